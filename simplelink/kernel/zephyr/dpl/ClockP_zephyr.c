@@ -5,16 +5,189 @@
  */
 
 #include <zephyr.h>
+#include <version.h>
 #include <sys/__assert.h>
 #include <kernel/zephyr/dpl/dpl.h>
 #include <ti/drivers/dpl/ClockP.h>
 
+/*
+ * A ClockP is a k_timer. Its expiry function runs in the system clock
+ * interrupt, which matches the Swi context ClockP functions run in on
+ * TI-RTOS: they must not block.
+ */
+typedef struct ClockP_Obj {
+	struct k_timer timer;
+	ClockP_Fxn fxn;
+	uintptr_t arg;
+	uint32_t timeout;	/* Initial timeout, in ClockP ticks */
+	uint32_t period;	/* Period, in ClockP ticks; 0 for one-shot */
+} ClockP_Obj;
+
+BUILD_ASSERT(sizeof(ClockP_Obj) <= sizeof(ClockP_Struct));
+
+/*
+ * Pool for ClockP_create(); ClockP_construct() needs none, so drivers
+ * that construct their clocks are not limited by it.
+ */
+#ifndef DPL_MAX_CLOCKS
+#define DPL_MAX_CLOCKS	4  /* From TI driver code inspection */
+#endif
+K_MEM_SLAB_DEFINE(clock_slab, sizeof(ClockP_Struct), DPL_MAX_CLOCKS,\
+		  MEM_ALIGN);
+
+/*
+ * Sleeps shorter than this spin instead: below a few tens of microseconds
+ * the cost of switching threads outweighs the CPU time given back. Longer
+ * sleeps block, and may last up to a tick more than asked.
+ */
+#ifndef DPL_USLEEP_SPIN_MAX
+#define DPL_USLEEP_SPIN_MAX	50
+#endif
+
+/* k_usleep() first appeared in Zephyr 2.1 */
+#if KERNEL_VERSION_NUMBER >= 0x020100
+#define DPL_HAVE_K_USLEEP	1
+#else
+#define DPL_HAVE_K_USLEEP	0
+#endif
+
+static void dpl_clock_expiry(struct k_timer *timer)
+{
+	ClockP_Obj *obj = CONTAINER_OF(timer, ClockP_Obj, timer);
+
+	obj->fxn(obj->arg);
+}
+
+ClockP_Handle ClockP_construct(ClockP_Struct *clockP, ClockP_Fxn clockFxn,
+			       uint32_t timeout, ClockP_Params *params)
+{
+	ClockP_Obj *obj = (ClockP_Obj *)clockP;
+	ClockP_Params defaultParams;
+
+	if (params == NULL) {
+		ClockP_Params_init(&defaultParams);
+		params = &defaultParams;
+	}
+
+	obj->fxn = clockFxn;
+	obj->arg = params->arg;
+	obj->timeout = timeout;
+	obj->period = params->period;
+	k_timer_init(&obj->timer, dpl_clock_expiry, NULL);
+
+	if (params->startFlag) {
+		ClockP_start((ClockP_Handle)obj);
+	}
+
+	return ((ClockP_Handle)obj);
+}
+
+void ClockP_destruct(ClockP_Struct *clockP)
+{
+	k_timer_stop(&((ClockP_Obj *)clockP)->timer);
+}
+
+ClockP_Handle ClockP_create(ClockP_Fxn clockFxn, uint32_t timeout,
+			    ClockP_Params *params)
+{
+	ClockP_Struct *clockP = NULL;
+
+	if (k_mem_slab_alloc(&clock_slab, (void **)&clockP, K_NO_WAIT) < 0) {
+		__ASSERT(0, "Increase size of DPL clock pool");
+		return (NULL);
+	}
+
+	return (ClockP_construct(clockP, clockFxn, timeout, params));
+}
+
+void ClockP_delete(ClockP_Handle handle)
+{
+	ClockP_destruct((ClockP_Struct *)handle);
+
+	k_mem_slab_free(&clock_slab, (void **)&handle);
+}
+
+void ClockP_Params_init(ClockP_Params *params)
+{
+	params->startFlag = false;
+	params->period = 0;
+	params->arg = 0;
+}
+
+void ClockP_start(ClockP_Handle handle)
+{
+	ClockP_Obj *obj = (ClockP_Obj *)handle;
+
+	k_timer_start(&obj->timer, DPL_TICKS_TO_MS(obj->timeout),
+		      DPL_TICKS_TO_MS(obj->period));
+}
+
+void ClockP_stop(ClockP_Handle handle)
+{
+	k_timer_stop(&((ClockP_Obj *)handle)->timer);
+}
+
+bool ClockP_isActive(ClockP_Handle handle)
+{
+	return (k_timer_remaining_get(&((ClockP_Obj *)handle)->timer) != 0);
+}
+
+uint32_t ClockP_getTimeout(ClockP_Handle handle)
+{
+	ClockP_Obj *obj = (ClockP_Obj *)handle;
+	u32_t remaining = k_timer_remaining_get(&obj->timer);
+
+	return ((remaining != 0) ? (uint32_t)z_ms_to_ticks(remaining) :
+		obj->timeout);
+}
+
+void ClockP_setTimeout(ClockP_Handle handle, uint32_t timeout)
+{
+	((ClockP_Obj *)handle)->timeout = timeout;
+}
+
+void ClockP_getCpuFreq(ClockP_FreqHz *freq)
+{
+	freq->hi = 0;
+	freq->lo = (uint32_t)sys_clock_hw_cycles_per_sec();
+}
+
+uint32_t ClockP_getSystemTickPeriod()
+{
+	return (USEC_PER_SEC / CONFIG_SYS_CLOCK_TICKS_PER_SEC);
+}
+
 uint32_t ClockP_getSystemTicks()
 {
-	return (uint32_t)z_ms_to_ticks(k_uptime_get_32());
+	return (uint32_t)z_tick_get_32();
+}
+
+/* The hardware cycle counter of the system timer: the CPU clock on CC32XX */
+uint32_t ClockP_getTimestamp(void)
+{
+	return (uint32_t)k_cycle_get_32();
+}
+
+void ClockP_getTimestampFreq(ClockP_FreqHz *freq)
+{
+	freq->hi = 0;
+	freq->lo = (uint32_t)sys_clock_hw_cycles_per_sec();
 }
 
 void ClockP_usleep(uint32_t usec)
 {
-	k_sleep((s32_t)usec);
+	if (usec < DPL_USLEEP_SPIN_MAX) {
+		k_busy_wait(usec);
+	} else {
+#if DPL_HAVE_K_USLEEP
+		k_usleep((s32_t)usec);
+#else
+		k_sleep(K_MSEC((usec + USEC_PER_MSEC - 1) / USEC_PER_MSEC));
+#endif
+	}
+}
+
+void ClockP_sleep(uint32_t sec)
+{
+	k_sleep(K_SECONDS(sec));
 }
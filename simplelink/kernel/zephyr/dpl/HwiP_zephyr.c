@@ -16,117 +16,196 @@
 #include <driverlib/rom_map.h>
 #include <driverlib/interrupt.h>
 
-/*
- * IRQ_CONNECT requires we know the ISR signature and argument
- * at build time; whereas SimpleLink plugs the interrupts
- * at run time, so we create an ISR shim, and register that.
- * The callback argument doesn't change after the ISR is registered.
- */
-struct sl_isr_args
-{
+typedef struct HwiP_Obj {
 	HwiP_Fxn cb;
 	uintptr_t arg;
-};
+	int interruptNum;
+} HwiP_Obj;
 
-static struct sl_isr_args sl_UDMA_cb = {NULL, 0};
-static struct sl_isr_args sl_UDMAERR_cb = {NULL, 0};
-static struct sl_isr_args sl_NWPIC_cb = {NULL, 0};
-static struct sl_isr_args sl_LSPI_cb = {NULL, 0};
+BUILD_ASSERT(sizeof(HwiP_Obj) <= sizeof(HwiP_Struct));
+
+/* Pool for HwiP_create(); HwiP_construct() needs none */
+#ifndef DPL_MAX_HWIS
+#define DPL_MAX_HWIS	16
+#endif
+K_MEM_SLAB_DEFINE(hwi_slab, sizeof(HwiP_Struct), DPL_MAX_HWIS, MEM_ALIGN);
 
 static void sl_isr(void *isr_arg)
 {
-	HwiP_Fxn cb = ((struct sl_isr_args *)isr_arg)->cb;
-	uintptr_t arg =	 ((struct sl_isr_args *)isr_arg)->arg;
+	HwiP_Fxn cb = ((HwiP_Obj *)isr_arg)->cb;
+	uintptr_t arg =	 ((HwiP_Obj *)isr_arg)->arg;
 
-	/* Call the SimpleLink ISR Handler: */
+	/* Call the TI driver ISR Handler: */
 	if (cb) {
 		cb(arg);
 	}
 }
 
+/*
+ * Priority expected is the NVIC priority byte the TI drivers use:
+ *    INT_PRIORITY_LVL_0 .. INT_PRIORITY_LVL_7 (level << 5),
+ *    or ~0 or 255 (meaning lowest priority)
+ *    ~0 and 255 are meant to be the same as INT_PRIORITY_LVL_7.
+ *    Zephyr IRQ_CONNECT adds +1, so the lowest level we can pass is 6.
+ */
+static unsigned int dpl_irq_priority(uint32_t priority)
+{
+	unsigned int level = (priority & 0xff) >> 5;
+
+	return ((level > 6) ? 6 : level);
+}
+
+#if defined(CONFIG_DYNAMIC_INTERRUPTS)
+
+static int dpl_irq_connect(HwiP_Obj *obj, uint32_t priority)
+{
+	return irq_connect_dynamic(obj->interruptNum - 16,
+				   dpl_irq_priority(priority), sl_isr, obj, 0);
+}
+
+#else
+
+/*
+ * Without CONFIG_DYNAMIC_INTERRUPTS, IRQ_CONNECT requires we know the ISR
+ * signature and argument at build time; whereas the TI drivers plug the
+ * interrupts at run time, so we register an ISR shim for the interrupts
+ * used by SimpleLink (NWPIC, UDMA, UDMAERR and LSPI), which looks up the
+ * HwiP object. Enable CONFIG_DYNAMIC_INTERRUPTS for the other peripherals.
+ */
+static HwiP_Obj *sl_UDMA_obj;
+static HwiP_Obj *sl_UDMAERR_obj;
+static HwiP_Obj *sl_NWPIC_obj;
+static HwiP_Obj *sl_LSPI_obj;
+
+static void sl_static_isr(void *isr_arg)
+{
+	HwiP_Obj *obj = *(HwiP_Obj **)isr_arg;
+
+	if (obj) {
+		sl_isr(obj);
+	}
+}
+
 /* Must hardcode the IRQ for IRQ_CONNECT macro.	 Must be <= CONFIG_NUM_IRQS.*/
 #define EXCEPTION_UDMA		46	/* == INT_UDMA	(62) - 16 */
 #define EXCEPTION_UDMAERR	47	/* == INT_UDMAERR (63) - 16 */
 #define EXCEPTION_NWPIC		171	/* == INT_NWPIC (187) - 16 */
 #define EXCEPTION_LSPI		177	/* == INT_LSPI (193) - 16 */
 
-HwiP_Handle HwiP_create(int interruptNum, HwiP_Fxn hwiFxn, HwiP_Params *params)
+static int dpl_irq_connect(HwiP_Obj *obj, uint32_t priority)
 {
-	HwiP_Handle handle = 0;
-	uint32_t priority = ~0;
-	uintptr_t arg = 0;
-
-	if (params) {
-		priority = params->priority;
-		arg = params->arg;
-	}
+	ARG_UNUSED(priority);
 
-	/*
-	 * SimpleLink only uses the NWPIC, UDMA, UDMAERR and LSPI interrupts:
-	 */
-	__ASSERT(INT_NWPIC == interruptNum || INT_UDMA == interruptNum ||
-		 INT_UDMAERR == interruptNum || INT_LSPI == interruptNum,
-		 "Unexpected interruptNum: %d\r\n",
-		 interruptNum);
-	/*
-	 * Priority expected is either:
-	 *    INT_PRIORITY_LVL_1,
-	 *    or ~0 or 255 (meaning lowest priority)
-	 *    ~0 and 255 are meant to be the same as INT_PRIORITY_LVL_7.
-	 *    For ~0 or 255, we want 7; but Zephyr IRQ_CONNECT adds +1,
-	 *    so we pass 6 for those TI drivers passing prio = ~0.
-	 */
-	__ASSERT((INT_PRIORITY_LVL_1 == priority) ||
-		 (0xff == (priority & 0xff)),
-		 "Expected priority: 0x%x or 0x%x, got: 0x%x\r\n",
-		 INT_PRIORITY_LVL_1, 0xff, (unsigned int)priority);
-
-	switch(interruptNum) {
+	switch(obj->interruptNum) {
 	case INT_UDMA:
-		sl_UDMA_cb.cb = hwiFxn;
-		sl_UDMA_cb.arg = arg;
-		IRQ_CONNECT(EXCEPTION_UDMA, 6, sl_isr, &sl_UDMA_cb, 0);
+		sl_UDMA_obj = obj;
+		IRQ_CONNECT(EXCEPTION_UDMA, 6, sl_static_isr, &sl_UDMA_obj, 0);
 		break;
 	case INT_UDMAERR:
-		sl_UDMAERR_cb.cb = hwiFxn;
-		sl_UDMAERR_cb.arg = arg;
-		IRQ_CONNECT(EXCEPTION_UDMAERR, 6, sl_isr, &sl_UDMAERR_cb, 0);
+		sl_UDMAERR_obj = obj;
+		IRQ_CONNECT(EXCEPTION_UDMAERR, 6, sl_static_isr,
+			    &sl_UDMAERR_obj, 0);
 		break;
 	case INT_NWPIC:
-		sl_NWPIC_cb.cb = hwiFxn;
-		sl_NWPIC_cb.arg = arg;
-		IRQ_CONNECT(EXCEPTION_NWPIC, 1, sl_isr, &sl_NWPIC_cb, 0);
+		sl_NWPIC_obj = obj;
+		IRQ_CONNECT(EXCEPTION_NWPIC, 1, sl_static_isr,
+			    &sl_NWPIC_obj, 0);
 		break;
 	case INT_LSPI:
-		sl_LSPI_cb.cb = hwiFxn;
-		sl_LSPI_cb.arg = arg;
-		IRQ_CONNECT(EXCEPTION_LSPI, 6, sl_isr, &sl_LSPI_cb, 0);
+		sl_LSPI_obj = obj;
+		IRQ_CONNECT(EXCEPTION_LSPI, 6, sl_static_isr, &sl_LSPI_obj, 0);
 		break;
 	default:
-		return(handle);
+		__ASSERT(0, "Unexpected interruptNum: %d, "
+			 "enable CONFIG_DYNAMIC_INTERRUPTS\r\n",
+			 obj->interruptNum);
+		return -EINVAL;
 	}
-	irq_enable(interruptNum - 16);
+	return 0;
+}
+
+#endif /* CONFIG_DYNAMIC_INTERRUPTS */
+
+HwiP_Handle HwiP_construct(HwiP_Struct *hwiP, int interruptNum,
+			   HwiP_Fxn hwiFxn, HwiP_Params *params)
+{
+	HwiP_Obj *obj = (HwiP_Obj *)hwiP;
+	HwiP_Params defaultParams;
+
+	if (params == NULL) {
+		HwiP_Params_init(&defaultParams);
+		params = &defaultParams;
+	}
+
+	obj->cb = hwiFxn;
+	obj->arg = params->arg;
+	obj->interruptNum = interruptNum;
 
-	return (HwiP_Handle)interruptNum;
+	if (dpl_irq_connect(obj, params->priority) < 0) {
+		return (NULL);
+	}
+
+	if (params->enableInt) {
+		irq_enable(interruptNum - 16);
+	}
+
+	return ((HwiP_Handle)obj);
 }
 
 /* Can't actually de-register an interrupt in Zephyr, so just disable: */
+void HwiP_destruct(HwiP_Struct *hwiP)
+{
+	HwiP_Obj *obj = (HwiP_Obj *)hwiP;
+
+	irq_disable(obj->interruptNum - 16);
+	obj->cb = NULL;
+}
+
+HwiP_Handle HwiP_create(int interruptNum, HwiP_Fxn hwiFxn, HwiP_Params *params)
+{
+	HwiP_Struct *hwiP = NULL;
+	HwiP_Handle handle;
+
+	if (k_mem_slab_alloc(&hwi_slab, (void **)&hwiP, K_NO_WAIT) < 0) {
+		__ASSERT(0, "Increase size of DPL hwi pool");
+		return (NULL);
+	}
+
+	handle = HwiP_construct(hwiP, interruptNum, hwiFxn, params);
+	if (handle == NULL) {
+		k_mem_slab_free(&hwi_slab, (void **)&hwiP);
+	}
+
+	return (handle);
+}
+
 void HwiP_delete(HwiP_Handle handle)
 {
-	int interruptNum = (int)handle;
+	if (handle == NULL) {
+		return;
+	}
 
-	__ASSERT(INT_NWPIC == interruptNum || INT_UDMA == interruptNum ||
-		 INT_UDMAERR == interruptNum || INT_LSPI == interruptNum,
-		 "Unexpected interruptNum: %d\r\n",
-		 interruptNum);
+	HwiP_destruct((HwiP_Struct *)handle);
 
-	irq_disable(interruptNum - 16);
+	k_mem_slab_free(&hwi_slab, (void **)&handle);
 }
 
 void HwiP_Params_init(HwiP_Params *params)
 {
 	params->arg = 0;
 	params->priority = ~0;
+	params->enableInt = true;
+}
+
+void HwiP_setFunc(HwiP_Handle hwiP, HwiP_Fxn fxn, uintptr_t arg)
+{
+	HwiP_Obj *obj = (HwiP_Obj *)hwiP;
+	unsigned int key;
+
+	key = irq_lock();
+	obj->cb = fxn;
+	obj->arg = arg;
+	irq_unlock(key);
 }
 
 /* Zephyr has no functions for clearing an interrupt, so use driverlib: */
@@ -135,6 +214,11 @@ void HwiP_clearInterrupt(int interruptNum)
 	MAP_IntPendClear((unsigned long)interruptNum);
 }
 
+void HwiP_post(int interruptNum)
+{
+	MAP_IntPendSet((unsigned long)interruptNum);
+}
+
 void HwiP_enableInterrupt(int interruptNum)
 {
 	irq_enable(interruptNum - 16);
@@ -145,6 +229,11 @@ void HwiP_disableInterrupt(int interruptNum)
 	irq_disable(interruptNum - 16);
 }
 
+bool HwiP_inISR(void)
+{
+	return (k_is_in_isr());
+}
+
 uintptr_t HwiP_disable(void)
 {
 	uintptr_t key;
@@ -154,6 +243,11 @@ uintptr_t HwiP_disable(void)
 	return (key);
 }
 
+void HwiP_enable(void)
+{
+	irq_unlock(0);
+}
+
 void HwiP_restore(uintptr_t key)
 {
 	irq_unlock(key);
@@ -21,10 +21,14 @@
  */
 
 /* Define a Mutex pool: */
+#ifndef DPL_MAX_MUTEXES
 #define DPL_MAX_MUTEXES	 4  /* From simplelink driver code inspection */
-K_MEM_SLAB_DEFINE(mutex_slab, sizeof(struct k_mutex), DPL_MAX_MUTEXES,\
+#endif
+K_MEM_SLAB_DEFINE(mutex_slab, sizeof(MutexP_Struct), DPL_MAX_MUTEXES,\
 		  MEM_ALIGN);
 
+BUILD_ASSERT(sizeof(struct k_mutex) <= sizeof(MutexP_Struct));
+
 static struct k_mutex *dpl_mutex_pool_alloc()
 {
 	struct k_mutex *mutex_ptr = NULL;
@@ -47,25 +51,37 @@ static MutexP_Status dpl_mutex_pool_free(struct k_mutex *mutex)
 	return MutexP_OK;
 }
 
+MutexP_Handle MutexP_construct(MutexP_Struct *handle, MutexP_Params *params)
+{
+	ARG_UNUSED(params);
+
+	k_mutex_init((struct k_mutex *)handle);
+
+	return ((MutexP_Handle)handle);
+}
+
+void MutexP_destruct(MutexP_Struct *mutexP)
+{
+	/* No way in Zephyr to "reset" the lock, so just re-init: */
+	k_mutex_init((struct k_mutex *)mutexP);
+}
+
 MutexP_Handle MutexP_create(MutexP_Params *params)
 {
 	struct k_mutex *mutex;
 
-	ARG_UNUSED(params);
-
 	mutex = dpl_mutex_pool_alloc();
 	__ASSERT(mutex, "MutexP_create failed\r\n");
 
 	if (mutex) {
-		k_mutex_init(mutex);
+		MutexP_construct((MutexP_Struct *)mutex, params);
 	}
 	return ((MutexP_Handle)mutex);
 }
 
 void MutexP_delete(MutexP_Handle handle)
 {
-	/* No way in Zephyr to "reset" the lock, so just re-init: */
-	k_mutex_init((struct k_mutex *)handle);
+	MutexP_destruct((MutexP_Struct *)handle);
 
 	dpl_mutex_pool_free((struct k_mutex *)handle);
 }
@@ -19,10 +19,20 @@
  * It leverages the Zephyr memory slab, enabling us to define a semaphore
  * object pool for use by the SimpleLink host driver.
  */
-#define DPL_MAX_SEMAPHORES 14  /* (user.h:MAX_CONCURRENT_ACTIONS+4) = 14 */
-K_MEM_SLAB_DEFINE(sem_slab, sizeof(struct k_sem), DPL_MAX_SEMAPHORES,\
+#ifndef DPL_MAX_SEMAPHORES
+/* (user.h:MAX_CONCURRENT_ACTIONS+4) = 14, plus the peripheral drivers */
+#define DPL_MAX_SEMAPHORES 30
+#endif
+K_MEM_SLAB_DEFINE(sem_slab, sizeof(SemaphoreP_Struct), DPL_MAX_SEMAPHORES,\
 		  MEM_ALIGN);
 
+BUILD_ASSERT(sizeof(struct k_sem) <= sizeof(SemaphoreP_Struct));
+
+SemaphoreP_Params SemaphoreP_defaultParams = {
+	.mode = SemaphoreP_Mode_COUNTING,
+	.callback = NULL,
+};
+
 static struct k_sem *dpl_sem_pool_alloc()
 {
 	struct k_sem *sem_ptr = NULL;
@@ -45,7 +55,7 @@ static SemaphoreP_Status dpl_sem_pool_free(struct k_sem *sem)
 	return SemaphoreP_OK;
 }
 
-/* timeout comes in and out as milliSeconds: */
+/* timeout comes in as ClockP ticks: */
 static int32_t dpl_convert_timeout(uint32_t timeout)
 {
 	int32_t zephyr_timeout;
@@ -58,26 +68,51 @@ static int32_t dpl_convert_timeout(uint32_t timeout)
 		zephyr_timeout = K_FOREVER;
 		break;
 	default:
-		zephyr_timeout = timeout;
+		zephyr_timeout = DPL_TICKS_TO_MS(timeout);
 	}
 	return zephyr_timeout;
 }
 
-
-SemaphoreP_Handle SemaphoreP_create(unsigned int count,
-				    SemaphoreP_Params *params)
+SemaphoreP_Handle SemaphoreP_construct(SemaphoreP_Struct *handle,
+				       unsigned int count,
+				       SemaphoreP_Params *params)
 {
 	unsigned int limit = UINT_MAX;
-	struct k_sem *sem;
 
 	if (params) {
 		limit = (params->mode == SemaphoreP_Mode_BINARY) ?
 			1 : UINT_MAX;
 	}
 
+	k_sem_init((struct k_sem *)handle, MIN(count, limit), limit);
+
+	return (SemaphoreP_Handle)handle;
+}
+
+SemaphoreP_Handle SemaphoreP_constructBinary(SemaphoreP_Struct *handle,
+					     unsigned int count)
+{
+	SemaphoreP_Params params;
+
+	SemaphoreP_Params_init(&params);
+	params.mode = SemaphoreP_Mode_BINARY;
+
+	return (SemaphoreP_construct(handle, count, &params));
+}
+
+void SemaphoreP_destruct(SemaphoreP_Struct *semP)
+{
+	k_sem_reset((struct k_sem *)semP);
+}
+
+SemaphoreP_Handle SemaphoreP_create(unsigned int count,
+				    SemaphoreP_Params *params)
+{
+	struct k_sem *sem;
+
 	sem = dpl_sem_pool_alloc();
 	if (sem) {
-		k_sem_init(sem, 0, limit);
+		SemaphoreP_construct((SemaphoreP_Struct *)sem, count, params);
 	}
 
 	return (SemaphoreP_Handle)sem;
@@ -96,15 +131,24 @@ SemaphoreP_Handle SemaphoreP_createBinary(unsigned int count)
 
 void SemaphoreP_delete(SemaphoreP_Handle handle)
 {
-	k_sem_reset((struct k_sem *)handle);
+	SemaphoreP_destruct((SemaphoreP_Struct *)handle);
 
 	(void)dpl_sem_pool_free((struct k_sem *)handle);
 }
 
 void SemaphoreP_Params_init(SemaphoreP_Params *params)
 {
-	params->mode = SemaphoreP_Mode_COUNTING;
-	params->callback = NULL;
+	*params = SemaphoreP_defaultParams;
+}
+
+SemaphoreP_Status SemaphoreP_pend(SemaphoreP_Handle handle, uint32_t timeout)
+{
+	int retval;
+
+	retval = k_sem_take((struct k_sem *)handle,
+			    dpl_convert_timeout(timeout));
+
+	return (retval == 0) ? SemaphoreP_OK : SemaphoreP_TIMEOUT;
 }
 
 /*
@@ -117,8 +161,12 @@ void SemaphoreP_Params_init(SemaphoreP_Params *params)
  * So, we claim (via simplelink driver code inspection), that SyncObjWait
  * will *only* be called with timeout == 0 if the intention is to clear the
  * semaphore: in that case, we just call k_sem_reset.
+ *
+ * This is kept apart from SemaphoreP_pend(), where the TI drivers rely on a
+ * timeout of SemaphoreP_NO_WAIT taking the semaphore when it is available.
+ * The SimpleLink timeout is in milliseconds.
  */
-SemaphoreP_Status SemaphoreP_pend(SemaphoreP_Handle handle, uint32_t timeout)
+int dpl_SyncObjWait(SemaphoreP_Handle handle, uint32_t timeout)
 {
 	int retval;
 
@@ -127,7 +175,8 @@ SemaphoreP_Status SemaphoreP_pend(SemaphoreP_Handle handle, uint32_t timeout)
 		retval = SemaphoreP_OK;
 	} else {
 		retval = k_sem_take((struct k_sem *)handle,
-				    dpl_convert_timeout(timeout));
+				    (timeout == SemaphoreP_WAIT_FOREVER) ?
+				    K_FOREVER : (s32_t)timeout);
 		__ASSERT_NO_MSG(retval != -EBUSY);
 		retval = (retval >= 0) ? SemaphoreP_OK : SemaphoreP_TIMEOUT;
 	}
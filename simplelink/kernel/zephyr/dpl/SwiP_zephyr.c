@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2017, Texas Instruments Incorporated
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <device.h>
+#include <init.h>
+#include <sys/__assert.h>
+#include <kernel/zephyr/dpl/dpl.h>
+#include <ti/drivers/dpl/SwiP.h>
+
+/*
+ * SwiPs run from a dedicated work queue, whose cooperative thread ranks
+ * just below the SimpleLink spawn task. A posted SwiP therefore runs as
+ * soon as the interrupt that posted it returns, ahead of any preemptible
+ * thread, and SwiPs never preempt each other. They run in the order they
+ * were posted; the SwiP priority is kept but not used for scheduling.
+ */
+#define SWI_TASK_STACKSIZE	1024
+#define SWI_TASK_PRIORITY	(K_HIGHEST_THREAD_PRIO + 1)
+
+static K_THREAD_STACK_DEFINE(swi_task_stack, SWI_TASK_STACKSIZE);
+static struct k_work_q swi_workq;
+
+typedef struct SwiP_Obj {
+	struct k_work work;
+	SwiP_Fxn fxn;
+	uintptr_t arg0;
+	uintptr_t arg1;
+	uint32_t priority;
+	uint32_t initTrigger;
+	uint32_t trigger;
+} SwiP_Obj;
+
+BUILD_ASSERT(sizeof(SwiP_Obj) <= sizeof(SwiP_Struct));
+
+/* Pool for SwiP_create(); SwiP_construct() needs none */
+#ifndef DPL_MAX_SWIS
+#define DPL_MAX_SWIS	4
+#endif
+K_MEM_SLAB_DEFINE(swi_slab, sizeof(SwiP_Struct), DPL_MAX_SWIS, MEM_ALIGN);
+
+/* Trigger of the running SwiP, as latched when it started */
+static uint32_t swi_trigger;
+
+static int dpl_swi_init(struct device *port)
+{
+	ARG_UNUSED(port);
+
+	k_work_q_start(&swi_workq, swi_task_stack,
+		       K_THREAD_STACK_SIZEOF(swi_task_stack),
+		       SWI_TASK_PRIORITY);
+	return 0;
+}
+SYS_INIT(dpl_swi_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+static void dpl_swi_handler(struct k_work *work)
+{
+	SwiP_Obj *obj = CONTAINER_OF(work, SwiP_Obj, work);
+	unsigned int key;
+
+	/* Latch the trigger and re-arm it, as a TI-RTOS Swi does */
+	key = irq_lock();
+	swi_trigger = obj->trigger;
+	obj->trigger = obj->initTrigger;
+	irq_unlock(key);
+
+	obj->fxn(obj->arg0, obj->arg1);
+}
+
+SwiP_Handle SwiP_construct(SwiP_Struct *swiP, SwiP_Fxn swiFxn,
+			   SwiP_Params *params)
+{
+	SwiP_Obj *obj = (SwiP_Obj *)swiP;
+	SwiP_Params defaultParams;
+
+	if (params == NULL) {
+		SwiP_Params_init(&defaultParams);
+		params = &defaultParams;
+	}
+
+	obj->fxn = swiFxn;
+	obj->arg0 = params->arg0;
+	obj->arg1 = params->arg1;
+	obj->priority = params->priority;
+	obj->initTrigger = params->trigger;
+	obj->trigger = params->trigger;
+	k_work_init(&obj->work, dpl_swi_handler);
+
+	return ((SwiP_Handle)obj);
+}
+
+/* There is no cancelling a submitted k_work: the SwiP must not be pending */
+void SwiP_destruct(SwiP_Struct *swiP)
+{
+	__ASSERT(!k_work_pending(&((SwiP_Obj *)swiP)->work),
+		 "SwiP_destruct: SwiP is pending\r\n");
+}
+
+void SwiP_Params_init(SwiP_Params *params)
+{
+	params->arg0 = 0;
+	params->arg1 = 0;
+	params->priority = ~0;
+	params->trigger = 0;
+}
+
+SwiP_Handle SwiP_create(SwiP_Fxn swiFxn, SwiP_Params *params)
+{
+	SwiP_Struct *swiP = NULL;
+
+	if (k_mem_slab_alloc(&swi_slab, (void **)&swiP, K_NO_WAIT) < 0) {
+		__ASSERT(0, "Increase size of DPL swi pool");
+		return (NULL);
+	}
+
+	return (SwiP_construct(swiP, swiFxn, params));
+}
+
+void SwiP_delete(SwiP_Handle handle)
+{
+	SwiP_destruct((SwiP_Struct *)handle);
+
+	k_mem_slab_free(&swi_slab, (void **)&handle);
+}
+
+/*
+ * Keeps the SwiP thread, like any other, from preempting the caller.
+ * A no-op in an ISR, which SwiPs cannot preempt anyway.
+ */
+uintptr_t SwiP_disable(void)
+{
+	if (k_is_in_isr()) {
+		return (0);
+	}
+
+	k_sched_lock();
+
+	return (1);
+}
+
+void SwiP_restore(uintptr_t key)
+{
+	if (key) {
+		k_sched_unlock();
+	}
+}
+
+uint32_t SwiP_getTrigger()
+{
+	return (swi_trigger);
+}
+
+bool SwiP_inISR(void)
+{
+	return (k_current_get() == &swi_workq.thread);
+}
+
+/* Posting a SwiP that is already pending has no effect, as on TI-RTOS */
+void SwiP_post(SwiP_Handle handle)
+{
+	k_work_submit_to_queue(&swi_workq, &((SwiP_Obj *)handle)->work);
+}
+
+void SwiP_andn(SwiP_Handle handle, uint32_t mask)
+{
+	SwiP_Obj *obj = (SwiP_Obj *)handle;
+	unsigned int key;
+	bool post;
+
+	key = irq_lock();
+	post = (obj->trigger != 0) && ((obj->trigger & ~mask) == 0);
+	obj->trigger &= ~mask;
+	irq_unlock(key);
+
+	if (post) {
+		SwiP_post(handle);
+	}
+}
+
+void SwiP_dec(SwiP_Handle handle)
+{
+	SwiP_Obj *obj = (SwiP_Obj *)handle;
+	unsigned int key;
+	bool post;
+
+	key = irq_lock();
+	post = (obj->trigger == 1);
+	if (obj->trigger != 0) {
+		obj->trigger--;
+	}
+	irq_unlock(key);
+
+	if (post) {
+		SwiP_post(handle);
+	}
+}
+
+void SwiP_inc(SwiP_Handle handle)
+{
+	SwiP_Obj *obj = (SwiP_Obj *)handle;
+	unsigned int key;
+
+	key = irq_lock();
+	obj->trigger++;
+	irq_unlock(key);
+
+	SwiP_post(handle);
+}
+
+void SwiP_or(SwiP_Handle handle, uint32_t mask)
+{
+	SwiP_Obj *obj = (SwiP_Obj *)handle;
+	unsigned int key;
+
+	key = irq_lock();
+	obj->trigger |= mask;
+	irq_unlock(key);
+
+	SwiP_post(handle);
+}
+
+void SwiP_setPriority(SwiP_Handle handle, uint32_t priority)
+{
+	((SwiP_Obj *)handle)->priority = priority;
+}
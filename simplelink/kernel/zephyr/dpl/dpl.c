@@ -29,11 +29,21 @@
  * Since SimpleLink APIs may be called from any thread, including
  * cooperative threads, and the _main kernel thread, we must set this
  * as highest prioirty.
+ * It can be lowered, if the application keeps SimpleLink calls and
+ * event handling out of the threads above it, so a flood of events can't
+ * starve those threads.
  */
-#define	 SPAWN_TASK_PRIORITY   K_HIGHEST_THREAD_PRIO
+#ifndef DPL_SPAWN_TASK_PRIORITY
+#define	 DPL_SPAWN_TASK_PRIORITY   K_HIGHEST_THREAD_PRIO
+#endif
 
-/* Spawn message queue size: Could be 1, but 3 is used by other DPL ports */
-#define SPAWN_QUEUE_SIZE  ( 3 )
+/*
+ * Spawn message queue size, per lane. Other DPL ports use 3, which a
+ * burst of NWP interrupts overflows.
+ */
+#ifndef DPL_SPAWN_QUEUE_SIZE
+#define DPL_SPAWN_QUEUE_SIZE  ( 16 )
+#endif
 
 /* Stack, for the simplelink spawn task: */
 static K_THREAD_STACK_DEFINE(spawn_task_stack, SPAWN_TASK_STACKSIZE);
@@ -42,11 +52,23 @@ static struct k_thread spawn_task_data;
 static void spawn_task(void *unused1, void *unused2, void *unused3);
 
 /*
- * MessageQ to send message from an ISR or other task to the SimpleLink
- * "Spawn" task:
+ * MessageQs to send messages from an ISR or other task to the SimpleLink
+ * "Spawn" task. Messages spawned by the NWP interrupt handler go in their
+ * own lane, which is served first, so the RX path is not held up behind
+ * deferred work spawned from command context.
  */
-K_MSGQ_DEFINE(spawn_msgq, sizeof(tSimpleLinkSpawnMsg), SPAWN_QUEUE_SIZE,\
-	      MEM_ALIGN);
+K_MSGQ_DEFINE(spawn_irq_msgq, sizeof(tSimpleLinkSpawnMsg),
+	      DPL_SPAWN_QUEUE_SIZE, MEM_ALIGN);
+K_MSGQ_DEFINE(spawn_msgq, sizeof(tSimpleLinkSpawnMsg),
+	      DPL_SPAWN_QUEUE_SIZE, MEM_ALIGN);
+
+/*
+ * Given on every spawn. It saturates at 1: the task drains both lanes
+ * per wakeup, so a burst of spawns costs it a single wakeup.
+ */
+K_SEM_DEFINE(spawn_sem, 0, 1);
+
+static struct dpl_spawn_stats spawn_stats;
 
 /*
  * SimpleLink does not have an init hook, so we export this function to
@@ -57,7 +79,7 @@ static int dpl_zephyr_init(struct device *port)
 	(void)k_thread_create(&spawn_task_data, spawn_task_stack,
 			SPAWN_TASK_STACKSIZE, spawn_task,
 			NULL, NULL, NULL,
-			SPAWN_TASK_PRIORITY, 0, K_NO_WAIT);
+			DPL_SPAWN_TASK_PRIORITY, 0, K_NO_WAIT);
 	return 0;
 }
 SYS_INIT(dpl_zephyr_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -67,35 +89,77 @@ _SlReturnVal_t os_Spawn(P_OS_SPAWN_ENTRY pEntry, void *pValue,
 			unsigned long flags)
 {
 	tSimpleLinkSpawnMsg slMsg;
-	_SlReturnVal_t retval;
+	struct k_msgq *msgq;
+	unsigned int lane;
+	unsigned int key;
+	u32_t depth;
 
 	slMsg.pEntry = pEntry;
 	slMsg.pValue = pValue;
 
-	if (0 == k_msgq_put(&spawn_msgq, &slMsg, K_NO_WAIT)) {
-		retval = OS_OK;
+	lane = (flags == SL_SPAWN_FLAG_FROM_SL_IRQ_HANDLER) ?
+		DPL_SPAWN_LANE_IRQ : DPL_SPAWN_LANE_DEFERRED;
+	msgq = (lane == DPL_SPAWN_LANE_IRQ) ? &spawn_irq_msgq : &spawn_msgq;
+
+	if (0 != k_msgq_put(msgq, &slMsg, K_NO_WAIT)) {
+		/* Count it; the caller sees the failure */
+		key = irq_lock();
+		spawn_stats.lanes[lane].overflows++;
+		irq_unlock(key);
+
+		return -1;
 	}
-	else {
-		retval = -1;
-		__ASSERT(retval == OS_OK,
-			 "os_Spawn: Failed to k_msgq_put failed\r\n");
 
+	depth = k_msgq_num_used_get(msgq);
+
+	key = irq_lock();
+	spawn_stats.lanes[lane].spawned++;
+	if (depth > spawn_stats.lanes[lane].max_depth) {
+		spawn_stats.lanes[lane].max_depth = depth;
 	}
+	irq_unlock(key);
+
+	k_sem_give(&spawn_sem);
+
+	return OS_OK;
+}
+
+void dpl_get_spawn_stats(struct dpl_spawn_stats *stats)
+{
+	unsigned int key;
 
-	return retval;
+	key = irq_lock();
+	*stats = spawn_stats;
+	irq_unlock(key);
 }
 
 void spawn_task(void *unused1, void *unused2, void *unused3)
 {
 	tSimpleLinkSpawnMsg slMsg;
+	u32_t batch;
 
 	ARG_UNUSED(unused1);
 	ARG_UNUSED(unused2);
 	ARG_UNUSED(unused3);
 
 	while (1) {
-		k_msgq_get(&spawn_msgq, &slMsg, K_FOREVER);
-		slMsg.pEntry(slMsg.pValue);
+		k_sem_take(&spawn_sem, K_FOREVER);
+
+		batch = 0;
+		for (;;) {
+			/* The IRQ lane goes first, before every deferred one */
+			if (k_msgq_get(&spawn_irq_msgq, &slMsg, K_NO_WAIT) != 0 &&
+			    k_msgq_get(&spawn_msgq, &slMsg, K_NO_WAIT) != 0) {
+				break;
+			}
+			slMsg.pEntry(slMsg.pValue);
+			batch++;
+		}
+
+		spawn_stats.wakeups++;
+		if (batch > spawn_stats.max_batch) {
+			spawn_stats.max_batch = batch;
+		}
 	}
 }
 
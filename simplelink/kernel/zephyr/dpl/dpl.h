@@ -6,4 +6,34 @@
 
 #define MEM_ALIGN (sizeof(uint32_t))
 
+/*
+ * ClockP ticks are Zephyr kernel ticks, while the kernel APIs of this
+ * Zephyr version take their timeouts in milliseconds. Round up, so a
+ * timeout never expires early.
+ */
+#define DPL_TICKS_TO_MS(ticks) \
+	((s32_t)((((u64_t)(ticks) * MSEC_PER_SEC) + \
+		  CONFIG_SYS_CLOCK_TICKS_PER_SEC - 1) / \
+		 CONFIG_SYS_CLOCK_TICKS_PER_SEC))
+
 extern int *__errno(void);
+
+/* Spawn lanes: messages from the NWP interrupt handler, and the others */
+#define DPL_SPAWN_LANE_IRQ	0
+#define DPL_SPAWN_LANE_DEFERRED	1
+#define DPL_SPAWN_NUM_LANES	2
+
+struct dpl_spawn_lane_stats {
+	u32_t spawned;		/* Messages queued */
+	u32_t overflows;	/* Messages refused on a full queue */
+	u32_t max_depth;	/* Deepest the queue has been */
+};
+
+struct dpl_spawn_stats {
+	struct dpl_spawn_lane_stats lanes[DPL_SPAWN_NUM_LANES];
+	u32_t wakeups;		/* Spawn task wakeups */
+	u32_t max_batch;	/* Most messages run in one wakeup */
+};
+
+/* Copies the os_Spawn() statistics */
+extern void dpl_get_spawn_stats(struct dpl_spawn_stats *stats);
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2019, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== CRC.c ========
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ti/drivers/CRC.h>
+#include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/dpl/SemaphoreP.h>
+
+extern const CRC_Config CRC_config[];
+extern const uint_least8_t CRC_count;
+
+/* Default CRC parameters structure: CRC-32 */
+const CRC_Params CRC_defaultParams = {
+    CRC_POLYNOMIAL_CRC_32,      /* polynomial */
+    0xFFFFFFFF,                 /* seed */
+    0xFFFFFFFF,                 /* finalXor */
+    true,                       /* reflect */
+    SemaphoreP_WAIT_FOREVER,    /* timeout */
+    NULL                        /* custom */
+};
+
+static bool isInitialized = false;
+
+/*
+ *  ======== CRC_addData ========
+ */
+int_fast16_t CRC_addData(CRC_Handle handle, const void *source, size_t size)
+{
+    return (handle->fxnTablePtr->addDataFxn(handle, source, size));
+}
+
+/*
+ *  ======== CRC_calculate ========
+ */
+int_fast16_t CRC_calculate(CRC_Handle handle, const void *source, size_t size,
+    uint32_t *result)
+{
+    int_fast16_t status;
+
+    status = handle->fxnTablePtr->addDataFxn(handle, source, size);
+
+    if (status == CRC_STATUS_SUCCESS) {
+        status = handle->fxnTablePtr->finalizeFxn(handle, result);
+    }
+
+    return (status);
+}
+
+/*
+ *  ======== CRC_close ========
+ */
+void CRC_close(CRC_Handle handle)
+{
+    handle->fxnTablePtr->closeFxn(handle);
+}
+
+/*
+ *  ======== CRC_finalize ========
+ */
+int_fast16_t CRC_finalize(CRC_Handle handle, uint32_t *result)
+{
+    return (handle->fxnTablePtr->finalizeFxn(handle, result));
+}
+
+/*
+ *  ======== CRC_init ========
+ */
+void CRC_init(void)
+{
+    uint_least8_t i;
+    uintptr_t key;
+
+    key = HwiP_disable();
+
+    if (!isInitialized) {
+        isInitialized = (bool) true;
+
+        /* Call each driver's init function */
+        for (i = 0; i < CRC_count; i++) {
+            CRC_config[i].fxnTablePtr->initFxn((CRC_Handle)&(CRC_config[i]));
+        }
+    }
+
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== CRC_open ========
+ */
+CRC_Handle CRC_open(uint_least8_t index, CRC_Params *params)
+{
+    CRC_Handle handle = NULL;
+
+    /* Verify driver index and state */
+    if (isInitialized && (index < CRC_count)) {
+        /* If params are NULL use defaults */
+        if (params == NULL) {
+            params = (CRC_Params *) &CRC_defaultParams;
+        }
+
+        handle = (CRC_Handle)&(CRC_config[index]);
+        handle = handle->fxnTablePtr->openFxn(handle, params);
+    }
+
+    return (handle);
+}
+
+/*
+ *  ======== CRC_Params_init ========
+ */
+void CRC_Params_init(CRC_Params *params)
+{
+    *params = CRC_defaultParams;
+}
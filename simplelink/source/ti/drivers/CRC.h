@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2019, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!*****************************************************************************
+ *  @file       CRC.h
+ *
+ *  @brief      CRC driver interface
+ *
+ *  The CRC header file should be included in an application as follows:
+ *  @code
+ *  #include <ti/drivers/CRC.h>
+ *  @endcode
+ *
+ *  # Overview #
+ *
+ *  The CRC driver computes cyclic redundancy checks over memory buffers.
+ *  Depending on the implementation the data is fed to a hardware CRC engine
+ *  (by the CPU or by uDMA) or processed in software.  The driver supports
+ *  the CRC-16 (0x8005), CRC-CCITT (0x1021), CRC-32 (0x04C11DB7) and
+ *  CRC-32C (0x1EDC6F41) polynomials, with a configurable seed, final XOR
+ *  value and input/output reflection.
+ *
+ *  # Usage #
+ *
+ *  The CRC driver must be initialized by calling CRC_init(), before any
+ *  other CRC APIs can be called.  A CRC instance is then opened with a
+ *  CRC_Params structure describing the CRC variant.
+ *
+ *  A whole buffer is processed with CRC_calculate().  Data that arrives in
+ *  pieces (a log record, an OTA image received over the network) is fed
+ *  with any number of CRC_addData() calls followed by CRC_finalize(), which
+ *  returns the CRC and restarts the instance at its seed.
+ *
+ *  @code
+ *  CRC_Handle handle;
+ *  CRC_Params params;
+ *  uint32_t   crc;
+ *
+ *  CRC_init();
+ *
+ *  CRC_Params_init(&params);       // CRC-32, as used by zlib and Ethernet
+ *  handle = CRC_open(Board_CRC0, &params);
+ *
+ *  CRC_addData(handle, header, sizeof(header));
+ *  CRC_addData(handle, payload, payloadLength);
+ *  CRC_finalize(handle, &crc);
+ *  @endcode
+ *
+ *  Common variants:
+ *  | Variant            | polynomial               | seed       | finalXor   | reflect |
+ *  |--------------------|--------------------------|------------|------------|---------|
+ *  | CRC-32             | CRC_POLYNOMIAL_CRC_32    | 0xFFFFFFFF | 0xFFFFFFFF | true    |
+ *  | CRC-32C            | CRC_POLYNOMIAL_CRC_32C   | 0xFFFFFFFF | 0xFFFFFFFF | true    |
+ *  | CRC-16/ARC         | CRC_POLYNOMIAL_CRC_16    | 0x0000     | 0x0000     | true    |
+ *  | CRC-16/XMODEM      | CRC_POLYNOMIAL_CRC_CCITT | 0x0000     | 0x0000     | false   |
+ *  | CRC-16/CCITT-FALSE | CRC_POLYNOMIAL_CRC_CCITT | 0xFFFF     | 0x0000     | false   |
+ *
+ *  CRC_calculate(), CRC_addData() and CRC_finalize() are blocking and must
+ *  only be called from a task context.
+ *
+ *******************************************************************************
+ */
+
+#ifndef ti_drivers_CRC__include
+#define ti_drivers_CRC__include
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * Common CRC status code reservation offset.
+ * CRC driver implementations should offset status codes with
+ * CRC_STATUS_RESERVED growing negatively.
+ */
+#define CRC_STATUS_RESERVED         (-32)
+
+/*!
+ * @brief   Successful status code.
+ */
+#define CRC_STATUS_SUCCESS          (0)
+
+/*!
+ * @brief   Generic error status code.
+ */
+#define CRC_STATUS_ERROR            (-1)
+
+/*!
+ * @brief   The requested CRC variant is not supported by the implementation.
+ */
+#define CRC_STATUS_UNSUPPORTED      (-2)
+
+/*!
+ * @brief   The CRC engine could not be acquired, or did not complete,
+ *          within the timeout.
+ */
+#define CRC_STATUS_TIMEOUT          (-3)
+
+/*!
+ *  @brief      A handle that is returned from a CRC_open() call.
+ */
+typedef struct CRC_Config_ *CRC_Handle;
+
+/*!
+ *  @brief  CRC generator polynomials
+ *
+ *  The enumeration value is the normal (non-reflected) representation of
+ *  the polynomial without its leading term.
+ */
+typedef enum CRC_Polynomial_ {
+    CRC_POLYNOMIAL_CRC_16       = 0x8005,     /*!< CRC-16, 16 bits */
+    CRC_POLYNOMIAL_CRC_CCITT    = 0x1021,     /*!< CRC-CCITT, 16 bits */
+    CRC_POLYNOMIAL_CRC_32       = 0x04C11DB7, /*!< CRC-32, 32 bits */
+    CRC_POLYNOMIAL_CRC_32C      = 0x1EDC6F41  /*!< CRC-32C (Castagnoli) */
+} CRC_Polynomial;
+
+/*!
+ *  @brief  CRC Parameters
+ *
+ *  CRC parameters are used with the CRC_open() call.  Default values for
+ *  these parameters are set using CRC_Params_init().
+ *
+ *  @sa     CRC_Params_init()
+ */
+typedef struct CRC_Params_ {
+    CRC_Polynomial  polynomial; /*!< Generator polynomial */
+    uint32_t        seed;       /*!< Initial CRC value */
+    uint32_t        finalXor;   /*!< Value XORed with the final CRC */
+    bool            reflect;    /*!< Reflect input bytes and the result */
+    uint32_t        timeout;    /*!< Timeout to acquire the CRC engine, and
+                                     for it to complete, in ClockP ticks */
+    void           *custom;     /*!< Custom argument used by driver
+                                     implementation */
+} CRC_Params;
+
+/*!
+ *  @brief      A function pointer to a driver specific implementation of
+ *              CRC_addData().
+ */
+typedef int_fast16_t (*CRC_AddDataFxn)(CRC_Handle handle, const void *source,
+                                       size_t size);
+
+/*!
+ *  @brief      A function pointer to a driver specific implementation of
+ *              CRC_close().
+ */
+typedef void (*CRC_CloseFxn)(CRC_Handle handle);
+
+/*!
+ *  @brief      A function pointer to a driver specific implementation of
+ *              CRC_finalize().
+ */
+typedef int_fast16_t (*CRC_FinalizeFxn)(CRC_Handle handle, uint32_t *result);
+
+/*!
+ *  @brief      A function pointer to a driver specific implementation of
+ *              CRC_init().
+ */
+typedef void (*CRC_InitFxn)(CRC_Handle handle);
+
+/*!
+ *  @brief      A function pointer to a driver specific implementation of
+ *              CRC_open().
+ */
+typedef CRC_Handle (*CRC_OpenFxn)(CRC_Handle handle, CRC_Params *params);
+
+/*!
+ *  @brief      The definition of a CRC function table that contains the
+ *              required set of functions to control a specific CRC driver
+ *              implementation.
+ */
+typedef struct CRC_FxnTable_ {
+    CRC_AddDataFxn      addDataFxn;
+    CRC_CloseFxn        closeFxn;
+    CRC_FinalizeFxn     finalizeFxn;
+    CRC_InitFxn         initFxn;
+    CRC_OpenFxn         openFxn;
+} CRC_FxnTable;
+
+/*!
+ *  @brief      CRC Global configuration
+ *
+ *  The CRC_Config structure contains a set of pointers used to
+ *  characterize the CRC driver implementation.
+ *
+ *  This structure needs to be defined before calling CRC_init() and
+ *  it must not be changed thereafter.
+ *
+ *  @sa     CRC_init()
+ */
+typedef struct CRC_Config_ {
+    /*! Pointer to a table of driver-specific implementations of CRC APIs */
+    CRC_FxnTable const *fxnTablePtr;
+
+    /*! Pointer to a driver specific data object */
+    void               *object;
+
+    /*! Pointer to a driver specific hardware attributes structure */
+    void         const *hwAttrs;
+} CRC_Config;
+
+/*!
+ *  @brief  Function to feed data into a running CRC
+ *
+ *  May be called any number of times between CRC_open() (or the previous
+ *  CRC_finalize()) and CRC_finalize().  Buffers need not be aligned and
+ *  may have any length.
+ *
+ *  @param  handle      A CRC_Handle returned from CRC_open()
+ *  @param  source      Data to process
+ *  @param  size        Number of bytes in source
+ *
+ *  @return CRC_STATUS_SUCCESS, or a negative status code on failure
+ */
+extern int_fast16_t CRC_addData(CRC_Handle handle, const void *source,
+                                size_t size);
+
+/*!
+ *  @brief  Function to compute the CRC of a single buffer
+ *
+ *  Equivalent to CRC_addData() followed by CRC_finalize().  Any data
+ *  previously added with CRC_addData() is included.
+ *
+ *  @param  handle      A CRC_Handle returned from CRC_open()
+ *  @param  source      Data to process
+ *  @param  size        Number of bytes in source
+ *  @param  result      Location the CRC is written to
+ *
+ *  @return CRC_STATUS_SUCCESS, or a negative status code on failure
+ */
+extern int_fast16_t CRC_calculate(CRC_Handle handle, const void *source,
+                                  size_t size, uint32_t *result);
+
+/*!
+ *  @brief  Function to close a CRC instance specified by the CRC handle
+ *
+ *  @pre    CRC_open() has to be called first.
+ *
+ *  @param  handle      A CRC_Handle returned from CRC_open()
+ *
+ *  @sa     CRC_open()
+ */
+extern void CRC_close(CRC_Handle handle);
+
+/*!
+ *  @brief  Function to complete a CRC started with CRC_addData()
+ *
+ *  Applies the output reflection and final XOR, and restarts the instance
+ *  at its seed.
+ *
+ *  @param  handle      A CRC_Handle returned from CRC_open()
+ *  @param  result      Location the CRC is written to
+ *
+ *  @return CRC_STATUS_SUCCESS, or a negative status code on failure
+ */
+extern int_fast16_t CRC_finalize(CRC_Handle handle, uint32_t *result);
+
+/*!
+ *  @brief  Function to initialize the CRC module
+ *
+ *  @pre    The CRC_config structure must exist and be persistent before this
+ *          function can be called.  This function must also be called before
+ *          any other CRC driver APIs.
+ */
+extern void CRC_init(void);
+
+/*!
+ *  @brief  Function to open a CRC instance
+ *
+ *  @pre    CRC_init() has to be called first.
+ *
+ *  @param  index       Logical instance number for the CRC indexed into
+ *                      the CRC_config table
+ *
+ *  @param  params      Pointer to a parameter block, if NULL it will use
+ *                      default values.
+ *
+ *  @return A CRC_Handle on success or a NULL on an error, or if the
+ *          requested CRC variant is not supported.
+ *
+ *  @sa     CRC_init()
+ *  @sa     CRC_close()
+ */
+extern CRC_Handle CRC_open(uint_least8_t index, CRC_Params *params);
+
+/*!
+ *  @brief  Function to initialize the CRC_Params structure to its defaults
+ *
+ *  Defaults values are:
+ *      polynomial = CRC_POLYNOMIAL_CRC_32,
+ *      seed = 0xFFFFFFFF,
+ *      finalXor = 0xFFFFFFFF,
+ *      reflect = true,
+ *      timeout = SemaphoreP_WAIT_FOREVER,
+ *      custom = NULL
+ *
+ *  @param  params      Parameter structure to initialize
+ */
+extern void CRC_Params_init(CRC_Params *params);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ti_drivers_CRC__include */
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2019, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== DMA.c ========
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ti/drivers/DMA.h>
+#include <ti/drivers/dpl/HwiP.h>
+
+extern const DMA_Config DMA_config[];
+extern const uint_least8_t DMA_count;
+
+static int_fast16_t DMA_submit(DMA_Handle handle, DMA_Transaction *transaction);
+
+/* Default DMA parameters structure */
+const DMA_Params DMA_defaultParams = {
+    DMA_MIN_TRANSFER_SIZE,      /* minTransferSize */
+    false,                      /* highPriority */
+    NULL                        /* custom */
+};
+
+static bool isInitialized = false;
+
+/*
+ *  ======== DMA_close ========
+ */
+void DMA_close(DMA_Handle handle)
+{
+    handle->fxnTablePtr->closeFxn(handle);
+}
+
+/*
+ *  ======== DMA_init ========
+ */
+void DMA_init(void)
+{
+    uint_least8_t i;
+    uintptr_t key;
+
+    key = HwiP_disable();
+
+    if (!isInitialized) {
+        isInitialized = (bool) true;
+
+        /* Call each driver's init function */
+        for (i = 0; i < DMA_count; i++) {
+            DMA_config[i].fxnTablePtr->initFxn((DMA_Handle)&(DMA_config[i]));
+        }
+    }
+
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== DMA_memcpy ========
+ */
+int_fast16_t DMA_memcpy(DMA_Handle handle, DMA_Transaction *transaction,
+    void *dst, const void *src, size_t size)
+{
+    transaction->dst = dst;
+    transaction->src = src;
+    transaction->size = size;
+
+    return (DMA_submit(handle, transaction));
+}
+
+/*
+ *  ======== DMA_memset ========
+ */
+int_fast16_t DMA_memset(DMA_Handle handle, DMA_Transaction *transaction,
+    void *dst, int value, size_t size)
+{
+    transaction->dst = dst;
+    transaction->src = NULL;
+    transaction->size = size;
+    transaction->pattern = (uint32_t) (uint8_t) value * 0x01010101;
+
+    return (DMA_submit(handle, transaction));
+}
+
+/*
+ *  ======== DMA_open ========
+ */
+DMA_Handle DMA_open(uint_least8_t index, DMA_Params *params)
+{
+    DMA_Handle handle = NULL;
+
+    /* Verify driver index and state */
+    if (isInitialized && (index < DMA_count)) {
+        /* If params are NULL use defaults */
+        if (params == NULL) {
+            params = (DMA_Params *) &DMA_defaultParams;
+        }
+
+        handle = (DMA_Handle)&(DMA_config[index]);
+        handle = handle->fxnTablePtr->openFxn(handle, params);
+    }
+
+    return (handle);
+}
+
+/*
+ *  ======== DMA_Params_init ========
+ */
+void DMA_Params_init(DMA_Params *params)
+{
+    *params = DMA_defaultParams;
+}
+
+/*
+ *  ======== DMA_submit ========
+ *  A zero-size transaction would program a transfer count of zero, which
+ *  the uDMA takes as its maximum, so it is completed here.
+ */
+static int_fast16_t DMA_submit(DMA_Handle handle, DMA_Transaction *transaction)
+{
+    if (transaction->size == 0) {
+        if (transaction->callbackFxn != NULL) {
+            transaction->callbackFxn(transaction);
+        }
+
+        return (DMA_STATUS_SUCCESS);
+    }
+
+    return (handle->fxnTablePtr->submitFxn(handle, transaction));
+}
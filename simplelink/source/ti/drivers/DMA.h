@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2019, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/** ============================================================================
+ *  @file       DMA.h
+ *
+ *  @brief      Memory to memory copy and fill on the uDMA
+ *
+ *  The DMA header file should be included in an application as follows:
+ *  @code
+ *  #include <ti/drivers/DMA.h>
+ *  @endcode
+ *
+ *  # Operation #
+ *
+ *  DMA_memcpy() and DMA_memset() queue a transaction on the channel of an
+ *  open DMA instance and return immediately.  The transaction's callback is called in
+ *  Hwi context when the data has been moved, so the CPU can work on
+ *  something else in the meantime.  If no callback is given the call blocks
+ *  until the transaction completes.
+ *
+ *  Transactions smaller than DMA_Params.minTransferSize are not worth the
+ *  set up and interrupt cost, and are done by the CPU before the call
+ *  returns; their callback is called from the calling context.  Such
+ *  transactions may complete before transactions queued earlier.  So do
+ *  transactions of zero bytes.
+ *
+ *  Refer to the device specific implementation header (for instance
+ *  @ref DMACC32XX.h) for the item sizes and channel arbitration.
+ *
+ *  @code
+ *  static void copyDone(DMA_Transaction *transaction)
+ *  {
+ *      // Called in Hwi context
+ *  }
+ *
+ *  DMA_Handle      handle;
+ *  DMA_Transaction transaction;
+ *
+ *  DMA_init();
+ *  handle = DMA_open(Board_DMA0, NULL);
+ *
+ *  transaction.callbackFxn = copyDone;
+ *  DMA_memcpy(handle, &transaction, frameOut, frameIn, frameLength);
+ *  @endcode
+ *
+ *  # Power Management #
+ *
+ *  LPDS is disallowed while transactions are queued.
+ *
+ *  # Thread Safety #
+ *
+ *  DMA_memcpy() and DMA_memset() may be called from tasks, Swis and Hwis
+ *  when a callback is given.  A transaction must not be resubmitted or
+ *  reused until its callback has been called, and an instance must not be
+ *  closed while it has transactions queued.
+ *  ============================================================================
+ */
+
+#ifndef ti_drivers_DMA__include
+#define ti_drivers_DMA__include
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ti/drivers/dpl/SemaphoreP.h>
+#include <ti/drivers/utils/List.h>
+
+/*!
+ *  @brief  Successful status code returned by DMA APIs
+ */
+#define DMA_STATUS_SUCCESS          (0)
+
+/*!
+ *  @brief  Generic error status code returned by DMA APIs
+ */
+#define DMA_STATUS_ERROR            (-1)
+
+/*!
+ *  @brief  Default DMA_Params.minTransferSize in bytes
+ */
+#define DMA_MIN_TRANSFER_SIZE       (256)
+
+/*!
+ *  @brief      A handle that is returned from a DMA_open() call.
+ */
+typedef struct DMA_Config_ *DMA_Handle;
+
+struct DMA_Transaction_;
+
+/*!
+ *  @brief  Transaction completion callback, called in Hwi context
+ */
+typedef void (*DMA_CallbackFxn)(struct DMA_Transaction_ *transaction);
+
+/*!
+ *  @brief  DMA transaction
+ *
+ *  The application sets callbackFxn and arg before submitting the
+ *  transaction; the remaining members are used by the driver.
+ */
+typedef struct DMA_Transaction_ {
+    List_Elem          elem;          /* Queue link */
+    DMA_CallbackFxn    callbackFxn;   /*!< Completion callback, or NULL */
+    uintptr_t          arg;           /*!< Argument for the callback */
+    void              *dst;           /* Destination buffer */
+    const void        *src;           /* Source buffer, NULL for a fill */
+    size_t             size;          /* Number of bytes */
+    uint32_t           pattern;       /* Fill byte repeated in a word */
+    SemaphoreP_Handle  done;          /* Posted if there is no callback */
+} DMA_Transaction;
+
+/*!
+ *  @brief  DMA parameters
+ *
+ *  @sa DMA_Params_init()
+ */
+typedef struct DMA_Params_ {
+    size_t   minTransferSize;  /*!< Smallest transaction moved by the uDMA */
+    bool     highPriority;     /*!< Use the high uDMA priority level */
+    void    *custom;           /*!< Custom argument used by driver
+                                    implementation */
+} DMA_Params;
+
+/*!
+ *  @brief      A function pointer to a driver specific implementation of
+ *              DMA_close().
+ */
+typedef void (*DMA_CloseFxn)(DMA_Handle handle);
+
+/*!
+ *  @brief      A function pointer to a driver specific implementation of
+ *              DMA_init().
+ */
+typedef void (*DMA_InitFxn)(DMA_Handle handle);
+
+/*!
+ *  @brief      A function pointer to a driver specific implementation of
+ *              DMA_open().
+ */
+typedef DMA_Handle (*DMA_OpenFxn)(DMA_Handle handle, DMA_Params *params);
+
+/*!
+ *  @brief      A function pointer to a driver specific function that
+ *              queues a DMA_memcpy() or DMA_memset() transaction of at
+ *              least one byte.
+ */
+typedef int_fast16_t (*DMA_SubmitFxn)(DMA_Handle handle,
+                                      DMA_Transaction *transaction);
+
+/*!
+ *  @brief      The definition of a DMA function table that contains the
+ *              required set of functions to control a specific DMA driver
+ *              implementation.
+ */
+typedef struct DMA_FxnTable_ {
+    DMA_CloseFxn        closeFxn;
+    DMA_InitFxn         initFxn;
+    DMA_OpenFxn         openFxn;
+    DMA_SubmitFxn       submitFxn;
+} DMA_FxnTable;
+
+/*!
+ *  @brief      DMA Global configuration
+ *
+ *  The DMA_Config structure contains a set of pointers used to
+ *  characterize the DMA driver implementation.
+ *
+ *  This structure needs to be defined before calling DMA_init() and
+ *  it must not be changed thereafter.
+ *
+ *  @sa     DMA_init()
+ */
+typedef struct DMA_Config_ {
+    /*! Pointer to a table of driver-specific implementations of DMA APIs */
+    DMA_FxnTable const *fxnTablePtr;
+
+    /*! Pointer to a driver specific data object */
+    void               *object;
+
+    /*! Pointer to a driver specific hardware attributes structure */
+    void         const *hwAttrs;
+} DMA_Config;
+
+/*!
+ *  @brief  Function to close a DMA instance specified by the DMA handle
+ *
+ *  @pre    DMA_open() has to be called first, and every transaction
+ *          submitted on the instance must have completed.
+ *
+ *  @param  handle      A DMA_Handle returned from DMA_open()
+ *
+ *  @sa     DMA_open()
+ */
+extern void DMA_close(DMA_Handle handle);
+
+/*!
+ *  @brief  Function to initialize the DMA module
+ *
+ *  @pre    The DMA_config structure must exist and be persistent before this
+ *          function can be called.  This function must also be called before
+ *          any other DMA driver APIs.
+ */
+extern void DMA_init(void);
+
+/*!
+ *  @brief  Function to copy memory
+ *
+ *  The buffers must not overlap.
+ *
+ *  @param  handle       A DMA_Handle returned from DMA_open()
+ *  @param  transaction  Transaction with callbackFxn and arg set
+ *  @param  dst          Destination buffer
+ *  @param  src          Source buffer
+ *  @param  size         Number of bytes to copy
+ *
+ *  @return DMA_STATUS_SUCCESS
+ */
+extern int_fast16_t DMA_memcpy(DMA_Handle handle,
+    DMA_Transaction *transaction, void *dst, const void *src, size_t size);
+
+/*!
+ *  @brief  Function to fill memory with a byte value
+ *
+ *  @param  handle       A DMA_Handle returned from DMA_open()
+ *  @param  transaction  Transaction with callbackFxn and arg set
+ *  @param  dst          Destination buffer
+ *  @param  value        Fill value, converted to a byte
+ *  @param  size         Number of bytes to fill
+ *
+ *  @return DMA_STATUS_SUCCESS
+ */
+extern int_fast16_t DMA_memset(DMA_Handle handle,
+    DMA_Transaction *transaction, void *dst, int value, size_t size);
+
+/*!
+ *  @brief  Function to open a DMA instance
+ *
+ *  Each open instance moves its transactions on its own channel, one
+ *  transaction at a time.
+ *
+ *  @pre    DMA_init() has to be called first.
+ *
+ *  @param  index       Logical instance number for the DMA indexed into
+ *                      the DMA_config table
+ *
+ *  @param  params      Pointer to a parameter block, if NULL it will use
+ *                      default values.
+ *
+ *  @return A DMA_Handle on success or a NULL on an error, or if no
+ *          channel could be allocated.
+ *
+ *  @sa     DMA_init()
+ *  @sa     DMA_close()
+ */
+extern DMA_Handle DMA_open(uint_least8_t index, DMA_Params *params);
+
+/*!
+ *  @brief  Function to initialize DMA_Params to the defaults
+ *
+ *  Defaults values are:
+ *      minTransferSize = DMA_MIN_TRANSFER_SIZE,
+ *      highPriority = false,
+ *      custom = NULL
+ *
+ *  @param  params  Pointer to the parameters to initialize
+ */
+extern void DMA_Params_init(DMA_Params *params);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ti_drivers_DMA__include */
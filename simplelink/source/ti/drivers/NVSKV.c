@@ -0,0 +1,1044 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== NVSKV.c ========
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <ti/drivers/dpl/SemaphoreP.h>
+#include <ti/drivers/NVS.h>
+#include <ti/drivers/NVSKV.h>
+
+/*
+ *  Flash layout
+ *
+ *  Each sector starts with a SectorHeader. The erase count and magic are
+ *  written right after the sector is erased; the sequence number and check
+ *  word are written when the sector becomes the head of the log. Flash is
+ *  programmed in address order, so a valid magic implies a complete erase
+ *  count. Sequence
+ *  numbers increase by one for each sector taken, and sectors are taken in
+ *  circular order, so the sectors holding records form one circular run
+ *  from the tail to the head with consecutive sequence numbers.
+ *
+ *  Records follow the header back to back, each a RecordHeader followed by
+ *  the data, padded to RECORD_ALIGN. An erased (all 0xFF) record header
+ *  marks the end of the records in a sector. The length is stored twice so
+ *  that the extent of a record whose write was interrupted after the length
+ *  can still be trusted; such a record fails its CRC and is stepped over.
+ *  If the header itself was torn, the damaged bytes are programmed to zero
+ *  and read as filler: RECORD_ALIGN sized units of zeros which are skipped.
+ *  Bit 15 of the key is cleared to mark a key as deleted.
+ */
+#define SECTOR_MAGIC        (0x564B564EU)   /* "NVKV" */
+#define SECTOR_SEQ_FREE     (0xFFFFFFFFU)
+#define SECTOR_CHECK_FREE   (0xFFFFFFFFU)
+
+#define KEY_ERASED          (0xFFFFU)
+#define KEY_LOG             (0xFFFEU)       /* Append log record */
+#define KEY_VALID           (0x8000U)       /* Cleared in key deleted marker */
+#define KEY_MASK            (0x7FFFU)
+
+#define OFFSET_NONE         (0xFFFFFFFFU)
+
+#define RECORD_ALIGN        (sizeof(RecordHeader))
+
+/*
+ *  Erased sectors kept for reclaim() to copy records into. Two, so that a
+ *  reclaim which loses a sector to an interrupted write can still finish.
+ */
+#define RESERVE_SECTORS     (2)
+
+/* Smallest region: the reserve, the head and one sector of values */
+#define MIN_SECTORS         (RESERVE_SECTORS + 2)
+
+/* Size of the bounce buffer used to copy and check records */
+#define CHUNK_WORDS         (8)
+
+/* Sector states returned by readSectorHeader() */
+#define SECTOR_INVALID      (0)   /* Must be erased before use */
+#define SECTOR_ERASED       (1)   /* Erased and ready to be taken */
+#define SECTOR_ACTIVE       (2)   /* Holds records */
+
+#define RECORD_SIZE(len)    (((sizeof(RecordHeader) + (len)) + \
+                                (RECORD_ALIGN - 1)) & ~(RECORD_ALIGN - 1))
+
+#define NEXT_SECTOR(obj, s) ((((s) + 1) == (obj)->numSectors) ? 0 : ((s) + 1))
+#define PREV_SECTOR(obj, s) (((s) == 0) ? ((obj)->numSectors - 1) : ((s) - 1))
+
+typedef struct SectorHeader_ {
+    uint32_t eraseCount;
+    uint32_t magic;
+    uint32_t seq;
+    uint32_t check;       /* ~(magic ^ eraseCount ^ seq) */
+} SectorHeader;
+
+typedef struct RecordHeader_ {
+    uint16_t key;
+    uint16_t length;
+    uint16_t lengthCheck; /* ~length */
+    uint16_t crc;         /* CRC-16 of the fields above and the data */
+} RecordHeader;
+
+static int_fast16_t activateSector(NVSKV_Object *obj, uint_fast16_t sector);
+static int_fast16_t copyRecord(NVSKV_Object *obj, NVSKV_Entry *entry);
+static uint16_t crc16(uint16_t crc, const void *data, size_t length);
+static size_t maxValueLength(NVSKV_Object *obj);
+static int_fast16_t prepareSector(NVSKV_Object *obj, uint_fast16_t sector,
+    uint32_t *eraseCount);
+static int_fast8_t readSectorHeader(NVSKV_Object *obj, uint_fast16_t sector,
+    SectorHeader *header);
+static int_fast16_t reclaim(NVSKV_Object *obj);
+static int_fast16_t reserveSpace(NVSKV_Object *obj, size_t size,
+    bool reclaiming);
+static void recoverHead(NVSKV_Object *obj, size_t offset);
+static void scanSector(NVSKV_Object *obj, uint_fast16_t sector);
+static void skipFailedRecord(NVSKV_Object *obj, size_t written, size_t size);
+static bool verifyRecord(NVSKV_Object *obj, size_t offset,
+    RecordHeader *header);
+static int_fast16_t writeRecord(NVSKV_Object *obj, uint16_t key,
+    const void *buf, size_t length, size_t *offset);
+
+/*
+ *  ======== activateSector ========
+ *  Makes sector the head of the log.
+ */
+static int_fast16_t activateSector(NVSKV_Object *obj, uint_fast16_t sector)
+{
+    int_fast16_t status;
+    uint32_t     eraseCount;
+    uint32_t     seqCheck[2];
+
+    status = prepareSector(obj, sector, &eraseCount);
+    if (status != NVS_STATUS_SUCCESS) {
+        return (status);
+    }
+
+    seqCheck[0] = obj->headSeq + 1;
+    seqCheck[1] = ~(SECTOR_MAGIC ^ eraseCount ^ seqCheck[0]);
+
+    status = NVS_write(obj->nvsHandle, (sector * obj->sectorSize) +
+        offsetof(SectorHeader, seq), seqCheck, sizeof(seqCheck), 0);
+    if (status != NVS_STATUS_SUCCESS) {
+        return (status);
+    }
+
+    obj->headSeq = seqCheck[0];
+    obj->head = sector;
+    obj->headOffset = sizeof(SectorHeader);
+    obj->freeSectors--;
+
+    return (NVS_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== copyRecord ========
+ *  Copies the record entry refers to, unchanged, to the head of the log.
+ */
+static int_fast16_t copyRecord(NVSKV_Object *obj, NVSKV_Entry *entry)
+{
+    uint32_t     chunk[CHUNK_WORDS];
+    size_t       done;
+    size_t       count;
+    size_t       dst;
+    int_fast16_t status;
+
+    status = reserveSpace(obj, entry->size, true);
+    if (status != NVS_STATUS_SUCCESS) {
+        return (status);
+    }
+
+    dst = (obj->head * obj->sectorSize) + obj->headOffset;
+
+    for (done = 0; done < entry->size; done += count) {
+        count = entry->size - done;
+        if (count > sizeof(chunk)) {
+            count = sizeof(chunk);
+        }
+
+        status = NVS_read(obj->nvsHandle, entry->offset + done, chunk, count);
+        if (status == NVS_STATUS_SUCCESS) {
+            status = NVS_write(obj->nvsHandle, dst + done, chunk, count, 0);
+        }
+        if (status != NVS_STATUS_SUCCESS) {
+            skipFailedRecord(obj, done, entry->size);
+            return (status);
+        }
+    }
+
+    obj->headOffset += entry->size;
+    obj->stats.relocatedBytes += entry->size;
+    entry->offset = dst;
+
+    return (NVS_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== crc16 ========
+ *  CRC-16/CCITT, MSB first.
+ */
+static uint16_t crc16(uint16_t crc, const void *data, size_t length)
+{
+    const uint8_t *bytes = data;
+    uint_fast8_t   bit;
+
+    while (length--) {
+        crc ^= (uint16_t)(*bytes++) << 8;
+        for (bit = 0; bit < 8; bit++) {
+            if (crc & 0x8000) {
+                crc = (uint16_t)((crc << 1) ^ 0x1021);
+            }
+            else {
+                crc = (uint16_t)(crc << 1);
+            }
+        }
+    }
+
+    return (crc);
+}
+
+/*
+ *  ======== maxValueLength ========
+ */
+static size_t maxValueLength(NVSKV_Object *obj)
+{
+    size_t length;
+
+    length = obj->sectorSize - sizeof(SectorHeader) - sizeof(RecordHeader);
+
+    return ((length > 0xFFFF) ? 0xFFFF : length);
+}
+
+/*
+ *  ======== prepareSector ========
+ *  Erases sector, unless it already is, and writes the first half of its
+ *  header. Returns the sector's erase count in eraseCount if not NULL.
+ */
+static int_fast16_t prepareSector(NVSKV_Object *obj, uint_fast16_t sector,
+    uint32_t *eraseCount)
+{
+    SectorHeader header;
+    int_fast16_t status;
+
+    if (readSectorHeader(obj, sector, &header) != SECTOR_ERASED) {
+        /* The count is lost if the previous erase was interrupted */
+        if ((header.magic != SECTOR_MAGIC) ||
+            (header.eraseCount > obj->stats.maxEraseCount)) {
+            header.eraseCount = obj->stats.maxEraseCount;
+        }
+        header.eraseCount++;
+
+        status = NVS_erase(obj->nvsHandle, sector * obj->sectorSize,
+            obj->sectorSize);
+        if (status != NVS_STATUS_SUCCESS) {
+            return (status);
+        }
+        obj->stats.erases++;
+        if (header.eraseCount > obj->stats.maxEraseCount) {
+            obj->stats.maxEraseCount = header.eraseCount;
+        }
+
+        header.magic = SECTOR_MAGIC;
+        status = NVS_write(obj->nvsHandle, sector * obj->sectorSize, &header,
+            offsetof(SectorHeader, seq), 0);
+        if (status != NVS_STATUS_SUCCESS) {
+            return (status);
+        }
+    }
+
+    if (eraseCount != NULL) {
+        *eraseCount = header.eraseCount;
+    }
+
+    return (NVS_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== readSectorHeader ========
+ */
+static int_fast8_t readSectorHeader(NVSKV_Object *obj, uint_fast16_t sector,
+    SectorHeader *header)
+{
+    if (NVS_read(obj->nvsHandle, sector * obj->sectorSize, header,
+        sizeof(SectorHeader)) != NVS_STATUS_SUCCESS) {
+        header->magic = ~SECTOR_MAGIC;
+        return (SECTOR_INVALID);
+    }
+
+    if (header->magic != SECTOR_MAGIC) {
+        return (SECTOR_INVALID);
+    }
+
+    if ((header->seq == SECTOR_SEQ_FREE) &&
+        (header->check == SECTOR_CHECK_FREE)) {
+        return (SECTOR_ERASED);
+    }
+
+    if (header->check == ~(header->magic ^ header->eraseCount ^ header->seq)) {
+        return (SECTOR_ACTIVE);
+    }
+
+    return (SECTOR_INVALID);
+}
+
+/*
+ *  ======== reclaim ========
+ *  Copies the current records out of the tail sector and erases it.
+ */
+static int_fast16_t reclaim(NVSKV_Object *obj)
+{
+    uint_fast16_t i;
+    uint_fast16_t sector = obj->tail;
+    size_t        start;
+    size_t        end;
+    int_fast16_t  status;
+
+    if (sector == obj->head) {
+        return (NVSKV_STATUS_FULL);
+    }
+
+    start = sector * obj->sectorSize;
+    end = start + obj->sectorSize;
+
+    /*
+     * Only indexed records are current; superseded values, delete markers
+     * and append log records are dropped.
+     */
+    for (i = 0; i < obj->indexSize; i++) {
+        if ((obj->index[i].offset != OFFSET_NONE) &&
+            (obj->index[i].offset >= start) && (obj->index[i].offset < end)) {
+            status = copyRecord(obj, &obj->index[i]);
+            if (status != NVS_STATUS_SUCCESS) {
+                return (status);
+            }
+        }
+    }
+
+    obj->tail = NEXT_SECTOR(obj, sector);
+    obj->freeSectors++;
+    obj->stats.reclaims++;
+
+    /* Erase now rather than when the log wraps round to the sector */
+    return (prepareSector(obj, sector, NULL));
+}
+
+/*
+ *  ======== recoverHead ========
+ *  Resumes writing to the head after a record whose header was torn at
+ *  offset. Everything from offset up to the erased end of the sector is
+ *  programmed to zero so that it reads as filler.
+ */
+static void recoverHead(NVSKV_Object *obj, size_t offset)
+{
+    uint32_t chunk[CHUNK_WORDS];
+    uint8_t *bytes = (uint8_t *)chunk;
+    size_t   base = obj->head * obj->sectorSize;
+    size_t   end = obj->sectorSize;
+    size_t   count;
+    size_t   i;
+
+    /* Search backwards for the last programmed byte */
+    while (end > offset) {
+        count = end - offset;
+        if (count > sizeof(chunk)) {
+            count = sizeof(chunk);
+        }
+
+        if (NVS_read(obj->nvsHandle, base + end - count, chunk, count) !=
+            NVS_STATUS_SUCCESS) {
+            obj->headOffset = obj->sectorSize;
+            return;
+        }
+
+        for (i = count; (i > 0) && (bytes[i - 1] == 0xFF); i--) {
+        }
+        if (i > 0) {
+            end = end - count + i;
+            break;
+        }
+        end -= count;
+    }
+    end = (end + (RECORD_ALIGN - 1)) & ~(RECORD_ALIGN - 1);
+
+    memset(chunk, 0, sizeof(chunk));
+    for (i = offset; i < end; i += count) {
+        count = end - i;
+        if (count > sizeof(chunk)) {
+            count = sizeof(chunk);
+        }
+
+        if (NVS_write(obj->nvsHandle, base + i, chunk, count, 0) !=
+            NVS_STATUS_SUCCESS) {
+            obj->headOffset = obj->sectorSize;
+            return;
+        }
+    }
+
+    obj->headOffset = end;
+}
+
+/*
+ *  ======== reserveSpace ========
+ *  Makes room for size bytes at the head of the log, moving the head on to
+ *  the next sector if necessary. Outside of reclaim() RESERVE_SECTORS
+ *  erased sectors are always kept for reclaim() to copy records into.
+ */
+static int_fast16_t reserveSpace(NVSKV_Object *obj, size_t size,
+    bool reclaiming)
+{
+    uint_fast16_t attempts;
+    uint_fast16_t reserve;
+    int_fast16_t  status;
+
+    /*
+     * A reclaim() interrupted by a power failure leaves the reserve short;
+     * it is topped up before the next record is written.
+     */
+    reserve = RESERVE_SECTORS - 1;
+    if ((obj->headOffset + size) > obj->sectorSize) {
+        reserve = RESERVE_SECTORS;
+    }
+    else if (reclaiming || (obj->freeSectors > reserve)) {
+        return (NVS_STATUS_SUCCESS);
+    }
+
+    if (!reclaiming) {
+        for (attempts = 0; obj->freeSectors <= reserve; attempts++) {
+            if (attempts == obj->numSectors) {
+                return (NVSKV_STATUS_FULL);
+            }
+
+            status = reclaim(obj);
+            if (status != NVS_STATUS_SUCCESS) {
+                return (status);
+            }
+        }
+
+        /* Reclaiming may have moved the head on already */
+        if ((obj->headOffset + size) <= obj->sectorSize) {
+            return (NVS_STATUS_SUCCESS);
+        }
+    }
+
+    if (obj->freeSectors == 0) {
+        return (NVSKV_STATUS_FULL);
+    }
+
+    return (activateSector(obj, NEXT_SECTOR(obj, obj->head)));
+}
+
+/*
+ *  ======== scanSector ========
+ *  Replays the records of sector into the index. Scanning stops at the
+ *  first record whose length is corrupt; in the head sector that can only
+ *  be a write torn by a power failure, which is recovered from.
+ */
+static void scanSector(NVSKV_Object *obj, uint_fast16_t sector)
+{
+    RecordHeader header;
+    NVSKV_Entry *entry;
+    size_t       base = sector * obj->sectorSize;
+    size_t       offset = sizeof(SectorHeader);
+    size_t       size;
+
+    while ((offset + sizeof(RecordHeader)) <= obj->sectorSize) {
+        if (NVS_read(obj->nvsHandle, base + offset, &header,
+            sizeof(RecordHeader)) != NVS_STATUS_SUCCESS) {
+            offset = obj->sectorSize;
+            break;
+        }
+
+        if ((header.key == 0) && (header.length == 0) &&
+            (header.lengthCheck == 0) && (header.crc == 0)) {
+            /* Filler */
+            offset += RECORD_ALIGN;
+            continue;
+        }
+
+        size = RECORD_SIZE(header.length);
+        if (((header.length ^ header.lengthCheck) != 0xFFFF) ||
+            ((offset + size) > obj->sectorSize)) {
+            if ((header.key == KEY_ERASED) && (header.length == 0xFFFF) &&
+                (header.lengthCheck == 0xFFFF) && (header.crc == 0xFFFF)) {
+                /* End of the records */
+                break;
+            }
+
+            /* Without a trustworthy length the rest of the sector is lost */
+            if (sector == obj->head) {
+                recoverHead(obj, offset);
+                return;
+            }
+            offset = obj->sectorSize;
+            break;
+        }
+
+        /* Interrupted writes are stepped over */
+        if (((header.key & KEY_MASK) < obj->indexSize) &&
+            verifyRecord(obj, base + offset, &header)) {
+            entry = &obj->index[header.key & KEY_MASK];
+            if (entry->offset != OFFSET_NONE) {
+                obj->liveBytes -= entry->size;
+            }
+
+            if ((header.key & KEY_VALID) == 0) {
+                entry->offset = OFFSET_NONE;
+            }
+            else {
+                entry->offset = base + offset;
+                entry->size = size;
+                obj->liveBytes += size;
+            }
+        }
+
+        offset += size;
+    }
+
+    if (sector == obj->head) {
+        obj->headOffset = offset;
+    }
+}
+
+/*
+ *  ======== skipFailedRecord ========
+ *  Moves the head past a record whose write failed after written bytes.
+ *  Once the record header is complete the record is stepped over like one
+ *  torn by a power failure; otherwise the head is recovered.
+ */
+static void skipFailedRecord(NVSKV_Object *obj, size_t written, size_t size)
+{
+    if (written >= sizeof(RecordHeader)) {
+        obj->headOffset += size;
+    }
+    else {
+        recoverHead(obj, obj->headOffset);
+    }
+}
+
+/*
+ *  ======== verifyRecord ========
+ *  Checks the CRC of the record at offset.
+ */
+static bool verifyRecord(NVSKV_Object *obj, size_t offset,
+    RecordHeader *header)
+{
+    uint32_t chunk[CHUNK_WORDS];
+    uint16_t crc;
+    size_t   done;
+    size_t   count;
+
+    crc = crc16(0xFFFF, header, offsetof(RecordHeader, crc));
+    offset += sizeof(RecordHeader);
+
+    for (done = 0; done < header->length; done += count) {
+        count = header->length - done;
+        if (count > sizeof(chunk)) {
+            count = sizeof(chunk);
+        }
+
+        if (NVS_read(obj->nvsHandle, offset + done, chunk, count) !=
+            NVS_STATUS_SUCCESS) {
+            return (false);
+        }
+        crc = crc16(crc, chunk, count);
+    }
+
+    return (crc == header->crc);
+}
+
+/*
+ *  ======== writeRecord ========
+ *  Appends a record at the head of the log; the record's offset is
+ *  returned in offset.
+ */
+static int_fast16_t writeRecord(NVSKV_Object *obj, uint16_t key,
+    const void *buf, size_t length, size_t *offset)
+{
+    RecordHeader header;
+    size_t       size = RECORD_SIZE(length);
+    int_fast16_t status;
+
+    status = reserveSpace(obj, size, false);
+    if (status != NVS_STATUS_SUCCESS) {
+        return (status);
+    }
+
+    header.key = key;
+    header.length = (uint16_t)length;
+    header.lengthCheck = (uint16_t)~length;
+    header.crc = crc16(crc16(0xFFFF, &header, offsetof(RecordHeader, crc)),
+        buf, length);
+
+    *offset = (obj->head * obj->sectorSize) + obj->headOffset;
+
+    status = NVS_write(obj->nvsHandle, *offset, &header, sizeof(header), 0);
+    if (status != NVS_STATUS_SUCCESS) {
+        skipFailedRecord(obj, 0, size);
+        return (status);
+    }
+
+    if (length != 0) {
+        status = NVS_write(obj->nvsHandle, *offset + sizeof(header),
+            (void *)buf, length, 0);
+        if (status != NVS_STATUS_SUCCESS) {
+            skipFailedRecord(obj, sizeof(header), size);
+            return (status);
+        }
+    }
+
+    obj->headOffset += size;
+
+    return (NVS_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== NVSKV_append ========
+ */
+int_fast16_t NVSKV_append(NVSKV_Handle handle, const void *buf, size_t length)
+{
+    size_t       offset;
+    int_fast16_t status;
+
+    if (length > maxValueLength(handle)) {
+        return (NVS_STATUS_INV_SIZE);
+    }
+
+    SemaphoreP_pend(handle->mutex, SemaphoreP_WAIT_FOREVER);
+
+    status = writeRecord(handle, KEY_LOG, buf, length, &offset);
+
+    SemaphoreP_post(handle->mutex);
+
+    return (status);
+}
+
+/*
+ *  ======== NVSKV_compact ========
+ */
+int_fast16_t NVSKV_compact(NVSKV_Handle handle)
+{
+    uint_fast16_t attempts;
+    int_fast16_t  status = NVS_STATUS_SUCCESS;
+
+    SemaphoreP_pend(handle->mutex, SemaphoreP_WAIT_FOREVER);
+
+    /*
+     * Leave enough erased sectors that the head can move on once without
+     * reserveSpace() having to reclaim.
+     */
+    for (attempts = 0; (attempts < handle->numSectors) &&
+        (handle->freeSectors <= RESERVE_SECTORS) &&
+        (status == NVS_STATUS_SUCCESS);
+        attempts++) {
+        status = reclaim(handle);
+    }
+
+    if ((status == NVS_STATUS_SUCCESS) && (handle->freeSectors != 0)) {
+        status = prepareSector(handle, NEXT_SECTOR(handle, handle->head),
+            NULL);
+    }
+
+    SemaphoreP_post(handle->mutex);
+
+    return (status);
+}
+
+/*
+ *  ======== NVSKV_construct ========
+ */
+int_fast16_t NVSKV_construct(NVSKV_Handle handle, NVS_Handle nvsHandle,
+    NVSKV_Entry *index, uint_fast16_t indexSize)
+{
+    NVS_Attrs     attrs;
+    SectorHeader  header;
+    uint_fast16_t i;
+    uint_fast16_t sector;
+    uint_fast16_t active;
+    int_fast8_t   state;
+    bool          found = false;
+
+    NVS_getAttrs(nvsHandle, &attrs);
+
+    memset(handle, 0, sizeof(NVSKV_Object));
+    handle->nvsHandle = nvsHandle;
+    handle->index = index;
+    handle->indexSize = indexSize;
+    handle->sectorSize = attrs.sectorSize;
+
+    if ((attrs.sectorSize <= (sizeof(SectorHeader) + sizeof(RecordHeader))) ||
+        ((attrs.sectorSize % RECORD_ALIGN) != 0) ||
+        ((attrs.regionSize / attrs.sectorSize) < MIN_SECTORS) ||
+        ((attrs.regionSize / attrs.sectorSize) > 0xFFFF) ||
+        (indexSize > (KEY_LOG & KEY_MASK))) {
+        return (NVS_STATUS_INV_SIZE);
+    }
+    handle->numSectors = attrs.regionSize / attrs.sectorSize;
+
+    handle->mutex = SemaphoreP_createBinary(1);
+    if (handle->mutex == NULL) {
+        return (NVS_STATUS_ERROR);
+    }
+
+    for (i = 0; i < indexSize; i++) {
+        index[i].offset = OFFSET_NONE;
+    }
+
+    /* The head is the sector with the highest sequence number */
+    for (sector = 0; sector < handle->numSectors; sector++) {
+        state = readSectorHeader(handle, sector, &header);
+        if ((state != SECTOR_INVALID) &&
+            (header.eraseCount > handle->stats.maxEraseCount)) {
+            handle->stats.maxEraseCount = header.eraseCount;
+        }
+        if ((state == SECTOR_ACTIVE) &&
+            (!found || (header.seq > handle->headSeq))) {
+            handle->head = sector;
+            handle->headSeq = header.seq;
+            found = true;
+        }
+    }
+
+    if (!found) {
+        /* Empty or foreign region; start the log at the first sector */
+        handle->freeSectors = handle->numSectors;
+        handle->tail = 0;
+        if (activateSector(handle, 0) != NVS_STATUS_SUCCESS) {
+            SemaphoreP_delete(handle->mutex);
+            return (NVS_STATUS_ERROR);
+        }
+
+        return (NVS_STATUS_SUCCESS);
+    }
+
+    /* Walk back from the head to the tail */
+    handle->tail = handle->head;
+    for (active = 1; active < handle->numSectors; active++) {
+        sector = PREV_SECTOR(handle, handle->tail);
+        if ((readSectorHeader(handle, sector, &header) != SECTOR_ACTIVE) ||
+            (header.seq != (handle->headSeq - active))) {
+            break;
+        }
+        handle->tail = sector;
+    }
+    handle->freeSectors = handle->numSectors - active;
+
+    /* Rebuild the index, oldest records first */
+    for (sector = handle->tail; active > 0; active--) {
+        scanSector(handle, sector);
+        sector = NEXT_SECTOR(handle, sector);
+    }
+
+    return (NVS_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== NVSKV_delete ========
+ */
+int_fast16_t NVSKV_delete(NVSKV_Handle handle, uint_fast16_t key)
+{
+    NVSKV_Entry  *entry;
+    size_t        offset;
+    int_fast16_t  status;
+
+    if (key >= handle->indexSize) {
+        return (NVSKV_STATUS_INV_KEY);
+    }
+
+    SemaphoreP_pend(handle->mutex, SemaphoreP_WAIT_FOREVER);
+
+    entry = &handle->index[key];
+    if (entry->offset == OFFSET_NONE) {
+        status = NVSKV_STATUS_NOT_FOUND;
+    }
+    else {
+        status = writeRecord(handle, (uint16_t)key & ~KEY_VALID, NULL, 0,
+            &offset);
+        if (status == NVS_STATUS_SUCCESS) {
+            handle->liveBytes -= entry->size;
+            entry->offset = OFFSET_NONE;
+        }
+    }
+
+    SemaphoreP_post(handle->mutex);
+
+    return (status);
+}
+
+/*
+ *  ======== NVSKV_destruct ========
+ */
+void NVSKV_destruct(NVSKV_Handle handle)
+{
+    SemaphoreP_delete(handle->mutex);
+    handle->mutex = NULL;
+}
+
+/*
+ *  ======== NVSKV_format ========
+ */
+int_fast16_t NVSKV_format(NVSKV_Handle handle)
+{
+    uint_fast16_t i;
+    int_fast16_t  status = NVS_STATUS_SUCCESS;
+
+    SemaphoreP_pend(handle->mutex, SemaphoreP_WAIT_FOREVER);
+
+    for (i = 0; (i < handle->numSectors) && (status == NVS_STATUS_SUCCESS);
+        i++) {
+        status = prepareSector(handle, i, NULL);
+    }
+
+    if (status == NVS_STATUS_SUCCESS) {
+        for (i = 0; i < handle->indexSize; i++) {
+            handle->index[i].offset = OFFSET_NONE;
+        }
+        handle->liveBytes = 0;
+        handle->freeSectors = handle->numSectors;
+        handle->tail = 0;
+        status = activateSector(handle, 0);
+    }
+
+    SemaphoreP_post(handle->mutex);
+
+    return (status);
+}
+
+/*
+ *  ======== NVSKV_getStats ========
+ */
+void NVSKV_getStats(NVSKV_Handle handle, NVSKV_Stats *stats)
+{
+    SemaphoreP_pend(handle->mutex, SemaphoreP_WAIT_FOREVER);
+
+    *stats = handle->stats;
+    stats->capacity = (handle->numSectors - MIN_SECTORS + 1) *
+        (handle->sectorSize - sizeof(SectorHeader));
+    stats->liveBytes = handle->liveBytes;
+    stats->freeSectors = handle->freeSectors;
+
+    SemaphoreP_post(handle->mutex);
+}
+
+/*
+ *  ======== NVSKV_initCursor ========
+ */
+void NVSKV_initCursor(NVSKV_Cursor *cursor)
+{
+    cursor->seq = SECTOR_SEQ_FREE;
+    cursor->offset = 0;
+}
+
+/*
+ *  ======== NVSKV_read ========
+ */
+int_fast16_t NVSKV_read(NVSKV_Handle handle, uint_fast16_t key, void *buf,
+    size_t bufSize, size_t *length)
+{
+    RecordHeader  header;
+    NVSKV_Entry  *entry;
+    int_fast16_t  status;
+
+    if (key >= handle->indexSize) {
+        return (NVSKV_STATUS_INV_KEY);
+    }
+
+    SemaphoreP_pend(handle->mutex, SemaphoreP_WAIT_FOREVER);
+
+    entry = &handle->index[key];
+    if (entry->offset == OFFSET_NONE) {
+        status = NVSKV_STATUS_NOT_FOUND;
+    }
+    else {
+        status = NVS_read(handle->nvsHandle, entry->offset, &header,
+            sizeof(header));
+
+        if (status == NVS_STATUS_SUCCESS) {
+            if (bufSize > header.length) {
+                bufSize = header.length;
+            }
+            if (length != NULL) {
+                *length = header.length;
+            }
+
+            status = NVS_read(handle->nvsHandle,
+                entry->offset + sizeof(header), buf, bufSize);
+        }
+    }
+
+    SemaphoreP_post(handle->mutex);
+
+    return (status);
+}
+
+/*
+ *  ======== NVSKV_readLog ========
+ */
+int_fast16_t NVSKV_readLog(NVSKV_Handle handle, NVSKV_Cursor *cursor,
+    void *buf, size_t bufSize, size_t *length)
+{
+    SectorHeader  sectorHeader;
+    RecordHeader  header;
+    uint_fast16_t sector;
+    size_t        end;
+    size_t        size;
+    int_fast16_t  status = NVSKV_STATUS_NOT_FOUND;
+
+    SemaphoreP_pend(handle->mutex, SemaphoreP_WAIT_FOREVER);
+
+    /*
+     * Start again at the tail if the cursor's sector has been reclaimed. A
+     * record can end right at the end of the sector, leaving the offset at
+     * the start of the next one, so the sector is found from the offset's
+     * last byte.
+     */
+    sector = (cursor->offset - 1) / handle->sectorSize;
+    if ((sector >= handle->numSectors) ||
+        (readSectorHeader(handle, sector, &sectorHeader) != SECTOR_ACTIVE) ||
+        (sectorHeader.seq != cursor->seq)) {
+        sector = handle->tail;
+        readSectorHeader(handle, sector, &sectorHeader);
+        cursor->seq = sectorHeader.seq;
+        cursor->offset = (sector * handle->sectorSize) + sizeof(SectorHeader);
+    }
+
+    for (;;) {
+        end = sector * handle->sectorSize;
+        end += (sector == handle->head) ? handle->headOffset :
+            handle->sectorSize;
+
+        while ((cursor->offset + sizeof(RecordHeader)) <= end) {
+            if (NVS_read(handle->nvsHandle, cursor->offset, &header,
+                sizeof(header)) != NVS_STATUS_SUCCESS) {
+                break;
+            }
+
+            if ((header.key == 0) && (header.length == 0) &&
+                (header.lengthCheck == 0) && (header.crc == 0)) {
+                /* Filler */
+                cursor->offset += RECORD_ALIGN;
+                continue;
+            }
+
+            size = RECORD_SIZE(header.length);
+            if ((header.key == KEY_ERASED) ||
+                ((header.length ^ header.lengthCheck) != 0xFFFF) ||
+                ((cursor->offset + size) > end)) {
+                break;
+            }
+
+            if ((header.key == KEY_LOG) &&
+                verifyRecord(handle, cursor->offset, &header)) {
+                if (bufSize > header.length) {
+                    bufSize = header.length;
+                }
+                if (length != NULL) {
+                    *length = header.length;
+                }
+
+                status = NVS_read(handle->nvsHandle,
+                    cursor->offset + sizeof(header), buf, bufSize);
+                if (status == NVS_STATUS_SUCCESS) {
+                    cursor->offset += size;
+                }
+                break;
+            }
+
+            cursor->offset += size;
+        }
+
+        if ((status != NVSKV_STATUS_NOT_FOUND) || (sector == handle->head)) {
+            break;
+        }
+
+        /* Continue with the next sector of the log */
+        sector = NEXT_SECTOR(handle, sector);
+        readSectorHeader(handle, sector, &sectorHeader);
+        cursor->seq = sectorHeader.seq;
+        cursor->offset = (sector * handle->sectorSize) + sizeof(SectorHeader);
+    }
+
+    SemaphoreP_post(handle->mutex);
+
+    return (status);
+}
+
+/*
+ *  ======== NVSKV_write ========
+ */
+int_fast16_t NVSKV_write(NVSKV_Handle handle, uint_fast16_t key,
+    const void *buf, size_t length)
+{
+    NVSKV_Entry  *entry;
+    size_t        offset;
+    size_t        oldSize;
+    size_t        size = RECORD_SIZE(length);
+    size_t        capacity;
+    int_fast16_t  status;
+
+    if (key >= handle->indexSize) {
+        return (NVSKV_STATUS_INV_KEY);
+    }
+
+    if (length > maxValueLength(handle)) {
+        return (NVS_STATUS_INV_SIZE);
+    }
+
+    capacity = (handle->numSectors - MIN_SECTORS + 1) *
+        (handle->sectorSize - sizeof(SectorHeader));
+
+    SemaphoreP_pend(handle->mutex, SemaphoreP_WAIT_FOREVER);
+
+    entry = &handle->index[key];
+    oldSize = (entry->offset == OFFSET_NONE) ? 0 : entry->size;
+
+    if ((handle->liveBytes - oldSize + size) > capacity) {
+        status = NVSKV_STATUS_FULL;
+    }
+    else {
+        status = writeRecord(handle, (uint16_t)key | KEY_VALID, buf, length,
+            &offset);
+        if (status == NVS_STATUS_SUCCESS) {
+            handle->liveBytes = handle->liveBytes - oldSize + size;
+            entry->offset = offset;
+            entry->size = size;
+        }
+    }
+
+    SemaphoreP_post(handle->mutex);
+
+    return (status);
+}
@@ -0,0 +1,356 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/** ============================================================================
+ *  @file       NVSKV.h
+ *
+ *  @brief      Log-structured key/value store on top of the NVS driver
+ *
+ *  The NVSKV header file should be included in an application as follows:
+ *  @code
+ *  #include <ti/drivers/NVS.h>
+ *  #include <ti/drivers/NVSKV.h>
+ *  @endcode
+ *
+ *  # Operation #
+ *
+ *  NVSKV stores small values, addressed by a numeric key, in an NVS region
+ *  without erasing flash on every update. The region is used as a circular
+ *  log of sectors: each NVSKV_write() appends a new record for the key at
+ *  the head of the log and the RAM index is pointed at it, so reads and
+ *  writes never search the flash. Superseded records are left in place.
+ *
+ *  When the log runs out of erased sectors the oldest sector is reclaimed:
+ *  the records in it which are still current are copied to the head and the
+ *  sector is erased. Because sectors are always reclaimed oldest first,
+ *  every sector is erased once per trip around the region, whether the data
+ *  in it is hot or cold, which levels wear across the region. Two sectors
+ *  are always kept in reserve for reclaiming.
+ *
+ *  NVSKV_append() adds records to a separate append-only log held in the
+ *  same region. Log records are read back in order with NVSKV_readLog().
+ *  They are not copied when their sector is reclaimed, so the append log
+ *  behaves as a circular buffer which keeps the most recent entries.
+ *
+ *  Every record carries a CRC. A record is only indexed if its CRC matches,
+ *  so a write which is interrupted by a power failure leaves the previous
+ *  value of the key in place. A reclaim which is interrupted leaves both
+ *  copies of a record in flash; the newer one is used. The erase count of
+ *  each sector is kept in its header.
+ *
+ *  Erasing is confined to reclaiming. Calling NVSKV_compact() when the
+ *  application is idle reclaims and erases sectors ahead of time, so that
+ *  time critical NVSKV_write() calls only program flash.
+ *
+ *  ## Opening the store #
+ *
+ *  @code
+ *  #define NUM_KEYS 32
+ *
+ *  NVSKV_Object kv;
+ *  NVSKV_Entry  kvIndex[NUM_KEYS];
+ *  NVS_Handle   nvsHandle;
+ *  uint32_t     value = 42;
+ *
+ *  nvsHandle = NVS_open(Board_NVS0, NULL);
+ *  if (NVSKV_construct(&kv, nvsHandle, kvIndex, NUM_KEYS) !=
+ *      NVS_STATUS_SUCCESS) {
+ *      // The region is smaller than 4 sectors
+ *      while (1);
+ *  }
+ *
+ *  NVSKV_write(&kv, 3, &value, sizeof(value));
+ *  @endcode
+ *
+ *  Keys range from 0 to indexSize - 1, and indexSize may be at most 32766;
+ *  the index holds one #NVSKV_Entry per key. Keys beyond the index found in
+ *  flash are ignored and dropped the next time their sector is reclaimed.
+ *
+ *  The region must be at least 4 sectors long. The largest value is a
+ *  sector less 32 bytes of headers, and current values may occupy at most
+ *  (sectors - 3) sectors in total. Records are padded to 8 bytes.
+ *
+ *  NVSKV uses only the NVS and SemaphoreP APIs, so it can be run on a host
+ *  against an NVSRAM region.
+ *  ============================================================================
+ */
+
+#ifndef ti_drivers_NVSKV__include
+#define ti_drivers_NVSKV__include
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ti/drivers/dpl/SemaphoreP.h>
+#include <ti/drivers/NVS.h>
+
+/*!
+ *  @brief  The key was never written or has been deleted.
+ */
+#define NVSKV_STATUS_NOT_FOUND      (NVS_STATUS_RESERVED - 0)
+
+/*!
+ *  @brief  There is not enough space in the region for the record.
+ */
+#define NVSKV_STATUS_FULL           (NVS_STATUS_RESERVED - 1)
+
+/*!
+ *  @brief  The key is outside the range of the index.
+ */
+#define NVSKV_STATUS_INV_KEY        (NVS_STATUS_RESERVED - 2)
+
+/*!
+ *  @brief  RAM index entry
+ *
+ *  The application provides an array of these, one per key, to
+ *  NVSKV_construct(). The application must not access the members.
+ */
+typedef struct NVSKV_Entry_ {
+    uint32_t offset;  /* Offset of the current record, or ~0 */
+    uint32_t size;    /* Size of the current record in flash */
+} NVSKV_Entry;
+
+/*!
+ *  @brief  Append log read position
+ *
+ *  Initialize with NVSKV_initCursor() before the first NVSKV_readLog().
+ */
+typedef struct NVSKV_Cursor_ {
+    uint32_t seq;     /* Sequence number of the sector being read */
+    size_t   offset;  /* Offset of the next record to examine */
+} NVSKV_Cursor;
+
+/*!
+ *  @brief  NVSKV statistics
+ *
+ *  @sa NVSKV_getStats()
+ */
+typedef struct NVSKV_Stats_ {
+    size_t   capacity;       /*!< Bytes available to current values */
+    size_t   liveBytes;      /*!< Bytes used by current values */
+    uint32_t freeSectors;    /*!< Sectors not holding any records */
+    uint32_t maxEraseCount;  /*!< Highest erase count of any sector */
+    uint32_t erases;         /*!< Sectors erased since construct */
+    uint32_t reclaims;       /*!< Sectors reclaimed since construct */
+    uint32_t relocatedBytes; /*!< Bytes copied by reclaiming */
+} NVSKV_Stats;
+
+/*!
+ *  @brief  NVSKV Object
+ *
+ *  The application must not access any member variables of this structure!
+ */
+typedef struct NVSKV_Object_ {
+    NVS_Handle         nvsHandle;
+    SemaphoreP_Handle  mutex;
+    NVSKV_Entry       *index;
+    uint_fast16_t      indexSize;
+    size_t             sectorSize;
+    uint_fast16_t      numSectors;
+    uint_fast16_t      head;         /* Sector records are appended to */
+    uint_fast16_t      tail;         /* Oldest sector holding records */
+    size_t             headOffset;   /* Write offset within the head */
+    uint32_t           headSeq;      /* Sequence number of the head */
+    uint_fast16_t      freeSectors;
+    size_t             liveBytes;
+    NVSKV_Stats        stats;
+} NVSKV_Object, *NVSKV_Handle;
+
+/*!
+ *  @brief  Function to append a record to the append log.
+ *
+ *  @param  handle  Pointer to a constructed NVSKV_Object
+ *
+ *  @param  buf     Data to append
+ *
+ *  @param  length  Number of bytes to append
+ *
+ *  @return NVS_STATUS_SUCCESS, NVS_STATUS_INV_SIZE if the record is larger
+ *          than a sector, NVSKV_STATUS_FULL or an NVS error code.
+ *
+ *  @sa NVSKV_readLog()
+ */
+extern int_fast16_t NVSKV_append(NVSKV_Handle handle, const void *buf,
+    size_t length);
+
+/*!
+ *  @brief  Function to reclaim sectors ahead of time.
+ *
+ *  Reclaims and erases old sectors so that the next sector the log moves
+ *  on to is already erased and does not require a reclaim. Call this when
+ *  the application can tolerate the erase time.
+ *
+ *  @param  handle  Pointer to a constructed NVSKV_Object
+ *
+ *  @return NVS_STATUS_SUCCESS or an NVS error code.
+ */
+extern int_fast16_t NVSKV_compact(NVSKV_Handle handle);
+
+/*!
+ *  @brief  Function to mount a key/value store on an NVS region.
+ *
+ *  Scans the region and rebuilds the RAM index from the records found. A
+ *  region which holds no NVSKV data is formatted as it is used.
+ *
+ *  @param  handle     Pointer to an NVSKV_Object to construct
+ *
+ *  @param  nvsHandle  An NVS handle returned from NVS_open()
+ *
+ *  @param  index      Array of indexSize entries used as the RAM index
+ *
+ *  @param  indexSize  Number of keys
+ *
+ *  @return NVS_STATUS_SUCCESS, NVS_STATUS_INV_SIZE if the region is smaller
+ *          than 4 sectors, or NVS_STATUS_ERROR.
+ */
+extern int_fast16_t NVSKV_construct(NVSKV_Handle handle, NVS_Handle nvsHandle,
+    NVSKV_Entry *index, uint_fast16_t indexSize);
+
+/*!
+ *  @brief  Function to delete a key.
+ *
+ *  @param  handle  Pointer to a constructed NVSKV_Object
+ *
+ *  @param  key     Key to delete
+ *
+ *  @return NVS_STATUS_SUCCESS, NVSKV_STATUS_NOT_FOUND,
+ *          NVSKV_STATUS_INV_KEY or an NVS error code.
+ */
+extern int_fast16_t NVSKV_delete(NVSKV_Handle handle, uint_fast16_t key);
+
+/*!
+ *  @brief  Function to release the resources of an NVSKV_Object.
+ *
+ *  The NVS region is left as is and can be mounted again.
+ *
+ *  @param  handle  Pointer to a constructed NVSKV_Object
+ */
+extern void NVSKV_destruct(NVSKV_Handle handle);
+
+/*!
+ *  @brief  Function to erase the whole store.
+ *
+ *  @param  handle  Pointer to a constructed NVSKV_Object
+ *
+ *  @return NVS_STATUS_SUCCESS or an NVS error code.
+ */
+extern int_fast16_t NVSKV_format(NVSKV_Handle handle);
+
+/*!
+ *  @brief  Function to read the NVSKV statistics.
+ *
+ *  @param  handle  Pointer to a constructed NVSKV_Object
+ *
+ *  @param  stats   Pointer to a NVSKV_Stats structure to fill in
+ */
+extern void NVSKV_getStats(NVSKV_Handle handle, NVSKV_Stats *stats);
+
+/*!
+ *  @brief  Function to position a cursor at the oldest append log record.
+ *
+ *  @param  cursor  Pointer to the cursor to initialize
+ */
+extern void NVSKV_initCursor(NVSKV_Cursor *cursor);
+
+/*!
+ *  @brief  Function to read the current value of a key.
+ *
+ *  @param  handle   Pointer to a constructed NVSKV_Object
+ *
+ *  @param  key      Key to read
+ *
+ *  @param  buf      Buffer to read the value into
+ *
+ *  @param  bufSize  Size of buf; a longer value is truncated
+ *
+ *  @param  length   Set to the length of the value; may be NULL
+ *
+ *  @return NVS_STATUS_SUCCESS, NVSKV_STATUS_NOT_FOUND,
+ *          NVSKV_STATUS_INV_KEY or an NVS error code.
+ */
+extern int_fast16_t NVSKV_read(NVSKV_Handle handle, uint_fast16_t key,
+    void *buf, size_t bufSize, size_t *length);
+
+/*!
+ *  @brief  Function to read the next append log record.
+ *
+ *  If the records the cursor points at have been reclaimed, reading resumes
+ *  at the oldest record remaining.
+ *
+ *  @param  handle   Pointer to a constructed NVSKV_Object
+ *
+ *  @param  cursor   Read position; advanced past the record returned
+ *
+ *  @param  buf      Buffer to read the record into
+ *
+ *  @param  bufSize  Size of buf; a longer record is truncated
+ *
+ *  @param  length   Set to the length of the record; may be NULL
+ *
+ *  @return NVS_STATUS_SUCCESS, NVSKV_STATUS_NOT_FOUND if there are no more
+ *          records, or an NVS error code.
+ *
+ *  @sa NVSKV_initCursor()
+ */
+extern int_fast16_t NVSKV_readLog(NVSKV_Handle handle, NVSKV_Cursor *cursor,
+    void *buf, size_t bufSize, size_t *length);
+
+/*!
+ *  @brief  Function to write the value of a key.
+ *
+ *  Appends a record to the log; flash is only erased if a sector has to be
+ *  reclaimed to make room.
+ *
+ *  @param  handle  Pointer to a constructed NVSKV_Object
+ *
+ *  @param  key     Key to write
+ *
+ *  @param  buf     New value
+ *
+ *  @param  length  Length of the new value in bytes
+ *
+ *  @return NVS_STATUS_SUCCESS, NVSKV_STATUS_INV_KEY, NVS_STATUS_INV_SIZE if
+ *          the value is larger than a sector, NVSKV_STATUS_FULL or an NVS
+ *          error code.
+ */
+extern int_fast16_t NVSKV_write(NVSKV_Handle handle, uint_fast16_t key,
+    const void *buf, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ti_drivers_NVSKV__include */
@@ -148,6 +148,28 @@ int_fast16_t SD_read(SD_Handle handle, void *buf,
     return (handle->fxnTablePtr->readFxn(handle, buf, sector, secCount));
 }
 
+/*
+ *  ======== SD_readAsync ========
+ */
+int_fast16_t SD_readAsync(SD_Handle handle, SD_Transaction *transaction)
+{
+    if (transaction->callbackFxn == NULL) {
+        return (SD_STATUS_ERROR);
+    }
+
+    if (handle->fxnTablePtr->readAsyncFxn == NULL) {
+        /* Not supported by the implementation; complete the read now */
+        transaction->isWrite = false;
+        transaction->status = handle->fxnTablePtr->readFxn(handle,
+            transaction->buf, transaction->sector, transaction->secCount);
+        transaction->callbackFxn(handle, transaction);
+
+        return (SD_STATUS_SUCCESS);
+    }
+
+    return (handle->fxnTablePtr->readAsyncFxn(handle, transaction));
+}
+
 /*
  *  ======== SD_write ========
  */
@@ -156,3 +178,25 @@ int_fast16_t SD_write(SD_Handle handle, const void *buf,
 {
     return (handle->fxnTablePtr->writeFxn(handle, buf, sector, secCount));
 }
+
+/*
+ *  ======== SD_writeAsync ========
+ */
+int_fast16_t SD_writeAsync(SD_Handle handle, SD_Transaction *transaction)
+{
+    if (transaction->callbackFxn == NULL) {
+        return (SD_STATUS_ERROR);
+    }
+
+    if (handle->fxnTablePtr->writeAsyncFxn == NULL) {
+        /* Not supported by the implementation; complete the write now */
+        transaction->isWrite = true;
+        transaction->status = handle->fxnTablePtr->writeFxn(handle,
+            transaction->buf, transaction->sector, transaction->secCount);
+        transaction->callbackFxn(handle, transaction);
+
+        return (SD_STATUS_SUCCESS);
+    }
+
+    return (handle->fxnTablePtr->writeAsyncFxn(handle, transaction));
+}
@@ -57,6 +57,35 @@
  *  }
  *  @endcode
  *
+ *  ## Asynchronous transfers #
+ *
+ *  SD_readAsync() & SD_writeAsync() queue a transfer described by a
+ *  #SD_Transaction & return immediately.  The transaction's callback
+ *  function is called (possibly from an interrupt context) once the transfer
+ *  has completed; transaction.status then holds the result.  Transactions
+ *  are processed in the order in which they were submitted.  Implementations
+ *  which do not support asynchronous transfers perform the transfer before
+ *  SD_readAsync()/SD_writeAsync() return.
+ *
+ *  @code
+ *  void writeDone(SD_Handle handle, SD_Transaction *transaction)
+ *  {
+ *      if (transaction->status != SD_STATUS_SUCCESS) {
+ *          // Handle the error
+ *      }
+ *  }
+ *
+ *  SD_Transaction transaction;
+ *
+ *  transaction.buf = frame;
+ *  transaction.sector = nextSector;
+ *  transaction.secCount = FRAME_SECTORS;
+ *  transaction.callbackFxn = writeDone;
+ *  transaction.arg = NULL;
+ *
+ *  SD_writeAsync(handle, &transaction);
+ *  @endcode
+ *
  *  # Implementation #
  *
  *  This module serves as the main interface for TI-RTOS applications. Its
@@ -92,8 +121,11 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
 #include <stdint.h>
 
+#include <ti/drivers/utils/List.h>
+
 /**
  *  @defgroup SD_CONTROL SD_control command and status codes
  *  @{
@@ -202,6 +234,48 @@ typedef struct SD_Params_ {
     void   *custom;  /*!< Custom argument used by driver implementation */
 } SD_Params;
 
+/*!
+ *  @brief  A structure describing an asynchronous SD transfer
+ *
+ *  The transaction must remain valid (along with the buffer it points to)
+ *  until its callback function has been called.
+ *
+ *  @sa SD_readAsync()
+ *  @sa SD_writeAsync()
+ */
+typedef struct SD_Transaction_ SD_Transaction;
+
+/*!
+ *  @brief  SD callback function
+ *
+ *  Called when an asynchronous transfer has completed; this may be called
+ *  from an interrupt context.
+ *
+ *  @param  handle      A SD handle returned from SD_open()
+ *
+ *  @param  transaction The completed transaction
+ */
+typedef void (*SD_CallbackFxn) (SD_Handle handle,
+    SD_Transaction *transaction);
+
+struct SD_Transaction_ {
+    /*! Used internally to queue transactions */
+    List_Elem       qElem;
+
+    /* User input (write-only) fields */
+    void           *buf;         /*!< Buffer to read data into/write from */
+    int_fast32_t    sector;      /*!< Starting sector on the disk */
+    uint_fast32_t   secCount;    /*!< Number of sectors to transfer */
+    SD_CallbackFxn  callbackFxn; /*!< Function called on completion */
+    void           *arg;         /*!< Argument available to callbackFxn */
+
+    /* User output (read-only) fields */
+    int_fast16_t    status;      /*!< SD_STATUS_SUCCESS or SD_STATUS_ERROR */
+
+    /*! Used internally by the driver to hold the transfer direction */
+    bool            isWrite;
+};
+
 /*!
  *  @brief A function pointer to a driver specific implementation of
  *         SD_CloseFxn().
@@ -259,6 +333,20 @@ typedef int_fast16_t (*SD_ReadFxn) (SD_Handle handle, void *buf,
 typedef int_fast16_t (*SD_WriteFxn) (SD_Handle handle, const void *buf,
     int_fast32_t sector, uint_fast32_t secCount);
 
+/*!
+ *  @brief A function pointer to a driver specific implementation of
+ *         SD_readAsync().
+ */
+typedef int_fast16_t (*SD_ReadAsyncFxn) (SD_Handle handle,
+    SD_Transaction *transaction);
+
+/*!
+ *  @brief A function pointer to a driver specific implementation of
+ *         SD_writeAsync().
+ */
+typedef int_fast16_t (*SD_WriteAsyncFxn) (SD_Handle handle,
+    SD_Transaction *transaction);
+
 /*!
  *  @brief The definition of a SD function table that contains the
  *         required set of functions to control a specific SD driver
@@ -283,6 +371,16 @@ typedef struct SD_FxnTable_ {
     SD_ReadFxn              readFxn;
     /*! Function to write to the SD card */
     SD_WriteFxn             writeFxn;
+    /*!
+     *  Function to queue a read from the SD card; NULL if the implementation
+     *  does not support asynchronous transfers
+     */
+    SD_ReadAsyncFxn         readAsyncFxn;
+    /*!
+     *  Function to queue a write to the SD card; NULL if the implementation
+     *  does not support asynchronous transfers
+     */
+    SD_WriteAsyncFxn        writeAsyncFxn;
 } SD_FxnTable;
 
 /*!
@@ -461,6 +559,30 @@ extern SD_Handle SD_open(uint_least8_t index, SD_Params *params);
 extern int_fast16_t SD_read(SD_Handle handle, void *buf,
     int_fast32_t sector, uint_fast32_t secCount);
 
+/*!
+ *  @brief Function to queue a read from the SD card.
+ *
+ *  The read is described by @p transaction; its callbackFxn is called once
+ *  the data has been read & transaction->status is set.  Adjacent queued
+ *  transfers may be combined by the implementation into a single multi-block
+ *  transfer on the card.
+ *
+ *  @pre SD controller has been opened and initialized by calling SD_open()
+ *       followed by SD_initialize().
+ *
+ *  @param handle A SD handle returned from SD_open().
+ *
+ *  @param transaction Pointer to a SD_Transaction; callbackFxn must not be
+ *                     NULL.
+ *
+ *  @return SD_STATUS_SUCCESS if the transaction was queued (or completed),
+ *          SD_STATUS_ERROR if the transaction is invalid.
+ *
+ *  @sa SD_writeAsync()
+ */
+extern int_fast16_t SD_readAsync(SD_Handle handle,
+    SD_Transaction *transaction);
+
 /*!
  *  @brief A function pointer to a driver specific implementation of
  *         SD_write().
@@ -484,6 +606,30 @@ extern int_fast16_t SD_read(SD_Handle handle, void *buf,
 extern int_fast16_t SD_write(SD_Handle handle, const void *buf,
     int_fast32_t sector, uint_fast32_t secCount);
 
+/*!
+ *  @brief Function to queue a write to the SD card.
+ *
+ *  The write is described by @p transaction; its callbackFxn is called once
+ *  the data has been written & transaction->status is set.  Adjacent queued
+ *  transfers may be combined by the implementation into a single multi-block
+ *  transfer on the card.
+ *
+ *  @pre SD controller has been opened and initialized by calling SD_open()
+ *       followed by SD_initialize().
+ *
+ *  @param handle A SD handle returned from SD_open().
+ *
+ *  @param transaction Pointer to a SD_Transaction; callbackFxn must not be
+ *                     NULL.
+ *
+ *  @return SD_STATUS_SUCCESS if the transaction was queued (or completed),
+ *          SD_STATUS_ERROR if the transaction is invalid.
+ *
+ *  @sa SD_readAsync()
+ */
+extern int_fast16_t SD_writeAsync(SD_Handle handle,
+    SD_Transaction *transaction);
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,8 +45,11 @@
 #define DebugP_LOG_ENABLED 0
 #endif
 
+#include <string.h>
+
 #include <ti/drivers/dpl/DebugP.h>
 #include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/dpl/SemaphoreP.h>
 #include <ti/drivers/SD.h>
 #include <ti/drivers/SDFatFS.h>
 
@@ -55,6 +58,23 @@
 /* SDFatFS Specific Defines */
 #define DRIVE_NOT_MOUNTED    (~(0U))
 
+#if (SDFatFS_CACHE_SECTORS > 0)
+#if (SDFatFS_READ_AHEAD_SECTORS >= SDFatFS_CACHE_SECTORS)
+#error "SDFatFS_READ_AHEAD_SECTORS must be smaller than SDFatFS_CACHE_SECTORS"
+#endif
+
+#define CACHE_LINE_NONE      (-1)
+
+static int_fast8_t cacheAlloc(SDFatFS_Object *obj, uint32_t sector);
+static int_fast8_t cacheFind(SDFatFS_Object *obj, uint32_t sector);
+static int_fast16_t cacheFlush(SDFatFS_Object *obj);
+static void cacheInvalidate(SDFatFS_Object *obj);
+static DRESULT cacheRead(SDFatFS_Object *obj, BYTE *buffer, uint32_t sector);
+static int_fast16_t cacheTransfer(SDFatFS_Object *obj,
+    const int_fast8_t *lines, uint_fast8_t count, bool isWrite);
+static void cacheXferCallback(SD_Handle handle, SD_Transaction *transaction);
+#endif
+
 extern const SDFatFS_Config SDFatFS_config[];
 extern const uint_least8_t SDFatFS_count;
 
@@ -76,6 +96,277 @@ DSTATUS SDFatFS_diskStatus(BYTE drive);
 DRESULT SDFatFS_diskWrite(BYTE drive, const BYTE *buffer,
     DWORD sector, UINT secCount);
 
+#if (SDFatFS_CACHE_SECTORS > 0)
+/*
+ *  ======== cacheAlloc ========
+ *  Claims a cache line for sector, evicting the least recently used line.
+ *  A dirty victim is written back first. The returned line is marked valid
+ *  and most recently used; its contents are left for the caller to fill.
+ */
+static int_fast8_t cacheAlloc(SDFatFS_Object *obj, uint32_t sector)
+{
+    int_fast8_t        i;
+    int_fast8_t        victim = 0;
+    int_fast16_t       result;
+    SDFatFS_CacheLine *line;
+
+    for (i = 0; i < SDFatFS_CACHE_SECTORS; i++) {
+        line = &obj->cacheLine[i];
+        if (!line->valid) {
+            victim = i;
+            break;
+        }
+        if ((obj->useCount - line->lastUse) >
+            (obj->useCount - obj->cacheLine[victim].lastUse)) {
+            victim = i;
+        }
+    }
+
+    line = &obj->cacheLine[victim];
+    if (line->valid && line->dirty) {
+        result = SD_write(obj->sdHandle, obj->cacheData[victim],
+            (int_fast32_t)line->sector, 1);
+        if (result != SD_STATUS_SUCCESS) {
+            DebugP_log1("SDFatFS: Could not write back sector %d",
+                line->sector);
+            return (CACHE_LINE_NONE);
+        }
+        obj->cacheStats.writeBacks++;
+    }
+
+    line->sector = sector;
+    line->valid = true;
+    line->dirty = false;
+    line->lastUse = ++obj->useCount;
+
+    return (victim);
+}
+
+/*
+ *  ======== cacheFind ========
+ *  Returns the cache line holding sector and marks it most recently used,
+ *  or CACHE_LINE_NONE on a miss.
+ */
+static int_fast8_t cacheFind(SDFatFS_Object *obj, uint32_t sector)
+{
+    int_fast8_t i;
+
+    for (i = 0; i < SDFatFS_CACHE_SECTORS; i++) {
+        if (obj->cacheLine[i].valid && (obj->cacheLine[i].sector == sector)) {
+            obj->cacheLine[i].lastUse = ++obj->useCount;
+            return (i);
+        }
+    }
+
+    return (CACHE_LINE_NONE);
+}
+
+/*
+ *  ======== cacheFlush ========
+ *  Writes every dirty cache line back to the card. The lines are queued in
+ *  sector order so adjacent sectors can be merged into multi-block writes by
+ *  drivers that support asynchronous transfers.
+ */
+static int_fast16_t cacheFlush(SDFatFS_Object *obj)
+{
+    int_fast8_t  i;
+    int_fast8_t  j;
+    int_fast8_t  lines[SDFatFS_CACHE_SECTORS];
+    uint_fast8_t count = 0;
+    int_fast16_t result;
+
+    /* Insertion sort the dirty lines by sector */
+    for (i = 0; i < SDFatFS_CACHE_SECTORS; i++) {
+        if (obj->cacheLine[i].valid && obj->cacheLine[i].dirty) {
+            for (j = (int_fast8_t)count; j > 0; j--) {
+                if (obj->cacheLine[lines[j - 1]].sector <
+                    obj->cacheLine[i].sector) {
+                    break;
+                }
+                lines[j] = lines[j - 1];
+            }
+            lines[j] = i;
+            count++;
+        }
+    }
+
+    if (count == 0) {
+        return (SD_STATUS_SUCCESS);
+    }
+
+    result = cacheTransfer(obj, lines, count, true);
+
+    /* Lines that failed to write stay dirty */
+    for (i = 0; i < (int_fast8_t)count; i++) {
+        if (obj->cacheXfer[i].status == SD_STATUS_SUCCESS) {
+            obj->cacheLine[lines[i]].dirty = false;
+            obj->cacheStats.writeBacks++;
+        }
+    }
+
+    return (result);
+}
+
+/*
+ *  ======== cacheInvalidate ========
+ *  Drops every cache line, including dirty ones.
+ */
+static void cacheInvalidate(SDFatFS_Object *obj)
+{
+    uint_fast8_t i;
+
+    for (i = 0; i < SDFatFS_CACHE_SECTORS; i++) {
+        obj->cacheLine[i].valid = false;
+        obj->cacheLine[i].dirty = false;
+    }
+    obj->nextSector = 0;
+}
+
+/*
+ *  ======== cacheRead ========
+ *  Reads a single sector through the cache. A miss that directly follows
+ *  the previous read also fetches up to SDFatFS_READ_AHEAD_SECTORS of the
+ *  following sectors.
+ */
+static DRESULT cacheRead(SDFatFS_Object *obj, BYTE *buffer, uint32_t sector)
+{
+    int_fast8_t  lines[SDFatFS_READ_AHEAD_SECTORS + 1];
+    uint_fast8_t count;
+    uint_fast8_t i;
+    bool         sequential = (sector == obj->nextSector);
+
+    obj->nextSector = sector + 1;
+
+    lines[0] = cacheFind(obj, sector);
+    if (lines[0] != CACHE_LINE_NONE) {
+        obj->cacheStats.hits++;
+        memcpy(buffer, obj->cacheData[lines[0]], SDFatFS_CACHE_SECTOR_SIZE);
+        return (RES_OK);
+    }
+
+    obj->cacheStats.misses++;
+
+    lines[0] = cacheAlloc(obj, sector);
+    if (lines[0] == CACHE_LINE_NONE) {
+        return (RES_ERROR);
+    }
+    count = 1;
+
+    /* Read ahead up to the next sector which is already cached */
+    if (sequential) {
+        while ((count <= SDFatFS_READ_AHEAD_SECTORS) &&
+            (cacheFind(obj, sector + count) == CACHE_LINE_NONE)) {
+            lines[count] = cacheAlloc(obj, sector + count);
+            if (lines[count] == CACHE_LINE_NONE) {
+                break;
+            }
+            count++;
+        }
+    }
+
+    cacheTransfer(obj, lines, count, false);
+
+    /*
+     * Read-ahead past the end of the card fails the whole (merged) transfer;
+     * retry the requested sector on its own.
+     */
+    if ((obj->cacheXfer[0].status != SD_STATUS_SUCCESS) && (count > 1)) {
+        for (i = 1; i < count; i++) {
+            obj->cacheLine[lines[i]].valid = false;
+        }
+        count = 1;
+        cacheTransfer(obj, lines, count, false);
+    }
+
+    for (i = 1; i < count; i++) {
+        if (obj->cacheXfer[i].status == SD_STATUS_SUCCESS) {
+            obj->cacheStats.readAheads++;
+        }
+        else {
+            obj->cacheLine[lines[i]].valid = false;
+        }
+    }
+
+    if (obj->cacheXfer[0].status != SD_STATUS_SUCCESS) {
+        obj->cacheLine[lines[0]].valid = false;
+        return (RES_ERROR);
+    }
+
+    memcpy(buffer, obj->cacheData[lines[0]], SDFatFS_CACHE_SECTOR_SIZE);
+
+    return (RES_OK);
+}
+
+/*
+ *  ======== cacheTransfer ========
+ *  Queues a single-sector transfer for each cache line and waits for all of
+ *  them to complete. Returns SD_STATUS_ERROR if any of them failed; the
+ *  per-line result is left in obj->cacheXfer[].status.
+ */
+static int_fast16_t cacheTransfer(SDFatFS_Object *obj,
+    const int_fast8_t *lines, uint_fast8_t count, bool isWrite)
+{
+    uint_fast8_t    i;
+    uint_fast8_t    submitted;
+    int_fast16_t    result = SD_STATUS_SUCCESS;
+    SD_Transaction *xfer;
+
+    for (submitted = 0; submitted < count; submitted++) {
+        xfer = &obj->cacheXfer[submitted];
+        xfer->buf = obj->cacheData[lines[submitted]];
+        xfer->sector = (int_fast32_t)obj->cacheLine[lines[submitted]].sector;
+        xfer->secCount = 1;
+        xfer->callbackFxn = cacheXferCallback;
+        xfer->arg = obj;
+        xfer->status = SD_STATUS_ERROR;
+
+        if (isWrite) {
+            result = SD_writeAsync(obj->sdHandle, xfer);
+        }
+        else {
+            result = SD_readAsync(obj->sdHandle, xfer);
+        }
+
+        if (result != SD_STATUS_SUCCESS) {
+            break;
+        }
+    }
+
+    /* Mark the transfers which were never queued as failed */
+    for (i = submitted; i < count; i++) {
+        obj->cacheXfer[i].status = SD_STATUS_ERROR;
+    }
+
+    /* Every queued transfer posts cacheSem exactly once */
+    for (i = 0; i < submitted; i++) {
+        SemaphoreP_pend(obj->cacheSem, SemaphoreP_WAIT_FOREVER);
+        if (obj->cacheXfer[i].status != SD_STATUS_SUCCESS) {
+            result = SD_STATUS_ERROR;
+        }
+    }
+
+    return (result);
+}
+
+/*
+ *  ======== cacheXferCallback ========
+ */
+static void cacheXferCallback(SD_Handle handle, SD_Transaction *transaction)
+{
+    SemaphoreP_post(((SDFatFS_Object *)transaction->arg)->cacheSem);
+}
+#endif
+
+/*
+ *  ======== SDFatFS_clearCacheStats ========
+ */
+void SDFatFS_clearCacheStats(SDFatFS_Handle handle)
+{
+    SDFatFS_Object *obj = handle->object;
+
+    memset(&obj->cacheStats, 0, sizeof(obj->cacheStats));
+}
+
 /*
  *  ======== SDFatFS_close ========
  */
@@ -91,6 +382,23 @@ void SDFatFS_close(SDFatFS_Handle handle)
     path[1] = (TCHAR)':';
     path[2] = (TCHAR)'\0';
 
+#if (SDFatFS_CACHE_SECTORS > 0)
+    /* Write back anything FatFs has not synced yet */
+    if ((obj->diskState & (DSTATUS)STA_NOINIT) == 0) {
+        if (cacheFlush(obj) != SD_STATUS_SUCCESS) {
+            DebugP_log1("SDFatFS: Could not flush sector cache @ drive"
+                " number %d", obj->driveNum);
+        }
+    }
+    cacheInvalidate(obj);
+
+    if (obj->cacheSem != NULL) {
+        SemaphoreP_delete(obj->cacheSem);
+        obj->cacheSem = NULL;
+    }
+#endif
+    obj->diskState = STA_NOINIT;
+
     /* Close the SD driver */
     SD_close(obj->sdHandle);
 
@@ -119,6 +427,27 @@ DSTATUS SDFatFS_diskInitialize(BYTE drive)
 {
     int_fast8_t     result;
     SDFatFS_Object *obj = sdFatFSHandles[drive]->object;
+#if (SDFatFS_CACHE_SECTORS > 0)
+    uint_fast8_t    i;
+
+    /*
+     * FatFs has already been told the dirty lines are written, so write
+     * them back while the card is still selected. This only succeeds if the
+     * same card is still present; a swapped card has not been initialized
+     * yet & rejects the writes. Lines which could not be written are dropped
+     * & counted, rather than written to whatever card is inserted now.
+     */
+    if (cacheFlush(obj) != SD_STATUS_SUCCESS) {
+        for (i = 0; i < SDFatFS_CACHE_SECTORS; i++) {
+            if (obj->cacheLine[i].valid && obj->cacheLine[i].dirty) {
+                obj->cacheStats.discards++;
+            }
+        }
+        DebugP_log1("SDFatFS: Discarded dirty sectors, %d in total",
+            obj->cacheStats.discards);
+    }
+    cacheInvalidate(obj);
+#endif
 
     result = SD_initialize(obj->sdHandle);
 
@@ -142,6 +471,12 @@ DRESULT SDFatFS_diskIOctrl(BYTE drive, BYTE ctrl, void *buffer)
 
     switch (ctrl) {
         case CTRL_SYNC:
+#if (SDFatFS_CACHE_SECTORS > 0)
+            if (cacheFlush(obj) != SD_STATUS_SUCCESS) {
+                DebugP_log0("SDFatFS: Disk IO control: sync failed");
+                break;
+            }
+#endif
             fatfsRes = RES_OK;
             break;
 
@@ -183,14 +518,23 @@ DRESULT SDFatFS_diskIOctrl(BYTE drive, BYTE ctrl, void *buffer)
 DRESULT SDFatFS_diskRead(BYTE drive, BYTE *buffer,
     DWORD sector, UINT secCount)
 {
-    int_fast32_t    result;
-    DRESULT         fatfsRes = RES_ERROR;
-    SDFatFS_Object *obj   = sdFatFSHandles[drive]->object;
+    int_fast32_t       result;
+    DRESULT            fatfsRes = RES_ERROR;
+    SDFatFS_Object    *obj   = sdFatFSHandles[drive]->object;
+#if (SDFatFS_CACHE_SECTORS > 0)
+    uint_fast8_t       i;
+    SDFatFS_CacheLine *line;
+#endif
 
     /* Return if disk not initialized */
     if ((obj->diskState & (DSTATUS)STA_NOINIT) != 0) {
         fatfsRes = RES_PARERR;
     }
+#if (SDFatFS_CACHE_SECTORS > 0)
+    else if (secCount == 1) {
+        fatfsRes = cacheRead(obj, buffer, (uint32_t)sector);
+    }
+#endif
     else {
         result = SD_read(obj->sdHandle, (uint_least8_t *)buffer,
             (int_least32_t)sector, (uint_least32_t)secCount);
@@ -198,6 +542,20 @@ DRESULT SDFatFS_diskRead(BYTE drive, BYTE *buffer,
         /* Convert lower level driver status code */
         if (result == SD_STATUS_SUCCESS) {
             fatfsRes = RES_OK;
+
+#if (SDFatFS_CACHE_SECTORS > 0)
+            /* Cached writes the card has not seen yet take precedence */
+            for (i = 0; i < SDFatFS_CACHE_SECTORS; i++) {
+                line = &obj->cacheLine[i];
+                if (line->valid && line->dirty && (line->sector >= sector) &&
+                    (line->sector - sector < secCount)) {
+                    memcpy(buffer + ((line->sector - sector) *
+                        SDFatFS_CACHE_SECTOR_SIZE), obj->cacheData[i],
+                        SDFatFS_CACHE_SECTOR_SIZE);
+                }
+            }
+            obj->nextSector = sector + secCount;
+#endif
         }
     }
 
@@ -224,14 +582,36 @@ DSTATUS SDFatFS_diskStatus(BYTE drive)
 DRESULT SDFatFS_diskWrite(BYTE drive, const BYTE *buffer, DWORD sector,
     UINT secCount)
 {
-    int_fast32_t    result;
-    DRESULT         fatfsRes = RES_ERROR;
-    SDFatFS_Object *obj = sdFatFSHandles[drive]->object;
+    int_fast32_t       result;
+    DRESULT            fatfsRes = RES_ERROR;
+    SDFatFS_Object    *obj = sdFatFSHandles[drive]->object;
+#if (SDFatFS_CACHE_SECTORS > 0)
+    int_fast8_t        i;
+    SDFatFS_CacheLine *line;
+#endif
 
     /* Return if disk not initialized */
     if ((obj->diskState & (DSTATUS)STA_NOINIT) != 0) {
         fatfsRes = RES_PARERR;
     }
+#if (SDFatFS_CACHE_SECTORS > 0)
+    else if (secCount == 1) {
+        /* Write-back: the card is updated on eviction or CTRL_SYNC */
+        i = cacheFind(obj, (uint32_t)sector);
+        if (i != CACHE_LINE_NONE) {
+            obj->cacheStats.hits++;
+        }
+        else {
+            i = cacheAlloc(obj, (uint32_t)sector);
+        }
+
+        if (i != CACHE_LINE_NONE) {
+            memcpy(obj->cacheData[i], buffer, SDFatFS_CACHE_SECTOR_SIZE);
+            obj->cacheLine[i].dirty = true;
+            fatfsRes = RES_OK;
+        }
+    }
+#endif
     else {
         result = SD_write(obj->sdHandle, (const uint_least8_t *)buffer,
             (int_least32_t)sector, (uint_least32_t)secCount);
@@ -239,6 +619,20 @@ DRESULT SDFatFS_diskWrite(BYTE drive, const BYTE *buffer, DWORD sector,
         /* Convert lower level driver status code */
         if (result == SD_STATUS_SUCCESS) {
             fatfsRes = RES_OK;
+
+#if (SDFatFS_CACHE_SECTORS > 0)
+            /* Keep cached copies of the written sectors current */
+            for (i = 0; i < SDFatFS_CACHE_SECTORS; i++) {
+                line = &obj->cacheLine[i];
+                if (line->valid && (line->sector >= sector) &&
+                    (line->sector - sector < secCount)) {
+                    memcpy(obj->cacheData[i], buffer + ((line->sector -
+                        sector) * SDFatFS_CACHE_SECTOR_SIZE),
+                        SDFatFS_CACHE_SECTOR_SIZE);
+                    line->dirty = false;
+                }
+            }
+#endif
         }
     }
 
@@ -246,6 +640,16 @@ DRESULT SDFatFS_diskWrite(BYTE drive, const BYTE *buffer, DWORD sector,
 }
 #endif
 
+/*
+ *  ======== SDFatFS_getCacheStats ========
+ */
+void SDFatFS_getCacheStats(SDFatFS_Handle handle, SDFatFS_CacheStats *stats)
+{
+    SDFatFS_Object *obj = handle->object;
+
+    *stats = obj->cacheStats;
+}
+
 /*
  *  ======== SDFatFS_init ========
  */
@@ -266,6 +670,9 @@ void SDFatFS_init(void)
 
             obj->diskState = STA_NOINIT;
             obj->driveNum = DRIVE_NOT_MOUNTED;
+#if (SDFatFS_CACHE_SECTORS > 0)
+            obj->cacheSem = NULL;
+#endif
         }
 
         /* Initialize the SD Driver */
@@ -316,7 +723,19 @@ SDFatFS_Handle SDFatFS_open(uint_least8_t idx, uint_least8_t drive)
                 /* Error occurred in lower level driver */
                 handle = NULL;
             }
+#if (SDFatFS_CACHE_SECTORS > 0)
+            else if ((obj->cacheSem = SemaphoreP_create(0, NULL)) == NULL) {
+                DebugP_log0("SDFatFS: Could not create cache semaphore");
+                SDFatFS_close(handle);
+                handle = NULL;
+            }
+#endif
             else {
+                memset(&obj->cacheStats, 0, sizeof(obj->cacheStats));
+#if (SDFatFS_CACHE_SECTORS > 0)
+                obj->useCount = 0;
+                cacheInvalidate(obj);
+#endif
 
                 /* Register FATFS Functions */
                 dresult = disk_register(obj->driveNum,
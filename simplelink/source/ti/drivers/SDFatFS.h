@@ -55,6 +55,23 @@
  *  has been successfully called. After the SDFatFS_close API is called,
  *  ensure the application does NOT make any file I/O calls.
  *
+ *  ## Sector cache #
+ *
+ *  Each SDFatFS instance keeps a small LRU cache of ::SDFatFS_CACHE_SECTORS
+ *  sectors in front of the SD driver so that FAT and directory sectors are
+ *  not re-read from the card on every access. Writes are deferred until the
+ *  sector is evicted, FatFs syncs the volume (f_sync(), f_close()) or
+ *  SDFatFS_close() is called; data written with f_write() is therefore only
+ *  guaranteed to be on the card after one of those. Multi-sector transfers
+ *  bypass the cache. Hit and miss counts can be read with
+ *  SDFatFS_getCacheStats().
+ *
+ *  When FatFs re-initializes the drive (e.g. on a remount), dirty sectors
+ *  are first written back to the card. If that fails, because the card was
+ *  removed or swapped, they are dropped & counted in
+ *  SDFatFS_CacheStats.discards; an application that swaps cards should
+ *  sync or close its files beforehand.
+ *
  *  ## Opening the driver #
  *
  *  @code
@@ -94,13 +111,73 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
 #include <stdint.h>
 
+#include <ti/drivers/dpl/SemaphoreP.h>
 #include <ti/drivers/SD.h>
 
 #include <third_party/fatfs/ff.h>
 #include <third_party/fatfs/diskio.h>
 
+/*!
+ *  @brief Number of sectors held in each SDFatFS instance's sector cache
+ *
+ *  The cache sits between FatFs and the SD driver. Single-sector accesses,
+ *  which is how FatFs touches FAT, directory and partial file sectors, are
+ *  served from the cache. Writes are held in the cache (write-back) until
+ *  the sector is evicted or FatFs issues CTRL_SYNC (f_sync(), f_close()).
+ *  Each cache line costs ::SDFatFS_CACHE_SECTOR_SIZE bytes of RAM in the
+ *  SDFatFS_Object. Define as 0 to disable the cache.
+ */
+#ifndef SDFatFS_CACHE_SECTORS
+#define SDFatFS_CACHE_SECTORS         (4)
+#endif
+
+/*!
+ *  @brief Number of sectors to read ahead on a sequential cache miss
+ *
+ *  When a single-sector read misses the cache and directly follows the
+ *  previous read, up to this many following sectors are fetched into the
+ *  cache along with it. Must be smaller than ::SDFatFS_CACHE_SECTORS.
+ *  Define as 0 to disable read-ahead.
+ */
+#ifndef SDFatFS_READ_AHEAD_SECTORS
+#define SDFatFS_READ_AHEAD_SECTORS    (2)
+#endif
+
+/*!
+ *  @brief Size in bytes of a sector cache line
+ */
+#define SDFatFS_CACHE_SECTOR_SIZE     (512)
+
+/*!
+ *  @brief SDFatFS sector cache statistics
+ *
+ *  @sa SDFatFS_getCacheStats()
+ */
+typedef struct SDFatFS_CacheStats_ {
+    uint32_t hits;        /*!< Single-sector accesses served by the cache */
+    uint32_t misses;      /*!< Single-sector reads that went to the card */
+    uint32_t readAheads;  /*!< Sectors fetched speculatively by read-ahead */
+    uint32_t writeBacks;  /*!< Dirty sectors written to the card */
+    uint32_t discards;    /*!< Dirty sectors lost as they could not be
+                               written back on re-initialization */
+} SDFatFS_CacheStats;
+
+#if (SDFatFS_CACHE_SECTORS > 0)
+/*!
+ *  @brief SDFatFS sector cache line
+ *  The application must not access any member variables of this structure!
+ */
+typedef struct SDFatFS_CacheLine_ {
+    uint32_t sector;
+    uint32_t lastUse;  /* Value of useCount at the last access */
+    bool     valid;
+    bool     dirty;
+} SDFatFS_CacheLine;
+#endif
+
 /*!
  *  @brief SDFatFS Object
  *  The application must not access any member variables of this structure!
@@ -110,6 +187,18 @@ typedef struct SDFatFS_Object_ {
     DSTATUS       diskState;
     FATFS         filesystem; /* FATFS data object */
     SD_Handle     sdHandle;
+
+    SDFatFS_CacheStats cacheStats;
+#if (SDFatFS_CACHE_SECTORS > 0)
+    SemaphoreP_Handle  cacheSem;     /* Posted by cache transfer callbacks */
+    uint32_t           useCount;     /* LRU clock */
+    uint32_t           nextSector;   /* Sector following the last read */
+    SDFatFS_CacheLine  cacheLine[SDFatFS_CACHE_SECTORS];
+    SD_Transaction     cacheXfer[SDFatFS_CACHE_SECTORS];
+    /* Word aligned so the lines can be handed to the SD driver's DMA */
+    uint32_t           cacheData[SDFatFS_CACHE_SECTORS]
+                           [SDFatFS_CACHE_SECTOR_SIZE / sizeof(uint32_t)];
+#endif
 } SDFatFS_Object;
 
 /*!
@@ -166,6 +255,32 @@ extern void SDFatFS_close(SDFatFS_Handle handle);
  */
 extern void SDFatFS_init(void);
 
+/*!
+ *  @brief Function to read the sector cache statistics of a SDFatFS
+ *         instance.
+ *
+ *  The counters accumulate from SDFatFS_open() and are cleared by
+ *  SDFatFS_clearCacheStats().
+ *
+ *  @pre SDFatFS_open() had to be called first.
+ *
+ *  @param handle A SDFatFS handle returned from SDFatFS_open
+ *
+ *  @param stats  Pointer to a SDFatFS_CacheStats structure to fill in
+ */
+extern void SDFatFS_getCacheStats(SDFatFS_Handle handle,
+    SDFatFS_CacheStats *stats);
+
+/*!
+ *  @brief Function to clear the sector cache statistics of a SDFatFS
+ *         instance.
+ *
+ *  @pre SDFatFS_open() had to be called first.
+ *
+ *  @param handle A SDFatFS handle returned from SDFatFS_open
+ */
+extern void SDFatFS_clearCacheStats(SDFatFS_Handle handle);
+
 #ifdef __cplusplus
 }
 #endif
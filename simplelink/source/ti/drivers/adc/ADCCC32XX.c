@@ -46,8 +46,12 @@
 #include <ti/drivers/dpl/DebugP.h>
 #include <ti/drivers/dpl/HwiP.h>
 
+#include <ti/drivers/Power.h>
+#include <ti/drivers/power/PowerCC32XX.h>
 #include <ti/drivers/adc/ADCCC32XX.h>
 
+#include <ti/devices/cc32xx/inc/hw_adc.h>
+#include <ti/devices/cc32xx/inc/hw_ints.h>
 #include <ti/devices/cc32xx/inc/hw_memmap.h>
 #include <ti/devices/cc32xx/inc/hw_ocp_shared.h>
 #include <ti/devices/cc32xx/inc/hw_types.h>
@@ -56,6 +60,7 @@
 #include <ti/devices/cc32xx/driverlib/rom_patch.h>
 #include <ti/devices/cc32xx/driverlib/adc.h>
 #include <ti/devices/cc32xx/driverlib/pin.h>
+#include <ti/devices/cc32xx/driverlib/udma.h>
 
 /* Pad configuration register defaults */
 #define PAD_CONFIG_BASE (OCP_SHARED_BASE + OCP_SHARED_O_GPIO_PAD_CONFIG_0)
@@ -66,6 +71,14 @@
 #define PinConfigChannel(config) (((config) >> 8) & 0xff)
 #define PinConfigPin(config) ((config) & 0xff)
 
+/* ADC_CH_n is n * 8; the interrupts and uDMA channels are consecutive */
+#define ChannelIntNum(channel) (INT_ADCCH0 + ((channel) >> 3))
+#define ChannelDmaChannel(channel) (UDMA_CH14_ADC_CH0 + ((channel) >> 3))
+#define ChannelFifoAddr(channel) (ADC_BASE + ADC_O_channel0FIFODATA + (channel))
+
+static void ADCCC32XX_armBuffer(ADC_Handle handle, uint_fast8_t index);
+static void ADCCC32XX_hwiFxn(uintptr_t arg);
+
 void ADCCC32XX_close(ADC_Handle handle);
 int_fast16_t ADCCC32XX_control(ADC_Handle handle, uint_fast16_t cmd, void *arg);
 int_fast16_t ADCCC32XX_convert(ADC_Handle handle, uint16_t *value);
@@ -101,6 +114,8 @@ void ADCCC32XX_close(ADC_Handle handle)
     ADCCC32XX_Object *object = handle->object;
     ADCCC32XX_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
 
+    ADCCC32XX_stopStream(handle);
+
     pin = PinConfigChannel(hwAttrs->adcPin);
 
     key = HwiP_disable();
@@ -143,8 +158,14 @@ int_fast16_t ADCCC32XX_convert(ADC_Handle handle, uint16_t *value)
     uintptr_t                  key;
     uint16_t                   adcSample = 0;
     uint_fast16_t              adcChannel;
+    ADCCC32XX_Object          *object = handle->object;
     ADCCC32XX_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
 
+    /* The uDMA owns the FIFO while streaming */
+    if (object->isStreaming) {
+        return (ADC_STATUS_ERROR);
+    }
+
     adcChannel = PinConfigChannel(hwAttrs->adcPin);
     key = HwiP_disable();
 
@@ -181,6 +202,7 @@ void ADCCC32XX_init(ADC_Handle handle)
 {
     /* Mark the object as available */
     ((ADCCC32XX_Object *) handle->object)->isOpen = false;
+    ((ADCCC32XX_Object *) handle->object)->isStreaming = false;
 }
 
 /*
@@ -228,3 +250,201 @@ ADC_Handle ADCCC32XX_open(ADC_Handle handle, ADC_Params *params)
 
     return (handle);
 }
+
+/*
+ *  ======== ADCCC32XX_StreamParams_init ========
+ */
+void ADCCC32XX_StreamParams_init(ADCCC32XX_StreamParams *params)
+{
+    params->buffers[0] = NULL;
+    params->buffers[1] = NULL;
+    params->count = 0;
+    params->callbackFxn = NULL;
+}
+
+/*
+ *  ======== ADCCC32XX_startStream ========
+ */
+int_fast16_t ADCCC32XX_startStream(ADC_Handle handle,
+    ADCCC32XX_StreamParams *params)
+{
+    uintptr_t                  key;
+    uint32_t                   channel;
+    uint32_t                   dmaChannel;
+    HwiP_Params                hwiParams;
+    ADCCC32XX_Object          *object = handle->object;
+    ADCCC32XX_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
+
+    if ((params->buffers[0] == NULL) || (params->buffers[1] == NULL) ||
+        (params->callbackFxn == NULL) || (params->count == 0) ||
+        (params->count > ADCCC32XX_STREAM_MAX_COUNT)) {
+        return (ADC_STATUS_ERROR);
+    }
+
+    key = HwiP_disable();
+    if (object->isStreaming) {
+        HwiP_restore(key);
+        return (ADC_STATUS_ERROR);
+    }
+    object->isStreaming = true;
+    HwiP_restore(key);
+
+    channel = PinConfigChannel(hwAttrs->adcPin);
+    dmaChannel = ChannelDmaChannel(channel);
+
+    object->dmaHandle = UDMACC32XX_open();
+    if (object->dmaHandle == NULL) {
+        object->isStreaming = false;
+        return (ADC_STATUS_ERROR);
+    }
+
+    /* Reserve the channel so that UDMACC32XX_allocChannel() users skip it */
+    if (UDMACC32XX_allocChannel(object->dmaHandle, &dmaChannel, 1,
+            UDMACC32XX_PRIORITY_DEFAULT) == UDMACC32XX_CHANNEL_NONE) {
+        UDMACC32XX_close(object->dmaHandle);
+        object->isStreaming = false;
+        return (ADC_STATUS_ERROR);
+    }
+
+    HwiP_Params_init(&hwiParams);
+    hwiParams.arg = (uintptr_t) handle;
+    object->hwiHandle = HwiP_create(ChannelIntNum(channel), ADCCC32XX_hwiFxn,
+        &hwiParams);
+    if (object->hwiHandle == NULL) {
+        UDMACC32XX_freeChannel(object->dmaHandle, dmaChannel);
+        UDMACC32XX_close(object->dmaHandle);
+        object->isStreaming = false;
+        return (ADC_STATUS_ERROR);
+    }
+
+    object->buffers[0] = params->buffers[0];
+    object->buffers[1] = params->buffers[1];
+    object->count = params->count;
+    object->callbackFxn = params->callbackFxn;
+    object->nextBuffer = 0;
+
+    /* The uDMA does not run in LPDS */
+    Power_setConstraint(PowerCC32XX_DISALLOW_LPDS);
+
+    /* One FIFO word per request, into alternating buffers */
+    MAP_uDMAChannelControlSet(dmaChannel | UDMA_PRI_SELECT,
+        UDMA_SIZE_32 | UDMA_SRC_INC_NONE | UDMA_DST_INC_32 | UDMA_ARB_1);
+    MAP_uDMAChannelControlSet(dmaChannel | UDMA_ALT_SELECT,
+        UDMA_SIZE_32 | UDMA_SRC_INC_NONE | UDMA_DST_INC_32 | UDMA_ARB_1);
+    ADCCC32XX_armBuffer(handle, 0);
+    ADCCC32XX_armBuffer(handle, 1);
+
+    /* Drop the samples that piled up in the FIFO before the stream */
+    while (MAP_ADCFIFOLvlGet(ADC_BASE, channel) > 0) {
+        MAP_ADCFIFORead(ADC_BASE, channel);
+    }
+
+    MAP_ADCIntClear(ADC_BASE, channel, ADC_DMA_DONE);
+    MAP_ADCIntEnable(ADC_BASE, channel, ADC_DMA_DONE);
+
+    /* A lock is needed because we are accessing shared uDMA registers */
+    key = HwiP_disable();
+    MAP_uDMAChannelEnable(dmaChannel);
+    HwiP_restore(key);
+
+    MAP_ADCDMAEnable(ADC_BASE, channel);
+
+    DebugP_log1("ADC: (%p) stream started", (uintptr_t) handle);
+
+    return (ADC_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== ADCCC32XX_stopStream ========
+ */
+void ADCCC32XX_stopStream(ADC_Handle handle)
+{
+    uintptr_t                  key;
+    uint32_t                   channel;
+    ADCCC32XX_Object          *object = handle->object;
+    ADCCC32XX_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
+
+    channel = PinConfigChannel(hwAttrs->adcPin);
+
+    key = HwiP_disable();
+    if (!object->isStreaming) {
+        HwiP_restore(key);
+        return;
+    }
+    object->isStreaming = false;
+
+    MAP_ADCDMADisable(ADC_BASE, channel);
+    MAP_uDMAChannelDisable(ChannelDmaChannel(channel));
+    MAP_ADCIntDisable(ADC_BASE, channel, ADC_DMA_DONE);
+    MAP_ADCIntClear(ADC_BASE, channel, ADC_DMA_DONE);
+    HwiP_restore(key);
+
+    HwiP_delete(object->hwiHandle);
+    object->hwiHandle = NULL;
+    UDMACC32XX_freeChannel(object->dmaHandle, ChannelDmaChannel(channel));
+    UDMACC32XX_close(object->dmaHandle);
+    object->dmaHandle = NULL;
+
+    Power_releaseConstraint(PowerCC32XX_DISALLOW_LPDS);
+
+    DebugP_log1("ADC: (%p) stream stopped", (uintptr_t) handle);
+}
+
+/*
+ *  ======== ADCCC32XX_armBuffer ========
+ *  Hands a stream buffer to the primary (0) or alternate (1) uDMA control
+ *  structure of the channel.
+ */
+static void ADCCC32XX_armBuffer(ADC_Handle handle, uint_fast8_t index)
+{
+    ADCCC32XX_Object          *object = handle->object;
+    ADCCC32XX_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
+    uint32_t                   channel = PinConfigChannel(hwAttrs->adcPin);
+
+    MAP_uDMAChannelTransferSet(ChannelDmaChannel(channel) |
+        ((index == 0) ? UDMA_PRI_SELECT : UDMA_ALT_SELECT),
+        UDMA_MODE_PINGPONG, (void *) ChannelFifoAddr(channel),
+        object->buffers[index], object->count);
+}
+
+/*
+ *  ======== ADCCC32XX_hwiFxn ========
+ *  The uDMA has filled one or both stream buffers of the channel.
+ */
+static void ADCCC32XX_hwiFxn(uintptr_t arg)
+{
+    ADC_Handle                 handle = (ADC_Handle) arg;
+    ADCCC32XX_Object          *object = handle->object;
+    ADCCC32XX_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
+    uint32_t                   channel = PinConfigChannel(hwAttrs->adcPin);
+    uint32_t                   dmaChannel = ChannelDmaChannel(channel);
+    uint_fast8_t               index;
+    uint_fast8_t               i;
+
+    MAP_ADCIntClear(ADC_BASE, channel, ADC_DMA_DONE);
+
+    if (!object->isStreaming) {
+        return;
+    }
+
+    /* Deliver the filled buffers oldest first and queue them up again */
+    for (i = 0; i < 2; i++) {
+        index = object->nextBuffer;
+        if (MAP_uDMAChannelModeGet(dmaChannel | ((index == 0) ?
+            UDMA_PRI_SELECT : UDMA_ALT_SELECT)) != UDMA_MODE_STOP) {
+            break;
+        }
+
+        object->callbackFxn(handle, object->buffers[index], object->count);
+        ADCCC32XX_armBuffer(handle, index);
+        object->nextBuffer = index ^ 1;
+    }
+
+    /*
+     * If both buffers filled before the interrupt was served, the uDMA
+     * stopped the channel and the FIFO overflowed; resume.
+     */
+    if (!MAP_uDMAChannelIsEnabled(dmaChannel)) {
+        MAP_uDMAChannelEnable(dmaChannel);
+    }
+}
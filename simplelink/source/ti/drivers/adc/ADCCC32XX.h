@@ -44,6 +44,37 @@
  *
  *  Refer to @ref ADC.h for a complete description of APIs & example of use.
  *
+ *  # Streaming #
+ *
+ *  The CC32XX ADC converts its enabled channels continuously, each one
+ *  every 16 microseconds. ADCCC32XX_startStream() has the uDMA move every
+ *  sample of a channel into a pair of application buffers, alternately
+ *  (ping-pong), and calls a callback from interrupt context each time one
+ *  fills. The callback, or whatever it hands the buffer to, must be done
+ *  with it before the other buffer fills, at which point it is reused.
+ *  Several channels can stream at once by starting a stream on each of
+ *  their handles.
+ *
+ *  Streamed samples are the raw 32 bit FIFO words. They keep the ADC
+ *  timer value the hardware stamps on every conversion, so the samples of
+ *  different channels can be aligned and the sampling jitter measured.
+ *  Use ADCCC32XX_SAMPLE_VALUE() and ADCCC32XX_SAMPLE_TIMESTAMP() to
+ *  separate them. A stalled consumer shows as a jump in the timestamps.
+ *
+ *  @code
+ *  ADCCC32XX_StreamParams params;
+ *
+ *  ADCCC32XX_StreamParams_init(&params);
+ *  params.buffers[0] = ping;
+ *  params.buffers[1] = pong;
+ *  params.count = 256;
+ *  params.callbackFxn = samplesReady;
+ *  ADCCC32XX_startStream(adcHandle, &params);
+ *  @endcode
+ *
+ *  While streaming, ADC_convert() on the same handle returns
+ *  ADC_STATUS_ERROR and LPDS is disallowed.
+ *
  *  ============================================================================
  */
 #ifndef ti_drivers_adc_ADCMSP432__include
@@ -57,6 +88,8 @@ extern "C" {
 #include <stdbool.h>
 
 #include <ti/drivers/ADC.h>
+#include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/dma/UDMACC32XX.h>
 
 /*
  *  The bits in the pin mode macros are as follows:
@@ -71,9 +104,50 @@ extern "C" {
 #define ADCCC32XX_PIN_59_CH_2  (ADC_CH_2 << 8) | 0x3a /*!< PIN 59 is used for ADC channel 2 */
 #define ADCCC32XX_PIN_60_CH_3  (ADC_CH_3 << 8) | 0x3b /*!< PIN 60 is used for ADC channel 3 */
 
+/*!
+ *  @brief  Conversion result of a streamed sample
+ */
+#define ADCCC32XX_SAMPLE_VALUE(sample)      (((sample) >> 2) & 0x0FFF)
+
+/*!
+ *  @brief  ADC timer value stamped on a streamed sample
+ */
+#define ADCCC32XX_SAMPLE_TIMESTAMP(sample)  ((uint32_t)(sample) >> 14)
+
+/*!
+ *  @brief  Largest number of samples in a stream buffer (one uDMA transfer)
+ */
+#define ADCCC32XX_STREAM_MAX_COUNT          (1024)
+
 /* ADC function table pointer */
 extern const ADC_FxnTable ADCCC32XX_fxnTable;
 
+/*!
+ *  @brief  Stream callback function
+ *
+ *  Called from interrupt context with a buffer the uDMA has filled.
+ *
+ *  @param  handle   ADC_Handle of the streaming channel
+ *  @param  samples  The filled buffer
+ *  @param  count    Number of samples in the buffer
+ */
+typedef void (*ADCCC32XX_StreamCallbackFxn)(ADC_Handle handle,
+    uint32_t *samples, uint_fast16_t count);
+
+/*!
+ *  @brief  ADCCC32XX stream parameters
+ *
+ *  @sa ADCCC32XX_StreamParams_init()
+ */
+typedef struct ADCCC32XX_StreamParams {
+    /*! The two buffers filled alternately, of count samples each */
+    uint32_t                   *buffers[2];
+    /*! Samples per buffer, at most ::ADCCC32XX_STREAM_MAX_COUNT */
+    uint_fast16_t               count;
+    /*! Called each time a buffer is filled */
+    ADCCC32XX_StreamCallbackFxn callbackFxn;
+} ADCCC32XX_StreamParams;
+
 /*!
  *  @brief  ADCCC32XX Hardware attributes
  *
@@ -111,8 +185,53 @@ typedef struct ADCCC32XX_State {
  */
 typedef struct ADCCC32XX_Object {
     bool              isOpen;
+    bool              isStreaming;
+
+    /* Stream state */
+    HwiP_Handle       hwiHandle;
+    UDMACC32XX_Handle dmaHandle;
+    uint32_t         *buffers[2];
+    uint_fast16_t     count;
+    uint_fast8_t      nextBuffer;    /* Buffer the uDMA completes next */
+    ADCCC32XX_StreamCallbackFxn callbackFxn;
 } ADCCC32XX_Object;
 
+/*!
+ *  @brief  Initialize stream parameters to default values: no buffers,
+ *          count 0 and no callback.
+ *
+ *  @param  params  Pointer to the stream parameters
+ */
+extern void ADCCC32XX_StreamParams_init(ADCCC32XX_StreamParams *params);
+
+/*!
+ *  @brief  Start streaming the samples of a channel into ping-pong buffers
+ *
+ *  @pre    ADC_open() has been called on the handle.
+ *
+ *  @param  handle  ADC_Handle of the channel
+ *  @param  params  Stream parameters; both buffers and the callback must
+ *                  be given
+ *
+ *  @return ADC_STATUS_SUCCESS if the stream was started, else
+ *          ADC_STATUS_ERROR if the parameters are invalid, the channel is
+ *          already streaming or uDMA is not available.
+ *
+ *  @sa ADCCC32XX_stopStream()
+ */
+extern int_fast16_t ADCCC32XX_startStream(ADC_Handle handle,
+    ADCCC32XX_StreamParams *params);
+
+/*!
+ *  @brief  Stop streaming the samples of a channel
+ *
+ *  No callback is called after this function returns. Samples in a
+ *  partially filled buffer are dropped. ADC_close() stops the stream too.
+ *
+ *  @param  handle  ADC_Handle of the channel
+ */
+extern void ADCCC32XX_stopStream(ADC_Handle handle);
+
 #ifdef __cplusplus
 }
 #endif
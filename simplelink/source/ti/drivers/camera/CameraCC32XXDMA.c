@@ -31,6 +31,7 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 
 /*
  * By default disable both asserts and log for this module.
@@ -42,6 +43,7 @@
 #ifndef DebugP_LOG_ENABLED
 #define DebugP_LOG_ENABLED 0
 #endif
+#include <ti/drivers/dpl/ClockP.h>
 #include <ti/drivers/dpl/DebugP.h>
 #include <ti/drivers/dpl/HwiP.h>
 #include <ti/drivers/dpl/SemaphoreP.h>
@@ -65,6 +67,10 @@
 
 #define CAM_BT_CORRECT_EN   0x00001000
 
+/* Bytes moved by one ping-pong burst */
+#define BURST_BYTES \
+    (CameraCC32XXDMA_DMA_TRANSFER_SIZE * sizeof(unsigned long))
+
 /* CameraCC32XXDMA functions */
 void           CameraCC32XXDMA_close(Camera_Handle handle);
 int_fast16_t   CameraCC32XXDMA_control(Camera_Handle handle,
@@ -150,6 +156,160 @@ static void captureSemCallback(Camera_Handle handle, void *buffer, size_t count)
     SemaphoreP_post(object->captureSem);
 }
 
+/*
+ *  ======== streamSetTransfer ========
+ *  Arm the ping (UDMA_PRI_SELECT) or pong (UDMA_ALT_SELECT) structure for
+ *  one burst into dst.
+ */
+static void streamSetTransfer(CameraCC32XXDMA_HWAttrs const *hwAttrs,
+    uint32_t select, void *dst)
+{
+    MAP_uDMAChannelControlSet(hwAttrs->channelIndex | select,
+        UDMA_SIZE_32 | UDMA_SRC_INC_32 | UDMA_DST_INC_32 | UDMA_ARB_8);
+    MAP_uDMAChannelTransferSet(hwAttrs->channelIndex | select,
+        UDMA_MODE_PINGPONG, (void *)CAM_BUFFER_ADDR, dst,
+        CameraCC32XXDMA_DMA_TRANSFER_SIZE);
+}
+
+/*
+ *  ======== streamArm ========
+ *  Start filling a frame buffer: ping takes the first burst and pong the
+ *  second. Called with the channel disabled.
+ */
+static void streamArm(Camera_Handle handle, void *buffer)
+{
+    CameraCC32XXDMA_Object        *object = handle->object;
+    CameraCC32XXDMA_HWAttrs const *hwAttrs = handle->hwAttrs;
+
+    object->captureBuf = buffer;
+    object->frameLength = 0;
+    object->overflow = false;
+    object->cameraDMA_PingPongMode = 0;
+
+    streamSetTransfer(hwAttrs, UDMA_PRI_SELECT, buffer);
+    streamSetTransfer(hwAttrs, UDMA_ALT_SELECT,
+        (uint8_t *)buffer + BURST_BYTES);
+    object->inFlight = 2;
+
+    MAP_uDMAChannelAttributeDisable(hwAttrs->channelIndex,
+        UDMA_ATTR_ALTSELECT);
+    MAP_uDMAChannelEnable(hwAttrs->channelIndex);
+}
+
+/*
+ *  ======== streamDmaDone ========
+ *  Account for the bursts the uDMA has finished, oldest first, and re-arm
+ *  each one further into the frame buffer while there is room. When no
+ *  burst is left armed the frame has either outgrown its buffer or the
+ *  uDMA ran dry before this interrupt was serviced; the rest of the frame
+ *  is lost either way.
+ */
+static void streamDmaDone(Camera_Handle handle)
+{
+    CameraCC32XXDMA_Object        *object = handle->object;
+    CameraCC32XXDMA_HWAttrs const *hwAttrs = handle->hwAttrs;
+    uint32_t                       select;
+    size_t                         offset;
+
+    while (object->inFlight > 0) {
+        select = object->cameraDMA_PingPongMode ?
+            UDMA_ALT_SELECT : UDMA_PRI_SELECT;
+        if (MAP_uDMAChannelModeGet(hwAttrs->channelIndex | select) !=
+            UDMA_MODE_STOP) {
+            break;
+        }
+
+        object->inFlight--;
+        object->frameLength += BURST_BYTES;
+        object->cameraDMA_PingPongMode = !object->cameraDMA_PingPongMode;
+
+        if (object->inFlight == 0) {
+            object->overflow = true;
+            break;
+        }
+
+        /* The other burst is filling the next BURST_BYTES */
+        offset = object->frameLength + BURST_BYTES;
+        if (offset + BURST_BYTES <= object->bufferlength) {
+            streamSetTransfer(hwAttrs, select,
+                (uint8_t *)object->captureBuf + offset);
+            object->inFlight++;
+        }
+    }
+}
+
+/*
+ *  ======== streamFrameEnd ========
+ *  Queue the frame just captured and arm the next free buffer. Without a
+ *  free buffer, or if the frame was cut short, the frame is dropped and
+ *  its buffer reused.
+ */
+static void streamFrameEnd(Camera_Handle handle)
+{
+    CameraCC32XXDMA_Object        *object = handle->object;
+    CameraCC32XXDMA_HWAttrs const *hwAttrs = handle->hwAttrs;
+    CameraCC32XXDMA_Frame         *frame;
+    uint32_t                       select;
+    void                          *next = object->captureBuf;
+
+    MAP_uDMAChannelDisable(hwAttrs->channelIndex);
+
+    /* Count the part of the burst in progress */
+    if (object->inFlight > 0) {
+        select = object->cameraDMA_PingPongMode ?
+            UDMA_ALT_SELECT : UDMA_PRI_SELECT;
+        object->frameLength += BURST_BYTES - sizeof(unsigned long) *
+            MAP_uDMAChannelSizeGet(hwAttrs->channelIndex | select);
+    }
+
+    object->frameNumber++;
+
+    if (object->overflow) {
+        object->streamStats.truncated++;
+    }
+    else if (object->numFree == 0) {
+        object->streamStats.dropped++;
+    }
+    else {
+        frame = &object->readyFrames[(object->readyHead + object->numReady) %
+            CameraCC32XXDMA_STREAM_MAX_BUFFERS];
+        frame->buffer = object->captureBuf;
+        frame->length = object->frameLength;
+        frame->frameNumber = object->frameNumber;
+        frame->timestamp = ClockP_getSystemTicks();
+
+        object->numReady++;
+        if (object->numReady > object->streamStats.maxQueued) {
+            object->streamStats.maxQueued = object->numReady;
+        }
+        object->streamStats.frames++;
+
+        next = object->freeBuffers[--object->numFree];
+        SemaphoreP_post(object->frameSem);
+    }
+
+    streamArm(handle, next);
+}
+
+/*
+ *  ======== streamHwiFxn ========
+ */
+static void streamHwiFxn(Camera_Handle handle, uint32_t status)
+{
+    CameraCC32XXDMA_HWAttrs const *hwAttrs = handle->hwAttrs;
+
+    if (status & CAM_INT_DMA) {
+        MAP_CameraIntClear(hwAttrs->baseAddr, CAM_INT_DMA);
+        streamDmaDone(handle);
+    }
+
+    if (status & CAM_INT_FE) {
+        MAP_CameraIntClear(hwAttrs->baseAddr, CAM_INT_FE);
+        streamDmaDone(handle);
+        streamFrameEnd(handle);
+    }
+}
+
 /*
  *  ======== CameraCC32XXDMA_hwiIntFxn ========
  *  Hwi function that processes Camera interrupts.
@@ -170,20 +330,30 @@ static void CameraCC32XXDMA_hwiIntFxn(uintptr_t arg)
     unsigned long **bufferPtr = (unsigned long**)&object->captureBuf;
 
     status = MAP_CameraIntStatus(hwAttrs->baseAddr);
+
+    if (object->isStreaming) {
+        streamHwiFxn((Camera_Handle)arg, status);
+        return;
+    }
+
     if ((object->cameraDMAxIntrRcvd > 1) && (status & (CAM_INT_FE))) {
         DebugP_log2("Camera:(%p) Interrupt with mask 0x%x",
                hwAttrs->baseAddr,status);
 
         MAP_CameraIntClear(hwAttrs->baseAddr, CAM_INT_FE);
-        object->captureCallback((Camera_Handle)arg, *bufferPtr,
-                                 object->frameLength);
-        DebugP_log2("Camera:(%p) capture finished, %d bytes written",
-                hwAttrs->baseAddr, object->frameLength);
-        object->inUse = 0;
 
-        MAP_CameraCaptureStop(hwAttrs->baseAddr, true);
+        /* Already completed if the buffer filled up before the frame end */
+        if (object->inUse) {
+            object->captureCallback((Camera_Handle)arg, *bufferPtr,
+                                     object->frameLength);
+            DebugP_log2("Camera:(%p) capture finished, %d bytes written",
+                    hwAttrs->baseAddr, object->frameLength);
+            object->inUse = 0;
+
+            MAP_CameraCaptureStop(hwAttrs->baseAddr, true);
 
-        Power_releaseConstraint(PowerCC32XX_DISALLOW_LPDS);
+            Power_releaseConstraint(PowerCC32XX_DISALLOW_LPDS);
+        }
     }
 
     if (status & CAM_INT_DMA) {
@@ -233,10 +403,14 @@ static void CameraCC32XXDMA_hwiIntFxn(uintptr_t arg)
             MAP_uDMAChannelDisable(hwAttrs->channelIndex);
             MAP_CameraIntDisable(hwAttrs->baseAddr, CAM_INT_DMA);
             object->cameraDMA_PingPongMode = 0;
+            if (!object->inUse) {
+                return;
+            }
             object->captureCallback((Camera_Handle)arg, *bufferPtr,
                                      object->frameLength);
             DebugP_log2("Camera:(%p) capture finished, %d bytes written",
                     hwAttrs->baseAddr, object->frameLength);
+            object->inUse = 0;
 
             MAP_CameraCaptureStop(hwAttrs->baseAddr, true);
 
@@ -253,6 +427,7 @@ void CameraCC32XXDMA_init(Camera_Handle handle)
     CameraCC32XXDMA_Object *object = handle->object;
 
     object->opened = false;
+    object->isStreaming = false;
 }
 
 /*
@@ -270,6 +445,8 @@ Camera_Handle CameraCC32XXDMA_open(Camera_Handle handle, Camera_Params *params)
     unsigned long                  pixelClkConfig;
     HwiP_Params                    hwiParams;
     SemaphoreP_Params              semParams;
+    UDMACC32XX_Handle              dmaHandle;
+    uint32_t                       dmaChannel = hwAttrs->channelIndex;
 
     /* Timeouts cannot be 0 */
     DebugP_assert((params->captureTimeout != 0));
@@ -301,6 +478,12 @@ Camera_Handle CameraCC32XXDMA_open(Camera_Handle handle, Camera_Params *params)
     object->bufferlength = 0;
     object->frameLength  = 0;
     object->inUse        = 0;
+    object->isStreaming  = false;
+    object->captureSem   = NULL;
+    object->frameSem     = NULL;
+    object->hwiHandle    = NULL;
+    object->dmaHandle    = NULL;
+    memset(&object->streamStats, 0, sizeof(object->streamStats));
 
     /*
      *  Register power dependency. Keeps the clock running in SLP
@@ -309,6 +492,20 @@ Camera_Handle CameraCC32XXDMA_open(Camera_Handle handle, Camera_Params *params)
     Power_setDependency(PowerCC32XX_PERIPH_CAMERA);
     Power_setDependency(PowerCC32XX_PERIPH_UDMA);
 
+    /* Reserve the channel so that UDMACC32XX_allocChannel() users skip it */
+    dmaHandle = UDMACC32XX_open();
+    if (dmaHandle == NULL) {
+        CameraCC32XXDMA_close(handle);
+        return (NULL);
+    }
+    if (UDMACC32XX_allocChannel(dmaHandle, &dmaChannel, 1,
+            UDMACC32XX_PRIORITY_DEFAULT) == UDMACC32XX_CHANNEL_NONE) {
+        UDMACC32XX_close(dmaHandle);
+        CameraCC32XXDMA_close(handle);
+        return (NULL);
+    }
+    object->dmaHandle = dmaHandle;
+
     /* Disable the Camera interrupt. */
     MAP_CameraIntDisable(hwAttrs->baseAddr, (CAM_INT_FE | CAM_INT_DMA));
 
@@ -341,6 +538,14 @@ Camera_Handle CameraCC32XXDMA_open(Camera_Handle handle, Camera_Params *params)
         object->captureCallback = &captureSemCallback;
     }
 
+    /* Counts the frames waiting in a stream's frame queue */
+    semParams.mode = SemaphoreP_Mode_COUNTING;
+    object->frameSem = SemaphoreP_create(0, &semParams);
+    if (object->frameSem == NULL) {
+        CameraCC32XXDMA_close(handle);
+        return (NULL);
+    }
+
     MAP_CameraReset(hwAttrs->baseAddr);
 
     if (params->hsyncPolarity == Camera_HSYNC_POLARITY_HIGH) {
@@ -407,6 +612,8 @@ void CameraCC32XXDMA_close(Camera_Handle handle)
     CameraCC32XXDMA_Object           *object = handle->object;
     CameraCC32XXDMA_HWAttrs const    *hwAttrs = handle->hwAttrs;
 
+    CameraCC32XXDMA_stopStream(handle);
+
     /* Disable Camera and interrupts. */
     MAP_CameraIntDisable(hwAttrs->baseAddr,CAM_INT_FE);
     MAP_CameraDMADisable(hwAttrs->baseAddr);
@@ -417,6 +624,14 @@ void CameraCC32XXDMA_close(Camera_Handle handle)
     if (object->captureSem) {
         SemaphoreP_delete(object->captureSem);
     }
+    if (object->frameSem) {
+        SemaphoreP_delete(object->frameSem);
+    }
+    if (object->dmaHandle) {
+        UDMACC32XX_freeChannel(object->dmaHandle, hwAttrs->channelIndex);
+        UDMACC32XX_close(object->dmaHandle);
+        object->dmaHandle = NULL;
+    }
 
     Power_releaseDependency(PowerCC32XX_PERIPH_CAMERA);
     Power_releaseDependency(PowerCC32XX_PERIPH_UDMA);
@@ -477,21 +692,223 @@ int_fast16_t CameraCC32XXDMA_capture(Camera_Handle handle, void *buffer,
    /* If operationMode is blocking, block and get the status. */
    if (object->operationMode == Camera_MODE_BLOCKING) {
        /* Pend on semaphore and wait for Hwi to finish. */
-       if (SemaphoreP_OK == SemaphoreP_pend(object->captureSem,
+       if (SemaphoreP_OK != SemaphoreP_pend(object->captureSem,
                    object->captureTimeout)) {
-
-           DebugP_log2("Camera:(%p) Capture timed out, %d bytes captured",
-                          ((CameraCC32XXDMA_HWAttrs const *)
-                          (handle->hwAttrs))->baseAddr,
-                          object->frameLength);
-       }
-       else {
-           MAP_CameraCaptureStop(hwAttrs->baseAddr, true);
-           *frameLen = object->frameLength;
-           return (CAMERA_STATUS_SUCCESS);
+           key = HwiP_disable();
+           if (object->inUse) {
+               /* Still capturing; abandon the frame */
+               MAP_CameraCaptureStop(hwAttrs->baseAddr, true);
+               MAP_uDMAChannelDisable(hwAttrs->channelIndex);
+               MAP_CameraIntDisable(hwAttrs->baseAddr, CAM_INT_DMA);
+               object->inUse = 0;
+               HwiP_restore(key);
+
+               Power_releaseConstraint(PowerCC32XX_DISALLOW_LPDS);
+
+               DebugP_log2("Camera:(%p) Capture timed out, %d bytes captured",
+                              hwAttrs->baseAddr, object->frameLength);
+
+               *frameLen = 0;
+               return (CAMERA_STATUS_ERROR);
+           }
+           HwiP_restore(key);
+
+           /* The frame completed while timing out; consume its post */
+           SemaphoreP_pend(object->captureSem, SemaphoreP_NO_WAIT);
        }
+
+       *frameLen = object->frameLength;
+       return (CAMERA_STATUS_SUCCESS);
    }
 
    *frameLen = 0;
    return (CAMERA_STATUS_SUCCESS);
 }
+
+/*
+ *  ======== CameraCC32XXDMA_StreamParams_init ========
+ */
+void CameraCC32XXDMA_StreamParams_init(CameraCC32XXDMA_StreamParams *params)
+{
+    params->buffers = NULL;
+    params->numBuffers = 0;
+    params->bufferLength = 0;
+}
+
+/*
+ *  ======== CameraCC32XXDMA_startStream ========
+ */
+int_fast16_t CameraCC32XXDMA_startStream(Camera_Handle handle,
+    CameraCC32XXDMA_StreamParams *params)
+{
+    CameraCC32XXDMA_Object        *object = handle->object;
+    CameraCC32XXDMA_HWAttrs const *hwAttrs = handle->hwAttrs;
+    uintptr_t                      key;
+    uint_fast8_t                   i;
+
+    if (params->buffers == NULL || params->numBuffers < 2 ||
+        params->numBuffers > CameraCC32XXDMA_STREAM_MAX_BUFFERS ||
+        params->bufferLength < 2 * BURST_BYTES ||
+        (params->bufferLength % BURST_BYTES) != 0) {
+        return (CAMERA_STATUS_ERROR);
+    }
+
+    for (i = 0; i < params->numBuffers; i++) {
+        if (params->buffers[i] == NULL ||
+            ((uintptr_t)params->buffers[i] & (sizeof(unsigned long) - 1))) {
+            return (CAMERA_STATUS_ERROR);
+        }
+    }
+
+    key = HwiP_disable();
+    if (object->inUse) {
+        HwiP_restore(key);
+        DebugP_log1("Camera:(%p) Could not start stream, camera in use.",
+                       hwAttrs->baseAddr);
+
+        return (CAMERA_STATUS_ERROR);
+    }
+    object->inUse = 1;
+    HwiP_restore(key);
+
+    /* Drop posts left over from the last stream */
+    while (SemaphoreP_pend(object->frameSem, SemaphoreP_NO_WAIT) ==
+        SemaphoreP_OK) {
+    }
+
+    /* The first buffer is armed below; the rest start out free */
+    object->numFree = 0;
+    for (i = params->numBuffers - 1; i > 0; i--) {
+        object->freeBuffers[object->numFree++] = params->buffers[i];
+    }
+    object->readyHead = 0;
+    object->numReady = 0;
+    object->frameNumber = 0;
+    object->bufferlength = params->bufferLength;
+    memset(&object->streamStats, 0, sizeof(object->streamStats));
+
+    /* Set constraints to guarantee transaction */
+    Power_setConstraint(PowerCC32XX_DISALLOW_LPDS);
+
+    MAP_uDMAChannelAttributeEnable(hwAttrs->channelIndex, UDMA_ATTR_USEBURST);
+    streamArm(handle, params->buffers[0]);
+
+    key = HwiP_disable();
+    object->isStreaming = true;
+    MAP_CameraIntClear(hwAttrs->baseAddr, (CAM_INT_FE | CAM_INT_DMA));
+    MAP_CameraIntEnable(hwAttrs->baseAddr, (CAM_INT_FE | CAM_INT_DMA));
+    HwiP_restore(key);
+
+    MAP_CameraCaptureStart(hwAttrs->baseAddr);
+
+    DebugP_log2("Camera:(%p) stream started, %d buffers",
+                   hwAttrs->baseAddr, params->numBuffers);
+
+    return (CAMERA_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== CameraCC32XXDMA_getFrame ========
+ */
+int_fast16_t CameraCC32XXDMA_getFrame(Camera_Handle handle,
+    CameraCC32XXDMA_Frame *frame, uint32_t timeout)
+{
+    CameraCC32XXDMA_Object *object = handle->object;
+    uintptr_t               key;
+
+    if (!object->isStreaming) {
+        return (CAMERA_STATUS_ERROR);
+    }
+
+    if (SemaphoreP_pend(object->frameSem, timeout) != SemaphoreP_OK) {
+        return (CameraCC32XXDMA_STATUS_TIMEOUT);
+    }
+
+    key = HwiP_disable();
+
+    /* The stream was stopped while waiting */
+    if (object->numReady == 0) {
+        HwiP_restore(key);
+        return (CAMERA_STATUS_ERROR);
+    }
+
+    *frame = object->readyFrames[object->readyHead];
+    object->readyHead = (object->readyHead + 1) %
+        CameraCC32XXDMA_STREAM_MAX_BUFFERS;
+    object->numReady--;
+
+    HwiP_restore(key);
+
+    return (CAMERA_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== CameraCC32XXDMA_releaseFrame ========
+ */
+void CameraCC32XXDMA_releaseFrame(Camera_Handle handle,
+    CameraCC32XXDMA_Frame *frame)
+{
+    CameraCC32XXDMA_Object *object = handle->object;
+    uintptr_t               key;
+
+    key = HwiP_disable();
+    if (object->isStreaming &&
+        object->numFree < CameraCC32XXDMA_STREAM_MAX_BUFFERS) {
+        object->freeBuffers[object->numFree++] = frame->buffer;
+    }
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== CameraCC32XXDMA_stopStream ========
+ */
+void CameraCC32XXDMA_stopStream(Camera_Handle handle)
+{
+    CameraCC32XXDMA_Object        *object = handle->object;
+    CameraCC32XXDMA_HWAttrs const *hwAttrs = handle->hwAttrs;
+    uintptr_t                      key;
+
+    key = HwiP_disable();
+    if (!object->isStreaming) {
+        HwiP_restore(key);
+        return;
+    }
+
+    MAP_CameraCaptureStop(hwAttrs->baseAddr, true);
+    MAP_uDMAChannelDisable(hwAttrs->channelIndex);
+
+    /* No frame end or DMA done may reach the Hwi once the stream is gone */
+    MAP_CameraIntDisable(hwAttrs->baseAddr, (CAM_INT_FE | CAM_INT_DMA));
+    MAP_CameraIntClear(hwAttrs->baseAddr, (CAM_INT_FE | CAM_INT_DMA));
+    HwiP_clearInterrupt(hwAttrs->intNum);
+
+    object->isStreaming = false;
+    object->numReady = 0;
+    object->numFree = 0;
+    object->inUse = 0;
+    HwiP_restore(key);
+
+    /* Wake a task waiting in CameraCC32XXDMA_getFrame() */
+    SemaphoreP_post(object->frameSem);
+
+    Power_releaseConstraint(PowerCC32XX_DISALLOW_LPDS);
+
+    DebugP_log3("Camera:(%p) stream stopped, %d frames, %d dropped",
+                   hwAttrs->baseAddr, object->streamStats.frames,
+                   object->streamStats.dropped +
+                   object->streamStats.truncated);
+}
+
+/*
+ *  ======== CameraCC32XXDMA_getStreamStats ========
+ */
+void CameraCC32XXDMA_getStreamStats(Camera_Handle handle,
+    CameraCC32XXDMA_StreamStats *stats)
+{
+    CameraCC32XXDMA_Object *object = handle->object;
+    uintptr_t               key;
+
+    key = HwiP_disable();
+    *stats = object->streamStats;
+    HwiP_restore(key);
+}
@@ -42,6 +42,45 @@
  *
  *  Refer to @ref Camera.h for a complete description of APIs & example of use.
  *
+ *  # Streaming #
+ *
+ *  Camera_capture() arms the uDMA for one frame and returns it in one
+ *  buffer. To capture at the sensor frame rate, CameraCC32XXDMA_startStream()
+ *  keeps the capture running and cycles through a pool of application
+ *  buffers: the uDMA fills one frame buffer in ping-pong bursts of
+ *  ::CameraCC32XXDMA_DMA_TRANSFER_SIZE words, and at each frame end the
+ *  buffer is queued as a completed frame and the next free buffer is armed.
+ *  Completed frames are taken with CameraCC32XXDMA_getFrame() and handed
+ *  back with CameraCC32XXDMA_releaseFrame() once processed.
+ *
+ *  Each frame carries a frame number and the ClockP system tick count of
+ *  its frame end. Frame numbers count every frame the sensor delivered, so
+ *  a gap in them shows frames that were dropped. A frame is dropped when
+ *  no free buffer is left at its end (the application holds or has not yet
+ *  taken all of them) or when it did not fit in its buffer; its buffer is
+ *  then reused for the next frame. CameraCC32XXDMA_getStreamStats() returns
+ *  the counts.
+ *
+ *  @code
+ *  CameraCC32XXDMA_StreamParams params;
+ *  CameraCC32XXDMA_Frame        frame;
+ *
+ *  CameraCC32XXDMA_StreamParams_init(&params);
+ *  params.buffers = frameBuffers;
+ *  params.numBuffers = 3;
+ *  params.bufferLength = sizeof(frameBuffers[0]);
+ *  CameraCC32XXDMA_startStream(cameraHandle, &params);
+ *
+ *  while (CameraCC32XXDMA_getFrame(cameraHandle, &frame,
+ *         SemaphoreP_WAIT_FOREVER) == CAMERA_STATUS_SUCCESS) {
+ *      process(frame.buffer, frame.length);
+ *      CameraCC32XXDMA_releaseFrame(cameraHandle, &frame);
+ *  }
+ *  @endcode
+ *
+ *  While streaming, Camera_capture() returns CAMERA_STATUS_ERROR and LPDS
+ *  is disallowed.
+ *
  *  ============================================================================
  */
 
@@ -57,6 +96,7 @@ extern "C" {
 #include <ti/drivers/Camera.h>
 #include <ti/drivers/dpl/HwiP.h>
 #include <ti/drivers/dpl/SemaphoreP.h>
+#include <ti/drivers/dma/UDMACC32XX.h>
 
 /**
  *  @addtogroup Camera_STATUS
@@ -70,6 +110,14 @@ extern "C" {
 
 /* Add CameraCC32XXDMA_STATUS_* macros here */
 
+/*!
+ * @brief   No completed frame was available before the timeout
+ *
+ * CameraCC32XXDMA_getFrame() returns this if no frame completed within
+ * the given timeout.
+ */
+#define CameraCC32XXDMA_STATUS_TIMEOUT      (CAMERA_STATUS_RESERVED - 0)
+
 /** @}*/
 
 /**
@@ -89,9 +137,53 @@ extern "C" {
 /* CC32XX camera DMA transfer size */
 #define CameraCC32XXDMA_DMA_TRANSFER_SIZE  64
 
+/*!
+ *  @brief  Maximum number of frame buffers in a stream
+ */
+#define CameraCC32XXDMA_STREAM_MAX_BUFFERS  (8)
+
 /* Camera function table pointer */
 extern const Camera_FxnTable CameraCC32XXDMA_fxnTable;
 
+/*!
+ *  @brief  CameraCC32XXDMA stream parameters
+ *
+ *  @sa CameraCC32XXDMA_StreamParams_init()
+ */
+typedef struct CameraCC32XXDMA_StreamParams {
+    /*! Frame buffers, word aligned, of bufferLength bytes each */
+    void          **buffers;
+    /*! Number of buffers, 2 to ::CameraCC32XXDMA_STREAM_MAX_BUFFERS */
+    uint_fast8_t    numBuffers;
+    /*! Length of each buffer in bytes, a multiple of 256 (one ping-pong
+     *  burst of ::CameraCC32XXDMA_DMA_TRANSFER_SIZE words) and at least
+     *  512. A frame that fills its buffer completely is dropped, so allow
+     *  for the largest frame plus one burst. */
+    size_t          bufferLength;
+} CameraCC32XXDMA_StreamParams;
+
+/*!
+ *  @brief  A completed frame of a stream
+ */
+typedef struct CameraCC32XXDMA_Frame {
+    void     *buffer;       /*!< Frame buffer holding the frame */
+    size_t    length;       /*!< Number of bytes captured */
+    uint32_t  frameNumber;  /*!< Running count of frames, dropped included */
+    uint32_t  timestamp;    /*!< ClockP system ticks at the frame end */
+} CameraCC32XXDMA_Frame;
+
+/*!
+ *  @brief  CameraCC32XXDMA stream statistics
+ *
+ *  @sa CameraCC32XXDMA_getStreamStats()
+ */
+typedef struct CameraCC32XXDMA_StreamStats {
+    uint32_t frames;     /*!< Frames delivered to the frame queue */
+    uint32_t dropped;    /*!< Frames dropped for lack of a free buffer */
+    uint32_t truncated;  /*!< Frames dropped for not fitting in a buffer */
+    uint32_t maxQueued;  /*!< Most frames waiting in the queue at once */
+} CameraCC32XXDMA_StreamStats;
+
 /*!
  *  @brief      CameraCC32XXDMA Hardware attributes
  *
@@ -152,12 +244,103 @@ typedef struct CameraCC32XXDMA_Object {
     bool                cameraDMA_PingPongMode; /* DMA ping pong mode */
     size_t              cameraDMAxIntrRcvd;     /* Number of DMA interrupts*/
     bool                inUse;                  /* Camera in Use */
+    bool                isStreaming;            /* Stream running */
+
+    /* Stream state */
+    bool                overflow;          /* Frame ran past its buffer */
+    uint_fast8_t        inFlight;          /* Bursts armed in the uDMA */
+    uint32_t            frameNumber;       /* Frames seen since start */
+    uint_fast8_t        numFree;           /* Buffers in freeBuffers */
+    uint_fast8_t        readyHead;         /* Oldest frame in readyFrames */
+    uint_fast8_t        numReady;          /* Frames in readyFrames */
+    void               *freeBuffers[CameraCC32XXDMA_STREAM_MAX_BUFFERS];
+    CameraCC32XXDMA_Frame readyFrames[CameraCC32XXDMA_STREAM_MAX_BUFFERS];
+    CameraCC32XXDMA_StreamStats streamStats;
 
     /* Camera OS objects */
     SemaphoreP_Handle   captureSem;
+    SemaphoreP_Handle   frameSem;          /* Counts frames in readyFrames */
     HwiP_Handle         hwiHandle;
+
+    /* Holds channelIndex while the driver is open */
+    UDMACC32XX_Handle   dmaHandle;
 } CameraCC32XXDMA_Object, *CameraCC32XXDMA_Handle;
 
+/*!
+ *  @brief  Initialize stream parameters to default values: no buffers and
+ *          bufferLength 0.
+ *
+ *  @param  params  Pointer to the stream parameters
+ */
+extern void CameraCC32XXDMA_StreamParams_init(
+    CameraCC32XXDMA_StreamParams *params);
+
+/*!
+ *  @brief  Start capturing frames continuously into a pool of buffers
+ *
+ *  The first buffer is armed at once; the others are kept free for the
+ *  frames that follow. The stream statistics are cleared.
+ *
+ *  @pre    Camera_open() has been called on the handle.
+ *
+ *  @param  handle  A Camera_Handle
+ *  @param  params  Stream parameters
+ *
+ *  @return CAMERA_STATUS_SUCCESS if the stream was started, else
+ *          CAMERA_STATUS_ERROR if the parameters are invalid or a capture
+ *          or stream is already running.
+ *
+ *  @sa CameraCC32XXDMA_stopStream()
+ */
+extern int_fast16_t CameraCC32XXDMA_startStream(Camera_Handle handle,
+    CameraCC32XXDMA_StreamParams *params);
+
+/*!
+ *  @brief  Take the oldest completed frame of a stream
+ *
+ *  The frame's buffer belongs to the application until it is handed back
+ *  with CameraCC32XXDMA_releaseFrame().
+ *
+ *  @param  handle   A Camera_Handle
+ *  @param  frame    Filled in with the frame
+ *  @param  timeout  Timeout, in ClockP ticks, to wait for a frame
+ *
+ *  @return CAMERA_STATUS_SUCCESS if a frame was taken,
+ *          CameraCC32XXDMA_STATUS_TIMEOUT if none completed in time, or
+ *          CAMERA_STATUS_ERROR if the stream is not running.
+ */
+extern int_fast16_t CameraCC32XXDMA_getFrame(Camera_Handle handle,
+    CameraCC32XXDMA_Frame *frame, uint32_t timeout);
+
+/*!
+ *  @brief  Hand a frame buffer back to the stream
+ *
+ *  @param  handle  A Camera_Handle
+ *  @param  frame   A frame returned by CameraCC32XXDMA_getFrame()
+ */
+extern void CameraCC32XXDMA_releaseFrame(Camera_Handle handle,
+    CameraCC32XXDMA_Frame *frame);
+
+/*!
+ *  @brief  Stop a stream
+ *
+ *  The frame being captured is dropped and frames still in the queue are
+ *  discarded; all buffers belong to the application again once this
+ *  returns. Camera_close() stops the stream too.
+ *
+ *  @param  handle  A Camera_Handle
+ */
+extern void CameraCC32XXDMA_stopStream(Camera_Handle handle);
+
+/*!
+ *  @brief  Read the statistics of the current or last stream
+ *
+ *  @param  handle  A Camera_Handle
+ *  @param  stats   Filled in with the statistics
+ */
+extern void CameraCC32XXDMA_getStreamStats(Camera_Handle handle,
+    CameraCC32XXDMA_StreamStats *stats);
+
 #ifdef __cplusplus
 }
 #endif
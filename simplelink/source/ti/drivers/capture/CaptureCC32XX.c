@@ -46,7 +46,10 @@
 #include <ti/devices/cc32xx/inc/hw_timer.h>
 #include <ti/devices/cc32xx/inc/hw_ocp_shared.h>
 #include <ti/devices/cc32xx/inc/hw_apps_config.h>
+#include <ti/devices/cc32xx/driverlib/rom.h>
+#include <ti/devices/cc32xx/driverlib/rom_map.h>
 #include <ti/devices/cc32xx/driverlib/timer.h>
+#include <ti/devices/cc32xx/driverlib/udma.h>
 
 #define getTimerBaseAddress(config) (TIMERA0_BASE | ((config >> 18) & 0x3000))
 #define getSubTimer(config)         ((config >> 28) & 0x3)
@@ -55,6 +58,10 @@
 #define getPinMode(config)          (config & 0xF)
 #define getGPIOBaseAddress(config)  (GPIOA0_BASE + ((config >> 4) & 0xF000))
 
+/* The default uDMA channels 0 - 7 serve Timer0A, Timer0B ... Timer3B */
+#define getDmaChannel(config)       ((((config) >> 29) & 0x6) | \
+                                     (getSubTimer(config) - 1))
+
 #define PAD_RESET_STATE 0xC61
 
 void CaptureCC32XX_close(Capture_Handle handle);
@@ -67,6 +74,10 @@ void CaptureCC32XX_stop(Capture_Handle handle);
 
 /* Internal static Functions */
 static void CaptureCC32XX_hwiIntFunction(uintptr_t arg);
+static void armBuffer(Capture_Handle handle, uint_fast8_t index);
+static void deliverPeriods(Capture_Handle handle, uint_fast16_t end);
+static uint32_t getPeriod(CaptureCC32XX_Object *object, uint32_t currentCount);
+static void streamIntFunction(Capture_Handle handle);
 static uint32_t getPowerMgrId(uint32_t baseAddress);
 static void initHw(Capture_Handle handle);
 static int postNotifyFxn(unsigned int eventType, uintptr_t eventArg,
@@ -98,6 +109,7 @@ void CaptureCC32XX_close(Capture_Handle handle)
     subTimer = (TimerCC32XX_SubTimer) getSubTimer(hwAttrs->capturePin);
 
     CaptureCC32XX_stop(handle);
+    CaptureCC32XX_stopStream(handle);
 
     Power_unregisterNotify(&(object->notifyObj));
     Power_releaseDependency(getPowerMgrId(getGPIOBaseAddress(hwAttrs->capturePin)));
@@ -134,45 +146,23 @@ void CaptureCC32XX_hwiIntFunction(uintptr_t arg)
     CaptureCC32XX_Object *object = handle->object;
     uint32_t baseAddress = getTimerBaseAddress(hwAttrs->capturePin);
     uint32_t interruptMask;
-    uint32_t interval, currentCount;
+    uint32_t interval;
 
-    /* Read the TXR register */
-    currentCount = TimerValueGet(baseAddress, object->timer);
+    if (object->isStreaming) {
 
-    /* Calculate the interval */
-    if (currentCount < object->previousCount) {
+        streamIntFunction(handle);
 
-        /* Calculate the difference if the timer rolled over */
-        interval = currentCount + (0xFFFFFF - object->previousCount);
+        return;
     }
-    else if (currentCount > object->previousCount) {
-
-        interval = currentCount - object->previousCount - 1;
-    }
-    else {
-        interval = 1;
-    }
-
-    /* Store the interval for the next interrupt */
-    object->previousCount = currentCount;
 
-    /* Compensate for prescale register roll-over hardware issue */
-    interval = interval - (interval / 0xFFFF);
+    /* Read the TXR register and convert to the period */
+    interval = getPeriod(object,
+        TimerValueGet(baseAddress, object->timer));
 
     /* Clear the interrupts used by this driver instance */
     interruptMask = object->timer & (TIMER_CAPB_EVENT | TIMER_CAPA_EVENT);
     TimerIntClear(baseAddress, interruptMask);
 
-    /* Need to convert the interval to periodUnits if microseconds or hertz */
-    if (object->periodUnits == Capture_PERIOD_US) {
-
-        interval = interval / (clockFreq.lo / 1000000);
-    }
-    else if (object->periodUnits == Capture_PERIOD_HZ) {
-
-        interval = clockFreq.lo / interval;
-    }
-
     /* Call the user callbackFxn */
     object->callBack(handle, interval);
 }
@@ -248,6 +238,7 @@ Capture_Handle CaptureCC32XX_open(Capture_Handle handle, Capture_Params *params)
     }
 
     object->isRunning = false;
+    object->isStreaming = false;
     object->callBack = params->callbackFxn;
     object->periodUnits = params->periodUnit;
 
@@ -290,7 +281,7 @@ int32_t CaptureCC32XX_start(Capture_Handle handle)
 
     key = HwiP_disable();
 
-    if (object->isRunning) {
+    if (object->isRunning || object->isStreaming) {
 
         HwiP_restore(key);
 
@@ -339,6 +330,318 @@ void CaptureCC32XX_stop(Capture_Handle handle)
     HwiP_restore(key);
 }
 
+/*
+ *  ======== CaptureCC32XX_StreamParams_init ========
+ */
+void CaptureCC32XX_StreamParams_init(CaptureCC32XX_StreamParams *params)
+{
+    params->buffers[0] = NULL;
+    params->buffers[1] = NULL;
+    params->count = 0;
+    params->timeout = 0;
+    params->callbackFxn = NULL;
+}
+
+/*
+ *  ======== CaptureCC32XX_startStream ========
+ */
+int32_t CaptureCC32XX_startStream(Capture_Handle handle,
+    CaptureCC32XX_StreamParams *params)
+{
+    CaptureCC32XX_HWAttrs const *hwAttrs = handle->hwAttrs;
+    CaptureCC32XX_Object *object = handle->object;
+    uint32_t baseAddress = getTimerBaseAddress(hwAttrs->capturePin);
+    uint32_t dmaChannel = getDmaChannel(hwAttrs->capturePin);
+    uint32_t interruptMask;
+    uint32_t wrapCycles;
+    uint64_t timeoutCycles;
+    uintptr_t key;
+
+    if ((params->buffers[0] == NULL) || (params->buffers[1] == NULL) ||
+        (params->callbackFxn == NULL) || (params->count == 0) ||
+        (params->count > CaptureCC32XX_STREAM_MAX_COUNT)) {
+
+        return (Capture_STATUS_ERROR);
+    }
+
+    key = HwiP_disable();
+
+    if (object->isRunning || object->isStreaming) {
+
+        HwiP_restore(key);
+
+        return (Capture_STATUS_ERROR);
+    }
+
+    object->isStreaming = true;
+
+    HwiP_restore(key);
+
+    object->dmaHandle = UDMACC32XX_open();
+
+    if (object->dmaHandle == NULL) {
+
+        object->isStreaming = false;
+
+        return (Capture_STATUS_ERROR);
+    }
+
+    /* Reserve the channel so that UDMACC32XX_allocChannel() users skip it */
+    if (UDMACC32XX_allocChannel(object->dmaHandle, &dmaChannel, 1,
+        UDMACC32XX_PRIORITY_DEFAULT) == UDMACC32XX_CHANNEL_NONE) {
+
+        UDMACC32XX_close(object->dmaHandle);
+        object->dmaHandle = NULL;
+        object->isStreaming = false;
+
+        return (Capture_STATUS_ERROR);
+    }
+
+    object->buffers[0] = params->buffers[0];
+    object->buffers[1] = params->buffers[1];
+    object->count = params->count;
+    object->streamCallback = params->callbackFxn;
+    object->nextBuffer = 0;
+    object->delivered = 0;
+    object->idleWraps = 0;
+    object->previousCount = 0;
+
+    /* Convert the timeout to a number of timer wrap arounds */
+    object->timeoutWraps = 0;
+
+    if (params->timeout) {
+
+        wrapCycles = ((TimerPrescaleGet(baseAddress, object->timer) << 16) |
+            TimerLoadGet(baseAddress, object->timer)) + 1;
+        timeoutCycles = (uint64_t) params->timeout *
+            (clockFreq.lo / 1000000);
+
+        object->timeoutWraps = (timeoutCycles + wrapCycles - 1) / wrapCycles;
+    }
+
+    /* The uDMA does not run in LPDS */
+    Power_setConstraint(PowerCC32XX_DISALLOW_LPDS);
+
+    /* One timer value per capture event, into alternating buffers */
+    MAP_uDMAChannelControlSet(dmaChannel | UDMA_PRI_SELECT,
+        UDMA_SIZE_32 | UDMA_SRC_INC_NONE | UDMA_DST_INC_32 | UDMA_ARB_1);
+    MAP_uDMAChannelControlSet(dmaChannel | UDMA_ALT_SELECT,
+        UDMA_SIZE_32 | UDMA_SRC_INC_NONE | UDMA_DST_INC_32 | UDMA_ARB_1);
+    armBuffer(handle, 0);
+    armBuffer(handle, 1);
+
+    /* uDMA done, and timer wrap around when there is a timeout */
+    interruptMask = object->timer & (TIMER_TIMB_DMA | TIMER_TIMA_DMA);
+
+    if (object->timeoutWraps) {
+
+        interruptMask |= object->timer & (TIMER_TIMB_TIMEOUT | TIMER_TIMA_TIMEOUT);
+    }
+
+    /* A lock is needed because we are accessing shared uDMA and timer registers */
+    key = HwiP_disable();
+
+    MAP_uDMAChannelEnable(dmaChannel);
+
+    TimerDMAEventSet(baseAddress, TimerDMAEventGet(baseAddress) |
+        (object->timer & (TIMER_DMA_CAPEVENT_B | TIMER_DMA_CAPEVENT_A)));
+
+    TimerIntClear(baseAddress, interruptMask);
+    TimerIntEnable(baseAddress, interruptMask);
+    TimerValueSet(baseAddress, object->timer, 0);
+    TimerEnable(baseAddress, object->timer);
+
+    HwiP_restore(key);
+
+    return (Capture_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== CaptureCC32XX_stopStream ========
+ */
+void CaptureCC32XX_stopStream(Capture_Handle handle)
+{
+    CaptureCC32XX_HWAttrs const *hwAttrs = handle->hwAttrs;
+    CaptureCC32XX_Object *object = handle->object;
+    uint32_t baseAddress = getTimerBaseAddress(hwAttrs->capturePin);
+    uint32_t interruptMask;
+    uintptr_t key;
+
+    interruptMask = object->timer & (TIMER_TIMB_DMA | TIMER_TIMA_DMA |
+        TIMER_TIMB_TIMEOUT | TIMER_TIMA_TIMEOUT);
+
+    key = HwiP_disable();
+
+    if (!object->isStreaming) {
+
+        HwiP_restore(key);
+
+        return;
+    }
+
+    object->isStreaming = false;
+
+    TimerDisable(baseAddress, object->timer);
+    TimerDMAEventSet(baseAddress, TimerDMAEventGet(baseAddress) &
+        ~(object->timer & (TIMER_DMA_CAPEVENT_B | TIMER_DMA_CAPEVENT_A)));
+    MAP_uDMAChannelDisable(getDmaChannel(hwAttrs->capturePin));
+    TimerIntDisable(baseAddress, interruptMask);
+    TimerIntClear(baseAddress, interruptMask);
+
+    HwiP_restore(key);
+
+    UDMACC32XX_freeChannel(object->dmaHandle,
+        getDmaChannel(hwAttrs->capturePin));
+    UDMACC32XX_close(object->dmaHandle);
+    object->dmaHandle = NULL;
+
+    Power_releaseConstraint(PowerCC32XX_DISALLOW_LPDS);
+}
+
+/*
+ *  ======== armBuffer ========
+ *  Hands a stream buffer to the primary (0) or alternate (1) uDMA control
+ *  structure of the channel.
+ */
+static void armBuffer(Capture_Handle handle, uint_fast8_t index)
+{
+    CaptureCC32XX_HWAttrs const *hwAttrs = handle->hwAttrs;
+    CaptureCC32XX_Object const *object = handle->object;
+    uint32_t baseAddress = getTimerBaseAddress(hwAttrs->capturePin);
+
+    MAP_uDMAChannelTransferSet(getDmaChannel(hwAttrs->capturePin) |
+        ((index == 0) ? UDMA_PRI_SELECT : UDMA_ALT_SELECT),
+        UDMA_MODE_PINGPONG,
+        (void *) (baseAddress + ((object->timer == TIMER_A) ?
+            TIMER_O_TAR : TIMER_O_TBR)),
+        object->buffers[index], object->count);
+}
+
+/*
+ *  ======== deliverPeriods ========
+ *  Converts the timer values of the current buffer, up to end, to periods
+ *  and hands them to the stream callback.
+ */
+static void deliverPeriods(Capture_Handle handle, uint_fast16_t end)
+{
+    CaptureCC32XX_Object *object = handle->object;
+    uint32_t *values = object->buffers[object->nextBuffer];
+    uint_fast16_t i;
+
+    if (end <= object->delivered) {
+
+        return;
+    }
+
+    for (i = object->delivered; i < end; i++) {
+
+        values[i] = getPeriod(object, values[i]);
+    }
+
+    object->streamCallback(handle, &values[object->delivered],
+        end - object->delivered);
+
+    object->delivered = end;
+    object->idleWraps = 0;
+}
+
+/*
+ *  ======== getPeriod ========
+ *  Returns the period since the previous capture event, in periodUnits.
+ */
+static uint32_t getPeriod(CaptureCC32XX_Object *object, uint32_t currentCount)
+{
+    uint32_t interval;
+
+    /* Calculate the interval */
+    if (currentCount < object->previousCount) {
+
+        /* Calculate the difference if the timer rolled over */
+        interval = currentCount + (0xFFFFFF - object->previousCount);
+    }
+    else if (currentCount > object->previousCount) {
+
+        interval = currentCount - object->previousCount - 1;
+    }
+    else {
+        interval = 1;
+    }
+
+    /* Store the interval for the next interrupt */
+    object->previousCount = currentCount;
+
+    /* Compensate for prescale register roll-over hardware issue */
+    interval = interval - (interval / 0xFFFF);
+
+    /* Need to convert the interval to periodUnits if microseconds or hertz */
+    if (object->periodUnits == Capture_PERIOD_US) {
+
+        interval = interval / (clockFreq.lo / 1000000);
+    }
+    else if (object->periodUnits == Capture_PERIOD_HZ) {
+
+        interval = clockFreq.lo / interval;
+    }
+
+    return (interval);
+}
+
+/*
+ *  ======== streamIntFunction ========
+ *  The uDMA has filled one or both stream buffers, or the timer wrapped
+ *  around.
+ */
+static void streamIntFunction(Capture_Handle handle)
+{
+    CaptureCC32XX_HWAttrs const *hwAttrs = handle->hwAttrs;
+    CaptureCC32XX_Object *object = handle->object;
+    uint32_t baseAddress = getTimerBaseAddress(hwAttrs->capturePin);
+    uint32_t dmaChannel = getDmaChannel(hwAttrs->capturePin);
+    uint32_t status;
+    uint_fast8_t index;
+    uint_fast8_t i;
+
+    status = TimerIntStatus(baseAddress, true) & object->timer &
+        (TIMER_TIMB_DMA | TIMER_TIMA_DMA | TIMER_TIMB_TIMEOUT | TIMER_TIMA_TIMEOUT);
+    TimerIntClear(baseAddress, status);
+
+    /* Deliver the filled buffers oldest first and queue them up again */
+    for (i = 0; i < 2; i++) {
+
+        index = object->nextBuffer;
+
+        if (MAP_uDMAChannelModeGet(dmaChannel | ((index == 0) ?
+            UDMA_PRI_SELECT : UDMA_ALT_SELECT)) != UDMA_MODE_STOP) {
+
+            break;
+        }
+
+        deliverPeriods(handle, object->count);
+        armBuffer(handle, index);
+        object->delivered = 0;
+        object->nextBuffer = index ^ 1;
+    }
+
+    /*
+     * If both buffers filled before the interrupt was served, the uDMA
+     * stopped the channel and capture events were lost; resume.
+     */
+    if (!MAP_uDMAChannelIsEnabled(dmaChannel)) {
+
+        MAP_uDMAChannelEnable(dmaChannel);
+    }
+
+    /* Deliver the periods that waited out the timeout */
+    if ((status & (TIMER_TIMB_TIMEOUT | TIMER_TIMA_TIMEOUT)) &&
+        (++object->idleWraps >= object->timeoutWraps)) {
+
+        deliverPeriods(handle, object->count -
+            MAP_uDMAChannelSizeGet(dmaChannel |
+                ((object->nextBuffer == 0) ? UDMA_PRI_SELECT : UDMA_ALT_SELECT)));
+
+        object->idleWraps = 0;
+    }
+}
 
 /*
  *  ======== getPowerMgrId ========
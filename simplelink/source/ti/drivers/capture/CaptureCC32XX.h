@@ -52,6 +52,36 @@
  *  TimerCC32XX_freeTimerResource is used. The application is not responsible
  *  for calling these allocation APIs directly.
  *
+ *  # Batched Capture #
+ *  Capture_start() calls the callback on every edge, which at tens of kHz
+ *  spends most of the CPU entering and leaving the interrupt.
+ *  CaptureCC32XX_startStream() instead has the uDMA copy the timer value
+ *  of every capture event into a pair of application buffers, alternately
+ *  (ping-pong). One interrupt per filled buffer converts the values to
+ *  periods, in the unit given to Capture_open(), and calls a batch
+ *  callback with them.
+ *
+ *  If a timeout is given, periods that have been waiting that long in a
+ *  partially filled buffer are delivered too, so a slow or stopped input
+ *  is still reported. The timeout is checked each time the capture timer
+ *  wraps around, which bounds its resolution.
+ *
+ *  @code
+ *  CaptureCC32XX_StreamParams params;
+ *
+ *  CaptureCC32XX_StreamParams_init(&params);
+ *  params.buffers[0] = ping;
+ *  params.buffers[1] = pong;
+ *  params.count = 64;
+ *  params.timeout = 500000;
+ *  params.callbackFxn = periodsReady;
+ *  CaptureCC32XX_startStream(captureHandle, &params);
+ *  @endcode
+ *
+ *  The uDMA channel is the default one of the capture timer half: channel
+ *  0 for Timer0A up to channel 7 for Timer3B. While streaming,
+ *  Capture_start() returns Capture_STATUS_ERROR and LPDS is disallowed.
+ *
  *******************************************************************************
  */
 #ifndef ti_drivers_capture_CaptureCC32XX__include
@@ -68,6 +98,7 @@ extern "C"
 #include <ti/drivers/Capture.h>
 #include <ti/drivers/Power.h>
 #include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/dma/UDMACC32XX.h>
 #include <ti/devices/cc32xx/inc/hw_ints.h>
 #include <ti/devices/cc32xx/inc/hw_ocp_shared.h>
 
@@ -229,6 +260,41 @@ extern "C"
 
 extern const Capture_FxnTable CaptureCC32XX_fxnTable;
 
+/*!
+ *  @brief  Largest number of periods per stream buffer
+ */
+#define CaptureCC32XX_STREAM_MAX_COUNT      (1024)
+
+/*!
+ *  @brief  Stream callback function
+ *
+ *  Called from interrupt context with the periods of a filled buffer, or
+ *  with the periods that waited out the stream timeout.
+ *
+ *  @param  handle     Capture_Handle of the stream
+ *  @param  intervals  Periods, in the unit given to Capture_open()
+ *  @param  count      Number of periods
+ */
+typedef void (*CaptureCC32XX_StreamCallbackFxn)(Capture_Handle handle,
+    uint32_t *intervals, uint_fast16_t count);
+
+/*!
+ *  @brief  CaptureCC32XX stream parameters
+ *
+ *  @sa CaptureCC32XX_StreamParams_init()
+ */
+typedef struct CaptureCC32XX_StreamParams {
+    /*! The two buffers filled alternately, of count periods each */
+    uint32_t                       *buffers[2];
+    /*! Periods per buffer, at most ::CaptureCC32XX_STREAM_MAX_COUNT */
+    uint_fast16_t                   count;
+    /*! Microseconds after which waiting periods are delivered even if
+        their buffer is not full; 0 to only deliver full buffers */
+    uint32_t                        timeout;
+    /*! Called each time periods are delivered */
+    CaptureCC32XX_StreamCallbackFxn callbackFxn;
+} CaptureCC32XX_StreamParams;
+
 /*!
  *  @brief CaptureCC32XX Hardware Attributes
  *
@@ -276,8 +342,55 @@ typedef struct CaptureCC32XX_Object_ {
     uint32_t              timer;
     uint32_t              previousCount;
     bool                  isRunning;
+    bool                  isStreaming;
+
+    /* Stream state */
+    UDMACC32XX_Handle     dmaHandle;
+    uint32_t             *buffers[2];
+    uint_fast16_t         count;
+    uint_fast16_t         delivered;    /* Periods of nextBuffer delivered */
+    uint_fast8_t          nextBuffer;   /* Buffer the uDMA completes next */
+    uint32_t              timeoutWraps; /* Timer wraps per timeout, or 0 */
+    uint32_t              idleWraps;    /* Timer wraps since the last delivery */
+    CaptureCC32XX_StreamCallbackFxn streamCallback;
 } CaptureCC32XX_Object;
 
+/*!
+ *  @brief  Initialize stream parameters to default values: no buffers,
+ *          count 0, no timeout and no callback.
+ *
+ *  @param  params  Pointer to the stream parameters
+ */
+extern void CaptureCC32XX_StreamParams_init(CaptureCC32XX_StreamParams *params);
+
+/*!
+ *  @brief  Start capturing periods into ping-pong buffers
+ *
+ *  @pre    Capture_open() has been called on the handle.
+ *
+ *  @param  handle  Capture_Handle of the capture pin
+ *  @param  params  Stream parameters; both buffers and the callback must
+ *                  be given
+ *
+ *  @return Capture_STATUS_SUCCESS if the stream was started, else
+ *          Capture_STATUS_ERROR if the parameters are invalid, the capture
+ *          is already running or uDMA is not available.
+ *
+ *  @sa CaptureCC32XX_stopStream()
+ */
+extern int32_t CaptureCC32XX_startStream(Capture_Handle handle,
+    CaptureCC32XX_StreamParams *params);
+
+/*!
+ *  @brief  Stop capturing periods into ping-pong buffers
+ *
+ *  No callback is called after this function returns. Periods not yet
+ *  delivered are dropped. Capture_close() stops the stream too.
+ *
+ *  @param  handle  Capture_Handle of the capture pin
+ */
+extern void CaptureCC32XX_stopStream(Capture_Handle handle);
+
 #ifdef __cplusplus
 }
 #endif
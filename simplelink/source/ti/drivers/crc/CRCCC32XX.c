@@ -0,0 +1,495 @@
+/*
+ * Copyright (c) 2019, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ti/drivers/dpl/ClockP.h>
+#include <ti/drivers/dpl/DebugP.h>
+#include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/dpl/SemaphoreP.h>
+
+#include <ti/drivers/Power.h>
+#include <ti/drivers/power/PowerCC32XX.h>
+
+#include <ti/drivers/crc/CRCCC32XX.h>
+
+#include <ti/devices/cc32xx/inc/hw_types.h>
+#include <ti/devices/cc32xx/inc/hw_memmap.h>
+#include <ti/devices/cc32xx/inc/hw_dthe.h>
+#include <ti/devices/cc32xx/driverlib/rom.h>
+#include <ti/devices/cc32xx/driverlib/rom_map.h>
+#include <ti/devices/cc32xx/driverlib/crc.h>
+#include <ti/devices/cc32xx/driverlib/udma.h>
+
+/* Maximum number of items in a single uDMA transfer */
+#define MAX_DMA_TRANSFER_AMOUNT     (1024)
+
+/*
+ * A uDMA transfer of MAX_DMA_TRANSFER_AMOUNT words takes some tens of
+ * microseconds; one that has not completed after this has failed.
+ */
+#define DMA_TRANSFER_TIMEOUT_USEC   (1000)
+
+/* Function prototypes */
+int_fast16_t CRCCC32XX_addData(CRC_Handle handle, const void *source,
+    size_t size);
+void CRCCC32XX_close(CRC_Handle handle);
+int_fast16_t CRCCC32XX_finalize(CRC_Handle handle, uint32_t *result);
+void CRCCC32XX_init(CRC_Handle handle);
+CRC_Handle CRCCC32XX_open(CRC_Handle handle, CRC_Params *params);
+
+/* Internal functions */
+static void CRCCC32XX_dmaHwiFxn(uintptr_t arg);
+static void CRCCC32XX_dmaStart(void);
+static void CRCCC32XX_feedBytes(CRCCC32XX_Object *object,
+    const uint8_t *data, size_t count);
+static int_fast16_t CRCCC32XX_feedWords(CRCCC32XX_Object *object,
+    const uint32_t *data, size_t count, bool useDma);
+static uint32_t CRCCC32XX_reflect(uint32_t value, uint_fast8_t width);
+static void CRCCC32XX_releaseDma(UDMACC32XX_Handle dmaHandle);
+static bool CRCCC32XX_reserveDma(UDMACC32XX_Handle dmaHandle);
+
+/* CRC function table for CC32XX implementation */
+const CRC_FxnTable CRCCC32XX_fxnTable = {
+    CRCCC32XX_addData,
+    CRCCC32XX_close,
+    CRCCC32XX_finalize,
+    CRCCC32XX_init,
+    CRCCC32XX_open
+};
+
+/* State of the single engine, shared by all CRCCC32XX instances */
+static struct {
+    SemaphoreP_Struct   engineLock;
+    SemaphoreP_Struct   dmaDone;
+    uint32_t            dmaChannel;
+    uint_fast8_t        dmaUsers;       /* Instances holding the channel */
+    const uint32_t     *dmaSource;
+    size_t              dmaWords;
+    bool                initialized;
+} CRCCC32XX_module;
+
+/*
+ *  ======== CRCCC32XX_addData ========
+ */
+int_fast16_t CRCCC32XX_addData(CRC_Handle handle, const void *source,
+    size_t size)
+{
+    CRCCC32XX_Object          *object = handle->object;
+    CRCCC32XX_HWAttrs const   *hwAttrs = handle->hwAttrs;
+    const uint8_t             *data = (const uint8_t *) source;
+    int_fast16_t               status = CRC_STATUS_SUCCESS;
+    uint32_t                   crc;
+    size_t                     head;
+    size_t                     words;
+
+    if (size == 0) {
+        return (CRC_STATUS_SUCCESS);
+    }
+
+    if (SemaphoreP_pend((SemaphoreP_Handle) &CRCCC32XX_module.engineLock,
+        object->timeout) != SemaphoreP_OK) {
+        return (CRC_STATUS_TIMEOUT);
+    }
+
+    /* An LPDS while the calling task blocks on uDMA would reset the engine */
+    Power_setConstraint(PowerCC32XX_DISALLOW_LPDS);
+
+    /* A failed call leaves the CRC as it was */
+    crc = object->crc;
+
+    /* Bytes up to the first word boundary */
+    head = (size_t) (-(uintptr_t) data) & 3;
+    if (head > size) {
+        head = size;
+    }
+    if (head != 0) {
+        CRCCC32XX_feedBytes(object, data, head);
+        data += head;
+        size -= head;
+    }
+
+    /* Aligned words, by uDMA if there are enough of them */
+    words = size >> 2;
+    if (words != 0) {
+        status = CRCCC32XX_feedWords(object, (const uint32_t *) data, words,
+            (object->dmaHandle != NULL) && (words >= hwAttrs->dmaThreshold));
+        data += words << 2;
+        size -= words << 2;
+    }
+
+    /* Trailing bytes */
+    if ((status == CRC_STATUS_SUCCESS) && (size != 0)) {
+        CRCCC32XX_feedBytes(object, data, size);
+    }
+
+    if (status != CRC_STATUS_SUCCESS) {
+        object->crc = crc;
+    }
+
+    Power_releaseConstraint(PowerCC32XX_DISALLOW_LPDS);
+
+    SemaphoreP_post((SemaphoreP_Handle) &CRCCC32XX_module.engineLock);
+
+    return (status);
+}
+
+/*
+ *  ======== CRCCC32XX_close ========
+ */
+void CRCCC32XX_close(CRC_Handle handle)
+{
+    CRCCC32XX_Object          *object = handle->object;
+    uintptr_t                  key;
+
+    if (object->dmaHandle != NULL) {
+        CRCCC32XX_releaseDma(object->dmaHandle);
+        UDMACC32XX_close(object->dmaHandle);
+        object->dmaHandle = NULL;
+    }
+
+    Power_releaseDependency(PowerCC32XX_PERIPH_DTHE);
+
+    key = HwiP_disable();
+    object->isOpen = false;
+    HwiP_restore(key);
+
+    DebugP_log1("CRC:(%p) closed", (uintptr_t) handle);
+}
+
+/*
+ *  ======== CRCCC32XX_finalize ========
+ */
+int_fast16_t CRCCC32XX_finalize(CRC_Handle handle, uint32_t *result)
+{
+    CRCCC32XX_Object          *object = handle->object;
+    uint32_t                   mask;
+    uint32_t                   crc;
+
+    mask = (object->width == 32) ? 0xFFFFFFFF : ((1U << object->width) - 1);
+
+    /*
+     * The engine always works on the normal (MSB first) register; output
+     * reflection and the final XOR are applied here, so the running value
+     * can be used as the seed of the next CRCCC32XX_addData().
+     */
+    crc = object->crc & mask;
+    if (object->reflect) {
+        crc = CRCCC32XX_reflect(crc, object->width);
+    }
+    *result = (crc ^ object->finalXor) & mask;
+
+    object->crc = object->seed;
+
+    return (CRC_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== CRCCC32XX_init ========
+ */
+void CRCCC32XX_init(CRC_Handle handle)
+{
+    CRCCC32XX_HWAttrs const   *hwAttrs = handle->hwAttrs;
+
+    /* The first instance sets up the shared engine */
+    if (CRCCC32XX_module.initialized) {
+        return;
+    }
+    CRCCC32XX_module.initialized = true;
+
+    SemaphoreP_constructBinary(&CRCCC32XX_module.engineLock, 1);
+    SemaphoreP_constructBinary(&CRCCC32XX_module.dmaDone, 0);
+
+    CRCCC32XX_module.dmaChannel = hwAttrs->dmaChannel;
+
+    if (CRCCC32XX_module.dmaChannel != CRCCC32XX_DMA_CHANNEL_NONE) {
+        UDMACC32XX_init();
+    }
+}
+
+/*
+ *  ======== CRCCC32XX_open ========
+ */
+CRC_Handle CRCCC32XX_open(CRC_Handle handle, CRC_Params *params)
+{
+    CRCCC32XX_Object          *object = handle->object;
+    uintptr_t                  key;
+    uint32_t                   type;
+
+    switch (params->polynomial) {
+        case CRC_POLYNOMIAL_CRC_16:
+            type = CRC_CFG_TYPE_P8005;
+            object->width = 16;
+            break;
+
+        case CRC_POLYNOMIAL_CRC_CCITT:
+            type = CRC_CFG_TYPE_P1021;
+            object->width = 16;
+            break;
+
+        case CRC_POLYNOMIAL_CRC_32:
+            type = CRC_CFG_TYPE_P4C11DB7;
+            object->width = 32;
+            break;
+
+        case CRC_POLYNOMIAL_CRC_32C:
+            type = CRC_CFG_TYPE_P1EDC6F41;
+            object->width = 32;
+            break;
+
+        default:
+            DebugP_log1("CRC:(%p) unsupported polynomial", (uintptr_t) handle);
+            return (NULL);
+    }
+
+    key = HwiP_disable();
+
+    if (object->isOpen) {
+        HwiP_restore(key);
+
+        DebugP_log1("CRC:(%p) already in use.", (uintptr_t) handle);
+        return (NULL);
+    }
+    object->isOpen = true;
+
+    HwiP_restore(key);
+
+    /* Input bytes are bit reversed by the engine for reflected CRCs */
+    object->ctrl = type | CRC_CFG_INIT_SEED |
+        (params->reflect ? CRC_CFG_IBR : 0);
+    object->reflect = params->reflect;
+    object->seed = params->seed;
+    object->crc = object->seed;
+    object->finalXor = params->finalXor;
+    object->timeout = params->timeout;
+
+    Power_setDependency(PowerCC32XX_PERIPH_DTHE);
+
+    /* Without uDMA the CPU feeds the engine */
+    object->dmaHandle = NULL;
+    if (CRCCC32XX_module.dmaChannel != CRCCC32XX_DMA_CHANNEL_NONE) {
+        object->dmaHandle = UDMACC32XX_open();
+        if (object->dmaHandle != NULL) {
+            /* The channel may be held by another driver */
+            if (!CRCCC32XX_reserveDma(object->dmaHandle)) {
+                UDMACC32XX_close(object->dmaHandle);
+                object->dmaHandle = NULL;
+            }
+            /* Without the completion interrupt the CPU feeds the engine */
+            else if (!UDMACC32XX_setCallback(object->dmaHandle,
+                CRCCC32XX_module.dmaChannel, CRCCC32XX_dmaHwiFxn, 0)) {
+                CRCCC32XX_releaseDma(object->dmaHandle);
+                UDMACC32XX_close(object->dmaHandle);
+                object->dmaHandle = NULL;
+            }
+        }
+    }
+
+    DebugP_log1("CRC:(%p) opened", (uintptr_t) handle);
+
+    return (handle);
+}
+
+/*
+ *  ======== CRCCC32XX_dmaHwiFxn ========
+ *  Chains the next uDMA transfer, or wakes the task when the run is done.
+ */
+static void CRCCC32XX_dmaHwiFxn(uintptr_t arg)
+{
+    (void)arg;
+
+    if (CRCCC32XX_module.dmaWords != 0) {
+        CRCCC32XX_dmaStart();
+    }
+    else {
+        SemaphoreP_post((SemaphoreP_Handle) &CRCCC32XX_module.dmaDone);
+    }
+}
+
+/*
+ *  ======== CRCCC32XX_dmaStart ========
+ *  Start an auto-request transfer of up to MAX_DMA_TRANSFER_AMOUNT words
+ *  into the engine's data register.
+ */
+static void CRCCC32XX_dmaStart(void)
+{
+    uint32_t channel = CRCCC32XX_module.dmaChannel;
+    size_t   count = CRCCC32XX_module.dmaWords;
+
+    if (count > MAX_DMA_TRANSFER_AMOUNT) {
+        count = MAX_DMA_TRANSFER_AMOUNT;
+    }
+
+    MAP_uDMAChannelControlSet(channel | UDMA_PRI_SELECT,
+        UDMA_SIZE_32 | UDMA_SRC_INC_32 | UDMA_DST_INC_NONE | UDMA_ARB_8);
+    MAP_uDMAChannelTransferSet(channel | UDMA_PRI_SELECT, UDMA_MODE_AUTO,
+        (void *) CRCCC32XX_module.dmaSource,
+        (void *) (DTHE_BASE + DTHE_O_CRC_DIN), count);
+
+    CRCCC32XX_module.dmaSource += count;
+    CRCCC32XX_module.dmaWords -= count;
+
+    MAP_uDMAChannelEnable(channel);
+    MAP_uDMAChannelRequest(channel);
+}
+
+/*
+ *  ======== CRCCC32XX_feedBytes ========
+ */
+static void CRCCC32XX_feedBytes(CRCCC32XX_Object *object,
+    const uint8_t *data, size_t count)
+{
+    MAP_CRCConfigSet(DTHE_BASE, object->ctrl | CRC_CFG_SIZE_8BIT);
+    MAP_CRCSeedSet(DTHE_BASE, object->crc);
+
+    while (count--) {
+        HWREG(DTHE_BASE + DTHE_O_CRC_DIN) = *data++;
+    }
+
+    object->crc = MAP_CRCResultRead(DTHE_BASE);
+}
+
+/*
+ *  ======== CRCCC32XX_feedWords ========
+ *  Words are swapped to byte stream order, so the result is the same as
+ *  feeding the bytes one at a time.
+ *
+ *  The uDMA run is bounded by object->timeout, and by the time the
+ *  transfers can take: an error stops the channel without a completion
+ *  interrupt, which must not hold the engine forever.
+ */
+static int_fast16_t CRCCC32XX_feedWords(CRCCC32XX_Object *object,
+    const uint32_t *data, size_t count, bool useDma)
+{
+    uint32_t  timeout;
+    uintptr_t key;
+
+    MAP_CRCConfigSet(DTHE_BASE, object->ctrl | CRC_CFG_SIZE_32BIT |
+        DTHE_CRC_CTRL_ENDIAN_M);
+    MAP_CRCSeedSet(DTHE_BASE, object->crc);
+
+    if (useDma) {
+        timeout = ((count + MAX_DMA_TRANSFER_AMOUNT - 1) /
+            MAX_DMA_TRANSFER_AMOUNT) * DMA_TRANSFER_TIMEOUT_USEC /
+            ClockP_getSystemTickPeriod() + 2;
+        if (timeout > object->timeout) {
+            timeout = object->timeout;
+        }
+
+        /* Drop a completion left over from a failed run */
+        SemaphoreP_pend((SemaphoreP_Handle) &CRCCC32XX_module.dmaDone,
+            SemaphoreP_NO_WAIT);
+
+        CRCCC32XX_module.dmaSource = data;
+        CRCCC32XX_module.dmaWords = count;
+
+        CRCCC32XX_dmaStart();
+
+        if (SemaphoreP_pend((SemaphoreP_Handle) &CRCCC32XX_module.dmaDone,
+            timeout) != SemaphoreP_OK) {
+            key = HwiP_disable();
+            CRCCC32XX_module.dmaWords = 0;
+            MAP_uDMAChannelDisable(CRCCC32XX_module.dmaChannel);
+            HwiP_restore(key);
+
+            DebugP_log1("CRC: uDMA channel %d did not complete",
+                CRCCC32XX_module.dmaChannel);
+
+            return (CRC_STATUS_TIMEOUT);
+        }
+    }
+    else {
+        while (count--) {
+            HWREG(DTHE_BASE + DTHE_O_CRC_DIN) = *data++;
+        }
+    }
+
+    object->crc = MAP_CRCResultRead(DTHE_BASE);
+
+    return (CRC_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== CRCCC32XX_reflect ========
+ */
+static uint32_t CRCCC32XX_reflect(uint32_t value, uint_fast8_t width)
+{
+    uint32_t result = 0;
+
+    while (width--) {
+        result = (result << 1) | (value & 1);
+        value >>= 1;
+    }
+
+    return (result);
+}
+
+/*
+ *  ======== CRCCC32XX_releaseDma ========
+ *  Frees the shared uDMA channel when its last instance lets go of it.
+ */
+static void CRCCC32XX_releaseDma(UDMACC32XX_Handle dmaHandle)
+{
+    uintptr_t key;
+
+    key = HwiP_disable();
+    if (--CRCCC32XX_module.dmaUsers == 0) {
+        UDMACC32XX_freeChannel(dmaHandle, CRCCC32XX_module.dmaChannel);
+    }
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== CRCCC32XX_reserveDma ========
+ *  The first instance reserves the shared uDMA channel with
+ *  UDMACC32XX_allocChannel(), so that dynamic uDMA users cannot claim it.
+ *  Returns false if another driver already holds the channel.
+ */
+static bool CRCCC32XX_reserveDma(UDMACC32XX_Handle dmaHandle)
+{
+    uintptr_t key;
+
+    key = HwiP_disable();
+    if ((CRCCC32XX_module.dmaUsers == 0) &&
+        (UDMACC32XX_allocChannel(dmaHandle, &CRCCC32XX_module.dmaChannel, 1,
+            UDMACC32XX_PRIORITY_DEFAULT) == UDMACC32XX_CHANNEL_NONE)) {
+        HwiP_restore(key);
+
+        return (false);
+    }
+    CRCCC32XX_module.dmaUsers++;
+    HwiP_restore(key);
+
+    return (true);
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2019, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!****************************************************************************
+ *  @file       CRCCC32XX.h
+ *  @brief      CRC driver implementation for the CC32XX DTHE CRC engine
+ *
+ *  The CRC header file for CC32XX should be included in an application
+ *  as follows:
+ *  @code
+ *  #include <ti/drivers/CRC.h>
+ *  #include <ti/drivers/crc/CRCCC32XX.h>
+ *  @endcode
+ *
+ *  Refer to @ref CRC.h for a complete description of APIs.
+ *
+ *  All four CRC_Polynomial values are computed by the engine.  Word-aligned
+ *  runs of at least CRCCC32XX_HWAttrs.dmaThreshold words are written to the
+ *  engine by a uDMA software channel while the calling task blocks; shorter
+ *  runs and unaligned head and tail bytes are written by the CPU.
+ *
+ *  CRC_Params.timeout also bounds the wait for the uDMA, which is further
+ *  limited to the time the transfers can take.  If the uDMA does not
+ *  complete, CRC_addData() returns CRC_STATUS_TIMEOUT and leaves the CRC
+ *  as it was before the call.
+ *
+ *  The device has a single CRC engine.  Several CRC_config entries may use
+ *  this implementation (for instance one CRC-32 and one CRC-16 instance);
+ *  they share the engine and are serialized per CRC_addData() call.  The
+ *  running CRC of each instance is kept in its object, so interleaved
+ *  multi-part computations on different instances do not interfere.  The
+ *  uDMA channel of the first CRC_config entry is used for the shared
+ *  engine.
+ *
+ *  # Power Driver Usage #
+ *
+ *  The driver sets a dependency on the DTHE module while an instance is open,
+ *  and disallows LPDS for the duration of each CRC_addData() call.  The engine
+ *  is reprogrammed on every call, so no state is lost across LPDS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef ti_drivers_crc_CRCCC32XX__include
+#define ti_drivers_crc_CRCCC32XX__include
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <ti/drivers/CRC.h>
+#include <ti/drivers/dma/UDMACC32XX.h>
+
+/*!
+ *  @brief  CRCCC32XX_HWAttrs.dmaChannel value that disables uDMA
+ */
+#define CRCCC32XX_DMA_CHANNEL_NONE      (~0U)
+
+/*!  @brief  CRC function table for CC32XX */
+extern const CRC_FxnTable CRCCC32XX_fxnTable;
+
+/*!
+ *  @brief  CRC hardware attributes for CC32XX
+ *
+ *  dmaChannel is a uDMA software channel (for instance UDMA_CH30_SW), or
+ *  CRCCC32XX_DMA_CHANNEL_NONE to have the CPU feed the engine.  The first
+ *  open instance reserves the channel with UDMACC32XX_allocChannel(); if
+ *  another driver already holds it, the CPU feeds the engine instead.
+ *
+ *  Completion of the uDMA software channel is signalled through
+ *  UDMACC32XX_setCallback(), at the priority of the uDMA interrupts.
+ *
+ *  dmaThreshold is the smallest number of 32-bit words moved by uDMA.
+ *  Below it the set up and interrupt cost outweighs the transfer.
+ *
+ *  A sample structure is shown below:
+ *  @code
+ *  const CRCCC32XX_HWAttrs crcCC32XXHWAttrs[] = {
+ *      {
+ *          .dmaChannel = UDMA_CH30_SW,
+ *          .dmaThreshold = 16
+ *      }
+ *  };
+ *  @endcode
+ */
+typedef struct CRCCC32XX_HWAttrs {
+    /*! uDMA software channel, or CRCCC32XX_DMA_CHANNEL_NONE */
+    uint32_t dmaChannel;
+    /*! Minimum number of words transferred by uDMA */
+    uint32_t dmaThreshold;
+} CRCCC32XX_HWAttrs;
+
+/*!
+ *  @brief  CRC Object for CC32XX
+ *
+ *  Not to be accessed by the user.
+ */
+typedef struct CRCCC32XX_Object {
+    uint32_t ctrl;          /* Engine configuration, without input size */
+    uint32_t crc;           /* Running CRC, as held by the engine */
+    uint32_t seed;          /* Initial engine value */
+    uint32_t finalXor;      /* Value XORed with the final CRC */
+    uint32_t timeout;       /* Timeout for the engine and the uDMA */
+    UDMACC32XX_Handle dmaHandle;    /* NULL if the CPU feeds the engine */
+    uint8_t  width;         /* CRC width in bits */
+    bool     reflect;       /* Reflect input bytes and the result */
+    bool     isOpen;        /* Flag for open/close status */
+} CRCCC32XX_Object;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ti_drivers_crc_CRCCC32XX__include */
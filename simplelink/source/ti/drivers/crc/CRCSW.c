@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2019, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ti/drivers/dpl/DebugP.h>
+#include <ti/drivers/dpl/HwiP.h>
+
+#include <ti/drivers/crc/CRCSW.h>
+
+/* Lookup table k holds the contribution of a byte followed by k zero bytes */
+#define TABLE(t, k, i)      ((t)[((k) << 8) + (i)])
+
+/* Function prototypes */
+int_fast16_t CRCSW_addData(CRC_Handle handle, const void *source,
+    size_t size);
+void CRCSW_close(CRC_Handle handle);
+int_fast16_t CRCSW_finalize(CRC_Handle handle, uint32_t *result);
+void CRCSW_init(CRC_Handle handle);
+CRC_Handle CRCSW_open(CRC_Handle handle, CRC_Params *params);
+
+/* Internal functions */
+static void CRCSW_buildTables(uint32_t *table, uint32_t polynomial,
+    uint_fast8_t width, bool reflect);
+static uint32_t CRCSW_reflect(uint32_t value, uint_fast8_t width);
+
+/* CRC function table for the software implementation */
+const CRC_FxnTable CRCSW_fxnTable = {
+    CRCSW_addData,
+    CRCSW_close,
+    CRCSW_finalize,
+    CRCSW_init,
+    CRCSW_open
+};
+
+/*
+ *  ======== CRCSW_addData ========
+ *  Reflected CRCs keep the register in the low bits and consume bytes
+ *  LSB first; normal CRCs keep it left aligned and consume bytes MSB first.
+ */
+int_fast16_t CRCSW_addData(CRC_Handle handle, const void *source, size_t size)
+{
+    CRCSW_Object          *object = handle->object;
+    CRCSW_HWAttrs const   *hwAttrs = handle->hwAttrs;
+    const uint32_t        *t = hwAttrs->table;
+    const uint8_t         *data = (const uint8_t *) source;
+    uint32_t               crc = object->crc;
+    uint32_t               one;
+    uint32_t               two;
+
+    if (object->reflect) {
+        while (size >= 8) {
+            one = crc ^ ((uint32_t) data[0] | ((uint32_t) data[1] << 8) |
+                ((uint32_t) data[2] << 16) | ((uint32_t) data[3] << 24));
+            two = (uint32_t) data[4] | ((uint32_t) data[5] << 8) |
+                ((uint32_t) data[6] << 16) | ((uint32_t) data[7] << 24);
+
+            crc = TABLE(t, 7, one & 0xFF) ^
+                  TABLE(t, 6, (one >> 8) & 0xFF) ^
+                  TABLE(t, 5, (one >> 16) & 0xFF) ^
+                  TABLE(t, 4, one >> 24) ^
+                  TABLE(t, 3, two & 0xFF) ^
+                  TABLE(t, 2, (two >> 8) & 0xFF) ^
+                  TABLE(t, 1, (two >> 16) & 0xFF) ^
+                  TABLE(t, 0, two >> 24);
+
+            data += 8;
+            size -= 8;
+        }
+
+        while (size--) {
+            crc = (crc >> 8) ^ TABLE(t, 0, (crc ^ *data++) & 0xFF);
+        }
+    }
+    else {
+        while (size >= 8) {
+            one = crc ^ (((uint32_t) data[0] << 24) |
+                ((uint32_t) data[1] << 16) | ((uint32_t) data[2] << 8) |
+                (uint32_t) data[3]);
+            two = ((uint32_t) data[4] << 24) | ((uint32_t) data[5] << 16) |
+                ((uint32_t) data[6] << 8) | (uint32_t) data[7];
+
+            crc = TABLE(t, 7, one >> 24) ^
+                  TABLE(t, 6, (one >> 16) & 0xFF) ^
+                  TABLE(t, 5, (one >> 8) & 0xFF) ^
+                  TABLE(t, 4, one & 0xFF) ^
+                  TABLE(t, 3, two >> 24) ^
+                  TABLE(t, 2, (two >> 16) & 0xFF) ^
+                  TABLE(t, 1, (two >> 8) & 0xFF) ^
+                  TABLE(t, 0, two & 0xFF);
+
+            data += 8;
+            size -= 8;
+        }
+
+        while (size--) {
+            crc = (crc << 8) ^ TABLE(t, 0, (crc >> 24) ^ *data++);
+        }
+    }
+
+    object->crc = crc;
+
+    return (CRC_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== CRCSW_close ========
+ */
+void CRCSW_close(CRC_Handle handle)
+{
+    CRCSW_Object          *object = handle->object;
+    uintptr_t              key;
+
+    key = HwiP_disable();
+    object->isOpen = false;
+    HwiP_restore(key);
+
+    DebugP_log1("CRC:(%p) closed", (uintptr_t) handle);
+}
+
+/*
+ *  ======== CRCSW_finalize ========
+ */
+int_fast16_t CRCSW_finalize(CRC_Handle handle, uint32_t *result)
+{
+    CRCSW_Object          *object = handle->object;
+    uint32_t               mask;
+    uint32_t               crc;
+
+    mask = (object->width == 32) ? 0xFFFFFFFF : ((1U << object->width) - 1);
+
+    if (object->reflect) {
+        crc = object->crc;
+    }
+    else {
+        crc = object->crc >> (32 - object->width);
+    }
+    *result = (crc ^ object->finalXor) & mask;
+
+    object->crc = object->seed;
+
+    return (CRC_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== CRCSW_init ========
+ */
+void CRCSW_init(CRC_Handle handle)
+{
+    (void)handle;
+}
+
+/*
+ *  ======== CRCSW_open ========
+ */
+CRC_Handle CRCSW_open(CRC_Handle handle, CRC_Params *params)
+{
+    CRCSW_Object          *object = handle->object;
+    CRCSW_HWAttrs const   *hwAttrs = handle->hwAttrs;
+    uintptr_t              key;
+
+    switch (params->polynomial) {
+        case CRC_POLYNOMIAL_CRC_16:
+        case CRC_POLYNOMIAL_CRC_CCITT:
+            object->width = 16;
+            break;
+
+        case CRC_POLYNOMIAL_CRC_32:
+        case CRC_POLYNOMIAL_CRC_32C:
+            object->width = 32;
+            break;
+
+        default:
+            DebugP_log1("CRC:(%p) unsupported polynomial", (uintptr_t) handle);
+            return (NULL);
+    }
+
+    key = HwiP_disable();
+
+    if (object->isOpen) {
+        HwiP_restore(key);
+
+        DebugP_log1("CRC:(%p) already in use.", (uintptr_t) handle);
+        return (NULL);
+    }
+    object->isOpen = true;
+
+    HwiP_restore(key);
+
+    object->reflect = params->reflect;
+    object->finalXor = params->finalXor;
+    if (object->reflect) {
+        object->seed = CRCSW_reflect(params->seed, object->width);
+    }
+    else {
+        object->seed = params->seed << (32 - object->width);
+    }
+    object->crc = object->seed;
+
+    CRCSW_buildTables(hwAttrs->table, (uint32_t) params->polynomial,
+        object->width, object->reflect);
+
+    DebugP_log1("CRC:(%p) opened", (uintptr_t) handle);
+
+    return (handle);
+}
+
+/*
+ *  ======== CRCSW_buildTables ========
+ */
+static void CRCSW_buildTables(uint32_t *table, uint32_t polynomial,
+    uint_fast8_t width, bool reflect)
+{
+    uint32_t    crc;
+    uint32_t    i;
+    uint32_t    k;
+    uint32_t    bit;
+
+    if (reflect) {
+        polynomial = CRCSW_reflect(polynomial, width);
+    }
+    else {
+        polynomial <<= 32 - width;
+    }
+
+    for (i = 0; i < 256; i++) {
+        if (reflect) {
+            crc = i;
+            for (bit = 0; bit < 8; bit++) {
+                crc = (crc & 1) ? ((crc >> 1) ^ polynomial) : (crc >> 1);
+            }
+        }
+        else {
+            crc = i << 24;
+            for (bit = 0; bit < 8; bit++) {
+                crc = (crc & 0x80000000) ? ((crc << 1) ^ polynomial) :
+                    (crc << 1);
+            }
+        }
+        TABLE(table, 0, i) = crc;
+    }
+
+    for (k = 1; k < 8; k++) {
+        for (i = 0; i < 256; i++) {
+            crc = TABLE(table, k - 1, i);
+            if (reflect) {
+                TABLE(table, k, i) = (crc >> 8) ^ TABLE(table, 0, crc & 0xFF);
+            }
+            else {
+                TABLE(table, k, i) = (crc << 8) ^ TABLE(table, 0, crc >> 24);
+            }
+        }
+    }
+}
+
+/*
+ *  ======== CRCSW_reflect ========
+ */
+static uint32_t CRCSW_reflect(uint32_t value, uint_fast8_t width)
+{
+    uint32_t result = 0;
+
+    while (width--) {
+        result = (result << 1) | (value & 1);
+        value >>= 1;
+    }
+
+    return (result);
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2019, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!****************************************************************************
+ *  @file       CRCSW.h
+ *  @brief      Portable software CRC driver implementation
+ *
+ *  The software CRC header file should be included in an application
+ *  as follows:
+ *  @code
+ *  #include <ti/drivers/CRC.h>
+ *  #include <ti/drivers/crc/CRCSW.h>
+ *  @endcode
+ *
+ *  Refer to @ref CRC.h for a complete description of APIs.
+ *
+ *  This implementation is intended for devices without a CRC engine, or for
+ *  an additional instance when the engine is busy with long transfers.  It
+ *  uses the slice-by-8 algorithm: eight 256-entry lookup tables let the CPU
+ *  consume eight bytes per iteration.  The tables depend on the polynomial
+ *  and reflection, and are generated into RAM supplied by the board file
+ *  when the instance is opened.
+ *
+ *  Instances are not thread safe; a handle must not be used by more than
+ *  one task at a time.  CRC_Params.timeout is ignored.
+ *
+ ******************************************************************************
+ */
+
+#ifndef ti_drivers_crc_CRCSW__include
+#define ti_drivers_crc_CRCSW__include
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <ti/drivers/CRC.h>
+
+/*!
+ *  @brief  Number of uint32_t entries in a CRCSW lookup table buffer
+ */
+#define CRCSW_TABLE_SIZE        (8 * 256)
+
+/*!  @brief  CRC function table for the software implementation */
+extern const CRC_FxnTable CRCSW_fxnTable;
+
+/*!
+ *  @brief  CRC hardware attributes for the software implementation
+ *
+ *  table points to CRCSW_TABLE_SIZE words (8 KB) of RAM owned by this
+ *  instance.
+ *
+ *  A sample structure is shown below:
+ *  @code
+ *  static uint32_t crcSWTable[CRCSW_TABLE_SIZE];
+ *
+ *  const CRCSW_HWAttrs crcSWHWAttrs[] = {
+ *      {
+ *          .table = crcSWTable
+ *      }
+ *  };
+ *  @endcode
+ */
+typedef struct CRCSW_HWAttrs {
+    /*! Lookup table storage, CRCSW_TABLE_SIZE entries */
+    uint32_t *table;
+} CRCSW_HWAttrs;
+
+/*!
+ *  @brief  CRC Object for the software implementation
+ *
+ *  Not to be accessed by the user.
+ */
+typedef struct CRCSW_Object {
+    uint32_t crc;           /* Running CRC register */
+    uint32_t seed;          /* Initial register value */
+    uint32_t finalXor;      /* Value XORed with the final CRC */
+    uint8_t  width;         /* CRC width in bits */
+    bool     reflect;       /* Reflect input bytes and the result */
+    bool     isOpen;        /* Flag for open/close status */
+} CRCSW_Object;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ti_drivers_crc_CRCSW__include */
@@ -55,10 +55,13 @@
 #include <ti/drivers/power/PowerCC32XX.h>
 
 #include <ti/drivers/crypto/CryptoCC32XX.h>
+#include <ti/drivers/dma/UDMACC32XX.h>
 
 #include <ti/devices/cc32xx/inc/hw_types.h>
 #include <ti/devices/cc32xx/inc/hw_ints.h>
 #include <ti/devices/cc32xx/inc/hw_memmap.h>
+#include <ti/devices/cc32xx/inc/hw_aes.h>
+#include <ti/devices/cc32xx/inc/hw_des.h>
 #include <ti/devices/cc32xx/inc/hw_shamd5.h>
 #include <ti/devices/cc32xx/driverlib/rom.h>
 #include <ti/devices/cc32xx/driverlib/rom_map.h>
@@ -66,6 +69,7 @@
 #include <ti/devices/cc32xx/driverlib/des.h>
 #include <ti/devices/cc32xx/driverlib/shamd5.h>
 #include <ti/devices/cc32xx/driverlib/prcm.h>
+#include <ti/devices/cc32xx/driverlib/udma.h>
 
 
 #define CryptoCC32XX_SHAMD5_SIGNATURE_LEN_MD5       16
@@ -75,6 +79,26 @@
 
 #define CryptoCC32XX_CONTEXT_READY_MAX_COUNTER      1000
 
+/* Largest uDMA basic mode transfer: 1024 words */
+#define CryptoCC32XX_DMA_MAX_TRANSFER               4096
+
+/* Engine indexes, from the crypto type bitwise */
+#define CryptoCC32XX_AES_INDEX  (CryptoCC32XX_AES >> 1)
+#define CryptoCC32XX_DES_INDEX  (CryptoCC32XX_DES >> 1)
+#define CryptoCC32XX_HMAC_INDEX (CryptoCC32XX_HMAC >> 1)
+
+/* Engine index of an asynchronous operation */
+#define CryptoCC32XX_getIndex(_op) (((_op)->hashCtx != NULL) ?             \
+    CryptoCC32XX_HMAC_INDEX : (((_op)->method >> 8) >> 1))
+
+/* Internal status: the operation was started, the engine's interrupt completes it */
+#define CryptoCC32XX_STATUS_IN_PROGRESS             1
+
+/* Size of the SHAMD5 engine's digest state, SHA224 uses the SHA256 state */
+#define CryptoCC32XX_SHAMD5GetStateSize(_mode)     ((_mode == SHAMD5_ALGO_MD5)     ? CryptoCC32XX_SHAMD5_SIGNATURE_LEN_MD5:      \
+                                                    (_mode == SHAMD5_ALGO_SHA1)    ?  CryptoCC32XX_SHAMD5_SIGNATURE_LEN_SHA1:    \
+                                                    CryptoCC32XX_SHAMD5_SIGNATURE_LEN_SHA256)
+
 #define CryptoCC32XX_SHAMD5GetSignatureSize(_mode) ((_mode == SHAMD5_ALGO_MD5)     ? CryptoCC32XX_SHAMD5_SIGNATURE_LEN_MD5:      \
                                                     (_mode == SHAMD5_ALGO_SHA1)    ?  CryptoCC32XX_SHAMD5_SIGNATURE_LEN_SHA1:    \
                                                     (_mode == SHAMD5_ALGO_SHA224)  ?  CryptoCC32XX_SHAMD5_SIGNATURE_LEN_SHA224:  \
@@ -92,13 +116,50 @@ typedef struct CryptoCC32XX_HwiP {
     uint32_t    intPriority;
 } CryptoCC32XX_HwiP;
 
+typedef struct CryptoCC32XX_DmaP {
+    /*! uDMA channel feeding the engine */
+    uint32_t    inChannel;
+    /*! uDMA channel draining the engine */
+    uint32_t    outChannel;
+    /*! Engine data register */
+    uint32_t    dataAddr;
+    /*! Words moved per DMA request: one cipher block */
+    uint32_t    arbSize;
+    /*! Cipher block size in bytes */
+    uint32_t    blockSize;
+} CryptoCC32XX_DmaP;
+
 /* Prototypes */
-int32_t         CryptoCC32XX_aesProcess(uint32_t cryptoMode , uint32_t cryptoDirection, uint8_t* pInBuff, uint16_t inLen, uint8_t* pOutBuff , CryptoCC32XX_EncryptParams* pParams);
-int32_t         CryptoCC32XX_desProcess(uint32_t cryptoMode , uint32_t cryptoDirection, uint8_t* pInBuff, uint16_t inLen, uint8_t* pOutBuff , CryptoCC32XX_EncryptParams* pParams);
+int32_t         CryptoCC32XX_aesProcess(uint32_t cryptoMode , uint32_t cryptoDirection, uint8_t* pInBuff, size_t inLen, uint8_t* pOutBuff , CryptoCC32XX_EncryptParams* pParams);
+int32_t         CryptoCC32XX_desProcess(uint32_t cryptoMode , uint32_t cryptoDirection, uint8_t* pInBuff, size_t inLen, uint8_t* pOutBuff , CryptoCC32XX_EncryptParams* pParams);
 int32_t         CryptoCC32XX_shamd5Process(uint32_t cryptoMode , uint8_t* pBuff, uint32_t len, uint8_t *pSignature, CryptoCC32XX_HmacParams* pParams);
-void            CryptoCC32XX_aesIntHandler(void);
-void            CryptoCC32XX_desIntHandler(void);
-void            CryptoCC32XX_shamd5IntHandler(void);
+void            CryptoCC32XX_aesIntHandler(uintptr_t arg);
+void            CryptoCC32XX_desIntHandler(uintptr_t arg);
+void            CryptoCC32XX_shamd5IntHandler(uintptr_t arg);
+static int32_t  CryptoCC32XX_aesSetup(uint32_t cryptoMode, uint32_t cryptoDirection, CryptoCC32XX_EncryptParams *pParams);
+static int32_t  CryptoCC32XX_desSetup(uint32_t cryptoMode, uint32_t cryptoDirection, CryptoCC32XX_EncryptParams *pParams);
+static bool     CryptoCC32XX_acquireEngine(CryptoCC32XX_Object *object, uint8_t cryptoIndex, uint32_t timeout);
+static void     CryptoCC32XX_releaseEngine(CryptoCC32XX_Handle handle, uint8_t cryptoIndex);
+static void     CryptoCC32XX_countJob(CryptoCC32XX_Object *object, uint8_t cryptoIndex, size_t len);
+static bool     CryptoCC32XX_canQueue(CryptoCC32XX_Object *object, CryptoCC32XX_Operation *op);
+static void     CryptoCC32XX_dispatch(CryptoCC32XX_Handle handle, uint8_t cryptoIndex);
+static bool     CryptoCC32XX_dmaCanProcess(CryptoCC32XX_Object *object, CryptoCC32XX_Operation *op);
+static void     CryptoCC32XX_dmaComplete(CryptoCC32XX_Handle handle, uint8_t cryptoIndex);
+static void     CryptoCC32XX_dmaFinish(CryptoCC32XX_Handle handle, uint8_t cryptoIndex, int32_t status);
+static void     CryptoCC32XX_dmaNext(CryptoCC32XX_DmaState *state, const CryptoCC32XX_DmaP *dmaP);
+static int32_t  CryptoCC32XX_dmaProcess(CryptoCC32XX_Handle handle, CryptoCC32XX_Operation *op);
+static void     CryptoCC32XX_dmaRelease(UDMACC32XX_Handle dmaHandle, uint8_t count);
+static bool     CryptoCC32XX_dmaReserve(UDMACC32XX_Handle dmaHandle);
+static void     CryptoCC32XX_dmaStart(CryptoCC32XX_Handle handle, uint8_t cryptoIndex, CryptoCC32XX_Operation *op, bool blocking, bool independent);
+static bool     CryptoCC32XX_hashBuffer(CryptoCC32XX_HashContext *ctx, const uint8_t **pData, size_t *len);
+static void     CryptoCC32XX_hashComplete(CryptoCC32XX_Handle handle);
+static size_t   CryptoCC32XX_hashDmaNext(const uint8_t *pData, size_t len);
+static int32_t  CryptoCC32XX_hashRestore(CryptoCC32XX_HashContext *ctx, size_t len, bool close);
+static int32_t  CryptoCC32XX_hashRound(CryptoCC32XX_Object *object, CryptoCC32XX_HashContext *ctx, const uint8_t *pData, size_t len, bool close, uint8_t *pDigest);
+static void     CryptoCC32XX_hashSave(CryptoCC32XX_HashContext *ctx, bool close, uint8_t *pDigest);
+static int32_t  CryptoCC32XX_hashStartRound(CryptoCC32XX_Object *object, const uint8_t *pData, size_t len, bool close);
+static int32_t  CryptoCC32XX_dmaStartOperation(CryptoCC32XX_Handle handle, uint8_t cryptoIndex);
+static void     CryptoCC32XX_dmaStopOperation(CryptoCC32XX_DmaState *state, uint8_t cryptoIndex);
 HwiP_Handle     CryptoCC32XX_register(CryptoCC32XX_Handle handle, CryptoCC32XX_HwiP *hwiP);
 void            CryptoCC32XX_unregister(HwiP_Handle handle);
 
@@ -110,6 +171,16 @@ CryptoCC32XX_HwiP CryptoCC32XX_HwiPTable[] = {
     { (HwiP_Fxn)CryptoCC32XX_shamd5IntHandler,  INT_SHA, (~0) }     /* SHAMD5 */
 };
 
+/* Crypto CC32XX uDMA channels, indexed like CryptoCC32XX_HwiPTable */
+static const CryptoCC32XX_DmaP CryptoCC32XX_DmaPTable[] = {
+    { UDMA_CH20_AES_DIN, UDMA_CH21_AES_DOUT, AES_BASE + AES_O_DATA_IN_0,
+      UDMA_ARB_4, CryptoCC32XX_AES_BLOCK_SIZE },                    /* AES */
+    { UDMA_CH4_DES_DIN,  UDMA_CH5_DES_DOUT,  DES_BASE + DES_O_DATA_L,
+      UDMA_ARB_2, CryptoCC32XX_DES_BLOCK_SIZE },                    /* DES */
+    { UDMA_CH1_SHAMD5_DIN, 0, SHAMD5_BASE + SHAMD5_O_DATA0_IN,
+      UDMA_ARB_16, CryptoCC32XX_SHA256_BLOCK_SIZE }                 /* SHAMD5 */
+};
+
 /* Crypto AES key size to Crypto CC32XX AES key size */
 #define CryptoCC32XX_getAesKeySize(_keySize) (                                  \
     (_keySize == CryptoCC32XX_AES_KEY_SIZE_128BIT)? AES_CFG_KEY_SIZE_128BIT:    \
@@ -142,11 +213,6 @@ CryptoCC32XX_HwiP CryptoCC32XX_HwiPTable[] = {
     CryptoCC32XX_STATUS_ERROR_NOT_SUPPORTED)
 
 
-/* global variables for the interrupt handles */
-static volatile bool g_bAESReadyFlag;
-static volatile bool g_bDESReadyFlag;
-static volatile bool g_bSHAMD5ReadyFlag;
-
 /* Externs */
 extern const CryptoCC32XX_Config CryptoCC32XX_config[];
 extern const uint8_t CryptoCC32XX_count;
@@ -173,12 +239,24 @@ void CryptoCC32XX_close(CryptoCC32XX_Handle handle)
         {
             SemaphoreP_delete(object->sem[type]);
         }
+        if (object->dmaSem[type] != NULL)
+        {
+            SemaphoreP_delete(object->dmaSem[type]);
+            object->dmaSem[type] = NULL;
+        }
         if (object->hwiHandle[type] != NULL)
         {
             CryptoCC32XX_unregister(object->hwiHandle[type]);
         }
    }
 
+    if (object->dmaHandle != NULL)
+    {
+        CryptoCC32XX_dmaRelease(object->dmaHandle, CryptoCC32XX_MAX_TYPES);
+        UDMACC32XX_close(object->dmaHandle);
+        object->dmaHandle = NULL;
+    }
+
     /* Mark the module as available */
     key = HwiP_disable();
 
@@ -195,6 +273,7 @@ void CryptoCC32XX_close(CryptoCC32XX_Handle handle)
  */
 void CryptoCC32XX_init(void)
 {
+    UDMACC32XX_init();
 }
 
 /*
@@ -247,6 +326,14 @@ CryptoCC32XX_Handle CryptoCC32XX_open(uint32_t index, uint32_t types)
                 CryptoCC32XX_close(handle);
                 return (NULL);
             }
+            /* DMA completion */
+            object->dma[type].op = NULL;
+            object->dmaSem[type] = SemaphoreP_create(0, &semParams);
+            if (object->dmaSem[type] == NULL)
+            {
+                CryptoCC32XX_close(handle);
+                return (NULL);
+            }
             /* interrupt handler */
             object->hwiHandle[type] = CryptoCC32XX_register(handle,&CryptoCC32XX_HwiPTable[type]);
             if (object->hwiHandle[type] == NULL)
@@ -258,8 +345,28 @@ CryptoCC32XX_Handle CryptoCC32XX_open(uint32_t index, uint32_t types)
         else
         {
             object->sem[type] = NULL;
+            object->dmaSem[type] = NULL;
         }
     }
+
+    /* Without uDMA the engines are fed by the CPU */
+    object->dmaHandle = UDMACC32XX_open();
+    if ((object->dmaHandle != NULL) &&
+        !CryptoCC32XX_dmaReserve(object->dmaHandle))
+    {
+        UDMACC32XX_close(object->dmaHandle);
+        object->dmaHandle = NULL;
+    }
+
+    for (type = 0; type < CryptoCC32XX_MAX_TYPES; type++)
+    {
+        object->queueHead[type] = NULL;
+        object->queueTail[type] = NULL;
+    }
+    memset(object->stats, 0, sizeof(object->stats));
+    object->statsStart = ClockP_getTimestamp();
+    object->statsStartTick = ClockP_getSystemTicks();
+
     /* Return the address of the handle */
     return (handle);
 }
@@ -284,6 +391,7 @@ int32_t CryptoCC32XX_encrypt(CryptoCC32XX_Handle handle, CryptoCC32XX_EncryptMet
     uint8_t cryptoType = method >> 8;
     uint32_t cryptoMode = CryptoCC32XX_getMode((uint32_t)method);
     int32_t status = CryptoCC32XX_STATUS_ERROR;
+    CryptoCC32XX_Operation op;
     /* Convert crypto type bitwise to index */
     uint8_t cryptoIndex = cryptoType >> 1;
 
@@ -293,23 +401,43 @@ int32_t CryptoCC32XX_encrypt(CryptoCC32XX_Handle handle, CryptoCC32XX_EncryptMet
         return CryptoCC32XX_STATUS_ERROR_NOT_SUPPORTED;
     }
     /* get the semaphore */
-    if (SemaphoreP_OK == SemaphoreP_pend(object->sem[cryptoIndex],
-                SemaphoreP_WAIT_FOREVER))
+    if (CryptoCC32XX_acquireEngine(object, cryptoIndex, SemaphoreP_WAIT_FOREVER))
     {
         switch (cryptoType)
         {
             case CryptoCC32XX_AES:
-                status = CryptoCC32XX_aesProcess(cryptoMode , AES_CFG_DIR_ENCRYPT, pInBuff, inLen, pOutBuff , pParams);
-            break;
             case CryptoCC32XX_DES:
-                status = CryptoCC32XX_desProcess(cryptoMode , DES_CFG_DIR_ENCRYPT, pInBuff, inLen, pOutBuff , pParams);
+                CryptoCC32XX_Operation_init(&op);
+                op.method = method;
+                op.decrypt = false;
+                op.pInBuff = pInBuff;
+                op.inLen = inLen;
+                op.pOutBuff = pOutBuff;
+                op.pParams = pParams;
+                if ((inLen >= CryptoCC32XX_DMA_MIN_SIZE) &&
+                    CryptoCC32XX_dmaCanProcess(object, &op))
+                {
+                    status = CryptoCC32XX_dmaProcess(handle, &op);
+                }
+                else if (cryptoType == CryptoCC32XX_AES)
+                {
+                    status = CryptoCC32XX_aesProcess(cryptoMode , AES_CFG_DIR_ENCRYPT, pInBuff, inLen, pOutBuff , pParams);
+                }
+                else
+                {
+                    status = CryptoCC32XX_desProcess(cryptoMode , DES_CFG_DIR_ENCRYPT, pInBuff, inLen, pOutBuff , pParams);
+                }
             break;
             default:
             break;
         }
+        if (status == CryptoCC32XX_STATUS_SUCCESS)
+        {
+            CryptoCC32XX_countJob(object, cryptoIndex, inLen);
+        }
 
         /* release the semaphore */
-        SemaphoreP_post(object->sem[cryptoIndex]);
+        CryptoCC32XX_releaseEngine(handle, cryptoIndex);
     }
     return status;
 }
@@ -323,6 +451,7 @@ int32_t CryptoCC32XX_decrypt(CryptoCC32XX_Handle handle, CryptoCC32XX_EncryptMet
     uint8_t cryptoType =  method >> 8;
     uint32_t cryptoMode = CryptoCC32XX_getMode((uint32_t)method);
     int32_t status = CryptoCC32XX_STATUS_ERROR;
+    CryptoCC32XX_Operation op;
     /* Convert crypto type bitwise to index */
     uint8_t cryptoIndex = cryptoType >> 1;
 
@@ -332,26 +461,193 @@ int32_t CryptoCC32XX_decrypt(CryptoCC32XX_Handle handle, CryptoCC32XX_EncryptMet
         return CryptoCC32XX_STATUS_ERROR_NOT_SUPPORTED;
     }
     /* get the semaphore */
-    if (SemaphoreP_OK == SemaphoreP_pend(object->sem[cryptoIndex],
-                SemaphoreP_WAIT_FOREVER))
+    if (CryptoCC32XX_acquireEngine(object, cryptoIndex, SemaphoreP_WAIT_FOREVER))
     {
         switch (cryptoType)
         {
             case CryptoCC32XX_AES:
-                status = CryptoCC32XX_aesProcess(cryptoMode , AES_CFG_DIR_DECRYPT, pInBuff, inLen, pOutBuff , pParams);
-            break;
             case CryptoCC32XX_DES:
-                status = CryptoCC32XX_desProcess(cryptoMode , DES_CFG_DIR_DECRYPT, pInBuff, inLen, pOutBuff , pParams);
+                CryptoCC32XX_Operation_init(&op);
+                op.method = method;
+                op.decrypt = true;
+                op.pInBuff = pInBuff;
+                op.inLen = inLen;
+                op.pOutBuff = pOutBuff;
+                op.pParams = pParams;
+                if ((inLen >= CryptoCC32XX_DMA_MIN_SIZE) &&
+                    CryptoCC32XX_dmaCanProcess(object, &op))
+                {
+                    status = CryptoCC32XX_dmaProcess(handle, &op);
+                }
+                else if (cryptoType == CryptoCC32XX_AES)
+                {
+                    status = CryptoCC32XX_aesProcess(cryptoMode , AES_CFG_DIR_DECRYPT, pInBuff, inLen, pOutBuff , pParams);
+                }
+                else
+                {
+                    status = CryptoCC32XX_desProcess(cryptoMode , DES_CFG_DIR_DECRYPT, pInBuff, inLen, pOutBuff , pParams);
+                }
             break;
             default:
             break;
         }
+        if (status == CryptoCC32XX_STATUS_SUCCESS)
+        {
+            CryptoCC32XX_countJob(object, cryptoIndex, inLen);
+        }
         /* release the semaphore */
-        SemaphoreP_post(object->sem[cryptoIndex]);
+        CryptoCC32XX_releaseEngine(handle, cryptoIndex);
     }
     return status;
 }
 
+/*
+ *  ======== CryptoCC32XX_submit ========
+ */
+int32_t CryptoCC32XX_submit(CryptoCC32XX_Handle handle, CryptoCC32XX_Operation *op)
+{
+    CryptoCC32XX_Object     *object = handle->object;
+    CryptoCC32XX_Operation  *next;
+    uint8_t cryptoIndex = CryptoCC32XX_getIndex(op);
+
+    /* The whole chain must be able to run from the interrupt */
+    for (next = op; next != NULL; next = next->next)
+    {
+        if ((CryptoCC32XX_getIndex(next) != cryptoIndex) ||
+            !CryptoCC32XX_canQueue(object, next))
+        {
+            return CryptoCC32XX_STATUS_ERROR_NOT_SUPPORTED;
+        }
+    }
+
+    /* get the semaphore, it is released when the chain completes */
+    if (!CryptoCC32XX_acquireEngine(object, cryptoIndex, SemaphoreP_WAIT_FOREVER))
+    {
+        return CryptoCC32XX_STATUS_ERROR;
+    }
+
+    CryptoCC32XX_dmaStart(handle, cryptoIndex, op, false, false);
+    return CryptoCC32XX_STATUS_SUCCESS;
+}
+
+/*
+ *  ======== CryptoCC32XX_queue ========
+ */
+int32_t CryptoCC32XX_queue(CryptoCC32XX_Handle handle, CryptoCC32XX_Operation *op)
+{
+    CryptoCC32XX_Object     *object = handle->object;
+    CryptoCC32XX_EngineStats *stats;
+    CryptoCC32XX_Operation  *next;
+    uintptr_t key;
+    uint8_t   cryptoIndex;
+    uint8_t   engines = 0;
+
+    if (!CryptoCC32XX_canQueue(object, op))
+    {
+        return CryptoCC32XX_STATUS_ERROR_NOT_SUPPORTED;
+    }
+
+    for (; op != NULL; op = next)
+    {
+        next = op->next;
+        cryptoIndex = CryptoCC32XX_getIndex(op);
+        stats = &object->stats[cryptoIndex];
+        op->next = NULL;
+
+        key = HwiP_disable();
+        if (object->queueTail[cryptoIndex] == NULL)
+        {
+            object->queueHead[cryptoIndex] = op;
+        }
+        else
+        {
+            object->queueTail[cryptoIndex]->next = op;
+        }
+        object->queueTail[cryptoIndex] = op;
+        if (++stats->queued > stats->maxQueued)
+        {
+            stats->maxQueued = stats->queued;
+        }
+        HwiP_restore(key);
+
+        engines |= 1 << cryptoIndex;
+    }
+
+    for (cryptoIndex = 0; cryptoIndex < CryptoCC32XX_MAX_TYPES; cryptoIndex++)
+    {
+        if (engines & (1 << cryptoIndex))
+        {
+            CryptoCC32XX_dispatch(handle, cryptoIndex);
+        }
+    }
+    return CryptoCC32XX_STATUS_SUCCESS;
+}
+
+/*
+ *  ======== CryptoCC32XX_Operation_init ========
+ */
+void CryptoCC32XX_Operation_init(CryptoCC32XX_Operation *op)
+{
+    memset(op, 0, sizeof(CryptoCC32XX_Operation));
+    op->method = CryptoCC32XX_AES_ECB;
+}
+
+/*
+ *  ======== CryptoCC32XX_getEngineStats ========
+ */
+void CryptoCC32XX_getEngineStats(CryptoCC32XX_Handle handle, CryptoCC32XX_Type type, CryptoCC32XX_EngineStats *stats)
+{
+    CryptoCC32XX_Object     *object = handle->object;
+    uint8_t   cryptoIndex = type >> 1;
+    uintptr_t key;
+    ClockP_FreqHz freq;
+    uint64_t  usecs;
+
+    DebugP_assert(cryptoIndex < CryptoCC32XX_MAX_TYPES);
+
+    ClockP_getTimestampFreq(&freq);
+
+    key = HwiP_disable();
+    *stats = object->stats[cryptoIndex];
+    stats->timestampFreq = freq.lo;
+
+    /*
+     * The 32-bit timestamp wraps (after ~53 s at 80 MHz); once that may have
+     * happened the elapsed time is derived from the system tick instead.
+     */
+    usecs = (uint64_t)(ClockP_getSystemTicks() - object->statsStartTick) *
+        ClockP_getSystemTickPeriod();
+    stats->elapsedTicks = (usecs / 1000U) * freq.lo / 1000U;
+    if (stats->elapsedTicks < 0x80000000U)
+    {
+        stats->elapsedTicks = ClockP_getTimestamp() - object->statsStart;
+    }
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== CryptoCC32XX_clearEngineStats ========
+ */
+void CryptoCC32XX_clearEngineStats(CryptoCC32XX_Handle handle)
+{
+    CryptoCC32XX_Object     *object = handle->object;
+    CryptoCC32XX_EngineStats *stats;
+    uintptr_t key;
+    uint8_t   cryptoIndex;
+
+    key = HwiP_disable();
+    for (cryptoIndex = 0; cryptoIndex < CryptoCC32XX_MAX_TYPES; cryptoIndex++)
+    {
+        stats = &object->stats[cryptoIndex];
+        stats->jobs = 0;
+        stats->bytes = 0;
+        stats->busyTicks = 0;
+        stats->maxQueued = stats->queued;
+    }
+    object->statsStart = ClockP_getTimestamp();
+    object->statsStartTick = ClockP_getSystemTicks();
+    HwiP_restore(key);
+}
 
 /*
  *  ======== CryptoCC32XX_sign ========
@@ -371,8 +667,7 @@ int32_t CryptoCC32XX_sign(CryptoCC32XX_Handle handle, CryptoCC32XX_HmacMethod me
         return CryptoCC32XX_STATUS_ERROR_NOT_SUPPORTED;
     }
     /* get the semaphore */
-    if (SemaphoreP_OK == SemaphoreP_pend(object->sem[cryptoIndex],
-                SemaphoreP_WAIT_FOREVER))
+    if (CryptoCC32XX_acquireEngine(object, cryptoIndex, SemaphoreP_WAIT_FOREVER))
     {
         switch (cryptoType)
         {
@@ -382,8 +677,12 @@ int32_t CryptoCC32XX_sign(CryptoCC32XX_Handle handle, CryptoCC32XX_HmacMethod me
             default:
             break;
         }
+        if (status == CryptoCC32XX_STATUS_SUCCESS)
+        {
+            CryptoCC32XX_countJob(object, cryptoIndex, len);
+        }
         /* release the semaphore */
-        SemaphoreP_post(object->sem[cryptoIndex]);
+        CryptoCC32XX_releaseEngine(handle, cryptoIndex);
     }
     return status;
 }
@@ -408,8 +707,7 @@ int32_t CryptoCC32XX_verify(CryptoCC32XX_Handle handle, CryptoCC32XX_HmacMethod
         return CryptoCC32XX_STATUS_ERROR_NOT_SUPPORTED;
     }
     /* get the semaphore */
-    if (SemaphoreP_OK == SemaphoreP_pend(object->sem[cryptoIndex],
-                SemaphoreP_WAIT_FOREVER))
+    if (CryptoCC32XX_acquireEngine(object, cryptoIndex, SemaphoreP_WAIT_FOREVER))
     {
         switch (cryptoType)
         {
@@ -440,47 +738,157 @@ int32_t CryptoCC32XX_verify(CryptoCC32XX_Handle handle, CryptoCC32XX_HmacMethod
             default:
             break;
         }
+        if (status != CryptoCC32XX_STATUS_ERROR)
+        {
+            CryptoCC32XX_countJob(object, cryptoIndex, len);
+        }
         /* release the semaphore */
-        SemaphoreP_post(object->sem[cryptoIndex]);
+        CryptoCC32XX_releaseEngine(handle, cryptoIndex);
     }
     return status;
 }
 
 /*
- *  ======== CryptoCC32XX_shamd5Process ========
+ *  ======== CryptoCC32XX_hashFinal ========
  */
-int32_t CryptoCC32XX_shamd5Process(uint32_t cryptoMode , uint8_t *pBuff, uint32_t len, uint8_t *pSignature, CryptoCC32XX_HmacParams *pParams)
+int32_t CryptoCC32XX_hashFinal(CryptoCC32XX_Handle handle, CryptoCC32XX_HashContext *ctx, uint8_t *pDigest)
 {
-    int32_t count = CryptoCC32XX_CONTEXT_READY_MAX_COUNTER;
-    uint32_t blockComplementLen = 0;
-    uint32_t newLen = 0;
-    uint32_t copyLen = 0;
-    uint32_t totalLen = 0;
-    uint32_t blockRemainder = 0;
-    /*
-    Step1: Enable Interrupts
-    Step2: Wait for Context Ready Interrupt
-    Step3: Set the Configuration Parameters (Hash Algorithm)
-    Step4: Set Key
-    Step5: Start Hash Generation
-    */
+    CryptoCC32XX_Object     *object = handle->object;
+    int32_t status = CryptoCC32XX_STATUS_ERROR;
 
-    if((pBuff == NULL) || (0 == len))
+    /* check semaphore created  */
+    if (object->sem[CryptoCC32XX_HMAC_INDEX] == NULL)
     {
-      return CryptoCC32XX_STATUS_ERROR;
+        return CryptoCC32XX_STATUS_ERROR_NOT_SUPPORTED;
+    }
+
+    /* The engine can't close a hash without data */
+    if (ctx->buffLen == 0)
+    {
+        return CryptoCC32XX_STATUS_ERROR;
+    }
+
+    /* get the semaphore */
+    if (CryptoCC32XX_acquireEngine(object, CryptoCC32XX_HMAC_INDEX, SemaphoreP_WAIT_FOREVER))
+    {
+        status = CryptoCC32XX_hashRound(object, ctx, NULL, 0, true, pDigest);
+        if (status == CryptoCC32XX_STATUS_SUCCESS)
+        {
+            CryptoCC32XX_countJob(object, CryptoCC32XX_HMAC_INDEX, 0);
+        }
+
+        /* release the semaphore */
+        CryptoCC32XX_releaseEngine(handle, CryptoCC32XX_HMAC_INDEX);
+    }
+
+    /* Ready for the next calculation */
+    ctx->digestCount = 0;
+    ctx->buffLen = 0;
+
+    return status;
+}
+
+/*
+ *  ======== CryptoCC32XX_hashInit ========
+ */
+int32_t CryptoCC32XX_hashInit(CryptoCC32XX_Handle handle, CryptoCC32XX_HashContext *ctx, CryptoCC32XX_HmacMethod method, uint8_t *pKey)
+{
+    CryptoCC32XX_Object     *object = handle->object;
+
+    if ((object->sem[CryptoCC32XX_HMAC_INDEX] == NULL) ||
+        ((method >> 8) != CryptoCC32XX_HMAC))
+    {
+        return CryptoCC32XX_STATUS_ERROR_NOT_SUPPORTED;
+    }
+
+    ctx->method = method;
+    ctx->pKey = pKey;
+    ctx->digestCount = 0;
+    ctx->buffLen = 0;
+
+    return CryptoCC32XX_STATUS_SUCCESS;
+}
+
+/*
+ *  ======== CryptoCC32XX_hashBuffer ========
+ *  Adds the start of an update to the data held back in ctx. Returns false
+ *  if the whole update fits, as at least one byte is always held back for
+ *  the closing round: the engine can't close a hash without data.
+ *  Otherwise the held back data is complemented to a block and pData and
+ *  len are advanced past the bytes taken.
+ */
+static bool CryptoCC32XX_hashBuffer(CryptoCC32XX_HashContext *ctx, const uint8_t **pData, size_t *len)
+{
+    uint32_t copyLen;
+
+    if ((ctx->buffLen + *len) <= CryptoCC32XX_MAX_BLOCK_SIZE)
+    {
+        memcpy((uint8_t *)ctx->buff + ctx->buffLen, *pData, *len);
+        ctx->buffLen += *len;
+        return false;
+    }
+
+    /* Complement the buffered data to a block */
+    if (ctx->buffLen > 0)
+    {
+        copyLen = CryptoCC32XX_MAX_BLOCK_SIZE - ctx->buffLen;
+        memcpy((uint8_t *)ctx->buff + ctx->buffLen, *pData, copyLen);
+        ctx->buffLen = CryptoCC32XX_MAX_BLOCK_SIZE;
+        *pData += copyLen;
+        *len -= copyLen;
+    }
+    return true;
+}
+
+/*
+ *  ======== CryptoCC32XX_hashDmaNext ========
+ *  Sets up the uDMA to feed the SHAMD5 engine with up to one transfer of
+ *  pData. The engine raises SHAMD5_INT_DMA_DATA_IN when it is done.
+ *  Returns the number of bytes moved.
+ */
+static size_t CryptoCC32XX_hashDmaNext(const uint8_t *pData, size_t len)
+{
+    const CryptoCC32XX_DmaP *dmaP = &CryptoCC32XX_DmaPTable[CryptoCC32XX_HMAC_INDEX];
+    uintptr_t key;
+
+    if (len > CryptoCC32XX_DMA_MAX_TRANSFER)
+    {
+        len = CryptoCC32XX_DMA_MAX_TRANSFER;
     }
 
-    /* Clear the flag */
-    g_bSHAMD5ReadyFlag = false;
+    MAP_uDMAChannelControlSet(dmaP->inChannel | UDMA_PRI_SELECT,
+        UDMA_SIZE_32 | UDMA_SRC_INC_32 | UDMA_DST_INC_NONE | dmaP->arbSize);
+    MAP_uDMAChannelAttributeDisable(dmaP->inChannel, UDMA_ATTR_ALTSELECT);
+    MAP_uDMAChannelTransferSet(dmaP->inChannel | UDMA_PRI_SELECT,
+        UDMA_MODE_BASIC, (void *)pData, (void *)dmaP->dataAddr,
+        len / sizeof(uint32_t));
+
+    MAP_SHAMD5IntClear(SHAMD5_BASE, SHAMD5_INT_DMA_DATA_IN);
+    MAP_SHAMD5IntEnable(SHAMD5_BASE, SHAMD5_INT_DMA_DATA_IN);
 
-    /* Enable interrupts. */
-    MAP_SHAMD5IntEnable(SHAMD5_BASE, SHAMD5_INT_CONTEXT_READY |
-                    SHAMD5_INT_PARTHASH_READY |
-                    SHAMD5_INT_INPUT_READY |
-                    SHAMD5_INT_OUTPUT_READY);
+    /* A lock is needed because we are accessing shared uDMA memory */
+    key = HwiP_disable();
+    MAP_uDMAChannelEnable(dmaP->inChannel);
+    HwiP_restore(key);
+
+    return len;
+}
+
+/*
+ *  ======== CryptoCC32XX_hashRestore ========
+ *  Starts a pass of the SHAMD5 engine for ctx that is followed by len more
+ *  bytes: restores the engine state from ctx and writes the buffered data.
+ */
+static int32_t CryptoCC32XX_hashRestore(CryptoCC32XX_HashContext *ctx, size_t len, bool close)
+{
+    uint32_t cryptoMode = CryptoCC32XX_getMode((uint32_t)ctx->method);
+    uint32_t stateSize = CryptoCC32XX_SHAMD5GetStateSize(cryptoMode);
+    uint8_t  hmac = (ctx->pKey != NULL);
+    int32_t  count = CryptoCC32XX_CONTEXT_READY_MAX_COUNTER;
+    uint32_t i;
 
     /* Wait for the context ready flag. */
-    while ((!g_bSHAMD5ReadyFlag) && (count > 0))
+    while (((MAP_SHAMD5IntStatus(SHAMD5_BASE, false) & SHAMD5_INT_CONTEXT_READY) == 0) && (count > 0))
     {
         count --;
     }
@@ -488,73 +896,369 @@ int32_t CryptoCC32XX_shamd5Process(uint32_t cryptoMode , uint8_t *pBuff, uint32_
     {
         return CryptoCC32XX_STATUS_ERROR;
     }
-        
-    if (pParams->moreData == 1)
-    {
-        /* Less than block size available. Copy the received data to the internal buffer and return */
-        if((pParams->buffLen + len) < pParams->blockSize)
-        {
-            memcpy(&pParams->buff[pParams->buffLen], pBuff, len);
-            pParams->buffLen += len;
-            return CryptoCC32XX_STATUS_SUCCESS;
-        }
 
-        if(pParams->first)
+    if (ctx->digestCount == 0)
+    {
+        /* First round: start from the algorithm constants or the key */
+        if (hmac)
         {
-            /* If Keyed Hashing is used, set Key */
-            if (pParams->pKey != NULL)
-            {
-                MAP_SHAMD5HMACKeySet(SHAMD5_BASE, pParams->pKey);
-                MAP_SHAMD5ConfigSet(SHAMD5_BASE, cryptoMode, 0, 0, 1, 0);
-            }
-            else
-            {
-                MAP_SHAMD5ConfigSet(SHAMD5_BASE, cryptoMode, 1, 0, 0, 0);
-            }
-
-            /* Will write data in this iteration. Unset first */
-            pParams->first = 0;
+            MAP_SHAMD5HMACKeySet(SHAMD5_BASE, ctx->pKey);
+            MAP_SHAMD5ConfigSet(SHAMD5_BASE, cryptoMode, 0, close, 1, close);
         }
         else
         {
-            MAP_SHAMD5ConfigSet(SHAMD5_BASE, cryptoMode, 0, 0, 0, 0);
-            /* Write the intermediate digest and count in case it isn't the first round */
-            SHAMD5ResultWrite(SHAMD5_BASE, pParams->innerDigest);
-            SHAMD5WriteDigestCount(SHAMD5_BASE, pParams->digestCount);
+            MAP_SHAMD5ConfigSet(SHAMD5_BASE, cryptoMode, 1, close, 0, 0);
         }
     }
     else
     {
-        if(pParams->first)
-        {    
-            /* If Keyed Hashing is used, set Key */
-            if (pParams->pKey != NULL)
-            {
-                MAP_SHAMD5HMACKeySet(SHAMD5_BASE, pParams->pKey);
-                MAP_SHAMD5ConfigSet(SHAMD5_BASE, cryptoMode, 0, 1, 1, 1);
-            }
-            else
-            {
-                MAP_SHAMD5ConfigSet(SHAMD5_BASE, cryptoMode, 1, 1, 0, 0);
-            }
-        }
-        else
+        /* Restore the state saved by the previous round */
+        MAP_SHAMD5ConfigSet(SHAMD5_BASE, cryptoMode, 0, close, 0, hmac & close);
+        for (i = 0; i < stateSize; i += sizeof(uint32_t))
         {
-            /* Write the intermediate digest and count in case it isn't the first round */
-            SHAMD5ResultWrite(SHAMD5_BASE, pParams->innerDigest);
-            SHAMD5WriteDigestCount(SHAMD5_BASE, pParams->digestCount);
-            if (pParams->pKey != NULL)
-            {
-                MAP_SHAMD5ConfigSet(SHAMD5_BASE, cryptoMode, 0, 1, 0, 1);
-            }
-            else
+            if (hmac)
             {
-                MAP_SHAMD5ConfigSet(SHAMD5_BASE, cryptoMode, 0, 1, 0, 0);
+                HWREG(SHAMD5_BASE + SHAMD5_O_ODIGEST_A + i) = ctx->outerDigest[i / sizeof(uint32_t)];
             }
-            
-            /* This is the last iteration for the requested calculation */
-            /* Set the first flag to 1 (initial value) for next calculations */
-            pParams->first = 1;
+            HWREG(SHAMD5_BASE + SHAMD5_O_IDIGEST_A + i) = ctx->innerDigest[i / sizeof(uint32_t)];
+        }
+        SHAMD5WriteDigestCount(SHAMD5_BASE, ctx->digestCount);
+    }
+
+    SHAMD5DataLengthSet(SHAMD5_BASE, ctx->buffLen + len);
+    if (ctx->buffLen > 0)
+    {
+        SHAMD5DataWriteMultiple(SHAMD5_BASE, (uint8_t *)ctx->buff, ctx->buffLen);
+    }
+
+    return CryptoCC32XX_STATUS_SUCCESS;
+}
+
+/*
+ *  ======== CryptoCC32XX_hashSave ========
+ *  Ends a pass of the SHAMD5 engine: waits for the output and saves the
+ *  engine state to ctx, or writes the result to pDigest if the hash is
+ *  closed.
+ */
+static void CryptoCC32XX_hashSave(CryptoCC32XX_HashContext *ctx, bool close, uint8_t *pDigest)
+{
+    uint32_t cryptoMode = CryptoCC32XX_getMode((uint32_t)ctx->method);
+    uint32_t stateSize = CryptoCC32XX_SHAMD5GetStateSize(cryptoMode);
+    uint32_t i;
+
+    /* Wait for the output to be ready */
+    while((HWREG(SHAMD5_BASE + SHAMD5_O_IRQSTATUS) & SHAMD5_INT_OUTPUT_READY) == 0)
+    {
+    }
+
+    if (close)
+    {
+        MAP_SHAMD5ResultRead(SHAMD5_BASE, pDigest);
+    }
+    else
+    {
+        /* Save the state for the next round */
+        for (i = 0; i < stateSize; i += sizeof(uint32_t))
+        {
+            if (ctx->pKey != NULL)
+            {
+                ctx->outerDigest[i / sizeof(uint32_t)] = HWREG(SHAMD5_BASE + SHAMD5_O_ODIGEST_A + i);
+            }
+            ctx->innerDigest[i / sizeof(uint32_t)] = HWREG(SHAMD5_BASE + SHAMD5_O_IDIGEST_A + i);
+        }
+        SHAMD5ReadDigestCount(SHAMD5_BASE, &ctx->digestCount);
+    }
+}
+
+/*
+ *  ======== CryptoCC32XX_hashRound ========
+ *  Runs one pass of the SHAMD5 engine for ctx over the buffered data
+ *  followed by len bytes from pData, and waits for it. The engine state is
+ *  restored from ctx beforehand and saved to it afterwards unless the hash
+ *  is closed, in which case the result is written to pDigest. Called with
+ *  the HMAC engine semaphore held.
+ */
+static int32_t CryptoCC32XX_hashRound(CryptoCC32XX_Object *object, CryptoCC32XX_HashContext *ctx, const uint8_t *pData, size_t len, bool close, uint8_t *pDigest)
+{
+    size_t   xferLen;
+    int32_t  status;
+
+    status = CryptoCC32XX_hashRestore(ctx, len, close);
+    if (status != CryptoCC32XX_STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    if ((len >= CryptoCC32XX_DMA_MIN_SIZE) && (object->dmaHandle != NULL) &&
+        (((uintptr_t)pData & 0x3) == 0))
+    {
+        /* The uDMA does not run in LPDS */
+        Power_setConstraint(PowerCC32XX_DISALLOW_LPDS);
+        MAP_SHAMD5DMAEnable(SHAMD5_BASE);
+
+        while (len > 0)
+        {
+            xferLen = CryptoCC32XX_hashDmaNext(pData, len);
+            SemaphoreP_pend(object->dmaSem[CryptoCC32XX_HMAC_INDEX], SemaphoreP_WAIT_FOREVER);
+
+            pData += xferLen;
+            len -= xferLen;
+        }
+
+        MAP_SHAMD5DMADisable(SHAMD5_BASE);
+        Power_releaseConstraint(PowerCC32XX_DISALLOW_LPDS);
+    }
+    else if (len > 0)
+    {
+        SHAMD5DataWriteMultiple(SHAMD5_BASE, (uint8_t *)pData, len);
+    }
+
+    CryptoCC32XX_hashSave(ctx, close, pDigest);
+
+    return CryptoCC32XX_STATUS_SUCCESS;
+}
+
+/*
+ *  ======== CryptoCC32XX_hashStartRound ========
+ *  Starts one pass of the SHAMD5 engine for the current hash operation, as
+ *  CryptoCC32XX_hashRound() but without waiting: the output ready interrupt
+ *  calls CryptoCC32XX_hashComplete() when the engine is done.
+ */
+static int32_t CryptoCC32XX_hashStartRound(CryptoCC32XX_Object *object, const uint8_t *pData, size_t len, bool close)
+{
+    CryptoCC32XX_DmaState   *state = &object->dma[CryptoCC32XX_HMAC_INDEX];
+    size_t   xferLen;
+    int32_t  status;
+
+    status = CryptoCC32XX_hashRestore(state->op->hashCtx, len, close);
+    if (status != CryptoCC32XX_STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    state->closing = close;
+    state->remaining = 0;
+
+    if ((len >= CryptoCC32XX_DMA_MIN_SIZE) && (object->dmaHandle != NULL) &&
+        (((uintptr_t)pData & 0x3) == 0))
+    {
+        /*
+         * The rest must be recorded before the channel is enabled: the
+         * uDMA done interrupt continues from it.
+         */
+        xferLen = (len > CryptoCC32XX_DMA_MAX_TRANSFER) ?
+            CryptoCC32XX_DMA_MAX_TRANSFER : len;
+        state->pIn = (uint8_t *)pData + xferLen;
+        state->remaining = len - xferLen;
+
+        MAP_SHAMD5DMAEnable(SHAMD5_BASE);
+        CryptoCC32XX_hashDmaNext(pData, xferLen);
+    }
+    else
+    {
+        if (len > 0)
+        {
+            SHAMD5DataWriteMultiple(SHAMD5_BASE, (uint8_t *)pData, len);
+        }
+        MAP_SHAMD5IntEnable(SHAMD5_BASE, SHAMD5_INT_OUTPUT_READY);
+    }
+
+    return CryptoCC32XX_STATUS_IN_PROGRESS;
+}
+
+/*
+ *  ======== CryptoCC32XX_hashComplete ========
+ *  Called from the SHAMD5 interrupt when a pass started by
+ *  CryptoCC32XX_hashStartRound() is done. Holds back the rest of the
+ *  operation's data in the context and, if a digest was asked for, starts
+ *  the closing round; otherwise completes the operation.
+ */
+static void CryptoCC32XX_hashComplete(CryptoCC32XX_Handle handle)
+{
+    CryptoCC32XX_Object     *object = handle->object;
+    CryptoCC32XX_DmaState   *state = &object->dma[CryptoCC32XX_HMAC_INDEX];
+    CryptoCC32XX_Operation  *op = state->op;
+    CryptoCC32XX_HashContext *ctx;
+    int32_t status = CryptoCC32XX_STATUS_SUCCESS;
+
+    if (op == NULL)
+    {
+        return;
+    }
+    ctx = op->hashCtx;
+
+    if (state->closing)
+    {
+        CryptoCC32XX_hashSave(ctx, true, op->pDigest);
+
+        /* Ready for the next calculation */
+        ctx->digestCount = 0;
+        ctx->buffLen = 0;
+    }
+    else
+    {
+        CryptoCC32XX_hashSave(ctx, false, NULL);
+        ctx->buffLen = state->tailLen;
+        memcpy(ctx->buff, state->pTail, state->tailLen);
+
+        if (op->pDigest != NULL)
+        {
+            status = CryptoCC32XX_hashStartRound(object, NULL, 0, true);
+            if (status == CryptoCC32XX_STATUS_IN_PROGRESS)
+            {
+                return;
+            }
+        }
+    }
+
+    CryptoCC32XX_dmaFinish(handle, CryptoCC32XX_HMAC_INDEX, status);
+}
+
+/*
+ *  ======== CryptoCC32XX_hashUpdate ========
+ */
+int32_t CryptoCC32XX_hashUpdate(CryptoCC32XX_Handle handle, CryptoCC32XX_HashContext *ctx, const void *pBuff, size_t len)
+{
+    CryptoCC32XX_Object     *object = handle->object;
+    const uint8_t *pData = pBuff;
+    size_t   totalLen = len;
+    size_t   hashLen;
+    int32_t  status = CryptoCC32XX_STATUS_ERROR;
+
+    /* check semaphore created  */
+    if (object->sem[CryptoCC32XX_HMAC_INDEX] == NULL)
+    {
+        return CryptoCC32XX_STATUS_ERROR_NOT_SUPPORTED;
+    }
+
+    if (!CryptoCC32XX_hashBuffer(ctx, &pData, &len))
+    {
+        return CryptoCC32XX_STATUS_SUCCESS;
+    }
+
+    /* Hash whole blocks from the caller's buffer, holding back the last */
+    hashLen = ((len - 1) / CryptoCC32XX_MAX_BLOCK_SIZE) * CryptoCC32XX_MAX_BLOCK_SIZE;
+
+    /* get the semaphore */
+    if (CryptoCC32XX_acquireEngine(object, CryptoCC32XX_HMAC_INDEX, SemaphoreP_WAIT_FOREVER))
+    {
+        status = CryptoCC32XX_hashRound(object, ctx, pData, hashLen, false, NULL);
+        if (status == CryptoCC32XX_STATUS_SUCCESS)
+        {
+            CryptoCC32XX_countJob(object, CryptoCC32XX_HMAC_INDEX, totalLen);
+        }
+
+        /* release the semaphore */
+        CryptoCC32XX_releaseEngine(handle, CryptoCC32XX_HMAC_INDEX);
+    }
+
+    if (status == CryptoCC32XX_STATUS_SUCCESS)
+    {
+        ctx->buffLen = len - hashLen;
+        memcpy(ctx->buff, pData + hashLen, ctx->buffLen);
+    }
+    return status;
+}
+
+/*
+ *  ======== CryptoCC32XX_shamd5Process ========
+ */
+int32_t CryptoCC32XX_shamd5Process(uint32_t cryptoMode , uint8_t *pBuff, uint32_t len, uint8_t *pSignature, CryptoCC32XX_HmacParams *pParams)
+{
+    int32_t count = CryptoCC32XX_CONTEXT_READY_MAX_COUNTER;
+    uint32_t blockComplementLen = 0;
+    uint32_t newLen = 0;
+    uint32_t copyLen = 0;
+    uint32_t totalLen = 0;
+    uint32_t blockRemainder = 0;
+    /*
+    Step1: Wait for Context Ready
+    Step2: Set the Configuration Parameters (Hash Algorithm)
+    Step3: Set Key
+    Step4: Start Hash Generation
+    */
+
+    if((pBuff == NULL) || (0 == len))
+    {
+      return CryptoCC32XX_STATUS_ERROR;
+    }
+
+    /* Wait for the context ready flag. */
+    while (((MAP_SHAMD5IntStatus(SHAMD5_BASE, false) & SHAMD5_INT_CONTEXT_READY) == 0) && (count > 0))
+    {
+        count --;
+    }
+    if (count == 0)
+    {
+        return CryptoCC32XX_STATUS_ERROR;
+    }
+        
+    if (pParams->moreData == 1)
+    {
+        /* Less than block size available. Copy the received data to the internal buffer and return */
+        if((pParams->buffLen + len) < pParams->blockSize)
+        {
+            memcpy(&pParams->buff[pParams->buffLen], pBuff, len);
+            pParams->buffLen += len;
+            return CryptoCC32XX_STATUS_SUCCESS;
+        }
+
+        if(pParams->first)
+        {
+            /* If Keyed Hashing is used, set Key */
+            if (pParams->pKey != NULL)
+            {
+                MAP_SHAMD5HMACKeySet(SHAMD5_BASE, pParams->pKey);
+                MAP_SHAMD5ConfigSet(SHAMD5_BASE, cryptoMode, 0, 0, 1, 0);
+            }
+            else
+            {
+                MAP_SHAMD5ConfigSet(SHAMD5_BASE, cryptoMode, 1, 0, 0, 0);
+            }
+
+            /* Will write data in this iteration. Unset first */
+            pParams->first = 0;
+        }
+        else
+        {
+            MAP_SHAMD5ConfigSet(SHAMD5_BASE, cryptoMode, 0, 0, 0, 0);
+            /* Write the intermediate digest and count in case it isn't the first round */
+            SHAMD5ResultWrite(SHAMD5_BASE, pParams->innerDigest);
+            SHAMD5WriteDigestCount(SHAMD5_BASE, pParams->digestCount);
+        }
+    }
+    else
+    {
+        if(pParams->first)
+        {    
+            /* If Keyed Hashing is used, set Key */
+            if (pParams->pKey != NULL)
+            {
+                MAP_SHAMD5HMACKeySet(SHAMD5_BASE, pParams->pKey);
+                MAP_SHAMD5ConfigSet(SHAMD5_BASE, cryptoMode, 0, 1, 1, 1);
+            }
+            else
+            {
+                MAP_SHAMD5ConfigSet(SHAMD5_BASE, cryptoMode, 1, 1, 0, 0);
+            }
+        }
+        else
+        {
+            /* Write the intermediate digest and count in case it isn't the first round */
+            SHAMD5ResultWrite(SHAMD5_BASE, pParams->innerDigest);
+            SHAMD5WriteDigestCount(SHAMD5_BASE, pParams->digestCount);
+            if (pParams->pKey != NULL)
+            {
+                MAP_SHAMD5ConfigSet(SHAMD5_BASE, cryptoMode, 0, 1, 0, 1);
+            }
+            else
+            {
+                MAP_SHAMD5ConfigSet(SHAMD5_BASE, cryptoMode, 0, 1, 0, 0);
+            }
+            
+            /* This is the last iteration for the requested calculation */
+            /* Set the first flag to 1 (initial value) for next calculations */
+            pParams->first = 1;
         }
     }
 
@@ -650,26 +1354,57 @@ int32_t CryptoCC32XX_shamd5Process(uint32_t cryptoMode , uint8_t *pBuff, uint32_
 /*
  *  ======== CryptoCC32XX_aesProcess ========
  */
-int32_t CryptoCC32XX_aesProcess(uint32_t cryptoMode , uint32_t cryptoDirection, uint8_t *pInBuff, uint16_t inLen, uint8_t *pOutBuff , CryptoCC32XX_EncryptParams *pParams)
+int32_t CryptoCC32XX_aesProcess(uint32_t cryptoMode , uint32_t cryptoDirection, uint8_t *pInBuff, size_t inLen, uint8_t *pOutBuff , CryptoCC32XX_EncryptParams *pParams)
+{
+    int32_t status;
+
+    status = CryptoCC32XX_aesSetup(cryptoMode, cryptoDirection, pParams);
+    if (status != CryptoCC32XX_STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    /* Start Crypt Process */
+    if ((cryptoMode == AES_CFG_MODE_CCM) || (cryptoMode == AES_CFG_MODE_GCM_HY0CALC))
+    {
+        MAP_AESDataProcessAE(AES_BASE, (uint8_t *)(pInBuff+(pParams->aes.aadParams.input.len)), pOutBuff ,inLen, pInBuff, pParams->aes.aadParams.input.len, pParams->aes.aadParams.tag);
+
+    }
+    else
+    {
+        MAP_AESDataProcess(AES_BASE, pInBuff, pOutBuff, inLen);
+    }
+
+    /* Read the initial value registers if needed, depends on the mode. */
+    if ((cryptoMode == AES_CFG_MODE_CBC) || (cryptoMode == AES_CFG_MODE_CFB) ||
+        (cryptoMode == AES_CFG_MODE_CTR) || (cryptoMode == AES_CFG_MODE_ICM) ||
+        (cryptoMode == AES_CFG_MODE_CCM) || (cryptoMode == AES_CFG_MODE_GCM_HY0CALC))
+    {
+        MAP_AESIVGet(AES_BASE, pParams->aes.pIV);
+    }
+
+    return CryptoCC32XX_STATUS_SUCCESS;
+
+}
+
+/*
+ *  ======== CryptoCC32XX_aesSetup ========
+ *  Loads a new context into the AES engine. The context in status is
+ *  polled rather than signalled by interrupt, so this is also used from
+ *  the AES interrupt to start the next operation of a chain.
+ */
+static int32_t CryptoCC32XX_aesSetup(uint32_t cryptoMode, uint32_t cryptoDirection, CryptoCC32XX_EncryptParams *pParams)
 {
     int32_t count = CryptoCC32XX_CONTEXT_READY_MAX_COUNTER;
     /*
-    Step1:  Enable Interrupts
-    Step2:  Wait for Context Ready Interrupt
-    Step3:  Set the Configuration Parameters (Direction,AES Mode and Key Size)
-    Step4:  Set the Initialization Vector
-    Step5:  Write Key
-    Step6:  Start the Crypt Process
+    Step1:  Wait for Context Ready
+    Step2:  Set the Configuration Parameters (Direction,AES Mode and Key Size)
+    Step3:  Set the Initialization Vector
+    Step4:  Write Key
     */
 
-    /* Clear the flag. */
-    g_bAESReadyFlag = false;
-
-    /* Enable all interrupts. */
-    MAP_AESIntEnable(AES_BASE, AES_INT_CONTEXT_IN | AES_INT_CONTEXT_OUT | AES_INT_DATA_IN | AES_INT_DATA_OUT);
-
-    /* Wait for the context in flag, the flag will be set in the Interrupt handler. */
-    while((!g_bAESReadyFlag) && (count > 0))
+    /* Wait for the context in flag. */
+    while(((MAP_AESIntStatus(AES_BASE, false) & AES_INT_CONTEXT_IN) == 0) && (count > 0))
     {
         count --;
     }
@@ -700,53 +1435,43 @@ int32_t CryptoCC32XX_aesProcess(uint32_t cryptoMode , uint32_t cryptoDirection,
         MAP_AESKey2Set(AES_BASE, pParams->aes.aadParams.input.pKey2, CryptoCC32XX_getAesKeySize(pParams->aes.aadParams.input.key2Size));
     }
 
-    /* Start Crypt Process */
-    if ((cryptoMode == AES_CFG_MODE_CCM) || (cryptoMode == AES_CFG_MODE_GCM_HY0CALC))
-    {
-        MAP_AESDataProcessAE(AES_BASE, (uint8_t *)(pInBuff+(pParams->aes.aadParams.input.len)), pOutBuff ,inLen, pInBuff, pParams->aes.aadParams.input.len, pParams->aes.aadParams.tag);
+    return CryptoCC32XX_STATUS_SUCCESS;
+}
 
-    }
-    else
-    {
-        MAP_AESDataProcess(AES_BASE, pInBuff, pOutBuff, inLen);
-    }
+/*
+ *  ======== CryptoCC32XX_desProcess ========
+ */
+int32_t CryptoCC32XX_desProcess(uint32_t cryptoMode , uint32_t cryptoDirection, uint8_t *pInBuff, size_t inLen, uint8_t *pOutBuff , CryptoCC32XX_EncryptParams *pParams)
+{
+    int32_t status;
 
-    /* Read the initial value registers if needed, depends on the mode. */
-    if ((cryptoMode == AES_CFG_MODE_CBC) || (cryptoMode == AES_CFG_MODE_CFB) ||
-        (cryptoMode == AES_CFG_MODE_CTR) || (cryptoMode == AES_CFG_MODE_ICM) ||
-        (cryptoMode == AES_CFG_MODE_CCM) || (cryptoMode == AES_CFG_MODE_GCM_HY0CALC))
+    status = CryptoCC32XX_desSetup(cryptoMode, cryptoDirection, pParams);
+    if (status != CryptoCC32XX_STATUS_SUCCESS)
     {
-        MAP_AESIVGet(AES_BASE, pParams->aes.pIV);
+        return status;
     }
 
+    MAP_DESDataProcess(DES_BASE, pInBuff, pOutBuff,inLen);
     return CryptoCC32XX_STATUS_SUCCESS;
-
 }
 
 /*
- *  ======== CryptoCC32XX_desProcess ========
+ *  ======== CryptoCC32XX_desSetup ========
+ *  Loads a new context into the DES engine, see CryptoCC32XX_aesSetup().
  */
-int32_t CryptoCC32XX_desProcess(uint32_t cryptoMode , uint32_t cryptoDirection, uint8_t *pInBuff, uint16_t inLen, uint8_t *pOutBuff , CryptoCC32XX_EncryptParams *pParams)
+static int32_t CryptoCC32XX_desSetup(uint32_t cryptoMode, uint32_t cryptoDirection, CryptoCC32XX_EncryptParams *pParams)
 {
     int32_t count = CryptoCC32XX_CONTEXT_READY_MAX_COUNTER;
 
     /*
-    Step1:  Enable Interrupts
-    Step2:  Wait for Context Ready Interrupt
-    Step3:  Set the Configuration Parameters (Direction,AES Mode)
-    Step4:  Set the Initialization Vector
-    Step5:  Write Key
-    Step6:  Start the Crypt Process
+    Step1:  Wait for Context Ready
+    Step2:  Set the Configuration Parameters (Direction,AES Mode)
+    Step3:  Set the Initialization Vector
+    Step4:  Write Key
     */
 
-    /* Clear the flag. */
-    g_bDESReadyFlag = false;
-
-    /* Enable all interrupts. */
-    MAP_DESIntEnable(DES_BASE, DES_INT_CONTEXT_IN | DES_INT_DATA_IN | DES_INT_DATA_OUT);
-
     /* Wait for the context in flag. */
-    while((!g_bDESReadyFlag) && (count > 0))
+    while(((MAP_DESIntStatus(DES_BASE, false) & DES_INT_CONTEXT_IN) == 0) && (count > 0))
     {
         count --;
     }
@@ -767,93 +1492,588 @@ int32_t CryptoCC32XX_desProcess(uint32_t cryptoMode , uint32_t cryptoDirection,
         MAP_DESIVSet(DES_BASE, pParams->des.pIV);
     }
 
-    MAP_DESDataProcess(DES_BASE, pInBuff, pOutBuff,inLen);
     return CryptoCC32XX_STATUS_SUCCESS;
 }
 
+/*
+ *  ======== CryptoCC32XX_acquireEngine ========
+ *  Takes an engine's semaphore and starts accounting its busy time.
+ */
+static bool CryptoCC32XX_acquireEngine(CryptoCC32XX_Object *object, uint8_t cryptoIndex, uint32_t timeout)
+{
+    if (SemaphoreP_pend(object->sem[cryptoIndex], timeout) != SemaphoreP_OK)
+    {
+        return false;
+    }
+    object->busyStart[cryptoIndex] = ClockP_getTimestamp();
+    return true;
+}
 
 /*
- *  ======== CryptoCC32XX_aesIntHandler ========
+ *  ======== CryptoCC32XX_releaseEngine ========
+ *  Gives back an engine taken by CryptoCC32XX_acquireEngine() and starts
+ *  the operations queued for it meanwhile.
  */
-void CryptoCC32XX_aesIntHandler(void)
+static void CryptoCC32XX_releaseEngine(CryptoCC32XX_Handle handle, uint8_t cryptoIndex)
 {
-    uint32_t uiIntStatus;
+    CryptoCC32XX_Object     *object = handle->object;
 
-    /* Read the AES masked interrupt status. */
-    uiIntStatus = MAP_AESIntStatus(AES_BASE, true);
+    object->stats[cryptoIndex].busyTicks += (uint32_t)
+        (ClockP_getTimestamp() - object->busyStart[cryptoIndex]);
+
+    SemaphoreP_post(object->sem[cryptoIndex]);
+    CryptoCC32XX_dispatch(handle, cryptoIndex);
+}
+
+/*
+ *  ======== CryptoCC32XX_countJob ========
+ *  Counts a completed operation. Called by the engine's holder.
+ */
+static void CryptoCC32XX_countJob(CryptoCC32XX_Object *object, uint8_t cryptoIndex, size_t len)
+{
+    object->stats[cryptoIndex].jobs++;
+    object->stats[cryptoIndex].bytes += len;
+}
+
+/*
+ *  ======== CryptoCC32XX_canQueue ========
+ *  Returns true if a list of operations, and the operations they pass
+ *  their results on to, can run from the engines' interrupts.
+ */
+static bool CryptoCC32XX_canQueue(CryptoCC32XX_Object *object, CryptoCC32XX_Operation *op)
+{
+    uint8_t cryptoType;
 
-    /* Set Different flags depending on the interrupt source. */
-    if(uiIntStatus & AES_INT_CONTEXT_IN)
+    for (; op != NULL; op = op->next)
     {
-        MAP_AESIntDisable(AES_BASE, AES_INT_CONTEXT_IN);
-        g_bAESReadyFlag = true;
+        if (op->hashCtx == NULL)
+        {
+            cryptoType = op->method >> 8;
+            if (((cryptoType != CryptoCC32XX_AES) && (cryptoType != CryptoCC32XX_DES)) ||
+                !CryptoCC32XX_dmaCanProcess(object, op))
+            {
+                return false;
+            }
+        }
+        if (object->sem[CryptoCC32XX_getIndex(op)] == NULL)
+        {
+            return false;
+        }
+        if ((op->then != NULL) && !CryptoCC32XX_canQueue(object, op->then))
+        {
+            return false;
+        }
     }
-    if(uiIntStatus & AES_INT_DATA_IN)
+    return true;
+}
+
+/*
+ *  ======== CryptoCC32XX_dispatch ========
+ *  Starts the operations queued for an engine if the engine is free.
+ *  Called whenever operations are queued and whenever the engine is
+ *  released, so the queue is never left waiting on an idle engine.
+ */
+static void CryptoCC32XX_dispatch(CryptoCC32XX_Handle handle, uint8_t cryptoIndex)
+{
+    CryptoCC32XX_Object     *object = handle->object;
+    CryptoCC32XX_Operation  *op;
+    uintptr_t key;
+
+    while (object->queueHead[cryptoIndex] != NULL)
     {
-        MAP_AESIntDisable(AES_BASE, AES_INT_DATA_IN);
+        /* If the engine is held, its holder dispatches when it is done */
+        if (!CryptoCC32XX_acquireEngine(object, cryptoIndex, SemaphoreP_NO_WAIT))
+        {
+            return;
+        }
+
+        /* Take everything queued so far as one chain */
+        key = HwiP_disable();
+        op = object->queueHead[cryptoIndex];
+        object->queueHead[cryptoIndex] = NULL;
+        object->queueTail[cryptoIndex] = NULL;
+        object->stats[cryptoIndex].queued = 0;
+        HwiP_restore(key);
+
+        if (op != NULL)
+        {
+            CryptoCC32XX_dmaStart(handle, cryptoIndex, op, false, true);
+            return;
+        }
+
+        /* Another dispatcher took the queue first */
+        SemaphoreP_post(object->sem[cryptoIndex]);
     }
-    if(uiIntStatus & AES_INT_CONTEXT_OUT)
+}
+
+/*
+ *  ======== CryptoCC32XX_dmaCanProcess ========
+ *  Returns true if an operation can be fed to its engine by the uDMA: the
+ *  uDMA moves whole words and the engine requests whole blocks.
+ */
+static bool CryptoCC32XX_dmaCanProcess(CryptoCC32XX_Object *object, CryptoCC32XX_Operation *op)
+{
+    uint32_t blockSize;
+
+    if ((object->dmaHandle == NULL) ||
+        (op->method == CryptoCC32XX_AES_GCM) || (op->method == CryptoCC32XX_AES_CCM))
+    {
+        return false;
+    }
+
+    blockSize = ((op->method >> 8) == CryptoCC32XX_AES) ?
+        CryptoCC32XX_AES_BLOCK_SIZE : CryptoCC32XX_DES_BLOCK_SIZE;
+
+    return ((op->inLen > 0) && ((op->inLen % blockSize) == 0) &&
+            ((((uintptr_t)op->pInBuff | (uintptr_t)op->pOutBuff) & 0x3) == 0));
+}
+
+/*
+ *  ======== CryptoCC32XX_dmaComplete ========
+ *  Called from the engine's interrupt when a uDMA transfer has drained the
+ *  engine. Continues the operation, or completes it and starts the next
+ *  operation of the chain.
+ */
+static void CryptoCC32XX_dmaComplete(CryptoCC32XX_Handle handle, uint8_t cryptoIndex)
+{
+    CryptoCC32XX_Object     *object = handle->object;
+    CryptoCC32XX_DmaState   *state = &object->dma[cryptoIndex];
+
+    if (state->op == NULL)
     {
-        MAP_AESIntDisable(AES_BASE, AES_INT_CONTEXT_OUT);
+        return;
     }
-    if(uiIntStatus & AES_INT_DATA_OUT)
+
+    if (state->remaining > 0)
     {
-        MAP_AESIntDisable(AES_BASE, AES_INT_DATA_OUT);
+        CryptoCC32XX_dmaNext(state, &CryptoCC32XX_DmaPTable[cryptoIndex]);
+        return;
     }
+
+    CryptoCC32XX_dmaStopOperation(state, cryptoIndex);
+    CryptoCC32XX_dmaFinish(handle, cryptoIndex, CryptoCC32XX_STATUS_SUCCESS);
 }
 
 /*
- *  ======== CryptoCC32XX_desIntHandler ========
+ *  ======== CryptoCC32XX_dmaFinish ========
+ *  Completes the current operation with status, then starts the next
+ *  operation of the chain or, at its end, gives back the engine.
  */
-void CryptoCC32XX_desIntHandler(void)
+static void CryptoCC32XX_dmaFinish(CryptoCC32XX_Handle handle, uint8_t cryptoIndex, int32_t status)
 {
-    uint32_t ui32IntStatus;
+    CryptoCC32XX_Object     *object = handle->object;
+    CryptoCC32XX_DmaState   *state = &object->dma[cryptoIndex];
+    CryptoCC32XX_Operation  *op = state->op;
+    CryptoCC32XX_Operation  *next;
 
-    /* Read the DES masked interrupt status. */
-    ui32IntStatus = MAP_DESIntStatus(DES_BASE, true);
+    /* Complete operations until one starts or the chain ends */
+    while (op != NULL)
+    {
+        next = op->next;
+        op->status = status;
+        if (status == CryptoCC32XX_STATUS_SUCCESS)
+        {
+            if (!state->blocking)
+            {
+                CryptoCC32XX_countJob(object, cryptoIndex, op->inLen);
+            }
+            /* Pass the result on to the next stage of the pipeline */
+            if (op->then != NULL)
+            {
+                CryptoCC32XX_queue(handle, op->then);
+            }
+        }
+        if (op->callbackFxn != NULL)
+        {
+            op->callbackFxn(handle, op);
+        }
 
-    /* set flags depending on the interrupt source. */
-    if(ui32IntStatus & DES_INT_CONTEXT_IN)
+        op = next;
+        if ((op != NULL) && ((status == CryptoCC32XX_STATUS_SUCCESS) || state->independent))
+        {
+            state->op = op;
+            status = CryptoCC32XX_dmaStartOperation(handle, cryptoIndex);
+            if (status == CryptoCC32XX_STATUS_IN_PROGRESS)
+            {
+                return;
+            }
+        }
+    }
+
+    state->op = NULL;
+    Power_releaseConstraint(PowerCC32XX_DISALLOW_LPDS);
+
+    if (state->blocking)
     {
-        MAP_DESIntDisable(DES_BASE, DES_INT_CONTEXT_IN);
-        g_bDESReadyFlag = true;
+        SemaphoreP_post(object->dmaSem[cryptoIndex]);
     }
-    if(ui32IntStatus & DES_INT_DATA_IN)
+    else
     {
-        MAP_DESIntDisable(DES_BASE, DES_INT_DATA_IN);
+        /* release the engine taken by CryptoCC32XX_submit() or the dispatcher */
+        CryptoCC32XX_releaseEngine(handle, cryptoIndex);
     }
-    if(ui32IntStatus & DES_INT_DATA_OUT)
+}
+
+/*
+ *  ======== CryptoCC32XX_dmaNext ========
+ *  Sets up the uDMA to feed the engine and drain it for the next part of
+ *  the current operation.
+ */
+static void CryptoCC32XX_dmaNext(CryptoCC32XX_DmaState *state, const CryptoCC32XX_DmaP *dmaP)
+{
+    uintptr_t key;
+    size_t    count = state->remaining;
+
+    if (count > CryptoCC32XX_DMA_MAX_TRANSFER)
     {
-        MAP_DESIntDisable(DES_BASE, DES_INT_DATA_OUT);
+        count = CryptoCC32XX_DMA_MAX_TRANSFER;
     }
+
+    /* Setup the input transfer characteristics & buffers */
+    MAP_uDMAChannelControlSet(dmaP->inChannel | UDMA_PRI_SELECT,
+        UDMA_SIZE_32 | UDMA_SRC_INC_32 | UDMA_DST_INC_NONE | dmaP->arbSize);
+    MAP_uDMAChannelAttributeDisable(dmaP->inChannel, UDMA_ATTR_ALTSELECT);
+    MAP_uDMAChannelTransferSet(dmaP->inChannel | UDMA_PRI_SELECT,
+        UDMA_MODE_BASIC, state->pIn, (void *)dmaP->dataAddr,
+        count / sizeof(uint32_t));
+
+    /* Setup the output transfer characteristics & buffers */
+    MAP_uDMAChannelControlSet(dmaP->outChannel | UDMA_PRI_SELECT,
+        UDMA_SIZE_32 | UDMA_SRC_INC_NONE | UDMA_DST_INC_32 | dmaP->arbSize);
+    MAP_uDMAChannelAttributeDisable(dmaP->outChannel, UDMA_ATTR_ALTSELECT);
+    MAP_uDMAChannelTransferSet(dmaP->outChannel | UDMA_PRI_SELECT,
+        UDMA_MODE_BASIC, (void *)dmaP->dataAddr, state->pOut,
+        count / sizeof(uint32_t));
+
+    state->pIn += count;
+    state->pOut += count;
+    state->remaining -= count;
+
+    /* A lock is needed because we are accessing shared uDMA memory */
+    key = HwiP_disable();
+
+    /* Enable channels & start DMA transfers */
+    MAP_uDMAChannelEnable(dmaP->outChannel);
+    MAP_uDMAChannelEnable(dmaP->inChannel);
+
+    HwiP_restore(key);
 }
 
 /*
- *  ======== CryptoCC32XX_shamd5IntHandler ========
+ *  ======== CryptoCC32XX_dmaProcess ========
+ *  Processes one operation by DMA and sleeps until the engine's interrupt
+ *  signals completion. The engine semaphore is held by the caller.
  */
-void CryptoCC32XX_shamd5IntHandler(void)
+static int32_t CryptoCC32XX_dmaProcess(CryptoCC32XX_Handle handle, CryptoCC32XX_Operation *op)
 {
-    uint32_t ui32IntStatus;
+    CryptoCC32XX_Object     *object = handle->object;
+    uint8_t cryptoIndex = CryptoCC32XX_getIndex(op);
 
-    /* Read the SHA/MD5 masked interrupt status. */
-    ui32IntStatus = MAP_SHAMD5IntStatus(SHAMD5_BASE, true);
+    CryptoCC32XX_dmaStart(handle, cryptoIndex, op, true, false);
+    SemaphoreP_pend(object->dmaSem[cryptoIndex], SemaphoreP_WAIT_FOREVER);
 
-    if(ui32IntStatus & SHAMD5_INT_CONTEXT_READY)
+    return op->status;
+}
+
+/*
+ *  ======== CryptoCC32XX_dmaRelease ========
+ *  Frees the uDMA channels of the first count engines.
+ */
+static void CryptoCC32XX_dmaRelease(UDMACC32XX_Handle dmaHandle, uint8_t count)
+{
+    const CryptoCC32XX_DmaP *dmaP;
+
+    while (count-- > 0)
     {
-        MAP_SHAMD5IntDisable(SHAMD5_BASE, SHAMD5_INT_CONTEXT_READY);
-        g_bSHAMD5ReadyFlag = true;
+        dmaP = &CryptoCC32XX_DmaPTable[count];
+        UDMACC32XX_freeChannel(dmaHandle, dmaP->inChannel);
+        if (dmaP->outChannel != 0)
+        {
+            UDMACC32XX_freeChannel(dmaHandle, dmaP->outChannel);
+        }
     }
-    if(ui32IntStatus & SHAMD5_INT_PARTHASH_READY)
+}
+
+/*
+ *  ======== CryptoCC32XX_dmaReserve ========
+ *  Reserves the uDMA channels of every engine, so that
+ *  UDMACC32XX_allocChannel() users cannot claim them.  Returns false, with
+ *  nothing reserved, if another driver holds one of them.
+ */
+static bool CryptoCC32XX_dmaReserve(UDMACC32XX_Handle dmaHandle)
+{
+    const CryptoCC32XX_DmaP *dmaP;
+    uint8_t                  type;
+
+    for (type = 0; type < CryptoCC32XX_MAX_TYPES; type++)
+    {
+        dmaP = &CryptoCC32XX_DmaPTable[type];
+        if (UDMACC32XX_allocChannel(dmaHandle, &dmaP->inChannel, 1,
+                UDMACC32XX_PRIORITY_DEFAULT) == UDMACC32XX_CHANNEL_NONE)
+        {
+            break;
+        }
+        if ((dmaP->outChannel != 0) &&
+            (UDMACC32XX_allocChannel(dmaHandle, &dmaP->outChannel, 1,
+                UDMACC32XX_PRIORITY_DEFAULT) == UDMACC32XX_CHANNEL_NONE))
+        {
+            UDMACC32XX_freeChannel(dmaHandle, dmaP->inChannel);
+            break;
+        }
+    }
+
+    if (type < CryptoCC32XX_MAX_TYPES)
+    {
+        CryptoCC32XX_dmaRelease(dmaHandle, type);
+        return (false);
+    }
+
+    return (true);
+}
+
+/*
+ *  ======== CryptoCC32XX_dmaStart ========
+ *  Starts a chain of operations. The engine semaphore is held by the
+ *  caller and is given back, or the blocking caller's DMA semaphore is
+ *  posted, when the chain ends. If independent, a failed operation does
+ *  not end the chain.
+ */
+static void CryptoCC32XX_dmaStart(CryptoCC32XX_Handle handle, uint8_t cryptoIndex, CryptoCC32XX_Operation *op, bool blocking, bool independent)
+{
+    CryptoCC32XX_Object     *object = handle->object;
+    CryptoCC32XX_DmaState   *state = &object->dma[cryptoIndex];
+    int32_t status;
+
+    /* The uDMA does not run in LPDS */
+    Power_setConstraint(PowerCC32XX_DISALLOW_LPDS);
+
+    state->op = op;
+    state->blocking = blocking;
+    state->independent = independent;
+    status = CryptoCC32XX_dmaStartOperation(handle, cryptoIndex);
+    if (status != CryptoCC32XX_STATUS_IN_PROGRESS)
+    {
+        CryptoCC32XX_dmaFinish(handle, cryptoIndex, status);
+    }
+}
+
+/*
+ *  ======== CryptoCC32XX_dmaStartOperation ========
+ *  Loads the context of the current operation and starts feeding the
+ *  engine. Completion of each transfer raises the engine's interrupt.
+ *  Returns CryptoCC32XX_STATUS_IN_PROGRESS once started, or the result of
+ *  an operation that completes without the engine.
+ */
+static int32_t CryptoCC32XX_dmaStartOperation(CryptoCC32XX_Handle handle, uint8_t cryptoIndex)
+{
+    CryptoCC32XX_Object     *object = handle->object;
+    CryptoCC32XX_DmaState   *state = &object->dma[cryptoIndex];
+    CryptoCC32XX_Operation  *op = state->op;
+    uint32_t cryptoMode = CryptoCC32XX_getMode((uint32_t)op->method);
+    CryptoCC32XX_HashContext *ctx = op->hashCtx;
+    const uint8_t *pData = op->pInBuff;
+    size_t   len = op->inLen;
+    size_t   hashLen;
+    int32_t status;
+
+    if (cryptoIndex == CryptoCC32XX_HMAC_INDEX)
+    {
+        if (!CryptoCC32XX_hashBuffer(ctx, &pData, &len))
+        {
+            state->pTail = NULL;
+            state->tailLen = 0;
+            if (op->pDigest == NULL)
+            {
+                return CryptoCC32XX_STATUS_SUCCESS;
+            }
+            /* The engine can't close a hash without data */
+            if (ctx->buffLen == 0)
+            {
+                return CryptoCC32XX_STATUS_ERROR;
+            }
+            return CryptoCC32XX_hashStartRound(object, NULL, 0, true);
+        }
+
+        /* Hash whole blocks from the operation's buffer, holding back the last */
+        hashLen = ((len - 1) / CryptoCC32XX_MAX_BLOCK_SIZE) * CryptoCC32XX_MAX_BLOCK_SIZE;
+        state->pTail = pData + hashLen;
+        state->tailLen = len - hashLen;
+
+        return CryptoCC32XX_hashStartRound(object, pData, hashLen, false);
+    }
+    else if (cryptoIndex == CryptoCC32XX_AES_INDEX)
+    {
+        status = CryptoCC32XX_aesSetup(cryptoMode,
+            op->decrypt ? AES_CFG_DIR_DECRYPT : AES_CFG_DIR_ENCRYPT, op->pParams);
+        if (status != CryptoCC32XX_STATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        /* The length write makes the engine start using this context */
+        MAP_AESDataLengthSet(AES_BASE, (uint64_t)op->inLen);
+        MAP_AESIntClear(AES_BASE, AES_INT_DMA_DATA_OUT);
+        MAP_AESIntEnable(AES_BASE, AES_INT_DMA_DATA_OUT);
+        MAP_AESDMAEnable(AES_BASE, AES_DMA_DATA_IN);
+        MAP_AESDMAEnable(AES_BASE, AES_DMA_DATA_OUT);
+    }
+    else
+    {
+        status = CryptoCC32XX_desSetup(cryptoMode,
+            op->decrypt ? DES_CFG_DIR_DECRYPT : DES_CFG_DIR_ENCRYPT, op->pParams);
+        if (status != CryptoCC32XX_STATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        /*
+         * The engine does not give back the final DES IV; it is the last
+         * cipher text block, which in place decryption overwrites.
+         */
+        if (op->decrypt)
+        {
+            memcpy(state->lastBlock, (uint8_t *)op->pInBuff + op->inLen -
+                CryptoCC32XX_DES_BLOCK_SIZE, CryptoCC32XX_DES_BLOCK_SIZE);
+        }
+
+        MAP_DESDataLengthSet(DES_BASE, (uint32_t)op->inLen);
+        MAP_DESIntClear(DES_BASE, DES_INT_DMA_DATA_OUT);
+        MAP_DESIntEnable(DES_BASE, DES_INT_DMA_DATA_OUT);
+        MAP_DESDMAEnable(DES_BASE, DES_DMA_DATA_IN);
+        MAP_DESDMAEnable(DES_BASE, DES_DMA_DATA_OUT);
+    }
+
+    state->pIn = op->pInBuff;
+    state->pOut = op->pOutBuff;
+    state->remaining = op->inLen;
+    CryptoCC32XX_dmaNext(state, &CryptoCC32XX_DmaPTable[cryptoIndex]);
+
+    return CryptoCC32XX_STATUS_IN_PROGRESS;
+}
+
+/*
+ *  ======== CryptoCC32XX_dmaStopOperation ========
+ *  Stops the engine's DMA requests once the current operation has been
+ *  drained and writes back its final IV.
+ */
+static void CryptoCC32XX_dmaStopOperation(CryptoCC32XX_DmaState *state, uint8_t cryptoIndex)
+{
+    CryptoCC32XX_Operation *op = state->op;
+    uint32_t cryptoMode = CryptoCC32XX_getMode((uint32_t)op->method);
+
+    if (cryptoIndex == CryptoCC32XX_AES_INDEX)
+    {
+        MAP_AESIntDisable(AES_BASE, AES_INT_DMA_DATA_OUT);
+        MAP_AESDMADisable(AES_BASE, AES_DMA_DATA_IN);
+        MAP_AESDMADisable(AES_BASE, AES_DMA_DATA_OUT);
+
+        if ((cryptoMode == AES_CFG_MODE_CBC) || (cryptoMode == AES_CFG_MODE_CFB) ||
+            (cryptoMode == AES_CFG_MODE_CTR) || (cryptoMode == AES_CFG_MODE_ICM))
+        {
+            MAP_AESIVGet(AES_BASE, op->pParams->aes.pIV);
+        }
+    }
+    else
     {
-        MAP_SHAMD5IntDisable(SHAMD5_BASE, SHAMD5_INT_PARTHASH_READY);
+        MAP_DESIntDisable(DES_BASE, DES_INT_DMA_DATA_OUT);
+        MAP_DESDMADisable(DES_BASE, DES_DMA_DATA_IN);
+        MAP_DESDMADisable(DES_BASE, DES_DMA_DATA_OUT);
+
+        if((cryptoMode & DES_CFG_MODE_CBC) || (cryptoMode & DES_CFG_MODE_CFB))
+        {
+            if (op->decrypt)
+            {
+                memcpy(op->pParams->des.pIV, state->lastBlock,
+                    CryptoCC32XX_DES_BLOCK_SIZE);
+            }
+            else
+            {
+                memcpy(op->pParams->des.pIV, (uint8_t *)op->pOutBuff +
+                    op->inLen - CryptoCC32XX_DES_BLOCK_SIZE,
+                    CryptoCC32XX_DES_BLOCK_SIZE);
+            }
+        }
     }
-    if(ui32IntStatus & SHAMD5_INT_INPUT_READY)
+}
+
+/*
+ *  ======== CryptoCC32XX_aesIntHandler ========
+ */
+void CryptoCC32XX_aesIntHandler(uintptr_t arg)
+{
+    uint32_t uiIntStatus;
+
+    /* Read the AES masked interrupt status. */
+    uiIntStatus = MAP_AESIntStatus(AES_BASE, true);
+
+    /* The output uDMA channel has drained the engine */
+    if(uiIntStatus & AES_INT_DMA_DATA_OUT)
     {
-        MAP_SHAMD5IntDisable(SHAMD5_BASE, SHAMD5_INT_INPUT_READY);
+        MAP_AESIntClear(AES_BASE, AES_INT_DMA_DATA_OUT);
+        CryptoCC32XX_dmaComplete((CryptoCC32XX_Handle)arg, CryptoCC32XX_AES_INDEX);
     }
+}
+
+/*
+ *  ======== CryptoCC32XX_desIntHandler ========
+ */
+void CryptoCC32XX_desIntHandler(uintptr_t arg)
+{
+    uint32_t ui32IntStatus;
+
+    /* Read the DES masked interrupt status. */
+    ui32IntStatus = MAP_DESIntStatus(DES_BASE, true);
+
+    /* The output uDMA channel has drained the engine */
+    if(ui32IntStatus & DES_INT_DMA_DATA_OUT)
+    {
+        MAP_DESIntClear(DES_BASE, DES_INT_DMA_DATA_OUT);
+        CryptoCC32XX_dmaComplete((CryptoCC32XX_Handle)arg, CryptoCC32XX_DES_INDEX);
+    }
+}
+
+/*
+ *  ======== CryptoCC32XX_shamd5IntHandler ========
+ */
+void CryptoCC32XX_shamd5IntHandler(uintptr_t arg)
+{
+    CryptoCC32XX_Object     *object = ((CryptoCC32XX_Handle)arg)->object;
+    CryptoCC32XX_DmaState   *state = &object->dma[CryptoCC32XX_HMAC_INDEX];
+    uint32_t ui32IntStatus;
+    size_t   xferLen;
+
+    /* Read the SHA/MD5 masked interrupt status. */
+    ui32IntStatus = MAP_SHAMD5IntStatus(SHAMD5_BASE, true);
+
+    /* The input uDMA channel has fed the engine */
+    if(ui32IntStatus & SHAMD5_INT_DMA_DATA_IN)
+    {
+        MAP_SHAMD5IntDisable(SHAMD5_BASE, SHAMD5_INT_DMA_DATA_IN);
+        MAP_SHAMD5IntClear(SHAMD5_BASE, SHAMD5_INT_DMA_DATA_IN);
+
+        if (state->op == NULL)
+        {
+            /* CryptoCC32XX_hashRound() is waiting */
+            SemaphoreP_post(object->dmaSem[CryptoCC32XX_HMAC_INDEX]);
+        }
+        else if (state->remaining > 0)
+        {
+            xferLen = CryptoCC32XX_hashDmaNext(state->pIn, state->remaining);
+            state->pIn += xferLen;
+            state->remaining -= xferLen;
+        }
+        else
+        {
+            MAP_SHAMD5DMADisable(SHAMD5_BASE);
+            MAP_SHAMD5IntEnable(SHAMD5_BASE, SHAMD5_INT_OUTPUT_READY);
+        }
+    }
+
+    /* The engine is done with a pass started by the dispatcher */
     if(ui32IntStatus & SHAMD5_INT_OUTPUT_READY)
     {
         MAP_SHAMD5IntDisable(SHAMD5_BASE, SHAMD5_INT_OUTPUT_READY);
+        CryptoCC32XX_hashComplete((CryptoCC32XX_Handle)arg);
     }
 }
 
@@ -84,6 +84,38 @@
  *
  *  @endcode
  *
+ *  ## DMA and asynchronous AES and DES #
+ *
+ *  When the uDMA driver is configured, AES and DES data is moved between
+ *  memory and the engine by the uDMA and completion is signalled by the
+ *  engine's interrupt, so the calling task sleeps rather than feeding the
+ *  engine block by block. CryptoCC32XX_encrypt() and CryptoCC32XX_decrypt()
+ *  use DMA for buffers of at least ::CryptoCC32XX_DMA_MIN_SIZE bytes that
+ *  are word aligned and a multiple of the cipher block size, in every mode
+ *  except CryptoCC32XX_AES_GCM and CryptoCC32XX_AES_CCM.
+ *
+ *  CryptoCC32XX_submit() starts a chain of such operations and returns
+ *  without waiting. Each operation's callback is called from the engine's
+ *  interrupt when that operation is done. The IV of a CBC, CFB, CTR or ICM
+ *  operation is updated on completion, so consecutive operations that share
+ *  a CryptoCC32XX_EncryptParams continue one stream across buffers.
+ *
+ *  @code
+ *  CryptoCC32XX_Operation op[2];
+ *
+ *  CryptoCC32XX_Operation_init(&op[0]);
+ *  op[0].method = CryptoCC32XX_AES_CBC;
+ *  op[0].pInBuff = log0;
+ *  op[0].inLen = sizeof(log0);
+ *  op[0].pOutBuff = cipher0;
+ *  op[0].pParams = &params;
+ *  op[0].next = &op[1];
+ *  op[1] = ...; // as op[0] for the second buffer, with a callbackFxn
+ *  op[1].next = NULL;
+ *
+ *  ret = CryptoCC32XX_submit(handle, &op[0]);
+ *  @endcode
+ *
  *  ## Generate HMAC Hash signature #
  *
  *  @code
@@ -99,6 +131,70 @@
  *
  *  @endcode
  *
+ *  ## Streaming hashes #
+ *
+ *  CryptoCC32XX_hashInit(), CryptoCC32XX_hashUpdate() and
+ *  CryptoCC32XX_hashFinal() compute a hash or HMAC over data supplied in
+ *  pieces. The engine state is saved in the CryptoCC32XX_HashContext after
+ *  every update, so several hashes can be in progress at once and their
+ *  updates interleaved from different tasks. All but the last block of an
+ *  update is hashed straight from the caller's buffer, by uDMA when it is
+ *  word aligned and at least ::CryptoCC32XX_DMA_MIN_SIZE bytes long.
+ *
+ *  @code
+ *  CryptoCC32XX_HashContext ctx;
+ *  uint8_t                  digest[CryptoCC32XX_SHA256_DIGEST_SIZE];
+ *
+ *  CryptoCC32XX_hashInit(handle, &ctx, CryptoCC32XX_HMAC_SHA256, NULL);
+ *  while (imageChunk(&chunk, &chunkLen)) {
+ *      CryptoCC32XX_hashUpdate(handle, &ctx, chunk, chunkLen);
+ *  }
+ *  CryptoCC32XX_hashFinal(handle, &ctx, digest);
+ *  @endcode
+ *
+ *  ## Job queue #
+ *
+ *  CryptoCC32XX_queue() hands operations to the driver without blocking;
+ *  it may be called from any context, including an operation's callback.
+ *  Each engine has its own queue, and whenever an engine finishes it starts
+ *  everything queued for it in the meantime, so the AES, DES and SHAMD5
+ *  engines run concurrently for as long as there is work. A hash operation
+ *  adds its buffer to a CryptoCC32XX_HashContext like
+ *  CryptoCC32XX_hashUpdate() and, if pDigest is set, completes it like
+ *  CryptoCC32XX_hashFinal().
+ *
+ *  An operation's then field names an operation that is queued when it
+ *  succeeds. Encrypt-then-MAC therefore pipelines: while the SHAMD5 engine
+ *  hashes the cipher text of one packet, the AES engine encrypts the next.
+ *
+ *  @code
+ *  CryptoCC32XX_Operation enc, mac;
+ *
+ *  CryptoCC32XX_Operation_init(&enc);
+ *  enc.method = CryptoCC32XX_AES_CBC;
+ *  enc.pInBuff = plain;
+ *  enc.inLen = sizeof(plain);
+ *  enc.pOutBuff = cipher;
+ *  enc.pParams = &params;
+ *  enc.then = &mac;
+ *
+ *  CryptoCC32XX_Operation_init(&mac);
+ *  mac.hashCtx = &ctx;   // from CryptoCC32XX_hashInit() with the MAC key
+ *  mac.pInBuff = cipher;
+ *  mac.inLen = sizeof(cipher);
+ *  mac.pDigest = tag;
+ *  mac.callbackFxn = packetDone;
+ *
+ *  CryptoCC32XX_queue(handle, &enc);
+ *  @endcode
+ *
+ *  CryptoCC32XX_getEngineStats() reports, per engine, the operations and
+ *  bytes processed by all APIs, the time the engine was held and the queue
+ *  depth. Time is counted in ClockP_getTimestamp() counts, which resolve
+ *  single sub-millisecond operations; busyTicks / elapsedTicks is the
+ *  engine's utilization and busyTicks / timestampFreq its busy time in
+ *  seconds.
+ *
  *  # Implementation #
  *
  *  The CryptoCC32XX driver interface module is joined (at link time) to a
@@ -124,6 +220,7 @@ extern "C" {
 #include <stdbool.h>
 #include <ti/drivers/dpl/HwiP.h>
 #include <ti/drivers/dpl/SemaphoreP.h>
+#include <ti/drivers/dma/UDMACC32XX.h>
 
 
 #define CryptoCC32XX_CMD_RESERVED             32
@@ -177,6 +274,18 @@ extern "C" {
 #define CryptoCC32XX_MAX_DIGEST_SIZE CryptoCC32XX_SHA256_DIGEST_SIZE
 #define CryptoCC32XX_MAX_BLOCK_SIZE  CryptoCC32XX_SHA256_BLOCK_SIZE
 
+#define CryptoCC32XX_AES_BLOCK_SIZE     16
+#define CryptoCC32XX_DES_BLOCK_SIZE     8
+
+/*!
+ * @brief   Smallest AES or DES payload, in bytes, that CryptoCC32XX_encrypt()
+ * and CryptoCC32XX_decrypt() hand to the uDMA. Shorter payloads are written
+ * to the engine by the CPU, which is quicker than setting up the transfer.
+ */
+#ifndef CryptoCC32XX_DMA_MIN_SIZE
+#define CryptoCC32XX_DMA_MIN_SIZE       64
+#endif
+
 
 /*!
  *  @brief  Cryptography types configuration
@@ -343,11 +452,117 @@ typedef struct
     uint32_t blockSize;
 }CryptoCC32XX_HmacParams;
 
+/*!
+ *  @brief  Streaming hash context
+ *
+ *  This structure holds a hash in progress between CryptoCC32XX_hashInit()
+ *  and CryptoCC32XX_hashFinal(), including the saved engine state.
+ *
+ *  The application must not access any member variables of this structure!
+ */
+typedef struct CryptoCC32XX_HashContext {
+    /*! Hash algorithm */
+    CryptoCC32XX_HmacMethod method;
+    /*! 64 byte HMAC key, or NULL for a plain hash */
+    uint8_t                 *pKey;
+    /*! Bytes processed by the engine, 0 before the first block */
+    uint32_t                digestCount;
+    /*! Saved inner (or only) digest state */
+    uint32_t                innerDigest[CryptoCC32XX_MAX_DIGEST_SIZE / sizeof(uint32_t)];
+    /*! Saved HMAC outer digest state */
+    uint32_t                outerDigest[CryptoCC32XX_MAX_DIGEST_SIZE / sizeof(uint32_t)];
+    /*! Data not yet hashed: at most one block is held back */
+    uint32_t                buff[CryptoCC32XX_MAX_BLOCK_SIZE / sizeof(uint32_t)];
+    /*! Number of bytes in buff */
+    uint32_t                buffLen;
+} CryptoCC32XX_HashContext;
+
 /*!
  *  @brief      A handle that is returned from a CryptoCC32XX_open() call.
  */
 typedef struct CryptoCC32XX_Config    *CryptoCC32XX_Handle;
 
+struct CryptoCC32XX_Operation;
+
+/*!
+ *  @brief  Callback function called when an asynchronous operation completes
+ *
+ *  Called from the engine's interrupt; op->status holds the result. An
+ *  operation that completes without the engine, such as a hash update that
+ *  only fills the context's block or one that fails to start, calls it from
+ *  the context that started the operation.
+ */
+typedef void (*CryptoCC32XX_CallbackFxn)(CryptoCC32XX_Handle handle,
+    struct CryptoCC32XX_Operation *op);
+
+/*!
+ *  @brief  Asynchronous AES, DES or hash operation
+ *
+ *  This structure describes one buffer for CryptoCC32XX_submit() or
+ *  CryptoCC32XX_queue(). It must stay valid until its callback is called.
+ *  AES and DES buffers must be word aligned and inLen a multiple of the
+ *  cipher block size. An operation with a hashCtx is a hash operation and
+ *  its method, decrypt, pOutBuff and pParams are ignored.
+ *
+ *  @sa CryptoCC32XX_Operation_init()
+ */
+typedef struct CryptoCC32XX_Operation {
+    CryptoCC32XX_EncryptMethod      method;      /*!< AES or DES method, not GCM or CCM */
+    bool                            decrypt;     /*!< true to decrypt, false to encrypt */
+    void                           *pInBuff;     /*!< Input data */
+    size_t                          inLen;       /*!< Size of the input and output data */
+    void                           *pOutBuff;    /*!< Output data, may equal pInBuff */
+    CryptoCC32XX_EncryptParams     *pParams;     /*!< Key and IV; the IV is updated on completion */
+    CryptoCC32XX_HashContext       *hashCtx;     /*!< Hash context to update, NULL for AES or DES */
+    uint8_t                        *pDigest;     /*!< Hash digest output to complete the hash into, or NULL */
+    CryptoCC32XX_CallbackFxn        callbackFxn; /*!< Completion callback, may be NULL */
+    uintptr_t                       arg;         /*!< Argument for the application's use */
+    struct CryptoCC32XX_Operation  *next;        /*!< Next operation of the chain, or NULL */
+    struct CryptoCC32XX_Operation  *then;        /*!< Operation queued when this one succeeds, or NULL */
+    int32_t                         status;      /*!< Result, set before callbackFxn is called */
+} CryptoCC32XX_Operation;
+
+/*!
+ *  @brief  CryptoCC32XX engine utilization counters
+ *
+ *  @sa CryptoCC32XX_getEngineStats()
+ */
+typedef struct CryptoCC32XX_EngineStats {
+    uint32_t jobs;          /*!< Operations completed */
+    uint32_t bytes;         /*!< Input bytes processed */
+    uint64_t busyTicks;     /*!< Timestamp counts the engine was held */
+    uint64_t elapsedTicks;  /*!< Timestamp counts since the counters were cleared */
+    uint32_t timestampFreq; /*!< Rate of the timestamp counts in Hz */
+    uint32_t queued;        /*!< Operations waiting in the engine's queue */
+    uint32_t maxQueued;     /*!< Highest value of queued */
+} CryptoCC32XX_EngineStats;
+
+/*!
+ *  @brief  CryptoCC32XX DMA state of an engine
+ *
+ *  The application must not access any member variables of this structure!
+ */
+typedef struct CryptoCC32XX_DmaState {
+    /*! Operation being processed, NULL when the engine is idle */
+    CryptoCC32XX_Operation *op;
+    /*! Next input and output of the operation */
+    uint8_t                *pIn;
+    uint8_t                *pOut;
+    /*! Bytes of the operation still to be transferred */
+    size_t                  remaining;
+    /*! True if a blocking API is waiting on the chain */
+    bool                    blocking;
+    /*! True if a failed operation does not end the chain */
+    bool                    independent;
+    /*! True while the closing round of a hash operation runs */
+    bool                    closing;
+    /*! Rest of a hash operation, held back in the context afterwards */
+    const uint8_t          *pTail;
+    size_t                  tailLen;
+    /*! Last cipher text block, used to chain the DES IV */
+    uint8_t                 lastBlock[CryptoCC32XX_DES_BLOCK_SIZE];
+} CryptoCC32XX_DmaState;
+
 
 /*!
  *  @brief  CryptoCC32XX Object
@@ -361,6 +576,22 @@ typedef struct CryptoCC32XX_Object {
     bool            isOpen;
     /*! Semaphore handles */
     SemaphoreP_Handle   sem[CryptoCC32XX_MAX_TYPES];
+    /*! DMA completion semaphores of the blocking APIs */
+    SemaphoreP_Handle   dmaSem[CryptoCC32XX_MAX_TYPES];
+    /*! DMA state of each engine */
+    CryptoCC32XX_DmaState dma[CryptoCC32XX_MAX_TYPES];
+    /*! uDMA handle, NULL if the engines are fed by the CPU */
+    UDMACC32XX_Handle   dmaHandle;
+    /*! Operations waiting for each engine, see CryptoCC32XX_queue() */
+    CryptoCC32XX_Operation *queueHead[CryptoCC32XX_MAX_TYPES];
+    CryptoCC32XX_Operation *queueTail[CryptoCC32XX_MAX_TYPES];
+    /*! Utilization counters of each engine */
+    CryptoCC32XX_EngineStats stats[CryptoCC32XX_MAX_TYPES];
+    /*! Timestamp at which each engine was taken */
+    uint32_t            busyStart[CryptoCC32XX_MAX_TYPES];
+    /*! Timestamp & system tick at which the counters were cleared */
+    uint32_t            statsStart;
+    uint32_t            statsStartTick;
 } CryptoCC32XX_Object;
 
 
@@ -497,6 +728,87 @@ int32_t CryptoCC32XX_decrypt(  CryptoCC32XX_Handle handle, CryptoCC32XX_EncryptM
                             void *pInBuff, size_t inLen,
                             void *pOutBuff , size_t *outLen , CryptoCC32XX_EncryptParams *pParams);
 
+/*!
+ *  @brief  Initialize an operation to default values.
+ *
+ *  All fields are cleared: an AES operation that encrypts, with no hash
+ *  context, callback, next or then operation.
+ *
+ *  @param op  Pointer to the operation.
+ */
+void CryptoCC32XX_Operation_init(CryptoCC32XX_Operation *op);
+
+/*!
+ *  @brief Function which starts a chain of operations on one engine and
+ *  returns without waiting for them.
+ *  relevant to CryptoCC32XX_AES, CryptoCC32XX_DES and CryptoCC32XX_HMAC
+ *
+ *  The operations are processed in order. When each one completes, its
+ *  status is set and its callbackFxn is called from interrupt context. If
+ *  an operation fails, the rest of the chain is completed with
+ *  CryptoCC32XX_STATUS_ERROR, which includes an operation that fails to
+ *  start. The engine is held until the chain ends, so this function blocks
+ *  while another operation is using it.
+ *
+ *  @param  handle      A CryptoCC32XX_Handle
+ *
+ *  @param  op          First operation of the chain.
+ *
+ *  @return             Returns CryptoCC32XX_STATUS_SUCCESS if the chain was started,
+ *                      CryptoCC32XX_STATUS_ERROR_NOT_SUPPORTED if uDMA is not available
+ *                      or an operation can't use it, else CryptoCC32XX_STATUS_ERROR.
+ *
+ *  @sa                 CryptoCC32XX_queue()
+ */
+int32_t CryptoCC32XX_submit(CryptoCC32XX_Handle handle, CryptoCC32XX_Operation *op);
+
+/*!
+ *  @brief Function which queues operations for their engines without
+ *  blocking.
+ *  relevant to CryptoCC32XX_AES, CryptoCC32XX_DES and CryptoCC32XX_HMAC
+ *
+ *  Each operation of the list is appended to the queue of its engine; the
+ *  next field is used by the driver from then on. Queued operations are
+ *  independent: one failing does not affect the others. An operation's then
+ *  operation is queued when it succeeds. May be called from interrupt
+ *  context and from callbacks. The driver must not be closed while
+ *  operations are queued.
+ *
+ *  @param  handle      A CryptoCC32XX_Handle
+ *
+ *  @param  op          First operation of the list.
+ *
+ *  @return             Returns CryptoCC32XX_STATUS_SUCCESS if the operations were queued,
+ *                      else CryptoCC32XX_STATUS_ERROR_NOT_SUPPORTED if the engine of an
+ *                      operation is not open or an AES or DES operation can't use uDMA;
+ *                      nothing is queued then.
+ *
+ *  @sa                 CryptoCC32XX_getEngineStats()
+ */
+int32_t CryptoCC32XX_queue(CryptoCC32XX_Handle handle, CryptoCC32XX_Operation *op);
+
+/*!
+ *  @brief Function which reads the utilization counters of an engine.
+ *
+ *  The counters accumulate from CryptoCC32XX_open() and are cleared by
+ *  CryptoCC32XX_clearEngineStats().
+ *
+ *  @param  handle      A CryptoCC32XX_Handle
+ *
+ *  @param  type        CryptoCC32XX_AES, CryptoCC32XX_DES or CryptoCC32XX_HMAC.
+ *
+ *  @param  stats       Pointer to a CryptoCC32XX_EngineStats structure to fill in.
+ */
+void CryptoCC32XX_getEngineStats(CryptoCC32XX_Handle handle, CryptoCC32XX_Type type,
+                            CryptoCC32XX_EngineStats *stats);
+
+/*!
+ *  @brief Function which clears the utilization counters of all engines.
+ *
+ *  @param  handle      A CryptoCC32XX_Handle
+ */
+void CryptoCC32XX_clearEngineStats(CryptoCC32XX_Handle handle);
+
 /*!
  *  @brief Function which generates the HMAC Hash value of given plain Text.
  *  relevant to CryptoCC32XX_HMAC
@@ -549,6 +861,72 @@ int32_t CryptoCC32XX_verify(   CryptoCC32XX_Handle handle, CryptoCC32XX_HmacMeth
                             void *pBuff, size_t len,
                             uint8_t *pSignature, CryptoCC32XX_HmacParams *pParams);
 
+/*!
+ *  @brief Function which starts a streaming hash or HMAC calculation.
+ *  relevant to CryptoCC32XX_HMAC
+ *
+ *  @param  handle      A CryptoCC32XX_Handle
+ *
+ *  @param  ctx         Context to initialize.
+ *
+ *  @param  method      Hash algorithm to use.
+ *
+ *  @param  pKey        Pointer to a 64 byte HMAC key, zero padded, which must
+ *                      stay valid until CryptoCC32XX_hashFinal(); NULL for a
+ *                      plain hash.
+ *
+ *  @return             Returns CryptoCC32XX_STATUS_SUCCESS if successful else would return
+ *                      CryptoCC32XX_STATUS_ERROR_NOT_SUPPORTED.
+ *
+ *  @sa                 CryptoCC32XX_hashUpdate()
+ */
+int32_t CryptoCC32XX_hashInit(CryptoCC32XX_Handle handle, CryptoCC32XX_HashContext *ctx,
+                            CryptoCC32XX_HmacMethod method, uint8_t *pKey);
+
+/*!
+ *  @brief Function which adds data to a streaming hash or HMAC calculation.
+ *  relevant to CryptoCC32XX_HMAC
+ *
+ *  Blocks while another context is using the engine. If an error is
+ *  returned, the context must be initialized again.
+ *
+ *  @param  handle      A CryptoCC32XX_Handle
+ *
+ *  @param  ctx         Context initialized by CryptoCC32XX_hashInit().
+ *
+ *  @param  pBuff       Pointer to the data.
+ *
+ *  @param  len         Size of the data.
+ *
+ *  @return             Returns CryptoCC32XX_STATUS_SUCCESS if successful else would return
+ *                      CryptoCC32XX_STATUS_ERROR on an error.
+ *
+ *  @sa                 CryptoCC32XX_hashFinal()
+ */
+int32_t CryptoCC32XX_hashUpdate(CryptoCC32XX_Handle handle, CryptoCC32XX_HashContext *ctx,
+                            const void *pBuff, size_t len);
+
+/*!
+ *  @brief Function which completes a streaming hash or HMAC calculation.
+ *  relevant to CryptoCC32XX_HMAC
+ *
+ *  The context may then be reused for another calculation with the same
+ *  method and key.
+ *
+ *  @param  handle      A CryptoCC32XX_Handle
+ *
+ *  @param  ctx         Context initialized by CryptoCC32XX_hashInit().
+ *
+ *  @param  pDigest     Pointer to the output digest.
+ *
+ *  @return             Returns CryptoCC32XX_STATUS_SUCCESS if successful else would return
+ *                      CryptoCC32XX_STATUS_ERROR on an error or if no data was hashed.
+ *
+ *  @sa                 CryptoCC32XX_hashInit()
+ */
+int32_t CryptoCC32XX_hashFinal(CryptoCC32XX_Handle handle, CryptoCC32XX_HashContext *ctx,
+                            uint8_t *pDigest);
+
 
 #ifdef __cplusplus
 }
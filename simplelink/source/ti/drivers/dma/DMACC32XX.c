@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2019, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== DMACC32XX.c ========
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <ti/drivers/dpl/DebugP.h>
+#include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/dpl/SemaphoreP.h>
+
+#include <ti/drivers/Power.h>
+#include <ti/drivers/power/PowerCC32XX.h>
+
+#include <ti/drivers/dma/DMACC32XX.h>
+
+#include <ti/devices/cc32xx/driverlib/udma.h>
+
+/* Maximum number of items in a single uDMA transfer */
+#define MAX_DMA_TRANSFER_AMOUNT     (1024)
+
+/* Function prototypes */
+void DMACC32XX_close(DMA_Handle handle);
+void DMACC32XX_init(DMA_Handle handle);
+DMA_Handle DMACC32XX_open(DMA_Handle handle, DMA_Params *params);
+int_fast16_t DMACC32XX_submit(DMA_Handle handle,
+    DMA_Transaction *transaction);
+
+/* Internal functions */
+static void DMACC32XX_complete(DMA_Transaction *transaction);
+static void DMACC32XX_hwiFxn(uintptr_t arg);
+static void DMACC32XX_start(DMACC32XX_Object *object,
+    DMA_Transaction *transaction);
+static void DMACC32XX_startChunk(DMACC32XX_Object *object);
+
+/* DMA function table for CC32XX implementation */
+const DMA_FxnTable DMACC32XX_fxnTable = {
+    DMACC32XX_close,
+    DMACC32XX_init,
+    DMACC32XX_open,
+    DMACC32XX_submit
+};
+
+/* Item size and increments for 8, 16 and 32-bit copies */
+static const uint32_t copyControl[] = {
+    UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_8 | UDMA_ARB_8,
+    UDMA_SIZE_16 | UDMA_SRC_INC_16 | UDMA_DST_INC_16 | UDMA_ARB_8,
+    UDMA_SIZE_32 | UDMA_SRC_INC_32 | UDMA_DST_INC_32 | UDMA_ARB_8
+};
+
+/* Item size and increments for 8, 16 and 32-bit fills */
+static const uint32_t fillControl[] = {
+    UDMA_SIZE_8 | UDMA_SRC_INC_NONE | UDMA_DST_INC_8 | UDMA_ARB_8,
+    UDMA_SIZE_16 | UDMA_SRC_INC_NONE | UDMA_DST_INC_16 | UDMA_ARB_8,
+    UDMA_SIZE_32 | UDMA_SRC_INC_NONE | UDMA_DST_INC_32 | UDMA_ARB_8
+};
+
+/*
+ *  ======== DMACC32XX_close ========
+ */
+void DMACC32XX_close(DMA_Handle handle)
+{
+    DMACC32XX_Object          *object = handle->object;
+    uintptr_t                  key;
+
+    UDMACC32XX_setCallback(object->dmaHandle, object->channel, NULL, 0);
+    UDMACC32XX_freeChannel(object->dmaHandle, object->channel);
+    UDMACC32XX_close(object->dmaHandle);
+    object->dmaHandle = NULL;
+
+    key = HwiP_disable();
+    object->isOpen = false;
+    HwiP_restore(key);
+
+    DebugP_log1("DMA:(%p) closed", (uintptr_t) handle);
+}
+
+/*
+ *  ======== DMACC32XX_init ========
+ */
+void DMACC32XX_init(DMA_Handle handle)
+{
+    (void) handle;
+
+    UDMACC32XX_init();
+}
+
+/*
+ *  ======== DMACC32XX_open ========
+ */
+DMA_Handle DMACC32XX_open(DMA_Handle handle, DMA_Params *params)
+{
+    DMACC32XX_Object          *object = handle->object;
+    DMACC32XX_HWAttrs const   *hwAttrs = handle->hwAttrs;
+    uintptr_t                  key;
+
+    key = HwiP_disable();
+
+    if (object->isOpen) {
+        HwiP_restore(key);
+
+        DebugP_log1("DMA:(%p) already in use.", (uintptr_t) handle);
+        return (NULL);
+    }
+    object->isOpen = true;
+
+    HwiP_restore(key);
+
+    object->dmaHandle = UDMACC32XX_open();
+    if (object->dmaHandle == NULL) {
+        object->isOpen = false;
+        return (NULL);
+    }
+
+    object->channel = UDMACC32XX_allocChannel(object->dmaHandle,
+        (hwAttrs->dmaChannel == DMACC32XX_DMA_CHANNEL_ANY) ?
+        NULL : &hwAttrs->dmaChannel, 1,
+        params->highPriority ? UDMACC32XX_PRIORITY_HIGH :
+        UDMACC32XX_PRIORITY_DEFAULT);
+    if (object->channel == UDMACC32XX_CHANNEL_NONE) {
+        UDMACC32XX_close(object->dmaHandle);
+        object->isOpen = false;
+        return (NULL);
+    }
+
+    if (!UDMACC32XX_setCallback(object->dmaHandle, object->channel,
+        DMACC32XX_hwiFxn, (uintptr_t) handle)) {
+        UDMACC32XX_freeChannel(object->dmaHandle, object->channel);
+        UDMACC32XX_close(object->dmaHandle);
+        object->isOpen = false;
+        return (NULL);
+    }
+
+    List_clearList(&object->queue);
+    object->active = NULL;
+    object->minTransferSize = params->minTransferSize;
+
+    DebugP_log1("DMA:(%p) opened", (uintptr_t) handle);
+
+    return (handle);
+}
+
+/*
+ *  ======== DMACC32XX_submit ========
+ */
+int_fast16_t DMACC32XX_submit(DMA_Handle handle, DMA_Transaction *transaction)
+{
+    DMACC32XX_Object          *object = handle->object;
+    SemaphoreP_Struct          done;
+    bool                       start = false;
+    uintptr_t                  key;
+
+    if (transaction->size < object->minTransferSize) {
+        if (transaction->src != NULL) {
+            memcpy(transaction->dst, transaction->src, transaction->size);
+        }
+        else {
+            memset(transaction->dst, (int) (transaction->pattern & 0xFF),
+                transaction->size);
+        }
+
+        if (transaction->callbackFxn != NULL) {
+            transaction->callbackFxn(transaction);
+        }
+
+        return (DMA_STATUS_SUCCESS);
+    }
+
+    if (transaction->callbackFxn == NULL) {
+        transaction->done = SemaphoreP_constructBinary(&done, 0);
+    }
+
+    key = HwiP_disable();
+
+    if (object->active == NULL) {
+        object->active = transaction;
+        Power_setConstraint(PowerCC32XX_DISALLOW_LPDS);
+        start = true;
+    }
+    else {
+        List_put(&object->queue, &transaction->elem);
+    }
+
+    HwiP_restore(key);
+
+    if (start) {
+        DMACC32XX_start(object, transaction);
+    }
+
+    if (transaction->callbackFxn == NULL) {
+        SemaphoreP_pend(transaction->done, SemaphoreP_WAIT_FOREVER);
+        SemaphoreP_destruct(&done);
+    }
+
+    return (DMA_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== DMACC32XX_complete ========
+ */
+static void DMACC32XX_complete(DMA_Transaction *transaction)
+{
+    if (transaction->callbackFxn != NULL) {
+        transaction->callbackFxn(transaction);
+    }
+    else {
+        SemaphoreP_post(transaction->done);
+    }
+}
+
+/*
+ *  ======== DMACC32XX_hwiFxn ========
+ *  Chains the next chunk of the active transaction, or starts the next
+ *  queued transaction before completing the active one.
+ */
+static void DMACC32XX_hwiFxn(uintptr_t arg)
+{
+    DMACC32XX_Object   *object = ((DMA_Handle) arg)->object;
+    DMA_Transaction    *transaction;
+    DMA_Transaction    *next;
+    uintptr_t           key;
+
+    if (object->items != 0) {
+        DMACC32XX_startChunk(object);
+        return;
+    }
+
+    key = HwiP_disable();
+
+    transaction = object->active;
+    next = (DMA_Transaction *) List_get(&object->queue);
+    object->active = next;
+    if (next == NULL) {
+        Power_releaseConstraint(PowerCC32XX_DISALLOW_LPDS);
+    }
+
+    HwiP_restore(key);
+
+    if (next != NULL) {
+        DMACC32XX_start(object, next);
+    }
+
+    DMACC32XX_complete(transaction);
+}
+
+/*
+ *  ======== DMACC32XX_start ========
+ *  Picks the widest item size the buffers allow.
+ */
+static void DMACC32XX_start(DMACC32XX_Object *object,
+    DMA_Transaction *transaction)
+{
+    uintptr_t   align = (uintptr_t) transaction->dst | transaction->size;
+    uint_fast8_t shift;
+
+    if (transaction->src != NULL) {
+        align |= (uintptr_t) transaction->src;
+    }
+
+    if ((align & 3) == 0) {
+        shift = 2;
+    }
+    else if ((align & 1) == 0) {
+        shift = 1;
+    }
+    else {
+        shift = 0;
+    }
+
+    object->dst = transaction->dst;
+    object->shift = shift;
+    object->items = transaction->size >> shift;
+    object->fill = (transaction->src == NULL);
+
+    if (!object->fill) {
+        object->src = transaction->src;
+        object->control = copyControl[shift];
+    }
+    else {
+        object->src = (const uint8_t *) &transaction->pattern;
+        object->control = fillControl[shift];
+    }
+
+    DMACC32XX_startChunk(object);
+}
+
+/*
+ *  ======== DMACC32XX_startChunk ========
+ *  Start an auto-request transfer of up to MAX_DMA_TRANSFER_AMOUNT items
+ *  of the active transaction.
+ */
+static void DMACC32XX_startChunk(DMACC32XX_Object *object)
+{
+    size_t count = object->items;
+
+    if (count > MAX_DMA_TRANSFER_AMOUNT) {
+        count = MAX_DMA_TRANSFER_AMOUNT;
+    }
+
+    UDMACC32XX_startTransfer(object->dmaHandle, object->channel,
+        object->control, UDMA_MODE_AUTO, (void *) object->src,
+        object->dst, count);
+
+    object->items -= count;
+    object->dst += count << object->shift;
+    if (!object->fill) {
+        object->src += count << object->shift;
+    }
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2019, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!****************************************************************************
+ *  @file       DMACC32XX.h
+ *  @brief      DMA driver implementation for the CC32XX uDMA
+ *
+ *  The DMA header file for CC32XX should be included in an application
+ *  as follows:
+ *  @code
+ *  #include <ti/drivers/DMA.h>
+ *  #include <ti/drivers/dma/DMACC32XX.h>
+ *  @endcode
+ *
+ *  Refer to @ref DMA.h for a complete description of APIs.
+ *
+ *  Each open instance holds one uDMA software channel, reserved with
+ *  UDMACC32XX_allocChannel(), and moves its transactions with auto-request
+ *  transfers.  Transfers longer than 1024 items are chained from the
+ *  completion interrupt, and the next queued transaction is started before
+ *  the callback of the previous one runs.
+ *
+ *  The uDMA moves 32-bit items if the addresses and size are word aligned,
+ *  16-bit items if they are half word aligned, and bytes otherwise, so
+ *  buffers should be word aligned for the best throughput.  The channel
+ *  re-arbitrates every 8 items, letting peripheral channels interleave with
+ *  long copies.  DMA_Params.highPriority places the channel in the high
+ *  uDMA priority level.
+ *
+ *  # Power Driver Usage #
+ *
+ *  LPDS is disallowed from the start of an instance's first queued
+ *  transaction until its queue is empty.
+ *
+ ******************************************************************************
+ */
+
+#ifndef ti_drivers_dma_DMACC32XX__include
+#define ti_drivers_dma_DMACC32XX__include
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <ti/drivers/DMA.h>
+#include <ti/drivers/dma/UDMACC32XX.h>
+#include <ti/drivers/utils/List.h>
+
+/*!
+ *  @brief  DMACC32XX_HWAttrs.dmaChannel value that lets the driver pick
+ *          any free software channel
+ */
+#define DMACC32XX_DMA_CHANNEL_ANY       (~0U)
+
+/*! @brief  DMA function table for CC32XX */
+extern const DMA_FxnTable DMACC32XX_fxnTable;
+
+/*!
+ *  @brief  DMA hardware attributes for CC32XX
+ *
+ *  dmaChannel is a uDMA software channel mapping (for instance
+ *  UDMA_CH29_SW), or DMACC32XX_DMA_CHANNEL_ANY to take the highest
+ *  numbered free channel.  DMA_open() fails if the channel is held by
+ *  another driver.
+ *
+ *  A sample structure is shown below:
+ *  @code
+ *  const DMACC32XX_HWAttrs dmaCC32XXHWAttrs[] = {
+ *      {
+ *          .dmaChannel = DMACC32XX_DMA_CHANNEL_ANY
+ *      }
+ *  };
+ *  @endcode
+ */
+typedef struct DMACC32XX_HWAttrs {
+    /*! uDMA software channel, or DMACC32XX_DMA_CHANNEL_ANY */
+    uint32_t dmaChannel;
+} DMACC32XX_HWAttrs;
+
+/*!
+ *  @brief  DMA Object for CC32XX
+ *
+ *  Not to be accessed by the user.
+ */
+typedef struct DMACC32XX_Object {
+    UDMACC32XX_Handle   dmaHandle;
+    uint32_t            channel;        /* Allocated channel mapping */
+    size_t              minTransferSize;
+    List_List           queue;
+    DMA_Transaction    *active;         /* Transaction on the channel */
+    uint8_t            *dst;            /* Next chunk of the active one */
+    const uint8_t      *src;
+    size_t              items;          /* Items left to start */
+    uint32_t            control;
+    uint_fast8_t        shift;          /* log2 of the item size */
+    bool                fill;           /* Source does not increment */
+    bool                isOpen;         /* Flag for open/close status */
+} DMACC32XX_Object;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ti_drivers_dma_DMACC32XX__include */
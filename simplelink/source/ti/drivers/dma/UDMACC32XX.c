@@ -30,6 +30,9 @@
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <stdint.h>
+#include <string.h>
+
 #include <ti/drivers/dpl/DebugP.h>
 #include <ti/drivers/dpl/HwiP.h>
 
@@ -45,17 +48,257 @@
 #include <ti/devices/cc32xx/driverlib/prcm.h>
 #include <ti/devices/cc32xx/driverlib/udma.h>
 
+/* Channel number and software mapping of a channel mapping value */
+#define CHANNEL_NUM(mapping)    ((mapping) & 0x1F)
+#define SW_MAPPING(channel)     ((uint32_t)(0x3 << 16) | (channel))
+#define IS_SW_MAPPING(mapping)  (((mapping) >> 16) == 0x3)
+
 extern const UDMACC32XX_Config UDMACC32XX_config[];
 
 static int postNotifyFxn(unsigned int eventType, uintptr_t eventArg,
         uintptr_t clientArg);
 
+static void swHwiFxn(uintptr_t arg);
+
 static bool dmaInitialized = false;
 static Power_NotifyObj postNotifyObj;    /* LPDS wake-up notify object */
 
 /* Reference count for open calls */
 static uint32_t          refCount = 0;
 
+/*
+ *  ======== UDMACC32XX_allocChannel ========
+ */
+uint32_t UDMACC32XX_allocChannel(UDMACC32XX_Handle handle,
+        const uint32_t *mappings, uint_fast8_t count, uint_fast8_t priority)
+{
+    UDMACC32XX_Object    *object = handle->object;
+    uint32_t              mapping = UDMACC32XX_CHANNEL_NONE;
+    uint32_t              channel;
+    uint32_t              free;
+    uint_fast8_t          i;
+    uintptr_t             key;
+
+    key = HwiP_disable();
+
+    if (mappings == NULL) {
+        free = ~object->allocMask;
+        for (channel = UDMACC32XX_NUM_CHANNELS; channel-- > 0; ) {
+            if (free & (1U << channel)) {
+                mapping = SW_MAPPING(channel);
+                break;
+            }
+        }
+    }
+    else {
+        for (i = 0; i < count; i++) {
+            if ((object->allocMask & (1U << CHANNEL_NUM(mappings[i]))) == 0) {
+                mapping = mappings[i];
+                break;
+            }
+        }
+    }
+
+    if (mapping == UDMACC32XX_CHANNEL_NONE) {
+        object->allocFailures++;
+        HwiP_restore(key);
+
+        DebugP_log0("UDMACC32XX: no free channel");
+        return (UDMACC32XX_CHANNEL_NONE);
+    }
+
+    channel = CHANNEL_NUM(mapping);
+    object->allocMask |= 1U << channel;
+    object->mapping[channel] = mapping;
+    object->stats[channel].allocations++;
+
+    HwiP_restore(key);
+
+    MAP_uDMAChannelAssign(mapping);
+    MAP_uDMAChannelAttributeDisable(channel, UDMA_ATTR_ALL);
+    UDMACC32XX_setChannelPriority(handle, mapping, priority);
+
+    return (mapping);
+}
+
+/*
+ *  ======== UDMACC32XX_setChannelPriority ========
+ */
+void UDMACC32XX_setChannelPriority(UDMACC32XX_Handle handle,
+        uint32_t mapping, uint_fast8_t priority)
+{
+    UDMACC32XX_Object    *object = handle->object;
+    uint32_t              channel = CHANNEL_NUM(mapping);
+    uintptr_t             key;
+
+    key = HwiP_disable();
+
+    if (priority & UDMACC32XX_PRIORITY_HIGH) {
+        object->highPriorityMask |= 1U << channel;
+        MAP_uDMAChannelAttributeEnable(channel, UDMA_ATTR_HIGH_PRIORITY);
+    }
+    else {
+        object->highPriorityMask &= ~(1U << channel);
+        MAP_uDMAChannelAttributeDisable(channel, UDMA_ATTR_HIGH_PRIORITY);
+    }
+
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== UDMACC32XX_freeChannel ========
+ */
+void UDMACC32XX_freeChannel(UDMACC32XX_Handle handle, uint32_t mapping)
+{
+    UDMACC32XX_Object    *object = handle->object;
+    uint32_t              channel = CHANNEL_NUM(mapping);
+    uintptr_t             key;
+
+    MAP_uDMAChannelDisable(channel);
+    MAP_uDMAChannelAttributeDisable(channel, UDMA_ATTR_ALL);
+
+    key = HwiP_disable();
+
+    object->allocMask &= ~(1U << channel);
+    object->highPriorityMask &= ~(1U << channel);
+
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== UDMACC32XX_getChannelStats ========
+ */
+void UDMACC32XX_getChannelStats(UDMACC32XX_Handle handle, uint32_t channel,
+        UDMACC32XX_ChannelStats *stats)
+{
+    UDMACC32XX_Object    *object = handle->object;
+    uintptr_t             key;
+
+    key = HwiP_disable();
+    *stats = object->stats[CHANNEL_NUM(channel)];
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== UDMACC32XX_setTask ========
+ *  Same encoding as the uDMATaskStructEntry() macro: the control structure
+ *  holds the addresses of the last source and destination bytes.
+ */
+void UDMACC32XX_setTask(UDMACC32XX_Task *task, uint32_t control,
+        uint32_t mode, void *src, void *dst, uint32_t count)
+{
+    uint32_t srcInc = control & UDMA_SRC_INC_NONE;
+    uint32_t dstInc = control & UDMA_DST_INC_NONE;
+
+    if (srcInc == UDMA_SRC_INC_NONE) {
+        task->srcEndAddr = src;
+    }
+    else {
+        task->srcEndAddr = (uint8_t *)src + (count << (srcInc >> 26)) - 1;
+    }
+
+    if (dstInc == UDMA_DST_INC_NONE) {
+        task->dstEndAddr = dst;
+    }
+    else {
+        task->dstEndAddr = (uint8_t *)dst + (count << (dstInc >> 30)) - 1;
+    }
+
+    if ((mode == UDMA_MODE_MEM_SCATTER_GATHER) ||
+        (mode == UDMA_MODE_PER_SCATTER_GATHER)) {
+        mode |= UDMA_MODE_ALT_SELECT;
+    }
+
+    task->control = control | ((count - 1) << 4) | mode;
+    task->spare = 0;
+}
+
+/*
+ *  ======== UDMACC32XX_setCallback ========
+ */
+bool UDMACC32XX_setCallback(UDMACC32XX_Handle handle, uint32_t mapping,
+        UDMACC32XX_CallbackFxn fxn, uintptr_t arg)
+{
+    UDMACC32XX_Object    *object = handle->object;
+    uint32_t              channel = CHANNEL_NUM(mapping);
+    uintptr_t             key;
+
+    if (object->swHwiHandle == NULL) {
+        return (false);
+    }
+
+    key = HwiP_disable();
+
+    object->callbackFxn[channel] = fxn;
+    object->callbackArg[channel] = arg;
+    if (fxn != NULL) {
+        object->callbackMask |= 1U << channel;
+    }
+    else {
+        object->callbackMask &= ~(1U << channel);
+    }
+
+    HwiP_restore(key);
+
+    return (true);
+}
+
+/*
+ *  ======== UDMACC32XX_startScatterGather ========
+ */
+void UDMACC32XX_startScatterGather(UDMACC32XX_Handle handle,
+        uint32_t mapping, UDMACC32XX_Task *tasks, uint_fast16_t taskCount,
+        bool peripheral)
+{
+    UDMACC32XX_Object    *object = handle->object;
+    uint32_t              channel = CHANNEL_NUM(mapping);
+    uint32_t              items = 0;
+    uint_fast16_t         i;
+    uintptr_t             key;
+
+    for (i = 0; i < taskCount; i++) {
+        items += ((tasks[i].control >> 4) & 0x3FF) + 1;
+    }
+
+    key = HwiP_disable();
+    object->stats[channel].transfers++;
+    object->stats[channel].tasks += taskCount;
+    object->stats[channel].items += items;
+    HwiP_restore(key);
+
+    MAP_uDMAChannelScatterGatherSet(channel, taskCount, tasks, peripheral);
+    MAP_uDMAChannelEnable(channel);
+
+    if (!peripheral) {
+        MAP_uDMAChannelRequest(channel);
+    }
+}
+
+/*
+ *  ======== UDMACC32XX_startTransfer ========
+ */
+void UDMACC32XX_startTransfer(UDMACC32XX_Handle handle, uint32_t mapping,
+        uint32_t control, uint32_t mode, void *src, void *dst, uint32_t count)
+{
+    UDMACC32XX_Object    *object = handle->object;
+    uint32_t              channel = CHANNEL_NUM(mapping);
+    uintptr_t             key;
+
+    key = HwiP_disable();
+    object->stats[channel].transfers++;
+    object->stats[channel].items += count;
+    HwiP_restore(key);
+
+    MAP_uDMAChannelControlSet(channel | UDMA_PRI_SELECT, control);
+    MAP_uDMAChannelTransferSet(channel | UDMA_PRI_SELECT, mode, src, dst,
+            count);
+    MAP_uDMAChannelEnable(channel);
+
+    if ((mode == UDMA_MODE_AUTO) && IS_SW_MAPPING(mapping)) {
+        MAP_uDMAChannelRequest(channel);
+    }
+}
+
 /*
  *  ======== UDMACC32XX_close ========
  */
@@ -90,6 +333,11 @@ void UDMACC32XX_init()
 
     if (!dmaInitialized) {
         object->isOpen = false;
+        object->allocMask = 0;
+        object->highPriorityMask = 0;
+        object->allocFailures = 0;
+        object->callbackMask = 0;
+        memset(object->stats, 0, sizeof(object->stats));
 
         HwiP_Params_init(&hwiParams);
         hwiParams.priority = hwAttrs->intPriority;
@@ -103,6 +351,13 @@ void UDMACC32XX_init()
         else {
             dmaInitialized = true;
         }
+
+        /* Checked in UDMACC32XX_setCallback() */
+        hwiParams.arg = (uintptr_t)handle;
+        object->swHwiHandle = HwiP_create(INT_UDMA, swHwiFxn, &hwiParams);
+        if (object->swHwiHandle == NULL) {
+            DebugP_log0("Failed to create uDMA software Hwi!!\n");
+        }
     }
 }
 
@@ -147,6 +402,27 @@ UDMACC32XX_Handle UDMACC32XX_open()
     return (handle);
 }
 
+/*
+ *  ======== swHwiFxn ========
+ *  Dispatches software channel completions to their callbacks.
+ */
+static void swHwiFxn(uintptr_t arg)
+{
+    UDMACC32XX_Handle handle = (UDMACC32XX_Handle)arg;
+    UDMACC32XX_Object *object = handle->object;
+    uint32_t status;
+    uint32_t channel;
+
+    status = MAP_uDMAIntStatus() & object->callbackMask;
+    MAP_uDMAIntClear(status);
+
+    for (channel = 0; status != 0; channel++, status >>= 1) {
+        if (status & 1) {
+            object->callbackFxn[channel](object->callbackArg[channel]);
+        }
+    }
+}
+
 /*
  *  ======== postNotifyFxn ========
  *  Called by Power module when waking up from LPDS.
@@ -156,9 +432,22 @@ static int postNotifyFxn(unsigned int eventType, uintptr_t eventArg,
 {
     UDMACC32XX_Handle handle = (UDMACC32XX_Handle)clientArg;
     UDMACC32XX_HWAttrs const *hwAttrs = handle->hwAttrs;
+    UDMACC32XX_Object *object = handle->object;
+    uint32_t channel;
 
     MAP_uDMAEnable();
     MAP_uDMAControlBaseSet(hwAttrs->controlBaseAddr);
 
+    /* Restore channel mappings and priorities of allocated channels */
+    for (channel = 0; channel < UDMACC32XX_NUM_CHANNELS; channel++) {
+        if (object->allocMask & (1U << channel)) {
+            MAP_uDMAChannelAssign(object->mapping[channel]);
+            if (object->highPriorityMask & (1U << channel)) {
+                MAP_uDMAChannelAttributeEnable(channel,
+                        UDMA_ATTR_HIGH_PRIORITY);
+            }
+        }
+    }
+
     return (Power_NOTIFYDONE);
 }
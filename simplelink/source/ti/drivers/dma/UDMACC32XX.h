@@ -41,11 +41,58 @@
  *  The application should only define the memory for the control table and
  *  set up the UDMACC32XX_HWAttrs and UDMACC32XX_Config structures.
  *
+ *  # Channel Management #
+ *
+ *  Drivers may either keep a fixed channel assignment in their hardware
+ *  attributes, or obtain a channel at runtime with
+ *  UDMACC32XX_allocChannel().  The caller passes the channel mappings it can
+ *  work with (a peripheral is usually wired to two channels, and every
+ *  channel has a software mapping), and the first one whose channel is free
+ *  is assigned and returned.  Drivers that program a fixed channel should
+ *  reserve it with UDMACC32XX_allocChannel() as well, so that dynamic users
+ *  cannot claim it.
+ *
+ *  The uDMA arbitrates between channels by priority level and then by
+ *  channel number.  UDMACC32XX_PRIORITY_HIGH places a channel in the high
+ *  priority level; software channels are allocated from the highest free
+ *  channel number down, so peripheral channels with lower numbers win
+ *  arbitration against bulk memory transfers at the same level.
+ *
+ *  Allocated mappings and priorities are restored when waking from LPDS.
+ *
+ *  # Scatter-Gather #
+ *
+ *  A list of UDMACC32XX_Task entries describes a chain of transfers that the
+ *  uDMA executes without CPU involvement.  Each entry is filled in with
+ *  UDMACC32XX_setTask() (or statically with uDMATaskStructEntry()) and the
+ *  list is started with UDMACC32XX_startScatterGather().  In memory mode the
+ *  whole list runs on one software request; in peripheral mode each task
+ *  waits for the peripheral's request signal.
+ *
+ *  # Completion Callbacks #
+ *
+ *  Transfers on software mappings signal completion on the shared uDMA
+ *  software interrupt.  The driver owns that interrupt and calls the
+ *  function registered for the channel with UDMACC32XX_setCallback(), in
+ *  Hwi context.  Peripheral transfers complete on the peripheral's own
+ *  interrupt and do not use callbacks.
+ *
+ *  # Utilization #
+ *
+ *  UDMACC32XX_getChannelStats() returns how often a channel was allocated,
+ *  how many transfers and scatter-gather tasks were started on it through
+ *  this driver, and the number of items moved.
+ *
  *  The UDMACC32XX header file should be included in an application as follows:
  *  @code
  *  #include <ti/drivers/dma/UDMACC32XX.h>
  *  @endcode
  *
+ *  The channel mappings, control words and modes passed to this driver are
+ *  the UDMA_* values of driverlib; code using them includes
+ *  ti/devices/cc32xx/inc/hw_types.h and ti/devices/cc32xx/driverlib/udma.h
+ *  itself.
+ *
  *  ============================================================================
  */
 
@@ -60,6 +107,51 @@ extern "C" {
 #include <stdbool.h>
 #include <ti/drivers/dpl/HwiP.h>
 
+/*!
+ *  @brief  Number of uDMA channels
+ */
+#define UDMACC32XX_NUM_CHANNELS         32
+
+/*!
+ *  @brief  UDMACC32XX_allocChannel() return value if no channel was free
+ */
+#define UDMACC32XX_CHANNEL_NONE         (~0U)
+
+/*!
+ *  @brief  Channel priority flags for UDMACC32XX_allocChannel()
+ */
+#define UDMACC32XX_PRIORITY_DEFAULT     0x0
+#define UDMACC32XX_PRIORITY_HIGH        0x1
+
+/*!
+ *  @brief  Scatter-gather task list entry
+ *
+ *  Task lists must be word aligned.  Entries are copied by the uDMA into the
+ *  alternate control structure of the channel running the list, so the
+ *  layout is that of a uDMA control structure (tDMAControlTable).
+ */
+typedef struct UDMACC32XX_Task {
+    void       *srcEndAddr;     /*!< Address of the last source item */
+    void       *dstEndAddr;     /*!< Address of the last destination item */
+    uint32_t    control;        /*!< Control word */
+    uint32_t    spare;          /*!< Unused */
+} UDMACC32XX_Task;
+
+/*!
+ *  @brief  Per-channel utilization counters
+ */
+typedef struct UDMACC32XX_ChannelStats {
+    uint32_t allocations;   /*!< Times the channel was allocated */
+    uint32_t transfers;     /*!< Transfers and task lists started */
+    uint32_t tasks;         /*!< Scatter-gather tasks started */
+    uint32_t items;         /*!< Items moved by transfers started */
+} UDMACC32XX_ChannelStats;
+
+/*!
+ *  @brief      UDMA channel completion callback, called in Hwi context
+ */
+typedef void (*UDMACC32XX_CallbackFxn)(uintptr_t arg);
+
 /*!
  *  @brief      UDMA error function pointer
  */
@@ -77,7 +169,8 @@ typedef void (*UDMACC32XX_ErrorFxn)(uintptr_t arg);
  *
  *  dmaErrorFxn is the uDMA peripheral's error interrupt handler.
  *
- *  intPriority is priority of the uDMA peripheral's error interrupt, as
+ *  intPriority is priority of the uDMA peripheral's error interrupt and of
+ *  the software channel completion interrupt (INT_UDMA), as
  *  defined by the underlying OS.  It is passed unmodified to the
  *  underlying OS's interrupt handler creation code, so you need to
  *  refer to the OS documentation for usage.  If the
@@ -140,8 +233,149 @@ typedef struct UDMACC32XX_Config      *UDMACC32XX_Handle;
 typedef struct UDMACC32XX_Object {
     bool             isOpen;          /* Flag for open/close status */
     HwiP_Handle      hwiHandle;       /* DMA error Hwi */
+    HwiP_Handle      swHwiHandle;     /* Software channel completion Hwi */
+    uint32_t         callbackMask;    /* Channels with a callback */
+    uint32_t         allocMask;       /* Allocated channels */
+    uint32_t         highPriorityMask;    /* Channels at high priority */
+    uint32_t         allocFailures;   /* UDMACC32XX_allocChannel() failures */
+    uint32_t         mapping[UDMACC32XX_NUM_CHANNELS]; /* Assigned mappings */
+    UDMACC32XX_ChannelStats stats[UDMACC32XX_NUM_CHANNELS];
+    UDMACC32XX_CallbackFxn callbackFxn[UDMACC32XX_NUM_CHANNELS];
+    uintptr_t        callbackArg[UDMACC32XX_NUM_CHANNELS];
 } UDMACC32XX_Object;
 
+/*!
+ *  @brief  Function to allocate a uDMA channel
+ *
+ *  The channels selected by @p mappings are tried in order, and the first
+ *  one that is not allocated is assigned to its mapping with
+ *  uDMAChannelAssign() and placed at the requested priority level.  The
+ *  channel's attributes other than the priority are reset.
+ *
+ *  If @p mappings is NULL, any free channel is taken with its software
+ *  mapping (UDMA_CHn_SW), searching from channel 31 down.
+ *
+ *  @pre    UDMACC32XX_open() has to be called first.
+ *          Calling context: Task or Hwi
+ *
+ *  @param  handle    A UDMACC32XX_Handle returned from UDMACC32XX_open()
+ *  @param  mappings  Array of channel mappings (for example
+ *                    UDMA_CH8_UARTA0_RX), or NULL for a software channel
+ *  @param  count     Number of entries in @p mappings
+ *  @param  priority  UDMACC32XX_PRIORITY_DEFAULT or UDMACC32XX_PRIORITY_HIGH
+ *
+ *  @return The allocated mapping, or UDMACC32XX_CHANNEL_NONE if all
+ *          candidate channels are in use.
+ *
+ *  @sa     UDMACC32XX_freeChannel()
+ */
+extern uint32_t UDMACC32XX_allocChannel(UDMACC32XX_Handle handle,
+        const uint32_t *mappings, uint_fast8_t count, uint_fast8_t priority);
+
+/*!
+ *  @brief  Function to change the priority level of an allocated channel
+ *
+ *  @param  handle    A UDMACC32XX_Handle returned from UDMACC32XX_open()
+ *  @param  mapping   Mapping returned by UDMACC32XX_allocChannel()
+ *  @param  priority  UDMACC32XX_PRIORITY_DEFAULT or UDMACC32XX_PRIORITY_HIGH
+ */
+extern void UDMACC32XX_setChannelPriority(UDMACC32XX_Handle handle,
+        uint32_t mapping, uint_fast8_t priority);
+
+/*!
+ *  @brief  Function to free a channel allocated with UDMACC32XX_allocChannel()
+ *
+ *  The channel is disabled; any transfer in progress is abandoned.
+ *
+ *  @param  handle    A UDMACC32XX_Handle returned from UDMACC32XX_open()
+ *  @param  mapping   Mapping returned by UDMACC32XX_allocChannel()
+ */
+extern void UDMACC32XX_freeChannel(UDMACC32XX_Handle handle, uint32_t mapping);
+
+/*!
+ *  @brief  Function to set the completion callback of a software channel
+ *
+ *  @p fxn is called from the uDMA software interrupt each time a transfer
+ *  on the channel completes.  Passing NULL removes the callback.
+ *
+ *  @param  handle    A UDMACC32XX_Handle returned from UDMACC32XX_open()
+ *  @param  mapping   Software channel mapping, for example UDMA_CH30_SW
+ *  @param  fxn       Callback function, or NULL
+ *  @param  arg       Argument passed to @p fxn
+ *
+ *  @return true on success, false if the completion interrupt could not be
+ *          created.
+ */
+extern bool UDMACC32XX_setCallback(UDMACC32XX_Handle handle, uint32_t mapping,
+        UDMACC32XX_CallbackFxn fxn, uintptr_t arg);
+
+/*!
+ *  @brief  Function to start a single transfer on an allocated channel
+ *
+ *  Programs the primary control structure of the channel and enables it.
+ *  For UDMA_MODE_AUTO on a software mapping the transfer is also requested.
+ *  Peripheral transfers start when the peripheral raises its request.
+ *
+ *  @param  handle    A UDMACC32XX_Handle returned from UDMACC32XX_open()
+ *  @param  mapping   Mapping returned by UDMACC32XX_allocChannel()
+ *  @param  control   Item size, increments and arbitration size, as for
+ *                    uDMAChannelControlSet()
+ *  @param  mode      UDMA_MODE_BASIC, UDMA_MODE_AUTO or UDMA_MODE_PINGPONG
+ *  @param  src       Source address
+ *  @param  dst       Destination address
+ *  @param  count     Number of items, 1 to 1024
+ */
+extern void UDMACC32XX_startTransfer(UDMACC32XX_Handle handle,
+        uint32_t mapping, uint32_t control, uint32_t mode, void *src,
+        void *dst, uint32_t count);
+
+/*!
+ *  @brief  Function to fill in a scatter-gather task list entry
+ *
+ *  The runtime equivalent of uDMATaskStructEntry().  Within a task list
+ *  every task but the last uses UDMA_MODE_MEM_SCATTER_GATHER or
+ *  UDMA_MODE_PER_SCATTER_GATHER; the last task uses UDMA_MODE_AUTO (memory
+ *  lists) or UDMA_MODE_BASIC (peripheral lists) so that the channel
+ *  completes.  The alternate select bit is added by this function.
+ *
+ *  @param  task      Task list entry to fill in
+ *  @param  control   Item size, increments and arbitration size, as for
+ *                    uDMAChannelControlSet()
+ *  @param  mode      Transfer mode of this task
+ *  @param  src       Source address
+ *  @param  dst       Destination address
+ *  @param  count     Number of items, 1 to 1024
+ */
+extern void UDMACC32XX_setTask(UDMACC32XX_Task *task, uint32_t control,
+        uint32_t mode, void *src, void *dst, uint32_t count);
+
+/*!
+ *  @brief  Function to start a scatter-gather task list on a channel
+ *
+ *  The task list must remain valid until the channel completes.  Memory
+ *  lists are started immediately with a software request; peripheral lists
+ *  advance on each request from the peripheral.
+ *
+ *  @param  handle      A UDMACC32XX_Handle returned from UDMACC32XX_open()
+ *  @param  mapping     Mapping returned by UDMACC32XX_allocChannel()
+ *  @param  tasks       Task list
+ *  @param  taskCount   Number of tasks, 1 to 256
+ *  @param  peripheral  true for peripheral scatter-gather, false for memory
+ */
+extern void UDMACC32XX_startScatterGather(UDMACC32XX_Handle handle,
+        uint32_t mapping, UDMACC32XX_Task *tasks, uint_fast16_t taskCount,
+        bool peripheral);
+
+/*!
+ *  @brief  Function to read the utilization counters of a channel
+ *
+ *  @param  handle    A UDMACC32XX_Handle returned from UDMACC32XX_open()
+ *  @param  channel   Channel number or mapping
+ *  @param  stats     Pointer to the structure to fill in
+ */
+extern void UDMACC32XX_getChannelStats(UDMACC32XX_Handle handle,
+        uint32_t channel, UDMACC32XX_ChannelStats *stats);
+
 /*!
  *  @brief  Function to close the DMA driver.
  *
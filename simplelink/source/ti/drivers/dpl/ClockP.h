@@ -71,8 +71,9 @@ extern "C" {
  *
  *  nortos:   32 (biggest of the HW-specific ClockP instance structs)
  *  SysBIOS:  36
+ *  Zephyr:   64
  */
-#define ClockP_STRUCT_SIZE   (36)
+#define ClockP_STRUCT_SIZE   (64)
 
 /*!
  *  @brief    ClockP structure.
@@ -297,9 +298,32 @@ extern void ClockP_stop(ClockP_Handle handle);
 
 extern void ClockP_timestamp(ClockP_Handle handle);
 
+/*!
+ *  @brief  Get a free running timestamp
+ *
+ *  The timestamp counts at the rate returned by ClockP_getTimestampFreq(),
+ *  typically the CPU clock, and wraps back to zero after it reaches the
+ *  max value that can be stored in 32 bits. Use it to measure short
+ *  intervals with a finer resolution than ClockP_getSystemTicks().
+ *
+ *  @return Timestamp in timestamp counts
+ */
+extern uint32_t ClockP_getTimestamp(void);
+
+/*!
+ *  @brief  Get the rate of ClockP_getTimestamp() in Hz
+ *
+ *  @param  freq  Pointer to the FreqHz structure
+ */
+extern void ClockP_getTimestampFreq(ClockP_FreqHz *freq);
+
 /*!
  *  @brief  Set delay in microseconds
  *
+ *  On the Zephyr port, delays shorter than DPL_USLEEP_SPIN_MAX (50 by
+ *  default) microseconds busy-wait; longer delays block the calling thread
+ *  and may last up to a system tick longer than requested.
+ *
  *  @param  usec  A duration in micro seconds
  *
  *  @return ClockP_OK
@@ -60,6 +60,7 @@
 #include <ti/devices/cc32xx/inc/hw_memmap.h>
 #include <ti/devices/cc32xx/inc/hw_gpio.h>
 #include <ti/devices/cc32xx/inc/hw_ints.h>
+#include <ti/devices/cc32xx/inc/hw_nvic.h>
 #include <ti/devices/cc32xx/driverlib/rom.h>
 #include <ti/devices/cc32xx/driverlib/rom_map.h>
 #include <ti/devices/cc32xx/driverlib/gpio.h>
@@ -168,6 +169,15 @@ static const uint32_t powerResources[] = {
 /* Uninitialized callbackInfo pinIndex */
 #define CALLBACK_INDEX_NOT_CONFIGURED 0xFF
 
+/* Cortex-M4 DWT cycle counter, used for event timestamps */
+#define DWT_CTRL             0xE0001000
+#define DWT_CYCCNT           0xE0001004
+#define DWT_CTRL_CYCCNTENA   0x00000001
+#define NVIC_DBG_INT_TRCENA  0x01000000
+
+/* Events copied per interrupt-disabled section in GPIOCC32XX_readEvents() */
+#define EVENT_COPY_BATCH     8
+
 /*
  * Device specific interpretation of the GPIO_PinConfig content
  */
@@ -196,6 +206,15 @@ typedef struct PortCallbackInfo {
  */
 static PortCallbackInfo gpioCallbackInfo[NUM_PORTS];
 
+/*
+ * Event rings attached by GPIOCC32XX_enableEvents(), by port and pin.
+ * A pin with an event ring records its edges instead of calling back.
+ */
+static GPIOCC32XX_EventRing *eventRings[NUM_PORTS][NUM_PINS_PER_PORT];
+
+/* Number of attached event rings; the cycle counter runs while non-zero */
+static uint8_t numEventRings = 0;
+
 /*
  * bit mask used to determine if a Hwi has been created/constructed
  * for a port already.
@@ -397,6 +416,85 @@ void GPIO_getConfig(uint_least8_t index, GPIO_PinConfig *pinConfig)
     *pinConfig = GPIOCC32XX_config.pinConfigs[index];
 }
 
+/*
+ *  ======== enableCycleCounter ========
+ */
+static void enableCycleCounter(void)
+{
+    HWREG(NVIC_DBG_INT) |= NVIC_DBG_INT_TRCENA;
+    HWREG(DWT_CTRL) |= DWT_CTRL_CYCCNTENA;
+}
+
+/*
+ *  ======== recordEvent ========
+ *  Append an edge to a pin's event ring, or fold it into the newest event
+ *  if it follows closely or the ring is full. Called from the port Hwi.
+ */
+static void recordEvent(GPIOCC32XX_EventRing *ring, uint32_t timestamp,
+    uint8_t level)
+{
+    GPIOCC32XX_Event *event;
+    uint16_t          newest;
+    bool              full;
+
+    ring->stats.edges++;
+
+    full = (ring->count == ring->numEvents);
+    newest = (ring->head == 0) ? ring->numEvents - 1 : ring->head - 1;
+
+    if (ring->count > 0 &&
+        (full || timestamp - ring->lastEdge < ring->coalesceCycles)) {
+        event = &ring->events[newest];
+        event->span = timestamp - event->timestamp;
+        event->count++;
+        event->level = level;
+
+        if (full) {
+            ring->stats.overflows++;
+        }
+    }
+    else {
+        event = &ring->events[ring->head];
+        event->timestamp = timestamp;
+        event->span = 0;
+        event->count = 1;
+        event->index = ring->index;
+        event->level = level;
+
+        ring->head = (ring->head + 1 == ring->numEvents) ? 0 : ring->head + 1;
+        ring->count++;
+        ring->stats.events++;
+
+        if (ring->count == ring->threshold) {
+            SemaphoreP_post(ring->sem);
+        }
+    }
+
+    ring->lastEdge = timestamp;
+}
+
+/*
+ *  ======== leaveEvents ========
+ *  Called by GPIOCC32XX_readEvents() when it is done with the ring. After
+ *  GPIOCC32XX_disableEvents() each reader wakes the next, and the last one
+ *  lets GPIOCC32XX_disableEvents() delete the semaphores.
+ */
+static void leaveEvents(GPIOCC32XX_EventRing *ring)
+{
+    uintptr_t key;
+    bool      closing;
+    uint8_t   readers;
+
+    key = HwiP_disable();
+    readers = --ring->readers;
+    closing = ring->closing;
+    HwiP_restore(key);
+
+    if (closing) {
+        SemaphoreP_post((readers > 0) ? ring->sem : ring->idleSem);
+    }
+}
+
 /*
  *  ======== GPIO_hwiIntFxn ========
  *  Hwi function that processes GPIO interrupts.
@@ -406,8 +504,14 @@ void GPIO_hwiIntFxn(uintptr_t portIndex)
     unsigned int      bitNum;
     unsigned int      pinIndex;
     uint32_t          pins;
+    uint32_t          levels = 0;
     uint32_t          portBase;
+    uint32_t          timestamp;
     PortCallbackInfo *portCallbackInfo;
+    GPIOCC32XX_EventRing *ring;
+
+    /* Sample the cycle counter first, for the least jitter */
+    timestamp = HWREG(DWT_CYCCNT);
 
     portCallbackInfo = &gpioCallbackInfo[portIndex];
     portBase = getPortBase(portIndex);
@@ -418,13 +522,21 @@ void GPIO_hwiIntFxn(uintptr_t portIndex)
     /* clear all the set bits at once */
     MAP_GPIOIntClear(portBase, pins);
 
+    if (numEventRings) {
+        levels = MAP_GPIOPinRead(portBase, pins);
+    }
+
     /* Match the interrupt to its corresponding callback function */
     while (pins) {
         /* Gets the lowest order set bit number */
         bitNum = getPinNumber(pins);
+        ring = eventRings[portIndex][bitNum & 0x7];
         pinIndex = portCallbackInfo->pinIndex[bitNum & 0x7];
+        if (ring != NULL) {
+            recordEvent(ring, timestamp, (levels >> bitNum) & 1);
+        }
         /* only call plugged callbacks */
-        if (pinIndex != CALLBACK_INDEX_NOT_CONFIGURED) {
+        else if (pinIndex != CALLBACK_INDEX_NOT_CONFIGURED) {
             GPIOCC32XX_config.callbacks[pinIndex](pinIndex);
         }
         pins &= ~(1 << bitNum);
@@ -764,6 +876,10 @@ static int powerNotifyFxn(unsigned int eventType, uintptr_t eventArg,
 
     if (eventType == PowerCC32XX_AWAKE_LPDS) {
 
+        if (numEventRings) {
+            enableCycleCounter();
+        }
+
         for (i = 0; i < GPIOCC32XX_config.numberOfPinConfigs; i++) {
             if (!(GPIOCC32XX_config.pinConfigs[i] & GPIO_DO_NOT_CONFIG)) {
                 config = GPIOCC32XX_config.pinConfigs[i];
@@ -813,3 +929,228 @@ static int powerNotifyFxn(unsigned int eventType, uintptr_t eventArg,
 
     return (Power_NOTIFYDONE);
 }
+
+/*
+ *  ======== GPIOCC32XX_EventParams_init ========
+ */
+void GPIOCC32XX_EventParams_init(GPIOCC32XX_EventParams *params)
+{
+    params->events = NULL;
+    params->numEvents = 0;
+    params->threshold = 1;
+    params->coalesceCycles = 0;
+}
+
+/*
+ *  ======== GPIOCC32XX_enableEvents ========
+ */
+int_fast16_t GPIOCC32XX_enableEvents(uint_least8_t index,
+    GPIOCC32XX_EventRing *ring, GPIOCC32XX_EventParams *params)
+{
+    uintptr_t  key;
+    uint32_t   pinNum;
+    uint32_t   portIndex;
+    PinConfig *config = (PinConfig *) &GPIOCC32XX_config.pinConfigs[index];
+
+    DebugP_assert(initCalled && index < GPIOCC32XX_config.numberOfPinConfigs);
+
+    if (params->events == NULL || params->numEvents == 0 ||
+        params->threshold == 0 || params->threshold > params->numEvents ||
+        (GPIOCC32XX_config.pinConfigs[index] & GPIO_CFG_INT_MASK) == 0) {
+        return (GPIO_STATUS_ERROR);
+    }
+
+    ring->sem = SemaphoreP_createBinary(0);
+    if (ring->sem == NULL) {
+        return (GPIO_STATUS_ERROR);
+    }
+    ring->idleSem = SemaphoreP_createBinary(0);
+    if (ring->idleSem == NULL) {
+        SemaphoreP_delete(ring->sem);
+        return (GPIO_STATUS_ERROR);
+    }
+
+    ring->events = params->events;
+    ring->numEvents = params->numEvents;
+    ring->threshold = params->threshold;
+    ring->coalesceCycles = params->coalesceCycles;
+    ring->head = 0;
+    ring->count = 0;
+    ring->lastEdge = 0;
+    ring->index = index;
+    ring->readers = 0;
+    ring->closing = false;
+    ring->stats.edges = 0;
+    ring->stats.events = 0;
+    ring->stats.overflows = 0;
+
+    pinNum = getPinNumber(config->pin);
+    portIndex = config->port & PORT_MASK;
+
+    key = HwiP_disable();
+
+    if (eventRings[portIndex][pinNum] != NULL) {
+        HwiP_restore(key);
+        SemaphoreP_delete(ring->sem);
+        SemaphoreP_delete(ring->idleSem);
+        return (GPIO_STATUS_ERROR);
+    }
+
+    if (numEventRings++ == 0) {
+        enableCycleCounter();
+    }
+    eventRings[portIndex][pinNum] = ring;
+
+    HwiP_restore(key);
+
+    DebugP_log2("GPIO: port 0x%x, pin 0x%x event capture enabled",
+        getPort(config->port), config->pin);
+
+    return (GPIO_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== GPIOCC32XX_disableEvents ========
+ */
+void GPIOCC32XX_disableEvents(uint_least8_t index)
+{
+    uintptr_t             key;
+    uint32_t              pinNum;
+    uint32_t              portIndex;
+    GPIOCC32XX_EventRing *ring;
+    PinConfig *config = (PinConfig *) &GPIOCC32XX_config.pinConfigs[index];
+
+    DebugP_assert(initCalled && index < GPIOCC32XX_config.numberOfPinConfigs);
+
+    pinNum = getPinNumber(config->pin);
+    portIndex = config->port & PORT_MASK;
+
+    key = HwiP_disable();
+
+    ring = eventRings[portIndex][pinNum];
+    if (ring == NULL) {
+        HwiP_restore(key);
+        return;
+    }
+
+    eventRings[portIndex][pinNum] = NULL;
+    numEventRings--;
+
+    /*
+     * Readers still hold the ring: wake them, the last one to leave
+     * posts idleSem, and only then may the semaphores go.
+     */
+    ring->closing = true;
+    if (ring->readers > 0) {
+        HwiP_restore(key);
+        SemaphoreP_post(ring->sem);
+        SemaphoreP_pend(ring->idleSem, SemaphoreP_WAIT_FOREVER);
+    }
+    else {
+        HwiP_restore(key);
+    }
+
+    SemaphoreP_delete(ring->sem);
+    SemaphoreP_delete(ring->idleSem);
+}
+
+/*
+ *  ======== GPIOCC32XX_readEvents ========
+ */
+uint_fast16_t GPIOCC32XX_readEvents(uint_least8_t index,
+    GPIOCC32XX_Event *events, uint_fast16_t maxEvents, uint32_t timeout)
+{
+    uintptr_t             key;
+    uint_fast16_t         copied = 0;
+    uint_fast16_t         batch;
+    uint16_t              tail;
+    GPIOCC32XX_EventRing *ring;
+    PinConfig *config = (PinConfig *) &GPIOCC32XX_config.pinConfigs[index];
+
+    DebugP_assert(initCalled && index < GPIOCC32XX_config.numberOfPinConfigs);
+
+    key = HwiP_disable();
+    ring = eventRings[config->port & PORT_MASK][getPinNumber(config->pin)];
+    if (ring == NULL) {
+        HwiP_restore(key);
+        return (0);
+    }
+    ring->readers++;
+    HwiP_restore(key);
+
+    /*
+     * Discard a post left from events already taken, then wait only if
+     * the threshold is not met. A post made after this is kept, including
+     * the one GPIOCC32XX_disableEvents() makes after setting closing.
+     */
+    SemaphoreP_pend(ring->sem, SemaphoreP_NO_WAIT);
+    if (!ring->closing && ring->count < ring->threshold) {
+        SemaphoreP_pend(ring->sem, timeout);
+    }
+    if (ring->closing) {
+        leaveEvents(ring);
+        return (0);
+    }
+
+    /*
+     * The Hwi may fold edges into the newest event, so copy under
+     * interrupt lock, a few events at a time to bound the latency.
+     */
+    while (copied < maxEvents) {
+        key = HwiP_disable();
+
+        batch = maxEvents - copied;
+        if (batch > ring->count) {
+            batch = ring->count;
+        }
+        if (batch > EVENT_COPY_BATCH) {
+            batch = EVENT_COPY_BATCH;
+        }
+        if (batch == 0) {
+            HwiP_restore(key);
+            break;
+        }
+
+        tail = (ring->head >= ring->count) ? ring->head - ring->count :
+            ring->head + ring->numEvents - ring->count;
+        ring->count -= batch;
+
+        while (batch--) {
+            events[copied++] = ring->events[tail];
+            tail = (tail + 1 == ring->numEvents) ? 0 : tail + 1;
+        }
+
+        HwiP_restore(key);
+    }
+
+    leaveEvents(ring);
+
+    return (copied);
+}
+
+/*
+ *  ======== GPIOCC32XX_getEventStats ========
+ */
+void GPIOCC32XX_getEventStats(uint_least8_t index,
+    GPIOCC32XX_EventStats *stats)
+{
+    uintptr_t             key;
+    GPIOCC32XX_EventRing *ring;
+    PinConfig *config = (PinConfig *) &GPIOCC32XX_config.pinConfigs[index];
+
+    DebugP_assert(initCalled && index < GPIOCC32XX_config.numberOfPinConfigs);
+
+    key = HwiP_disable();
+
+    ring = eventRings[config->port & PORT_MASK][getPinNumber(config->pin)];
+    if (ring != NULL) {
+        *stats = ring->stats;
+    }
+    else {
+        stats->edges = 0;
+        stats->events = 0;
+        stats->overflows = 0;
+    }
+
+    HwiP_restore(key);
+}
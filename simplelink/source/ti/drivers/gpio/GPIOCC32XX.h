@@ -136,6 +136,48 @@
  * \note GPIOCC32XX_GPIO_26 & GPIOCC32XX_GPIO_27 can only be used as output
  * pins.
  *
+ *  ### Event capture #
+ *
+ *  Callbacks run once per edge in interrupt context and know only the pin
+ *  index. For pins that toggle at high rates, such as flow meter or
+ *  encoder inputs, GPIOCC32XX_enableEvents() attaches an application
+ *  supplied event ring to a pin instead. The interrupt then only appends
+ *  a GPIOCC32XX_Event holding the pin level and a CPU cycle count taken on
+ *  interrupt entry, and a task drains the ring in batches with
+ *  GPIOCC32XX_readEvents(). A pin with an event ring does not call its
+ *  callback.
+ *
+ *  Edges closer than coalesceCycles to the previous one are folded into
+ *  that event, which then spans a burst of edges. When the ring is full
+ *  further edges are folded into the newest event as well, so the edge
+ *  count stays exact even when the task falls behind.
+ *
+ *  @code
+ *  static GPIOCC32XX_Event     flowEvents[64];
+ *  static GPIOCC32XX_EventRing flowRing;
+ *
+ *  GPIOCC32XX_EventParams params;
+ *  GPIOCC32XX_Event       batch[16];
+ *  uint_fast16_t          n;
+ *
+ *  GPIOCC32XX_EventParams_init(&params);
+ *  params.events = flowEvents;
+ *  params.numEvents = 64;
+ *  params.threshold = 16;
+ *  GPIOCC32XX_enableEvents(Board_FLOW_SENSOR, &flowRing, &params);
+ *  GPIO_enableInt(Board_FLOW_SENSOR);
+ *
+ *  while (1) {
+ *      n = GPIOCC32XX_readEvents(Board_FLOW_SENSOR, batch, 16,
+ *          SemaphoreP_WAIT_FOREVER);
+ *      ...
+ *  }
+ *  @endcode
+ *
+ *  Timestamps are taken from the Cortex-M4 DWT cycle counter, which runs
+ *  at the CPU clock and wraps every 2^32 cycles. The counter is re-enabled
+ *  after LPDS but does not keep counting through it.
+ *
  *  ============================================================================
  */
 
@@ -148,6 +190,7 @@ extern "C" {
 
 #include <stdint.h>
 #include <ti/drivers/GPIO.h>
+#include <ti/drivers/dpl/SemaphoreP.h>
 
 /*!
  *  @brief  GPIO device specific driver configuration structure
@@ -256,6 +299,133 @@ typedef struct GPIOCC32XX_Config {
 
 /** @} end of GPIOCC32XX_PinConfigIds group */
 
+/*!
+ *  @brief  A captured GPIO edge, or a burst of coalesced edges
+ */
+typedef struct GPIOCC32XX_Event {
+    uint32_t timestamp;  /*!< Cycle count at the first edge */
+    uint32_t span;       /*!< Cycles from the first to the last edge */
+    uint32_t count;      /*!< Number of edges, at least 1 */
+    uint8_t  index;      /*!< GPIO pin index */
+    uint8_t  level;      /*!< Pin level (0 or 1) after the last edge */
+} GPIOCC32XX_Event;
+
+/*!
+ *  @brief  GPIOCC32XX event capture parameters
+ *
+ *  @sa GPIOCC32XX_EventParams_init()
+ */
+typedef struct GPIOCC32XX_EventParams {
+    /*! Ring storage */
+    GPIOCC32XX_Event *events;
+    /*! Number of events the ring holds */
+    uint16_t          numEvents;
+    /*! GPIOCC32XX_readEvents() waits for this many events */
+    uint16_t          threshold;
+    /*! Edges closer than this many cycles to the previous edge are
+     *  coalesced into its event; 0 records every edge */
+    uint32_t          coalesceCycles;
+} GPIOCC32XX_EventParams;
+
+/*!
+ *  @brief  GPIOCC32XX event capture statistics
+ *
+ *  @sa GPIOCC32XX_getEventStats()
+ */
+typedef struct GPIOCC32XX_EventStats {
+    uint32_t edges;      /*!< Edges seen */
+    uint32_t events;     /*!< Events appended to the ring */
+    uint32_t overflows;  /*!< Edges folded in because the ring was full */
+} GPIOCC32XX_EventStats;
+
+/*!
+ *  @brief  GPIOCC32XX event ring
+ *
+ *  Supplied by the application, one per pin with event capture.
+ *  The application must not access any member variables of this structure!
+ */
+typedef struct GPIOCC32XX_EventRing {
+    GPIOCC32XX_Event     *events;
+    uint16_t              numEvents;
+    uint16_t              threshold;
+    uint16_t              head;       /* Next slot written */
+    uint16_t              count;      /* Events in the ring */
+    uint32_t              coalesceCycles;
+    uint32_t              lastEdge;   /* Cycle count of the newest edge */
+    uint8_t               index;
+    uint8_t               readers;    /* Tasks in GPIOCC32XX_readEvents() */
+    bool                  closing;    /* GPIOCC32XX_disableEvents() called */
+    SemaphoreP_Handle     sem;        /* Posted when count hits threshold */
+    SemaphoreP_Handle     idleSem;    /* Posted when the last reader leaves */
+    GPIOCC32XX_EventStats stats;
+} GPIOCC32XX_EventRing;
+
+/*!
+ *  @brief  Initialize event parameters to default values: no storage,
+ *          threshold 1 and no coalescing.
+ *
+ *  @param  params  Pointer to the event parameters
+ */
+extern void GPIOCC32XX_EventParams_init(GPIOCC32XX_EventParams *params);
+
+/*!
+ *  @brief  Attach an event ring to an input pin
+ *
+ *  The pin must be configured for interrupts; they are left as they are,
+ *  so call GPIO_enableInt() to start capturing.
+ *
+ *  @param  index   GPIO index
+ *  @param  ring    Ring state, which must stay valid until
+ *                  GPIOCC32XX_disableEvents() is called
+ *  @param  params  Event parameters
+ *
+ *  @return GPIO_STATUS_SUCCESS, or GPIO_STATUS_ERROR if the parameters are
+ *          invalid, the pin has no interrupt configured or a semaphore
+ *          could not be created.
+ */
+extern int_fast16_t GPIOCC32XX_enableEvents(uint_least8_t index,
+    GPIOCC32XX_EventRing *ring, GPIOCC32XX_EventParams *params);
+
+/*!
+ *  @brief  Detach the event ring of a pin
+ *
+ *  The pin's callback, if any, is called for its edges again. Events
+ *  still in the ring are discarded.
+ *
+ *  Tasks waiting in GPIOCC32XX_readEvents() for the pin are woken and
+ *  return 0; the ring's semaphores are deleted once they have left, so
+ *  this function may block and must be called from a task.
+ *
+ *  @param  index   GPIO index
+ */
+extern void GPIOCC32XX_disableEvents(uint_least8_t index);
+
+/*!
+ *  @brief  Take events from the ring of a pin, oldest first
+ *
+ *  Waits until the ring holds at least the threshold number of events or
+ *  the timeout expires, then returns what is there, up to maxEvents.
+ *  Returns 0 at once if GPIOCC32XX_disableEvents() is called meanwhile.
+ *
+ *  @param  index      GPIO index
+ *  @param  events     Buffer for the events
+ *  @param  maxEvents  Size of the buffer in events
+ *  @param  timeout    Timeout, in ClockP ticks
+ *
+ *  @return Number of events copied, possibly 0
+ */
+extern uint_fast16_t GPIOCC32XX_readEvents(uint_least8_t index,
+    GPIOCC32XX_Event *events, uint_fast16_t maxEvents, uint32_t timeout);
+
+/*!
+ *  @brief  Read the event statistics of a pin
+ *
+ *  @param  index   GPIO index
+ *  @param  stats   Filled in with the statistics
+ */
+extern void GPIOCC32XX_getEventStats(uint_least8_t index,
+    GPIOCC32XX_EventStats *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -82,6 +82,14 @@
 #define I2C_MASTER_CMD_BURST_RECEIVE_CONT_NACK   I2C_MASTER_CMD_BURST_SEND_CONT
 #endif
 
+/*
+ * True if the current transaction is followed by another of the batch
+ * with a repeated START, so it must end without a STOP.
+ */
+#define holdBus(object) ((object)->batch != NULL && \
+    (object)->batch->repeatedStart && \
+    (object)->batchIndex + 1 < (object)->batch->count)
+
 /* Prototypes */
 static void I2CCC32XX_blockingCallback(I2C_Handle handle, I2C_Transaction *msg,
                                        bool transferStatus);
@@ -135,6 +143,13 @@ void I2CCC32XX_cancel(I2C_Handle handle)
     MAP_I2CMasterControl(hwAttrs->baseAddr,
         I2C_MASTER_CMD_BURST_SEND_ERROR_STOP);
 
+    /* a batch reports through its last transaction */
+    if (object->batch) {
+        object->currentTransaction =
+            &object->batch->transactions[object->batch->count - 1];
+        object->batch = NULL;
+    }
+
     /* call the transfer callback for the current transfer, indicate failure */
     object->transferCallbackFxn(handle, object->currentTransaction, false);
 
@@ -215,6 +230,28 @@ static void I2CCC32XX_completeTransfer(I2C_Handle handle)
     DebugP_log1("I2C:(%p) ISR Transfer Complete",
                 ((I2CCC32XX_HWAttrsV1 const *)(handle->hwAttrs))->baseAddr);
 
+    if (object->batch) {
+        if (object->mode == I2CCC32XX_IDLE_MODE) {
+            object->batch->completed++;
+
+            /* Start the next transaction of the batch right away */
+            if (++object->batchIndex < object->batch->count) {
+                I2CCC32XX_primeTransfer(object,
+                    (I2CCC32XX_HWAttrsV1 const *)handle->hwAttrs,
+                    &object->batch->transactions[object->batchIndex]);
+                return;
+            }
+        }
+
+        /*
+         * The batch is done, or stopped at a failed transaction. Complete
+         * it as its last transaction, which holds the queue position.
+         */
+        object->currentTransaction =
+            &object->batch->transactions[object->batch->count - 1];
+        object->batch = NULL;
+    }
+
     /* See if we need to process any other transactions */
     if (object->headPtr == object->tailPtr) {
 
@@ -319,7 +356,19 @@ static void I2CCC32XX_hwiFxn(uintptr_t arg)
                     MAP_I2CMasterDataPut(hwAttrs->baseAddr, *(object->writeBufIdx));
                     object->writeBufIdx++;
 
-                    if ((object->writeCountIdx < 2) && !(object->readCountIdx)) {
+                    if ((object->writeCountIdx < 2) && !(object->readCountIdx) &&
+                        holdBus(object)) {
+                        /* Next state: Idle mode */
+                        object->mode = I2CCC32XX_IDLE_MODE;
+
+                        /*
+                         * Send last byte without STOP; the next transaction
+                         * of the batch follows with a repeated START
+                         */
+                        MAP_I2CMasterControl(hwAttrs->baseAddr,
+                                             I2C_MASTER_CMD_BURST_SEND_CONT);
+                    }
+                    else if ((object->writeCountIdx < 2) && !(object->readCountIdx)) {
                         /* Everything has been sent, nothing to receive */
                         /* Next state: Idle mode */
                         object->mode = I2CCC32XX_IDLE_MODE;
@@ -390,6 +439,14 @@ static void I2CCC32XX_hwiFxn(uintptr_t arg)
                                         hwAttrs->baseAddr);
                         }
                     }
+                    else if (holdBus(object)) {
+                        /*
+                         * Done, and the bus is held for the next
+                         * transaction of the batch: no STOP
+                         */
+                        object->mode = I2CCC32XX_IDLE_MODE;
+                        I2CCC32XX_completeTransfer((I2C_Handle) arg);
+                    }
                     else {
                         /* Done with all transmissions */
                         object->mode = I2CCC32XX_IDLE_MODE;
@@ -442,6 +499,14 @@ static void I2CCC32XX_hwiFxn(uintptr_t arg)
                                     hwAttrs->baseAddr);
                     }
                 }
+                else if (holdBus(object)) {
+                    /*
+                     * The last byte was NACKed; the next transaction of the
+                     * batch follows with a repeated START instead of a STOP
+                     */
+                    object->mode = I2CCC32XX_IDLE_MODE;
+                    I2CCC32XX_completeTransfer((I2C_Handle) arg);
+                }
                 else {
                     /* Next state: Idle mode */
                     object->mode = I2CCC32XX_IDLE_MODE;
@@ -604,6 +669,7 @@ I2C_Handle I2CCC32XX_open(I2C_Handle handle, I2C_Params *params)
     /* Clear the head pointer */
     object->headPtr = NULL;
     object->tailPtr = NULL;
+    object->batch = NULL;
 
     DebugP_log1("I2C: Object created 0x%x", hwAttrs->baseAddr);
 
@@ -784,6 +850,81 @@ bool I2CCC32XX_transfer(I2C_Handle handle, I2C_Transaction *transaction)
     return (ret);
 }
 
+/*
+ *  ======== I2CCC32XX_transferBatch ========
+ */
+bool I2CCC32XX_transferBatch(I2C_Handle handle, I2CCC32XX_Batch *batch)
+{
+    uintptr_t                  key;
+    bool                       ret = false;
+    I2CCC32XX_Object          *object = handle->object;
+    I2CCC32XX_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
+    I2C_Transaction           *last;
+    uint_least16_t             i;
+
+    batch->completed = 0;
+
+    if (batch->count == 0) {
+        return (ret);
+    }
+    for (i = 0; i < batch->count; i++) {
+        if ((!batch->transactions[i].writeCount) &&
+            (!batch->transactions[i].readCount)) {
+            return (ret);
+        }
+    }
+
+    /* The last transaction stands for the batch in the transfer queue */
+    last = &batch->transactions[batch->count - 1];
+
+    key = HwiP_disable();
+
+    if (object->transferMode == I2C_MODE_CALLBACK && object->headPtr) {
+        /* Transfer in progress */
+        HwiP_restore(key);
+        return (false);
+    }
+
+    object->headPtr = last;
+    object->tailPtr = last;
+
+    HwiP_restore(key);
+
+    /* Get the lock for this I2C handle */
+    if (SemaphoreP_pend(object->mutex, SemaphoreP_NO_WAIT) == SemaphoreP_TIMEOUT) {
+        if (object->transferMode == I2C_MODE_CALLBACK) {
+            return (false);
+        }
+
+        SemaphoreP_pend(object->mutex, SemaphoreP_WAIT_FOREVER);
+    }
+
+    Power_setConstraint(PowerCC32XX_DISALLOW_LPDS);
+
+    HwiP_disableInterrupt(hwAttrs->intNum);
+    object->batch = batch;
+    object->batchIndex = 0;
+    I2CCC32XX_primeTransfer(object, hwAttrs, &batch->transactions[0]);
+    HwiP_enableInterrupt(hwAttrs->intNum);
+
+    DebugP_log2("I2C:(%p) Started batch of %d transactions",
+                hwAttrs->baseAddr, batch->count);
+
+    if (object->transferMode == I2C_MODE_BLOCKING) {
+        SemaphoreP_pend(object->transferComplete, SemaphoreP_WAIT_FOREVER);
+
+        ret = (batch->completed == batch->count);
+    }
+    else {
+        ret = true;
+    }
+
+    /* Release the lock for this particular I2C handle */
+    SemaphoreP_post(object->mutex);
+
+    return (ret);
+}
+
 /*
  *  ======== I2CCC32XX_blockingCallback ========
  */
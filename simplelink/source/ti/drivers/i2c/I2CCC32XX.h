@@ -46,6 +46,35 @@
  *    - #I2C_100kHz
  *    - #I2C_400kHz
  *
+ *  ## Batched transfers ##
+ *  I2CCC32XX_transferBatch() runs an array of transactions back to back
+ *  from the I2C interrupt, e.g. one register read from each of a dozen
+ *  sensors. Each transaction starts as soon as the previous one ends; the
+ *  transfer completes once for the whole batch: a blocking call returns
+ *  once, and in #I2C_MODE_CALLBACK the transfer callback is called once,
+ *  for the last transaction of the batch, with the status of the batch.
+ *
+ *  With I2CCC32XX_Batch.repeatedStart set, the bus is held for the whole
+ *  batch: transactions are joined by a repeated START and only the last
+ *  one ends with a STOP. Otherwise each transaction ends with its own STOP.
+ *
+ *  The batch stops at the first transaction that fails;
+ *  I2CCC32XX_Batch.completed tells how many completed.
+ *
+ *  @code
+ *  I2C_Transaction  reads[12];
+ *  I2CCC32XX_Batch  batch;
+ *
+ *  // fill in reads[i].slaveAddress, writeBuf/writeCount = register,
+ *  // readBuf/readCount = result
+ *  batch.transactions = reads;
+ *  batch.count = 12;
+ *  batch.repeatedStart = true;
+ *  if (!I2CCC32XX_transferBatch(i2cHandle, &batch)) {
+ *      // reads[batch.completed] failed
+ *  }
+ *  @endcode
+ *
  ******************************************************************************
  */
 
@@ -215,9 +244,48 @@ typedef struct I2CCC32XX_Object {
 
     Power_NotifyObj     notifyObj;      /* For notification of wake from LPDS */
     I2C_BitRate         bitRate;        /* I2C bus bit rate */
+
+    struct I2CCC32XX_Batch *batch;      /* Batch in progress, or NULL */
+    uint_least16_t      batchIndex;     /* Its current transaction */
 } I2CCC32XX_Object;
 /*! @endcond */
 
+/*!
+ *  @brief  A batch of transactions for I2CCC32XX_transferBatch()
+ */
+typedef struct I2CCC32XX_Batch {
+    /*! Transactions, run in array order */
+    I2C_Transaction *transactions;
+    /*! Number of transactions */
+    uint_least16_t   count;
+    /*! Join the transactions with repeated STARTs, with a single STOP at
+     *  the end of the batch */
+    bool             repeatedStart;
+    /*! Set by the driver: number of transactions that completed */
+    uint_least16_t   completed;
+} I2CCC32XX_Batch;
+
+/*!
+ *  @brief  Perform a batch of I2C transactions
+ *
+ *  In #I2C_MODE_BLOCKING, blocks until the whole batch has completed. In
+ *  #I2C_MODE_CALLBACK, returns once the batch has started; the transfer
+ *  callback is then called once, for the last transaction of the batch.
+ *  A batch is not queued behind other transfers in callback mode.
+ *
+ *  @pre    I2C_open() has been called.
+ *
+ *  @param  handle  An I2C_Handle
+ *  @param  batch   The batch; it and its transactions must stay valid
+ *                  until the batch completes
+ *
+ *  @return In blocking mode, true if every transaction completed. In
+ *          callback mode, true if the batch was started, false if a
+ *          transfer is in progress. False if the batch is empty or holds
+ *          a transaction without data.
+ */
+extern bool I2CCC32XX_transferBatch(I2C_Handle handle, I2CCC32XX_Batch *batch);
+
 #ifdef __cplusplus
 }
 #endif
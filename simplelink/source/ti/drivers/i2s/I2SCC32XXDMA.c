@@ -145,8 +145,6 @@ static void I2SCC32XXDMA_configDMA(I2S_Handle handle, I2S_BufDesc *desc,
         divider = 4;
     }
 
-    Power_setConstraint(PowerCC32XX_DISALLOW_LPDS);
-
     if (isWrite) {
         channelControlOptions = dmaTxConfig[object->dmaSize];
 
@@ -221,6 +219,156 @@ static void I2SCC32XXDMA_configDMA(I2S_Handle handle, I2S_BufDesc *desc,
     }
 }
 
+/*
+ *  ======== I2SCC32XXDMA_streamArm ========
+ *  Point the primary (slot 0) or alternate (slot 1) control structure of a
+ *  channel at a block of its stream ring.
+ */
+static void I2SCC32XXDMA_streamArm(I2S_Handle handle, bool isWrite,
+    uint_fast8_t slot, uint_fast8_t block)
+{
+    I2SCC32XXDMA_Object          *object = handle->object;
+    I2SCC32XXDMA_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
+    uint32_t                      select;
+    uint32_t                      count;
+
+    select = (slot == 0) ? UDMA_PRI_SELECT : UDMA_ALT_SELECT;
+    count = object->blockSize /
+        ((object->dmaSize == I2SCC32XXDMA_16bit) ? 2 : 4);
+
+    if (isWrite) {
+        MAP_uDMAChannelControlSet(hwAttrs->txChannelIndex | select,
+            dmaTxConfig[object->dmaSize]);
+        MAP_uDMAChannelTransferSet(hwAttrs->txChannelIndex | select,
+            UDMA_MODE_PINGPONG,
+            (void *)(object->txRing + block * object->blockSize),
+            (void *)I2S_TX_DMA_PORT, count);
+    }
+    else {
+        MAP_uDMAChannelControlSet(hwAttrs->rxChannelIndex | select,
+            dmaRxConfig[object->dmaSize]);
+        MAP_uDMAChannelTransferSet(hwAttrs->rxChannelIndex | select,
+            UDMA_MODE_PINGPONG, (void *)I2S_RX_DMA_PORT,
+            (void *)(object->rxRing + block * object->blockSize), count);
+    }
+}
+
+/*
+ *  ======== I2SCC32XXDMA_streamPeriod ========
+ *  A block period has ended; block is the block just completed. The block
+ *  two ahead has just been armed.
+ */
+static void I2SCC32XXDMA_streamPeriod(I2S_Handle handle, uint_fast8_t block)
+{
+    I2SCC32XXDMA_Object *object = handle->object;
+    void                *rxBlock = NULL;
+    uint_fast8_t         txBlock;
+
+    /*
+     * The transmit block just armed was handed out last period. If the
+     * application still holds blocks, that one is among them.
+     */
+    if (object->pending > 0) {
+        object->streamStats.underruns++;
+
+        /*
+         * The receive block just armed was handed out numBlocks - 2
+         * periods ago; it is the oldest held and is now being overwritten.
+         */
+        if (object->pending >= object->numBlocks - 2) {
+            if (object->streamRx) {
+                object->streamStats.overruns++;
+            }
+            object->pending--;
+        }
+    }
+
+    if (object->streamRx) {
+        rxBlock = object->rxRing + block * object->blockSize;
+    }
+    txBlock = (block + 3) % object->numBlocks;
+
+    object->pending++;
+    object->streamStats.blocks++;
+
+    object->streamCallback(handle, rxBlock,
+        object->txRing + txBlock * object->blockSize);
+}
+
+/*
+ *  ======== I2SCC32XXDMA_streamDmaDone ========
+ *  Re-arm the control structures a channel has finished, oldest first, two
+ *  blocks further along the ring.
+ */
+static void I2SCC32XXDMA_streamDmaDone(I2S_Handle handle,
+    bool isWrite)
+{
+    I2SCC32XXDMA_Object          *object = handle->object;
+    I2SCC32XXDMA_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
+    unsigned long                 channel;
+    uint_fast8_t                 *next;
+    uint_fast8_t                 *slot;
+    uint_fast8_t                  done = 0;
+    uint_fast8_t                  block;
+
+    if (isWrite) {
+        channel = hwAttrs->txChannelIndex;
+        next = &object->txNext;
+        slot = &object->txSlot;
+    }
+    else {
+        channel = hwAttrs->rxChannelIndex;
+        next = &object->rxNext;
+        slot = &object->rxSlot;
+    }
+
+    while (done < 2) {
+        if (MAP_uDMAChannelModeGet(channel | ((*slot == 0) ?
+            UDMA_PRI_SELECT : UDMA_ALT_SELECT)) != UDMA_MODE_STOP) {
+            break;
+        }
+
+        block = *next;
+        I2SCC32XXDMA_streamArm(handle, isWrite, *slot,
+            (block + 2) % object->numBlocks);
+        *next = (block + 1) % object->numBlocks;
+        *slot ^= 1;
+        done++;
+
+        /* Receive drives the block period unless the stream has none */
+        if (isWrite != object->streamRx) {
+            I2SCC32XXDMA_streamPeriod(handle, block);
+        }
+    }
+
+    /*
+     * If both blocks ended before the interrupt was served, the uDMA
+     * stopped the channel and the serializer under- or overran; resume.
+     */
+    if (!MAP_uDMAChannelIsEnabled(channel)) {
+        object->streamStats.dmaStalls++;
+        MAP_uDMAChannelEnable(channel);
+    }
+}
+
+/*
+ *  ======== I2SCC32XXDMA_streamHwiFxn ========
+ */
+static void I2SCC32XXDMA_streamHwiFxn(I2S_Handle handle, uint32_t intStatus)
+{
+    I2SCC32XXDMA_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
+
+    if (intStatus & I2S_STS_XDMA) {
+        MAP_I2SIntClear(hwAttrs->baseAddr, I2S_STS_XDMA);
+        I2SCC32XXDMA_streamDmaDone(handle, true);
+    }
+
+    if (intStatus & I2S_STS_RDMA) {
+        MAP_I2SIntClear(hwAttrs->baseAddr, I2S_STS_RDMA);
+        I2SCC32XXDMA_streamDmaDone(handle, false);
+    }
+}
+
 /*
  *  ======== I2SCC32XXDMA_hwiIntFxn ========
  *  Hwi function that processes I2S interrupts.
@@ -244,6 +392,11 @@ static void I2SCC32XXDMA_hwiIntFxn(uintptr_t arg)
     /* Read the interrupt status */
     intStatus = MAP_I2SIntStatus(hwAttrs->baseAddr);
 
+    if (object->isStreaming) {
+        I2SCC32XXDMA_streamHwiFxn((I2S_Handle)arg, intStatus);
+        return;
+    }
+
     /* Check for TX DMA done interrupt */
     if (intStatus & I2S_STS_XDMA) {
 
@@ -406,6 +559,8 @@ void I2SCC32XXDMA_close(I2S_Handle handle)
     I2SCC32XXDMA_HWAttrsV1 const  *hwAttrs = handle->hwAttrs;
     uint32_t                      padRegister;
 
+    I2SCC32XXDMA_stopStream(handle);
+
     /* Disable I2S and interrupts. */
     MAP_I2SDisable(hwAttrs->baseAddr);
 
@@ -419,7 +574,10 @@ void I2SCC32XXDMA_close(I2S_Handle handle)
         SemaphoreP_delete(object->readSem);
     }
     if (object->dmaHandle != NULL) {
+        UDMACC32XX_freeChannel(object->dmaHandle, hwAttrs->rxChannelIndex);
+        UDMACC32XX_freeChannel(object->dmaHandle, hwAttrs->txChannelIndex);
         UDMACC32XX_close(object->dmaHandle);
+        object->dmaHandle = NULL;
     }
 
     Power_releaseConstraint(PowerCC32XX_DISALLOW_LPDS);
@@ -482,6 +640,7 @@ void I2SCC32XXDMA_init(I2S_Handle handle)
     I2SCC32XXDMA_Object *object = handle->object;
 
     object->opened = false;
+    object->isStreaming = false;
 
     UDMACC32XX_init();
 }
@@ -499,6 +658,8 @@ I2S_Handle I2SCC32XXDMA_open(I2S_Handle handle, I2S_Params *params)
     I2SCC32XXDMA_SerialPinParams *cc3200CustomParams;
     SemaphoreP_Params             semParams;
     HwiP_Params                   hwiParams;
+    UDMACC32XX_Handle             dmaHandle;
+    uint32_t                      dmaChannels[2];
     int                           i;
     uint32_t                      pin;
     uint32_t                      mode;
@@ -538,6 +699,9 @@ I2S_Handle I2SCC32XXDMA_open(I2S_Handle handle, I2S_Params *params)
     object->dmaHandle = NULL;
     object->currentWriteBufDesc = NULL;
     object->currentReadBufDesc = NULL;
+    object->prevWriteBufDesc = NULL;
+    object->prevReadBufDesc = NULL;
+    object->isStreaming = false;
 
     object->emptyReadBufLength = sizeof(I2SCC32XXDMA_emptyBuffer);
     object->zeroWriteBufLength = sizeof(I2SCC32XXDMA_zeroBuffer);
@@ -627,12 +791,30 @@ I2S_Handle I2SCC32XXDMA_open(I2S_Handle handle, I2S_Params *params)
         return (NULL);
     }
 
-    object->dmaHandle = UDMACC32XX_open();
-    if (object->dmaHandle == NULL) {
+    dmaHandle = UDMACC32XX_open();
+    if (dmaHandle == NULL) {
         I2SCC32XXDMA_close(handle);
         return (NULL);
     }
 
+    /* Reserve the channels so that UDMACC32XX_allocChannel() users skip them */
+    dmaChannels[0] = hwAttrs->rxChannelIndex;
+    dmaChannels[1] = hwAttrs->txChannelIndex;
+    if (UDMACC32XX_allocChannel(dmaHandle, &dmaChannels[0], 1,
+            UDMACC32XX_PRIORITY_DEFAULT) == UDMACC32XX_CHANNEL_NONE) {
+        UDMACC32XX_close(dmaHandle);
+        I2SCC32XXDMA_close(handle);
+        return (NULL);
+    }
+    if (UDMACC32XX_allocChannel(dmaHandle, &dmaChannels[1], 1,
+            UDMACC32XX_PRIORITY_DEFAULT) == UDMACC32XX_CHANNEL_NONE) {
+        UDMACC32XX_freeChannel(dmaHandle, dmaChannels[0]);
+        UDMACC32XX_close(dmaHandle);
+        I2SCC32XXDMA_close(handle);
+        return (NULL);
+    }
+    object->dmaHandle = dmaHandle;
+
     MAP_I2SIntEnable(hwAttrs->baseAddr,I2S_INT_XDMA | I2S_INT_RDMA);
 
     if (params->operationMode == I2S_OPMODE_TX_ONLY) {
@@ -715,14 +897,7 @@ I2S_Handle I2SCC32XXDMA_open(I2S_Handle handle, I2S_Params *params)
     MAP_I2SConfigSetExpClk(hwAttrs->baseAddr,bitClock,bitClock,slotConfig |
                                       I2S_PORT_DMA);
 
-    MAP_uDMAChannelAssign(hwAttrs->rxChannelIndex);
-    MAP_uDMAChannelAttributeDisable(hwAttrs->rxChannelIndex,
-                                     UDMA_ATTR_ALTSELECT);
-
-    MAP_uDMAChannelAssign(hwAttrs->txChannelIndex);
-    MAP_uDMAChannelAttributeDisable(hwAttrs->txChannelIndex,
-                                     UDMA_ATTR_ALTSELECT);
-
+    Power_setConstraint(PowerCC32XX_DISALLOW_LPDS);
 
     /* Configure the DMA with zero/empty buffers */
     if (params->operationMode == I2S_OPMODE_TX_ONLY){
@@ -825,3 +1000,167 @@ size_t I2SCC32XXDMA_writeReclaim(I2S_Handle handle, I2S_BufDesc **desc)
     }
     return (size);
 }
+
+/*
+ *  ======== I2SCC32XXDMA_StreamParams_init ========
+ */
+void I2SCC32XXDMA_StreamParams_init(I2SCC32XXDMA_StreamParams *params)
+{
+    DebugP_assert(params != NULL);
+
+    params->rxBuffer = NULL;
+    params->txBuffer = NULL;
+    params->blockSize = 0;
+    params->numBlocks = 4;
+    params->callbackFxn = NULL;
+}
+
+/*
+ *  ======== I2SCC32XXDMA_startStream ========
+ */
+int_fast16_t I2SCC32XXDMA_startStream(I2S_Handle handle,
+    I2SCC32XXDMA_StreamParams *params)
+{
+    I2SCC32XXDMA_Object          *object = handle->object;
+    I2SCC32XXDMA_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
+    uintptr_t                     key;
+    size_t                        slotSize;
+    bool                          streamRx;
+
+    slotSize = (object->dmaSize == I2SCC32XXDMA_16bit) ? 2 : 4;
+    streamRx = (object->operationMode == I2S_MODE_TX_RX_SYNC) &&
+        (object->readIndex != I2SCC32XXDMA_INDEX_INVALID);
+
+    if (params->txBuffer == NULL || params->callbackFxn == NULL ||
+        (streamRx && params->rxBuffer == NULL) ||
+        params->numBlocks < 4 ||
+        params->numBlocks > I2SCC32XXDMA_STREAM_MAX_BLOCKS ||
+        params->blockSize == 0 || (params->blockSize % slotSize) != 0 ||
+        params->blockSize / slotSize > 1024) {
+        return (I2S_STATUS_ERROR);
+    }
+
+    key = HwiP_disable();
+    if (object->isStreaming) {
+        HwiP_restore(key);
+        return (I2SCC32XXDMA_STATUS_STREAMING);
+    }
+
+    /* Stop the issue/reclaim transfers */
+    MAP_I2SDisable(hwAttrs->baseAddr);
+    MAP_uDMAChannelDisable(hwAttrs->txChannelIndex);
+    MAP_uDMAChannelDisable(hwAttrs->rxChannelIndex);
+    MAP_I2SIntClear(hwAttrs->baseAddr, I2S_STS_XDMA | I2S_STS_RDMA);
+
+    object->isStreaming = true;
+    object->streamRx = streamRx;
+    object->rxRing = params->rxBuffer;
+    object->txRing = params->txBuffer;
+    object->blockSize = params->blockSize;
+    object->numBlocks = params->numBlocks;
+    object->streamCallback = params->callbackFxn;
+    object->rxNext = 0;
+    object->txNext = 0;
+    object->rxSlot = 0;
+    object->txSlot = 0;
+    object->pending = 0;
+    memset(&object->streamStats, 0, sizeof(object->streamStats));
+    HwiP_restore(key);
+
+    /* Arm both channels before enabling the I2S so they start together */
+    I2SCC32XXDMA_streamArm(handle, true, 0, 0);
+    I2SCC32XXDMA_streamArm(handle, true, 1, 1);
+    MAP_uDMAChannelAttributeDisable(hwAttrs->txChannelIndex,
+                                     UDMA_ATTR_ALTSELECT);
+    MAP_uDMAChannelEnable(hwAttrs->txChannelIndex);
+
+    if (streamRx) {
+        I2SCC32XXDMA_streamArm(handle, false, 0, 0);
+        I2SCC32XXDMA_streamArm(handle, false, 1, 1);
+        MAP_uDMAChannelAttributeDisable(hwAttrs->rxChannelIndex,
+                                         UDMA_ATTR_ALTSELECT);
+        MAP_uDMAChannelEnable(hwAttrs->rxChannelIndex);
+    }
+
+    MAP_I2SEnable(hwAttrs->baseAddr, object->operationMode);
+
+    DebugP_log3("I2S:(%p) stream started, %d blocks of %d bytes",
+        hwAttrs->baseAddr, params->numBlocks, params->blockSize);
+
+    return (I2S_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== I2SCC32XXDMA_releaseStreamBlock ========
+ */
+void I2SCC32XXDMA_releaseStreamBlock(I2S_Handle handle)
+{
+    I2SCC32XXDMA_Object *object = handle->object;
+    uintptr_t            key;
+
+    key = HwiP_disable();
+    if (object->pending > 0) {
+        object->pending--;
+    }
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== I2SCC32XXDMA_stopStream ========
+ */
+void I2SCC32XXDMA_stopStream(I2S_Handle handle)
+{
+    I2SCC32XXDMA_Object          *object = handle->object;
+    I2SCC32XXDMA_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
+    uintptr_t                     key;
+
+    key = HwiP_disable();
+    if (!object->isStreaming) {
+        HwiP_restore(key);
+        return;
+    }
+
+    MAP_I2SDisable(hwAttrs->baseAddr);
+    MAP_uDMAChannelDisable(hwAttrs->txChannelIndex);
+    MAP_uDMAChannelDisable(hwAttrs->rxChannelIndex);
+    MAP_I2SIntClear(hwAttrs->baseAddr, I2S_STS_XDMA | I2S_STS_RDMA);
+
+    object->isStreaming = false;
+    object->currentWriteBufDesc = NULL;
+    object->currentReadBufDesc = NULL;
+    object->prevWriteBufDesc = NULL;
+    object->prevReadBufDesc = NULL;
+    HwiP_restore(key);
+
+    /* Resume with the zero/empty buffers as I2SCC32XXDMA_open() does */
+    MAP_uDMAChannelAttributeDisable(hwAttrs->rxChannelIndex,
+                                     UDMA_ATTR_ALTSELECT);
+    MAP_uDMAChannelAttributeDisable(hwAttrs->txChannelIndex,
+                                     UDMA_ATTR_ALTSELECT);
+    if (object->operationMode == I2S_MODE_TX_ONLY) {
+        I2SCC32XXDMA_configDMA(handle, &I2SCC32XXDMA_zeroBufDesc, true);
+    }
+    else {
+        I2SCC32XXDMA_configDMA(handle, &I2SCC32XXDMA_emptyBufDesc, false);
+    }
+
+    MAP_I2SEnable(hwAttrs->baseAddr, object->operationMode);
+
+    DebugP_log3("I2S:(%p) stream stopped, %d underruns, %d overruns",
+        hwAttrs->baseAddr, object->streamStats.underruns,
+        object->streamStats.overruns);
+}
+
+/*
+ *  ======== I2SCC32XXDMA_getStreamStats ========
+ */
+void I2SCC32XXDMA_getStreamStats(I2S_Handle handle,
+    I2SCC32XXDMA_StreamStats *stats)
+{
+    I2SCC32XXDMA_Object *object = handle->object;
+    uintptr_t            key;
+
+    key = HwiP_disable();
+    *stats = object->streamStats;
+    HwiP_restore(key);
+}
@@ -42,6 +42,50 @@
  *
  *  Refer to @ref I2S.h for a complete description of APIs & example of use.
  *
+ *  # Streaming #
+ *
+ *  In issue/reclaim and callback mode every buffer makes a round trip
+ *  through the driver's queues and the uDMA is reprogrammed per buffer.
+ *  For low, constant latency audio I2SCC32XXDMA_startStream() instead
+ *  runs the receive and transmit uDMA channels over two fixed rings of
+ *  numBlocks blocks each, re-arming them in ping-pong from the interrupt
+ *  without waiting for the application.
+ *
+ *  Both rings advance in lockstep off the same frame clock. Each block
+ *  period the stream callback is called from interrupt context with the
+ *  receive block just filled and the transmit block to fill. That transmit
+ *  block starts playing two block periods later, so the delay from capture
+ *  to playback is a fixed three blocks, which is what an echo canceller
+ *  needs to know. Once the application has consumed the receive block and
+ *  filled the transmit block, either in the callback or in a task it
+ *  signals, it calls I2SCC32XXDMA_releaseStreamBlock(). Blocks are released
+ *  in the order they were handed out.
+ *
+ *  A block not released by the next period is sent as it is and counted as
+ *  an underrun; if the application falls numBlocks - 2 blocks behind, the
+ *  oldest receive block it holds is overwritten and counted as an overrun.
+ *  I2SCC32XXDMA_getStreamStats() returns the counts.
+ *
+ *  @code
+ *  static int16_t rxRing[4][64];
+ *  static int16_t txRing[4][64];
+ *
+ *  I2SCC32XXDMA_StreamParams params;
+ *
+ *  I2SCC32XXDMA_StreamParams_init(&params);
+ *  params.rxBuffer = rxRing;
+ *  params.txBuffer = txRing;
+ *  params.blockSize = sizeof(rxRing[0]);
+ *  params.numBlocks = 4;
+ *  params.callbackFxn = blockReady;
+ *  I2SCC32XXDMA_startStream(i2sHandle, &params);
+ *  @endcode
+ *
+ *  The CC32XX McASP always runs its transmit channel, so a transmit ring
+ *  is required even if no serializer transmits. Buffers issued with
+ *  I2S_readIssue() or I2S_writeIssue() should be reclaimed before a stream
+ *  is started; I2SCC32XXDMA_stopStream() resumes issue/reclaim operation.
+ *
  *  ============================================================================
  */
 
@@ -102,6 +146,13 @@ extern "C" {
 
 /* Add I2SCC32XXDMA_STATUS_* macros here */
 
+/*!
+ * @brief   A stream is running
+ *
+ * I2SCC32XXDMA_startStream() returns this if a stream is already running.
+ */
+#define I2SCC32XXDMA_STATUS_STREAMING   (I2S_STATUS_RESERVED - 0)
+
 /** @}*/
 
 /**
@@ -144,9 +195,60 @@ typedef enum I2SCC32XXDMA_DataSize {
 } I2SCC32XXDMA_DataSize;
 
 
+/*!
+ *  @brief  Maximum number of blocks in a stream ring
+ */
+#define I2SCC32XXDMA_STREAM_MAX_BLOCKS  (16)
+
 /* I2S function table pointer */
 extern const I2S_FxnTable I2SCC32XXDMA_fxnTable;
 
+/*!
+ *  @brief  Stream callback function
+ *
+ *  Called from interrupt context once per block period.
+ *
+ *  @param  handle   I2S_Handle of the stream
+ *  @param  rxBlock  The receive block just filled, or NULL if the stream
+ *                   does not receive
+ *  @param  txBlock  The transmit block to fill; it starts playing two
+ *                   block periods from now
+ */
+typedef void (*I2SCC32XXDMA_StreamCallbackFxn)(I2S_Handle handle,
+    void *rxBlock, void *txBlock);
+
+/*!
+ *  @brief  I2SCC32XXDMA stream parameters
+ *
+ *  @sa I2SCC32XXDMA_StreamParams_init()
+ */
+typedef struct I2SCC32XXDMA_StreamParams {
+    /*! Receive ring of numBlocks * blockSize bytes, or NULL to stream
+     *  transmit only */
+    void                          *rxBuffer;
+    /*! Transmit ring of numBlocks * blockSize bytes */
+    void                          *txBuffer;
+    /*! Bytes per block, a multiple of the slot size and at most 1024
+     *  slots */
+    size_t                         blockSize;
+    /*! Blocks per ring, 4 to ::I2SCC32XXDMA_STREAM_MAX_BLOCKS */
+    uint_fast8_t                   numBlocks;
+    /*! Called every block period */
+    I2SCC32XXDMA_StreamCallbackFxn callbackFxn;
+} I2SCC32XXDMA_StreamParams;
+
+/*!
+ *  @brief  I2SCC32XXDMA stream statistics
+ *
+ *  @sa I2SCC32XXDMA_getStreamStats()
+ */
+typedef struct I2SCC32XXDMA_StreamStats {
+    uint32_t blocks;     /*!< Block periods handed to the callback */
+    uint32_t underruns;  /*!< Transmit blocks sent before being released */
+    uint32_t overruns;   /*!< Receive blocks overwritten before release */
+    uint32_t dmaStalls;  /*!< Times the uDMA ran out of armed blocks */
+} I2SCC32XXDMA_StreamStats;
+
 
 /*!
  *  @brief      I2SCC32XXDMA Hardware attributes
@@ -297,6 +399,21 @@ typedef struct I2SCC32XXDMA_Object {
     List_List             readDoneQueue;
     List_List             writeActiveQueue;
     List_List             writeDoneQueue;
+
+    /* Stream state */
+    bool                  isStreaming;
+    bool                  streamRx;        /* Stream receives as well */
+    uint8_t              *rxRing;
+    uint8_t              *txRing;
+    size_t                blockSize;
+    uint_fast8_t          numBlocks;
+    uint_fast8_t          rxNext;          /* Block the RX uDMA ends next */
+    uint_fast8_t          txNext;          /* Block the TX uDMA ends next */
+    uint_fast8_t          rxSlot;          /* Control structure of rxNext */
+    uint_fast8_t          txSlot;          /* Control structure of txNext */
+    uint_fast8_t          pending;         /* Blocks handed out, unreleased */
+    I2SCC32XXDMA_StreamCallbackFxn streamCallback;
+    I2SCC32XXDMA_StreamStats       streamStats;
 } I2SCC32XXDMA_Object, *I2SCC32XXDMA_Handle;
 
 /*!
@@ -314,6 +431,65 @@ typedef struct I2SCC32XXDMA_Object {
  */
 extern void I2SCC32XXDMA_Params_init(I2SCC32XXDMA_SerialPinParams *params);
 
+/*!
+ *  @brief  Initialize stream parameters to default values: no rings,
+ *          blockSize 0, numBlocks 4 and no callback.
+ *
+ *  @param  params  Pointer to the stream parameters
+ */
+extern void I2SCC32XXDMA_StreamParams_init(I2SCC32XXDMA_StreamParams *params);
+
+/*!
+ *  @brief  Start streaming through fixed receive and transmit rings
+ *
+ *  The rings are armed from their first block; the transmit ring should
+ *  hold silence or the first output. The stream statistics are cleared.
+ *
+ *  @pre    I2S_open() has been called on the handle.
+ *
+ *  @param  handle  I2S_Handle
+ *  @param  params  Stream parameters; rxBuffer must be given if a
+ *                  serializer receives and the I2S was opened with
+ *                  I2S_OPMODE_TX_RX_SYNC
+ *
+ *  @return I2S_STATUS_SUCCESS if the stream was started,
+ *          I2SCC32XXDMA_STATUS_STREAMING if one is running already, or
+ *          I2S_STATUS_ERROR if the parameters are invalid.
+ *
+ *  @sa I2SCC32XXDMA_stopStream()
+ */
+extern int_fast16_t I2SCC32XXDMA_startStream(I2S_Handle handle,
+    I2SCC32XXDMA_StreamParams *params);
+
+/*!
+ *  @brief  Hand the oldest block handed to the stream callback back to the
+ *          driver
+ *
+ *  May be called from the stream callback or from a task.
+ *
+ *  @param  handle  I2S_Handle
+ */
+extern void I2SCC32XXDMA_releaseStreamBlock(I2S_Handle handle);
+
+/*!
+ *  @brief  Stop a stream and resume issue/reclaim operation
+ *
+ *  No stream callback is called after this function returns. I2S_close()
+ *  stops the stream too.
+ *
+ *  @param  handle  I2S_Handle
+ */
+extern void I2SCC32XXDMA_stopStream(I2S_Handle handle);
+
+/*!
+ *  @brief  Read the statistics of the current or last stream
+ *
+ *  @param  handle  I2S_Handle
+ *  @param  stats   Filled in with the statistics
+ */
+extern void I2SCC32XXDMA_getStreamStats(I2S_Handle handle,
+    I2SCC32XXDMA_StreamStats *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -51,7 +51,12 @@ extern "C" {
 
 typedef signed int _SlFd_t;
 
+/* slcb_GetTimestamp() returns ClockP ticks, which are Zephyr kernel ticks */
+#if defined(CONFIG_SYS_CLOCK_TICKS_PER_SEC) && (CONFIG_SYS_CLOCK_TICKS_PER_SEC >= 100)
+#define SL_TIMESTAMP_TICKS_IN_10_MILLISECONDS     (_u32)(CONFIG_SYS_CLOCK_TICKS_PER_SEC / 100)
+#else
 #define SL_TIMESTAMP_TICKS_IN_10_MILLISECONDS     (_u32)(10)
+#endif
 #define SL_TIMESTAMP_MAX_VALUE                    (_u32)(0xFFFFFFFF)
 
 /*!
@@ -1104,7 +1109,8 @@ extern int dpl_set_errno(int err);
     \note       belongs to \ref configuration_sec
     \warning
 */
-#define sl_SyncObjWait(pSyncObj,Timeout)            SemaphoreP_pend((*(pSyncObj)),Timeout)
+extern int dpl_SyncObjWait(SemaphoreP_Handle handle, uint32_t timeout);
+#define sl_SyncObjWait(pSyncObj,Timeout)            dpl_SyncObjWait((*(pSyncObj)),Timeout)
 
 
 
@@ -53,6 +53,7 @@
 /* Instruction codes */
 #define SPIFLASH_WRITE              0x02 /**< Page Program */
 #define SPIFLASH_READ               0x03 /**< Read Data */
+#define SPIFLASH_FAST_READ          0x0B /**< Read Data at higher speed */
 #define SPIFLASH_READ_STATUS        0x05 /**< Read Status Register */
 #define SPIFLASH_WRITE_ENABLE       0x06 /**< Write Enable */
 #define SPIFLASH_SUBSECTOR_ERASE    0x20 /**< SubSector (4K Byte) Erase */
@@ -68,6 +69,15 @@
 /* Write page size assumed by this driver */
 #define SPIFLASH_PROGRAM_PAGE_SIZE  256
 
+/* Instruction byte followed by a 24 bit address */
+#define SPIFLASH_CMD_ADDR_SIZE      4
+
+/* Dummy byte clocked between the address and data of a fast read */
+#define SPIFLASH_FAST_READ_DUMMY    1
+
+/* First status poll delay when backing off towards statusPollDelayUs */
+#define STATUS_POLL_BACKOFF_MIN_US  8
+
 /* Highest supported SPI instance index */
 #define MAX_SPI_INDEX               3
 
@@ -84,6 +94,8 @@ static int_fast16_t doWriteVerify(NVS_Handle handle, size_t offset,
 
 static int_fast16_t extFlashSpiWrite(const uint8_t *buf, size_t len);
 static int_fast16_t extFlashSpiRead(uint8_t *buf, size_t len);
+static int_fast16_t extFlashSpiTransfer(const uint8_t *txBuf, uint8_t *rxBuf,
+                        size_t len);
 static int_fast16_t extFlashPowerDown(NVS_Handle nvsHandle);
 static int_fast16_t extFlashPowerStandby(NVS_Handle nvsHandle);
 static int_fast16_t extFlashWaitReady(NVS_Handle nvsHandle);
@@ -123,6 +135,12 @@ static uint32_t spiCsnGpioIndex;
  */
 static SemaphoreP_Handle  writeSem;
 
+/*
+ *  Page program frame (instruction, address and data) sent to the flash in
+ *  a single SPI transfer. Protected by writeSem.
+ */
+static uint8_t programBuf[SPIFLASH_CMD_ADDR_SIZE + SPIFLASH_PROGRAM_PAGE_SIZE];
+
 /*
  *  ======== NVSSPI25X_close ========
  */
@@ -414,7 +432,6 @@ int_fast16_t NVSSPI25X_write(NVS_Handle handle, size_t offset, void *buffer,
     uint32_t status = true;
     uint8_t *srcBuf;
     int retval = NVS_STATUS_SUCCESS;
-    uint8_t wbuf[4];
 
     hwAttrs = handle->hwAttrs;
     object = handle->object;
@@ -466,9 +483,30 @@ int_fast16_t NVSSPI25X_write(NVS_Handle handle, size_t offset, void *buffer,
     while (length > 0)
     {
         size_t ilen; /* Interim length per instruction */
+        int ret;
+
+        ilen = SPIFLASH_PROGRAM_PAGE_SIZE - (foffset % SPIFLASH_PROGRAM_PAGE_SIZE);
+        if (length < ilen) {
+            ilen = length;
+        }
+
+        /*
+         * Build the whole page program frame while the flash is still
+         * busy programming the previous page, so that the page can be
+         * sent in one (DMA) transfer as soon as the part is ready.
+         */
+        programBuf[0] = SPIFLASH_WRITE;
+        programBuf[1] = (foffset >> 16) & 0xff;
+        programBuf[2] = (foffset >> 8) & 0xff;
+        programBuf[3] = foffset & 0xff;
+        memcpy(&programBuf[SPIFLASH_CMD_ADDR_SIZE], srcBuf, ilen);
+
+        foffset += ilen;
+        length -= ilen;
+        srcBuf += ilen;
 
         /* Wait till previous erase/program operation completes */
-        int ret = extFlashWaitReady(handle);
+        ret = extFlashWaitReady(handle);
 
         if (ret) {
             status = false;
@@ -482,19 +520,6 @@ int_fast16_t NVSSPI25X_write(NVS_Handle handle, size_t offset, void *buffer,
             break;
         }
 
-        ilen = SPIFLASH_PROGRAM_PAGE_SIZE - (foffset % SPIFLASH_PROGRAM_PAGE_SIZE);
-        if (length < ilen) {
-            ilen = length;
-        }
-
-        wbuf[0] = SPIFLASH_WRITE;
-        wbuf[1] = (foffset >> 16) & 0xff;
-        wbuf[2] = (foffset >> 8) & 0xff;
-        wbuf[3] = foffset & 0xff;
-
-        foffset += ilen;
-        length -= ilen;
-
         /*
          * Up to 100ns CS hold time (which is not clear
          * whether it's application only in between reads)
@@ -504,18 +529,14 @@ int_fast16_t NVSSPI25X_write(NVS_Handle handle, size_t offset, void *buffer,
          */
         NVSSPI25X_assertSpiCs(handle, spiCsnGpioIndex);
 
-        if (extFlashSpiWrite(wbuf, sizeof(wbuf)) != NVS_STATUS_SUCCESS) {
-            status = false;
-            break;
-        }
+        ret = extFlashSpiWrite(programBuf, SPIFLASH_CMD_ADDR_SIZE + ilen);
 
-        if (extFlashSpiWrite(srcBuf, ilen) != NVS_STATUS_SUCCESS) {
+        NVSSPI25X_deassertSpiCs(handle, spiCsnGpioIndex);
+
+        if (ret != NVS_STATUS_SUCCESS) {
             status = false;
             break;
         }
-
-        srcBuf += ilen;
-        NVSSPI25X_deassertSpiCs(handle, spiCsnGpioIndex);
     }
 
     if (status == false) {
@@ -686,7 +707,7 @@ static int_fast16_t doRead(NVS_Handle handle, size_t offset, void *buffer,
     NVSSPI25X_Object *object;
     NVSSPI25X_HWAttrs const *hwAttrs;
     size_t loffset;
-    uint8_t wbuf[4];
+    uint8_t wbuf[SPIFLASH_CMD_ADDR_SIZE + SPIFLASH_FAST_READ_DUMMY];
     int retval = NVS_STATUS_SUCCESS;
 
     hwAttrs = handle->hwAttrs;
@@ -705,14 +726,15 @@ static int_fast16_t doRead(NVS_Handle handle, size_t offset, void *buffer,
     }
 
     /*
-     * SPI is driven with very low frequency (1MHz < 33MHz fR spec)
-     * in this temporary implementation.
-     * and hence it is not necessary to use fast read.
+     * Fast read is valid up to the device's maximum SPI clock, whereas
+     * plain read is limited to a lower frequency (typically 33-50MHz).
+     * The cost is a single dummy byte after the address.
      */
-    wbuf[0] = SPIFLASH_READ;
+    wbuf[0] = SPIFLASH_FAST_READ;
     wbuf[1] = (loffset >> 16) & 0xff;
     wbuf[2] = (loffset >> 8) & 0xff;
     wbuf[3] = loffset & 0xff;
+    wbuf[4] = 0xff;
 
     NVSSPI25X_assertSpiCs(handle, spiCsnGpioIndex);
 
@@ -721,6 +743,10 @@ static int_fast16_t doRead(NVS_Handle handle, size_t offset, void *buffer,
         return (NVS_STATUS_ERROR);
     }
 
+    /*
+     * Read the data in a single transfer so the SPI driver can move it with
+     * DMA (subject to the SPI instance's minDmaTransferSize).
+     */
     retval = extFlashSpiRead(buffer, bufferSize);
 
     NVSSPI25X_deassertSpiCs(handle, spiCsnGpioIndex);
@@ -796,33 +822,45 @@ static int_fast16_t extFlashMassErase(NVS_Handle nvsHandle)
 /*
  *  ======== extFlashWaitReady =======
  *  Wait for any previous job to complete.
+ *
+ *  The first status read is done immediately. While the part stays busy
+ *  the delay between reads doubles, starting at STATUS_POLL_BACKOFF_MIN_US,
+ *  up to statusPollDelayUs. Short operations (page program) are thus
+ *  detected with little latency while long ones (erase) are polled rarely.
  */
 static int_fast16_t extFlashWaitReady(NVS_Handle nvsHandle)
 {
-    const uint8_t wbuf[1] = { SPIFLASH_READ_STATUS };
+    const uint8_t wbuf[2] = { SPIFLASH_READ_STATUS, 0xff };
+    uint8_t rbuf[2];
+    uint32_t delayUs = STATUS_POLL_BACKOFF_MIN_US;
     int_fast16_t ret;
-    uint8_t buf;
 
     NVSSPI25X_HWAttrs const *hwAttrs;
     hwAttrs = nvsHandle->hwAttrs;
 
     for (;;) {
+        /* Instruction and status byte in one full-duplex transfer */
         NVSSPI25X_assertSpiCs(nvsHandle, spiCsnGpioIndex);
-        extFlashSpiWrite(wbuf, sizeof(wbuf));
-        ret = extFlashSpiRead(&buf,sizeof(buf));
+        ret = extFlashSpiTransfer(wbuf, rbuf, sizeof(wbuf));
         NVSSPI25X_deassertSpiCs(nvsHandle, spiCsnGpioIndex);
 
         if (ret != NVS_STATUS_SUCCESS) {
             /* Error */
             return (ret);
         }
-        if (!(buf & SPIFLASH_STATUS_BIT_BUSY)) {
+        if (!(rbuf[1] & SPIFLASH_STATUS_BIT_BUSY)) {
             /* Now ready */
             break;
         }
         if (hwAttrs->statusPollDelayUs){
+            if (delayUs > hwAttrs->statusPollDelayUs) {
+                delayUs = hwAttrs->statusPollDelayUs;
+            }
+
             /* Sleep to avoid excessive polling and starvation */
-            ClockP_usleep(hwAttrs->statusPollDelayUs);
+            ClockP_usleep(delayUs);
+
+            delayUs <<= 1;
         }
     }
 
@@ -912,6 +950,21 @@ static int_fast16_t extFlashSpiRead(uint8_t *buf, size_t len)
     return (SPI_transfer(spiHandle, &masterTransaction) ? NVS_STATUS_SUCCESS : NVS_STATUS_ERROR);
 }
 
+/*
+ *  ======== extFlashSpiTransfer =======
+ */
+static int_fast16_t extFlashSpiTransfer(const uint8_t *txBuf, uint8_t *rxBuf,
+        size_t len)
+{
+    SPI_Transaction masterTransaction;
+
+    masterTransaction.count = len;
+    masterTransaction.txBuf = (void *)txBuf;
+    masterTransaction.rxBuf = rxBuf;
+
+    return (SPI_transfer(spiHandle, &masterTransaction) ? NVS_STATUS_SUCCESS : NVS_STATUS_ERROR);
+}
+
 /*
  * Below are the default (weak) GPIO-driver based implementations of:
  *     NVSSPI25X_initSpiCs()
@@ -49,7 +49,7 @@
  *
  *  @code
  *  #define SPIFLASH_PAGE_WRITE       0x02 // Page Program (up to 256 bytes)
- *  #define SPIFLASH_READ             0x03 // Read Data
+ *  #define SPIFLASH_FAST_READ        0x0B // Read Data at higher speed
  *  #define SPIFLASH_READ_STATUS      0x05 // Read Status Register
  *  #define SPIFLASH_WRITE_ENABLE     0x06 // Write Enable
  *  #define SPIFLASH_SUBSECTOR_ERASE  0x20 // SubSector (4K bytes) Erase
@@ -67,9 +67,19 @@
  *  The NVS_erase() command will issue a sector or subsector erase command
  *  based on the input size and offset.
  *
+ *  NVS_read() uses the SPIFLASH_FAST_READ command, so the SPI bit rate may be
+ *  set up to the flash device's maximum clock frequency. The data is read in
+ *  a single SPI transfer, which the SPI driver performs with DMA when the
+ *  read is at least the SPI instance's minimum DMA transfer size.
+ *
+ *  NVS_write() sends each page (instruction, address and data) as a single
+ *  SPI transfer and prepares the next page while the previous one is being
+ *  programmed.
+ *
  *  The driver must query the SPI flash to ensure that the part is ready before
  *  commands are issued. If the part responds as busy, the poll function sleeps
- *  for a number of microseconds determined by the
+ *  between status reads; the sleep starts at a few microseconds and doubles
+ *  on every busy response up to the number of microseconds determined by the
  *  #NVSSPI25X_HWAttrs.statusPollDelayUs field. A value of 0 means that the
  *  driver will continuously poll the external flash until it is ready, which
  *  may affect other threads ability to execute.
@@ -311,10 +321,12 @@ typedef struct NVSSPI25X_HWAttrs {
     uint16_t    spiCsnGpioIndex;
     /*! @brief External Flash Status Poll Delay
      *
-     * This field determines how many microseconds the driver waits after
-     * querying the external flash status. Increasing this value can help
-     * mitigate CPU starvation if the external flash is busy for long periods
-     * of time, but may also result in increased latency.
+     * This field determines the maximum number of microseconds the driver
+     * waits after querying the external flash status. The driver backs off
+     * exponentially towards this value while the flash is busy. Increasing
+     * this value can help mitigate CPU starvation if the external flash is
+     * busy for long periods of time, but may also result in increased
+     * latency.
      */
     uint32_t    statusPollDelayUs;
 } NVSSPI25X_HWAttrs;
@@ -45,8 +45,10 @@
 #ifndef DebugP_LOG_ENABLED
 #define DebugP_LOG_ENABLED 0
 #endif
+#include <ti/drivers/dpl/ClockP.h>
 #include <ti/drivers/dpl/DebugP.h>
 #include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/dpl/SwiP.h>
 
 #include <ti/drivers/utils/List.h>
 
@@ -83,6 +85,18 @@
 #define PowerCC32XX_SSPICSDelay                 33
 #define uSEC_DELAY(x)                           (ROM_UtilsDelayDirect(x*80/3))
 
+/* slow clock counter (32768 Hz) ticks to usec: 1000000 / 32768 = 15625 / 512 */
+#define SLOWCLK_TO_USEC(x)                      (((x) * 15625) >> 9)
+
+/*
+ * Set in the eventTypes of a PowerCC32XX_NotifyObj, to tell it apart from
+ * a Power_NotifyObj in the notify list; no PowerCC32XX event uses it.
+ */
+#define NOTIFY_EXTENDED                         0x8000
+
+/* Fraction bits of PowerCC32XX_module.notifyUsecScale */
+#define NOTIFY_USEC_SHIFT                       16
+
 #define SYNCBARRIER() {          \
     __asm(" dsb \n"              \
           " isb \n");            \
@@ -135,6 +149,9 @@ PowerCC32XX_ModuleState PowerCC32XX_module = {
 /* context save variable */
 PowerCC32XX_SaveRegisters PowerCC32XX_contextSave;
 
+/* delivers PowerCC32XX_AWAKE_LPDS to PowerCC32XX_NOTIFY_DEFERRED clients */
+static SwiP_Struct deferredSwi;
+
 typedef void (*LPDSFunc)(void);
 
 /* enter LPDS is an assembly function */
@@ -149,11 +166,19 @@ void PowerCC32XX_shutdownSSPI(void);
 
 /* internal functions */
 static int_fast16_t notify(uint_fast16_t eventType);
+static void insertNotify(Power_NotifyObj *pNotifyObj);
+static uint_least8_t notifyPriority(Power_NotifyObj *pNotifyObj);
+static uint_least8_t notifyFlags(Power_NotifyObj *pNotifyObj);
+static int_fast16_t notifyClient(Power_NotifyObj *pNotifyObj,
+    uint_fast16_t eventType);
+static void notifyDeferred(void);
+static void deferredSwiFxn(uintptr_t arg0, uintptr_t arg1);
 static void restoreNVICRegs(void);
 static void restorePeriphClocks(void);
 static void saveNVICRegs(void);
 static void parkPins(void);
 static void restoreParkedPins(void);
+static void recordLPDS(uint32_t residency, uint32_t wakeCause);
 
 /*
  *  ======== Power_disablePolicy ========
@@ -259,6 +284,9 @@ void Power_idleFunc()
  */
 int_fast16_t Power_init()
 {
+    ClockP_FreqHz freq;
+    uint64_t usecScale;
+
     /* if this function has already been called, just return */
     if (PowerCC32XX_module.initialized) {
         return (Power_SOK);
@@ -301,6 +329,19 @@ int_fast16_t Power_init()
     /* copy the Power policy function to module state */
     PowerCC32XX_module.policyFxn = PowerCC32XX_config.policyFxn;
 
+    /*
+     * usec per timestamp tick, used to time notification functions. It
+     * saturates for timestamps slower than about 16 kHz.
+     */
+    ClockP_getTimestampFreq(&freq);
+    usecScale = ((uint64_t)1000000 << NOTIFY_USEC_SHIFT) /
+        ((freq.lo != 0) ? freq.lo : 1);
+    PowerCC32XX_module.notifyUsecScale = (usecScale > UINT32_MAX) ?
+        UINT32_MAX : (uint32_t) usecScale;
+
+    /* construct the SwiP for deferred wake notifications */
+    SwiP_construct(&deferredSwi, deferredSwiFxn, NULL);
+
     /* spin if too many pins were specified in the pin park array */
     if (PowerCC32XX_config.numPins > PowerCC32XX_NUMPINS) {
         while(1){}
@@ -331,12 +372,11 @@ int_fast16_t Power_registerNotify(Power_NotifyObj * pNotifyObj,
 
     else {
         /* fill in notify object elements */
-        pNotifyObj->eventTypes = eventTypes;
+        pNotifyObj->eventTypes = eventTypes & ~NOTIFY_EXTENDED;
         pNotifyObj->notifyFxn = notifyFxn;
         pNotifyObj->clientArg = clientArg;
 
-        /* place notify object on event notification queue */
-        List_put(&PowerCC32XX_module.notifyList, (List_Elem*)pNotifyObj);
+        insertNotify(pNotifyObj);
     }
 
     DebugP_log3(
@@ -647,6 +687,9 @@ int_fast16_t Power_sleep(uint_fast16_t sleepState)
     uint32_t preEvent;
     uint32_t postEvent;
     uint32_t semBits;
+    uint32_t wakeCause;
+    uint64_t sleepStart;
+    uint64_t residency;
     bool earlyPG = true;
 
     /* first validate the sleep state */
@@ -656,9 +699,18 @@ int_fast16_t Power_sleep(uint_fast16_t sleepState)
 
     else if (PowerCC32XX_module.state == Power_ACTIVE) {
 
+        /* finish a previous wake before starting the next sleep */
+        if (PowerCC32XX_module.deferredPending) {
+            PowerCC32XX_module.deferredPending = false;
+            notifyDeferred();
+        }
+
         /* set transition state to entering sleep */
         PowerCC32XX_module.state = Power_ENTERING_SLEEP;
 
+        /* residency is measured on the slow clock, which runs through LPDS */
+        sleepStart = MAP_PRCMSlowClkCtrGet();
+
         /* setup sleep vars */
         preEvent = PowerCC32XX_ENTERING_LPDS;
         postEvent = PowerCC32XX_AWAKE_LPDS;
@@ -761,8 +813,14 @@ int_fast16_t Power_sleep(uint_fast16_t sleepState)
             restoreParkedPins();
         }
 
+        /* account for the full round trip, for the LPDS governor */
+        wakeCause = MAP_PRCMLPDSWakeupCauseGet();
+        residency = SLOWCLK_TO_USEC(MAP_PRCMSlowClkCtrGet() - sleepStart);
+        recordLPDS((residency > UINT32_MAX) ? UINT32_MAX :
+            (uint32_t) residency, wakeCause);
+
         /* if wake source was GPIO, optionally call wakeup function */
-        if (MAP_PRCMLPDSWakeupCauseGet() == PRCM_LPDS_GPIO) {
+        if (wakeCause == PRCM_LPDS_GPIO) {
             if (PowerCC32XX_module.wakeupConfig.wakeupGPIOFxnLPDS != NULL) {
                 (*(PowerCC32XX_module.wakeupConfig.wakeupGPIOFxnLPDS))
                   (PowerCC32XX_module.wakeupConfig.wakeupGPIOFxnLPDSArg);
@@ -771,6 +829,11 @@ int_fast16_t Power_sleep(uint_fast16_t sleepState)
 
         /* now clear the transition state before re-enabling scheduler */
         PowerCC32XX_module.state = Power_ACTIVE;
+
+        /* slow restores run once the woken thread has been released */
+        if (PowerCC32XX_module.deferredPending) {
+            SwiP_post((SwiP_Handle) &deferredSwi);
+        }
     }
     else {
         status = Power_EBUSY;
@@ -906,6 +969,42 @@ void PowerCC32XX_getWakeup(PowerCC32XX_Wakeup *wakeup)
     *wakeup = PowerCC32XX_module.wakeupConfig;
 }
 
+/*
+ *  ======== PowerCC32XX_getNotifyLatency ========
+ *  Get a snapshot of a client's notification latency histogram
+ */
+uint_fast16_t PowerCC32XX_getNotifyLatency(PowerCC32XX_NotifyObj *pNotifyObj,
+    uint16_t *counts)
+{
+    uint_fast16_t latencyMax;
+    uintptr_t key;
+    uint32_t i;
+
+    key = HwiP_disable();
+
+    for (i = 0; i < PowerCC32XX_NOTIFY_LATENCY_BINS; i++) {
+        counts[i] = pNotifyObj->latencyCounts[i];
+    }
+    latencyMax = pNotifyObj->latencyMax;
+
+    HwiP_restore(key);
+
+    return (latencyMax);
+}
+
+/*
+ *  ======== PowerCC32XX_getStats ========
+ *  Get a snapshot of the LPDS residency and wake reason statistics
+ */
+void PowerCC32XX_getStats(PowerCC32XX_Stats *stats)
+{
+    uintptr_t key;
+
+    key = HwiP_disable();
+    *stats = PowerCC32XX_module.stats;
+    HwiP_restore(key);
+}
+
 /*
  *  ======== PowerCC32XX_parkPin ========
  *  Park a device pin in preparation for LPDS
@@ -978,6 +1077,57 @@ void PowerCC32XX_restoreParkState(PowerCC32XX_Pin pin,
     }
 }
 
+/*
+ *  ======== PowerCC32XX_selectLPDS ========
+ *  Predict the coming idle period and decide whether LPDS pays off
+ */
+bool PowerCC32XX_selectLPDS(uint_fast32_t timeUntilWake)
+{
+    PowerCC32XX_Stats *stats = &PowerCC32XX_module.stats;
+    uint32_t predicted = timeUntilWake;
+    uint32_t breakEven;
+    uintptr_t key;
+    bool select = false;
+
+    breakEven = Power_getTransitionLatency(PowerCC32XX_LPDS, Power_TOTAL);
+
+    key = HwiP_disable();
+
+    if (!(PowerCC32XX_module.constraintMask &
+        (1 << PowerCC32XX_DISALLOW_LPDS))) {
+
+        /* recent wakeups may come well before the next timer expiry */
+        if ((stats->predictedIdle != 0) &&
+            (stats->predictedIdle < predicted)) {
+            predicted = stats->predictedIdle;
+        }
+
+        if (predicted >= breakEven) {
+            select = true;
+        }
+        else {
+            stats->lpdsRejectCount++;
+
+            /*
+             * Only LPDS entries update the history, so let a rejected idle
+             * pull a stale short prediction back toward the timer bound;
+             * otherwise one burst of early wakeups would lock LPDS out.
+             */
+            if (timeUntilWake > stats->predictedIdle) {
+                stats->predictedIdle += (timeUntilWake -
+                    stats->predictedIdle) >> PowerCC32XX_IDLE_HISTORY_SHIFT;
+            }
+        }
+    }
+
+    HwiP_restore(key);
+
+    DebugP_log2("Power: selectLPDS, predicted (%d), select (%d)",
+        predicted, select);
+
+    return (select);
+}
+
 /*
  *  ======== PowerCC32XX_setParkState ========
  *  Set a new LPDS park state for a pin
@@ -1097,6 +1247,44 @@ void PowerCC32XX_shutdownSSPI(void)
     return;
 }
 
+/*
+ *  ======== PowerCC32XX_registerNotify ========
+ *  Register a notification function in a dispatch group.
+ */
+int_fast16_t PowerCC32XX_registerNotify(PowerCC32XX_NotifyObj *pNotifyObj,
+    uint_fast16_t eventTypes, Power_NotifyFxn notifyFxn, uintptr_t clientArg,
+    uint_least8_t priority, uint_least8_t flags)
+{
+    int_fast16_t status = Power_SOK;
+    uint32_t i;
+
+    /* check for NULL pointers  */
+    if ((pNotifyObj == NULL) || (notifyFxn == NULL)) {
+        status = Power_EINVALIDPOINTER;
+    }
+
+    else {
+        /* fill in notify object elements */
+        pNotifyObj->notifyObj.eventTypes = eventTypes | NOTIFY_EXTENDED;
+        pNotifyObj->notifyObj.notifyFxn = notifyFxn;
+        pNotifyObj->notifyObj.clientArg = clientArg;
+        pNotifyObj->priority = priority;
+        pNotifyObj->flags = flags;
+        pNotifyObj->latencyMax = 0;
+        for (i = 0; i < PowerCC32XX_NOTIFY_LATENCY_BINS; i++) {
+            pNotifyObj->latencyCounts[i] = 0;
+        }
+
+        insertNotify(&pNotifyObj->notifyObj);
+    }
+
+    DebugP_log3(
+        "Power: register notify (%p), eventTypes (0x%x), notifyFxn (%p)",
+        (uintptr_t) pNotifyObj, eventTypes, (uintptr_t) notifyFxn);
+
+    return (status);
+}
+
 /*
  *  ======== PowerCC32XX_reset ========
  *  Software reset of specific peripheral.
@@ -1130,8 +1318,7 @@ int_fast16_t PowerCC32XX_reset(uint_fast16_t resourceId)
 static int_fast16_t notify(uint_fast16_t eventType)
 {
     int_fast16_t notifyStatus;
-    Power_NotifyFxn notifyFxn;
-    uintptr_t clientArg;
+    Power_NotifyObj *pNotifyObj;
     List_Elem *elem;
 
     /* if queue is empty, return immediately */
@@ -1141,18 +1328,21 @@ static int_fast16_t notify(uint_fast16_t eventType)
 
         /* walk the queue and notify each registered client of the event */
         do {
-            if (((Power_NotifyObj *)elem)->eventTypes & eventType) {
-                /* pull params from notify object */
-                notifyFxn = ((Power_NotifyObj *)elem)->notifyFxn;
-                clientArg = ((Power_NotifyObj *)elem)->clientArg;
-
-                /* call the client's notification function */
-                notifyStatus = (int_fast16_t) (*(Power_NotifyFxn)notifyFxn)(
-                    eventType, 0, clientArg);
-
-                /* if client declared error stop all further notifications */
-                if (notifyStatus != Power_NOTIFYDONE) {
-                    return (Power_EFAIL);
+            pNotifyObj = (Power_NotifyObj *)elem;
+
+            if (pNotifyObj->eventTypes & eventType) {
+                /* leave deferred restores to the SwiP */
+                if ((eventType == PowerCC32XX_AWAKE_LPDS) &&
+                    (notifyFlags(pNotifyObj) & PowerCC32XX_NOTIFY_DEFERRED)) {
+                    PowerCC32XX_module.deferredPending = true;
+                }
+                else {
+                    notifyStatus = notifyClient(pNotifyObj, eventType);
+
+                    /* if client declared error stop further notifications */
+                    if (notifyStatus != Power_NOTIFYDONE) {
+                        return (Power_EFAIL);
+                    }
                 }
             }
 
@@ -1433,3 +1623,208 @@ static void restoreParkedPins(void)
         }
     }
 }
+
+/*
+ *  ======== recordLPDS ========
+ *  Update residency and wake reason statistics, and the idle prediction,
+ *  after a return from LPDS.
+ */
+static void recordLPDS(uint32_t residency, uint32_t wakeCause)
+{
+    PowerCC32XX_Stats *stats = &PowerCC32XX_module.stats;
+
+    stats->lpdsCount++;
+    stats->lpdsTime += residency;
+
+    if (residency < PowerCC32XX_TOTALTIMELPDS) {
+        stats->lpdsShortCount++;
+    }
+
+    if (wakeCause == PRCM_LPDS_HOST_IRQ) {
+        stats->wakeHostIRQCount++;
+    }
+    else if (wakeCause == PRCM_LPDS_GPIO) {
+        stats->wakeGPIOCount++;
+    }
+    else if (wakeCause == PRCM_LPDS_TIMER) {
+        stats->wakeTimerCount++;
+    }
+    else {
+        stats->wakeOtherCount++;
+    }
+
+    /* exponentially weighted average of recent residencies */
+    if (stats->predictedIdle == 0) {
+        stats->predictedIdle = residency;
+    }
+    else if (residency > stats->predictedIdle) {
+        stats->predictedIdle += (residency - stats->predictedIdle) >>
+            PowerCC32XX_IDLE_HISTORY_SHIFT;
+    }
+    else {
+        stats->predictedIdle -= (stats->predictedIdle - residency) >>
+            PowerCC32XX_IDLE_HISTORY_SHIFT;
+    }
+}
+
+/*
+ *  ======== insertNotify ========
+ *  Place a filled in notify object after all clients of the same or lower
+ *  dispatch group.
+ */
+static void insertNotify(Power_NotifyObj *pNotifyObj)
+{
+    uint_least8_t priority = notifyPriority(pNotifyObj);
+    List_Elem *elem;
+    uintptr_t key;
+
+    key = HwiP_disable();
+
+    elem = List_head(&PowerCC32XX_module.notifyList);
+    while ((elem != NULL) &&
+        (notifyPriority((Power_NotifyObj *)elem) <= priority)) {
+        elem = List_next(elem);
+    }
+
+    if (elem == NULL) {
+        List_put(&PowerCC32XX_module.notifyList, (List_Elem *)pNotifyObj);
+    }
+    else {
+        List_insert(&PowerCC32XX_module.notifyList,
+            (List_Elem *)pNotifyObj, elem);
+    }
+
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== notifyPriority ========
+ *  Dispatch group of a client; Power_registerNotify() uses the default.
+ */
+static uint_least8_t notifyPriority(Power_NotifyObj *pNotifyObj)
+{
+    if (pNotifyObj->eventTypes & NOTIFY_EXTENDED) {
+        return (((PowerCC32XX_NotifyObj *)pNotifyObj)->priority);
+    }
+
+    return (PowerCC32XX_NOTIFY_PRIORITY_DEFAULT);
+}
+
+/*
+ *  ======== notifyFlags ========
+ *  Dispatch flags of a client; Power_registerNotify() sets none.
+ */
+static uint_least8_t notifyFlags(Power_NotifyObj *pNotifyObj)
+{
+    if (pNotifyObj->eventTypes & NOTIFY_EXTENDED) {
+        return (((PowerCC32XX_NotifyObj *)pNotifyObj)->flags);
+    }
+
+    return (0);
+}
+
+/*
+ *  ======== notifyClient ========
+ *  Call one client's notification function and account for its latency.
+ */
+static int_fast16_t notifyClient(Power_NotifyObj *pNotifyObj,
+    uint_fast16_t eventType)
+{
+    PowerCC32XX_Stats *stats = &PowerCC32XX_module.stats;
+    PowerCC32XX_NotifyObj *pExtended;
+    int_fast16_t notifyStatus;
+    uint32_t start;
+    uint64_t usec;
+    uint32_t latency;
+    uint32_t limit = 16;
+    uint32_t bin = 0;
+
+    start = ClockP_getTimestamp();
+
+    /* call the client's notification function */
+    notifyStatus = (int_fast16_t) (*(Power_NotifyFxn)pNotifyObj->notifyFxn)(
+        eventType, 0, pNotifyObj->clientArg);
+
+    usec = ((uint64_t)(ClockP_getTimestamp() - start) *
+        PowerCC32XX_module.notifyUsecScale) >> NOTIFY_USEC_SHIFT;
+    latency = (usec > UINT32_MAX) ? UINT32_MAX : (uint32_t) usec;
+
+    if (pNotifyObj->eventTypes & NOTIFY_EXTENDED) {
+        pExtended = (PowerCC32XX_NotifyObj *)pNotifyObj;
+
+        while ((bin < (PowerCC32XX_NOTIFY_LATENCY_BINS - 1)) &&
+            (latency >= limit)) {
+            bin++;
+            limit <<= 2;
+        }
+
+        if (pExtended->latencyCounts[bin] != UINT16_MAX) {
+            pExtended->latencyCounts[bin]++;
+        }
+
+        if (latency > pExtended->latencyMax) {
+            pExtended->latencyMax =
+                (latency > UINT16_MAX) ? UINT16_MAX : (uint16_t) latency;
+        }
+    }
+
+    if (latency > stats->slowestNotifyLatency) {
+        stats->slowestNotifyLatency = latency;
+        stats->slowestNotifyFxn = pNotifyObj->notifyFxn;
+    }
+
+    return (notifyStatus);
+}
+
+/*
+ *  ======== notifyDeferred ========
+ *  Deliver PowerCC32XX_AWAKE_LPDS to the deferred clients. The caller has
+ *  cleared deferredPending. Called from the SwiP with interrupts enabled,
+ *  or from Power_sleep() with them disabled.
+ */
+static void notifyDeferred(void)
+{
+    Power_NotifyObj *pNotifyObj;
+    List_Elem *elem;
+
+    elem = List_head(&PowerCC32XX_module.notifyList);
+
+    while (elem != NULL) {
+        pNotifyObj = (Power_NotifyObj *)elem;
+
+        if ((pNotifyObj->eventTypes & PowerCC32XX_AWAKE_LPDS) &&
+            (notifyFlags(pNotifyObj) & PowerCC32XX_NOTIFY_DEFERRED)) {
+            /* the wake is already complete, an error can only be logged */
+            if (notifyClient(pNotifyObj, PowerCC32XX_AWAKE_LPDS) !=
+                Power_NOTIFYDONE) {
+                DebugP_log1("Power: deferred notify (%p) failed",
+                    (uintptr_t) pNotifyObj);
+            }
+        }
+
+        elem = List_next(elem);
+    }
+}
+
+/*
+ *  ======== deferredSwiFxn ========
+ */
+static void deferredSwiFxn(uintptr_t arg0, uintptr_t arg1)
+{
+    uintptr_t key;
+    bool pending;
+
+    (void)arg0;
+    (void)arg1;
+
+    /* Power_sleep() may already have flushed them */
+    key = HwiP_disable();
+    pending = PowerCC32XX_module.deferredPending;
+    PowerCC32XX_module.deferredPending = false;
+    HwiP_restore(key);
+
+    /* the restores themselves run with interrupts enabled */
+    if (pending) {
+        notifyDeferred();
+    }
+}
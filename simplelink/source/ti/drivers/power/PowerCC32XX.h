@@ -81,6 +81,13 @@ extern "C" {
 /*! The total latency to reserve for entry to and exit from LPDS (usec) */
 #define PowerCC32XX_TOTALTIMELPDS           20000
 
+/*!
+ *  Weight of the newest LPDS residency in the idle prediction, as a shift
+ *  (1/4); also the rate at which a rejected idle pulls the prediction back
+ *  up toward the timer bound
+ */
+#define PowerCC32XX_IDLE_HISTORY_SHIFT      2
+
 /*! The total latency to reserve for entry to and exit from Shutdown (usec) */
 #define PowerCC32XX_TOTALTIMESHUTDOWN       500000
 
@@ -184,6 +191,23 @@ extern "C" {
 #define PowerCC32XX_NUMEVENTS           3    /*!< number of events */
 /* \endcond */
 
+/* Notification dispatch */
+#define PowerCC32XX_NOTIFY_PRIORITY_DEFAULT   8
+/*!< Dispatch group used by Power_registerNotify() */
+
+#define PowerCC32XX_NOTIFY_DEFERRED     0x1
+/*!< Notify flag: deliver PowerCC32XX_AWAKE_LPDS from a SwiP after
+ *   Power_sleep() returns, rather than during the LPDS exit sequence.
+ *   For clients whose restore may run concurrently with the woken thread.
+ *   Entering events are always delivered synchronously.
+ */
+
+#define PowerCC32XX_NOTIFY_LATENCY_BINS 6
+/*!< Number of buckets in a notify object's latency histogram.
+ *   Bucket n counts notifications that completed in less than
+ *   (16 << (2 * n)) microseconds; the last bucket counts everything longer.
+ */
+
 /* Power sleep states */
 #define PowerCC32XX_LPDS                0x1 /*!< The LPDS sleep state */
 
@@ -551,6 +575,55 @@ typedef struct PowerCC32XX_Wakeup {
     uint32_t wakeupGPIOTypeShutdown;
 } PowerCC32XX_Wakeup;
 
+/*!
+ *  @brief  Notify object of PowerCC32XX_registerNotify()
+ *
+ *  Extends Power_NotifyObj, which stays the same on every device, with a
+ *  dispatch group, flags and latency statistics. Pass &obj->notifyObj to
+ *  Power_unregisterNotify().
+ *
+ *  The application must not access any member variables of this structure!
+ */
+typedef struct PowerCC32XX_NotifyObj {
+    Power_NotifyObj notifyObj;  /*!< must be first */
+    uint_least8_t priority;     /*!< dispatch group, lowest notified first */
+    uint_least8_t flags;        /*!< PowerCC32XX_NOTIFY_DEFERRED or 0 */
+    uint16_t latencyMax;        /*!< longest notification (usec) */
+    /*! notification latency histogram, see PowerCC32XX_NOTIFY_LATENCY_BINS */
+    uint16_t latencyCounts[PowerCC32XX_NOTIFY_LATENCY_BINS];
+} PowerCC32XX_NotifyObj;
+
+/*!
+ *  @brief  LPDS governor and residency statistics
+ *
+ *  Filled by PowerCC32XX_getStats().  Counters are cumulative since
+ *  Power_init() and wrap silently.
+ */
+typedef struct PowerCC32XX_Stats {
+    /*! Number of completed LPDS entries */
+    uint32_t lpdsCount;
+    /*! LPDS entries that lasted less than PowerCC32XX_TOTALTIMELPDS */
+    uint32_t lpdsShortCount;
+    /*! Idle periods PowerCC32XX_selectLPDS() kept out of LPDS */
+    uint32_t lpdsRejectCount;
+    /*! Total time spent in LPDS, including transitions (usec) */
+    uint64_t lpdsTime;
+    /*! LPDS wakeups caused by the network processor (host IRQ) */
+    uint32_t wakeHostIRQCount;
+    /*! LPDS wakeups caused by the configured wakeup GPIO */
+    uint32_t wakeGPIOCount;
+    /*! LPDS wakeups caused by the LPDS wakeup timer */
+    uint32_t wakeTimerCount;
+    /*! LPDS wakeups with any other cause */
+    uint32_t wakeOtherCount;
+    /*! Current prediction of the next idle period (usec), 0 if none yet */
+    uint32_t predictedIdle;
+    /*! Notification function with the longest single notification */
+    Power_NotifyFxn slowestNotifyFxn;
+    /*! Latency of that notification (usec) */
+    uint32_t slowestNotifyLatency;
+} PowerCC32XX_Stats;
+
 /*!
  *  @cond NODOC
  *  Internal structure defining Power module state.
@@ -572,6 +645,9 @@ typedef struct PowerCC32XX_ModuleState {
     uint16_t stateAntPin30;
     uint32_t pinLockMask;
     PowerCC32XX_Wakeup wakeupConfig;
+    PowerCC32XX_Stats stats;
+    uint32_t notifyUsecScale;
+    bool deferredPending;
 } PowerCC32XX_ModuleState;
 /*! @endcond */
 
@@ -631,6 +707,68 @@ void PowerCC32XX_disableIORetention(unsigned long groupFlags);
 /*! OS-specific power policy function */
 void PowerCC32XX_sleepPolicy(void);
 
+/*!
+ *  @brief  Decide whether an idle period is worth entering LPDS
+ *
+ *  Intended to be called by the power policy, with interrupts disabled,
+ *  once it has computed the time until the next scheduled ClockP/timer
+ *  expiry.  The idle period is predicted as the lesser of that bound and
+ *  a running average of recent LPDS residencies, since asynchronous
+ *  wakeups (network processor, GPIO) usually arrive well before the
+ *  next timeout.  LPDS is only chosen if the prediction covers
+ *  Power_getTransitionLatency(PowerCC32XX_LPDS, Power_TOTAL) and no
+ *  PowerCC32XX_DISALLOW_LPDS constraint is set.
+ *
+ *  When LPDS is rejected the policy should fall back to a plain WFI.
+ *
+ *  @param  timeUntilWake   time until the next scheduled wakeup (usec)
+ *
+ *  @return true if the policy should call Power_sleep(PowerCC32XX_LPDS)
+ */
+bool PowerCC32XX_selectLPDS(uint_fast32_t timeUntilWake);
+
+/*!
+ *  @brief  Register a notification function with a dispatch group and flags
+ *
+ *  Same as Power_registerNotify(), which uses
+ *  PowerCC32XX_NOTIFY_PRIORITY_DEFAULT and no flags.  Notifications are
+ *  delivered in ascending priority order; clients in the same group are
+ *  notified in registration order.  Each notification is timed, see
+ *  PowerCC32XX_getNotifyLatency(); clients registered with
+ *  Power_registerNotify() only count towards PowerCC32XX_getStats().
+ *
+ *  @param  pNotifyObj      notification object (preallocated by caller)
+ *  @param  eventTypes      events of interest, as with Power_registerNotify()
+ *  @param  notifyFxn       client's notification callback function
+ *  @param  clientArg       client-specific argument to pass with notification
+ *  @param  priority        dispatch group, lowest is notified first
+ *  @param  flags           zero or PowerCC32XX_NOTIFY_DEFERRED
+ *
+ *  @return Power_SOK on success,
+ *          Power_EINVALIDPOINTER if either pNotifyObj or notifyFxn are NULL.
+ */
+int_fast16_t PowerCC32XX_registerNotify(PowerCC32XX_NotifyObj *pNotifyObj,
+    uint_fast16_t eventTypes, Power_NotifyFxn notifyFxn, uintptr_t clientArg,
+    uint_least8_t priority, uint_least8_t flags);
+
+/*!
+ *  @brief  Get a client's notification latency histogram
+ *
+ *  @param  pNotifyObj      a registered notification object
+ *  @param  counts          PowerCC32XX_NOTIFY_LATENCY_BINS entries to be written
+ *
+ *  @return The longest single notification of this client (usec)
+ */
+uint_fast16_t PowerCC32XX_getNotifyLatency(PowerCC32XX_NotifyObj *pNotifyObj,
+    uint16_t *counts);
+
+/*!
+ *  @brief  Get LPDS residency and wake reason statistics
+ *
+ *  @param  stats       A PowerCC32XX_Stats structure to be written into
+ */
+void PowerCC32XX_getStats(PowerCC32XX_Stats *stats);
+
 /*!
  *  @brief  Software reset of a resource
  *
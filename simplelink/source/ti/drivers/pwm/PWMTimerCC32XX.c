@@ -53,6 +53,7 @@
 #include <ti/drivers/timer/TimerCC32XX.h>
 
 #include <ti/devices/cc32xx/inc/hw_apps_config.h>
+#include <ti/devices/cc32xx/inc/hw_ints.h>
 #include <ti/devices/cc32xx/inc/hw_memmap.h>
 #include <ti/devices/cc32xx/inc/hw_ocp_shared.h>
 #include <ti/devices/cc32xx/inc/hw_types.h>
@@ -138,6 +139,21 @@ static const uint32_t timerHalves[2] = {
     TIMER_B,
 };
 
+static const uint8_t timerInterrupts[4][2] = {
+    {INT_TIMERA0A, INT_TIMERA0B},
+    {INT_TIMERA1A, INT_TIMERA1B},
+    {INT_TIMERA2A, INT_TIMERA2B},
+    {INT_TIMERA3A, INT_TIMERA3B},
+};
+
+/*
+ * Mode register bits used by the sequencer: load and match values are
+ * latched at the next timeout, and output edges raise the event interrupt.
+ * Timer A and B use the same bit positions in their mode registers.
+ */
+#define SEQUENCE_MODE_BITS (TIMER_TAMR_TAILD | TIMER_TAMR_TAMRSU | \
+    TIMER_TAMR_TAPWMIE)
+
 #define NUMGPIOPORTS 4
 static const uint32_t gpioBaseAddresses[NUMGPIOPORTS] = {
     GPIOA0_BASE,
@@ -311,6 +327,199 @@ static int initHw(PWM_Handle handle, uint32_t period, uint32_t duty)
     return (PWM_STATUS_SUCCESS);
 }
 
+/*
+ *  ======== loadSequenceStep ========
+ *  Writes the duty and period of a sequence step in timer counts.  The duty
+ *  is clamped so that the output has an edge every period.
+ */
+static void loadSequenceStep(PWM_Handle handle, uint32_t index)
+{
+    PWMTimerCC32XX_Object          *object = handle->object;
+    PWMTimerCC32XX_HWAttrsV2 const *hwAttrs = handle->hwAttrs;
+    PWMTimerCC32XX_Sequence const  *sequence = object->sequence;
+    uint32_t                        timerBaseAddr;
+    uint16_t                        halfTimer;
+    uint32_t                        period;
+    uint32_t                        duty;
+
+    timerBaseAddr = timerBaseAddresses[PinConfigTimerPort(hwAttrs->pwmPin)];
+    halfTimer = timerHalves[PinConfigTimerHalf(hwAttrs->pwmPin)];
+
+    period = object->period;
+    if (sequence->periods != NULL) {
+        period = getPeriodCounts(object->periodUnits,
+            sequence->periods[index]);
+        if ((period < 2) || (period > PWM_MAX_PERIOD_COUNT)) {
+            period = object->period;
+        }
+    }
+
+    duty = getDutyCounts(object->dutyUnits, sequence->duties[index], period);
+    if (duty == 0) {
+        duty = 1;
+    }
+    else if (duty >= period) {
+        duty = period - 1;
+    }
+
+    object->period = period;
+    object->duty = duty;
+
+    MAP_TimerPrescaleSet(timerBaseAddr, halfTimer,
+        period / PWM_MAX_MATCH_REG_VALUE);
+    MAP_TimerLoadSet(timerBaseAddr, halfTimer,
+        period % PWM_MAX_MATCH_REG_VALUE);
+    MAP_TimerPrescaleMatchSet(timerBaseAddr, halfTimer,
+        duty / PWM_MAX_MATCH_REG_VALUE);
+    MAP_TimerMatchSet(timerBaseAddr, halfTimer,
+        duty % PWM_MAX_MATCH_REG_VALUE);
+}
+
+/*
+ *  ======== stopSequence ========
+ */
+static void stopSequence(PWM_Handle handle)
+{
+    PWMTimerCC32XX_Object          *object = handle->object;
+    PWMTimerCC32XX_HWAttrsV2 const *hwAttrs = handle->hwAttrs;
+    uint32_t                        timerBaseAddr;
+    uint16_t                        halfTimer;
+    uint32_t                        modeReg;
+    uintptr_t                       key;
+
+    timerBaseAddr = timerBaseAddresses[PinConfigTimerPort(hwAttrs->pwmPin)];
+    halfTimer = timerHalves[PinConfigTimerHalf(hwAttrs->pwmPin)];
+    modeReg = timerBaseAddr +
+        ((halfTimer & TIMER_A) ? TIMER_O_TAMR : TIMER_O_TBMR);
+
+    key = HwiP_disable();
+
+    if (object->sequence != NULL) {
+        MAP_TimerIntDisable(timerBaseAddr,
+            halfTimer & (TIMER_CAPA_EVENT | TIMER_CAPB_EVENT));
+        HWREG(modeReg) &= ~SEQUENCE_MODE_BITS;
+        object->sequence = NULL;
+    }
+
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== sequenceHwiFxn ========
+ *  Called on an output edge once per period while a sequence plays.
+ */
+static void sequenceHwiFxn(uintptr_t arg)
+{
+    PWM_Handle                      handle = (PWM_Handle) arg;
+    PWMTimerCC32XX_Object          *object = handle->object;
+    PWMTimerCC32XX_HWAttrsV2 const *hwAttrs = handle->hwAttrs;
+    PWMTimerCC32XX_Sequence const  *sequence = object->sequence;
+    uint32_t                        timerBaseAddr;
+    uint16_t                        halfTimer;
+
+    timerBaseAddr = timerBaseAddresses[PinConfigTimerPort(hwAttrs->pwmPin)];
+    halfTimer = timerHalves[PinConfigTimerHalf(hwAttrs->pwmPin)];
+
+    MAP_TimerIntClear(timerBaseAddr,
+        halfTimer & (TIMER_CAPA_EVENT | TIMER_CAPB_EVENT));
+
+    if ((sequence == NULL) || (--object->sequenceHold != 0)) {
+        return;
+    }
+    object->sequenceHold = sequence->stepPeriods;
+
+    /* The last step of a single pass has been held for its periods */
+    if (object->sequenceIndex == sequence->count) {
+        stopSequence(handle);
+
+        if (sequence->callbackFxn != NULL) {
+            sequence->callbackFxn(handle);
+        }
+        return;
+    }
+
+    loadSequenceStep(handle, object->sequenceIndex);
+
+    if ((++object->sequenceIndex == sequence->count) && sequence->loop) {
+        object->sequenceIndex = 0;
+
+        if (sequence->callbackFxn != NULL) {
+            sequence->callbackFxn(handle);
+        }
+    }
+}
+
+/*
+ *  ======== startSequence ========
+ */
+static int_fast16_t startSequence(PWM_Handle handle,
+    PWMTimerCC32XX_Sequence const *sequence)
+{
+    PWMTimerCC32XX_Object          *object = handle->object;
+    PWMTimerCC32XX_HWAttrsV2 const *hwAttrs = handle->hwAttrs;
+    HwiP_Params                     hwiParams;
+    uint32_t                        timerBaseAddr;
+    uint16_t                        halfTimer;
+    uint32_t                        modeReg;
+    uint32_t                        event;
+    uintptr_t                       key;
+
+    if ((sequence == NULL) || (sequence->duties == NULL) ||
+        (sequence->count == 0) || (sequence->stepPeriods == 0)) {
+        return (PWM_STATUS_ERROR);
+    }
+
+    timerBaseAddr = timerBaseAddresses[PinConfigTimerPort(hwAttrs->pwmPin)];
+    halfTimer = timerHalves[PinConfigTimerHalf(hwAttrs->pwmPin)];
+    modeReg = timerBaseAddr +
+        ((halfTimer & TIMER_A) ? TIMER_O_TAMR : TIMER_O_TBMR);
+    event = halfTimer & (TIMER_CAPA_EVENT | TIMER_CAPB_EVENT);
+
+    stopSequence(handle);
+
+    if (!object->hwiConstructed) {
+        HwiP_Params_init(&hwiParams);
+        hwiParams.arg = (uintptr_t) handle;
+        if (HwiP_construct(&object->hwiStruct,
+            timerInterrupts[PinConfigTimerPort(hwAttrs->pwmPin)]
+                [PinConfigTimerHalf(hwAttrs->pwmPin)],
+            sequenceHwiFxn, &hwiParams) == NULL) {
+            DebugP_log1("PWM:(%p) failed to construct sequence Hwi.",
+                (uintptr_t) handle);
+
+            return (PWM_STATUS_ERROR);
+        }
+        object->hwiConstructed = true;
+    }
+
+    key = HwiP_disable();
+
+    /* Steps never use the inverted output used for a duty of 100% */
+    if (object->duty == object->period) {
+        HWREG(timerBaseAddr + TIMER_O_CTL) ^=
+            (halfTimer & (TIMER_CTL_TAPWML | TIMER_CTL_TBPWML));
+    }
+
+    /* The first step takes effect immediately */
+    object->sequence = sequence;
+    loadSequenceStep(handle, 0);
+    object->sequenceIndex = 1;
+    object->sequenceHold = sequence->stepPeriods;
+
+    if ((object->sequenceIndex == sequence->count) && sequence->loop) {
+        object->sequenceIndex = 0;
+    }
+
+    HWREG(modeReg) |= SEQUENCE_MODE_BITS;
+    MAP_TimerControlEvent(timerBaseAddr, halfTimer, TIMER_EVENT_POS_EDGE);
+    MAP_TimerIntClear(timerBaseAddr, event);
+    MAP_TimerIntEnable(timerBaseAddr, event);
+
+    HwiP_restore(key);
+
+    return (PWM_STATUS_SUCCESS);
+}
+
 /*
  *  ======== postNotifyFxn ========
  *  Called by Power module when waking up from LPDS.
@@ -320,9 +529,26 @@ static int postNotifyFxn(unsigned int eventType, uintptr_t eventArg,
 {
     PWM_Handle             handle = (PWM_Handle) clientArg;
     PWMTimerCC32XX_Object *object = handle->object;
+    PWMTimerCC32XX_HWAttrsV2 const *hwAttrs = handle->hwAttrs;
+    uint32_t               timerBaseAddr;
+    uint16_t               halfTimer;
+    uint32_t               event;
 
     initHw(handle, object->period, object->duty);
 
+    /* initHw() rewrites the mode register; re-arm a paused sequence */
+    if (object->sequence != NULL) {
+        timerBaseAddr =
+            timerBaseAddresses[PinConfigTimerPort(hwAttrs->pwmPin)];
+        halfTimer = timerHalves[PinConfigTimerHalf(hwAttrs->pwmPin)];
+        event = halfTimer & (TIMER_CAPA_EVENT | TIMER_CAPB_EVENT);
+
+        HWREG(timerBaseAddr + ((halfTimer & TIMER_A) ?
+            TIMER_O_TAMR : TIMER_O_TBMR)) |= SEQUENCE_MODE_BITS;
+        MAP_TimerIntClear(timerBaseAddr, event);
+        MAP_TimerIntEnable(timerBaseAddr, event);
+    }
+
     return (Power_NOTIFYDONE);
 }
 
@@ -353,6 +579,12 @@ void PWMTimerCC32XX_close(PWM_Handle handle)
         0 : gpioBaseAddresses[PinConfigGPIOPort(hwAttrs->pwmPin)];
 
     PWMTimerCC32XX_stop(handle);
+    stopSequence(handle);
+
+    if (object->hwiConstructed) {
+        HwiP_destruct(&object->hwiStruct);
+        object->hwiConstructed = false;
+    }
 
     key = HwiP_disable();
 
@@ -382,8 +614,18 @@ void PWMTimerCC32XX_close(PWM_Handle handle)
 int_fast16_t PWMTimerCC32XX_control(PWM_Handle handle, uint_fast16_t cmd,
     void *arg)
 {
-    /* No implementation yet */
-    return (PWM_STATUS_UNDEFINEDCMD);
+    switch (cmd) {
+        case PWMTimerCC32XX_CMD_START_SEQUENCE:
+            return (startSequence(handle,
+                (PWMTimerCC32XX_Sequence const *) arg));
+
+        case PWMTimerCC32XX_CMD_STOP_SEQUENCE:
+            stopSequence(handle);
+            return (PWM_STATUS_SUCCESS);
+
+        default:
+            return (PWM_STATUS_UNDEFINEDCMD);
+    }
 }
 
 /*
@@ -475,6 +717,8 @@ PWM_Handle PWMTimerCC32XX_open(PWM_Handle handle, PWM_Params *params)
     object->idleLevel = params->idleLevel;
     object->periodUnits = params->periodUnits;
     object->pwmStarted = 0;
+    object->sequence = NULL;
+    object->hwiConstructed = false;
 
     /* Initialize the peripheral & set the period & duty */
     if (initHw(handle, params->periodValue, params->dutyValue) !=
@@ -128,6 +128,39 @@
  *    const uint_least8_t PWM_count = CC3220SF_LAUNCHXL_PWMCOUNT;
  *  @endcode
  *
+ *  ### Sequencer #
+ *  PWMTimerCC32XX_CMD_START_SEQUENCE plays a buffer of duty values, and
+ *  optionally periods, without further calls from the application.  Each
+ *  value is held for PWMTimerCC32XX_Sequence.stepPeriods PWM periods.  The
+ *  timer interrupt loads the next step once per period, and the timer
+ *  latches the new load and match values at the end of the period, so steps
+ *  change on period boundaries without glitches.
+ *  Values are in the duty and period units given to PWM_open().
+ *
+ *  Outputs which never change level do not generate the timer interrupt,
+ *  so the sequencer clamps each step's duty to between one timer count and
+ *  one count less than the period.  The callback, if any, is called in Hwi
+ *  context when a sequence has played its last step, and each time a
+ *  looping sequence starts over.  The output keeps the last step's duty
+ *  and period when a sequence ends.  PWM_setDuty(),
+ *  PWM_setPeriod() and PWM_setDutyAndPeriod() must not be called while a
+ *  sequence is playing.
+ *
+ *  @code
+ *  static const uint32_t ramp[] = {10, 20, 40, 60, 80, 90};
+ *  PWMTimerCC32XX_Sequence sequence = {
+ *      .duties = ramp,
+ *      .periods = NULL,
+ *      .count = sizeof(ramp) / sizeof(ramp[0]),
+ *      .stepPeriods = 50,
+ *      .loop = false,
+ *      .callbackFxn = NULL
+ *  };
+ *
+ *  PWM_start(pwm);
+ *  PWM_control(pwm, PWMTimerCC32XX_CMD_START_SEQUENCE, &sequence);
+ *  @endcode
+ *
  * ### Power Management #
  * The TI-RTOS power management framework will try to put the device into the most
  * power efficient mode whenever possible. Please see the technical reference
@@ -155,6 +188,7 @@ extern "C" {
 #endif
 
 #include <stdbool.h>
+#include <ti/drivers/dpl/HwiP.h>
 #include <ti/drivers/Power.h>
 #include <ti/drivers/PWM.h>
 
@@ -262,7 +296,24 @@ extern "C" {
  *  @{
  */
 
-/* Add PWMTimerCC32XX_CMD_* macros here */
+/*!
+ *  @brief  Command used by PWM_control() to start a sequence
+ *
+ *  With this command code, @b arg is a pointer to a
+ *  PWMTimerCC32XX_Sequence which must remain valid until the sequence
+ *  completes or is stopped.  A sequence already playing is replaced.
+ *
+ *  Returns PWM_STATUS_ERROR if the sequence is empty or stepPeriods is 0.
+ */
+#define PWMTimerCC32XX_CMD_START_SEQUENCE   (PWM_CMD_RESERVED + 0)
+
+/*!
+ *  @brief  Command used by PWM_control() to stop a sequence
+ *
+ *  With this command code, @b arg is not used.  The output keeps the duty
+ *  and period of the last step loaded.
+ */
+#define PWMTimerCC32XX_CMD_STOP_SEQUENCE    (PWM_CMD_RESERVED + 1)
 
 /** @}*/
 
@@ -295,6 +346,27 @@ typedef struct PWMTimerCC32XX_HWAttrsV2 {
                                              (see @ref pwmPinIdentifiersCC32XX) */
 } PWMTimerCC32XX_HWAttrsV2;
 
+/*!
+ *  @brief  Sequence callback function, called in Hwi context
+ */
+typedef void (*PWMTimerCC32XX_SequenceFxn)(PWM_Handle handle);
+
+/*!
+ *  @brief  PWMTimerCC32XX sequence
+ *
+ *  @sa PWMTimerCC32XX_CMD_START_SEQUENCE
+ */
+typedef struct PWMTimerCC32XX_Sequence {
+    const uint32_t *duties;       /*!< Duty of each step */
+    const uint32_t *periods;      /*!< Period of each step, or NULL to keep
+                                       the current period */
+    uint32_t        count;        /*!< Number of steps */
+    uint32_t        stepPeriods;  /*!< PWM periods each step is held */
+    bool            loop;         /*!< Restart after the last step */
+    PWMTimerCC32XX_SequenceFxn callbackFxn; /*!< Called after the last
+                                                 step, or NULL */
+} PWMTimerCC32XX_Sequence;
+
 /*!
  *  @brief  PWMTimerCC32XX Object
  *
@@ -307,6 +379,11 @@ typedef struct PWMTimerCC32XX_Object {
     PWM_Duty_Units   dutyUnits;         /* Current duty cycle unit */
     PWM_Period_Units periodUnits;       /* Current period unit */
     PWM_IdleLevel    idleLevel;         /* PWM idle level when stopped / not started */
+    HwiP_Struct      hwiStruct;         /* Timer interrupt for sequences */
+    PWMTimerCC32XX_Sequence const *sequence; /* Sequence playing, or NULL */
+    uint32_t         sequenceIndex;     /* Next step to load */
+    uint32_t         sequenceHold;      /* Periods until the next step */
+    bool             hwiConstructed;    /* hwiStruct has been constructed */
     bool             pwmStarted;        /* Used to gate Power_set/releaseConstraint() calls */
     bool             isOpen;            /* open flag used to check if PWM is opened */
 } PWMTimerCC32XX_Object;
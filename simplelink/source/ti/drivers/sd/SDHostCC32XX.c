@@ -32,6 +32,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 /*
  * By default disable both asserts and log for this module.
  * This must be done before DebugP.h is included.
@@ -50,6 +51,7 @@
 #include <ti/drivers/power/PowerCC32XX.h>
 #include <ti/drivers/sd/SDHostCC32XX.h>
 #include <ti/drivers/dma/UDMACC32XX.h>
+#include <ti/drivers/utils/List.h>
 
 /* Driverlib header files */
 #include <ti/devices/cc32xx/inc/hw_common_reg.h>
@@ -113,10 +115,18 @@
 /* Checksum to validate SD command responses */
 #define CHECKSUM             (0xA5)
 
-/* Setup the UDMA controller to either read or write to the SDHost buffer */
-#define UDMAWRITE            (0x01)
+/* Maximum number of blocks in a single multi-block transfer */
+#define MAXBLOCKCOUNT        (0xFFFF)
 
-#define UDMAREAD             (0x00)
+/* Steps of a (queued) read or write transfer; driven by hwiIntFxn */
+#define XFER_IDLE            (0)  /* No transfer in progress */
+#define XFER_APP_CMD         (1)  /* Waiting for CMD55 (ACMD23 prefix) */
+#define XFER_SET_BLK_CNT     (2)  /* Waiting for ACMD23 response */
+#define XFER_CMD             (3)  /* Waiting for CMD18/CMD25 response */
+#define XFER_DATA            (4)  /* DMA transferring data blocks */
+#define XFER_DATA_DONE       (5)  /* Waiting for data transfer complete */
+#define XFER_STOP_CMD        (6)  /* Waiting for CMD12 response */
+#define XFER_STOP_BUSY       (7)  /* Waiting for the card to release busy */
 
 /* Define used for commands that do not require an argument */
 #define NULLARG              (0x00)
@@ -137,19 +147,32 @@ int_fast16_t SDHostCC32XX_read(SD_Handle handle, void *buf,
     int_fast32_t sector, uint_fast32_t secCount);
 int_fast16_t SDHostCC32XX_write(SD_Handle handle, const void *buf,
     int_fast32_t sector, uint_fast32_t secCount);
+int_fast16_t SDHostCC32XX_readAsync(SD_Handle handle,
+    SD_Transaction *transaction);
+int_fast16_t SDHostCC32XX_writeAsync(SD_Handle handle,
+    SD_Transaction *transaction);
 
 /* Local Functions */
-static void configDMAChannel(SD_Handle handle, uint_fast32_t channelSel,
-    uint_fast32_t operation);
+static void completeRun(SD_Handle handle, int_fast16_t status);
+static void configDMAChannel(SD_Handle handle, uint_fast8_t chan);
 static int_fast32_t deSelectCard(SD_Handle handle);
+static void dmaIntFxn(SD_Handle handle, uint_fast32_t dmaInt,
+    unsigned long chIdx);
 static uint_fast32_t getPowerMgrId(uint_fast32_t baseAddr);
+static void holdQueue(SD_Handle handle);
 static void hwiIntFxn(uintptr_t handle);
 static void initHw(SD_Handle handle);
 static int postNotifyFxn(unsigned int eventType, uintptr_t eventArg,
     uintptr_t clientArg);
+static void releaseQueue(SD_Handle handle);
 static int_fast32_t send_cmd(SD_Handle handle, uint_fast32_t cmd,
     uint_fast32_t arg);
 static int_fast32_t selectCard(SD_Handle handle);
+static void startRun(SD_Handle handle);
+static int_fast16_t submitTransaction(SD_Handle handle,
+    SD_Transaction *transaction, bool isWrite);
+static void transferIntFxn(SD_Handle handle, uint_fast32_t status);
+static void xferCallback(SD_Handle handle, SD_Transaction *transaction);
 
 /* SDHostCC32XX function table for SDSPICC32XX implementation */
 const SD_FxnTable sdHostCC32XX_fxnTable = {
@@ -161,7 +184,9 @@ const SD_FxnTable sdHostCC32XX_fxnTable = {
     SDHostCC32XX_initialize,
     SDHostCC32XX_open,
     SDHostCC32XX_read,
-    SDHostCC32XX_write
+    SDHostCC32XX_write,
+    SDHostCC32XX_readAsync,
+    SDHostCC32XX_writeAsync
 };
 
 /*
@@ -185,7 +210,10 @@ void SDHostCC32XX_close(SD_Handle handle)
     MAP_SDHostIntDisable(hwAttrs->baseAddr, DATAERROR | CMDERROR);
 
     if (object->dmaHandle) {
+        UDMACC32XX_freeChannel(object->dmaHandle, hwAttrs->rxChIdx);
+        UDMACC32XX_freeChannel(object->dmaHandle, hwAttrs->txChIdx);
         UDMACC32XX_close(object->dmaHandle);
+        object->dmaHandle = NULL;
     }
     if (object->cmdSem) {
         SemaphoreP_delete(object->cmdSem);
@@ -247,8 +275,12 @@ uint_fast32_t SDHostCC32XX_getNumSectors(SD_Handle handle)
     DebugP_log1("SDHost:(%p) SDHostCC32XX_getNumSectors set command"
         " power constraint", hwAttrs->baseAddr);
 
+    /* The card must not be de-selected in the middle of a transfer */
+    holdQueue(handle);
+
     /* De-Select the card on the input drive(Stand-by state) */
     if (deSelectCard(handle) != SD_STATUS_SUCCESS) {
+        releaseQueue(handle);
         Power_releaseConstraint(PowerCC32XX_DISALLOW_LPDS);
         DebugP_log1("SDHost:(%p) SDHostCC32XX_getNumSectors released command"
             " power constraint", hwAttrs->baseAddr);
@@ -287,6 +319,8 @@ uint_fast32_t SDHostCC32XX_getNumSectors(SD_Handle handle)
         sectors = 0;
     }
 
+    releaseQueue(handle);
+
     Power_releaseConstraint(PowerCC32XX_DISALLOW_LPDS);
     DebugP_log1("SDHost:(%p) SDHostCC32XX_getNumSectors released command"
         " power constraint", hwAttrs->baseAddr);
@@ -318,6 +352,9 @@ int_fast16_t SDHostCC32XX_initialize(SD_Handle handle)
     DebugP_log1("SDHost:(%p) SDHostCC32XX_initialize set read/write"
         " power constraint", hwAttrs->baseAddr);
 
+    /* Queued transfers are started once the card has been initialized */
+    holdQueue(handle);
+
     /* Send go to IDLE command */
     result = send_cmd(handle, CMD_GO_IDLE_STATE, NULLARG);
 
@@ -419,6 +456,8 @@ int_fast16_t SDHostCC32XX_initialize(SD_Handle handle)
         result = SD_STATUS_ERROR;
     }
 
+    releaseQueue(handle);
+
     Power_releaseConstraint(PowerCC32XX_DISALLOW_LPDS);
     DebugP_log1("SDHost:(%p) SDHostCC32XX_initialize released read/write"
         " power constraint", hwAttrs->baseAddr);
@@ -434,10 +473,10 @@ void SDHostCC32XX_init(SD_Handle handle)
 {
     SDHostCC32XX_Object *object = handle->object;
 
-    object->writeBuf = NULL;
-    object->readBuf = NULL;
-    object->writeSecCount = 0;
-    object->readSecCount = 0;
+    List_clearList(&object->transactionList);
+    List_clearList(&object->runList);
+    object->xferState = XFER_IDLE;
+    object->cmdPending = false;
     object->cardType = SD_NOCARD;
     object->isOpen = false;
 
@@ -452,6 +491,8 @@ SD_Handle SDHostCC32XX_open(SD_Handle handle, SD_Params *params)
     uintptr_t                     key;
     SemaphoreP_Params             semParams;
     HwiP_Params                   hwiParams;
+    UDMACC32XX_Handle             dmaHandle;
+    uint32_t                      dmaChannels[2];
     SDHostCC32XX_Object          *object = handle->object;
     SDHostCC32XX_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
     uint16_t pin;
@@ -470,6 +511,7 @@ SD_Handle SDHostCC32XX_open(SD_Handle handle, SD_Params *params)
 
     /* Initialize the SDCARD_CLK pin ID to undefined */
     object->clkPin = (uint16_t)-1;
+    object->dmaHandle = NULL;
 
     /* Get the Power resource Id from the base address */
     object->powerMgrId = getPowerMgrId(hwAttrs->baseAddr);
@@ -488,14 +530,34 @@ SD_Handle SDHostCC32XX_open(SD_Handle handle, SD_Params *params)
     Power_registerNotify(&object->postNotify, PowerCC32XX_AWAKE_LPDS,
         postNotifyFxn, (uintptr_t)handle);
 
-    object->dmaHandle = UDMACC32XX_open();
-    if (object->dmaHandle == NULL) {
+    dmaHandle = UDMACC32XX_open();
+    if (dmaHandle == NULL) {
         DebugP_log1("SDHost:(%p) UDMACC32XX_open() failed.",
             hwAttrs->baseAddr);
         SDHostCC32XX_close(handle);
         return (NULL);
     }
 
+    /* Reserve the channels so that UDMACC32XX_allocChannel() users skip them */
+    dmaChannels[0] = hwAttrs->rxChIdx;
+    dmaChannels[1] = hwAttrs->txChIdx;
+    if (UDMACC32XX_allocChannel(dmaHandle, &dmaChannels[0], 1,
+            UDMACC32XX_PRIORITY_DEFAULT) == UDMACC32XX_CHANNEL_NONE) {
+        DebugP_log1("SDHost:(%p) uDMA RX channel in use.", hwAttrs->baseAddr);
+        UDMACC32XX_close(dmaHandle);
+        SDHostCC32XX_close(handle);
+        return (NULL);
+    }
+    if (UDMACC32XX_allocChannel(dmaHandle, &dmaChannels[1], 1,
+            UDMACC32XX_PRIORITY_DEFAULT) == UDMACC32XX_CHANNEL_NONE) {
+        DebugP_log1("SDHost:(%p) uDMA TX channel in use.", hwAttrs->baseAddr);
+        UDMACC32XX_freeChannel(dmaHandle, dmaChannels[0]);
+        UDMACC32XX_close(dmaHandle);
+        SDHostCC32XX_close(handle);
+        return (NULL);
+    }
+    object->dmaHandle = dmaHandle;
+
     SemaphoreP_Params_init(&semParams);
     semParams.mode = SemaphoreP_Mode_BINARY;
     object->cmdSem = SemaphoreP_create(0, &semParams);
@@ -507,6 +569,11 @@ SD_Handle SDHostCC32XX_open(SD_Handle handle, SD_Params *params)
         return (NULL);
     }
 
+    List_clearList(&object->transactionList);
+    List_clearList(&object->runList);
+    object->xferState = XFER_IDLE;
+    object->cmdPending = false;
+
     HwiP_Params_init(&hwiParams);
     hwiParams.arg = (uintptr_t)handle;
     hwiParams.priority = hwAttrs->intPriority;
@@ -539,124 +606,36 @@ SD_Handle SDHostCC32XX_open(SD_Handle handle, SD_Params *params)
 int_fast16_t SDHostCC32XX_read(SD_Handle handle, void *buf,
     int_fast32_t sector, uint_fast32_t secCount)
 {
-    int_fast32_t                  result;
-    uint_fast32_t                 ret;
-    uint_fast32_t                 size;
-    SDHostCC32XX_Object          *object  = handle->object;
-    SDHostCC32XX_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
-
-    object->stat = SD_STATUS_ERROR;
-
-    /* Check for valid sector count */
-    if (secCount == 0) {
+    SD_Transaction       transaction;
+    SemaphoreP_Struct    done;
+
+    /* Each caller waits on its own semaphore for its own transaction */
+    transaction.buf = buf;
+    transaction.sector = sector;
+    transaction.secCount = secCount;
+    transaction.callbackFxn = xferCallback;
+    transaction.arg = SemaphoreP_constructBinary(&done, 0);
+
+    if (submitTransaction(handle, &transaction, false) != SD_STATUS_SUCCESS) {
+        SemaphoreP_destruct(&done);
         return (SD_STATUS_ERROR);
     }
 
-    /* SDSC uses linear address, SDHC uses block address */
-    if (object->cardType == SD_SDSC) {
-        sector = sector * SECTORSIZE;
-    }
+    /* Wait for the read to complete */
+    SemaphoreP_pend((SemaphoreP_Handle)transaction.arg,
+        SemaphoreP_WAIT_FOREVER);
+    SemaphoreP_destruct(&done);
 
-    Power_setConstraint(PowerCC32XX_DISALLOW_LPDS);
-    DebugP_log1("SDHost:(%p) SDHostCC32XX_read set read power constraint",
-        hwAttrs->baseAddr);
-
-    /* Set the block count */
-    MAP_SDHostBlockCountSet(hwAttrs->baseAddr, secCount);
-
-    /* If input buffer is word aligned use DMA */
-    if (!(((uint_fast32_t)buf) & 0x03)) {
-        object->readBuf = (uint_fast32_t *)buf;
-        object->readSecCount = secCount;
-
-        /* Configure Primary structure */
-        configDMAChannel(handle, UDMA_PRI_SELECT , UDMAREAD);
-
-        /* Add offset to input buffer */
-        object->readBuf = (uint_fast32_t *)((uint_least8_t *)buf +
-            SECTORSIZE);
-
-        /* Configure alternate control structure */
-        configDMAChannel(handle, UDMA_ALT_SELECT , UDMAREAD);
-
-        MAP_SDHostIntClear(hwAttrs->baseAddr, SDHOST_INT_DMARD);
-
-        /* Send multi block read command */
-        result = send_cmd(handle, CMD_READ_MULTI_BLK | SDHOST_DMA_EN, sector);
-
-        if (result == SD_STATUS_SUCCESS) {
-            MAP_SDHostIntEnable(hwAttrs->baseAddr, SDHOST_INT_DMARD);
-
-            /* Wait for DMA read(s) to complete */
-            SemaphoreP_pend(object->cmdSem, SemaphoreP_WAIT_FOREVER);
-
-            MAP_SDHostIntDisable(hwAttrs->baseAddr, SDHOST_INT_DMARD);
-        }
-    }
-    /* Poll buffer for new data */
-    else {
-        /* Compute the number of words to read */
-        size = (SECTORSIZE * secCount) / 4;
-
-        /* Send multi block read command */
-        result = send_cmd(handle, CMD_READ_MULTI_BLK, sector);
-
-        if (result == SD_STATUS_SUCCESS) {
-            /* Read single word of data */
-            while (size > 0) {
-                ret = MAP_SDHostDataNonBlockingRead(hwAttrs->baseAddr,
-                    (unsigned long *)buf);
-                /* Block until buffer is ready */
-                if (ret == 0) {
-                    MAP_SDHostIntEnable(hwAttrs->baseAddr, SDHOST_INT_BRR);
-
-                    SemaphoreP_pend(object->cmdSem, SemaphoreP_WAIT_FOREVER);
-
-                    MAP_SDHostIntDisable(hwAttrs->baseAddr, SDHOST_INT_BRR);
-                }
-                else {
-                    buf = (uint_least8_t *)buf + 4;
-                    size--;
-                }
-            }
-        }
-    }
-
-    /* Verify host controller errors didn't occur */
-    if (object->stat == SD_STATUS_SUCCESS) {
-
-        MAP_SDHostIntEnable(hwAttrs->baseAddr, SDHOST_INT_TC);
-
-        /* Wait for full data transfer to complete */
-        SemaphoreP_pend(object->cmdSem, SemaphoreP_WAIT_FOREVER);
-
-        MAP_SDHostIntDisable(hwAttrs->baseAddr, SDHOST_INT_TC);
-    }
-
-    /* Verify host controller errors didn't occur */
-    if (object->stat == SD_STATUS_SUCCESS) {
-
-        /* Wait for command transfer stop acknowledgement */
-        result = send_cmd(handle, CMD_STOP_TRANS, NULLARG);
-
-        if (result ==  SD_STATUS_SUCCESS) {
-            MAP_SDHostIntEnable(hwAttrs->baseAddr, SDHOST_INT_TC);
-
-            SemaphoreP_pend(object->cmdSem, SemaphoreP_WAIT_FOREVER);
-
-            MAP_SDHostIntDisable(hwAttrs->baseAddr, SDHOST_INT_TC);
-        }
-    }
-
-    if (object->stat != SD_STATUS_SUCCESS) {
-        result = SD_STATUS_ERROR;
-    }
-
-    Power_releaseConstraint(PowerCC32XX_DISALLOW_LPDS);
-    DebugP_log1("SDHost:(%p) SDHostCC32XX_read released read power"
-        " constraint", hwAttrs->baseAddr);
+    return (transaction.status);
+}
 
-    return (result);
+/*
+ *  ======== SDHostCC32XX_readAsync ========
+ */
+int_fast16_t SDHostCC32XX_readAsync(SD_Handle handle,
+    SD_Transaction *transaction)
+{
+    return (submitTransaction(handle, transaction, false));
 }
 
 /*
@@ -665,158 +644,125 @@ int_fast16_t SDHostCC32XX_read(SD_Handle handle, void *buf,
 int_fast16_t SDHostCC32XX_write(SD_Handle handle, const void *buf,
     int_fast32_t sector, uint_fast32_t secCount)
 {
-    int_fast32_t                  result;
-    uint_fast32_t                 ret;
-    uint_fast32_t                 size;
-    SDHostCC32XX_Object          *object  = handle->object;
-    SDHostCC32XX_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
-
-    object->stat = SD_STATUS_ERROR;
-
-    /* Check for valid sector count */
-    if (secCount == 0) {
+    SD_Transaction       transaction;
+    SemaphoreP_Struct    done;
+
+    /* Each caller waits on its own semaphore for its own transaction */
+    transaction.buf = (void *)buf;
+    transaction.sector = sector;
+    transaction.secCount = secCount;
+    transaction.callbackFxn = xferCallback;
+    transaction.arg = SemaphoreP_constructBinary(&done, 0);
+
+    if (submitTransaction(handle, &transaction, true) != SD_STATUS_SUCCESS) {
+        SemaphoreP_destruct(&done);
         return (SD_STATUS_ERROR);
     }
 
-    /* SDSC uses linear address, SDHC uses block address */
-    if(object->cardType == SD_SDSC) {
-        sector = sector * SECTORSIZE;
-    }
-
-    Power_setConstraint(PowerCC32XX_DISALLOW_LPDS);
-    DebugP_log1("SDHost:(%p) SDHostCC32XX_write set write power"
-        " constraint", hwAttrs->baseAddr);
-
-    /* Set the block count */
-    MAP_SDHostBlockCountSet(hwAttrs->baseAddr, secCount);
-
-    /* Set the card write block count */
-    result = send_cmd(handle, CMD_APP_CMD,  object->rca << 16);
-
-    if (result == SD_STATUS_SUCCESS) {
-        result = send_cmd(handle, CMD_SET_BLK_CNT, secCount);
-    }
-
-    /* If input buffer is word aligned use DMA */
-    if (!(((uint_fast32_t)buf) & 0x03)) {
-        object->writeBuf = (uint_fast32_t *)buf;
-        object->writeSecCount = secCount;
+    /* Wait for the write to complete */
+    SemaphoreP_pend((SemaphoreP_Handle)transaction.arg,
+        SemaphoreP_WAIT_FOREVER);
+    SemaphoreP_destruct(&done);
 
-        /* Configure Primary structure */
-        configDMAChannel(handle, UDMA_PRI_SELECT, UDMAWRITE);
-
-        /* Add offset to input buffer */
-        object->writeBuf = (uint_fast32_t *)((uint_least8_t *)buf +
-            SECTORSIZE);
-        /* Configure alternate control structure */
-        configDMAChannel(handle, UDMA_ALT_SELECT, UDMAWRITE);
-
-        /* Verify that the block count had been previous set */
-        if (result == SD_STATUS_SUCCESS) {
-            result = send_cmd(handle, CMD_WRITE_MULTI_BLK | SDHOST_DMA_EN,
-                sector);
-        }
-
-        if (result == SD_STATUS_SUCCESS) {
-            /* Wait for DMA write(s) to complete */
-            MAP_SDHostIntEnable(hwAttrs->baseAddr, SDHOST_INT_DMAWR);
-
-            SemaphoreP_pend(object->cmdSem, SemaphoreP_WAIT_FOREVER);
-
-            MAP_SDHostIntDisable(hwAttrs->baseAddr, SDHOST_INT_DMAWR);
-        }
-
-    }
-    else {
-        /* Compute the number of words to write */
-        size = (SECTORSIZE * secCount) / 4;
-
-        /* Verify that the block count had been previous set */
-        if (result == SD_STATUS_SUCCESS) {
-            result = send_cmd(handle, CMD_WRITE_MULTI_BLK, sector);
-        }
-
-        if (result == SD_STATUS_SUCCESS) {
-            /* Write single word of data */
-            while (size > 0) {
-                ret = MAP_SDHostDataNonBlockingWrite(hwAttrs->baseAddr,
-                    (*(unsigned long *)buf));
+    return (transaction.status);
+}
 
-                /* Block until buffer is ready */
-                if (ret == 0) {
-                    MAP_SDHostIntEnable(hwAttrs->baseAddr, SDHOST_INT_BWR);
+/*
+ *  ======== SDHostCC32XX_writeAsync ========
+ */
+int_fast16_t SDHostCC32XX_writeAsync(SD_Handle handle,
+    SD_Transaction *transaction)
+{
+    return (submitTransaction(handle, transaction, true));
+}
 
-                    SemaphoreP_pend(object->cmdSem, SemaphoreP_WAIT_FOREVER);
+/*
+ *  ======== completeRun ========
+ *  Completes all transactions of the transfer in progress with the given
+ *  status & starts the next queued transfer, unless a command caller is
+ *  waiting for the transfer to complete.  Called from hwiIntFxn.
+ */
+static void completeRun(SD_Handle handle, int_fast16_t status)
+{
+    List_List            doneList;
+    SD_Transaction      *transaction;
+    SDHostCC32XX_Object *object = handle->object;
 
-                    MAP_SDHostIntDisable(hwAttrs->baseAddr, SDHOST_INT_BWR);
-                }
-                else {
-                    buf = (uint_least8_t *)buf + 4;
-                    size--;
-                }
-            }
-        }
-    }
+    /*
+     * Detach the completed transactions first; callbacks are free to queue
+     * new transactions which may immediately start a new transfer.
+     */
+    doneList = object->runList;
+    List_clearList(&object->runList);
+    object->xferState = XFER_IDLE;
 
-    /* Verify host controller errors didn't occur */
-    if (object->stat == SD_STATUS_SUCCESS) {
-        /* Wait for the full data transfer to complete */
-        MAP_SDHostIntEnable(hwAttrs->baseAddr, SDHOST_INT_TC);
+    while ((transaction = (SD_Transaction *)List_get(&doneList)) != NULL) {
+        transaction->status = status;
 
-        SemaphoreP_pend(object->cmdSem, SemaphoreP_WAIT_FOREVER);
+        Power_releaseConstraint(PowerCC32XX_DISALLOW_LPDS);
 
-        MAP_SDHostIntDisable(hwAttrs->baseAddr, SDHOST_INT_TC);
+        transaction->callbackFxn(handle, transaction);
     }
 
-    /* Verify host controller errors didn't occur */
-    if (object->stat == SD_STATUS_SUCCESS) {
-        /* Wait for command transfer stop acknowledgement */
-        result = send_cmd(handle, CMD_STOP_TRANS, NULLARG);
-
-        if (result ==  SD_STATUS_SUCCESS) {
-            MAP_SDHostIntEnable(hwAttrs->baseAddr, SDHOST_INT_TC);
-
-            SemaphoreP_pend(object->cmdSem, SemaphoreP_WAIT_FOREVER);
-
-            MAP_SDHostIntDisable(hwAttrs->baseAddr, SDHOST_INT_TC);
-        }
+    if (object->cmdPending) {
+        /* Unblock holdQueue(); the queue is restarted by releaseQueue() */
+        SemaphoreP_post(object->cmdSem);
     }
-
-    if (object->stat != SD_STATUS_SUCCESS) {
-        result = SD_STATUS_ERROR;
+    else {
+        startRun(handle);
     }
-
-    Power_releaseConstraint(PowerCC32XX_DISALLOW_LPDS);
-    DebugP_log1("SDHost:(%p) SDHostCC32XX_write released write power"
-        " constraint", hwAttrs->baseAddr);
-
-    return (result);
 }
 
 /*
  *  ======== configDMAChannel ========
- *  Configures either the primary or alternate DMA control structures in
- *  ping-pong mode.
- *  channelSel is the PRI or ALT channel select flag
+ *  Configures either the primary (chan 0) or alternate (chan 1) DMA control
+ *  structure in ping-pong mode for the next sector of the transfer in
+ *  progress.  Sectors of buffers which are not word aligned are transferred
+ *  through the channel's bounce buffer.
  */
-static void configDMAChannel(SD_Handle handle, uint_fast32_t channelSel,
-    uint_fast32_t operation)
+static void configDMAChannel(SD_Handle handle, uint_fast8_t chan)
 {
+    uint8_t                      *buf;
+    void                         *dmaBuf;
+    unsigned long                 channelSel;
     unsigned long                 channelControlOptions;
+    SD_Transaction               *transaction;
     SDHostCC32XX_Object          *object = handle->object;
     SDHostCC32XX_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
 
-    if (operation == UDMAWRITE) {
+    channelSel = (chan == 0) ? UDMA_PRI_SELECT : UDMA_ALT_SELECT;
+
+    transaction = object->dmaTransaction;
+    buf = (uint8_t *)transaction->buf + (object->dmaSector * SECTORSIZE);
+    object->chanBuf[chan] = buf;
+
+    if (((uintptr_t)buf) & 0x03) {
+        dmaBuf = object->bounceBuf[chan];
+        if (object->runIsWrite) {
+            memcpy(dmaBuf, buf, SECTORSIZE);
+        }
+    }
+    else {
+        dmaBuf = buf;
+    }
+
+    /* Move on to the next sector; possibly of the next merged transaction */
+    if (++object->dmaSector == transaction->secCount) {
+        object->dmaSector = 0;
+        object->dmaTransaction =
+            (SD_Transaction *)List_next(&transaction->qElem);
+    }
+
+    if (object->runIsWrite) {
         channelControlOptions = UDMA_SIZE_32 | UDMA_SRC_INC_32 |
             UDMA_DST_INC_NONE | UDMA_ARB_512;
 
-        /* Primary control structure set-up */
         MAP_uDMAChannelControlSet(hwAttrs->txChIdx |
             channelSel, channelControlOptions);
 
         /* Transfer size is the sector size in words */
         MAP_uDMAChannelTransferSet(hwAttrs->txChIdx | channelSel,
-            UDMA_MODE_PINGPONG, (void *)object->writeBuf,
+            UDMA_MODE_PINGPONG, dmaBuf,
             (void *)(hwAttrs->baseAddr + MMCHS_O_DATA), SECTORSIZE / 4);
 
         /* Enable the DMA channel */
@@ -826,14 +772,13 @@ static void configDMAChannel(SD_Handle handle, uint_fast32_t channelSel,
         channelControlOptions = UDMA_SIZE_32 | UDMA_SRC_INC_NONE |
                 UDMA_DST_INC_32 | UDMA_ARB_512;
 
-        /* Primary control structure set-up */
         MAP_uDMAChannelControlSet(hwAttrs->rxChIdx |
             channelSel, channelControlOptions);
 
         /* Transfer size is the sector size in words */
         MAP_uDMAChannelTransferSet(hwAttrs->rxChIdx | channelSel,
             UDMA_MODE_PINGPONG, (void *)(hwAttrs->baseAddr + MMCHS_O_DATA),
-            (void *)object->readBuf, SECTORSIZE / 4);
+            dmaBuf, SECTORSIZE / 4);
 
         /* Enable the DMA channel */
         MAP_uDMAChannelEnable(hwAttrs->rxChIdx);
@@ -867,6 +812,82 @@ static uint_fast32_t getPowerMgrId(uint_fast32_t baseAddr)
     }
 }
 
+/*
+ *  ======== dmaIntFxn ========
+ *  Services the completion of a sector DMA during a read or write transfer.
+ */
+static void dmaIntFxn(SD_Handle handle, uint_fast32_t dmaInt,
+    unsigned long chIdx)
+{
+    uint_fast8_t                  chan;
+    uint_fast32_t                 priChannelMode;
+    uint_fast32_t                 altChannelMode;
+    SDHostCC32XX_Object          *object = handle->object;
+    SDHostCC32XX_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
+
+    /* Sectors complete alternately on the primary & alternate channels */
+    chan = object->nextChan;
+    object->nextChan ^= 1;
+
+    priChannelMode = MAP_uDMAChannelModeGet(chIdx | UDMA_PRI_SELECT);
+    altChannelMode = MAP_uDMAChannelModeGet(chIdx | UDMA_ALT_SELECT);
+
+    /* Corner case in which a DMA interrupt is missed, (both completed) */
+    if ((priChannelMode != UDMA_MODE_STOP) ||
+        (altChannelMode != UDMA_MODE_STOP)) {
+        MAP_SDHostIntClear(hwAttrs->baseAddr, dmaInt);
+    }
+
+    /* Copy data received through the bounce buffer to the application */
+    if (!object->runIsWrite && (((uintptr_t)object->chanBuf[chan]) & 0x03)) {
+        memcpy(object->chanBuf[chan], object->bounceBuf[chan], SECTORSIZE);
+    }
+
+    /* Check if transfer is complete */
+    if (--object->runSecCount == 0) {
+        MAP_SDHostIntClear(hwAttrs->baseAddr, dmaInt);
+        MAP_SDHostIntDisable(hwAttrs->baseAddr, dmaInt);
+
+        /* Reset to primary channel */
+        MAP_uDMAChannelAttributeDisable(chIdx, UDMA_ATTR_ALTSELECT);
+
+        /* Wait for the full data transfer to complete */
+        object->xferState = XFER_DATA_DONE;
+        MAP_SDHostIntEnable(hwAttrs->baseAddr, SDHOST_INT_TC);
+    }
+    else if (object->dmaTransaction != NULL) {
+        /* Set-up the next sector on the channel which completed */
+        configDMAChannel(handle, chan);
+    }
+}
+
+/*
+ *  ======== holdQueue ========
+ *  Holds off the request queue & waits for the transfer in progress (if any)
+ *  to complete, so that commands can be sent to the card.  Must be paired
+ *  with releaseQueue().
+ */
+static void holdQueue(SD_Handle handle)
+{
+    uintptr_t            key;
+    SDHostCC32XX_Object *object = handle->object;
+
+    key = HwiP_disable();
+
+    object->cmdPending = true;
+
+    while (object->xferState != XFER_IDLE) {
+        HwiP_restore(key);
+
+        /* Posted by completeRun() */
+        SemaphoreP_pend(object->cmdSem, SemaphoreP_WAIT_FOREVER);
+
+        key = HwiP_disable();
+    }
+
+    HwiP_restore(key);
+}
+
 /*
  *  ======== hwiIntFxn ========
  *  ISR to service pending SD or DMA commands.
@@ -874,16 +895,18 @@ static uint_fast32_t getPowerMgrId(uint_fast32_t baseAddr)
 static void hwiIntFxn(uintptr_t handle)
 {
     uint_fast32_t                 ret;
-    uint_fast32_t                 priChannelMode;
-    uint_fast32_t                 altChannelMode;
     SDHostCC32XX_Object          *object = ((SD_Handle)handle)->object;
     SDHostCC32XX_HWAttrsV1 const *hwAttrs = ((SD_Handle)handle)->hwAttrs;
 
     /* Get interrupt status */
     ret = MAP_SDHostIntStatus(hwAttrs->baseAddr);
 
+    /* Read & write transfers are driven entirely from the ISR */
+    if (object->xferState != XFER_IDLE) {
+        transferIntFxn((SD_Handle)handle, ret);
+    }
     /* Don't unblock if an error occurred */
-    if (ret & SDHOST_INT_ERRI) {
+    else if (ret & SDHOST_INT_ERRI) {
         /* Clear any spurious interrupts caused by the error */
         MAP_SDHostIntClear(hwAttrs->baseAddr, SDHOST_INT_CC | SDHOST_INT_TC |
             DATAERROR | CMDERROR);
@@ -898,101 +921,11 @@ static void hwiIntFxn(uintptr_t handle)
         MAP_SDHostIntClear(hwAttrs->baseAddr, SDHOST_INT_CC);
         SemaphoreP_post(object->cmdSem);
     }
-    /* DMA read complete flag */
-    else if (ret & SDHOST_INT_DMARD) {
-        object->readSecCount--;
-
-        priChannelMode = MAP_uDMAChannelModeGet(hwAttrs->rxChIdx |
-            UDMA_PRI_SELECT);
-        altChannelMode = MAP_uDMAChannelModeGet(hwAttrs->rxChIdx |
-            UDMA_ALT_SELECT);
-
-        /* Corner case in which a DMA interrupt is missed, (both completed) */
-        if ((priChannelMode != UDMA_MODE_STOP) ||
-            (altChannelMode != UDMA_MODE_STOP)) {
-            MAP_SDHostIntClear(hwAttrs->baseAddr, SDHOST_INT_DMARD);
-        }
-
-        /* Check if transfer is complete */
-        if (object->readSecCount == 0) {
-            MAP_SDHostIntClear(hwAttrs->baseAddr, SDHOST_INT_DMARD);
-
-            object->stat = SD_STATUS_SUCCESS;
-
-            /* Reset to primary channel */
-            MAP_uDMAChannelAttributeDisable(hwAttrs->rxChIdx,
-                UDMA_ATTR_ALTSELECT);
-            SemaphoreP_post(object->cmdSem);
-        }
-        else {
-            /* Set-up next portion of buffer to be written to */
-            object->readBuf = object->readBuf + (SECTORSIZE / 4);
-
-            /* Check if primary channel completed */
-            if (priChannelMode == UDMA_MODE_STOP) {
-                configDMAChannel((SD_Handle)handle, UDMA_PRI_SELECT, UDMAREAD);
-            }
-            /* Secondary completed */
-            else {
-                configDMAChannel((SD_Handle)handle, UDMA_ALT_SELECT, UDMAREAD);
-            }
-        }
-    }
-    /* DMA write complete flag */
-    else if (ret & SDHOST_INT_DMAWR) {
-        object->writeSecCount--;
-
-        priChannelMode = MAP_uDMAChannelModeGet(hwAttrs->txChIdx |
-            UDMA_PRI_SELECT);
-        altChannelMode = MAP_uDMAChannelModeGet(hwAttrs->txChIdx |
-            UDMA_ALT_SELECT);
-
-        /* Corner case in which a DMA interrupt is missed (both completed) */
-        if ((priChannelMode != UDMA_MODE_STOP) ||
-            (altChannelMode != UDMA_MODE_STOP)) {
-            MAP_SDHostIntClear(hwAttrs->baseAddr, SDHOST_INT_DMAWR);
-        }
-
-        /* Check if transfer is complete */
-        if (object->writeSecCount == 0) {
-            MAP_SDHostIntClear(hwAttrs->baseAddr, SDHOST_INT_DMAWR);
-
-            object->stat = SD_STATUS_SUCCESS;
-
-            /* Reset to primary channel */
-            MAP_uDMAChannelAttributeDisable(hwAttrs->txChIdx,
-                UDMA_ATTR_ALTSELECT);
-            SemaphoreP_post(object->cmdSem);
-        }
-        else {
-            /* Set-up next portion of buffer to be written to */
-            object->writeBuf = object->writeBuf + (SECTORSIZE / 4);
-
-            /* Check if primary channel completed */
-            if (priChannelMode == UDMA_MODE_STOP) {
-                configDMAChannel((SD_Handle)handle, UDMA_PRI_SELECT,
-                    UDMAWRITE);
-            }
-            /* Secondary completed */
-            else {
-                configDMAChannel((SD_Handle)handle, UDMA_ALT_SELECT,
-                    UDMAWRITE);
-            }
-        }
-    }
     else {
         /* Transfer complete flag */
         if (ret & SDHOST_INT_TC) {
             MAP_SDHostIntClear(hwAttrs->baseAddr, SDHOST_INT_TC);
         }
-        /* Data buffer read ready flag */
-        else if (ret & SDHOST_INT_BRR) {
-            MAP_SDHostIntClear(hwAttrs->baseAddr, SDHOST_INT_BRR);
-        }
-        /* Data buffer write ready flag */
-        else if (ret & SDHOST_INT_BWR) {
-            MAP_SDHostIntClear(hwAttrs->baseAddr, SDHOST_INT_BWR);
-        }
         object->stat = SD_STATUS_SUCCESS;
         SemaphoreP_post(object->cmdSem);
     }
@@ -1041,20 +974,18 @@ static void initHw(SD_Handle handle)
 
     /*
      * DMA channels 23 and 24 are connected to the SD peripheral by default.
-     * If someone hasn't remapped them to something else already, we remap
-     * them to SW.
+     * If they are not the channels reserved by this driver & someone hasn't
+     * remapped them to something else already, we remap them to SW.
      */
-    if (!(HWREG(UDMA_BASE + UDMA_O_CHMAP2) & UDMA_CHMAP2_CH23SEL_M)) {
+    if (((hwAttrs->rxChIdx & 0x1F) != 23) &&
+        !(HWREG(UDMA_BASE + UDMA_O_CHMAP2) & UDMA_CHMAP2_CH23SEL_M)) {
         MAP_uDMAChannelAssign(UDMA_CH23_SW);
     }
-    if (!(HWREG(UDMA_BASE + UDMA_O_CHMAP3) & UDMA_CHMAP3_CH24SEL_M)) {
+    if (((hwAttrs->txChIdx & 0x1F) != 24) &&
+        !(HWREG(UDMA_BASE + UDMA_O_CHMAP3) & UDMA_CHMAP3_CH24SEL_M)) {
         MAP_uDMAChannelAssign(UDMA_CH24_SW);
     }
 
-    /* Configure DMA for TX and RX */
-    MAP_uDMAChannelAssign(hwAttrs->txChIdx);
-    MAP_uDMAChannelAssign(hwAttrs->rxChIdx);
-
     /* Enable SDHost Error Interrupts */
     MAP_SDHostIntEnable(hwAttrs->baseAddr, DATAERROR | CMDERROR);
 }
@@ -1072,6 +1003,23 @@ static int postNotifyFxn(unsigned int eventType, uintptr_t eventArg,
     return (Power_NOTIFYDONE);
 }
 
+/*
+ *  ======== releaseQueue ========
+ *  Restarts the request queue held off by holdQueue().
+ */
+static void releaseQueue(SD_Handle handle)
+{
+    uintptr_t            key;
+    SDHostCC32XX_Object *object = handle->object;
+
+    key = HwiP_disable();
+
+    object->cmdPending = false;
+    startRun(handle);
+
+    HwiP_restore(key);
+}
+
 /*
  *  ======== send_cmd ========
  *  Function to send a command to the SD Card
@@ -1130,3 +1078,275 @@ static int_fast32_t selectCard(SD_Handle handle)
     }
     return (result);
 }
+
+/*
+ *  ======== startRun ========
+ *  Starts a transfer for the transaction at the head of the queue, merged
+ *  with any following transactions which continue its sector range in the
+ *  same direction.  Must be called with interrupts disabled or from
+ *  hwiIntFxn.
+ */
+static void startRun(SD_Handle handle)
+{
+    uint_fast32_t                 dmaInt;
+    uint_fast32_t                 secCount;
+    int_fast32_t                  nextSector;
+    SD_Transaction               *transaction;
+    SD_Transaction               *next;
+    SDHostCC32XX_Object          *object = handle->object;
+    SDHostCC32XX_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
+
+    if ((object->xferState != XFER_IDLE) || object->cmdPending ||
+        List_empty(&object->transactionList)) {
+        return;
+    }
+
+    transaction = (SD_Transaction *)List_get(&object->transactionList);
+    List_put(&object->runList, &transaction->qElem);
+
+    secCount = transaction->secCount;
+    nextSector = transaction->sector + transaction->secCount;
+
+    /* Merge queued transactions which continue the sector range */
+    next = (SD_Transaction *)List_head(&object->transactionList);
+    while ((next != NULL) && (next->isWrite == transaction->isWrite) &&
+        (next->sector == nextSector) &&
+        ((secCount + next->secCount) <= MAXBLOCKCOUNT)) {
+        List_get(&object->transactionList);
+        List_put(&object->runList, &next->qElem);
+
+        secCount += next->secCount;
+        nextSector += next->secCount;
+
+        next = (SD_Transaction *)List_head(&object->transactionList);
+    }
+
+    object->runIsWrite = transaction->isWrite;
+    object->runStatus = SD_STATUS_SUCCESS;
+    object->runSecCount = secCount;
+    object->dmaTransaction = transaction;
+    object->dmaSector = 0;
+    object->nextChan = 0;
+
+    /* SDSC uses linear address, SDHC uses block address */
+    object->runAddress = transaction->sector;
+    if (object->cardType == SD_SDSC) {
+        object->runAddress *= SECTORSIZE;
+    }
+
+    DebugP_log2("SDHost:(%p) starting transfer of %d sectors",
+        hwAttrs->baseAddr, secCount);
+
+    /* Set the block count */
+    MAP_SDHostBlockCountSet(hwAttrs->baseAddr, secCount);
+
+    /* Configure primary & (if needed) alternate DMA control structures */
+    configDMAChannel(handle, 0);
+    if (object->dmaTransaction != NULL) {
+        configDMAChannel(handle, 1);
+    }
+
+    dmaInt = (object->runIsWrite) ? SDHOST_INT_DMAWR : SDHOST_INT_DMARD;
+    MAP_SDHostIntClear(hwAttrs->baseAddr, dmaInt);
+
+    MAP_SDHostIntEnable(hwAttrs->baseAddr, SDHOST_INT_CC);
+
+    if (object->runIsWrite) {
+        /* Set the card write block count (ACMD23) prior to writing */
+        object->xferState = XFER_APP_CMD;
+        MAP_SDHostCmdSend(hwAttrs->baseAddr, CMD_APP_CMD, object->rca << 16);
+    }
+    else {
+        /* Send multi block read command */
+        object->xferState = XFER_CMD;
+        MAP_SDHostCmdSend(hwAttrs->baseAddr,
+            CMD_READ_MULTI_BLK | SDHOST_DMA_EN, object->runAddress);
+    }
+}
+
+/*
+ *  ======== submitTransaction ========
+ *  Queues a read or write transaction & starts it if the driver is idle.
+ */
+static int_fast16_t submitTransaction(SD_Handle handle,
+    SD_Transaction *transaction, bool isWrite)
+{
+    uintptr_t            key;
+    SDHostCC32XX_Object *object = handle->object;
+
+    /* Check for valid sector count */
+    if ((transaction->secCount == 0) ||
+        (transaction->secCount > MAXBLOCKCOUNT) ||
+        (transaction->callbackFxn == NULL)) {
+        return (SD_STATUS_ERROR);
+    }
+
+    transaction->isWrite = isWrite;
+    transaction->status = SD_STATUS_ERROR;
+
+    /* Released once the transaction has completed */
+    Power_setConstraint(PowerCC32XX_DISALLOW_LPDS);
+
+    key = HwiP_disable();
+
+    List_put(&object->transactionList, &transaction->qElem);
+    startRun(handle);
+
+    HwiP_restore(key);
+
+    return (SD_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== transferIntFxn ========
+ *  Advances the read or write transfer in progress.  Called from hwiIntFxn.
+ */
+static void transferIntFxn(SD_Handle handle, uint_fast32_t status)
+{
+    uint_fast32_t                 dmaInt;
+    unsigned long                 chIdx;
+    SD_Transaction               *transaction;
+    SDHostCC32XX_Object          *object = handle->object;
+    SDHostCC32XX_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
+
+    if (object->runIsWrite) {
+        dmaInt = SDHOST_INT_DMAWR;
+        chIdx = hwAttrs->txChIdx;
+    }
+    else {
+        dmaInt = SDHOST_INT_DMARD;
+        chIdx = hwAttrs->rxChIdx;
+    }
+
+    if (status & SDHOST_INT_ERRI) {
+        DebugP_log1("SDHost:(%p) transfer failed", hwAttrs->baseAddr);
+
+        /* Clear any spurious interrupts caused by the error */
+        MAP_SDHostIntDisable(hwAttrs->baseAddr, SDHOST_INT_CC |
+            SDHOST_INT_TC | dmaInt);
+        MAP_SDHostIntClear(hwAttrs->baseAddr, SDHOST_INT_CC | SDHOST_INT_TC |
+            DATAERROR | CMDERROR | dmaInt);
+
+        /* Abort the DMA & reset the command line */
+        MAP_uDMAChannelDisable(chIdx);
+        MAP_uDMAChannelAttributeDisable(chIdx, UDMA_ATTR_ALTSELECT);
+        MAP_SDHostCmdReset(hwAttrs->baseAddr);
+
+        if ((object->xferState == XFER_CMD) ||
+            (object->xferState == XFER_DATA) ||
+            (object->xferState == XFER_DATA_DONE)) {
+            /*
+             * The card may be left in the data or receive state; stop the
+             * transfer & wait for busy to return it to the transfer state
+             * before the next transfer is started.
+             */
+            object->runStatus = SD_STATUS_ERROR;
+            object->xferState = XFER_STOP_CMD;
+            MAP_SDHostIntEnable(hwAttrs->baseAddr, SDHOST_INT_CC);
+            MAP_SDHostCmdSend(hwAttrs->baseAddr, CMD_STOP_TRANS, NULLARG);
+        }
+        else {
+            if ((object->xferState == XFER_STOP_CMD) ||
+                (object->xferState == XFER_STOP_BUSY)) {
+                /*
+                 * The card did not leave the data or receive state; fail
+                 * the queued transactions rather than start them on it.
+                 */
+                while ((transaction = (SD_Transaction *)
+                    List_get(&object->transactionList)) != NULL) {
+                    List_put(&object->runList, &transaction->qElem);
+                }
+            }
+
+            completeRun(handle, SD_STATUS_ERROR);
+        }
+        return;
+    }
+
+    switch (object->xferState) {
+        case XFER_APP_CMD:
+            if (status & SDHOST_INT_CC) {
+                MAP_SDHostIntClear(hwAttrs->baseAddr, SDHOST_INT_CC);
+
+                object->xferState = XFER_SET_BLK_CNT;
+                MAP_SDHostCmdSend(hwAttrs->baseAddr, CMD_SET_BLK_CNT,
+                    object->runSecCount);
+            }
+            break;
+
+        case XFER_SET_BLK_CNT:
+            if (status & SDHOST_INT_CC) {
+                MAP_SDHostIntClear(hwAttrs->baseAddr, SDHOST_INT_CC);
+
+                /* Send multi block write command */
+                object->xferState = XFER_CMD;
+                MAP_SDHostCmdSend(hwAttrs->baseAddr,
+                    CMD_WRITE_MULTI_BLK | SDHOST_DMA_EN, object->runAddress);
+            }
+            break;
+
+        case XFER_CMD:
+            if (status & SDHOST_INT_CC) {
+                MAP_SDHostIntClear(hwAttrs->baseAddr, SDHOST_INT_CC);
+                MAP_SDHostIntDisable(hwAttrs->baseAddr, SDHOST_INT_CC);
+
+                /* Wait for DMA read(s)/write(s) to complete */
+                object->xferState = XFER_DATA;
+                MAP_SDHostIntEnable(hwAttrs->baseAddr, dmaInt);
+            }
+            break;
+
+        case XFER_DATA:
+            if (status & dmaInt) {
+                dmaIntFxn(handle, dmaInt, chIdx);
+            }
+            break;
+
+        case XFER_DATA_DONE:
+            if (status & SDHOST_INT_TC) {
+                MAP_SDHostIntClear(hwAttrs->baseAddr, SDHOST_INT_TC);
+                MAP_SDHostIntDisable(hwAttrs->baseAddr, SDHOST_INT_TC);
+
+                /* Stop the multi block transfer */
+                object->xferState = XFER_STOP_CMD;
+                MAP_SDHostIntEnable(hwAttrs->baseAddr, SDHOST_INT_CC);
+                MAP_SDHostCmdSend(hwAttrs->baseAddr, CMD_STOP_TRANS, NULLARG);
+            }
+            break;
+
+        case XFER_STOP_CMD:
+            if (status & SDHOST_INT_CC) {
+                MAP_SDHostIntClear(hwAttrs->baseAddr, SDHOST_INT_CC);
+                MAP_SDHostIntDisable(hwAttrs->baseAddr, SDHOST_INT_CC);
+
+                /* Wait for command transfer stop acknowledgement */
+                object->xferState = XFER_STOP_BUSY;
+                MAP_SDHostIntEnable(hwAttrs->baseAddr, SDHOST_INT_TC);
+            }
+            break;
+
+        case XFER_STOP_BUSY:
+            if (status & SDHOST_INT_TC) {
+                MAP_SDHostIntClear(hwAttrs->baseAddr, SDHOST_INT_TC);
+                MAP_SDHostIntDisable(hwAttrs->baseAddr, SDHOST_INT_TC);
+
+                completeRun(handle, object->runStatus);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/*
+ *  ======== xferCallback ========
+ *  Callback used by SDHostCC32XX_read() & SDHostCC32XX_write() to unblock
+ *  the calling task, which passes its semaphore in transaction->arg.
+ */
+static void xferCallback(SD_Handle handle, SD_Transaction *transaction)
+{
+    (void)handle;
+
+    SemaphoreP_post((SemaphoreP_Handle)transaction->arg);
+}
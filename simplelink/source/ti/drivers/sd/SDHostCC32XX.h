@@ -47,14 +47,33 @@
  *  SD Host controller using a micro DMA controller.
  *
  *  Note: The driver API's are not thread safe and must not be accessed through
- *      multiple threads without the use of mutexes.
+ *      multiple threads without the use of mutexes.  SD_close() must not be
+ *      called while asynchronous transfers are pending.
+ *
+ *  ## Request queue #
+ *
+ *  All reads & writes (SD_read(), SD_write(), SD_readAsync() &
+ *  SD_writeAsync()) are placed on a request queue which is processed from
+ *  the SD Host interrupt.  SD_read() & SD_write() block until their request
+ *  has completed; the asynchronous variants return immediately.  When a
+ *  transfer is started, queued requests for the same direction which
+ *  continue the sector range of the request at the head of the queue are
+ *  merged into one multi-block transfer on the card.
+ *
+ *  SD_initialize() & SD_getNumSectors() issue their commands between
+ *  transfers: they wait for the transfer in progress to complete & hold off
+ *  the queued requests until their commands have completed.
+ *
+ *  When a transfer fails, CMD12 is sent to return the card to the transfer
+ *  state before the next queued request is started.  If the card does not
+ *  respond to it, all queued requests are completed with SD_STATUS_ERROR.
  *
  *  ## DMA buffer alignment #
  *
- *  When performing disk operations with a word aligned buffer the driver will
- *  make transfers using the DMA controller. Alternatively, if the buffer is
- *  not aligned, the data will be copied to the internal SD Host controller
- *  buffer using a polling method.
+ *  All data is moved using the DMA controller.  Word aligned buffers are
+ *  transferred directly; sectors of buffers which are not word aligned are
+ *  transferred through a pair of word aligned bounce buffers inside the
+ *  driver object & copied to/from the application buffer by the CPU.
  *
  *  ## DMA Interrupts #
  *
@@ -77,8 +96,10 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <ti/drivers/SD.h>
+#include <ti/drivers/utils/List.h>
 
 #include <ti/drivers/dpl/HwiP.h>
 #include <ti/drivers/dpl/SemaphoreP.h>
@@ -93,6 +114,9 @@ extern "C" {
 #define SDHostCC32XX_PIN_02_SDCARD_CMD   0x0601
 #define SDHostCC32XX_PIN_64_SDCARD_DATA  0x063f
 
+/* Size (in 32-bit words) of each of the two DMA bounce buffers */
+#define SDHostCC32XX_BOUNCE_BUF_WORDS    (512 / 4)
+
 /* SDHost function table */
 extern const SD_FxnTable sdHostCC32XX_fxnTable;
 
@@ -165,17 +189,32 @@ typedef struct SDHostCC32XX_HWAttrsV1 {
 typedef struct SDHostCC32XX_Object {
     /* Relative Card Address */
     uint_fast32_t              rca;
-    /* Write data pointer */
-    const uint_fast32_t       *writeBuf;
-    /* Number of sectors written */
-    volatile uint_fast32_t     writeSecCount;
-    /* Read data pointer */
-    uint_fast32_t             *readBuf;
-    /* Number of sectors read */
-    volatile uint_fast32_t     readSecCount;
+    /* Queue of transactions waiting to be transferred */
+    List_List                  transactionList;
+    /* Transactions merged into the transfer in progress */
+    List_List                  runList;
+    /* Transaction & sector index of the next sector to be set up for DMA */
+    SD_Transaction            *dmaTransaction;
+    uint_fast32_t              dmaSector;
+    /* Number of sectors of the transfer in progress left to complete */
+    uint_fast32_t              runSecCount;
+    /* Card address of the first sector of the transfer in progress */
+    uint_fast32_t              runAddress;
+    /* Application buffer of the sector set up on the PRI & ALT channels */
+    uint8_t                   *chanBuf[2];
+    /* DMA channel (0 = PRI, 1 = ALT) expected to complete next */
+    uint_fast8_t               nextChan;
+    /* Step of the transfer in progress */
+    volatile uint_fast8_t      xferState;
+    /* Direction of the transfer in progress */
+    bool                       runIsWrite;
+    /* Status the transfer in progress is completed with */
+    int_fast16_t               runStatus;
+    /* Set while a command caller holds off the request queue */
+    volatile bool              cmdPending;
     /*
      *  Semaphore to suspend thread execution when waiting for SD Commands
-     *  or data transfers to complete.
+     *  to complete.
      */
     SemaphoreP_Handle      cmdSem;
     /*
@@ -198,6 +237,8 @@ typedef struct SDHostCC32XX_Object {
     bool                   isOpen;
     /* SDCard Card Command Class(CCC) */
     SD_CardType            cardType;
+    /* Word aligned DMA buffers for application buffers which are not */
+    uint32_t               bounceBuf[2][SDHostCC32XX_BOUNCE_BUF_WORDS];
 } SDHostCC32XX_Object;
 
 #ifdef __cplusplus
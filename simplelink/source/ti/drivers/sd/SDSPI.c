@@ -36,6 +36,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include <ti/drivers/dpl/ClockP.h>
 #include <ti/drivers/dpl/HwiP.h>
@@ -66,6 +67,20 @@
 #define STOP_MULTIBLOCK_TOKEN     (0xFD)
 
 #define SD_SECTOR_SIZE            (512)
+#define SD_CRC_SIZE               (2)
+
+/*
+ * Number of bytes following a block's CRC that are clocked in (in the same
+ * SPI transfer) while looking for the next block's START_BLOCK_TOKEN during
+ * multi-block reads.
+ */
+#define SD_TOKEN_LOOKAHEAD        (8)
+
+/* Number of bytes clocked per SPI transfer while the SD card is busy */
+#define SD_BUSY_POLL_SIZE         (8)
+
+/* Default SPI bit rate used for data transfers after initialization */
+#define SD_DEFAULT_BITRATE        (2500000)
 
 #define DRIVE_NOT_MOUNTED         ((uint16_t) ~0)
 
@@ -84,11 +99,15 @@ int_fast16_t SDSPI_write(SD_Handle handle, const void *buf,
 
 static inline void assertCS(SDSPI_HWAttrs const *hwAttrs);
 static inline void deassertCS(SDSPI_HWAttrs const *hwAttrs);
-static bool recvDataBlock(SPI_Handle handle, void *buf, uint32_t count);
+static bool recvDataBlocks(SPI_Handle handle, uint8_t *buf, uint32_t count,
+    uint32_t numBlocks);
+static void recordStats(SDSPI_TransferStats *stats, uint32_t sectorCount,
+    uint32_t startTime);
 static uint8_t sendCmd(SPI_Handle handle, uint8_t cmd, uint32_t arg);
 static int_fast16_t sendInitialClockTrain(SPI_Handle handle);
 static int_fast16_t spiTransfer(SPI_Handle handle, void *rxBuf,
     void *txBuf, size_t count);
+static bool waitForStartToken(SPI_Handle handle);
 static bool waitUntilReady(SPI_Handle handle);
 static bool transmitDataBlock(SPI_Handle handle, void *buf, uint32_t count,
     uint8_t token);
@@ -103,7 +122,9 @@ const SD_FxnTable SDSPI_fxnTable = {
     SDSPI_initialize,
     SDSPI_open,
     SDSPI_read,
-    SDSPI_write
+    SDSPI_write,
+    NULL,           /* readAsyncFxn: SD_readAsync() falls back to read */
+    NULL            /* writeAsyncFxn: SD_writeAsync() falls back to write */
 };
 
 /*
@@ -133,7 +154,30 @@ void SDSPI_close(SD_Handle handle)
 int_fast16_t SDSPI_control(SD_Handle handle, uint_fast16_t cmd,
     void *arg)
 {
-    return (SD_STATUS_UNDEFINEDCMD);
+    uintptr_t     key;
+    ClockP_FreqHz freq;
+    SDSPI_Object *object = handle->object;
+
+    switch (cmd) {
+        case SDSPI_CMD_GET_STATS:
+            key = HwiP_disable();
+            *((SDSPI_Stats *) arg) = object->stats;
+            HwiP_restore(key);
+            ClockP_getTimestampFreq(&freq);
+            ((SDSPI_Stats *) arg)->timestampFreq = freq.lo;
+
+            return (SD_STATUS_SUCCESS);
+
+        case SDSPI_CMD_CLEAR_STATS:
+            key = HwiP_disable();
+            memset(&object->stats, 0, sizeof(object->stats));
+            HwiP_restore(key);
+
+            return (SD_STATUS_SUCCESS);
+
+        default:
+            return (SD_STATUS_UNDEFINEDCMD);
+    }
 }
 
 /*
@@ -154,7 +198,7 @@ uint_fast32_t SDSPI_getNumSectors(SD_Handle handle)
 
     /* Get number of sectors on the disk (uint32_t) */
     if ((sendCmd(object->spiHandle, CMD9, 0) == 0) &&
-        recvDataBlock(object->spiHandle, csd, 16)) {
+        recvDataBlocks(object->spiHandle, csd, 16, 1)) {
         /* SDC ver 2.00 */
         if ((csd[0] >> 6) == 1) {
             csize = csd[9] + (csd[8] << 8) + 1;
@@ -342,11 +386,12 @@ int_fast16_t SDSPI_initialize(SD_Handle handle)
         status = SD_STATUS_ERROR;
     }
     else {
-        /* Reconfigure the SPI to operate @ 2.5 MHz */
+        /* Reconfigure the SPI to operate at the data transfer bit rate */
         SPI_close(object->spiHandle);
 
         SPI_Params_init(&spiParams);
-        spiParams.bitRate = 2500000;
+        spiParams.bitRate = (hwAttrs->bitRate) ? hwAttrs->bitRate :
+            SD_DEFAULT_BITRATE;
         object->spiHandle = SPI_open(hwAttrs->spiIndex, &spiParams);
         status = (object->spiHandle == NULL) ? SD_STATUS_ERROR :
             SD_STATUS_SUCCESS;
@@ -378,6 +423,8 @@ SD_Handle SDSPI_open(SD_Handle handle, SD_Params *params)
 
     HwiP_restore(key);
 
+    memset(&object->stats, 0, sizeof(object->stats));
+
     object->lockSem = SemaphoreP_createBinary(1);
     if (object->lockSem == NULL) {
         object->isOpen = false;
@@ -389,7 +436,7 @@ SD_Handle SDSPI_open(SD_Handle handle, SD_Params *params)
      * SPI is initially set to 400 kHz to perform SD initialization.  This is
      * is done to ensure compatibility with older SD cards.  Once the card has
      * been initialized (in SPI mode) the SPI peripheral will be closed &
-     * reopened at 2.5 MHz.
+     * reopened at the data transfer bit rate (hwAttrs->bitRate).
      */
     SPI_Params_init(&spiParams);
     spiParams.bitRate = 400000;
@@ -413,7 +460,9 @@ SD_Handle SDSPI_open(SD_Handle handle, SD_Params *params)
 int_fast16_t SDSPI_read(SD_Handle handle, void *buf, int_fast32_t sector,
     uint_fast32_t sectorCount)
 {
+    bool                 received;
     int_fast16_t         status = SD_STATUS_ERROR;
+    uint32_t             startTime;
     SDSPI_Object        *object = handle->object;
     SDSPI_HWAttrs const *hwAttrs = handle->hwAttrs;
 
@@ -423,6 +472,8 @@ int_fast16_t SDSPI_read(SD_Handle handle, void *buf, int_fast32_t sector,
 
     SemaphoreP_pend(object->lockSem, SemaphoreP_WAIT_FOREVER);
 
+    startTime = ClockP_getTimestamp();
+
     /*
      * On a SDSC card, the sector address is a byte address on the SD Card
      * On a SDHC card, the sector addressing is via sector blocks
@@ -437,25 +488,21 @@ int_fast16_t SDSPI_read(SD_Handle handle, void *buf, int_fast32_t sector,
     /* Single block read */
     if (sectorCount == 1) {
         if ((sendCmd(object->spiHandle, CMD17, sector) == 0) &&
-            recvDataBlock(object->spiHandle, buf, SD_SECTOR_SIZE)) {
+            recvDataBlocks(object->spiHandle, buf, SD_SECTOR_SIZE, 1)) {
             status = SD_STATUS_SUCCESS;
         }
     }
     /* Multiple block read */
     else {
         if (sendCmd(object->spiHandle, CMD18, sector) == 0) {
-            do {
-                if (!recvDataBlock(object->spiHandle, buf, SD_SECTOR_SIZE)) {
-                    break;
-                }
-                buf = (void *) (((uint32_t) buf) + SD_SECTOR_SIZE);
-            } while (--sectorCount);
+            received = recvDataBlocks(object->spiHandle, buf, SD_SECTOR_SIZE,
+                sectorCount);
 
             /*
              * STOP_TRANSMISSION - order is important; always want to send
              * stop signal
              */
-            if (sendCmd(object->spiHandle, CMD12, 0) == 0 && sectorCount == 0) {
+            if (sendCmd(object->spiHandle, CMD12, 0) == 0 && received) {
                 status = SD_STATUS_SUCCESS;
             }
         }
@@ -463,6 +510,10 @@ int_fast16_t SDSPI_read(SD_Handle handle, void *buf, int_fast32_t sector,
 
     deassertCS(hwAttrs);
 
+    if (status == SD_STATUS_SUCCESS) {
+        recordStats(object->stats.read, sectorCount, startTime);
+    }
+
     SemaphoreP_post(object->lockSem);
 
     return (status);
@@ -474,7 +525,9 @@ int_fast16_t SDSPI_read(SD_Handle handle, void *buf, int_fast32_t sector,
 int_fast16_t SDSPI_write(SD_Handle handle, const void *buf,
     int_fast32_t sector, uint_fast32_t sectorCount)
 {
-    int_fast16_t        status = SD_STATUS_SUCCESS;
+    int_fast16_t         status = SD_STATUS_SUCCESS;
+    uint32_t             numSectors = sectorCount;
+    uint32_t             startTime;
     SDSPI_Object        *object = handle->object;
     SDSPI_HWAttrs const *hwAttrs = handle->hwAttrs;
 
@@ -484,6 +537,8 @@ int_fast16_t SDSPI_write(SD_Handle handle, const void *buf,
 
     SemaphoreP_pend(object->lockSem, SemaphoreP_WAIT_FOREVER);
 
+    startTime = ClockP_getTimestamp();
+
     /*
      * On a SDSC card, the sector address is a byte address on the SD Card
      * On a SDHC card, the sector addressing is via sector blocks
@@ -510,7 +565,10 @@ int_fast16_t SDSPI_write(SD_Handle handle, const void *buf,
                 status = SD_STATUS_ERROR;
             }
 
-            /* ACMD23 */
+            /*
+             * ACMD23 (SET_WR_BLK_ERASE_COUNT) - lets the card pre-erase the
+             * blocks which are about to be written
+             */
             if ((status == SD_STATUS_SUCCESS) &&
                 (sendCmd(object->spiHandle, CMD23, sectorCount) != 0)) {
                 status = SD_STATUS_ERROR;
@@ -538,6 +596,10 @@ int_fast16_t SDSPI_write(SD_Handle handle, const void *buf,
 
     deassertCS(hwAttrs);
 
+    if (sectorCount == 0) {
+        recordStats(object->stats.write, numSectors, startTime);
+    }
+
     SemaphoreP_post(object->lockSem);
 
     return ((sectorCount) ? SD_STATUS_ERROR : SD_STATUS_SUCCESS);
@@ -560,47 +622,100 @@ static inline void deassertCS(SDSPI_HWAttrs const *hwAttrs)
 }
 
 /*
- *  ======== recvDataBlock ========
- *  Function to receive a block of data from the SDCard
+ *  ======== recordStats ========
+ *  Function to account a completed transfer in the throughput statistics.
  */
-static bool recvDataBlock(SPI_Handle handle, void *buf, uint32_t count)
+static void recordStats(SDSPI_TransferStats *stats, uint32_t sectorCount,
+    uint32_t startTime)
 {
-    uint8_t      rxBuf[2];
-    uint8_t      txBuf[2] = {0xFF, 0xFF};
-    int_fast16_t status;
-    uint32_t     currentTime;
-    uint32_t     startTime;
-    uint32_t     timeout;
+    uintptr_t         key;
+    SDSPI_StatsBucket bucket;
+    uint32_t          ticks = ClockP_getTimestamp() - startTime;
 
-    /*
-     * Wait for SD card to be ready up to 1s.  SD card is ready when the
-     * START_BLOCK_TOKEN is received.
-     */
-    timeout = 1000000/ClockP_getSystemTickPeriod();
-    startTime = ClockP_getSystemTicks();
-    do {
-        status = spiTransfer(handle, &rxBuf, &txBuf, 1);
-        currentTime = ClockP_getSystemTicks();
-    } while ((status == SD_STATUS_SUCCESS) && (rxBuf[0] == 0xFF) &&
-        (currentTime - startTime) < timeout);
-
-    if (rxBuf[0] != START_BLOCK_TOKEN) {
-        /* Return error if valid data token was not received */
-        return (false);
+    if (sectorCount == 1) {
+        bucket = SDSPI_STATS_BUCKET_1;
     }
-
-    /* Receive the data block into buffer */
-    if (spiTransfer(handle, buf, NULL, count) != SD_STATUS_SUCCESS) {
-        return (false);
+    else if (sectorCount <= 8) {
+        bucket = SDSPI_STATS_BUCKET_8;
+    }
+    else if (sectorCount <= 64) {
+        bucket = SDSPI_STATS_BUCKET_64;
     }
+    else {
+        bucket = SDSPI_STATS_BUCKET_MAX;
+    }
+
+    key = HwiP_disable();
+
+    stats[bucket].transfers++;
+    stats[bucket].sectors += sectorCount;
+    stats[bucket].ticks += ticks;
+
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== recvDataBlocks ========
+ *  Function to receive numBlocks consecutive blocks of data from the SDCard
+ *
+ *  Each data block is received with a single SPI transfer directly into buf.
+ *  When more blocks follow, the CRC of the current block is read together
+ *  with the first SD_TOKEN_LOOKAHEAD bytes of the next block's token window.
+ *  Cards usually send the next START_BLOCK_TOKEN within that window; in which
+ *  case any data bytes which were received after the token are copied into
+ *  place & only the remainder of the block is transferred.
+ */
+static bool recvDataBlocks(SPI_Handle handle, uint8_t *buf, uint32_t count,
+    uint32_t numBlocks)
+{
+    uint8_t  rxBuf[SD_CRC_SIZE + SD_TOKEN_LOOKAHEAD];
+    uint32_t i;
+    uint32_t received = 0;
 
-    /* Read the 16 bit CRC, but discard it */
-    if (spiTransfer(handle, &rxBuf, &txBuf, 2) != SD_STATUS_SUCCESS) {
+    if (!waitForStartToken(handle)) {
         return (false);
     }
 
-    /* Return with success */
-    return (true);
+    while (true) {
+        /* Receive the (remainder of the) data block into buffer */
+        if (spiTransfer(handle, buf + received, NULL, count - received) !=
+            SD_STATUS_SUCCESS) {
+            return (false);
+        }
+
+        if (--numBlocks == 0) {
+            /* Read the 16 bit CRC, but discard it */
+            return (spiTransfer(handle, &rxBuf, NULL, SD_CRC_SIZE) ==
+                SD_STATUS_SUCCESS);
+        }
+
+        buf += count;
+
+        /* Read the 16 bit CRC (discarded) & look ahead for the next token */
+        if (spiTransfer(handle, &rxBuf, NULL, sizeof(rxBuf)) !=
+            SD_STATUS_SUCCESS) {
+            return (false);
+        }
+
+        for (i = SD_CRC_SIZE; (i < sizeof(rxBuf)) && (rxBuf[i] == 0xFF); i++);
+
+        if (i == sizeof(rxBuf)) {
+            /* Token not received yet; keep polling */
+            received = 0;
+            if (!waitForStartToken(handle)) {
+                return (false);
+            }
+        }
+        else if (rxBuf[i] == START_BLOCK_TOKEN) {
+            /* Data following the token is the start of the next block */
+            received = sizeof(rxBuf) - (i + 1);
+            memcpy(buf, &rxBuf[i + 1], received);
+        }
+        else {
+            /* Return error if valid data token was not received */
+            return (false);
+        }
+    }
 }
 
 /*
@@ -716,7 +831,7 @@ static int_fast16_t spiTransfer(SPI_Handle handle, void *rxBuf,
 static bool transmitDataBlock(SPI_Handle handle, void *buf, uint32_t count,
     uint8_t token)
 {
-    uint8_t rxBuf;
+    uint8_t rxBuf[SD_CRC_SIZE + 1];
     uint8_t txBuf[2] = {0xFF, 0xFF};
 
     if (!waitUntilReady(handle)) {
@@ -736,19 +851,17 @@ static bool transmitDataBlock(SPI_Handle handle, void *buf, uint32_t count,
             return (false);
         }
 
-        /* Receive the 16 bit CRC, but discard it */
-        txBuf[0] = (0xFF);
-        if (spiTransfer(handle, NULL, &txBuf, 2) != SD_STATUS_SUCCESS) {
-            return (false);
-        }
-
-        /* Receive data response token from SD card */
-        if (spiTransfer(handle, &rxBuf, &txBuf, 1) != SD_STATUS_SUCCESS) {
+        /*
+         * Send the 16 bit (dummy) CRC & receive the data response token
+         * from SD card in a single transfer
+         */
+        if (spiTransfer(handle, &rxBuf, NULL, SD_CRC_SIZE + 1) !=
+            SD_STATUS_SUCCESS) {
             return (false);
         }
 
         /* Check data response; return error if data was rejected  */
-        if ((rxBuf & 0x1F) != 0x05) {
+        if ((rxBuf[SD_CRC_SIZE] & 0x1F) != 0x05) {
             return (false);
         }
     }
@@ -756,30 +869,72 @@ static bool transmitDataBlock(SPI_Handle handle, void *buf, uint32_t count,
     return (true);
 }
 
+/*
+ *  ======== waitForStartToken ========
+ *  Function to wait (up to 1s) for the START_BLOCK_TOKEN which precedes a
+ *  data block sent by the SD card.
+ */
+static bool waitForStartToken(SPI_Handle handle)
+{
+    uint8_t      rxBuf;
+    uint8_t      txBuf = 0xFF;
+    int_fast16_t status;
+    uint32_t     currentTime;
+    uint32_t     startTime;
+    uint32_t     timeout;
+
+    /*
+     * Wait for SD card to be ready up to 1s.  SD card is ready when the
+     * START_BLOCK_TOKEN is received.
+     */
+    timeout = 1000000/ClockP_getSystemTickPeriod();
+    startTime = ClockP_getSystemTicks();
+    do {
+        status = spiTransfer(handle, &rxBuf, &txBuf, 1);
+        currentTime = ClockP_getSystemTicks();
+    } while ((status == SD_STATUS_SUCCESS) && (rxBuf == 0xFF) &&
+        (currentTime - startTime) < timeout);
+
+    /* Return error if valid data token was not received */
+    return ((status == SD_STATUS_SUCCESS) && (rxBuf == START_BLOCK_TOKEN));
+}
+
 /*
  *  ======== waitUntilReady ========
  *  Function to check if the SD card is busy.
  *
+ *  The card is usually ready, so a single byte is checked first.  While the
+ *  card is busy (programming a block) it is polled SD_BUSY_POLL_SIZE bytes
+ *  at a time; the card holds its output low until it is done so the last
+ *  byte of each transfer indicates whether it has become ready.
+ *
  *  Returns true if SD card is ready; false indicates the SD card is still busy
  *  & a timeout occurred.
  */
 static bool waitUntilReady(SPI_Handle handle)
 {
-    uint8_t      rxDummy;
+    uint8_t      rxBuf[SD_BUSY_POLL_SIZE];
     uint8_t      txDummy = 0xFF;
     int_fast16_t status;
     uint32_t     currentTime;
     uint32_t     startTime;
     uint32_t     timeout;
 
+    status = spiTransfer(handle, &rxBuf[SD_BUSY_POLL_SIZE - 1], &txDummy, 1);
+    if ((status != SD_STATUS_SUCCESS) ||
+        (rxBuf[SD_BUSY_POLL_SIZE - 1] == 0xFF)) {
+        return (status == SD_STATUS_SUCCESS);
+    }
+
     /* Wait up to 1s for data packet */
     timeout = 1000000/ClockP_getSystemTickPeriod();
     startTime = ClockP_getSystemTicks();
     do {
-        status = spiTransfer(handle, &rxDummy, &txDummy, 1);
+        status = spiTransfer(handle, &rxBuf, NULL, SD_BUSY_POLL_SIZE);
         currentTime = ClockP_getSystemTicks();
-    } while ((status == SD_STATUS_SUCCESS) && (rxDummy != 0xFF) &&
+    } while ((status == SD_STATUS_SUCCESS) &&
+        (rxBuf[SD_BUSY_POLL_SIZE - 1] != 0xFF) &&
         (currentTime - startTime) < timeout);
 
-    return (rxDummy == 0xFF);
+    return (rxBuf[SD_BUSY_POLL_SIZE - 1] == 0xFF);
 }
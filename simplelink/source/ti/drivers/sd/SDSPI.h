@@ -60,6 +60,36 @@
  *  accessibility requirements).  Refer to @ref SPI.h & the device specific
  *  SPI implementation header files for details.
  *
+ *  ## Multi-block transfers #
+ *
+ *  Reads & writes of more than one sector are performed as a single
+ *  READ_MULTIPLE_BLOCK (CMD18) or WRITE_MULTIPLE_BLOCK (CMD25) stream.  Each
+ *  512 byte data block is transferred in a single SPI transaction directly
+ *  to/from the application buffer so it is DMA backed whenever the SPI driver
+ *  permits.  The CRC of a block is exchanged in the same SPI transaction as
+ *  the data response (writes) or the start token of the following block
+ *  (reads), reducing the number of small transfers between blocks.  Multi
+ *  block writes to SD cards are preceded by SET_WR_BLK_ERASE_COUNT (ACMD23)
+ *  so the card may pre-erase the blocks to be written.
+ *
+ *  ## Throughput statistics #
+ *
+ *  The driver records the number of transfers, sectors & ClockP timestamp
+ *  counts spent in SDSPI_read() & SDSPI_write(), grouped by transfer size.
+ *  The timestamp resolves single sector transfers, which are usually
+ *  shorter than a system tick.  The statistics are read with the
+ *  #SDSPI_CMD_GET_STATS command:
+ *  @code
+ *  SDSPI_Stats stats;
+ *
+ *  SD_control(handle, SDSPI_CMD_GET_STATS, &stats);
+ *
+ *  // Bytes per microsecond is equivalent to MB/s
+ *  mbps = (stats.read[SDSPI_STATS_BUCKET_64].sectors * 512.0f) *
+ *      (stats.timestampFreq / 1000000.0f) /
+ *      stats.read[SDSPI_STATS_BUCKET_64].ticks;
+ *  @endcode
+ *
  *  ============================================================================
  */
 
@@ -75,6 +105,66 @@ extern "C" {
 #include <ti/drivers/SD.h>
 #include <ti/drivers/SPI.h>
 
+/**
+ *  @addtogroup SD_CMD
+ *  SDSPI_CMD_* macros are command codes only defined in the SDSPI.h
+ *  driver implementation and need to:
+ *  @code
+ *  #include <ti/drivers/sd/SDSPI.h>
+ *  @endcode
+ *  @{
+ */
+
+/*!
+ * @brief Command used by SD_control() to read the throughput statistics
+ *
+ * With this command code, @b arg is a pointer to a #SDSPI_Stats structure
+ * which is filled in with the statistics gathered since the driver was
+ * opened or since the last #SDSPI_CMD_CLEAR_STATS command.
+ */
+#define SDSPI_CMD_GET_STATS       (SD_CMD_RESERVED + 0)
+
+/*!
+ * @brief Command used by SD_control() to reset the throughput statistics
+ *
+ * With this command code, @b arg is not used.
+ */
+#define SDSPI_CMD_CLEAR_STATS     (SD_CMD_RESERVED + 1)
+/** @}*/
+
+/*!
+ *  @brief  Transfer size ranges used to group SDSPI throughput statistics
+ */
+typedef enum SDSPI_StatsBucket_ {
+    SDSPI_STATS_BUCKET_1 = 0,  /*!< Single sector transfers */
+    SDSPI_STATS_BUCKET_8,      /*!< 2 to 8 sector transfers */
+    SDSPI_STATS_BUCKET_64,     /*!< 9 to 64 sector transfers */
+    SDSPI_STATS_BUCKET_MAX,    /*!< Transfers larger than 64 sectors */
+    SDSPI_STATS_BUCKET_COUNT
+} SDSPI_StatsBucket;
+
+/*!
+ *  @brief  Statistics for transfers within one #SDSPI_StatsBucket
+ */
+typedef struct SDSPI_TransferStats_ {
+    uint32_t transfers;  /*!< Number of successful transfers */
+    uint32_t sectors;    /*!< Total number of sectors transferred */
+    uint64_t ticks;      /*!< Total timestamp counts spent transferring */
+} SDSPI_TransferStats;
+
+/*!
+ *  @brief  SDSPI throughput statistics returned by #SDSPI_CMD_GET_STATS
+ *
+ *  The throughput (in MB/s) of a bucket is given by
+ *  (sectors * 512 * timestampFreq) / (ticks * 1000000).
+ */
+typedef struct SDSPI_Stats_ {
+    SDSPI_TransferStats read[SDSPI_STATS_BUCKET_COUNT];
+    SDSPI_TransferStats write[SDSPI_STATS_BUCKET_COUNT];
+    uint32_t            timestampFreq; /*!< Ticks per second (ClockP
+                                            timestamp frequency in Hz) */
+} SDSPI_Stats;
+
 /* SDSPI function table */
 extern const SD_FxnTable SDSPI_fxnTable;
 
@@ -87,6 +177,9 @@ extern const SD_FxnTable SDSPI_fxnTable;
  *      - configure & open the SPI driver instance for data transfers
  *      - select the SD card (via chip select) when performing data transfers
  *
+ *  The bitRate field is the SPI bit rate used for data transfers once the
+ *  card has been initialized.  If it is 0, a conservative 2.5 MHz is used.
+ *
  *  @struct SDSPI_HWAttrs
  *  An example configuration structure could look as the following:
  *  @code
@@ -96,7 +189,10 @@ extern const SD_FxnTable SDSPI_fxnTable;
  *          .spiIndex = 0,
  *
  *          //  GPIO driver pin index
- *          .spiCsGpioIndex = 3
+ *          .spiCsGpioIndex = 3,
+ *
+ *          // SPI bit rate used once the card is initialized
+ *          .bitRate = 12000000
  *      }
  *  };
  *  @endcode
@@ -104,6 +200,7 @@ extern const SD_FxnTable SDSPI_fxnTable;
 typedef struct SDSPI_HWAttrs_ {
     uint_least8_t spiIndex;
     uint16_t      spiCsGpioIndex;
+    uint32_t      bitRate;
 } SDSPI_HWAttrs;
 
 /*!
@@ -116,6 +213,7 @@ typedef struct SDSPI_Object_ {
     SPI_Handle        spiHandle;
     SD_CardType       cardType;
     bool              isOpen;
+    SDSPI_Stats       stats;
 } SDSPI_Object;
 
 #ifdef __cplusplus
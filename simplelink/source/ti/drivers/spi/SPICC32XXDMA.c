@@ -216,20 +216,18 @@ static void configDMA(SPICC32XXDMA_Object *object,
 
     /*
      * DMA channels 30 and 31 are connected to the SPI peripheral by default.
-     * If someone hasn't remapped them to something else already, we remap
-     * them to SW.
+     * If they are not the channels reserved by this driver & someone hasn't
+     * remapped them to something else already, we remap them to SW.
      */
-    if (!(HWREG(UDMA_BASE + UDMA_O_CHMAP3) & UDMA_CHMAP3_CH30SEL_M)) {
+    if (((hwAttrs->rxChannelIndex & 0x1F) != 30) &&
+        !(HWREG(UDMA_BASE + UDMA_O_CHMAP3) & UDMA_CHMAP3_CH30SEL_M)) {
         MAP_uDMAChannelAssign(UDMA_CH30_SW);
     }
-    if (!(HWREG(UDMA_BASE + UDMA_O_CHMAP3) & UDMA_CHMAP3_CH31SEL_M)) {
+    if (((hwAttrs->txChannelIndex & 0x1F) != 31) &&
+        !(HWREG(UDMA_BASE + UDMA_O_CHMAP3) & UDMA_CHMAP3_CH31SEL_M)) {
         MAP_uDMAChannelAssign(UDMA_CH31_SW);
     }
 
-    /* Assign the requested DMA channels */
-    MAP_uDMAChannelAssign(hwAttrs->rxChannelIndex);
-    MAP_uDMAChannelAssign(hwAttrs->txChannelIndex);
-
     /* Enable DMA to generate interrupt on SPI peripheral */
     MAP_SPIDmaEnable(hwAttrs->baseAddr, SPI_RX_DMA | SPI_TX_DMA);
     MAP_SPIIntClear(hwAttrs->baseAddr, SPI_INT_DMARX);
@@ -478,6 +476,8 @@ void SPICC32XXDMA_close(SPI_Handle handle)
     }
 
     if (object->dmaHandle) {
+        UDMACC32XX_freeChannel(object->dmaHandle, hwAttrs->rxChannelIndex);
+        UDMACC32XX_freeChannel(object->dmaHandle, hwAttrs->txChannelIndex);
         UDMACC32XX_close(object->dmaHandle);
         object->dmaHandle = NULL;
     }
@@ -534,6 +534,8 @@ SPI_Handle SPICC32XXDMA_open(SPI_Handle handle, SPI_Params *params)
     uint16_t                      mode;
     uint8_t                       powerMgrId;
     HwiP_Params                   hwiParams;
+    UDMACC32XX_Handle             dmaHandle;
+    uint32_t                      dmaChannels[2];
     SPICC32XXDMA_Object          *object = handle->object;
     SPICC32XXDMA_HWAttrsV1 const *hwAttrs = handle->hwAttrs;
 
@@ -593,12 +595,32 @@ SPI_Handle SPICC32XXDMA_open(SPI_Handle handle, SPI_Params *params)
         }
     }
 
-    object->dmaHandle = UDMACC32XX_open();
-    if (object->dmaHandle == NULL) {
+    dmaHandle = UDMACC32XX_open();
+    if (dmaHandle == NULL) {
+        SPICC32XXDMA_close(handle);
+
+        return (NULL);
+    }
+
+    /* Reserve the channels so that UDMACC32XX_allocChannel() users skip them */
+    dmaChannels[0] = hwAttrs->rxChannelIndex;
+    dmaChannels[1] = hwAttrs->txChannelIndex;
+    if (UDMACC32XX_allocChannel(dmaHandle, &dmaChannels[0], 1,
+            UDMACC32XX_PRIORITY_DEFAULT) == UDMACC32XX_CHANNEL_NONE) {
+        UDMACC32XX_close(dmaHandle);
+        SPICC32XXDMA_close(handle);
+
+        return (NULL);
+    }
+    if (UDMACC32XX_allocChannel(dmaHandle, &dmaChannels[1], 1,
+            UDMACC32XX_PRIORITY_DEFAULT) == UDMACC32XX_CHANNEL_NONE) {
+        UDMACC32XX_freeChannel(dmaHandle, dmaChannels[0]);
+        UDMACC32XX_close(dmaHandle);
         SPICC32XXDMA_close(handle);
 
         return (NULL);
     }
+    object->dmaHandle = dmaHandle;
 
     HwiP_Params_init(&hwiParams);
     hwiParams.arg = (uintptr_t) handle;
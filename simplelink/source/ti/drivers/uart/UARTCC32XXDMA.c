@@ -174,7 +174,10 @@ void UARTCC32XXDMA_close(UART_Handle handle)
     }
 
     if (object->dmaHandle) {
+        UDMACC32XX_freeChannel(object->dmaHandle, hwAttrs->rxChannelIndex);
+        UDMACC32XX_freeChannel(object->dmaHandle, hwAttrs->txChannelIndex);
         UDMACC32XX_close(object->dmaHandle);
+        object->dmaHandle = NULL;
     }
 
     Power_unregisterNotify(&object->postNotify);
@@ -259,6 +262,8 @@ UART_Handle UARTCC32XXDMA_open(UART_Handle handle, UART_Params *params)
     SemaphoreP_Params              semParams;
     HwiP_Params                    hwiParams;
     ClockP_Params                  clockParams;
+    UDMACC32XX_Handle              dmaHandle;
+    uint32_t                       dmaChannels[2];
     uint16_t                       pin;
     uint16_t                       mode;
 
@@ -331,15 +336,36 @@ UART_Handle UARTCC32XXDMA_open(UART_Handle handle, UART_Params *params)
     object->writeSem = NULL;
     object->txFifoEmptyClk = NULL;
     object->txPin = (uint16_t)-1;
+    object->dmaHandle = NULL;
 
     /* DMA first */
-    object->dmaHandle = UDMACC32XX_open();
-    if (object->dmaHandle == NULL) {
+    dmaHandle = UDMACC32XX_open();
+    if (dmaHandle == NULL) {
         UARTCC32XXDMA_close(handle);
         DebugP_log1("UART:(%p) UDMACC32XX_open() failed.", hwAttrs->baseAddr);
         return (NULL);
     }
 
+    /* Reserve the channels so that UDMACC32XX_allocChannel() users skip them */
+    dmaChannels[0] = hwAttrs->rxChannelIndex;
+    dmaChannels[1] = hwAttrs->txChannelIndex;
+    if (UDMACC32XX_allocChannel(dmaHandle, &dmaChannels[0], 1,
+            UDMACC32XX_PRIORITY_DEFAULT) == UDMACC32XX_CHANNEL_NONE) {
+        UDMACC32XX_close(dmaHandle);
+        UARTCC32XXDMA_close(handle);
+        DebugP_log1("UART:(%p) uDMA RX channel in use.", hwAttrs->baseAddr);
+        return (NULL);
+    }
+    if (UDMACC32XX_allocChannel(dmaHandle, &dmaChannels[1], 1,
+            UDMACC32XX_PRIORITY_DEFAULT) == UDMACC32XX_CHANNEL_NONE) {
+        UDMACC32XX_freeChannel(dmaHandle, dmaChannels[0]);
+        UDMACC32XX_close(dmaHandle);
+        UARTCC32XXDMA_close(handle);
+        DebugP_log1("UART:(%p) uDMA TX channel in use.", hwAttrs->baseAddr);
+        return (NULL);
+    }
+    object->dmaHandle = dmaHandle;
+
     pin = (hwAttrs->rxPin) & 0xff;
     mode = (hwAttrs->rxPin >> 8) & 0xff;
 
@@ -929,11 +955,8 @@ static void initHw(UART_Handle handle)
 
     MAP_UARTDMAEnable(hwAttrs->baseAddr, UART_DMA_TX | UART_DMA_RX);
 
-    /* Configure DMA for TX and RX */
-    MAP_uDMAChannelAssign(hwAttrs->txChannelIndex);
+    /* Configure DMA for TX and RX; the channels are assigned on open */
     MAP_uDMAChannelAttributeDisable(hwAttrs->txChannelIndex, UDMA_ATTR_ALTSELECT);
-
-    MAP_uDMAChannelAssign(hwAttrs->rxChannelIndex);
     MAP_uDMAChannelAttributeDisable(hwAttrs->rxChannelIndex, UDMA_ATTR_ALTSELECT);
     MAP_UARTEnable(hwAttrs->baseAddr);
 }
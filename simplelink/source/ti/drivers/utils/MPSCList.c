@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2019, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== MPSCList.c ========
+ *  Intrusive MPSC queue after D. Vyukov.  Producers swing the tail with an
+ *  atomic exchange and then link the previous tail to the new elem; the
+ *  consumer follows next pointers from the head.  The stub elem is put back
+ *  whenever the consumer is about to take the last elem, so head and tail
+ *  are never NULL.
+ */
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <ti/drivers/utils/MPSCList.h>
+
+/* Pointers shared with producers are accessed through these */
+#define ATOMIC_ELEM(p)  ((_Atomic(List_Elem *) *) (p))
+
+/*
+ *  ======== MPSCList_clearList ========
+ */
+void MPSCList_clearList(MPSCList_List *list)
+{
+    list->stub.next = NULL;
+    list->head = &list->stub;
+    atomic_store(ATOMIC_ELEM(&list->tail), &list->stub);
+}
+
+/*
+ *  ======== MPSCList_get ========
+ */
+List_Elem *MPSCList_get(MPSCList_List *list)
+{
+    List_Elem *head = list->head;
+    List_Elem *next;
+
+    next = atomic_load_explicit(ATOMIC_ELEM(&head->next),
+        memory_order_acquire);
+
+    /* Skip over the stub */
+    if (head == &list->stub) {
+        if (next == NULL) {
+            return (NULL);
+        }
+        list->head = next;
+        head = next;
+        next = atomic_load_explicit(ATOMIC_ELEM(&head->next),
+            memory_order_acquire);
+    }
+
+    if (next != NULL) {
+        list->head = next;
+        return (head);
+    }
+
+    /* head looks like the last elem; a put may be in progress */
+    if (head != atomic_load(ATOMIC_ELEM(&list->tail))) {
+        return (NULL);
+    }
+
+    /* Put the stub back so that head can be taken */
+    MPSCList_put(list, &list->stub);
+
+    next = atomic_load_explicit(ATOMIC_ELEM(&head->next),
+        memory_order_acquire);
+    if (next != NULL) {
+        list->head = next;
+        return (head);
+    }
+
+    return (NULL);
+}
+
+/*
+ *  ======== MPSCList_put ========
+ */
+void MPSCList_put(MPSCList_List *list, List_Elem *elem)
+{
+    List_Elem *prev;
+
+    atomic_store_explicit(ATOMIC_ELEM(&elem->next), NULL,
+        memory_order_relaxed);
+
+    prev = atomic_exchange(ATOMIC_ELEM(&list->tail), elem);
+
+    atomic_store_explicit(ATOMIC_ELEM(&prev->next), elem,
+        memory_order_release);
+}
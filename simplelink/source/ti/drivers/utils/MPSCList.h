@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2019, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/** ============================================================================
+ *  @file       MPSCList.h
+ *
+ *  @brief      Lock-free multiple-producer, single-consumer queue
+ *
+ *  MPSCList is a first-in first-out queue of ::List_Elem elements that does
+ *  not disable interrupts.  Any number of tasks, Swis and Hwis may put
+ *  elements onto a list concurrently; only one context at a time may get
+ *  elements from it.  This suits the common driver pattern where requests
+ *  are queued from any context and drained by the driver's Hwi or Swi.
+ *
+ *  MPSCList_put() is a single atomic exchange followed by a store, so it
+ *  takes constant time and never delays other interrupts.  MPSCList_get()
+ *  also takes constant time.  Both rely on C11 atomics, which compile to
+ *  LDREX/STREX on Cortex-M3 and M4.
+ *
+ *  Elements use the same ::List_Elem as ::List_List, so a structure can
+ *  move between the two kinds of list; only List_Elem.next is used here.
+ *  An element must not be put again until it has been taken off the list.
+ *
+ *  A put that has been preempted between its two steps hides the element
+ *  it is adding, and any elements put after it, from MPSCList_get() until
+ *  the put resumes.  MPSCList_get() then returns NULL even though the list
+ *  is not empty, so a consumer should not treat NULL as proof that no more
+ *  work will arrive; the producer that was preempted signals its own work
+ *  as usual once it completes.
+ *
+ *  @code
+ *  typedef struct MyRequest {
+ *      List_Elem elem;
+ *      void *buffer;
+ *  } MyRequest;
+ *
+ *  MPSCList_List queue;
+ *  MyRequest request;
+ *  MyRequest *next;
+ *
+ *  MPSCList_clearList(&queue);
+ *
+ *  // Any context
+ *  MPSCList_put(&queue, &request.elem);
+ *
+ *  // Consumer only
+ *  while ((next = (MyRequest *) MPSCList_get(&queue)) != NULL) {
+ *      ...
+ *  }
+ *  @endcode
+ *  ============================================================================
+ */
+
+#ifndef ti_drivers_utils_MPSCList__include
+#define ti_drivers_utils_MPSCList__include
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <ti/drivers/utils/List.h>
+
+/*!
+ *  @brief  MPSCList structure
+ *
+ *  The application must not access any member variables of this structure!
+ */
+typedef struct MPSCList_List {
+    List_Elem * volatile tail;  /* Last elem put, shared by producers */
+    List_Elem           *head;  /* Next elem to get, consumer only */
+    List_Elem            stub;  /* Placeholder keeping the list non-empty */
+} MPSCList_List;
+
+/*!
+ *  @brief  Function to initialize the contents of a MPSCList_List
+ *
+ *  Must not be called while the list is in use.
+ *
+ *  @param  list Pointer to a MPSCList_List structure
+ */
+extern void MPSCList_clearList(MPSCList_List *list);
+
+/*!
+ *  @brief  Function to test whether a list is empty
+ *
+ *  May only be called by the consumer.
+ *
+ *  @param  list A pointer to the list
+ *
+ *  @return true if MPSCList_get() would return NULL
+ */
+static inline bool MPSCList_empty(MPSCList_List *list)
+{
+    return ((list->head == &list->stub) && (list->stub.next == NULL));
+}
+
+/*!
+ *  @brief  Function to get the first elem in a list
+ *
+ *  May only be called by the consumer.
+ *
+ *  @param  list A pointer to the list
+ *
+ *  @return Pointer to the first elem in the list or NULL if empty
+ */
+extern List_Elem *MPSCList_get(MPSCList_List *list);
+
+/*!
+ *  @brief  Function to put an elem onto the end of a list
+ *
+ *  May be called from any context.
+ *
+ *  @param  list A pointer to the list
+ *
+ *  @param  elem Element to place onto the end of the list
+ */
+extern void MPSCList_put(MPSCList_List *list, List_Elem *elem);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ti_drivers_utils_MPSCList__include */
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2019, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== PriorityQueue.c ========
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/utils/PriorityQueue.h>
+
+#define PARENT(i)   (((i) - 1) >> 1)
+#define LEFT(i)     (((i) << 1) + 1)
+
+static inline bool before(PriorityQueue_Elem *a, PriorityQueue_Elem *b);
+static void fixHeap(PriorityQueue_Queue *queue, uint_fast16_t index);
+static void removeAt(PriorityQueue_Queue *queue, uint_fast16_t index);
+
+/*
+ *  ======== before ========
+ *  Wrap-around comparison of keys, then of insertion order.
+ */
+static inline bool before(PriorityQueue_Elem *a, PriorityQueue_Elem *b)
+{
+    int32_t diff = (int32_t) (a->key - b->key);
+
+    if (diff != 0) {
+        return (diff < 0);
+    }
+
+    return ((int32_t) (a->seq - b->seq) < 0);
+}
+
+/*
+ *  ======== fixHeap ========
+ *  Moves the elem at index up or down until the heap is ordered again.
+ */
+static void fixHeap(PriorityQueue_Queue *queue, uint_fast16_t index)
+{
+    PriorityQueue_Elem **heap = queue->heap;
+    PriorityQueue_Elem  *elem = heap[index];
+    uint_fast16_t        child;
+
+    /* Sift up */
+    while ((index > 0) && before(elem, heap[PARENT(index)])) {
+        heap[index] = heap[PARENT(index)];
+        heap[index]->index = index;
+        index = PARENT(index);
+    }
+
+    /* Sift down */
+    while ((child = LEFT(index)) < queue->count) {
+        if ((child + 1 < queue->count) &&
+            before(heap[child + 1], heap[child])) {
+            child++;
+        }
+        if (!before(heap[child], elem)) {
+            break;
+        }
+        heap[index] = heap[child];
+        heap[index]->index = index;
+        index = child;
+    }
+
+    heap[index] = elem;
+    elem->index = index;
+}
+
+/*
+ *  ======== removeAt ========
+ */
+static void removeAt(PriorityQueue_Queue *queue, uint_fast16_t index)
+{
+    queue->count--;
+
+    if (index != queue->count) {
+        queue->heap[index] = queue->heap[queue->count];
+        fixHeap(queue, index);
+    }
+}
+
+/*
+ *  ======== PriorityQueue_construct ========
+ */
+void PriorityQueue_construct(PriorityQueue_Queue *queue,
+    PriorityQueue_Elem **heap, uint_fast16_t capacity)
+{
+    queue->heap = heap;
+    queue->capacity = capacity;
+    queue->count = 0;
+    queue->seq = 0;
+}
+
+/*
+ *  ======== PriorityQueue_get ========
+ */
+PriorityQueue_Elem *PriorityQueue_get(PriorityQueue_Queue *queue)
+{
+    PriorityQueue_Elem *elem = NULL;
+    uintptr_t           key;
+
+    key = HwiP_disable();
+
+    if (queue->count != 0) {
+        elem = queue->heap[0];
+        removeAt(queue, 0);
+    }
+
+    HwiP_restore(key);
+
+    return (elem);
+}
+
+/*
+ *  ======== PriorityQueue_put ========
+ */
+bool PriorityQueue_put(PriorityQueue_Queue *queue, PriorityQueue_Elem *elem,
+    uint32_t key)
+{
+    uintptr_t hwiKey;
+
+    hwiKey = HwiP_disable();
+
+    if (queue->count == queue->capacity) {
+        HwiP_restore(hwiKey);
+
+        return (false);
+    }
+
+    elem->key = key;
+    elem->seq = queue->seq++;
+    queue->heap[queue->count] = elem;
+    fixHeap(queue, queue->count++);
+
+    HwiP_restore(hwiKey);
+
+    return (true);
+}
+
+/*
+ *  ======== PriorityQueue_remove ========
+ */
+void PriorityQueue_remove(PriorityQueue_Queue *queue,
+    PriorityQueue_Elem *elem)
+{
+    uintptr_t key;
+
+    key = HwiP_disable();
+
+    removeAt(queue, elem->index);
+
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== PriorityQueue_setKey ========
+ */
+void PriorityQueue_setKey(PriorityQueue_Queue *queue,
+    PriorityQueue_Elem *elem, uint32_t key)
+{
+    uintptr_t hwiKey;
+
+    hwiKey = HwiP_disable();
+
+    elem->key = key;
+    fixHeap(queue, elem->index);
+
+    HwiP_restore(hwiKey);
+}
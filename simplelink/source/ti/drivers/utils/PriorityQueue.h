@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2019, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/** ============================================================================
+ *  @file       PriorityQueue.h
+ *
+ *  @brief      Intrusive binary heap priority queue for use in drivers
+ *
+ *  A PriorityQueue_Queue orders elements by a 32-bit key, smallest first,
+ *  so that drivers can serve requests by deadline instead of in arrival
+ *  order.  Elements with equal keys are served first-in first-out.
+ *
+ *  Like ::List_Elem, a ::PriorityQueue_Elem is embedded in the structure
+ *  being queued.  The driver provides an array of element pointers that
+ *  holds the heap; its length bounds the number of queued elements and
+ *  the time taken by every operation.  Insertion, removal of the first
+ *  elem, removal of an arbitrary elem and changing an elem's key take
+ *  O(log n) time; PriorityQueue_head() takes constant time.
+ *
+ *  Keys are compared with wrap-around arithmetic, so ClockP tick deadlines
+ *  can be used directly as long as all keys in a queue are within 2^31 of
+ *  each other.
+ *
+ *  PriorityQueue_get(), PriorityQueue_put(), PriorityQueue_remove() and
+ *  PriorityQueue_setKey() are atomic: they disable interrupts for the
+ *  duration of the O(log n) operation.
+ *
+ *  @code
+ *  typedef struct MyJob {
+ *      PriorityQueue_Elem elem;
+ *      void *buffer;
+ *  } MyJob;
+ *
+ *  PriorityQueue_Elem *heap[8];
+ *  PriorityQueue_Queue queue;
+ *  MyJob job;
+ *  MyJob *next;
+ *
+ *  PriorityQueue_construct(&queue, heap, 8);
+ *  PriorityQueue_put(&queue, &job.elem, ClockP_getSystemTicks() + 100);
+ *  next = (MyJob *) PriorityQueue_get(&queue);
+ *  @endcode
+ *  ============================================================================
+ */
+
+#ifndef ti_drivers_utils_PriorityQueue__include
+#define ti_drivers_utils_PriorityQueue__include
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*!
+ *  @brief  Element of a priority queue
+ *
+ *  The application must not access any member variables of this structure
+ *  except through PriorityQueue_key().
+ */
+typedef struct PriorityQueue_Elem {
+    uint32_t      key;      /* Smaller keys are served first */
+    uint32_t      seq;      /* Insertion order among equal keys */
+    uint_fast16_t index;    /* Position in the heap */
+} PriorityQueue_Elem;
+
+/*!
+ *  @brief  Priority queue structure
+ *
+ *  The application must not access any member variables of this structure!
+ */
+typedef struct PriorityQueue_Queue {
+    PriorityQueue_Elem **heap;      /* Heap storage */
+    uint_fast16_t        capacity;  /* Length of heap */
+    uint_fast16_t        count;     /* Number of queued elements */
+    uint32_t             seq;       /* Next insertion sequence number */
+} PriorityQueue_Queue;
+
+/*!
+ *  @brief  Function to initialize an empty priority queue
+ *
+ *  @param  queue     Pointer to the queue
+ *
+ *  @param  heap      Array of @p capacity element pointers
+ *
+ *  @param  capacity  Maximum number of queued elements
+ */
+extern void PriorityQueue_construct(PriorityQueue_Queue *queue,
+    PriorityQueue_Elem **heap, uint_fast16_t capacity);
+
+/*!
+ *  @brief  Function to return the number of elements in a queue
+ *
+ *  @param  queue  A pointer to the queue
+ *
+ *  @return Number of queued elements
+ */
+static inline uint_fast16_t PriorityQueue_count(PriorityQueue_Queue *queue)
+{
+    return (queue->count);
+}
+
+/*!
+ *  @brief  Function to test whether a queue is empty
+ *
+ *  @param  queue  A pointer to the queue
+ *
+ *  @return true if empty, false if not empty
+ */
+static inline bool PriorityQueue_empty(PriorityQueue_Queue *queue)
+{
+    return (queue->count == 0);
+}
+
+/*!
+ *  @brief  Function to atomically remove the elem with the smallest key
+ *
+ *  @param  queue  A pointer to the queue
+ *
+ *  @return Pointer to the elem with the smallest key or NULL if empty
+ */
+extern PriorityQueue_Elem *PriorityQueue_get(PriorityQueue_Queue *queue);
+
+/*!
+ *  @brief  Function to return the elem with the smallest key
+ *
+ *  This function does not remove the elem.
+ *
+ *  @param  queue  A pointer to the queue
+ *
+ *  @return Pointer to the elem with the smallest key or NULL if empty
+ */
+static inline PriorityQueue_Elem *PriorityQueue_head(
+    PriorityQueue_Queue *queue)
+{
+    return ((queue->count != 0) ? queue->heap[0] : NULL);
+}
+
+/*!
+ *  @brief  Function to return the key of an elem
+ *
+ *  @param  elem  A queued elem
+ *
+ *  @return The key the elem was put or last updated with
+ */
+static inline uint32_t PriorityQueue_key(PriorityQueue_Elem *elem)
+{
+    return (elem->key);
+}
+
+/*!
+ *  @brief  Function to atomically add an elem to a queue
+ *
+ *  @param  queue  A pointer to the queue
+ *
+ *  @param  elem   Element to add; must not already be queued
+ *
+ *  @param  key    Key of the element, for instance a deadline in ticks
+ *
+ *  @return true on success, false if the queue is full
+ */
+extern bool PriorityQueue_put(PriorityQueue_Queue *queue,
+    PriorityQueue_Elem *elem, uint32_t key);
+
+/*!
+ *  @brief  Function to atomically remove an elem from a queue
+ *
+ *  @param  queue  A pointer to the queue
+ *
+ *  @param  elem   Queued element to remove
+ */
+extern void PriorityQueue_remove(PriorityQueue_Queue *queue,
+    PriorityQueue_Elem *elem);
+
+/*!
+ *  @brief  Function to atomically change the key of a queued elem
+ *
+ *  The elem keeps its place among elements with the same key as if it
+ *  had been put when it was first queued.
+ *
+ *  @param  queue  A pointer to the queue
+ *
+ *  @param  elem   Queued element
+ *
+ *  @param  key    New key
+ */
+extern void PriorityQueue_setKey(PriorityQueue_Queue *queue,
+    PriorityQueue_Elem *elem, uint32_t key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ti_drivers_utils_PriorityQueue__include */
@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== CRC_test.c ========
+ *  CRCSW through the CRC API.
+ *
+ *  The catalogued check values of "123456789" for every supported
+ *  polynomial and reflection, then random messages, split at random points
+ *  and alignments, against zlib's crc32() and a bit at a time reference.
+ *
+ *  "CRC_test bench" reports the throughput of CRCSW, zlib's crc32() and
+ *  the bitwise reference by buffer size.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <zlib.h>
+
+#include <ti/drivers/CRC.h>
+#include <ti/drivers/crc/CRCSW.h>
+
+#include "test.h"
+
+#define MAX_MESSAGE  (4096)
+#define ROUNDS       (2000)
+
+typedef struct Variant {
+    const char     *name;
+    CRC_Polynomial  polynomial;
+    uint32_t        seed;
+    uint32_t        finalXor;
+    bool            reflect;
+    uint32_t        check;      /* CRC of "123456789" */
+} Variant;
+
+/* From the catalogue of parametrised CRC algorithms */
+static const Variant variants[] = {
+    {"CRC-32",             CRC_POLYNOMIAL_CRC_32, 0xFFFFFFFF, 0xFFFFFFFF,
+        true, 0xCBF43926},
+    {"CRC-32/BZIP2",       CRC_POLYNOMIAL_CRC_32, 0xFFFFFFFF, 0xFFFFFFFF,
+        false, 0xFC891918},
+    {"CRC-32/MPEG-2",      CRC_POLYNOMIAL_CRC_32, 0xFFFFFFFF, 0,
+        false, 0x0376E6E7},
+    {"CRC-32C",            CRC_POLYNOMIAL_CRC_32C, 0xFFFFFFFF, 0xFFFFFFFF,
+        true, 0xE3069283},
+    {"CRC-16/ARC",         CRC_POLYNOMIAL_CRC_16, 0, 0,
+        true, 0xBB3D},
+    {"CRC-16/UMTS",        CRC_POLYNOMIAL_CRC_16, 0, 0,
+        false, 0xFEE8},
+    {"CRC-16/XMODEM",      CRC_POLYNOMIAL_CRC_CCITT, 0, 0,
+        false, 0x31C3},
+    {"CRC-16/IBM-3740",    CRC_POLYNOMIAL_CRC_CCITT, 0xFFFF, 0,
+        false, 0x29B1},
+    {"CRC-16/KERMIT",      CRC_POLYNOMIAL_CRC_CCITT, 0, 0,
+        true, 0x2189}
+};
+
+static uint32_t crcSWTables[2][CRCSW_TABLE_SIZE];
+
+static CRCSW_Object crcSWObjects[2];
+
+static const CRCSW_HWAttrs crcSWHWAttrs[2] = {
+    {
+        .table = crcSWTables[0]
+    },
+    {
+        .table = crcSWTables[1]
+    }
+};
+
+const CRC_Config CRC_config[2] = {
+    {
+        .fxnTablePtr = &CRCSW_fxnTable,
+        .object = &crcSWObjects[0],
+        .hwAttrs = &crcSWHWAttrs[0]
+    },
+    {
+        .fxnTablePtr = &CRCSW_fxnTable,
+        .object = &crcSWObjects[1],
+        .hwAttrs = &crcSWHWAttrs[1]
+    }
+};
+
+const uint_least8_t CRC_count = 2;
+
+static uint32_t seed = 0x9E3779B9;
+static uint8_t  message[MAX_MESSAGE + 8];
+
+/* Keeps the benchmarked results live */
+static volatile uint32_t sink;
+
+/*
+ *  ======== widthOf ========
+ */
+static int widthOf(CRC_Polynomial polynomial)
+{
+    return (((polynomial == CRC_POLYNOMIAL_CRC_16) ||
+        (polynomial == CRC_POLYNOMIAL_CRC_CCITT)) ? 16 : 32);
+}
+
+/*
+ *  ======== reference ========
+ *  One bit at a time, straight from the definition.
+ */
+static uint32_t reference(const Variant *v, const uint8_t *data, size_t len)
+{
+    int      width = widthOf(v->polynomial);
+    uint32_t top = 1U << (width - 1);
+    uint32_t mask = (width == 32) ? 0xFFFFFFFF : ((1U << width) - 1);
+    uint32_t crc = v->seed & mask;
+    uint32_t result;
+    uint8_t  byte;
+    int      bit;
+
+    while (len-- > 0) {
+        byte = *data++;
+        for (bit = 0; bit < 8; bit++) {
+            /* Reflected CRCs consume each byte LSB first */
+            if (((crc & top) != 0) != (((v->reflect ? (byte >> bit) :
+                (byte >> (7 - bit))) & 1) != 0)) {
+                crc = ((crc << 1) ^ v->polynomial) & mask;
+            }
+            else {
+                crc = (crc << 1) & mask;
+            }
+        }
+    }
+
+    result = crc;
+    if (v->reflect) {
+        result = 0;
+        for (bit = 0; bit < width; bit++) {
+            result = (result << 1) | ((crc >> bit) & 1);
+        }
+    }
+
+    return ((result ^ v->finalXor) & mask);
+}
+
+/*
+ *  ======== openVariant ========
+ */
+static CRC_Handle openVariant(uint_least8_t index, const Variant *v)
+{
+    CRC_Params params;
+    CRC_Handle handle;
+
+    CRC_Params_init(&params);
+    params.polynomial = v->polynomial;
+    params.seed = v->seed;
+    params.finalXor = v->finalXor;
+    params.reflect = v->reflect;
+
+    handle = CRC_open(index, &params);
+    TEST_ASSERT(handle != NULL);
+
+    return (handle);
+}
+
+/*
+ *  ======== crcPieces ========
+ *  CRC of len bytes fed in pieces of random size up to maxPiece.
+ */
+static uint32_t crcPieces(CRC_Handle handle, const uint8_t *data, size_t len,
+    size_t maxPiece)
+{
+    uint32_t result;
+    size_t   piece;
+
+    while (len > 0) {
+        piece = Test_random(&seed) % (maxPiece + 1);
+        if (piece > len) {
+            piece = len;
+        }
+        TEST_ASSERT(CRC_addData(handle, data, piece) == CRC_STATUS_SUCCESS);
+        data += piece;
+        len -= piece;
+    }
+    TEST_ASSERT(CRC_finalize(handle, &result) == CRC_STATUS_SUCCESS);
+
+    return (result);
+}
+
+/*
+ *  ======== testCheck ========
+ *  The check value of every variant, whole and split at every point.
+ */
+static void testCheck(void)
+{
+    static const uint8_t check[] = "123456789";
+    const Variant *v;
+    CRC_Handle     handle;
+    uint32_t       result;
+    unsigned int   i;
+    size_t         split;
+
+    for (i = 0; i < sizeof(variants) / sizeof(variants[0]); i++) {
+        v = &variants[i];
+        TEST_ASSERT(reference(v, check, 9) == v->check);
+
+        handle = openVariant(0, v);
+
+        TEST_ASSERT(CRC_calculate(handle, check, 9, &result) ==
+            CRC_STATUS_SUCCESS);
+        TEST_ASSERT(result == v->check);
+
+        for (split = 0; split <= 9; split++) {
+            TEST_ASSERT(CRC_addData(handle, check, split) ==
+                CRC_STATUS_SUCCESS);
+            TEST_ASSERT(CRC_addData(handle, check + split, 9 - split) ==
+                CRC_STATUS_SUCCESS);
+            TEST_ASSERT(CRC_finalize(handle, &result) == CRC_STATUS_SUCCESS);
+            TEST_ASSERT(result == v->check);
+        }
+
+        CRC_close(handle);
+        printf("check %s: ok, 0x%x\n", v->name, (unsigned int)result);
+    }
+}
+
+/*
+ *  ======== testRandom ========
+ *  Random messages at random alignments in random pieces: CRC-32 against
+ *  zlib, every variant against the reference, on two instances fed in
+ *  turn.
+ */
+static void testRandom(void)
+{
+    const Variant *a;
+    const Variant *b;
+    CRC_Handle     handleA;
+    CRC_Handle     handleB;
+    uint32_t       resultA;
+    uint32_t       resultB;
+    uint8_t       *data;
+    size_t         len;
+    size_t         piece;
+    size_t         offset;
+    unsigned int   count = sizeof(variants) / sizeof(variants[0]);
+    int            round;
+
+    handleA = openVariant(0, &variants[0]);
+    for (round = 0; round < ROUNDS; round++) {
+        data = message + Test_random(&seed) % 8;
+        len = Test_random(&seed) % (MAX_MESSAGE + 1);
+        for (offset = 0; offset < len; offset++) {
+            data[offset] = (uint8_t)Test_random(&seed);
+        }
+
+        TEST_ASSERT(crcPieces(handleA, data, len, (round & 1) ? 13 : len) ==
+            (uint32_t)crc32(crc32(0, Z_NULL, 0), data, len));
+    }
+    CRC_close(handleA);
+    printf("random CRC-32 against zlib: ok, %d messages\n", ROUNDS);
+
+    for (round = 0; round < ROUNDS; round++) {
+        a = &variants[Test_random(&seed) % count];
+        b = &variants[Test_random(&seed) % count];
+        handleA = openVariant(0, a);
+        handleB = openVariant(1, b);
+
+        data = message + Test_random(&seed) % 8;
+        len = Test_random(&seed) % (MAX_MESSAGE + 1);
+        for (offset = 0; offset < len; offset++) {
+            data[offset] = (uint8_t)Test_random(&seed);
+        }
+
+        for (offset = 0; offset < len; offset += piece) {
+            piece = 1 + Test_random(&seed) % 100;
+            if (piece > len - offset) {
+                piece = len - offset;
+            }
+            TEST_ASSERT(CRC_addData(handleA, data + offset, piece) ==
+                CRC_STATUS_SUCCESS);
+            TEST_ASSERT(CRC_addData(handleB, data + offset, piece) ==
+                CRC_STATUS_SUCCESS);
+        }
+        TEST_ASSERT(CRC_finalize(handleA, &resultA) == CRC_STATUS_SUCCESS);
+        TEST_ASSERT(CRC_finalize(handleB, &resultB) == CRC_STATUS_SUCCESS);
+        TEST_ASSERT(resultA == reference(a, data, len));
+        TEST_ASSERT(resultB == reference(b, data, len));
+
+        CRC_close(handleA);
+        CRC_close(handleB);
+    }
+    printf("random variants against reference: ok, %d messages\n", ROUNDS);
+}
+
+/*
+ *  ======== nowUsec ========
+ */
+static double nowUsec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (ts.tv_sec * 1e6 + ts.tv_nsec / 1e3);
+}
+
+/*
+ *  ======== bench ========
+ *  Throughput, in MB/s, by buffer size.
+ */
+static void bench(void)
+{
+    static const size_t sizes[] = {16, 64, 256, 1024, 4096};
+    CRC_Handle   handle;
+    uint32_t     result;
+    unsigned int s;
+    unsigned int n;
+    unsigned int iterations;
+    double       start;
+    double       crcsw;
+    double       zlib;
+    double       bitwise;
+    size_t       i;
+
+    for (i = 0; i < MAX_MESSAGE; i++) {
+        message[i] = (uint8_t)Test_random(&seed);
+    }
+
+    handle = openVariant(0, &variants[0]);
+
+    printf("%6s %12s %12s %12s\n", "bytes", "CRCSW MB/s", "zlib MB/s",
+        "bitwise MB/s");
+
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        iterations = (64 * 1024 * 1024) / sizes[s];
+
+        start = nowUsec();
+        for (n = 0; n < iterations; n++) {
+            CRC_calculate(handle, message, sizes[s], &result);
+            sink = result;
+        }
+        crcsw = iterations * sizes[s] / (nowUsec() - start);
+
+        start = nowUsec();
+        for (n = 0; n < iterations; n++) {
+            sink = crc32(crc32(0, Z_NULL, 0), message, sizes[s]);
+        }
+        zlib = iterations * sizes[s] / (nowUsec() - start);
+
+        start = nowUsec();
+        for (n = 0; n < iterations / 64; n++) {
+            sink = reference(&variants[0], message, sizes[s]);
+        }
+        bitwise = iterations / 64 * sizes[s] / (nowUsec() - start);
+
+        printf("%6u %12.1f %12.1f %12.1f\n", (unsigned int)sizes[s], crcsw,
+            zlib, bitwise);
+    }
+
+    CRC_close(handle);
+}
+
+int main(int argc, char *argv[])
+{
+    CRC_init();
+
+    if ((argc > 1) && (strcmp(argv[1], "bench") == 0)) {
+        bench();
+    }
+    else {
+        testCheck();
+        testRandom();
+    }
+
+    return (0);
+}
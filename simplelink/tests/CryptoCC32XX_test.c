@@ -0,0 +1,1310 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== CryptoCC32XX_test.c ========
+ *  CryptoCC32XX against the DTHE and uDMA models in cc32xx/.
+ *
+ *  The published vectors in vectors/ are run through every path of the
+ *  driver: the blocking APIs fed by the uDMA and, with misaligned buffers,
+ *  by the CPU, CryptoCC32XX_submit() and CryptoCC32XX_queue(). Long random
+ *  messages, several times the largest uDMA transfer, are then checked
+ *  against the reference implementations in ref/: ciphers split at random
+ *  points with the IV chained from piece to piece, hashes split at random
+ *  points and alignments, so that they take several engine passes with
+ *  their state saved and restored in between.
+ *
+ *  "CryptoCC32XX_test bench" reports, per kilobyte processed, the model's
+ *  driverlib calls, CPU register words, uDMA items and interrupts, and the
+ *  host time taken. These are host side counts: they compare the cost of
+ *  the driver paths with each other, not with the device. Cycles per byte
+ *  on the device need a target build, which this harness does not have.
+ */
+
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <ti/drivers/Power.h>
+#include <ti/drivers/power/PowerCC32XX.h>
+#include <ti/drivers/crypto/CryptoCC32XX.h>
+#include <ti/drivers/dma/UDMACC32XX.h>
+
+#include <ti/devices/cc32xx/inc/hw_ints.h>
+
+#include "cc32xx/DTHE_host.h"
+#include "cc32xx/UDMA_host.h"
+#include "ref/CryptoRef.h"
+#include "test.h"
+
+#define VECTOR_DIR       "vectors/"
+#define VECTOR_MAX_DATA  (256)
+#define VECTOR_MAX_LINE  (1024)
+
+/* Long messages: more than three of the driver's 4096 byte uDMA transfers */
+#define LARGE_SIZE       (3 * 4096 + 1600)
+#define LARGE_ROUNDS     (8)
+
+#define TIMEOUT_SEC      (120)
+
+typedef enum Path {
+    PATH_BLOCKING,
+    PATH_SUBMIT,
+    PATH_QUEUE
+} Path;
+
+typedef struct Vector {
+    bool     decrypt;
+    unsigned int L;
+    uint8_t  key[VECTOR_MAX_DATA];
+    size_t   keyLen;
+    uint8_t  iv[CryptoRef_AES_BLOCK_SIZE];
+    size_t   ivLen;
+    uint8_t  in[VECTOR_MAX_DATA];
+    size_t   inLen;
+    uint8_t  out[VECTOR_MAX_DATA];
+    size_t   outLen;
+    long     bits;
+    size_t   tlen;
+} Vector;
+
+typedef struct CipherFile {
+    const char *name;
+    CryptoCC32XX_EncryptMethod method;
+} CipherFile;
+
+typedef struct HashFile {
+    const char *name;
+    CryptoCC32XX_HmacMethod method;
+} HashFile;
+
+static const CipherFile cipherFiles[] = {
+    {"AES_ECB.rsp", CryptoCC32XX_AES_ECB},
+    {"AES_CBC.rsp", CryptoCC32XX_AES_CBC},
+    {"AES_CFB128.rsp", CryptoCC32XX_AES_CFB},
+    {"AES_CTR.rsp", CryptoCC32XX_AES_CTR},
+    {"DES_ECB.rsp", CryptoCC32XX_DES_ECB},
+    {"DES_CBC.rsp", CryptoCC32XX_DES_CBC},
+    {"TDES_ECB.rsp", CryptoCC32XX_DES_ECB}
+};
+
+static const HashFile hashFiles[] = {
+    {"MD5.rsp", CryptoCC32XX_HMAC_MD5},
+    {"SHA1.rsp", CryptoCC32XX_HMAC_SHA1},
+    {"SHA224.rsp", CryptoCC32XX_HMAC_SHA224},
+    {"SHA256.rsp", CryptoCC32XX_HMAC_SHA256}
+};
+
+static const CryptoCC32XX_HmacMethod hashMethods[] = {
+    CryptoCC32XX_HMAC_MD5,
+    CryptoCC32XX_HMAC_SHA1,
+    CryptoCC32XX_HMAC_SHA224,
+    CryptoCC32XX_HMAC_SHA256
+};
+
+static CryptoCC32XX_Object cryptoCC32XXObjects[1];
+
+const CryptoCC32XX_Config CryptoCC32XX_config[1] = {
+    {
+        .object = &cryptoCC32XXObjects[0]
+    }
+};
+
+const uint8_t CryptoCC32XX_count = 1;
+
+static uint8_t dmaControlTable[1024] __attribute__((aligned(1024)));
+
+static UDMACC32XX_Object udmaCC32XXObject;
+
+static void dmaErrorFxn(uintptr_t arg);
+
+static const UDMACC32XX_HWAttrs udmaCC32XXHWAttrs = {
+    .controlBaseAddr = (void *)dmaControlTable,
+    .dmaErrorFxn = dmaErrorFxn,
+    .intNum = INT_UDMAERR,
+    .intPriority = (~0)
+};
+
+const UDMACC32XX_Config UDMACC32XX_config[1] = {
+    {
+        .object = &udmaCC32XXObject,
+        .hwAttrs = &udmaCC32XXHWAttrs
+    }
+};
+
+static CryptoCC32XX_Handle handle;
+static uint32_t seed = 0x6A09E667;
+static volatile uint32_t completed;
+
+/* Word aligned buffers; tests offset into them for misaligned data */
+static uint32_t bufIn[(LARGE_SIZE + 64) / sizeof(uint32_t)];
+static uint32_t bufOut[(LARGE_SIZE + 64) / sizeof(uint32_t)];
+static uint32_t bufRef[(LARGE_SIZE + 64) / sizeof(uint32_t)];
+
+/*
+ *  ======== dmaErrorFxn ========
+ */
+static void dmaErrorFxn(uintptr_t arg)
+{
+    TEST_ASSERT(false);
+}
+
+/*
+ *  ======== opDone ========
+ */
+static void opDone(CryptoCC32XX_Handle h, CryptoCC32XX_Operation *op)
+{
+    completed++;
+}
+
+/*
+ *  ======== fillRandom ========
+ */
+static void fillRandom(void *buf, size_t len)
+{
+    uint8_t *p = buf;
+
+    while (len-- > 0) {
+        *p++ = (uint8_t)Test_random(&seed);
+    }
+}
+
+/*
+ *  ======== refAlgo ========
+ */
+static CryptoRef_HashAlgo refAlgo(CryptoCC32XX_HmacMethod method)
+{
+    return ((CryptoRef_HashAlgo)(method - CryptoCC32XX_HMAC_MD5));
+}
+
+/*
+ *  ======== isDes ========
+ */
+static bool isDes(CryptoCC32XX_EncryptMethod method)
+{
+    return ((method >> 8) == CryptoCC32XX_DES);
+}
+
+/*
+ *  ======== blockSize ========
+ */
+static size_t blockSize(CryptoCC32XX_EncryptMethod method)
+{
+    return (isDes(method) ? CryptoRef_DES_BLOCK_SIZE :
+        CryptoRef_AES_BLOCK_SIZE);
+}
+
+/*
+ *  ======== refBlock ========
+ */
+static void refBlock(CryptoCC32XX_EncryptMethod method, const void *key,
+    bool decrypt, const uint8_t *in, uint8_t *out)
+{
+    if (isDes(method)) {
+        if (decrypt) {
+            CryptoRef_desDecrypt(key, in, out);
+        }
+        else {
+            CryptoRef_desEncrypt(key, in, out);
+        }
+    }
+    else {
+        if (decrypt) {
+            CryptoRef_aesDecrypt(key, in, out);
+        }
+        else {
+            CryptoRef_aesEncrypt(key, in, out);
+        }
+    }
+}
+
+/*
+ *  ======== refCipher ========
+ *  The engines' modes on the reference block ciphers; iv is updated as
+ *  the driver updates it. The counter of CTR mode is the last 32 bits of
+ *  the IV, as configured by the driver.
+ */
+static void refCipher(CryptoCC32XX_EncryptMethod method, bool decrypt,
+    const uint8_t *keyBytes, size_t keyLen, uint8_t *iv, const uint8_t *in,
+    uint8_t *out, size_t len)
+{
+    CryptoRef_AesKey aesKey;
+    CryptoRef_DesKey desKey;
+    const void *key = &aesKey;
+    size_t   bs = blockSize(method);
+    uint8_t  t[CryptoRef_AES_BLOCK_SIZE];
+    uint8_t  c[CryptoRef_AES_BLOCK_SIZE];
+    size_t   offset;
+    size_t   i;
+    int      j;
+
+    if (isDes(method)) {
+        CryptoRef_desSetKey(&desKey, keyBytes, keyLen == 24);
+        key = &desKey;
+    }
+    else {
+        CryptoRef_aesSetKey(&aesKey, keyBytes, keyLen);
+    }
+
+    for (offset = 0; offset < len; offset += bs) {
+        memcpy(c, in + offset, bs);
+        switch (method) {
+            case CryptoCC32XX_AES_ECB:
+            case CryptoCC32XX_DES_ECB:
+                refBlock(method, key, decrypt, c, out + offset);
+                break;
+
+            case CryptoCC32XX_AES_CBC:
+            case CryptoCC32XX_DES_CBC:
+                if (decrypt) {
+                    refBlock(method, key, true, c, t);
+                    for (i = 0; i < bs; i++) {
+                        out[offset + i] = t[i] ^ iv[i];
+                    }
+                    memcpy(iv, c, bs);
+                }
+                else {
+                    for (i = 0; i < bs; i++) {
+                        t[i] = c[i] ^ iv[i];
+                    }
+                    refBlock(method, key, false, t, out + offset);
+                    memcpy(iv, out + offset, bs);
+                }
+                break;
+
+            case CryptoCC32XX_AES_CFB:
+                refBlock(method, key, false, iv, t);
+                for (i = 0; i < bs; i++) {
+                    out[offset + i] = c[i] ^ t[i];
+                }
+                memcpy(iv, decrypt ? c : out + offset, bs);
+                break;
+
+            case CryptoCC32XX_AES_CTR:
+                refBlock(method, key, false, iv, t);
+                for (i = 0; i < bs; i++) {
+                    out[offset + i] = c[i] ^ t[i];
+                }
+                for (j = 15; (j >= 12) && (++iv[j] == 0); j--) {
+                }
+                break;
+
+            default:
+                TEST_ASSERT(false);
+                break;
+        }
+    }
+}
+
+/*
+ *  ======== cipher ========
+ *  Encrypts or decrypts through the driver, by the given path. iv, if
+ *  the mode has one, is updated by the driver.
+ */
+static int32_t cipher(CryptoCC32XX_EncryptMethod method, bool decrypt,
+    const uint8_t *key, size_t keyLen, uint8_t *iv, void *in, void *out,
+    size_t len, Path path)
+{
+    CryptoCC32XX_EncryptParams params;
+    CryptoCC32XX_Operation op;
+    uint32_t ivBuf[CryptoRef_AES_BLOCK_SIZE / sizeof(uint32_t)];
+    uint32_t done = completed;
+    size_t   outLen = len;
+    int32_t  status;
+
+    memcpy(ivBuf, iv, blockSize(method));
+    memset(&params, 0, sizeof(params));
+    if (isDes(method)) {
+        params.des.pKey = key;
+        params.des.keySize = (keyLen == 24) ?
+            CryptoCC32XX_DES_KEY_SIZE_TRIPLE : CryptoCC32XX_DES_KEY_SIZE_SINGLE;
+        params.des.pIV = ivBuf;
+    }
+    else {
+        params.aes.pKey = key;
+        params.aes.keySize = (keyLen == 16) ? CryptoCC32XX_AES_KEY_SIZE_128BIT :
+            (keyLen == 24) ? CryptoCC32XX_AES_KEY_SIZE_192BIT :
+            CryptoCC32XX_AES_KEY_SIZE_256BIT;
+        params.aes.pIV = ivBuf;
+    }
+
+    if (path == PATH_BLOCKING) {
+        status = decrypt ?
+            CryptoCC32XX_decrypt(handle, method, in, len, out, &outLen, &params) :
+            CryptoCC32XX_encrypt(handle, method, in, len, out, &outLen, &params);
+    }
+    else {
+        CryptoCC32XX_Operation_init(&op);
+        op.method = method;
+        op.decrypt = decrypt;
+        op.pInBuff = in;
+        op.inLen = len;
+        op.pOutBuff = out;
+        op.pParams = &params;
+        op.callbackFxn = opDone;
+        status = (path == PATH_SUBMIT) ? CryptoCC32XX_submit(handle, &op) :
+            CryptoCC32XX_queue(handle, &op);
+        if (status == CryptoCC32XX_STATUS_SUCCESS) {
+            /* Everything runs from the calls into the models */
+            TEST_ASSERT(completed == done + 1);
+            status = op.status;
+        }
+    }
+
+    memcpy(iv, ivBuf, blockSize(method));
+
+    return (status);
+}
+
+/*
+ *  ======== hmacKey ========
+ *  The driver takes the key as one zero padded block; longer keys are
+ *  hashed first, as HMAC specifies.
+ */
+static void hmacKey(CryptoCC32XX_HmacMethod method, const uint8_t *key,
+    size_t keyLen, uint8_t *block)
+{
+    memset(block, 0, CryptoRef_HASH_BLOCK_SIZE);
+    if (keyLen > CryptoRef_HASH_BLOCK_SIZE) {
+        CryptoRef_hash(refAlgo(method), key, keyLen, block);
+    }
+    else {
+        memcpy(block, key, keyLen);
+    }
+}
+
+/*
+ *  ======== hashPieces ========
+ *  Hashes len bytes through CryptoCC32XX_hashUpdate(), in pieces of
+ *  random size up to maxPiece, and closes the hash.
+ */
+static int32_t hashPieces(CryptoCC32XX_HmacMethod method, uint8_t *key,
+    const uint8_t *data, size_t len, size_t maxPiece, uint8_t *digest)
+{
+    CryptoCC32XX_HashContext ctx;
+    size_t   piece;
+    int32_t  status;
+
+    status = CryptoCC32XX_hashInit(handle, &ctx, method, key);
+    while ((status == CryptoCC32XX_STATUS_SUCCESS) && (len > 0)) {
+        piece = 1 + Test_random(&seed) % maxPiece;
+        if (piece > len) {
+            piece = len;
+        }
+        status = CryptoCC32XX_hashUpdate(handle, &ctx, data, piece);
+        data += piece;
+        len -= piece;
+    }
+    if (status == CryptoCC32XX_STATUS_SUCCESS) {
+        status = CryptoCC32XX_hashFinal(handle, &ctx, digest);
+    }
+
+    return (status);
+}
+
+/*
+ *  ======== hashOps ========
+ *  Hashes len bytes through a chain of operations of random size, the last
+ *  one closing the hash, by CryptoCC32XX_submit() or CryptoCC32XX_queue().
+ */
+static int32_t hashOps(CryptoCC32XX_HmacMethod method, uint8_t *key,
+    const uint8_t *data, size_t len, Path path, uint8_t *digest)
+{
+    CryptoCC32XX_HashContext ctx;
+    CryptoCC32XX_Operation ops[8];
+    uint32_t done = completed;
+    size_t   piece;
+    int      count = 0;
+    int      i;
+
+    TEST_ASSERT(CryptoCC32XX_hashInit(handle, &ctx, method, key) ==
+        CryptoCC32XX_STATUS_SUCCESS);
+
+    do {
+        piece = (count == 7) ? len : (1 + Test_random(&seed) % len);
+        CryptoCC32XX_Operation_init(&ops[count]);
+        ops[count].hashCtx = &ctx;
+        ops[count].pInBuff = (void *)data;
+        ops[count].inLen = piece;
+        ops[count].callbackFxn = opDone;
+        if (count > 0) {
+            ops[count - 1].next = &ops[count];
+        }
+        data += piece;
+        len -= piece;
+        count++;
+    } while (len > 0);
+    ops[count - 1].pDigest = digest;
+
+    TEST_ASSERT(((path == PATH_SUBMIT) ? CryptoCC32XX_submit(handle, ops) :
+        CryptoCC32XX_queue(handle, ops)) == CryptoCC32XX_STATUS_SUCCESS);
+    TEST_ASSERT(completed == done + count);
+
+    for (i = 0; i < count; i++) {
+        if (ops[i].status != CryptoCC32XX_STATUS_SUCCESS) {
+            return (ops[i].status);
+        }
+    }
+
+    return (CryptoCC32XX_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== checkIdle ========
+ *  Every operation has given back the LPDS constraint.
+ */
+static void checkIdle(void)
+{
+    TEST_ASSERT(Power_getConstraintMask() == 0);
+}
+
+/*
+ *  ======== parseHex ========
+ */
+static size_t parseHex(const char *text, uint8_t *buf, size_t max)
+{
+    unsigned int byte;
+    size_t   len = 0;
+
+    while ((text[0] != '\0') && (text[0] != '\n') && (text[0] != '\r')) {
+        TEST_ASSERT(len < max);
+        TEST_ASSERT(sscanf(text, "%2x", &byte) == 1);
+        buf[len++] = (uint8_t)byte;
+        text += 2;
+    }
+
+    return (len);
+}
+
+/*
+ *  ======== readVector ========
+ *  Reads the next record of a CAVP response file. Section headers set the
+ *  direction, [ENCRYPT] or [DECRYPT], and the digest length, [L = n].
+ */
+static bool readVector(FILE *file, Vector *v)
+{
+    char     line[VECTOR_MAX_LINE];
+    char     name[16];
+    char    *value;
+    bool     data = false;
+
+    v->keyLen = 0;
+    v->ivLen = 0;
+    v->inLen = 0;
+    v->outLen = 0;
+    v->bits = -1;
+    v->tlen = 0;
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (line[0] == '#') {
+            continue;
+        }
+        if (line[0] == '[') {
+            if (strncmp(line, "[ENCRYPT]", 9) == 0) {
+                v->decrypt = false;
+            }
+            else if (strncmp(line, "[DECRYPT]", 9) == 0) {
+                v->decrypt = true;
+            }
+            else {
+                TEST_ASSERT(sscanf(line, "[L = %u]", &v->L) == 1 ||
+                    sscanf(line, "[L=%u]", &v->L) == 1);
+            }
+            continue;
+        }
+
+        value = strchr(line, '=');
+        if (value == NULL) {
+            /* A blank line ends a record */
+            if (data) {
+                break;
+            }
+            continue;
+        }
+        TEST_ASSERT(sscanf(line, "%15s", name) == 1);
+        for (value++; *value == ' '; value++) {
+        }
+        data = true;
+
+        if ((strncmp(name, "KEY", 3) == 0) || (strcmp(name, "Key") == 0)) {
+            v->keyLen += parseHex(value, v->key + v->keyLen,
+                sizeof(v->key) - v->keyLen);
+        }
+        else if (strcmp(name, "IV") == 0) {
+            v->ivLen = parseHex(value, v->iv, sizeof(v->iv));
+        }
+        else if ((strcmp(name, "Msg") == 0) ||
+            (strcmp(name, v->decrypt ? "CIPHERTEXT" : "PLAINTEXT") == 0)) {
+            v->inLen = parseHex(value, v->in, sizeof(v->in));
+        }
+        else if ((strcmp(name, "MD") == 0) || (strcmp(name, "Mac") == 0) ||
+            (strcmp(name, v->decrypt ? "PLAINTEXT" : "CIPHERTEXT") == 0)) {
+            v->outLen = parseHex(value, v->out, sizeof(v->out));
+        }
+        else if (strcmp(name, "Len") == 0) {
+            v->bits = atol(value);
+        }
+        else if (strcmp(name, "Tlen") == 0) {
+            v->tlen = (size_t)atol(value);
+        }
+    }
+
+    if (v->bits >= 0) {
+        v->inLen = (size_t)v->bits / 8;
+    }
+
+    return (data);
+}
+
+/*
+ *  ======== openVectors ========
+ */
+static FILE *openVectors(const char *name)
+{
+    char  path[64];
+    FILE *file;
+
+    snprintf(path, sizeof(path), VECTOR_DIR "%s", name);
+    file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "can't open %s\n", path);
+        exit(EXIT_FAILURE);
+    }
+
+    return (file);
+}
+
+/*
+ *  ======== runCipherVector ========
+ */
+static void runCipherVector(CryptoCC32XX_EncryptMethod method,
+    const Vector *v)
+{
+    uint8_t  *in = (uint8_t *)bufIn;
+    uint8_t  *out = (uint8_t *)bufOut;
+    uint8_t  iv[CryptoRef_AES_BLOCK_SIZE];
+    uint8_t  refIv[CryptoRef_AES_BLOCK_SIZE];
+    uint8_t  expected[VECTOR_MAX_DATA];
+    Path     path;
+    int      misalign;
+
+    TEST_ASSERT((v->inLen == v->outLen) && (v->inLen > 0));
+
+    /* The reference must agree with the published answer */
+    memcpy(refIv, v->iv, sizeof(refIv));
+    refCipher(method, v->decrypt, v->key, v->keyLen, refIv, v->in, expected,
+        v->inLen);
+    TEST_ASSERT(memcmp(expected, v->out, v->outLen) == 0);
+
+    for (path = PATH_BLOCKING; path <= PATH_QUEUE; path++) {
+        for (misalign = 0; misalign <= ((path == PATH_BLOCKING) ? 1 : 0);
+            misalign++) {
+            memcpy(in + misalign, v->in, v->inLen);
+            memset(out, 0, v->outLen + 1);
+            memcpy(iv, v->iv, sizeof(iv));
+            TEST_ASSERT(cipher(method, v->decrypt, v->key, v->keyLen, iv,
+                in + misalign, out + misalign, v->inLen, path) ==
+                CryptoCC32XX_STATUS_SUCCESS);
+            TEST_ASSERT(memcmp(out + misalign, v->out, v->outLen) == 0);
+
+            /* The CPU path of DES does not give back the IV */
+            if ((v->ivLen > 0) && (!isDes(method) || (misalign == 0 &&
+                v->inLen >= CryptoCC32XX_DMA_MIN_SIZE) ||
+                (path != PATH_BLOCKING))) {
+                TEST_ASSERT(memcmp(iv, refIv, blockSize(method)) == 0);
+            }
+        }
+    }
+
+    checkIdle();
+}
+
+/*
+ *  ======== runHashVector ========
+ */
+static void runHashVector(CryptoCC32XX_HmacMethod method, const Vector *v,
+    bool hmac)
+{
+    CryptoCC32XX_HmacParams params;
+    uint8_t  key[CryptoRef_HASH_BLOCK_SIZE];
+    uint8_t  digest[CryptoRef_MAX_DIGEST_SIZE];
+    uint8_t  signature[CryptoRef_MAX_DIGEST_SIZE];
+    uint8_t *data = (uint8_t *)bufIn;
+    uint8_t *pKey = hmac ? key : NULL;
+    size_t   size = CryptoRef_digestSize(refAlgo(method));
+    size_t   tlen = hmac ? v->tlen : size;
+    Path     path;
+
+    TEST_ASSERT((v->L == size) && (v->outLen == tlen));
+    if (v->inLen == 0) {
+        /* The engine can't hash an empty message */
+        return;
+    }
+
+    if (hmac) {
+        hmacKey(method, v->key, v->keyLen, key);
+        CryptoRef_hmac(refAlgo(method), v->key, v->keyLen, v->in, v->inLen,
+            digest);
+    }
+    else {
+        CryptoRef_hash(refAlgo(method), v->in, v->inLen, digest);
+    }
+    TEST_ASSERT(memcmp(digest, v->out, tlen) == 0);
+
+    memcpy(data, v->in, v->inLen);
+
+    memset(digest, 0, sizeof(digest));
+    TEST_ASSERT(hashPieces(method, pKey, data, v->inLen, v->inLen, digest) ==
+        CryptoCC32XX_STATUS_SUCCESS);
+    TEST_ASSERT(memcmp(digest, v->out, tlen) == 0);
+
+    memset(digest, 0, sizeof(digest));
+    TEST_ASSERT(hashPieces(method, pKey, data + 1, 0, 1, digest) ==
+        CryptoCC32XX_STATUS_ERROR);
+    memmove(data + 1, data, v->inLen);
+    TEST_ASSERT(hashPieces(method, pKey, data + 1, v->inLen, 7, digest) ==
+        CryptoCC32XX_STATUS_SUCCESS);
+    TEST_ASSERT(memcmp(digest, v->out, tlen) == 0);
+    memmove(data, data + 1, v->inLen);
+
+    for (path = PATH_SUBMIT; path <= PATH_QUEUE; path++) {
+        memset(digest, 0, sizeof(digest));
+        TEST_ASSERT(hashOps(method, pKey, data, v->inLen, path, digest) ==
+            CryptoCC32XX_STATUS_SUCCESS);
+        TEST_ASSERT(memcmp(digest, v->out, tlen) == 0);
+    }
+
+    CryptoCC32XX_HmacParams_init(&params);
+    params.pKey = pKey;
+    TEST_ASSERT(CryptoCC32XX_sign(handle, method, data, v->inLen, signature,
+        &params) == CryptoCC32XX_STATUS_SUCCESS);
+    TEST_ASSERT(memcmp(signature, v->out, tlen) == 0);
+
+    CryptoCC32XX_HmacParams_init(&params);
+    params.pKey = pKey;
+    memcpy(signature, digest, size);
+    TEST_ASSERT(CryptoCC32XX_verify(handle, method, data, v->inLen, signature,
+        &params) == CryptoCC32XX_STATUS_SUCCESS);
+
+    checkIdle();
+}
+
+/*
+ *  ======== testVectors ========
+ */
+static void testVectors(void)
+{
+    CryptoCC32XX_HmacMethod method;
+    unsigned int i;
+    unsigned int count;
+    Vector       v;
+    FILE        *file;
+
+    memset(&v, 0, sizeof(v));
+
+    for (i = 0; i < sizeof(cipherFiles) / sizeof(cipherFiles[0]); i++) {
+        file = openVectors(cipherFiles[i].name);
+        for (count = 0; readVector(file, &v); count++) {
+            runCipherVector(cipherFiles[i].method, &v);
+        }
+        fclose(file);
+        TEST_ASSERT(count > 0);
+        printf("vectors %s: ok, %u cases\n", cipherFiles[i].name, count);
+    }
+
+    for (i = 0; i < sizeof(hashFiles) / sizeof(hashFiles[0]); i++) {
+        file = openVectors(hashFiles[i].name);
+        for (count = 0; readVector(file, &v); count++) {
+            runHashVector(hashFiles[i].method, &v, false);
+        }
+        fclose(file);
+        TEST_ASSERT(count > 0);
+        printf("vectors %s: ok, %u cases\n", hashFiles[i].name, count);
+    }
+
+    file = openVectors("HMAC.rsp");
+    for (count = 0; readVector(file, &v); count++) {
+        method = (v.L == 16) ? CryptoCC32XX_HMAC_MD5 :
+            (v.L == 20) ? CryptoCC32XX_HMAC_SHA1 :
+            (v.L == 28) ? CryptoCC32XX_HMAC_SHA224 : CryptoCC32XX_HMAC_SHA256;
+        runHashVector(method, &v, true);
+    }
+    fclose(file);
+    TEST_ASSERT(count > 0);
+    printf("vectors HMAC.rsp: ok, %u cases\n", count);
+}
+
+/*
+ *  ======== testMillion ========
+ *  FIPS 180-2 and RFC 1321 test suites: one million 'a'. The message is
+ *  fed in pieces of several uDMA transfers, so each piece takes several
+ *  transfers and the hash state goes through the context between pieces.
+ */
+static void testMillion(void)
+{
+    static const char *expected[] = {
+        "7707d6ae4e027c70eea2a935c2296f21",
+        "34aa973cd4c4daa4f61eeb2bdbad27316534016f",
+        "20794655980c91d8bbb4c1ea97618a4bf03f42581948b2ee4ee7ad67",
+        "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"
+    };
+    CryptoCC32XX_HashContext ctx;
+    uint8_t  digest[CryptoRef_MAX_DIGEST_SIZE];
+    uint8_t  answer[CryptoRef_MAX_DIGEST_SIZE];
+    size_t   left;
+    size_t   piece;
+    unsigned int i;
+
+    memset(bufIn, 'a', LARGE_SIZE);
+
+    for (i = 0; i < sizeof(hashMethods) / sizeof(hashMethods[0]); i++) {
+        TEST_ASSERT(CryptoCC32XX_hashInit(handle, &ctx, hashMethods[i],
+            NULL) == CryptoCC32XX_STATUS_SUCCESS);
+        for (left = 1000000; left > 0; left -= piece) {
+            piece = (left < LARGE_SIZE) ? left : LARGE_SIZE;
+            TEST_ASSERT(CryptoCC32XX_hashUpdate(handle, &ctx, bufIn, piece) ==
+                CryptoCC32XX_STATUS_SUCCESS);
+        }
+        TEST_ASSERT(CryptoCC32XX_hashFinal(handle, &ctx, digest) ==
+            CryptoCC32XX_STATUS_SUCCESS);
+        TEST_ASSERT(parseHex(expected[i], answer, sizeof(answer)) ==
+            CryptoRef_digestSize(refAlgo(hashMethods[i])));
+        TEST_ASSERT(memcmp(digest, answer,
+            CryptoRef_digestSize(refAlgo(hashMethods[i]))) == 0);
+    }
+
+    checkIdle();
+    printf("million a: ok\n");
+}
+
+/*
+ *  ======== testLargeCiphers ========
+ *  Long random messages, encrypted in random pieces by every path with the
+ *  IV chained from piece to piece, against the reference in one piece,
+ *  then decrypted in place.
+ */
+static void testLargeCiphers(void)
+{
+    static const struct {
+        CryptoCC32XX_EncryptMethod method;
+        size_t keyLen;
+    } cases[] = {
+        {CryptoCC32XX_AES_ECB, 16}, {CryptoCC32XX_AES_CBC, 16},
+        {CryptoCC32XX_AES_CBC, 24}, {CryptoCC32XX_AES_CBC, 32},
+        {CryptoCC32XX_AES_CTR, 16}, {CryptoCC32XX_AES_CTR, 32},
+        {CryptoCC32XX_AES_CFB, 24}, {CryptoCC32XX_DES_ECB, 8},
+        {CryptoCC32XX_DES_CBC, 8}, {CryptoCC32XX_DES_CBC, 24}
+    };
+    CryptoCC32XX_EncryptMethod method;
+    uint8_t *in = (uint8_t *)bufIn;
+    uint8_t *out = (uint8_t *)bufOut;
+    uint8_t *ref = (uint8_t *)bufRef;
+    uint8_t  key[32];
+    uint8_t  iv0[CryptoRef_AES_BLOCK_SIZE];
+    uint8_t  iv[CryptoRef_AES_BLOCK_SIZE];
+    uint8_t  refIv[CryptoRef_AES_BLOCK_SIZE];
+    size_t   bs;
+    size_t   len;
+    size_t   offset;
+    size_t   piece;
+    unsigned int pieces = 0;
+    unsigned int i;
+    int      round;
+    int      pass;
+    bool     decrypt;
+    Path     path;
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        method = cases[i].method;
+        bs = blockSize(method);
+
+        for (round = 0; round < LARGE_ROUNDS; round++) {
+            len = LARGE_SIZE - bs * (Test_random(&seed) % 64);
+            fillRandom(key, sizeof(key));
+            fillRandom(iv0, sizeof(iv0));
+            fillRandom(in, len);
+            memcpy(refIv, iv0, sizeof(refIv));
+            refCipher(method, false, key, cases[i].keyLen, refIv, in, ref,
+                len);
+
+            for (pass = 0; pass < 2; pass++) {
+                decrypt = (pass == 1);
+                memcpy(iv, iv0, sizeof(iv));
+                if (!decrypt) {
+                    memset(out, 0, len);
+                }
+                for (offset = 0; offset < len; offset += piece) {
+                    /* Pieces of 1 to 3 uDMA transfers, or shorter */
+                    piece = bs * (1 + Test_random(&seed) %
+                        (((round & 1) ? 3 * 4096 : 256) / bs));
+                    if (piece > len - offset) {
+                        piece = len - offset;
+                    }
+                    path = (Path)(Test_random(&seed) % 3);
+                    /* The CPU path of DES does not give back the IV */
+                    if (isDes(method) && (path == PATH_BLOCKING) &&
+                        (piece < CryptoCC32XX_DMA_MIN_SIZE)) {
+                        path = PATH_SUBMIT;
+                    }
+                    TEST_ASSERT(cipher(method, decrypt, key, cases[i].keyLen,
+                        iv, decrypt ? out + offset : in + offset,
+                        out + offset, piece, path) ==
+                        CryptoCC32XX_STATUS_SUCCESS);
+                    pieces++;
+                }
+
+                if (!decrypt) {
+                    TEST_ASSERT(memcmp(out, ref, len) == 0);
+                }
+                else {
+                    TEST_ASSERT(memcmp(out, in, len) == 0);
+                }
+                if ((method != CryptoCC32XX_AES_ECB) &&
+                    (method != CryptoCC32XX_DES_ECB)) {
+                    TEST_ASSERT(memcmp(iv, refIv, bs) == 0);
+                }
+            }
+        }
+    }
+
+    checkIdle();
+    printf("large ciphers: ok, %u pieces\n", pieces);
+}
+
+/*
+ *  ======== testLargeHashes ========
+ *  Long random messages hashed in random pieces at random alignments,
+ *  plain and with random HMAC keys, against the reference.
+ */
+static void testLargeHashes(void)
+{
+    CryptoCC32XX_HmacMethod method;
+    uint8_t *data = (uint8_t *)bufIn;
+    uint8_t  keyBytes[100];
+    uint8_t  key[CryptoRef_HASH_BLOCK_SIZE];
+    uint8_t  digest[CryptoRef_MAX_DIGEST_SIZE];
+    uint8_t  expected[CryptoRef_MAX_DIGEST_SIZE];
+    uint8_t *pKey;
+    size_t   keyLen;
+    size_t   len;
+    size_t   size;
+    unsigned int i;
+    int      round;
+    int      offset;
+
+    for (i = 0; i < sizeof(hashMethods) / sizeof(hashMethods[0]); i++) {
+        method = hashMethods[i];
+        size = CryptoRef_digestSize(refAlgo(method));
+
+        for (round = 0; round < LARGE_ROUNDS; round++) {
+            offset = Test_random(&seed) % 4;
+            len = 1 + Test_random(&seed) % (LARGE_SIZE - 4);
+            fillRandom(data + offset, len);
+
+            pKey = NULL;
+            if (round & 1) {
+                keyLen = 1 + Test_random(&seed) % sizeof(keyBytes);
+                fillRandom(keyBytes, keyLen);
+                hmacKey(method, keyBytes, keyLen, key);
+                pKey = key;
+                CryptoRef_hmac(refAlgo(method), keyBytes, keyLen,
+                    data + offset, len, expected);
+            }
+            else {
+                CryptoRef_hash(refAlgo(method), data + offset, len, expected);
+            }
+
+            memset(digest, 0, sizeof(digest));
+            TEST_ASSERT(hashPieces(method, pKey, data + offset, len,
+                (round & 2) ? 200 : 3 * 4096, digest) ==
+                CryptoCC32XX_STATUS_SUCCESS);
+            TEST_ASSERT(memcmp(digest, expected, size) == 0);
+
+            memset(digest, 0, sizeof(digest));
+            TEST_ASSERT(hashOps(method, pKey, data + offset, len,
+                (round & 2) ? PATH_SUBMIT : PATH_QUEUE, digest) ==
+                CryptoCC32XX_STATUS_SUCCESS);
+            TEST_ASSERT(memcmp(digest, expected, size) == 0);
+        }
+    }
+
+    checkIdle();
+    printf("large hashes: ok\n");
+}
+
+/*
+ *  ======== testInterleaved ========
+ *  Two streaming hashes with different algorithms and keys, updated in
+ *  turn: each update restores its own context into the engine.
+ */
+static void testInterleaved(void)
+{
+    CryptoCC32XX_HashContext ctxA;
+    CryptoCC32XX_HashContext ctxB;
+    CryptoRef_Hash refA;
+    uint8_t *data = (uint8_t *)bufIn;
+    uint8_t  key[CryptoRef_HASH_BLOCK_SIZE];
+    uint8_t  digestA[CryptoRef_MAX_DIGEST_SIZE];
+    uint8_t  digestB[CryptoRef_MAX_DIGEST_SIZE];
+    uint8_t  expected[CryptoRef_MAX_DIGEST_SIZE];
+    size_t   offset;
+    size_t   piece;
+
+    fillRandom(data, LARGE_SIZE);
+    fillRandom(key, 20);
+    memset(key + 20, 0, sizeof(key) - 20);
+
+    TEST_ASSERT(CryptoCC32XX_hashInit(handle, &ctxA, CryptoCC32XX_HMAC_SHA1,
+        NULL) == CryptoCC32XX_STATUS_SUCCESS);
+    TEST_ASSERT(CryptoCC32XX_hashInit(handle, &ctxB, CryptoCC32XX_HMAC_SHA256,
+        key) == CryptoCC32XX_STATUS_SUCCESS);
+    CryptoRef_hashInit(&refA, CryptoRef_SHA1);
+
+    for (offset = 0; offset < LARGE_SIZE; offset += piece) {
+        piece = 1 + Test_random(&seed) % 1500;
+        if (piece > LARGE_SIZE - offset) {
+            piece = LARGE_SIZE - offset;
+        }
+        TEST_ASSERT(CryptoCC32XX_hashUpdate(handle, &ctxA, data + offset,
+            piece) == CryptoCC32XX_STATUS_SUCCESS);
+        TEST_ASSERT(CryptoCC32XX_hashUpdate(handle, &ctxB, data + offset,
+            piece) == CryptoCC32XX_STATUS_SUCCESS);
+    }
+    TEST_ASSERT(CryptoCC32XX_hashFinal(handle, &ctxA, digestA) ==
+        CryptoCC32XX_STATUS_SUCCESS);
+    TEST_ASSERT(CryptoCC32XX_hashFinal(handle, &ctxB, digestB) ==
+        CryptoCC32XX_STATUS_SUCCESS);
+
+    CryptoRef_hashUpdate(&refA, data, LARGE_SIZE);
+    CryptoRef_hashFinal(&refA, expected);
+    TEST_ASSERT(memcmp(digestA, expected, 20) == 0);
+    CryptoRef_hmac(CryptoRef_SHA256, key, 20, data, LARGE_SIZE, expected);
+    TEST_ASSERT(memcmp(digestB, expected, 32) == 0);
+
+    checkIdle();
+    printf("interleaved hashes: ok\n");
+}
+
+/*
+ *  ======== testPipeline ========
+ *  Encrypt then MAC: the MAC of the cipher text is queued by the encrypt
+ *  operation when it completes.
+ */
+static void testPipeline(void)
+{
+    CryptoCC32XX_EncryptParams params;
+    CryptoCC32XX_HashContext ctx;
+    CryptoCC32XX_Operation enc;
+    CryptoCC32XX_Operation mac;
+    uint8_t *in = (uint8_t *)bufIn;
+    uint8_t *out = (uint8_t *)bufOut;
+    uint8_t *ref = (uint8_t *)bufRef;
+    uint32_t ivBuf[CryptoRef_AES_BLOCK_SIZE / sizeof(uint32_t)];
+    uint8_t  iv[CryptoRef_AES_BLOCK_SIZE];
+    uint8_t  aesKey[16];
+    uint8_t  macKey[CryptoRef_HASH_BLOCK_SIZE];
+    uint8_t  tag[CryptoRef_MAX_DIGEST_SIZE];
+    uint8_t  expected[CryptoRef_MAX_DIGEST_SIZE];
+    uint32_t done = completed;
+    size_t   len = 2 * 4096 + 512;
+
+    fillRandom(in, len);
+    fillRandom(aesKey, sizeof(aesKey));
+    fillRandom(ivBuf, sizeof(ivBuf));
+    fillRandom(macKey, 32);
+    memset(macKey + 32, 0, sizeof(macKey) - 32);
+
+    memcpy(iv, ivBuf, sizeof(iv));
+    refCipher(CryptoCC32XX_AES_CBC, false, aesKey, sizeof(aesKey), iv, in,
+        ref, len);
+    CryptoRef_hmac(CryptoRef_SHA256, macKey, 32, ref, len, expected);
+
+    memset(&params, 0, sizeof(params));
+    params.aes.pKey = aesKey;
+    params.aes.keySize = CryptoCC32XX_AES_KEY_SIZE_128BIT;
+    params.aes.pIV = ivBuf;
+
+    TEST_ASSERT(CryptoCC32XX_hashInit(handle, &ctx, CryptoCC32XX_HMAC_SHA256,
+        macKey) == CryptoCC32XX_STATUS_SUCCESS);
+
+    CryptoCC32XX_Operation_init(&enc);
+    enc.method = CryptoCC32XX_AES_CBC;
+    enc.pInBuff = in;
+    enc.inLen = len;
+    enc.pOutBuff = out;
+    enc.pParams = &params;
+    enc.callbackFxn = opDone;
+    enc.then = &mac;
+
+    CryptoCC32XX_Operation_init(&mac);
+    mac.hashCtx = &ctx;
+    mac.pInBuff = out;
+    mac.inLen = len;
+    mac.pDigest = tag;
+    mac.callbackFxn = opDone;
+
+    TEST_ASSERT(CryptoCC32XX_queue(handle, &enc) ==
+        CryptoCC32XX_STATUS_SUCCESS);
+    TEST_ASSERT(completed == done + 2);
+    TEST_ASSERT((enc.status == CryptoCC32XX_STATUS_SUCCESS) &&
+        (mac.status == CryptoCC32XX_STATUS_SUCCESS));
+    TEST_ASSERT(memcmp(out, ref, len) == 0);
+    TEST_ASSERT(memcmp(tag, expected, 32) == 0);
+    TEST_ASSERT(memcmp(ivBuf, iv, sizeof(iv)) == 0);
+
+    checkIdle();
+    printf("pipeline: ok\n");
+}
+
+/*
+ *  ======== testLegacyHash ========
+ *  CryptoCC32XX_sign() with moreData, the message in random pieces, plain
+ *  and keyed SHA-256.
+ */
+static void testLegacyHash(void)
+{
+    CryptoCC32XX_HmacParams params;
+    uint8_t *data = (uint8_t *)bufIn;
+    uint8_t  key[CryptoRef_HASH_BLOCK_SIZE];
+    uint8_t  signature[CryptoRef_MAX_DIGEST_SIZE];
+    uint8_t  expected[CryptoRef_MAX_DIGEST_SIZE];
+    size_t   len = 5000;
+    size_t   offset;
+    size_t   piece;
+    int      round;
+
+    fillRandom(data, len);
+    fillRandom(key, 40);
+    memset(key + 40, 0, sizeof(key) - 40);
+
+    for (round = 0; round < 2 * LARGE_ROUNDS; round++) {
+        CryptoCC32XX_HmacParams_init(&params);
+        params.pKey = (round & 1) ? key : NULL;
+        params.moreData = 1;
+
+        for (offset = 0; offset < len; offset += piece) {
+            piece = 1 + Test_random(&seed) % 700;
+            if (piece >= len - offset) {
+                piece = len - offset;
+                params.moreData = 0;
+            }
+            TEST_ASSERT(CryptoCC32XX_sign(handle, CryptoCC32XX_HMAC_SHA256,
+                data + offset, piece, signature, &params) ==
+                CryptoCC32XX_STATUS_SUCCESS);
+        }
+
+        if (round & 1) {
+            CryptoRef_hmac(CryptoRef_SHA256, key, 40, data, len, expected);
+        }
+        else {
+            CryptoRef_hash(CryptoRef_SHA256, data, len, expected);
+        }
+        TEST_ASSERT(memcmp(signature, expected, 32) == 0);
+    }
+
+    checkIdle();
+    printf("legacy hash: ok\n");
+}
+
+/*
+ *  ======== testStall ========
+ *  An engine whose context never becomes ready fails the operation and is
+ *  usable again afterwards.
+ */
+static void testStall(void)
+{
+    CryptoCC32XX_HashContext ctx;
+    uint8_t  key[16] = {0};
+    uint8_t  iv[CryptoRef_AES_BLOCK_SIZE] = {0};
+    uint8_t  digest[CryptoRef_MAX_DIGEST_SIZE];
+    uint8_t *data = (uint8_t *)bufIn;
+    Path     path;
+
+    fillRandom(data, 1024);
+
+    DTHEHost_stall(true);
+    for (path = PATH_BLOCKING; path <= PATH_QUEUE; path++) {
+        TEST_ASSERT(cipher(CryptoCC32XX_AES_CBC, false, key, sizeof(key), iv,
+            data, bufOut, 1024, path) == CryptoCC32XX_STATUS_ERROR);
+        TEST_ASSERT(cipher(CryptoCC32XX_DES_ECB, false, key, 8, iv,
+            data, bufOut, 1024, path) == CryptoCC32XX_STATUS_ERROR);
+    }
+    TEST_ASSERT(CryptoCC32XX_hashInit(handle, &ctx, CryptoCC32XX_HMAC_SHA256,
+        NULL) == CryptoCC32XX_STATUS_SUCCESS);
+    TEST_ASSERT(CryptoCC32XX_hashUpdate(handle, &ctx, data, 1024) ==
+        CryptoCC32XX_STATUS_ERROR);
+    TEST_ASSERT(hashOps(CryptoCC32XX_HMAC_MD5, NULL, data, 1024, PATH_QUEUE,
+        digest) == CryptoCC32XX_STATUS_ERROR);
+    DTHEHost_stall(false);
+    checkIdle();
+
+    for (path = PATH_BLOCKING; path <= PATH_QUEUE; path++) {
+        TEST_ASSERT(cipher(CryptoCC32XX_AES_CBC, false, key, sizeof(key), iv,
+            data, bufOut, 1024, path) == CryptoCC32XX_STATUS_SUCCESS);
+    }
+    TEST_ASSERT(hashPieces(CryptoCC32XX_HMAC_SHA256, NULL, data, 1024, 300,
+        digest) == CryptoCC32XX_STATUS_SUCCESS);
+
+    checkIdle();
+    printf("stall: ok\n");
+}
+
+/*
+ *  ======== nowUsec ========
+ */
+static double nowUsec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (ts.tv_sec * 1e6 + ts.tv_nsec / 1e3);
+}
+
+/*
+ *  ======== bench ========
+ *  Per kilobyte costs of the blocking APIs by mode and buffer size.
+ */
+static void bench(void)
+{
+    static const struct {
+        const char *name;
+        CryptoCC32XX_EncryptMethod method;
+        size_t keyLen;
+        CryptoCC32XX_HmacMethod hash;
+        bool hmac;
+    } modes[] = {
+        {"AES-128-ECB", CryptoCC32XX_AES_ECB, 16, 0, false},
+        {"AES-128-CBC", CryptoCC32XX_AES_CBC, 16, 0, false},
+        {"AES-256-CTR", CryptoCC32XX_AES_CTR, 32, 0, false},
+        {"DES-CBC", CryptoCC32XX_DES_CBC, 8, 0, false},
+        {"TDES-CBC", CryptoCC32XX_DES_CBC, 24, 0, false},
+        {"MD5", 0, 0, CryptoCC32XX_HMAC_MD5, false},
+        {"SHA-256", 0, 0, CryptoCC32XX_HMAC_SHA256, false},
+        {"HMAC-SHA-256", 0, 0, CryptoCC32XX_HMAC_SHA256, true}
+    };
+    static const size_t sizes[] = {16, 64, 256, 1024, 4096, 16384};
+    DTHEHost_Counters dthe;
+    UDMAHost_Counters udma;
+    CryptoCC32XX_HashContext ctx;
+    uint8_t  key[CryptoRef_HASH_BLOCK_SIZE];
+    uint8_t  iv[CryptoRef_AES_BLOCK_SIZE];
+    uint8_t  digest[CryptoRef_MAX_DIGEST_SIZE];
+    unsigned int m;
+    unsigned int s;
+    unsigned int n;
+    unsigned int iterations;
+    double   start;
+    double   kb;
+
+    fillRandom(key, sizeof(key));
+    fillRandom(iv, sizeof(iv));
+    fillRandom(bufIn, sizeof(bufIn));
+
+    printf("%-14s %6s %10s %10s %10s %10s %10s\n", "mode", "bytes",
+        "calls/KB", "words/KB", "dma/KB", "irqs/KB", "us/KB");
+
+    for (m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            iterations = (256 * 1024) / sizes[s];
+            dthe = DTHEHost_counters;
+            udma = UDMAHost_counters;
+            start = nowUsec();
+
+            for (n = 0; n < iterations; n++) {
+                if (modes[m].keyLen != 0) {
+                    TEST_ASSERT(cipher(modes[m].method, false, key,
+                        modes[m].keyLen, iv, bufIn, bufOut, sizes[s],
+                        PATH_BLOCKING) == CryptoCC32XX_STATUS_SUCCESS);
+                }
+                else {
+                    TEST_ASSERT(CryptoCC32XX_hashInit(handle, &ctx,
+                        modes[m].hash, modes[m].hmac ? key : NULL) ==
+                        CryptoCC32XX_STATUS_SUCCESS);
+                    TEST_ASSERT(CryptoCC32XX_hashUpdate(handle, &ctx, bufIn,
+                        sizes[s]) == CryptoCC32XX_STATUS_SUCCESS);
+                    TEST_ASSERT(CryptoCC32XX_hashFinal(handle, &ctx,
+                        digest) == CryptoCC32XX_STATUS_SUCCESS);
+                }
+            }
+
+            kb = iterations * sizes[s] / 1024.0;
+            printf("%-14s %6u %10.1f %10.1f %10.1f %10.1f %10.2f\n",
+                modes[m].name, (unsigned int)sizes[s],
+                (DTHEHost_counters.calls - dthe.calls +
+                    UDMAHost_counters.calls - udma.calls) / kb,
+                (DTHEHost_counters.cpuWords - dthe.cpuWords) / kb,
+                (UDMAHost_counters.items - udma.items) / kb,
+                (DTHEHost_counters.interrupts - dthe.interrupts) / kb,
+                (nowUsec() - start) / kb);
+        }
+    }
+
+    checkIdle();
+}
+
+int main(int argc, char *argv[])
+{
+    /* A driver waiting for an interrupt that never comes hangs the test */
+    alarm(TIMEOUT_SEC);
+
+    DTHEHost_init();
+    UDMACC32XX_init();
+    CryptoCC32XX_init();
+    handle = CryptoCC32XX_open(0, CryptoCC32XX_AES | CryptoCC32XX_DES |
+        CryptoCC32XX_HMAC);
+    TEST_ASSERT(handle != NULL);
+
+    if ((argc > 1) && (strcmp(argv[1], "bench") == 0)) {
+        bench();
+    }
+    else {
+        testVectors();
+        testMillion();
+        testLargeCiphers();
+        testLargeHashes();
+        testInterleaved();
+        testPipeline();
+        testLegacyHash();
+        testStall();
+    }
+
+    CryptoCC32XX_close(handle);
+    TEST_ASSERT(Power_getDependencyCount(PowerCC32XX_PERIPH_DTHE) == 0);
+
+    return (0);
+}
@@ -0,0 +1,411 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== DMA_test.c ========
+ *  DMACC32XX through the DMA API, against the uDMA model in cc32xx/.
+ *
+ *  Copies and fills of random sizes and alignments, several uDMA transfers
+ *  long, are checked byte for byte along with the bytes around them.
+ *  Transactions queued behind a running one complete in order, zero-size
+ *  and small transactions never reach the uDMA, and instances reserve
+ *  their channels.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <ti/drivers/DMA.h>
+#include <ti/drivers/Power.h>
+#include <ti/drivers/dma/DMACC32XX.h>
+#include <ti/drivers/dma/UDMACC32XX.h>
+#include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/power/PowerCC32XX.h>
+
+#include <ti/devices/cc32xx/inc/hw_ints.h>
+#include <ti/devices/cc32xx/driverlib/udma.h>
+
+#include "cc32xx/UDMA_host.h"
+#include "test.h"
+
+/* More than four 1024 item transfers when moved a byte at a time */
+#define MAX_SIZE     (4500)
+#define GUARD        (8)
+#define ROUNDS       (500)
+#define QUEUE_LEN    (8)
+
+#define TIMEOUT_SEC  (60)
+
+static DMACC32XX_Object dmaCC32XXObjects[3];
+
+/* Instances 1 and 2 want the same channel */
+static const DMACC32XX_HWAttrs dmaCC32XXHWAttrs[3] = {
+    {
+        .dmaChannel = DMACC32XX_DMA_CHANNEL_ANY
+    },
+    {
+        .dmaChannel = UDMA_CH29_SW
+    },
+    {
+        .dmaChannel = UDMA_CH29_SW
+    }
+};
+
+const DMA_Config DMA_config[3] = {
+    {
+        .fxnTablePtr = &DMACC32XX_fxnTable,
+        .object = &dmaCC32XXObjects[0],
+        .hwAttrs = &dmaCC32XXHWAttrs[0]
+    },
+    {
+        .fxnTablePtr = &DMACC32XX_fxnTable,
+        .object = &dmaCC32XXObjects[1],
+        .hwAttrs = &dmaCC32XXHWAttrs[1]
+    },
+    {
+        .fxnTablePtr = &DMACC32XX_fxnTable,
+        .object = &dmaCC32XXObjects[2],
+        .hwAttrs = &dmaCC32XXHWAttrs[2]
+    }
+};
+
+const uint_least8_t DMA_count = 3;
+
+static uint8_t dmaControlTable[1024] __attribute__((aligned(1024)));
+
+static UDMACC32XX_Object udmaCC32XXObject;
+
+static void dmaErrorFxn(uintptr_t arg);
+
+static const UDMACC32XX_HWAttrs udmaCC32XXHWAttrs = {
+    .controlBaseAddr = (void *)dmaControlTable,
+    .dmaErrorFxn = dmaErrorFxn,
+    .intNum = INT_UDMAERR,
+    .intPriority = (~0)
+};
+
+const UDMACC32XX_Config UDMACC32XX_config[1] = {
+    {
+        .object = &udmaCC32XXObject,
+        .hwAttrs = &udmaCC32XXHWAttrs
+    }
+};
+
+static uint32_t seed = 0x510E527F;
+
+/* Word aligned buffers; tests offset into them for misaligned data */
+static uint32_t bufSrc[(MAX_SIZE + 2 * GUARD) / sizeof(uint32_t)];
+static uint32_t bufDst[(MAX_SIZE + 2 * GUARD) / sizeof(uint32_t)];
+static uint32_t bufRef[(MAX_SIZE + 2 * GUARD) / sizeof(uint32_t)];
+
+static uint8_t queueDst[QUEUE_LEN][256];
+static DMA_Transaction *doneOrder[QUEUE_LEN];
+static volatile unsigned int numDone;
+
+/*
+ *  ======== dmaErrorFxn ========
+ */
+static void dmaErrorFxn(uintptr_t arg)
+{
+    TEST_ASSERT(false);
+}
+
+/*
+ *  ======== transactionDone ========
+ */
+static void transactionDone(DMA_Transaction *transaction)
+{
+    TEST_ASSERT(numDone < QUEUE_LEN);
+    doneOrder[numDone++] = transaction;
+}
+
+/*
+ *  ======== checkIdle ========
+ *  Every transaction has given back the LPDS constraint.
+ */
+static void checkIdle(void)
+{
+    TEST_ASSERT(Power_getConstraintMask() == 0);
+}
+
+/*
+ *  ======== fillRandom ========
+ */
+static void fillRandom(void *buf, size_t size)
+{
+    uint8_t *bytes = buf;
+
+    while (size-- > 0) {
+        *bytes++ = (uint8_t)Test_random(&seed);
+    }
+}
+
+/*
+ *  ======== openFast ========
+ *  Opens an instance that moves every transaction of a byte or more on
+ *  the uDMA.
+ */
+static DMA_Handle openFast(uint_least8_t index)
+{
+    DMA_Params params;
+
+    DMA_Params_init(&params);
+    params.minTransferSize = 0;
+
+    return (DMA_open(index, &params));
+}
+
+/*
+ *  ======== testZeroSize ========
+ *  A zero-size transaction completes at once, without a uDMA transfer.
+ */
+static void testZeroSize(void)
+{
+    DMA_Handle      handle = openFast(0);
+    DMA_Transaction transaction;
+    uint32_t        calls;
+
+    TEST_ASSERT(handle != NULL);
+    calls = UDMAHost_counters.calls;
+
+    numDone = 0;
+    transaction.callbackFxn = transactionDone;
+    TEST_ASSERT(DMA_memcpy(handle, &transaction, bufDst, bufSrc, 0) ==
+        DMA_STATUS_SUCCESS);
+    TEST_ASSERT(DMA_memset(handle, &transaction, bufDst, 0xA5, 0) ==
+        DMA_STATUS_SUCCESS);
+    TEST_ASSERT(numDone == 2);
+
+    transaction.callbackFxn = NULL;
+    TEST_ASSERT(DMA_memcpy(handle, &transaction, bufDst, bufSrc, 0) ==
+        DMA_STATUS_SUCCESS);
+
+    TEST_ASSERT(UDMAHost_counters.calls == calls);
+    checkIdle();
+    DMA_close(handle);
+
+    printf("zero size: ok\n");
+}
+
+/*
+ *  ======== testRandom ========
+ *  Blocking copies and fills of random sizes and alignments.
+ */
+static void testRandom(bool fill)
+{
+    DMA_Handle      handle = openFast(0);
+    DMA_Transaction transaction;
+    uint8_t        *src;
+    uint8_t        *dst;
+    uint8_t        *ref;
+    size_t          size;
+    size_t          offset;
+    uint32_t        items = UDMAHost_counters.items;
+    int             value;
+    int             round;
+
+    TEST_ASSERT(handle != NULL);
+    transaction.callbackFxn = NULL;
+
+    for (round = 0; round < ROUNDS; round++) {
+        size = 1 + Test_random(&seed) % MAX_SIZE;
+        offset = GUARD - Test_random(&seed) % 4;
+        src = (uint8_t *)bufSrc + GUARD - Test_random(&seed) % 4;
+        dst = (uint8_t *)bufDst + offset;
+        ref = (uint8_t *)bufRef + offset;
+        value = (int)Test_random(&seed);
+
+        fillRandom(bufSrc, sizeof(bufSrc));
+        fillRandom(bufDst, sizeof(bufDst));
+        memcpy(bufRef, bufDst, sizeof(bufRef));
+
+        if (fill) {
+            memset(ref, value, size);
+            TEST_ASSERT(DMA_memset(handle, &transaction, dst, value, size) ==
+                DMA_STATUS_SUCCESS);
+        }
+        else {
+            memcpy(ref, src, size);
+            TEST_ASSERT(DMA_memcpy(handle, &transaction, dst, src, size) ==
+                DMA_STATUS_SUCCESS);
+        }
+
+        TEST_ASSERT(memcmp(bufDst, bufRef, sizeof(bufDst)) == 0);
+    }
+
+    /* Every byte went through the uDMA */
+    TEST_ASSERT(UDMAHost_counters.items > items);
+    checkIdle();
+    DMA_close(handle);
+
+    printf("random %s: ok, %d transactions\n", fill ? "fills" : "copies",
+        ROUNDS);
+}
+
+/*
+ *  ======== testQueue ========
+ *  Transactions submitted while one is running complete in order, each
+ *  with its own data.
+ */
+static void testQueue(void)
+{
+    DMA_Handle      handle = openFast(0);
+    DMA_Transaction transactions[QUEUE_LEN];
+    uintptr_t       key;
+    int             i;
+
+    TEST_ASSERT(handle != NULL);
+    fillRandom(bufSrc, sizeof(bufSrc));
+    memset(queueDst, 0, sizeof(queueDst));
+    numDone = 0;
+
+    /* The completion interrupts are held until the last one is queued */
+    key = HwiP_disable();
+    for (i = 0; i < QUEUE_LEN; i++) {
+        transactions[i].callbackFxn = transactionDone;
+        if (i & 1) {
+            DMA_memset(handle, &transactions[i], queueDst[i], i,
+                sizeof(queueDst[i]) - i);
+        }
+        else {
+            DMA_memcpy(handle, &transactions[i], queueDst[i],
+                (uint8_t *)bufSrc + i, sizeof(queueDst[i]) - i);
+        }
+    }
+    TEST_ASSERT(numDone == 0);
+    TEST_ASSERT(Power_getConstraintMask() != 0);
+    HwiP_restore(key);
+
+    TEST_ASSERT(numDone == QUEUE_LEN);
+    for (i = 0; i < QUEUE_LEN; i++) {
+        TEST_ASSERT(doneOrder[i] == &transactions[i]);
+        if (i & 1) {
+            TEST_ASSERT(queueDst[i][0] == i);
+            TEST_ASSERT(queueDst[i][sizeof(queueDst[i]) - i - 1] == i);
+        }
+        else {
+            TEST_ASSERT(memcmp(queueDst[i], (uint8_t *)bufSrc + i,
+                sizeof(queueDst[i]) - i) == 0);
+        }
+        if (i > 0) {
+            TEST_ASSERT(queueDst[i][sizeof(queueDst[i]) - i] == 0);
+        }
+    }
+
+    checkIdle();
+    DMA_close(handle);
+
+    printf("queue: ok, %d transactions\n", QUEUE_LEN);
+}
+
+/*
+ *  ======== testSmall ========
+ *  With the default parameters, short transactions are done by the CPU
+ *  before the call returns.
+ */
+static void testSmall(void)
+{
+    DMA_Handle      handle = DMA_open(0, NULL);
+    DMA_Transaction transaction;
+    uint32_t        calls;
+
+    TEST_ASSERT(handle != NULL);
+    fillRandom(bufSrc, sizeof(bufSrc));
+    calls = UDMAHost_counters.calls;
+
+    numDone = 0;
+    transaction.callbackFxn = transactionDone;
+    DMA_memcpy(handle, &transaction, bufDst, bufSrc, DMA_MIN_TRANSFER_SIZE - 1);
+    TEST_ASSERT(numDone == 1);
+    TEST_ASSERT(memcmp(bufDst, bufSrc, DMA_MIN_TRANSFER_SIZE - 1) == 0);
+    TEST_ASSERT(UDMAHost_counters.calls == calls);
+
+    DMA_memcpy(handle, &transaction, bufDst, bufSrc, DMA_MIN_TRANSFER_SIZE);
+    TEST_ASSERT(numDone == 2);
+    TEST_ASSERT(UDMAHost_counters.calls != calls);
+
+    checkIdle();
+    DMA_close(handle);
+
+    printf("small: ok\n");
+}
+
+/*
+ *  ======== testChannels ========
+ *  An instance holds its channel from open to close.
+ */
+static void testChannels(void)
+{
+    DMA_Handle handle;
+    DMA_Handle other;
+
+    handle = DMA_open(1, NULL);
+    TEST_ASSERT(handle != NULL);
+
+    /* Already open, and its channel is taken */
+    TEST_ASSERT(DMA_open(1, NULL) == NULL);
+    TEST_ASSERT(DMA_open(2, NULL) == NULL);
+
+    /* Any free channel but 29 */
+    other = DMA_open(0, NULL);
+    TEST_ASSERT(other != NULL);
+    TEST_ASSERT((((DMACC32XX_Object *)other->object)->channel & 0x1F) != 29);
+    DMA_close(other);
+
+    DMA_close(handle);
+    handle = DMA_open(2, NULL);
+    TEST_ASSERT(handle != NULL);
+    DMA_close(handle);
+
+    printf("channels: ok\n");
+}
+
+int main(int argc, char *argv[])
+{
+    /* A driver waiting for an interrupt that never comes hangs the test */
+    alarm(TIMEOUT_SEC);
+
+    DMA_init();
+
+    testZeroSize();
+    testRandom(false);
+    testRandom(true);
+    testQueue();
+    testSmall();
+    testChannels();
+
+    TEST_ASSERT(Power_getDependencyCount(PowerCC32XX_PERIPH_UDMA) == 0);
+
+    return (0);
+}
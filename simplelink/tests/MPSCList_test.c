@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== MPSCList_test.c ========
+ *  MPSCList on its own and under concurrent producers.
+ *
+ *  Single context use checks first-in first-out order, emptiness and the
+ *  reuse of elements taken off the list. Several producer threads then put
+ *  numbered elements while the main thread gets them; every element must
+ *  arrive once, in the order its producer put it.
+ *
+ *  "MPSCList_test bench" reports the time per element of MPSCList and of
+ *  List_put()/List_get(), from one context and with several producer
+ *  threads. List_* takes the host HwiP lock, a mutex, where the device
+ *  only masks interrupts, so the numbers compare the two on the host only.
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <ti/drivers/utils/List.h>
+#include <ti/drivers/utils/MPSCList.h>
+
+#include "test.h"
+
+#define MAX_PRODUCERS   (4)
+#define PER_PRODUCER    (200000)
+#define BATCH           (64)
+
+#define TIMEOUT_SEC     (60)
+
+typedef struct Item {
+    List_Elem   elem;
+    int         producer;
+    int         number;
+} Item;
+
+typedef struct Producer {
+    pthread_t   thread;
+    int         id;
+    int         count;
+    bool        useList;    /* List_put() instead of MPSCList_put() */
+} Producer;
+
+static MPSCList_List mpscList;
+static List_List list;
+static Item items[MAX_PRODUCERS][PER_PRODUCER];
+static Producer producers[MAX_PRODUCERS];
+
+/*
+ *  ======== produce ========
+ */
+static void *produce(void *arg)
+{
+    Producer *producer = arg;
+    Item     *item;
+    int       i;
+
+    for (i = 0; i < producer->count; i++) {
+        item = &items[producer->id][i];
+        item->producer = producer->id;
+        item->number = i;
+        if (producer->useList) {
+            List_put(&list, &item->elem);
+        }
+        else {
+            MPSCList_put(&mpscList, &item->elem);
+        }
+    }
+
+    return (NULL);
+}
+
+/*
+ *  ======== consume ========
+ *  Starts numProducers threads that put count elements each, and gets them
+ *  all. Returns the elapsed time in microseconds.
+ */
+static double consume(int numProducers, int count, bool useList)
+{
+    int             next[MAX_PRODUCERS];
+    long            remaining = (long)numProducers * count;
+    struct timespec start;
+    struct timespec end;
+    Item           *item;
+    int             p;
+
+    MPSCList_clearList(&mpscList);
+    List_clearList(&list);
+    memset(next, 0, sizeof(next));
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (p = 0; p < numProducers; p++) {
+        producers[p].id = p;
+        producers[p].count = count;
+        producers[p].useList = useList;
+        TEST_ASSERT(pthread_create(&producers[p].thread, NULL, produce,
+            &producers[p]) == 0);
+    }
+
+    while (remaining > 0) {
+        item = (Item *)(useList ? List_get(&list) : MPSCList_get(&mpscList));
+        if (item == NULL) {
+            continue;
+        }
+        TEST_ASSERT(item->number == next[item->producer]);
+        next[item->producer]++;
+        remaining--;
+    }
+
+    for (p = 0; p < numProducers; p++) {
+        pthread_join(producers[p].thread, NULL);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    TEST_ASSERT(useList ? List_empty(&list) : MPSCList_empty(&mpscList));
+    TEST_ASSERT((useList ? List_get(&list) : MPSCList_get(&mpscList)) ==
+        NULL);
+
+    return ((end.tv_sec - start.tv_sec) * 1e6 +
+        (end.tv_nsec - start.tv_nsec) / 1e3);
+}
+
+/*
+ *  ======== testSingle ========
+ *  First-in first-out from one context, down to the last element and
+ *  through the reuse of elements.
+ */
+static void testSingle(void)
+{
+    Item *item = items[0];
+    int   round;
+    int   n;
+    int   i;
+
+    MPSCList_clearList(&mpscList);
+    TEST_ASSERT(MPSCList_empty(&mpscList));
+    TEST_ASSERT(MPSCList_get(&mpscList) == NULL);
+
+    /* One element at a time exercises the stub on every get */
+    for (i = 0; i < 3; i++) {
+        MPSCList_put(&mpscList, &item[i].elem);
+        TEST_ASSERT(!MPSCList_empty(&mpscList));
+        TEST_ASSERT(MPSCList_get(&mpscList) == &item[i].elem);
+        TEST_ASSERT(MPSCList_empty(&mpscList));
+        TEST_ASSERT(MPSCList_get(&mpscList) == NULL);
+    }
+
+    /* Runs of growing length, with the elements reused every round */
+    for (round = 0; round < 100; round++) {
+        n = 1 + round % BATCH;
+        for (i = 0; i < n; i++) {
+            item[i].number = i;
+            MPSCList_put(&mpscList, &item[i].elem);
+        }
+        for (i = 0; i < n; i++) {
+            TEST_ASSERT(MPSCList_get(&mpscList) == &item[i].elem);
+        }
+        TEST_ASSERT(MPSCList_empty(&mpscList));
+        TEST_ASSERT(MPSCList_get(&mpscList) == NULL);
+    }
+
+    /* Gets interleaved with puts keep the order */
+    for (i = 0; i < 10; i++) {
+        MPSCList_put(&mpscList, &item[i].elem);
+        if (i & 1) {
+            TEST_ASSERT(MPSCList_get(&mpscList) == &item[i / 2].elem);
+        }
+    }
+    for (i = 5; i < 10; i++) {
+        TEST_ASSERT(MPSCList_get(&mpscList) == &item[i].elem);
+    }
+    TEST_ASSERT(MPSCList_empty(&mpscList));
+
+    printf("single context: ok\n");
+}
+
+/*
+ *  ======== testProducers ========
+ */
+static void testProducers(void)
+{
+    int numProducers;
+
+    for (numProducers = 1; numProducers <= MAX_PRODUCERS; numProducers *= 2) {
+        consume(numProducers, PER_PRODUCER, false);
+        printf("%d producers: ok, %d elements\n", numProducers,
+            numProducers * PER_PRODUCER);
+    }
+}
+
+/*
+ *  ======== benchSingle ========
+ *  Nanoseconds per put and get of BATCH elements from one context.
+ */
+static double benchSingle(bool useList)
+{
+    struct timespec start;
+    struct timespec end;
+    Item           *item = items[0];
+    int             round;
+    int             i;
+
+    MPSCList_clearList(&mpscList);
+    List_clearList(&list);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (round = 0; round < PER_PRODUCER; round++) {
+        if (useList) {
+            for (i = 0; i < BATCH; i++) {
+                List_put(&list, &item[i].elem);
+            }
+            for (i = 0; i < BATCH; i++) {
+                TEST_ASSERT(List_get(&list) == &item[i].elem);
+            }
+        }
+        else {
+            for (i = 0; i < BATCH; i++) {
+                MPSCList_put(&mpscList, &item[i].elem);
+            }
+            for (i = 0; i < BATCH; i++) {
+                TEST_ASSERT(MPSCList_get(&mpscList) == &item[i].elem);
+            }
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return (((end.tv_sec - start.tv_sec) * 1e9 +
+        (end.tv_nsec - start.tv_nsec)) / ((double)PER_PRODUCER * BATCH));
+}
+
+/*
+ *  ======== bench ========
+ */
+static void bench(void)
+{
+    int numProducers;
+
+    printf("%-12s %14s %14s\n", "producers", "MPSCList ns", "List ns");
+
+    printf("%-12s %14.1f %14.1f\n", "same thread", benchSingle(false),
+        benchSingle(true));
+
+    for (numProducers = 1; numProducers <= MAX_PRODUCERS; numProducers *= 2) {
+        printf("%-12d %14.1f %14.1f\n", numProducers,
+            consume(numProducers, PER_PRODUCER, false) * 1e3 /
+                (numProducers * PER_PRODUCER),
+            consume(numProducers, PER_PRODUCER, true) * 1e3 /
+                (numProducers * PER_PRODUCER));
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    /* A lost element leaves the consumer spinning */
+    alarm(TIMEOUT_SEC);
+
+    if ((argc > 1) && (strcmp(argv[1], "bench") == 0)) {
+        bench();
+    }
+    else {
+        testSingle();
+        testProducers();
+    }
+
+    return (0);
+}
@@ -0,0 +1,516 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== NVSKV_test.c ========
+ *  NVSKV on an NVSRAM region.
+ *
+ *  Writes go through a fault layer which programs flash the way NOR flash
+ *  does (bits can only be cleared, checked with NVS_WRITE_PRE_VERIFY) and
+ *  which can cut the power after a given number of bytes, part way through
+ *  a byte or an erase. After a power cut the store is mounted again and
+ *  every key must hold either its last written value or, for the operation
+ *  that was cut, the value being written.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <ti/drivers/NVS.h>
+#include <ti/drivers/NVSKV.h>
+#include <ti/drivers/nvs/NVSRAM.h>
+
+#include "test.h"
+
+#define SECTOR_SIZE  (256)
+#define NUM_SECTORS  (8)
+#define REGION_SIZE  (SECTOR_SIZE * NUM_SECTORS)
+#define NUM_KEYS     (16)
+#define MAX_VALUE    (40)
+#define ERASE_COST   (64)   /* Budget units taken by a sector erase */
+#define KEY_NONE     (0xFFFF)
+
+typedef struct Value {
+    bool     present;
+    uint16_t length;
+    uint8_t  data[MAX_VALUE];
+} Value;
+
+static int_fast16_t faultErase(NVS_Handle handle, size_t offset, size_t size);
+static int_fast16_t faultWrite(NVS_Handle handle, size_t offset, void *buffer,
+    size_t bufferSize, uint_fast16_t flags);
+
+static const NVS_FxnTable faultFxnTable = {
+    NVSRAM_close,
+    NVSRAM_control,
+    faultErase,
+    NVSRAM_getAttrs,
+    NVSRAM_init,
+    NVSRAM_lock,
+    NVSRAM_open,
+    NVSRAM_read,
+    NVSRAM_unlock,
+    faultWrite
+};
+
+static uint8_t region[REGION_SIZE] __attribute__((aligned(SECTOR_SIZE)));
+
+static NVSRAM_Object nvsRAMObjects[1];
+
+static const NVSRAM_HWAttrs nvsRAMHWAttrs[1] = {
+    {
+        .regionBase = region,
+        .regionSize = REGION_SIZE,
+        .sectorSize = SECTOR_SIZE
+    }
+};
+
+NVS_Config NVS_config[1] = {
+    {
+        .fxnTablePtr = &faultFxnTable,
+        .object = &nvsRAMObjects[0],
+        .hwAttrs = &nvsRAMHWAttrs[0]
+    }
+};
+
+const uint8_t NVS_count = 1;
+
+static NVS_Handle    nvsHandle;
+static NVSKV_Object  kv;
+static NVSKV_Entry   kvIndex[NUM_KEYS];
+static Value         model[NUM_KEYS];
+static uint32_t      seed = 0x2545F491;
+
+/* Bytes which may still be programmed before the power is cut, or -1 */
+static long          budget = -1;
+static bool          powerLost;
+
+/*
+ *  ======== faultErase ========
+ *  An erase cut short leaves the sector half erased.
+ */
+static int_fast16_t faultErase(NVS_Handle handle, size_t offset, size_t size)
+{
+    if (powerLost) {
+        return (NVS_STATUS_ERROR);
+    }
+
+    if ((budget >= 0) && (budget < ERASE_COST)) {
+        memset(&region[offset], 0xFF, size / 2);
+        powerLost = true;
+        return (NVS_STATUS_ERROR);
+    }
+
+    if (budget >= 0) {
+        budget -= ERASE_COST;
+    }
+
+    return (NVSRAM_erase(handle, offset, size));
+}
+
+/*
+ *  ======== faultWrite ========
+ *  A write cut short programs the bytes before the cut and only some of
+ *  the bits of the byte at the cut.
+ */
+static int_fast16_t faultWrite(NVS_Handle handle, size_t offset, void *buffer,
+    size_t bufferSize, uint_fast16_t flags)
+{
+    int_fast16_t status;
+    size_t       count = bufferSize;
+
+    if (powerLost) {
+        return (NVS_STATUS_ERROR);
+    }
+
+    if ((budget >= 0) && ((size_t)budget < bufferSize)) {
+        count = budget;
+        powerLost = true;
+    }
+    else if (budget >= 0) {
+        budget -= bufferSize;
+    }
+
+    status = NVSRAM_write(handle, offset, buffer, count,
+        flags | NVS_WRITE_PRE_VERIFY);
+    TEST_ASSERT(status != NVS_STATUS_INV_WRITE);
+
+    if (powerLost) {
+        region[offset + count] &= ((uint8_t *)buffer)[count] | 0x0F;
+        return (NVS_STATUS_ERROR);
+    }
+
+    return (status);
+}
+
+/*
+ *  ======== makeValue ========
+ */
+static void makeValue(Value *value)
+{
+    uint16_t i;
+
+    value->present = true;
+    value->length = Test_random(&seed) % (MAX_VALUE + 1);
+    for (i = 0; i < value->length; i++) {
+        value->data[i] = (uint8_t)Test_random(&seed);
+    }
+}
+
+/*
+ *  ======== valueMatches ========
+ */
+static bool valueMatches(uint_fast16_t key, const Value *value)
+{
+    uint8_t      buf[MAX_VALUE + 1];
+    size_t       length;
+    int_fast16_t status;
+
+    status = NVSKV_read(&kv, key, buf, sizeof(buf), &length);
+
+    if (!value->present) {
+        return (status == NVSKV_STATUS_NOT_FOUND);
+    }
+
+    return ((status == NVS_STATUS_SUCCESS) && (length == value->length) &&
+        (memcmp(buf, value->data, length) == 0));
+}
+
+/*
+ *  ======== checkModel ========
+ */
+static void checkModel(void)
+{
+    uint_fast16_t key;
+
+    for (key = 0; key < NUM_KEYS; key++) {
+        TEST_ASSERT(valueMatches(key, &model[key]));
+    }
+}
+
+/*
+ *  ======== remount ========
+ *  Restores the power and mounts the store again from flash alone.
+ */
+static void remount(void)
+{
+    NVSKV_destruct(&kv);
+    memset(kvIndex, 0x5A, sizeof(kvIndex));
+
+    budget = -1;
+    powerLost = false;
+
+    TEST_ASSERT(NVSKV_construct(&kv, nvsHandle, kvIndex, NUM_KEYS) ==
+        NVS_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== writeKey ========
+ */
+static int_fast16_t writeKey(uint_fast16_t key, const Value *value)
+{
+    if (!value->present) {
+        return (NVSKV_delete(&kv, key));
+    }
+
+    return (NVSKV_write(&kv, key, value->data, value->length));
+}
+
+/*
+ *  ======== format ========
+ */
+static void format(void)
+{
+    TEST_ASSERT(NVSKV_format(&kv) == NVS_STATUS_SUCCESS);
+    memset(model, 0, sizeof(model));
+}
+
+/*
+ *  ======== testBasic ========
+ */
+static void testBasic(void)
+{
+    NVSKV_Cursor cursor;
+    uint32_t     record;
+    uint32_t     i;
+    size_t       length;
+    uint8_t      big[SECTOR_SIZE];
+
+    format();
+
+    TEST_ASSERT(NVSKV_read(&kv, 3, big, sizeof(big), NULL) ==
+        NVSKV_STATUS_NOT_FOUND);
+    TEST_ASSERT(NVSKV_write(&kv, NUM_KEYS, big, 1) == NVSKV_STATUS_INV_KEY);
+    TEST_ASSERT(NVSKV_write(&kv, 0, big, sizeof(big)) ==
+        NVS_STATUS_INV_SIZE);
+    TEST_ASSERT(NVSKV_delete(&kv, 3) == NVSKV_STATUS_NOT_FOUND);
+
+    for (i = 0; i < NUM_KEYS; i++) {
+        makeValue(&model[i]);
+        TEST_ASSERT(writeKey(i, &model[i]) == NVS_STATUS_SUCCESS);
+    }
+    checkModel();
+
+    model[5].present = false;
+    TEST_ASSERT(writeKey(5, &model[5]) == NVS_STATUS_SUCCESS);
+    makeValue(&model[6]);
+    TEST_ASSERT(writeKey(6, &model[6]) == NVS_STATUS_SUCCESS);
+    checkModel();
+
+    for (record = 0; record < 5; record++) {
+        TEST_ASSERT(NVSKV_append(&kv, &record, sizeof(record)) ==
+            NVS_STATUS_SUCCESS);
+    }
+
+    remount();
+    checkModel();
+
+    NVSKV_initCursor(&cursor);
+    for (i = 0; i < 5; i++) {
+        TEST_ASSERT(NVSKV_readLog(&kv, &cursor, &record, sizeof(record),
+            &length) == NVS_STATUS_SUCCESS);
+        TEST_ASSERT((length == sizeof(record)) && (record == i));
+    }
+    TEST_ASSERT(NVSKV_readLog(&kv, &cursor, &record, sizeof(record),
+        &length) == NVSKV_STATUS_NOT_FOUND);
+
+    printf("basic: ok\n");
+}
+
+/*
+ *  ======== readEraseCount ========
+ *  The erase count is the first word of the sector header.
+ */
+static uint32_t readEraseCount(uint_fast16_t sector)
+{
+    uint32_t eraseCount;
+
+    memcpy(&eraseCount, &region[sector * SECTOR_SIZE], sizeof(eraseCount));
+
+    return (eraseCount);
+}
+
+/*
+ *  ======== testWear ========
+ *  Rewrites keys until the log has wrapped many times; the erases must be
+ *  spread evenly over the sectors and compaction must free sectors without
+ *  losing values. Formatting only erases sectors which are not erased
+ *  already, so the erases are counted from after the format.
+ */
+static void testWear(void)
+{
+    NVSKV_Stats   stats;
+    uint32_t      startCount[NUM_SECTORS];
+    uint32_t      erases;
+    uint32_t      minErases = ~0U;
+    uint32_t      maxErases = 0;
+    uint_fast16_t key;
+    uint32_t      i;
+
+    format();
+
+    for (i = 0; i < NUM_SECTORS; i++) {
+        startCount[i] = readEraseCount(i);
+    }
+
+    for (i = 0; i < 20000; i++) {
+        key = Test_random(&seed) % NUM_KEYS;
+        if ((Test_random(&seed) % 8) == 0) {
+            if (!model[key].present) {
+                continue;
+            }
+            model[key].present = false;
+        }
+        else {
+            makeValue(&model[key]);
+        }
+        TEST_ASSERT(writeKey(key, &model[key]) == NVS_STATUS_SUCCESS);
+
+        if ((i % 1000) == 500) {
+            remount();
+            checkModel();
+        }
+    }
+    checkModel();
+
+    for (i = 0; i < NUM_SECTORS; i++) {
+        erases = readEraseCount(i) - startCount[i];
+        if (erases < minErases) {
+            minErases = erases;
+        }
+        if (erases > maxErases) {
+            maxErases = erases;
+        }
+    }
+
+    NVSKV_getStats(&kv, &stats);
+    TEST_ASSERT(stats.reclaims > 0);
+    TEST_ASSERT(minErases > 100);
+    TEST_ASSERT((maxErases - minErases) <= 1);
+
+    TEST_ASSERT(NVSKV_compact(&kv) == NVS_STATUS_SUCCESS);
+    NVSKV_getStats(&kv, &stats);
+    TEST_ASSERT(stats.freeSectors > 2);
+    checkModel();
+
+    remount();
+    checkModel();
+
+    printf("wear: ok, sector erases %u..%u, %u bytes relocated\n",
+        (unsigned)minErases, (unsigned)maxErases,
+        (unsigned)stats.relocatedBytes);
+}
+
+/*
+ *  ======== testPowerLoss ========
+ *  Cuts the power part way through a run of operations, over and over,
+ *  without ever reformatting, so that damage from one cut is still in
+ *  flash when the next one happens.
+ */
+static void testPowerLoss(void)
+{
+    NVSKV_Cursor  cursor;
+    Value         pending;
+    uint32_t      record[4];
+    uint32_t      lastRecord = 0;
+    bool          first;
+    uint32_t      nextRecord = 0;
+    uint_fast16_t pendingKey;
+    uint_fast16_t key;
+    int_fast16_t  status;
+    size_t        length;
+    uint32_t      cuts = 0;
+    uint32_t      trial;
+    uint32_t      op;
+
+    format();
+
+    for (trial = 0; trial < 20000; trial++) {
+        budget = Test_random(&seed) % 400;
+        pendingKey = KEY_NONE;
+
+        while (!powerLost) {
+            op = Test_random(&seed) % 16;
+            pendingKey = KEY_NONE;
+
+            if (op == 0) {
+                status = NVSKV_compact(&kv);
+            }
+            else if (op < 4) {
+                record[0] = nextRecord++;
+                record[1] = ~record[0];
+                record[2] = record[0] * 0x9E3779B9U;
+                record[3] = ~record[2];
+                status = NVSKV_append(&kv, record, sizeof(record));
+            }
+            else {
+                pendingKey = Test_random(&seed) % NUM_KEYS;
+                if ((op == 4) && model[pendingKey].present) {
+                    pending.present = false;
+                }
+                else {
+                    makeValue(&pending);
+                }
+                status = writeKey(pendingKey, &pending);
+            }
+
+            if (!powerLost) {
+                TEST_ASSERT(status == NVS_STATUS_SUCCESS);
+                if (pendingKey != KEY_NONE) {
+                    model[pendingKey] = pending;
+                }
+            }
+        }
+        cuts++;
+
+        remount();
+
+        /* The operation that was cut may or may not have taken effect */
+        for (key = 0; key < NUM_KEYS; key++) {
+            if (!valueMatches(key, &model[key])) {
+                TEST_ASSERT(key == pendingKey);
+                TEST_ASSERT(valueMatches(key, &pending));
+                model[key] = pending;
+            }
+        }
+
+        /* Whatever is left of the append log must be intact and in order */
+        NVSKV_initCursor(&cursor);
+        first = true;
+        while (NVSKV_readLog(&kv, &cursor, record, sizeof(record),
+            &length) == NVS_STATUS_SUCCESS) {
+            TEST_ASSERT(length == sizeof(record));
+            TEST_ASSERT((record[1] == ~record[0]) &&
+                (record[2] == record[0] * 0x9E3779B9U) &&
+                (record[3] == ~record[2]));
+            TEST_ASSERT(first || (record[0] > lastRecord));
+            lastRecord = record[0];
+            first = false;
+        }
+
+        /* The store must carry on working after the recovery */
+        key = Test_random(&seed) % NUM_KEYS;
+        makeValue(&model[key]);
+        TEST_ASSERT(writeKey(key, &model[key]) == NVS_STATUS_SUCCESS);
+        checkModel();
+    }
+
+    remount();
+    checkModel();
+
+    printf("power loss: ok, %u cuts\n", (unsigned)cuts);
+}
+
+/*
+ *  ======== main ========
+ */
+int main(void)
+{
+    nvsHandle = NVS_open(0, NULL);
+    TEST_ASSERT(nvsHandle != NULL);
+
+    /* The region starts out blank, as after a mass erase */
+    memset(region, 0xFF, sizeof(region));
+    TEST_ASSERT(NVSKV_construct(&kv, nvsHandle, kvIndex, NUM_KEYS) ==
+        NVS_STATUS_SUCCESS);
+
+    testBasic();
+    testWear();
+    testPowerLoss();
+
+    NVSKV_destruct(&kv);
+    NVS_close(nvsHandle);
+
+    return (0);
+}
@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== PriorityQueue_test.c ========
+ *  PriorityQueue against a linear search reference.
+ *
+ *  Equal keys come out first-in first-out, also after PriorityQueue_setKey(),
+ *  and a full queue refuses elements. Long random sequences of puts, gets,
+ *  removals and key changes, with keys that wrap around 2^32, then check
+ *  every PriorityQueue_get() against the reference.
+ *
+ *  "PriorityQueue_test bench" reports the time of a put and a get, by
+ *  number of queued elements, for PriorityQueue and for a List_List kept
+ *  sorted with List_insert(), the way drivers order requests by deadline
+ *  with List_*.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <ti/drivers/utils/List.h>
+#include <ti/drivers/utils/PriorityQueue.h>
+
+#include "test.h"
+
+#define CAPACITY    (256)
+#define OPERATIONS  (2000000)
+
+typedef struct Job {
+    PriorityQueue_Elem  elem;
+    List_Elem           listElem;   /* For the List_* benchmark */
+    bool                queued;
+    uint32_t            key;
+    uint32_t            seq;        /* Order of the put, for equal keys */
+} Job;
+
+static Job jobs[CAPACITY];
+static PriorityQueue_Elem *heap[CAPACITY];
+static PriorityQueue_Queue queue;
+static uint32_t seed = 0x9B05688C;
+
+/*
+ *  ======== reference ========
+ *  The queued job with the smallest key, the first put among equal keys.
+ */
+static Job *reference(int capacity)
+{
+    Job *best = NULL;
+    int  i;
+
+    for (i = 0; i < capacity; i++) {
+        if (!jobs[i].queued) {
+            continue;
+        }
+        if ((best == NULL) || ((int32_t)(jobs[i].key - best->key) < 0) ||
+            ((jobs[i].key == best->key) &&
+            ((int32_t)(jobs[i].seq - best->seq) < 0))) {
+            best = &jobs[i];
+        }
+    }
+
+    return (best);
+}
+
+/*
+ *  ======== testFifo ========
+ */
+static void testFifo(void)
+{
+    int i;
+
+    PriorityQueue_construct(&queue, heap, CAPACITY);
+    TEST_ASSERT(PriorityQueue_empty(&queue));
+    TEST_ASSERT(PriorityQueue_head(&queue) == NULL);
+    TEST_ASSERT(PriorityQueue_get(&queue) == NULL);
+
+    /* Three groups of equal keys, put in reverse key order */
+    for (i = 0; i < 30; i++) {
+        TEST_ASSERT(PriorityQueue_put(&queue, &jobs[i].elem, 30 - i / 10));
+    }
+    TEST_ASSERT(PriorityQueue_count(&queue) == 30);
+
+    /*
+     *  The first job moved to the smallest key keeps its place as the
+     *  first one put, ahead of the jobs that already had that key
+     */
+    PriorityQueue_setKey(&queue, &jobs[0].elem, 28);
+    TEST_ASSERT(PriorityQueue_key(&jobs[0].elem) == 28);
+
+    TEST_ASSERT(PriorityQueue_head(&queue) == &jobs[0].elem);
+    TEST_ASSERT(PriorityQueue_get(&queue) == &jobs[0].elem);
+    for (i = 20; i < 30; i++) {
+        TEST_ASSERT(PriorityQueue_get(&queue) == &jobs[i].elem);
+    }
+    for (i = 10; i < 20; i++) {
+        TEST_ASSERT(PriorityQueue_get(&queue) == &jobs[i].elem);
+    }
+    for (i = 1; i < 10; i++) {
+        TEST_ASSERT(PriorityQueue_get(&queue) == &jobs[i].elem);
+    }
+    TEST_ASSERT(PriorityQueue_empty(&queue));
+
+    printf("fifo: ok\n");
+}
+
+/*
+ *  ======== testFull ========
+ */
+static void testFull(void)
+{
+    Job extra;
+    int i;
+
+    PriorityQueue_construct(&queue, heap, 4);
+    for (i = 0; i < 4; i++) {
+        TEST_ASSERT(PriorityQueue_put(&queue, &jobs[i].elem, i));
+    }
+    TEST_ASSERT(!PriorityQueue_put(&queue, &extra.elem, 0));
+    TEST_ASSERT(PriorityQueue_count(&queue) == 4);
+    TEST_ASSERT(PriorityQueue_head(&queue) == &jobs[0].elem);
+
+    PriorityQueue_remove(&queue, &jobs[0].elem);
+    TEST_ASSERT(PriorityQueue_put(&queue, &extra.elem, 0));
+    TEST_ASSERT(PriorityQueue_get(&queue) == &extra.elem);
+
+    printf("full: ok\n");
+}
+
+/*
+ *  ======== testRandom ========
+ *  Random operations on up to capacity jobs, with keys drifting across
+ *  the 2^32 wrap.
+ */
+static void testRandom(int capacity)
+{
+    uint32_t base = 0xFFFFF000;
+    uint32_t seq = 0;
+    Job     *job;
+    Job     *expected;
+    long     gets = 0;
+    long     n;
+
+    memset(jobs, 0, sizeof(jobs));
+    PriorityQueue_construct(&queue, heap, capacity);
+
+    for (n = 0; n < OPERATIONS; n++) {
+        job = &jobs[Test_random(&seed) % capacity];
+
+        switch (Test_random(&seed) % 4) {
+            case 0:
+                if (!job->queued) {
+                    job->key = base + Test_random(&seed) % 512;
+                    job->seq = seq++;
+                    job->queued = true;
+                    TEST_ASSERT(PriorityQueue_put(&queue, &job->elem,
+                        job->key));
+                }
+                break;
+
+            case 1:
+                if (job->queued) {
+                    PriorityQueue_remove(&queue, &job->elem);
+                    job->queued = false;
+                }
+                break;
+
+            case 2:
+                if (job->queued) {
+                    job->key = base + Test_random(&seed) % 512;
+                    PriorityQueue_setKey(&queue, &job->elem, job->key);
+                }
+                break;
+
+            default:
+                expected = reference(capacity);
+                TEST_ASSERT(PriorityQueue_head(&queue) ==
+                    (expected ? &expected->elem : NULL));
+                TEST_ASSERT(PriorityQueue_get(&queue) ==
+                    (expected ? &expected->elem : NULL));
+                if (expected != NULL) {
+                    expected->queued = false;
+                }
+                gets++;
+                break;
+        }
+
+        base += Test_random(&seed) % 3;
+    }
+
+    printf("random, capacity %d: ok, %ld gets\n", capacity, gets);
+}
+
+/*
+ *  ======== listPutSorted ========
+ *  Inserts a job behind the queued jobs whose key is not larger.
+ */
+static void listPutSorted(List_List *list, Job *job)
+{
+    List_Elem *elem;
+
+    for (elem = List_head(list); elem != NULL; elem = List_next(elem)) {
+        if ((int32_t)(job->key -
+            ((Job *)((uint8_t *)elem - offsetof(Job, listElem)))->key) < 0) {
+            List_insert(list, &job->listElem, elem);
+            return;
+        }
+    }
+
+    List_put(list, &job->listElem);
+}
+
+/*
+ *  ======== bench ========
+ *  Nanoseconds per put and get with n jobs queued, the job put having a
+ *  random key.
+ */
+static void bench(void)
+{
+    static const int sizes[] = {4, 16, 64, 256};
+    struct timespec  start;
+    struct timespec  end;
+    List_List        list;
+    Job             *job;
+    double           pq;
+    double           sorted;
+    unsigned int     s;
+    long             iterations;
+    long             n;
+    int              i;
+
+    printf("%6s %16s %16s\n", "queued", "PriorityQueue ns", "sorted List ns");
+
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        iterations = OPERATIONS;
+
+        for (i = 0; i < sizes[s]; i++) {
+            jobs[i].key = Test_random(&seed) % 100000;
+        }
+
+        PriorityQueue_construct(&queue, heap, CAPACITY);
+        for (i = 0; i < sizes[s]; i++) {
+            PriorityQueue_put(&queue, &jobs[i].elem, jobs[i].key);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (n = 0; n < iterations; n++) {
+            job = (Job *)PriorityQueue_get(&queue);
+            job->key += Test_random(&seed) % 1000;
+            PriorityQueue_put(&queue, &job->elem, job->key);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        pq = ((end.tv_sec - start.tv_sec) * 1e9 +
+            (end.tv_nsec - start.tv_nsec)) / iterations;
+
+        for (i = 0; i < sizes[s]; i++) {
+            jobs[i].key = Test_random(&seed) % 100000;
+        }
+
+        List_clearList(&list);
+        for (i = 0; i < sizes[s]; i++) {
+            listPutSorted(&list, &jobs[i]);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (n = 0; n < iterations; n++) {
+            job = (Job *)((uint8_t *)List_get(&list) -
+                offsetof(Job, listElem));
+            job->key += Test_random(&seed) % 1000;
+            listPutSorted(&list, job);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        sorted = ((end.tv_sec - start.tv_sec) * 1e9 +
+            (end.tv_nsec - start.tv_nsec)) / iterations;
+
+        printf("%6d %16.1f %16.1f\n", sizes[s], pq, sorted);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if ((argc > 1) && (strcmp(argv[1], "bench") == 0)) {
+        bench();
+    }
+    else {
+        testFifo();
+        testFull();
+        testRandom(8);
+        testRandom(64);
+        testRandom(CAPACITY);
+    }
+
+    return (0);
+}
@@ -0,0 +1,803 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== SDSPI_test.c ========
+ *  SDSPI against an SD card model behind a test SPI instance.
+ *
+ *  The card model answers the SPI mode commands the driver sends, with a
+ *  configurable or random gap before each read data token and busy time
+ *  after each written block, so that multi-block reads take both the token
+ *  look-ahead and the polling path. Random reads and writes of up to 80
+ *  sectors at random buffer alignments are checked against a shadow copy
+ *  of the card, and the throughput statistics against the transfers made.
+ *
+ *  "SDSPI_test bench" reports, per transfer size, the SPI transfers and
+ *  bus bytes per sector, the MB/s the bus allows at the configured bit rate
+ *  (not counting the time to set up each SPI transfer), and the MB/s
+ *  SDSPI_CMD_GET_STATS reports for the host run.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <ti/drivers/GPIO.h>
+#include <ti/drivers/SD.h>
+#include <ti/drivers/SPI.h>
+#include <ti/drivers/sd/SDSPI.h>
+
+#include "test.h"
+
+#define SECTOR_SIZE   (512)
+#define NUM_SECTORS   (2048)
+#define MAX_COUNT     (80)
+#define ROUNDS        (400)
+
+#define CS_GPIO       (3)
+#define BIT_RATE      (20000000)
+
+/* Longest random gap before a read data token, busy time after a write */
+#define MAX_GAP       (12)
+#define MAX_BUSY      (40)
+
+#define TIMEOUT_SEC   (60)
+
+/* R1 response bits */
+#define R1_IDLE       (0x01)
+#define R1_ILLEGAL    (0x04)
+#define R1_ADDRESS    (0x20)
+
+typedef enum CardMode {
+    MODE_CMD,          /* Waiting for a command */
+    MODE_READ,         /* Streaming CMD18 data blocks */
+    MODE_WRITE_TOKEN,  /* Waiting for a write data token */
+    MODE_WRITE_DATA    /* Receiving a write data block & its CRC */
+} CardMode;
+
+typedef struct Card {
+    bool         selected;
+    bool         idle;
+    bool         appCmd;
+    bool         multi;
+    bool         rejectWrites;
+    unsigned int opCondPolls;
+    CardMode     mode;
+    uint32_t     sector;
+    uint8_t      cmd[6];
+    unsigned int cmdLen;
+    uint8_t      block[SECTOR_SIZE + 2];
+    unsigned int blockLen;
+    unsigned int busy;
+    /* Fixed gap & busy bytes, or random ones if 0 */
+    unsigned int gap;
+    unsigned int busyTime;
+    /* Bytes to clock out, ahead of any busy bytes */
+    uint8_t      out[2 * SECTOR_SIZE];
+    unsigned int outPos;
+    unsigned int outLen;
+} Card;
+
+static Card card;
+static uint8_t storage[NUM_SECTORS][SECTOR_SIZE];
+static uint8_t shadow[NUM_SECTORS][SECTOR_SIZE];
+
+static bool     spiIsOpen;
+static uint32_t spiBitRate;
+static uint32_t spiTransfers;
+static uint32_t spiBytes;
+
+static uint32_t seed = 0x9B05688C;
+
+/* Word aligned; tests offset into it for misaligned data */
+static uint32_t buf[(MAX_COUNT * SECTOR_SIZE + 4) / sizeof(uint32_t)];
+
+static void spiClose(SPI_Handle handle);
+static int_fast16_t spiControl(SPI_Handle handle, uint_fast16_t cmd,
+    void *arg);
+static void spiInit(SPI_Handle handle);
+static SPI_Handle spiOpen(SPI_Handle handle, SPI_Params *params);
+static bool spiTransfer(SPI_Handle handle, SPI_Transaction *transaction);
+static void spiTransferCancel(SPI_Handle handle);
+
+static const SPI_FxnTable spiFxnTable = {
+    spiClose,
+    spiControl,
+    spiInit,
+    spiOpen,
+    spiTransfer,
+    spiTransferCancel
+};
+
+const SPI_Config SPI_config[1] = {
+    {
+        .fxnTablePtr = &spiFxnTable,
+        .object = NULL,
+        .hwAttrs = NULL
+    }
+};
+
+const uint_least8_t SPI_count = 1;
+
+static SDSPI_Object sdspiObjects[1];
+
+static const SDSPI_HWAttrs sdspiHWAttrs[1] = {
+    {
+        .spiIndex = 0,
+        .spiCsGpioIndex = CS_GPIO,
+        .bitRate = BIT_RATE
+    }
+};
+
+const SD_Config SD_config[1] = {
+    {
+        .fxnTablePtr = &SDSPI_fxnTable,
+        .object = &sdspiObjects[0],
+        .hwAttrs = &sdspiHWAttrs[0]
+    }
+};
+
+const uint_least8_t SD_count = 1;
+
+/*
+ *  ======== cardPush ========
+ */
+static void cardPush(uint8_t byte)
+{
+    if (card.outPos == card.outLen) {
+        card.outPos = 0;
+        card.outLen = 0;
+    }
+    TEST_ASSERT(card.outLen < sizeof(card.out));
+    card.out[card.outLen++] = byte;
+}
+
+/*
+ *  ======== cardGap ========
+ *  Bytes of 0xFF the card sends before a read data token.
+ */
+static unsigned int cardGap(void)
+{
+    return ((card.gap != 0) ? card.gap : 1 + Test_random(&seed) % MAX_GAP);
+}
+
+/*
+ *  ======== cardBusy ========
+ *  Bytes the card holds its output low after a write.
+ */
+static unsigned int cardBusy(void)
+{
+    return ((card.busyTime != 0) ? card.busyTime :
+        Test_random(&seed) % (MAX_BUSY + 1));
+}
+
+/*
+ *  ======== cardPushBlock ========
+ *  Queues a data token, the data & a (dummy) CRC after the access gap.
+ */
+static void cardPushBlock(const uint8_t *data, size_t size)
+{
+    unsigned int i;
+
+    for (i = cardGap(); i > 0; i--) {
+        cardPush(0xFF);
+    }
+    cardPush(0xFE);
+    for (i = 0; i < size; i++) {
+        cardPush(data[i]);
+    }
+    cardPush(0x5A);
+    cardPush(0xA5);
+}
+
+/*
+ *  ======== cardCommand ========
+ */
+static void cardCommand(void)
+{
+    uint8_t  index = card.cmd[0] & 0x3F;
+    uint32_t arg = ((uint32_t)card.cmd[1] << 24) |
+        ((uint32_t)card.cmd[2] << 16) | ((uint32_t)card.cmd[3] << 8) |
+        card.cmd[4];
+    bool     app = card.appCmd;
+    uint8_t  r1;
+    uint8_t  csd[16];
+
+    card.appCmd = false;
+
+    if (index == 12) {
+        /* STOP_TRANSMISSION ends the data block being sent */
+        TEST_ASSERT(card.mode == MODE_READ);
+        card.outPos = 0;
+        card.outLen = 0;
+        card.mode = MODE_CMD;
+        card.busy = cardBusy();
+    }
+    else {
+        TEST_ASSERT(card.mode == MODE_CMD);
+    }
+
+    r1 = card.idle ? R1_IDLE : 0;
+
+    /* Stuff byte (CMD12) or NCR */
+    cardPush(0xFF);
+
+    switch (index) {
+        case 0:
+            card.idle = true;
+            card.opCondPolls = 0;
+            cardPush(R1_IDLE);
+            break;
+
+        case 8:
+            cardPush(r1);
+            cardPush(0x00);
+            cardPush(0x00);
+            cardPush((arg >> 8) & 0x0F);
+            cardPush(arg & 0xFF);
+            break;
+
+        case 9:
+            /* CSD version 2.0 */
+            memset(csd, 0, sizeof(csd));
+            csd[0] = 0x40;
+            csd[8] = ((NUM_SECTORS >> 10) - 1) >> 8;
+            csd[9] = ((NUM_SECTORS >> 10) - 1) & 0xFF;
+            cardPush(r1);
+            cardPushBlock(csd, sizeof(csd));
+            break;
+
+        case 12:
+        case 16:
+            cardPush(r1);
+            break;
+
+        case 17:
+        case 18:
+            if (arg >= NUM_SECTORS) {
+                cardPush(r1 | R1_ADDRESS);
+                break;
+            }
+            cardPush(r1);
+            card.sector = arg;
+            if (index == 17) {
+                cardPushBlock(storage[card.sector], SECTOR_SIZE);
+            }
+            else {
+                /* Blocks are queued as they are clocked out */
+                card.mode = MODE_READ;
+            }
+            break;
+
+        case 23:
+            /* ACMD23 only sets the pre-erase count */
+            cardPush(app ? r1 : (r1 | R1_ILLEGAL));
+            break;
+
+        case 24:
+        case 25:
+            if (arg >= NUM_SECTORS) {
+                cardPush(r1 | R1_ADDRESS);
+                break;
+            }
+            cardPush(r1);
+            card.sector = arg;
+            card.multi = (index == 25);
+            card.mode = MODE_WRITE_TOKEN;
+            break;
+
+        case 41:
+            if (!app) {
+                cardPush(r1 | R1_ILLEGAL);
+                break;
+            }
+            /* Ready on the second poll */
+            if (++card.opCondPolls >= 2) {
+                card.idle = false;
+            }
+            cardPush(card.idle ? R1_IDLE : 0);
+            break;
+
+        case 55:
+            card.appCmd = true;
+            cardPush(r1);
+            break;
+
+        case 58:
+            /* OCR: powered up, high capacity */
+            cardPush(r1);
+            cardPush(0xC0);
+            cardPush(0xFF);
+            cardPush(0x80);
+            cardPush(0x00);
+            break;
+
+        default:
+            cardPush(r1 | R1_ILLEGAL);
+            break;
+    }
+}
+
+/*
+ *  ======== cardExchange ========
+ *  Clocks one byte through the card: returns the byte on its output while
+ *  taking tx on its input.
+ */
+static uint8_t cardExchange(uint8_t tx)
+{
+    uint8_t rx;
+
+    if (!card.selected) {
+        return (0xFF);
+    }
+
+    /* The next block of a multi-block read follows the previous one */
+    if ((card.mode == MODE_READ) && (card.outPos == card.outLen)) {
+        if (card.sector < NUM_SECTORS) {
+            cardPushBlock(storage[card.sector++], SECTOR_SIZE);
+        }
+        else {
+            cardPush(0xFF);
+        }
+    }
+
+    if (card.outPos < card.outLen) {
+        rx = card.out[card.outPos++];
+    }
+    else if (card.busy > 0) {
+        card.busy--;
+        rx = 0x00;
+    }
+    else {
+        rx = 0xFF;
+    }
+
+    switch (card.mode) {
+        case MODE_CMD:
+        case MODE_READ:
+            /* A command starts with 01b */
+            if ((card.cmdLen > 0) || ((tx & 0xC0) == 0x40)) {
+                card.cmd[card.cmdLen++] = tx;
+                if (card.cmdLen == sizeof(card.cmd)) {
+                    card.cmdLen = 0;
+                    cardCommand();
+                }
+            }
+            break;
+
+        case MODE_WRITE_TOKEN:
+            if (tx == (card.multi ? 0xFC : 0xFE)) {
+                card.blockLen = 0;
+                card.mode = MODE_WRITE_DATA;
+            }
+            else if (card.multi && (tx == 0xFD)) {
+                card.mode = MODE_CMD;
+                card.busy = cardBusy();
+            }
+            else {
+                TEST_ASSERT(tx == 0xFF);
+            }
+            break;
+
+        case MODE_WRITE_DATA:
+            card.block[card.blockLen++] = tx;
+            if (card.blockLen == sizeof(card.block)) {
+                if (card.rejectWrites) {
+                    /* Data rejected due to a CRC error */
+                    cardPush(0xEB);
+                    card.mode = MODE_CMD;
+                }
+                else {
+                    memcpy(storage[card.sector++], card.block, SECTOR_SIZE);
+                    cardPush(0xE5);
+                    card.mode = card.multi ? MODE_WRITE_TOKEN : MODE_CMD;
+                }
+                card.busy = cardBusy();
+            }
+            break;
+    }
+
+    return (rx);
+}
+
+/*
+ *  ======== GPIO_init ========
+ */
+void GPIO_init()
+{
+}
+
+/*
+ *  ======== GPIO_setConfig ========
+ */
+int_fast16_t GPIO_setConfig(uint_least8_t index, GPIO_PinConfig pinConfig)
+{
+    TEST_ASSERT(index == CS_GPIO);
+    GPIO_write(index, (pinConfig & GPIO_CFG_OUT_HIGH) ? 1 : 0);
+
+    return (GPIO_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== GPIO_write ========
+ *  Chip select of the card. Deselecting it drops any command in progress.
+ */
+void GPIO_write(uint_least8_t index, unsigned int value)
+{
+    TEST_ASSERT(index == CS_GPIO);
+
+    card.selected = (value == 0);
+    if (!card.selected) {
+        TEST_ASSERT(card.mode != MODE_READ);
+        card.cmdLen = 0;
+        card.outPos = 0;
+        card.outLen = 0;
+    }
+}
+
+/*
+ *  ======== spiClose ========
+ */
+static void spiClose(SPI_Handle handle)
+{
+    TEST_ASSERT(spiIsOpen);
+    spiIsOpen = false;
+}
+
+/*
+ *  ======== spiControl ========
+ */
+static int_fast16_t spiControl(SPI_Handle handle, uint_fast16_t cmd,
+    void *arg)
+{
+    return (SPI_STATUS_UNDEFINEDCMD);
+}
+
+/*
+ *  ======== spiInit ========
+ */
+static void spiInit(SPI_Handle handle)
+{
+}
+
+/*
+ *  ======== spiOpen ========
+ */
+static SPI_Handle spiOpen(SPI_Handle handle, SPI_Params *params)
+{
+    TEST_ASSERT(!spiIsOpen);
+    TEST_ASSERT(params->dataSize == 8);
+    spiIsOpen = true;
+    spiBitRate = params->bitRate;
+
+    return (handle);
+}
+
+/*
+ *  ======== spiTransfer ========
+ *  Clocks the transaction through the card. Like the SPI drivers set up
+ *  for an SD card, 0xFF is sent when there is no txBuf.
+ */
+static bool spiTransfer(SPI_Handle handle, SPI_Transaction *transaction)
+{
+    uint8_t *txBuf = transaction->txBuf;
+    uint8_t *rxBuf = transaction->rxBuf;
+    uint8_t  rx;
+    size_t   i;
+
+    TEST_ASSERT(spiIsOpen);
+    TEST_ASSERT(transaction->count > 0);
+
+    for (i = 0; i < transaction->count; i++) {
+        rx = cardExchange((txBuf != NULL) ? txBuf[i] : 0xFF);
+        if (rxBuf != NULL) {
+            rxBuf[i] = rx;
+        }
+    }
+
+    spiTransfers++;
+    spiBytes += transaction->count;
+    transaction->status = SPI_TRANSFER_COMPLETED;
+
+    return (true);
+}
+
+/*
+ *  ======== spiTransferCancel ========
+ */
+static void spiTransferCancel(SPI_Handle handle)
+{
+}
+
+/*
+ *  ======== fillRandom ========
+ */
+static void fillRandom(void *data, size_t size)
+{
+    uint8_t *bytes = data;
+
+    while (size-- > 0) {
+        *bytes++ = (uint8_t)Test_random(&seed);
+    }
+}
+
+/*
+ *  ======== openCard ========
+ */
+static SD_Handle openCard(void)
+{
+    SD_Handle handle;
+
+    handle = SD_open(0, NULL);
+    TEST_ASSERT(handle != NULL);
+    TEST_ASSERT(SD_initialize(handle) == SD_STATUS_SUCCESS);
+
+    return (handle);
+}
+
+/*
+ *  ======== testInitialize ========
+ *  The card is initialized as an SDHC card & the SPI reopened at the data
+ *  transfer bit rate.
+ */
+static void testInitialize(void)
+{
+    SD_Handle handle;
+
+    handle = SD_open(0, NULL);
+    TEST_ASSERT(handle != NULL);
+    TEST_ASSERT(spiBitRate == 400000);
+
+    TEST_ASSERT(SD_initialize(handle) == SD_STATUS_SUCCESS);
+    TEST_ASSERT(!card.idle);
+    TEST_ASSERT(spiBitRate == BIT_RATE);
+    TEST_ASSERT(sdspiObjects[0].cardType == SD_SDHC);
+
+    TEST_ASSERT(SD_getNumSectors(handle) == NUM_SECTORS);
+    TEST_ASSERT(SD_getSectorSize(handle) == SECTOR_SIZE);
+
+    SD_close(handle);
+    TEST_ASSERT(!spiIsOpen);
+
+    printf("initialize: ok\n");
+}
+
+/*
+ *  ======== testRandom ========
+ *  Random reads & writes with random access gaps & busy times, checked
+ *  against the shadow copy of the card.
+ */
+static void testRandom(void)
+{
+    SD_Handle    handle = openCard();
+    uint8_t     *data;
+    uint32_t     sector;
+    uint32_t     count;
+    unsigned int round;
+    unsigned int reads = 0;
+    unsigned int writes = 0;
+
+    for (round = 0; round < ROUNDS; round++) {
+        count = 1 + Test_random(&seed) % MAX_COUNT;
+        sector = Test_random(&seed) % (NUM_SECTORS - count + 1);
+        data = (uint8_t *)buf + (Test_random(&seed) & 3);
+
+        if (Test_random(&seed) & 1) {
+            fillRandom(data, count * SECTOR_SIZE);
+            TEST_ASSERT(SD_write(handle, data, sector, count) ==
+                SD_STATUS_SUCCESS);
+            memcpy(shadow[sector], data, count * SECTOR_SIZE);
+            writes++;
+        }
+        else {
+            memset(data, 0, count * SECTOR_SIZE);
+            TEST_ASSERT(SD_read(handle, data, sector, count) ==
+                SD_STATUS_SUCCESS);
+            TEST_ASSERT(memcmp(data, shadow[sector],
+                count * SECTOR_SIZE) == 0);
+            reads++;
+        }
+    }
+
+    TEST_ASSERT(memcmp(storage, shadow, sizeof(storage)) == 0);
+
+    SD_close(handle);
+
+    printf("random: ok, %u reads, %u writes\n", reads, writes);
+}
+
+/*
+ *  ======== testStats ========
+ *  Successful transfers are counted in the bucket of their size; rejected
+ *  writes are not counted.
+ */
+static void testStats(void)
+{
+    static const uint32_t counts[] = {1, 1, 8, 2, 64, 9, 80};
+    SD_Handle     handle = openCard();
+    SDSPI_Stats   stats;
+    unsigned int  i;
+    unsigned int  bucket;
+    uint32_t      transfers[SDSPI_STATS_BUCKET_COUNT] = {0};
+    uint32_t      sectors[SDSPI_STATS_BUCKET_COUNT] = {0};
+
+    TEST_ASSERT(SD_control(handle, SDSPI_CMD_CLEAR_STATS, NULL) ==
+        SD_STATUS_SUCCESS);
+
+    for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        TEST_ASSERT(SD_read(handle, buf, 100, counts[i]) ==
+            SD_STATUS_SUCCESS);
+        TEST_ASSERT(SD_write(handle, buf, 100, counts[i]) ==
+            SD_STATUS_SUCCESS);
+
+        bucket = (counts[i] == 1) ? SDSPI_STATS_BUCKET_1 :
+            (counts[i] <= 8) ? SDSPI_STATS_BUCKET_8 :
+            (counts[i] <= 64) ? SDSPI_STATS_BUCKET_64 :
+            SDSPI_STATS_BUCKET_MAX;
+        transfers[bucket]++;
+        sectors[bucket] += counts[i];
+    }
+
+    /* Rejected data fails the write */
+    card.rejectWrites = true;
+    TEST_ASSERT(SD_write(handle, buf, 100, 1) == SD_STATUS_ERROR);
+    TEST_ASSERT(SD_write(handle, buf, 100, 8) == SD_STATUS_ERROR);
+    card.rejectWrites = false;
+    memcpy(shadow[100], storage[100], 80 * SECTOR_SIZE);
+
+    TEST_ASSERT(SD_control(handle, SDSPI_CMD_GET_STATS, &stats) ==
+        SD_STATUS_SUCCESS);
+    TEST_ASSERT(stats.timestampFreq != 0);
+
+    for (bucket = 0; bucket < SDSPI_STATS_BUCKET_COUNT; bucket++) {
+        TEST_ASSERT(stats.read[bucket].transfers == transfers[bucket]);
+        TEST_ASSERT(stats.read[bucket].sectors == sectors[bucket]);
+        TEST_ASSERT(stats.read[bucket].ticks > 0);
+        TEST_ASSERT(stats.write[bucket].transfers == transfers[bucket]);
+        TEST_ASSERT(stats.write[bucket].sectors == sectors[bucket]);
+        TEST_ASSERT(stats.write[bucket].ticks > 0);
+    }
+
+    TEST_ASSERT(SD_control(handle, SDSPI_CMD_CLEAR_STATS, NULL) ==
+        SD_STATUS_SUCCESS);
+    TEST_ASSERT(SD_control(handle, SDSPI_CMD_GET_STATS, &stats) ==
+        SD_STATUS_SUCCESS);
+    TEST_ASSERT(stats.read[SDSPI_STATS_BUCKET_1].transfers == 0);
+    TEST_ASSERT(stats.write[SDSPI_STATS_BUCKET_MAX].ticks == 0);
+
+    SD_close(handle);
+
+    printf("stats: ok\n");
+}
+
+/*
+ *  ======== benchSize ========
+ *  Prints one row per direction for transfers of count sectors.
+ */
+static void benchSize(SD_Handle handle, uint32_t count, unsigned int rounds)
+{
+    SDSPI_Stats  stats;
+    unsigned int round;
+    unsigned int dir;
+    uint32_t     bytes;
+    uint32_t     sectors;
+    double       busSec;
+    double       hostSec;
+    SDSPI_TransferStats *total;
+
+    for (dir = 0; dir < 2; dir++) {
+        SD_control(handle, SDSPI_CMD_CLEAR_STATS, NULL);
+        spiTransfers = 0;
+        spiBytes = 0;
+
+        for (round = 0; round < rounds; round++) {
+            if (dir == 0) {
+                TEST_ASSERT(SD_read(handle, buf, 0, count) ==
+                    SD_STATUS_SUCCESS);
+            }
+            else {
+                TEST_ASSERT(SD_write(handle, buf, 0, count) ==
+                    SD_STATUS_SUCCESS);
+            }
+        }
+
+        SD_control(handle, SDSPI_CMD_GET_STATS, &stats);
+        total = (dir == 0) ? stats.read : stats.write;
+        total = &total[(count == 1) ? SDSPI_STATS_BUCKET_1 :
+            (count <= 8) ? SDSPI_STATS_BUCKET_8 :
+            (count <= 64) ? SDSPI_STATS_BUCKET_64 : SDSPI_STATS_BUCKET_MAX];
+
+        sectors = count * rounds;
+        bytes = sectors * SECTOR_SIZE;
+        busSec = (spiBytes * 8.0) / BIT_RATE;
+        hostSec = (double)total->ticks / stats.timestampFreq;
+
+        printf("%-6s %8u %6u %12.2f %12.1f %10.2f %10.1f\n",
+            (dir == 0) ? "read" : "write", (unsigned int)count, card.gap,
+            (double)spiTransfers / sectors, (double)spiBytes / sectors,
+            bytes / busSec / 1e6, bytes / hostSec / 1e6);
+    }
+}
+
+/*
+ *  ======== bench ========
+ *  Fixed access gaps, within & beyond the token look-ahead, and busy time.
+ */
+static void bench(void)
+{
+    static const uint32_t counts[] = {1, 8, 64, MAX_COUNT};
+    static const unsigned int gaps[] = {2, 20};
+    SD_Handle    handle = openCard();
+    unsigned int i;
+    unsigned int j;
+
+    printf("%u Hz SPI; bus MB/s excludes the set up time of SPI transfers\n",
+        (unsigned int)BIT_RATE);
+    printf("%-6s %8s %6s %12s %12s %10s %10s\n", "dir", "sectors", "gap",
+        "xfers/sect", "bytes/sect", "bus MB/s", "host MB/s");
+
+    card.busyTime = 16;
+    for (j = 0; j < sizeof(gaps) / sizeof(gaps[0]); j++) {
+        card.gap = gaps[j];
+        for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+            benchSize(handle, counts[i], 20000 / counts[i]);
+        }
+    }
+    card.gap = 0;
+    card.busyTime = 0;
+
+    SD_close(handle);
+}
+
+int main(int argc, char *argv[])
+{
+    /* A driver polling a card that never answers hangs the test */
+    alarm(TIMEOUT_SEC);
+
+    fillRandom(storage, sizeof(storage));
+    memcpy(shadow, storage, sizeof(storage));
+
+    SD_init();
+
+    if ((argc > 1) && (strcmp(argv[1], "bench") == 0)) {
+        bench();
+    }
+    else {
+        testInitialize();
+        testRandom();
+        testStats();
+    }
+
+    return (0);
+}
@@ -0,0 +1,1278 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== DTHE_host.c ========
+ *  Model of the DTHE crypto engines behind the driverlib AES, DES and
+ *  SHAMD5 functions, computing with the reference implementations in
+ *  ref/.
+ *
+ *  The cipher engines take one block at a time: a block written, by the
+ *  CPU or by the input uDMA channel, is processed at once and must be read
+ *  back before the next is accepted. An operation starts at the length
+ *  write and ends when its last byte is read. The SHA/MD5 engine keeps its
+ *  state in its digest registers, which the drivers access directly
+ *  through HWREG(); a pass starts at the length write, from the algorithm
+ *  constants, the HMAC key or the digest registers, and ends when the
+ *  given length has been written.
+ *
+ *  Interrupt status follows driverlib: engine events in the low half, the
+ *  DTHE uDMA done events in the high half. An engine's interrupt is posted
+ *  when its masked status becomes non-zero. Every model call runs with
+ *  interrupts disabled, so the interrupts it raises run once it returns.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ti/drivers/dpl/HwiP.h>
+
+#include <ti/devices/cc32xx/inc/hw_types.h>
+#include <ti/devices/cc32xx/inc/hw_ints.h>
+#include <ti/devices/cc32xx/inc/hw_memmap.h>
+#include <ti/devices/cc32xx/inc/hw_aes.h>
+#include <ti/devices/cc32xx/inc/hw_des.h>
+#include <ti/devices/cc32xx/inc/hw_shamd5.h>
+#include <ti/devices/cc32xx/driverlib/aes.h>
+#include <ti/devices/cc32xx/driverlib/des.h>
+#include <ti/devices/cc32xx/driverlib/shamd5.h>
+#include <ti/devices/cc32xx/driverlib/udma.h>
+
+#include "ref/CryptoRef.h"
+
+#include "DTHE_host.h"
+#include "UDMA_host.h"
+
+#define ENGINE_AES          (0)
+#define ENGINE_DES          (1)
+#define ENGINE_SHA          (2)
+#define NUM_ENGINES         (3)
+
+/* DTHE interrupt bits are the driverlib uDMA event flags shifted down */
+#define DTHE_BITS(flags)    (((flags) >> 16) & 0xF)
+
+/* SHAMD5 register file: digests, count, mode, length and IRQ status */
+#define SHA_REG(offset)     (sha.regs[(offset) / sizeof(uint32_t)])
+#define SHA_NUM_REGS        ((SHAMD5_O_IRQSTATUS / sizeof(uint32_t)) + 1)
+
+#define SHA_ALGO_M          (0x6)
+#define SHA_ALGO_CONSTANT   (1U << ALGO_CONSTANT_SHIFT)
+#define SHA_CLOSE_HASH      (1U << CLOSE_HASH_SHIFT)
+#define SHA_HMAC_KEY_PROC   (1U << HMAC_KEY_PROC_SHIFT)
+#define SHA_HMAC_OUTER      (1U << HMAC_OUTER_HASH_SHIFT)
+
+typedef struct Cipher {
+    uint32_t base;
+    uint32_t blockSize;
+    uint32_t config;
+    uint8_t  key[32];
+    uint8_t  iv[CryptoRef_AES_BLOCK_SIZE];
+    CryptoRef_AesKey aesKey;
+    CryptoRef_DesKey desKey;
+    bool     busy;
+    uint64_t length;            /* bytes of the current operation */
+    uint64_t fed;               /* bytes written */
+    uint64_t drained;           /* bytes read */
+    uint8_t  in[CryptoRef_AES_BLOCK_SIZE];
+    uint32_t inLen;
+    uint8_t  out[CryptoRef_AES_BLOCK_SIZE];
+    uint32_t outLen;            /* valid bytes of out, 0 if none */
+    uint32_t outPos;
+    uint32_t irqEnable;
+    uint32_t dmaEnable;
+} Cipher;
+
+typedef struct Sha {
+    uint32_t regs[SHA_NUM_REGS];
+    CryptoRef_Hash hash;
+    bool     active;
+    uint32_t passLen;
+    uint32_t received;
+    bool     outputReady;
+    uint32_t irqEnable;
+    bool     dmaEnable;
+} Sha;
+
+DTHEHost_Counters DTHEHost_counters;
+
+static Cipher   aes = {.base = AES_BASE, .blockSize = CryptoRef_AES_BLOCK_SIZE};
+static Cipher   des = {.base = DES_BASE, .blockSize = CryptoRef_DES_BLOCK_SIZE};
+static Sha      sha;
+static uint32_t dtheRis[NUM_ENGINES];
+static uint32_t dtheIm[NUM_ENGINES] = {0xF, 0xF, 0xF};
+static bool     lines[NUM_ENGINES];
+static bool     stalled;
+
+static const int intNums[NUM_ENGINES] = {INT_AES, INT_DES, INT_SHA};
+
+/*
+ *  ======== fail ========
+ */
+static void fail(const char *what)
+{
+    fprintf(stderr, "DTHE model: %s\n", what);
+    abort();
+}
+
+/*
+ *  ======== words ========
+ */
+static uint32_t words(uint32_t bytes)
+{
+    return ((bytes + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+}
+
+/*
+ *  ======== aesStatus ========
+ */
+static uint32_t aesStatus(const Cipher *c)
+{
+    uint32_t status = 0;
+
+    if (!c->busy && !stalled) {
+        status |= AES_INT_CONTEXT_IN;
+    }
+    if (c->busy && (c->outLen == 0) && (c->fed < c->length)) {
+        status |= AES_INT_DATA_IN;
+    }
+    if (c->outLen != 0) {
+        status |= AES_INT_DATA_OUT;
+    }
+
+    return (status);
+}
+
+/*
+ *  ======== shaStatus ========
+ */
+static uint32_t shaStatus(void)
+{
+    uint32_t status = 0;
+
+    if (sha.outputReady) {
+        status |= SHAMD5_INT_OUTPUT_READY;
+    }
+    if (sha.active) {
+        status |= SHAMD5_INT_INPUT_READY;
+    }
+    else if (!stalled) {
+        status |= SHAMD5_INT_CONTEXT_READY;
+    }
+
+    return (status);
+}
+
+/*
+ *  ======== maskedStatus ========
+ */
+static uint32_t maskedStatus(int engine)
+{
+    uint32_t status;
+    uint32_t irqEnable;
+
+    switch (engine) {
+        case ENGINE_AES:
+            status = aesStatus(&aes);
+            irqEnable = aes.irqEnable;
+            break;
+        case ENGINE_DES:
+            status = aesStatus(&des);
+            irqEnable = des.irqEnable;
+            break;
+        default:
+            status = shaStatus();
+            irqEnable = sha.irqEnable;
+            break;
+    }
+
+    return ((status & irqEnable & 0xFFFF) |
+        ((dtheRis[engine] & ~dtheIm[engine]) << 16));
+}
+
+/*
+ *  ======== updateLines ========
+ *  Posts the interrupt of each engine whose masked status became non-zero.
+ */
+static void updateLines(void)
+{
+    bool line;
+    int  engine;
+
+    SHA_REG(SHAMD5_O_IRQSTATUS) = shaStatus();
+
+    for (engine = 0; engine < NUM_ENGINES; engine++) {
+        line = (maskedStatus(engine) != 0);
+        if (line && !lines[engine]) {
+            DTHEHost_counters.interrupts++;
+            HwiP_post(intNums[engine]);
+        }
+        lines[engine] = line;
+    }
+}
+
+/*
+ *  ======== enter ========
+ */
+static uintptr_t enter(void)
+{
+    uintptr_t key = HwiP_disable();
+
+    DTHEHost_counters.calls++;
+
+    return (key);
+}
+
+/*
+ *  ======== leave ========
+ */
+static void leave(uintptr_t key)
+{
+    UDMAHost_run();
+    updateLines();
+
+    HwiP_restore(key);
+}
+
+/* ============================ Cipher engines ========================= */
+
+/*
+ *  ======== xorBlock ========
+ */
+static void xorBlock(uint8_t *out, const uint8_t *a, const uint8_t *b,
+    uint32_t len)
+{
+    uint32_t i;
+
+    for (i = 0; i < len; i++) {
+        out[i] = a[i] ^ b[i];
+    }
+}
+
+/*
+ *  ======== aesBlock ========
+ *  ECB, CBC, CTR with a 32-bit counter, and CFB128.
+ */
+static void aesBlock(Cipher *c, const uint8_t *in, uint8_t *out)
+{
+    bool    encrypt = (c->config & AES_CFG_DIR_ENCRYPT) != 0;
+    uint8_t t[CryptoRef_AES_BLOCK_SIZE];
+    int     i;
+
+    switch (c->config & AES_CFG_MODE_M) {
+        case AES_CFG_MODE_ECB:
+            if (encrypt) {
+                CryptoRef_aesEncrypt(&c->aesKey, in, out);
+            }
+            else {
+                CryptoRef_aesDecrypt(&c->aesKey, in, out);
+            }
+            break;
+
+        case AES_CFG_MODE_CBC:
+            if (encrypt) {
+                xorBlock(t, in, c->iv, sizeof(t));
+                CryptoRef_aesEncrypt(&c->aesKey, t, out);
+                memcpy(c->iv, out, sizeof(t));
+            }
+            else {
+                CryptoRef_aesDecrypt(&c->aesKey, in, t);
+                xorBlock(out, t, c->iv, sizeof(t));
+                memcpy(c->iv, in, sizeof(t));
+            }
+            break;
+
+        case AES_CFG_MODE_CTR:
+            CryptoRef_aesEncrypt(&c->aesKey, c->iv, t);
+            xorBlock(out, in, t, sizeof(t));
+            for (i = 15; (i >= 12) && (++c->iv[i] == 0); i--) {
+            }
+            break;
+
+        case AES_CFG_MODE_CFB:
+            CryptoRef_aesEncrypt(&c->aesKey, c->iv, t);
+            xorBlock(out, in, t, sizeof(t));
+            memcpy(c->iv, encrypt ? out : in, sizeof(t));
+            break;
+
+        default:
+            fail("AES mode not modelled");
+            break;
+    }
+}
+
+/*
+ *  ======== desBlock ========
+ *  ECB, CBC and CFB64, single or EDE triple DES.
+ */
+static void desBlock(Cipher *c, const uint8_t *in, uint8_t *out)
+{
+    bool    encrypt = (c->config & DES_CFG_DIR_ENCRYPT) != 0;
+    uint8_t t[CryptoRef_DES_BLOCK_SIZE];
+
+    switch (c->config & (DES_CFG_MODE_CBC | DES_CFG_MODE_CFB)) {
+        case DES_CFG_MODE_ECB:
+            if (encrypt) {
+                CryptoRef_desEncrypt(&c->desKey, in, out);
+            }
+            else {
+                CryptoRef_desDecrypt(&c->desKey, in, out);
+            }
+            break;
+
+        case DES_CFG_MODE_CBC:
+            if (encrypt) {
+                xorBlock(t, in, c->iv, sizeof(t));
+                CryptoRef_desEncrypt(&c->desKey, t, out);
+                memcpy(c->iv, out, sizeof(t));
+            }
+            else {
+                CryptoRef_desDecrypt(&c->desKey, in, t);
+                xorBlock(out, t, c->iv, sizeof(t));
+                memcpy(c->iv, in, sizeof(t));
+            }
+            break;
+
+        case DES_CFG_MODE_CFB:
+            CryptoRef_desEncrypt(&c->desKey, c->iv, t);
+            xorBlock(out, in, t, sizeof(t));
+            memcpy(c->iv, encrypt ? out : in, sizeof(t));
+            break;
+
+        default:
+            fail("DES mode not modelled");
+            break;
+    }
+}
+
+/*
+ *  ======== cipherCheckIdle ========
+ */
+static void cipherCheckIdle(const Cipher *c)
+{
+    if (c->busy) {
+        fail("context written while the engine is busy");
+    }
+}
+
+/*
+ *  ======== cipherStart ========
+ *  The length write: the engine starts using the context.
+ */
+static void cipherStart(Cipher *c, uint64_t length)
+{
+    uint32_t keySize;
+
+    cipherCheckIdle(c);
+    if (length == 0) {
+        fail("zero length operation");
+    }
+
+    if (c == &aes) {
+        keySize = 8 * ((c->config >> 3) & 0x3) + 8;
+        CryptoRef_aesSetKey(&c->aesKey, c->key, keySize);
+    }
+    else {
+        CryptoRef_desSetKey(&c->desKey, c->key,
+            (c->config & DES_CFG_TRIPLE) != 0);
+    }
+
+    c->busy = true;
+    c->length = length;
+    c->fed = 0;
+    c->drained = 0;
+    c->inLen = 0;
+    c->outLen = 0;
+}
+
+/*
+ *  ======== cipherWrite ========
+ *  Takes input bytes; a full block, or the last bytes of the operation
+ *  padded with zeros, is processed at once.
+ */
+static void cipherWrite(Cipher *c, const uint8_t *src, uint32_t len)
+{
+    uint64_t left;
+
+    if (!c->busy || (c->outLen != 0) ||
+        (c->inLen + len > c->blockSize) || (c->fed + len > c->length)) {
+        fail("data written while the engine does not accept it");
+    }
+
+    memcpy(c->in + c->inLen, src, len);
+    c->inLen += len;
+    c->fed += len;
+
+    if ((c->inLen == c->blockSize) || (c->fed == c->length)) {
+        memset(c->in + c->inLen, 0, c->blockSize - c->inLen);
+        if (c == &aes) {
+            aesBlock(c, c->in, c->out);
+        }
+        else {
+            desBlock(c, c->in, c->out);
+        }
+        left = c->length - c->drained;
+        c->outLen = (left < c->blockSize) ? (uint32_t)left : c->blockSize;
+        c->outPos = 0;
+        c->inLen = 0;
+    }
+}
+
+/*
+ *  ======== cipherRead ========
+ */
+static void cipherRead(Cipher *c, uint8_t *dst, uint32_t len)
+{
+    if (c->outPos + len > c->outLen) {
+        fail("data read while the engine has no output");
+    }
+
+    memcpy(dst, c->out + c->outPos, len);
+    c->outPos += len;
+    c->drained += len;
+
+    if (c->outPos == c->outLen) {
+        c->outLen = 0;
+        if (c->drained == c->length) {
+            c->busy = false;
+        }
+    }
+}
+
+/*
+ *  ======== cipherProcess ========
+ *  DataProcess: the CPU writes each block and reads its result.
+ */
+static void cipherProcess(Cipher *c, const uint8_t *src, uint8_t *dst,
+    uint32_t len)
+{
+    uint32_t offset;
+    uint32_t n;
+
+    cipherStart(c, len);
+    for (offset = 0; offset < len; offset += n) {
+        n = (len - offset < c->blockSize) ? (len - offset) : c->blockSize;
+        cipherWrite(c, src + offset, n);
+        cipherRead(c, dst + offset, n);
+        DTHEHost_counters.cpuWords += 2 * words(n);
+    }
+}
+
+/*
+ *  ======== cipherStatus ========
+ */
+static uint32_t cipherStatus(Cipher *c, int engine, bool masked)
+{
+    if (masked) {
+        return (maskedStatus(engine));
+    }
+
+    return (aesStatus(c) | (dtheRis[engine] << 16));
+}
+
+/*
+ *  ======== cipherDataRequest ========
+ *  uDMA request lines of the cipher engines.
+ */
+static bool cipherInRequest(const Cipher *c, uint32_t dmaFlag)
+{
+    return ((c->dmaEnable & dmaFlag) && c->busy && (c->outLen == 0) &&
+        (c->fed < c->length));
+}
+
+static bool cipherOutRequest(const Cipher *c, uint32_t dmaFlag)
+{
+    return ((c->dmaEnable & dmaFlag) && (c->outLen != 0));
+}
+
+/*
+ *  ======== cipherDmaWrite ========
+ */
+static void cipherDmaWrite(Cipher *c, uint32_t addr, uint32_t dataAddr,
+    uint32_t value)
+{
+    if (addr != dataAddr) {
+        fail("uDMA write outside the data register");
+    }
+    cipherWrite(c, (uint8_t *)&value, sizeof(value));
+    updateLines();
+}
+
+/*
+ *  ======== cipherDmaRead ========
+ */
+static uint32_t cipherDmaRead(Cipher *c, uint32_t addr, uint32_t dataAddr)
+{
+    uint32_t value;
+
+    if (addr != dataAddr) {
+        fail("uDMA read outside the data register");
+    }
+    cipherRead(c, (uint8_t *)&value, sizeof(value));
+    updateLines();
+
+    return (value);
+}
+
+static bool aesInRequest(void)
+{
+    return (cipherInRequest(&aes, AES_DMA_DATA_IN));
+}
+
+static bool aesOutRequest(void)
+{
+    return (cipherOutRequest(&aes, AES_DMA_DATA_OUT));
+}
+
+static uint32_t aesRead(uint32_t addr)
+{
+    return (cipherDmaRead(&aes, addr, AES_BASE + AES_O_DATA_IN_0));
+}
+
+static void aesWrite(uint32_t addr, uint32_t value)
+{
+    cipherDmaWrite(&aes, addr, AES_BASE + AES_O_DATA_IN_0, value);
+}
+
+static void aesInDone(void)
+{
+    dtheRis[ENGINE_AES] |= DTHE_BITS(AES_INT_DMA_DATA_IN);
+    updateLines();
+}
+
+static void aesOutDone(void)
+{
+    dtheRis[ENGINE_AES] |= DTHE_BITS(AES_INT_DMA_DATA_OUT);
+    updateLines();
+}
+
+static bool desInRequest(void)
+{
+    return (cipherInRequest(&des, DES_DMA_DATA_IN));
+}
+
+static bool desOutRequest(void)
+{
+    return (cipherOutRequest(&des, DES_DMA_DATA_OUT));
+}
+
+static uint32_t desRead(uint32_t addr)
+{
+    return (cipherDmaRead(&des, addr, DES_BASE + DES_O_DATA_L));
+}
+
+static void desWrite(uint32_t addr, uint32_t value)
+{
+    cipherDmaWrite(&des, addr, DES_BASE + DES_O_DATA_L, value);
+}
+
+static void desInDone(void)
+{
+    dtheRis[ENGINE_DES] |= DTHE_BITS(DES_INT_DMA_DATA_IN);
+    updateLines();
+}
+
+static void desOutDone(void)
+{
+    dtheRis[ENGINE_DES] |= DTHE_BITS(DES_INT_DMA_DATA_OUT);
+    updateLines();
+}
+
+/* ============================ SHA/MD5 engine ========================= */
+
+/*
+ *  ======== shaAlgo ========
+ */
+static CryptoRef_HashAlgo shaAlgo(void)
+{
+    switch (SHA_REG(SHAMD5_O_MODE) & SHA_ALGO_M) {
+        case SHAMD5_ALGO_MD5:
+            return (CryptoRef_MD5);
+        case SHAMD5_ALGO_SHA1:
+            return (CryptoRef_SHA1);
+        case SHAMD5_ALGO_SHA224:
+            return (CryptoRef_SHA224);
+        default:
+            return (CryptoRef_SHA256);
+    }
+}
+
+/*
+ *  ======== shaStateWords ========
+ */
+static uint32_t shaStateWords(CryptoRef_HashAlgo algo)
+{
+    return ((algo == CryptoRef_MD5) ? 4 : (algo == CryptoRef_SHA1) ? 5 : 8);
+}
+
+/*
+ *  ======== shaSaveState ========
+ *  Digest registers hold the state in digest byte order.
+ */
+static void shaSaveState(const CryptoRef_Hash *hash, uint32_t offset)
+{
+    uint32_t i;
+
+    for (i = 0; i < shaStateWords(hash->algo); i++) {
+        SHA_REG(offset + 4 * i) = (hash->algo == CryptoRef_MD5) ?
+            hash->state[i] : __builtin_bswap32(hash->state[i]);
+    }
+}
+
+/*
+ *  ======== shaLoadState ========
+ */
+static void shaLoadState(CryptoRef_Hash *hash, CryptoRef_HashAlgo algo,
+    uint32_t offset, uint32_t count)
+{
+    uint32_t i;
+
+    CryptoRef_hashInit(hash, algo);
+    for (i = 0; i < shaStateWords(algo); i++) {
+        hash->state[i] = (algo == CryptoRef_MD5) ? SHA_REG(offset + 4 * i) :
+            __builtin_bswap32(SHA_REG(offset + 4 * i));
+    }
+    hash->count = count;
+}
+
+/*
+ *  ======== shaStart ========
+ *  The length write: starts a pass from the algorithm constants, the HMAC
+ *  key in the digest registers, or the state in the inner digest.
+ */
+static void shaStart(uint32_t length)
+{
+    CryptoRef_HashAlgo algo = shaAlgo();
+    uint32_t mode = SHA_REG(SHAMD5_O_MODE);
+    CryptoRef_Hash outer;
+    uint8_t  key[CryptoRef_HASH_BLOCK_SIZE];
+    uint8_t  pad[CryptoRef_HASH_BLOCK_SIZE];
+    uint32_t i;
+
+    if (sha.active) {
+        fail("length written during a pass");
+    }
+    if (length == 0) {
+        fail("zero length pass");
+    }
+
+    if (mode & SHA_HMAC_KEY_PROC) {
+        memcpy(key, &SHA_REG(SHAMD5_O_ODIGEST_A), sizeof(key));
+
+        for (i = 0; i < sizeof(pad); i++) {
+            pad[i] = key[i] ^ 0x5C;
+        }
+        CryptoRef_hashInit(&outer, algo);
+        CryptoRef_hashUpdate(&outer, pad, sizeof(pad));
+        shaSaveState(&outer, SHAMD5_O_ODIGEST_A);
+
+        for (i = 0; i < sizeof(pad); i++) {
+            pad[i] = key[i] ^ 0x36;
+        }
+        CryptoRef_hashInit(&sha.hash, algo);
+        CryptoRef_hashUpdate(&sha.hash, pad, sizeof(pad));
+    }
+    else if (mode & SHA_ALGO_CONSTANT) {
+        CryptoRef_hashInit(&sha.hash, algo);
+    }
+    else {
+        shaLoadState(&sha.hash, algo, SHAMD5_O_IDIGEST_A,
+            SHA_REG(SHAMD5_O_DIGEST_COUNT));
+    }
+
+    SHA_REG(SHAMD5_O_LENGTH) = length;
+    sha.active = true;
+    sha.passLen = length;
+    sha.received = 0;
+    sha.outputReady = false;
+}
+
+/*
+ *  ======== shaFinish ========
+ *  End of a pass: the digest, or the state and count for the next pass,
+ *  go to the inner digest registers.
+ */
+static void shaFinish(void)
+{
+    uint32_t mode = SHA_REG(SHAMD5_O_MODE);
+    CryptoRef_Hash outer;
+    uint8_t  digest[CryptoRef_MAX_DIGEST_SIZE];
+    size_t   size = CryptoRef_digestSize(sha.hash.algo);
+
+    if (mode & SHA_CLOSE_HASH) {
+        CryptoRef_hashFinal(&sha.hash, digest);
+        if (mode & SHA_HMAC_OUTER) {
+            shaLoadState(&outer, sha.hash.algo, SHAMD5_O_ODIGEST_A,
+                CryptoRef_HASH_BLOCK_SIZE);
+            CryptoRef_hashUpdate(&outer, digest, size);
+            CryptoRef_hashFinal(&outer, digest);
+        }
+        memcpy(&SHA_REG(SHAMD5_O_IDIGEST_A), digest, size);
+    }
+    else {
+        if (sha.hash.bufLen != 0) {
+            fail("pass without closing is not a multiple of the block size");
+        }
+        shaSaveState(&sha.hash, SHAMD5_O_IDIGEST_A);
+        SHA_REG(SHAMD5_O_DIGEST_COUNT) = (uint32_t)sha.hash.count;
+    }
+
+    sha.active = false;
+    sha.outputReady = true;
+}
+
+/*
+ *  ======== shaWrite ========
+ */
+static void shaWrite(const uint8_t *src, uint32_t len)
+{
+    if (!sha.active || (sha.received + len > sha.passLen)) {
+        fail("data written past the pass length");
+    }
+
+    CryptoRef_hashUpdate(&sha.hash, src, len);
+    sha.received += len;
+
+    if (sha.received == sha.passLen) {
+        shaFinish();
+    }
+}
+
+static bool shaInRequest(void)
+{
+    return (sha.dmaEnable && sha.active && (sha.received < sha.passLen));
+}
+
+static uint32_t shaRead(uint32_t addr)
+{
+    fail("uDMA read from the SHA/MD5 engine");
+
+    return (0);
+}
+
+static void shaDmaWrite(uint32_t addr, uint32_t value)
+{
+    if ((addr < SHAMD5_BASE + SHAMD5_O_DATA0_IN) ||
+        (addr > SHAMD5_BASE + SHAMD5_O_DATA15_IN)) {
+        fail("uDMA write outside the data registers");
+    }
+    shaWrite((uint8_t *)&value, sizeof(value));
+    updateLines();
+}
+
+static void shaInDone(void)
+{
+    dtheRis[ENGINE_SHA] |= DTHE_BITS(SHAMD5_INT_DMA_DATA_IN);
+    updateLines();
+}
+
+static const UDMAHost_Peripheral peripherals[] = {
+    {UDMA_CH20_AES_DIN, aesInRequest, aesRead, aesWrite, aesInDone},
+    {UDMA_CH21_AES_DOUT, aesOutRequest, aesRead, aesWrite, aesOutDone},
+    {UDMA_CH4_DES_DIN, desInRequest, desRead, desWrite, desInDone},
+    {UDMA_CH5_DES_DOUT, desOutRequest, desRead, desWrite, desOutDone},
+    {UDMA_CH1_SHAMD5_DIN, shaInRequest, shaRead, shaDmaWrite, shaInDone}
+};
+
+/*
+ *  ======== CC32XXHost_reg ========
+ *  HWREG() of the host hw_types.h. The drivers access the SHA/MD5 digest,
+ *  count, mode and status registers directly; a pass is only started by
+ *  SHAMD5DataLengthSet().
+ */
+volatile uint32_t *CC32XXHost_reg(uint32_t addr)
+{
+    uint32_t offset = addr - SHAMD5_BASE;
+
+    if ((addr < SHAMD5_BASE) || (offset % sizeof(uint32_t) != 0) ||
+        ((offset > SHAMD5_O_MODE) && (offset != SHAMD5_O_IRQSTATUS))) {
+        fprintf(stderr, "DTHE model: HWREG(0x%08x) not modelled\n",
+            (unsigned int)addr);
+        abort();
+    }
+
+    DTHEHost_counters.cpuWords++;
+
+    return (&SHA_REG(offset));
+}
+
+/*
+ *  ======== DTHEHost_init ========
+ */
+void DTHEHost_init(void)
+{
+    unsigned int i;
+
+    for (i = 0; i < sizeof(peripherals) / sizeof(peripherals[0]); i++) {
+        UDMAHost_addPeripheral(&peripherals[i]);
+    }
+    SHA_REG(SHAMD5_O_IRQSTATUS) = shaStatus();
+}
+
+/*
+ *  ======== DTHEHost_stall ========
+ */
+void DTHEHost_stall(bool stall)
+{
+    uintptr_t key = HwiP_disable();
+
+    stalled = stall;
+    updateLines();
+
+    HwiP_restore(key);
+}
+
+/* ================================ AES ================================ */
+
+void AESConfigSet(uint32_t ui32Base, uint32_t ui32Config)
+{
+    uintptr_t key = enter();
+
+    cipherCheckIdle(&aes);
+    aes.config = ui32Config;
+    DTHEHost_counters.cpuWords++;
+
+    leave(key);
+}
+
+void AESKey1Set(uint32_t ui32Base, uint8_t *pui8Key, uint32_t ui32Keysize)
+{
+    uintptr_t key = enter();
+    uint32_t  size = 8 * (ui32Keysize >> 3) + 8;
+
+    cipherCheckIdle(&aes);
+    memcpy(aes.key, pui8Key, size);
+    DTHEHost_counters.cpuWords += words(size);
+
+    leave(key);
+}
+
+void AESKey2Set(uint32_t ui32Base, uint8_t *pui8Key, uint32_t ui32Keysize)
+{
+    fail("AES key 2 is not modelled");
+}
+
+void AESIVSet(uint32_t ui32Base, uint8_t *pui8IVdata)
+{
+    uintptr_t key = enter();
+
+    cipherCheckIdle(&aes);
+    memcpy(aes.iv, pui8IVdata, CryptoRef_AES_BLOCK_SIZE);
+    DTHEHost_counters.cpuWords += 4;
+
+    leave(key);
+}
+
+void AESIVGet(uint32_t ui32Base, uint8_t *pui8IVdata)
+{
+    uintptr_t key = enter();
+
+    cipherCheckIdle(&aes);
+    memcpy(pui8IVdata, aes.iv, CryptoRef_AES_BLOCK_SIZE);
+    DTHEHost_counters.cpuWords += 4;
+
+    leave(key);
+}
+
+void AESDataLengthSet(uint32_t ui32Base, uint64_t ui64Length)
+{
+    uintptr_t key = enter();
+
+    cipherStart(&aes, ui64Length);
+    DTHEHost_counters.cpuWords += 2;
+
+    leave(key);
+}
+
+bool AESDataProcess(uint32_t ui32Base, uint8_t *pui8Src, uint8_t *pui8Dest,
+    uint32_t ui32Length)
+{
+    uintptr_t key = enter();
+
+    cipherProcess(&aes, pui8Src, pui8Dest, ui32Length);
+
+    leave(key);
+
+    return (true);
+}
+
+bool AESDataProcessAE(uint32_t ui32Base, uint8_t *pui8Src,
+    uint8_t *pui8Dest, uint32_t ui32Length, uint8_t *pui8AuthSrc,
+    uint32_t ui32AuthLength, uint8_t *pui8Tag)
+{
+    fail("AES authenticated modes are not modelled");
+
+    return (false);
+}
+
+uint32_t AESIntStatus(uint32_t ui32Base, bool bMasked)
+{
+    uintptr_t key = enter();
+    uint32_t  status = cipherStatus(&aes, ENGINE_AES, bMasked);
+
+    leave(key);
+
+    return (status);
+}
+
+void AESIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    uintptr_t key = enter();
+
+    dtheIm[ENGINE_AES] &= ~DTHE_BITS(ui32IntFlags);
+    aes.irqEnable |= ui32IntFlags & 0xFFFF;
+
+    leave(key);
+}
+
+void AESIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    uintptr_t key = enter();
+
+    dtheIm[ENGINE_AES] |= DTHE_BITS(ui32IntFlags);
+    aes.irqEnable &= ~(ui32IntFlags & 0xFFFF);
+
+    leave(key);
+}
+
+void AESIntClear(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    uintptr_t key = enter();
+
+    dtheRis[ENGINE_AES] &= ~DTHE_BITS(ui32IntFlags);
+
+    leave(key);
+}
+
+void AESDMAEnable(uint32_t ui32Base, uint32_t ui32Flags)
+{
+    uintptr_t key = enter();
+
+    aes.dmaEnable |= ui32Flags;
+
+    leave(key);
+}
+
+void AESDMADisable(uint32_t ui32Base, uint32_t ui32Flags)
+{
+    uintptr_t key = enter();
+
+    aes.dmaEnable &= ~ui32Flags;
+
+    leave(key);
+}
+
+/* ================================ DES ================================ */
+
+void DESConfigSet(uint32_t ui32Base, uint32_t ui32Config)
+{
+    uintptr_t key = enter();
+
+    cipherCheckIdle(&des);
+    des.config = ui32Config;
+    DTHEHost_counters.cpuWords++;
+
+    leave(key);
+}
+
+void DESKeySet(uint32_t ui32Base, uint8_t *pui8Key)
+{
+    uintptr_t key = enter();
+    uint32_t  size = (des.config & DES_CFG_TRIPLE) ? 24 : 8;
+
+    cipherCheckIdle(&des);
+    memcpy(des.key, pui8Key, size);
+    DTHEHost_counters.cpuWords += words(size);
+
+    leave(key);
+}
+
+bool DESIVSet(uint32_t ui32Base, uint8_t *pui8IVdata)
+{
+    uintptr_t key = enter();
+    bool      ready = !des.busy && !stalled;
+
+    if (ready) {
+        memcpy(des.iv, pui8IVdata, CryptoRef_DES_BLOCK_SIZE);
+        DTHEHost_counters.cpuWords += 2;
+    }
+
+    leave(key);
+
+    return (ready);
+}
+
+void DESDataLengthSet(uint32_t ui32Base, uint32_t ui32Length)
+{
+    uintptr_t key = enter();
+
+    if (ui32Length % CryptoRef_DES_BLOCK_SIZE != 0) {
+        fail("DES length not a multiple of the block size");
+    }
+    cipherStart(&des, ui32Length);
+    DTHEHost_counters.cpuWords++;
+
+    leave(key);
+}
+
+bool DESDataProcess(uint32_t ui32Base, uint8_t *pui8Src, uint8_t *pui8Dest,
+    uint32_t ui32Length)
+{
+    uintptr_t key = enter();
+
+    if (ui32Length % CryptoRef_DES_BLOCK_SIZE != 0) {
+        fail("DES length not a multiple of the block size");
+    }
+    cipherProcess(&des, pui8Src, pui8Dest, ui32Length);
+
+    leave(key);
+
+    return (true);
+}
+
+uint32_t DESIntStatus(uint32_t ui32Base, bool bMasked)
+{
+    uintptr_t key = enter();
+    uint32_t  status = cipherStatus(&des, ENGINE_DES, bMasked);
+
+    leave(key);
+
+    return (status);
+}
+
+void DESIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    uintptr_t key = enter();
+
+    dtheIm[ENGINE_DES] &= ~DTHE_BITS(ui32IntFlags);
+    des.irqEnable |= ui32IntFlags & 0xFFFF;
+
+    leave(key);
+}
+
+/* As driverlib, which masks the uDMA events in the AES mask register */
+void DESIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    uintptr_t key = enter();
+
+    dtheIm[ENGINE_AES] |= DTHE_BITS(ui32IntFlags);
+    des.irqEnable &= ~(ui32IntFlags & 0xFFFF);
+
+    leave(key);
+}
+
+void DESIntClear(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    uintptr_t key = enter();
+
+    dtheRis[ENGINE_DES] &= ~DTHE_BITS(ui32IntFlags);
+
+    leave(key);
+}
+
+void DESDMAEnable(uint32_t ui32Base, uint32_t ui32Flags)
+{
+    uintptr_t key = enter();
+
+    des.dmaEnable |= ui32Flags;
+
+    leave(key);
+}
+
+void DESDMADisable(uint32_t ui32Base, uint32_t ui32Flags)
+{
+    uintptr_t key = enter();
+
+    des.dmaEnable &= ~ui32Flags;
+
+    leave(key);
+}
+
+/* ============================== SHAMD5 =============================== */
+
+void SHAMD5ConfigSet(uint32_t ui32Base, uint32_t ui32CryptoMode,
+    uint8_t algConstFlag, uint8_t closeHashFlag, uint8_t HMACKeyFlag,
+    uint8_t HMACOuterHashFlag)
+{
+    uintptr_t key = enter();
+
+    if (sha.active) {
+        fail("mode written during a pass");
+    }
+    SHA_REG(SHAMD5_O_MODE) = ui32CryptoMode |
+        ((algConstFlag & 0x1) << ALGO_CONSTANT_SHIFT) |
+        ((closeHashFlag & 0x1) << CLOSE_HASH_SHIFT) |
+        ((HMACKeyFlag & 0x1) << HMAC_KEY_PROC_SHIFT) |
+        ((HMACOuterHashFlag & 0x1) << HMAC_OUTER_HASH_SHIFT);
+    DTHEHost_counters.cpuWords++;
+
+    leave(key);
+}
+
+void SHAMD5HMACKeySet(uint32_t ui32Base, uint8_t *pui8Src)
+{
+    uintptr_t key = enter();
+
+    memcpy(&SHA_REG(SHAMD5_O_ODIGEST_A), pui8Src, CryptoRef_HASH_BLOCK_SIZE);
+    DTHEHost_counters.cpuWords += 16;
+
+    leave(key);
+}
+
+void SHAMD5DataLengthSet(uint32_t ui32Base, uint32_t ui32Length)
+{
+    uintptr_t key = enter();
+
+    shaStart(ui32Length);
+    DTHEHost_counters.cpuWords++;
+
+    leave(key);
+}
+
+void SHAMD5DataWriteMultiple(uint32_t ui32Base, uint8_t *pui8DataSrc,
+    uint32_t ui32DataLength)
+{
+    uintptr_t key = enter();
+
+    shaWrite(pui8DataSrc, ui32DataLength);
+    DTHEHost_counters.cpuWords += words(ui32DataLength);
+
+    leave(key);
+}
+
+void SHAMD5ResultRead(uint32_t ui32Base, uint8_t *pui8Dest)
+{
+    uintptr_t key = enter();
+    size_t    size = CryptoRef_digestSize(shaAlgo());
+
+    memcpy(pui8Dest, &SHA_REG(SHAMD5_O_IDIGEST_A), size);
+    DTHEHost_counters.cpuWords += words(size);
+
+    leave(key);
+}
+
+void SHAMD5ResultWrite(uint32_t ui32Base, uint8_t *pui8Src)
+{
+    uintptr_t key = enter();
+    size_t    size = CryptoRef_digestSize(shaAlgo());
+
+    memcpy(&SHA_REG(SHAMD5_O_IDIGEST_A), pui8Src, size);
+    DTHEHost_counters.cpuWords += words(size);
+
+    leave(key);
+}
+
+void SHAMD5ReadDigestCount(uint32_t ui32Base, uint32_t *count)
+{
+    uintptr_t key = enter();
+
+    *count = SHA_REG(SHAMD5_O_DIGEST_COUNT);
+    DTHEHost_counters.cpuWords++;
+
+    leave(key);
+}
+
+void SHAMD5WriteDigestCount(uint32_t ui32Base, uint32_t count)
+{
+    uintptr_t key = enter();
+
+    SHA_REG(SHAMD5_O_DIGEST_COUNT) = count;
+    DTHEHost_counters.cpuWords++;
+
+    leave(key);
+}
+
+uint32_t SHAMD5IntStatus(uint32_t ui32Base, bool bMasked)
+{
+    uintptr_t key = enter();
+    uint32_t  status;
+
+    if (bMasked) {
+        status = maskedStatus(ENGINE_SHA);
+    }
+    else {
+        status = shaStatus() | (dtheRis[ENGINE_SHA] << 16);
+    }
+
+    leave(key);
+
+    return (status);
+}
+
+void SHAMD5IntEnable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    uintptr_t key = enter();
+
+    dtheIm[ENGINE_SHA] &= ~DTHE_BITS(ui32IntFlags);
+    sha.irqEnable |= ui32IntFlags & 0xFFFF;
+
+    leave(key);
+}
+
+void SHAMD5IntDisable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    uintptr_t key = enter();
+
+    dtheIm[ENGINE_SHA] |= DTHE_BITS(ui32IntFlags);
+    sha.irqEnable &= ~(ui32IntFlags & 0xFFFF);
+
+    leave(key);
+}
+
+void SHAMD5IntClear(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    uintptr_t key = enter();
+
+    dtheRis[ENGINE_SHA] &= ~DTHE_BITS(ui32IntFlags);
+
+    leave(key);
+}
+
+void SHAMD5DMAEnable(uint32_t ui32Base)
+{
+    uintptr_t key = enter();
+
+    sha.dmaEnable = true;
+
+    leave(key);
+}
+
+void SHAMD5DMADisable(uint32_t ui32Base)
+{
+    uintptr_t key = enter();
+
+    sha.dmaEnable = false;
+
+    leave(key);
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== DTHE_host.h ========
+ *  Model of the CC32XX DTHE crypto engines (AES, DES and SHA/MD5) for the
+ *  host tests. The driverlib AES, DES and SHAMD5 functions act on the
+ *  model, which is fed by the CPU through them or by the uDMA model, and
+ *  raises INT_AES, INT_DES and INT_SHA like the device.
+ */
+
+#ifndef tests_cc32xx_DTHE_host__include
+#define tests_cc32xx_DTHE_host__include
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct DTHEHost_Counters {
+    uint32_t calls;         /* driverlib engine calls */
+    uint32_t cpuWords;      /* register words accessed by the CPU */
+    uint32_t interrupts;    /* engine interrupts raised */
+} DTHEHost_Counters;
+
+extern DTHEHost_Counters DTHEHost_counters;
+
+/* Connects the engines to the uDMA model; call before opening the driver */
+extern void DTHEHost_init(void);
+
+/* While stalled, no engine reports its context ready */
+extern void DTHEHost_stall(bool stall);
+
+#endif /* tests_cc32xx_DTHE_host__include */
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== Power_host.c ========
+ *  Power and PRCM for the host tests with the CC32XX peripheral models.
+ *  Constraints and dependencies are only counted, so that a test can check
+ *  that a driver releases everything it takes; notifications are never
+ *  sent, as the host never enters LPDS.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <ti/drivers/dpl/HwiP.h>
+
+#include <ti/drivers/Power.h>
+#include <ti/drivers/power/PowerCC32XX.h>
+
+#include <ti/devices/cc32xx/driverlib/prcm.h>
+
+#define NUM_CONSTRAINTS     (32)
+
+static int constraints[NUM_CONSTRAINTS];
+static int dependencies[PowerCC32XX_NUMRESOURCES];
+
+/*
+ *  ======== count ========
+ */
+static int_fast16_t count(int *counts, unsigned int num, unsigned int id,
+    int delta)
+{
+    uintptr_t key;
+
+    if (id >= num) {
+        return (Power_EINVALIDINPUT);
+    }
+
+    key = HwiP_disable();
+    counts[id] += delta;
+    if (counts[id] < 0) {
+        fprintf(stderr, "Power: %s %u released more than set\n",
+            (counts == constraints) ? "constraint" : "dependency", id);
+        abort();
+    }
+    HwiP_restore(key);
+
+    return (Power_SOK);
+}
+
+/*
+ *  ======== Power_getConstraintMask ========
+ */
+uint_fast32_t Power_getConstraintMask(void)
+{
+    uint_fast32_t mask = 0;
+    unsigned int  id;
+
+    for (id = 0; id < NUM_CONSTRAINTS; id++) {
+        if (constraints[id] != 0) {
+            mask |= 1U << id;
+        }
+    }
+
+    return (mask);
+}
+
+/*
+ *  ======== Power_getDependencyCount ========
+ */
+int_fast16_t Power_getDependencyCount(uint_fast16_t resourceId)
+{
+    if (resourceId >= PowerCC32XX_NUMRESOURCES) {
+        return (Power_EINVALIDINPUT);
+    }
+
+    return (dependencies[resourceId]);
+}
+
+/*
+ *  ======== Power_registerNotify ========
+ */
+int_fast16_t Power_registerNotify(Power_NotifyObj *pNotifyObj,
+    uint_fast16_t eventTypes, Power_NotifyFxn notifyFxn, uintptr_t clientArg)
+{
+    return (Power_SOK);
+}
+
+/*
+ *  ======== Power_releaseConstraint ========
+ */
+int_fast16_t Power_releaseConstraint(uint_fast16_t constraintId)
+{
+    return (count(constraints, NUM_CONSTRAINTS, constraintId, -1));
+}
+
+/*
+ *  ======== Power_releaseDependency ========
+ */
+int_fast16_t Power_releaseDependency(uint_fast16_t resourceId)
+{
+    return (count(dependencies, PowerCC32XX_NUMRESOURCES, resourceId, -1));
+}
+
+/*
+ *  ======== Power_setConstraint ========
+ */
+int_fast16_t Power_setConstraint(uint_fast16_t constraintId)
+{
+    return (count(constraints, NUM_CONSTRAINTS, constraintId, 1));
+}
+
+/*
+ *  ======== Power_setDependency ========
+ */
+int_fast16_t Power_setDependency(uint_fast16_t resourceId)
+{
+    return (count(dependencies, PowerCC32XX_NUMRESOURCES, resourceId, 1));
+}
+
+/*
+ *  ======== Power_unregisterNotify ========
+ */
+void Power_unregisterNotify(Power_NotifyObj *pNotifyObj)
+{
+}
+
+/*
+ *  ======== PRCMPeripheralReset ========
+ *  The peripheral models start out in their reset state and the drivers
+ *  under test reset a peripheral before its first use only.
+ */
+void PRCMPeripheralReset(unsigned long ulPeripheral)
+{
+}
@@ -0,0 +1,497 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== UDMA_host.c ========
+ *  Model of the uDMA controller behind the driverlib uDMA functions. Only
+ *  the primary control structures are modelled: basic and auto mode
+ *  transfers, which is what the drivers under test use.
+ *
+ *  A channel whose mapping belongs to a peripheral model moves one
+ *  arbitration burst each time the peripheral requests, and signals its
+ *  completion to the peripheral. A channel with a software mapping moves
+ *  everything on a software request, then raises its bit in the uDMA
+ *  interrupt status and posts INT_UDMA.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ti/drivers/dpl/HwiP.h>
+
+#include <ti/devices/cc32xx/inc/hw_types.h>
+#include <ti/devices/cc32xx/inc/hw_ints.h>
+#include <ti/devices/cc32xx/driverlib/udma.h>
+
+#include "UDMA_host.h"
+
+#define NUM_CHANNELS        (32)
+#define MAX_PERIPHERALS     (8)
+
+/* Peripheral registers; everything else is memory */
+#define IS_REGISTER(addr)   (((addr) >= 0x40000000) && ((addr) < 0x50000000))
+
+#define IS_SW_MAPPING(mapping)  (((mapping) >> 16) == 0x3)
+
+typedef struct Channel {
+    uint32_t  mapping;      /* assigned mapping */
+    uint32_t  control;      /* sizes, increments and arbitration */
+    uint32_t  mode;
+    uintptr_t src;
+    uintptr_t dst;
+    uint32_t  remaining;    /* items left to move */
+    uint32_t  attributes;
+    bool      enabled;
+    bool      requested;    /* software request pending */
+} Channel;
+
+UDMAHost_Counters UDMAHost_counters;
+
+static Channel   channels[NUM_CHANNELS];
+static uint32_t  intStatus;
+static bool      running;
+static const UDMAHost_Peripheral *peripherals[MAX_PERIPHERALS];
+static unsigned int numPeripherals;
+
+/*
+ *  ======== fail ========
+ */
+static void fail(const char *what)
+{
+    fprintf(stderr, "uDMA model: %s\n", what);
+    abort();
+}
+
+/*
+ *  ======== findPeripheral ========
+ */
+static const UDMAHost_Peripheral *findPeripheral(uint32_t mapping)
+{
+    unsigned int i;
+
+    for (i = 0; i < numPeripherals; i++) {
+        if (peripherals[i]->mapping == mapping) {
+            return (peripherals[i]);
+        }
+    }
+
+    return (NULL);
+}
+
+/*
+ *  ======== readItem ========
+ */
+static uint32_t readItem(const UDMAHost_Peripheral *peripheral,
+    uintptr_t addr, uint32_t size)
+{
+    uint32_t value = 0;
+
+    if (IS_REGISTER(addr)) {
+        if ((peripheral == NULL) || (size != 4)) {
+            fail("register read by a channel without a peripheral");
+        }
+        return (peripheral->read((uint32_t)addr));
+    }
+
+    memcpy(&value, (void *)addr, size);
+
+    return (value);
+}
+
+/*
+ *  ======== writeItem ========
+ */
+static void writeItem(const UDMAHost_Peripheral *peripheral, uintptr_t addr,
+    uint32_t size, uint32_t value)
+{
+    if (IS_REGISTER(addr)) {
+        if ((peripheral == NULL) || (size != 4)) {
+            fail("register write by a channel without a peripheral");
+        }
+        peripheral->write((uint32_t)addr, value);
+        return;
+    }
+
+    memcpy((void *)addr, &value, size);
+}
+
+/*
+ *  ======== move ========
+ *  Moves count items of the channel and advances its addresses.
+ */
+static void move(Channel *ch, const UDMAHost_Peripheral *peripheral,
+    uint32_t count)
+{
+    uint32_t size = 1U << ((ch->control >> 24) & 0x3);
+    uint32_t srcInc = (ch->control >> 26) & 0x3;
+    uint32_t dstInc = (ch->control >> 30) & 0x3;
+    uint32_t value;
+
+    if (((ch->control >> 28) & 0x3) != ((ch->control >> 24) & 0x3)) {
+        fail("source and destination sizes differ");
+    }
+
+    UDMAHost_counters.bursts++;
+    UDMAHost_counters.items += count;
+
+    while (count-- > 0) {
+        value = readItem(peripheral, ch->src, size);
+        writeItem(peripheral, ch->dst, size, value);
+        if (srcInc != 0x3) {
+            ch->src += 1U << srcInc;
+        }
+        if (dstInc != 0x3) {
+            ch->dst += 1U << dstInc;
+        }
+        ch->remaining--;
+    }
+}
+
+/*
+ *  ======== UDMAHost_addPeripheral ========
+ */
+void UDMAHost_addPeripheral(const UDMAHost_Peripheral *peripheral)
+{
+    if (findPeripheral(peripheral->mapping) != NULL) {
+        return;
+    }
+    if (numPeripherals == MAX_PERIPHERALS) {
+        fail("too many peripherals");
+    }
+    peripherals[numPeripherals++] = peripheral;
+}
+
+/*
+ *  ======== UDMAHost_run ========
+ *  Lower channel numbers are served first, as by the controller's fixed
+ *  priority. Peripheral callbacks may call back in; the outermost call
+ *  serves their requests.
+ */
+void UDMAHost_run(void)
+{
+    const UDMAHost_Peripheral *peripheral;
+    Channel  *ch;
+    uint32_t  burst;
+    uint32_t  channel;
+    bool      progress;
+
+    if (running) {
+        return;
+    }
+    running = true;
+
+    do {
+        progress = false;
+        for (channel = 0; channel < NUM_CHANNELS; channel++) {
+            ch = &channels[channel];
+            if (!ch->enabled || (ch->remaining == 0)) {
+                continue;
+            }
+
+            peripheral = IS_SW_MAPPING(ch->mapping) ? NULL :
+                findPeripheral(ch->mapping);
+            if (peripheral != NULL) {
+                if (!peripheral->request()) {
+                    continue;
+                }
+                burst = 1U << ((ch->control >> 14) & 0xF);
+            }
+            else {
+                if (!ch->requested) {
+                    continue;
+                }
+                ch->requested = false;
+                burst = (ch->mode == UDMA_MODE_AUTO) ? ch->remaining :
+                    (1U << ((ch->control >> 14) & 0xF));
+            }
+
+            move(ch, peripheral, (burst < ch->remaining) ? burst :
+                ch->remaining);
+            progress = true;
+
+            if (ch->remaining == 0) {
+                ch->enabled = false;
+                ch->mode = UDMA_MODE_STOP;
+                if (peripheral != NULL) {
+                    peripheral->done();
+                }
+                else {
+                    intStatus |= 1U << channel;
+                    HwiP_post(INT_UDMA);
+                }
+            }
+        }
+    } while (progress);
+
+    running = false;
+}
+
+/*
+ *  ======== uDMAEnable ========
+ */
+void uDMAEnable(void)
+{
+    UDMAHost_counters.calls++;
+}
+
+/*
+ *  ======== uDMADisable ========
+ */
+void uDMADisable(void)
+{
+    UDMAHost_counters.calls++;
+}
+
+/*
+ *  ======== uDMAErrorStatusGet ========
+ */
+unsigned long uDMAErrorStatusGet(void)
+{
+    UDMAHost_counters.calls++;
+
+    return (0);
+}
+
+/*
+ *  ======== uDMAErrorStatusClear ========
+ */
+void uDMAErrorStatusClear(void)
+{
+    UDMAHost_counters.calls++;
+}
+
+/*
+ *  ======== uDMAControlBaseSet ========
+ */
+void uDMAControlBaseSet(void *pControlTable)
+{
+    UDMAHost_counters.calls++;
+
+    if (((uintptr_t)pControlTable & 0x3FF) != 0) {
+        fail("control table not aligned on 1024 bytes");
+    }
+}
+
+/*
+ *  ======== uDMAChannelAssign ========
+ */
+void uDMAChannelAssign(unsigned long ulMapping)
+{
+    uintptr_t key = HwiP_disable();
+
+    UDMAHost_counters.calls++;
+
+    channels[ulMapping & 0x1F].mapping = (uint32_t)ulMapping;
+    UDMAHost_run();
+
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== uDMAChannelAttributeEnable ========
+ */
+void uDMAChannelAttributeEnable(unsigned long ulChannelNum,
+    unsigned long ulAttr)
+{
+    UDMAHost_counters.calls++;
+
+    if (ulAttr & UDMA_ATTR_ALTSELECT) {
+        fail("alternate control structures are not modelled");
+    }
+    channels[ulChannelNum & 0x1F].attributes |= ulAttr;
+}
+
+/*
+ *  ======== uDMAChannelAttributeDisable ========
+ */
+void uDMAChannelAttributeDisable(unsigned long ulChannelNum,
+    unsigned long ulAttr)
+{
+    UDMAHost_counters.calls++;
+
+    channels[ulChannelNum & 0x1F].attributes &= ~ulAttr;
+}
+
+/*
+ *  ======== uDMAChannelAttributeGet ========
+ */
+unsigned long uDMAChannelAttributeGet(unsigned long ulChannelNum)
+{
+    UDMAHost_counters.calls++;
+
+    return (channels[ulChannelNum & 0x1F].attributes);
+}
+
+/*
+ *  ======== uDMAChannelControlSet ========
+ */
+void uDMAChannelControlSet(unsigned long ulChannelStructIndex,
+    unsigned long ulControl)
+{
+    UDMAHost_counters.calls++;
+
+    if (ulChannelStructIndex & UDMA_ALT_SELECT) {
+        fail("alternate control structures are not modelled");
+    }
+    channels[ulChannelStructIndex & 0x1F].control = (uint32_t)ulControl;
+}
+
+/*
+ *  ======== uDMAChannelTransferSet ========
+ */
+void uDMAChannelTransferSet(unsigned long ulChannelStructIndex,
+    unsigned long ulMode, void *pvSrcAddr, void *pvDstAddr,
+    unsigned long ulTransferSize)
+{
+    Channel *ch = &channels[ulChannelStructIndex & 0x1F];
+
+    UDMAHost_counters.calls++;
+
+    if (ulChannelStructIndex & UDMA_ALT_SELECT) {
+        fail("alternate control structures are not modelled");
+    }
+    if ((ulMode != UDMA_MODE_BASIC) && (ulMode != UDMA_MODE_AUTO)) {
+        fail("only basic and auto mode are modelled");
+    }
+    if ((ulTransferSize == 0) || (ulTransferSize > 1024)) {
+        fail("transfer size out of range");
+    }
+
+    ch->mode = (uint32_t)ulMode;
+    ch->src = (uintptr_t)pvSrcAddr;
+    ch->dst = (uintptr_t)pvDstAddr;
+    ch->remaining = (uint32_t)ulTransferSize;
+}
+
+/*
+ *  ======== uDMAChannelScatterGatherSet ========
+ */
+void uDMAChannelScatterGatherSet(unsigned long ulChannelNum,
+    unsigned ulTaskCount, void *pvTaskList, unsigned long ulIsPeriphSG)
+{
+    UDMAHost_counters.calls++;
+
+    fail("scatter-gather is not modelled");
+}
+
+/*
+ *  ======== uDMAChannelSizeGet ========
+ */
+unsigned long uDMAChannelSizeGet(unsigned long ulChannelStructIndex)
+{
+    UDMAHost_counters.calls++;
+
+    return (channels[ulChannelStructIndex & 0x1F].remaining);
+}
+
+/*
+ *  ======== uDMAChannelModeGet ========
+ */
+unsigned long uDMAChannelModeGet(unsigned long ulChannelStructIndex)
+{
+    UDMAHost_counters.calls++;
+
+    return (channels[ulChannelStructIndex & 0x1F].mode);
+}
+
+/*
+ *  ======== uDMAChannelEnable ========
+ */
+void uDMAChannelEnable(unsigned long ulChannelNum)
+{
+    uintptr_t key = HwiP_disable();
+
+    UDMAHost_counters.calls++;
+
+    channels[ulChannelNum & 0x1F].enabled = true;
+    UDMAHost_run();
+
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== uDMAChannelDisable ========
+ */
+void uDMAChannelDisable(unsigned long ulChannelNum)
+{
+    UDMAHost_counters.calls++;
+
+    channels[ulChannelNum & 0x1F].enabled = false;
+}
+
+/*
+ *  ======== uDMAChannelIsEnabled ========
+ */
+tBoolean uDMAChannelIsEnabled(unsigned long ulChannelNum)
+{
+    UDMAHost_counters.calls++;
+
+    return (channels[ulChannelNum & 0x1F].enabled);
+}
+
+/*
+ *  ======== uDMAChannelRequest ========
+ */
+void uDMAChannelRequest(unsigned long ulChannelNum)
+{
+    uintptr_t key = HwiP_disable();
+
+    UDMAHost_counters.calls++;
+
+    channels[ulChannelNum & 0x1F].requested = true;
+    UDMAHost_run();
+
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== uDMAIntStatus ========
+ */
+unsigned long uDMAIntStatus(void)
+{
+    UDMAHost_counters.calls++;
+
+    return (intStatus);
+}
+
+/*
+ *  ======== uDMAIntClear ========
+ */
+void uDMAIntClear(unsigned long ulChanMask)
+{
+    UDMAHost_counters.calls++;
+
+    intStatus &= ~ulChanMask;
+}
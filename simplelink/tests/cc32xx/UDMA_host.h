@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== UDMA_host.h ========
+ *  uDMA controller model for the host tests: the driverlib uDMA functions
+ *  act on a model of the channels, which move data between memory and the
+ *  peripheral models as the peripherals request it.
+ */
+
+#ifndef tests_cc32xx_UDMA_host__include
+#define tests_cc32xx_UDMA_host__include
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ *  A peripheral model behind one channel mapping. Transfers on a channel
+ *  assigned this mapping move one burst whenever request() returns true,
+ *  read and write the peripheral's registers through read() and write(),
+ *  and call done() when the channel completes.
+ */
+typedef struct UDMAHost_Peripheral {
+    uint32_t mapping;
+    bool     (*request)(void);
+    uint32_t (*read)(uint32_t addr);
+    void     (*write)(uint32_t addr, uint32_t value);
+    void     (*done)(void);
+} UDMAHost_Peripheral;
+
+typedef struct UDMAHost_Counters {
+    uint32_t calls;         /* driverlib uDMA calls */
+    uint32_t bursts;        /* arbitration bursts moved */
+    uint32_t items;         /* items moved */
+} UDMAHost_Counters;
+
+extern UDMAHost_Counters UDMAHost_counters;
+
+/* Adds a peripheral; peripherals are static and are never removed */
+extern void UDMAHost_addPeripheral(const UDMAHost_Peripheral *peripheral);
+
+/*
+ *  Serves the pending requests of the enabled channels. The driverlib
+ *  functions call it after each change; peripheral models call it when
+ *  their requests may have changed. Called with interrupts disabled.
+ */
+extern void UDMAHost_run(void);
+
+#endif /* tests_cc32xx_UDMA_host__include */
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== ClockP_host.c ========
+ *  ClockP time keeping for the host tests. Clock objects are not
+ *  supported; the system tick is ClockP_tickPeriod microseconds of
+ *  CLOCK_MONOTONIC and the timestamp counts nanoseconds.
+ */
+
+#include <stdint.h>
+#include <time.h>
+
+#include <ti/drivers/dpl/ClockP.h>
+
+uint32_t ClockP_tickPeriod = 1000;
+
+static uint64_t nowNsec(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (((uint64_t)now.tv_sec * 1000000000U) + now.tv_nsec);
+}
+
+/*
+ *  ======== ClockP_getCpuFreq ========
+ */
+void ClockP_getCpuFreq(ClockP_FreqHz *freq)
+{
+    ClockP_getTimestampFreq(freq);
+}
+
+/*
+ *  ======== ClockP_getSystemTickPeriod ========
+ */
+uint32_t ClockP_getSystemTickPeriod()
+{
+    return (ClockP_tickPeriod);
+}
+
+/*
+ *  ======== ClockP_getSystemTicks ========
+ */
+uint32_t ClockP_getSystemTicks()
+{
+    return ((uint32_t)(nowNsec() / (ClockP_tickPeriod * 1000U)));
+}
+
+/*
+ *  ======== ClockP_getTimestamp ========
+ */
+uint32_t ClockP_getTimestamp(void)
+{
+    return ((uint32_t)nowNsec());
+}
+
+/*
+ *  ======== ClockP_getTimestampFreq ========
+ */
+void ClockP_getTimestampFreq(ClockP_FreqHz *freq)
+{
+    freq->hi = 0;
+    freq->lo = 1000000000U;
+}
+
+/*
+ *  ======== ClockP_sleep ========
+ */
+void ClockP_sleep(uint32_t sec)
+{
+    struct timespec delay = {sec, 0};
+
+    nanosleep(&delay, NULL);
+}
+
+/*
+ *  ======== ClockP_usleep ========
+ */
+void ClockP_usleep(uint32_t usec)
+{
+    struct timespec delay = {usec / 1000000U, (usec % 1000000U) * 1000U};
+
+    nanosleep(&delay, NULL);
+}
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== HwiP_host.c ========
+ *  HwiP for the host tests.
+ *
+ *  HwiP_disable() takes one recursive process wide lock, which gives the
+ *  same mutual exclusion as masking interrupts on a single core. Interrupt
+ *  functions are only run when a test or a peripheral model calls
+ *  HwiP_post(), and are run with the lock held like a real ISR. An
+ *  interrupt posted while the posting thread has interrupts disabled, or
+ *  from an interrupt function, is held pending and runs at the outermost
+ *  HwiP_restore() or when the interrupt function returns, as it would on
+ *  the device.
+ */
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ti/drivers/dpl/HwiP.h>
+
+#define HOST_NUM_INTERRUPTS (256)
+
+typedef struct HwiP_Obj {
+    HwiP_Fxn  fxn;
+    uintptr_t arg;
+    int       intNum;
+} HwiP_Obj;
+
+int HwiP_swiPIntNum = 0;
+
+static pthread_mutex_t lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static HwiP_Obj       *vectors[HOST_NUM_INTERRUPTS];
+static bool            enabled[HOST_NUM_INTERRUPTS];
+static bool            pending[HOST_NUM_INTERRUPTS];
+static int             pendingCount;
+static __thread int    isrNesting;
+static __thread int    disableNesting;
+
+/*
+ *  ======== deliver ========
+ *  Runs the pending interrupts that are enabled, including those posted
+ *  by the interrupt functions themselves. Called with the lock held and
+ *  interrupts enabled.
+ */
+static void deliver(void)
+{
+    HwiP_Obj *obj;
+    int       intNum;
+    bool      ran;
+
+    do {
+        ran = false;
+        for (intNum = 0; (pendingCount > 0) && (intNum < HOST_NUM_INTERRUPTS);
+            intNum++) {
+            obj = vectors[intNum];
+            if (!pending[intNum] || (obj == NULL) || !enabled[intNum]) {
+                continue;
+            }
+            pending[intNum] = false;
+            pendingCount--;
+
+            isrNesting++;
+            obj->fxn(obj->arg);
+            isrNesting--;
+            ran = true;
+        }
+    } while (ran);
+}
+
+/*
+ *  ======== HwiP_clearInterrupt ========
+ */
+void HwiP_clearInterrupt(int interruptNum)
+{
+    pthread_mutex_lock(&lock);
+
+    if (pending[interruptNum]) {
+        pending[interruptNum] = false;
+        pendingCount--;
+    }
+
+    pthread_mutex_unlock(&lock);
+}
+
+/*
+ *  ======== HwiP_construct ========
+ */
+HwiP_Handle HwiP_construct(HwiP_Struct *hwiP, int interruptNum,
+    HwiP_Fxn hwiFxn, HwiP_Params *params)
+{
+    HwiP_Obj   *obj = (HwiP_Obj *)hwiP;
+    HwiP_Params defaultParams;
+
+    if (params == NULL) {
+        HwiP_Params_init(&defaultParams);
+        params = &defaultParams;
+    }
+
+    obj->fxn = hwiFxn;
+    obj->arg = params->arg;
+    obj->intNum = interruptNum;
+
+    vectors[interruptNum] = obj;
+    enabled[interruptNum] = params->enableInt;
+
+    return ((HwiP_Handle)obj);
+}
+
+/*
+ *  ======== HwiP_create ========
+ */
+HwiP_Handle HwiP_create(int interruptNum, HwiP_Fxn hwiFxn,
+    HwiP_Params *params)
+{
+    HwiP_Struct *hwiP = malloc(sizeof(HwiP_Struct));
+
+    if (hwiP == NULL) {
+        return (NULL);
+    }
+
+    return (HwiP_construct(hwiP, interruptNum, hwiFxn, params));
+}
+
+/*
+ *  ======== HwiP_delete ========
+ */
+void HwiP_delete(HwiP_Handle handle)
+{
+    HwiP_destruct((HwiP_Struct *)handle);
+    free(handle);
+}
+
+/*
+ *  ======== HwiP_destruct ========
+ */
+void HwiP_destruct(HwiP_Struct *hwiP)
+{
+    HwiP_Obj *obj = (HwiP_Obj *)hwiP;
+
+    if (vectors[obj->intNum] == obj) {
+        vectors[obj->intNum] = NULL;
+        enabled[obj->intNum] = false;
+    }
+}
+
+/*
+ *  ======== HwiP_disable ========
+ */
+uintptr_t HwiP_disable(void)
+{
+    pthread_mutex_lock(&lock);
+    disableNesting++;
+
+    return (0);
+}
+
+/*
+ *  ======== HwiP_disableInterrupt ========
+ */
+void HwiP_disableInterrupt(int interruptNum)
+{
+    enabled[interruptNum] = false;
+}
+
+/*
+ *  ======== HwiP_enable ========
+ */
+void HwiP_enable(void)
+{
+}
+
+/*
+ *  ======== HwiP_enableInterrupt ========
+ *  An interrupt posted while disabled runs once it is enabled.
+ */
+void HwiP_enableInterrupt(int interruptNum)
+{
+    pthread_mutex_lock(&lock);
+
+    enabled[interruptNum] = true;
+    if ((disableNesting == 0) && (isrNesting == 0)) {
+        deliver();
+    }
+
+    pthread_mutex_unlock(&lock);
+}
+
+/*
+ *  ======== HwiP_inISR ========
+ */
+bool HwiP_inISR(void)
+{
+    return (isrNesting != 0);
+}
+
+/*
+ *  ======== HwiP_Params_init ========
+ */
+void HwiP_Params_init(HwiP_Params *params)
+{
+    params->arg = 0;
+    params->priority = ~0;
+    params->enableInt = true;
+}
+
+/*
+ *  ======== HwiP_post ========
+ */
+void HwiP_post(int interruptNum)
+{
+    pthread_mutex_lock(&lock);
+
+    if (!pending[interruptNum]) {
+        pending[interruptNum] = true;
+        pendingCount++;
+    }
+    if ((disableNesting == 0) && (isrNesting == 0)) {
+        deliver();
+    }
+
+    pthread_mutex_unlock(&lock);
+}
+
+/*
+ *  ======== HwiP_restore ========
+ */
+void HwiP_restore(uintptr_t key)
+{
+    (void)key;
+
+    if ((--disableNesting == 0) && (isrNesting == 0)) {
+        deliver();
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+/*
+ *  ======== HwiP_setFunc ========
+ */
+void HwiP_setFunc(HwiP_Handle hwiP, HwiP_Fxn fxn, uintptr_t arg)
+{
+    HwiP_Obj *obj = (HwiP_Obj *)hwiP;
+    uintptr_t key = HwiP_disable();
+
+    obj->fxn = fxn;
+    obj->arg = arg;
+
+    HwiP_restore(key);
+}
+
+/*
+ *  ======== HwiP_setPriority ========
+ */
+void HwiP_setPriority(int interruptNum, uint32_t priority)
+{
+    (void)interruptNum;
+    (void)priority;
+}
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== SemaphoreP_host.c ========
+ *  SemaphoreP for the host tests, on POSIX threads. Timeouts are in
+ *  ClockP ticks of ClockP_tickPeriod microseconds.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <ti/drivers/dpl/ClockP.h>
+#include <ti/drivers/dpl/SemaphoreP.h>
+
+typedef struct SemaphoreP_Obj {
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    unsigned int    count;
+    unsigned int    limit;
+} SemaphoreP_Obj;
+
+SemaphoreP_Params SemaphoreP_defaultParams = {
+    .mode = SemaphoreP_Mode_COUNTING,
+    .callback = NULL,
+};
+
+/*
+ *  ======== SemaphoreP_construct ========
+ *  A pthread semaphore does not fit in a SemaphoreP_Struct, so the struct
+ *  only holds a pointer to one.
+ */
+SemaphoreP_Handle SemaphoreP_construct(SemaphoreP_Struct *handle,
+    unsigned int count, SemaphoreP_Params *params)
+{
+    SemaphoreP_Handle sem;
+
+    if (params == NULL) {
+        params = &SemaphoreP_defaultParams;
+    }
+
+    if (params->mode == SemaphoreP_Mode_BINARY) {
+        sem = SemaphoreP_createBinary(count);
+    }
+    else {
+        sem = SemaphoreP_create(count, params);
+    }
+
+    *(SemaphoreP_Handle *)handle = sem;
+
+    return (sem);
+}
+
+/*
+ *  ======== SemaphoreP_constructBinary ========
+ */
+SemaphoreP_Handle SemaphoreP_constructBinary(SemaphoreP_Struct *handle,
+    unsigned int count)
+{
+    SemaphoreP_Handle sem = SemaphoreP_createBinary(count);
+
+    *(SemaphoreP_Handle *)handle = sem;
+
+    return (sem);
+}
+
+/*
+ *  ======== SemaphoreP_create ========
+ */
+SemaphoreP_Handle SemaphoreP_create(unsigned int count,
+    SemaphoreP_Params *params)
+{
+    SemaphoreP_Obj *obj = malloc(sizeof(SemaphoreP_Obj));
+
+    if (obj == NULL) {
+        return (NULL);
+    }
+
+    pthread_mutex_init(&obj->mutex, NULL);
+    pthread_cond_init(&obj->cond, NULL);
+    obj->count = count;
+    obj->limit = ~0U;
+
+    if ((params != NULL) && (params->mode == SemaphoreP_Mode_BINARY)) {
+        obj->limit = 1;
+        if (obj->count > 1) {
+            obj->count = 1;
+        }
+    }
+
+    return ((SemaphoreP_Handle)obj);
+}
+
+/*
+ *  ======== SemaphoreP_createBinary ========
+ */
+SemaphoreP_Handle SemaphoreP_createBinary(unsigned int count)
+{
+    SemaphoreP_Params params;
+
+    SemaphoreP_Params_init(&params);
+    params.mode = SemaphoreP_Mode_BINARY;
+
+    return (SemaphoreP_create(count, &params));
+}
+
+/*
+ *  ======== SemaphoreP_delete ========
+ */
+void SemaphoreP_delete(SemaphoreP_Handle handle)
+{
+    SemaphoreP_Obj *obj = (SemaphoreP_Obj *)handle;
+
+    pthread_cond_destroy(&obj->cond);
+    pthread_mutex_destroy(&obj->mutex);
+    free(obj);
+}
+
+/*
+ *  ======== SemaphoreP_destruct ========
+ */
+void SemaphoreP_destruct(SemaphoreP_Struct *semP)
+{
+    SemaphoreP_delete(*(SemaphoreP_Handle *)semP);
+}
+
+/*
+ *  ======== SemaphoreP_Params_init ========
+ */
+void SemaphoreP_Params_init(SemaphoreP_Params *params)
+{
+    *params = SemaphoreP_defaultParams;
+}
+
+/*
+ *  ======== SemaphoreP_pend ========
+ */
+SemaphoreP_Status SemaphoreP_pend(SemaphoreP_Handle handle, uint32_t timeout)
+{
+    SemaphoreP_Obj   *obj = (SemaphoreP_Obj *)handle;
+    SemaphoreP_Status status = SemaphoreP_OK;
+    struct timespec   deadline;
+    uint64_t          nsec;
+
+    if ((timeout != (uint32_t)SemaphoreP_WAIT_FOREVER) &&
+        (timeout != SemaphoreP_NO_WAIT)) {
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        nsec = (uint64_t)timeout * ClockP_tickPeriod * 1000U;
+        nsec += deadline.tv_nsec;
+        deadline.tv_sec += nsec / 1000000000U;
+        deadline.tv_nsec = nsec % 1000000000U;
+    }
+
+    pthread_mutex_lock(&obj->mutex);
+
+    while ((obj->count == 0) && (status == SemaphoreP_OK)) {
+        if (timeout == SemaphoreP_NO_WAIT) {
+            status = SemaphoreP_TIMEOUT;
+        }
+        else if (timeout == (uint32_t)SemaphoreP_WAIT_FOREVER) {
+            pthread_cond_wait(&obj->cond, &obj->mutex);
+        }
+        else if (pthread_cond_timedwait(&obj->cond, &obj->mutex,
+            &deadline) == ETIMEDOUT) {
+            status = (obj->count == 0) ? SemaphoreP_TIMEOUT : SemaphoreP_OK;
+        }
+    }
+
+    if (status == SemaphoreP_OK) {
+        obj->count--;
+    }
+
+    pthread_mutex_unlock(&obj->mutex);
+
+    return (status);
+}
+
+/*
+ *  ======== SemaphoreP_post ========
+ */
+void SemaphoreP_post(SemaphoreP_Handle handle)
+{
+    SemaphoreP_Obj *obj = (SemaphoreP_Obj *)handle;
+
+    pthread_mutex_lock(&obj->mutex);
+
+    if (obj->count < obj->limit) {
+        obj->count++;
+    }
+    pthread_cond_signal(&obj->cond);
+
+    pthread_mutex_unlock(&obj->mutex);
+}
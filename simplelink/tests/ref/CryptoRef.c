@@ -0,0 +1,844 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== CryptoRef.c ========
+ *  Reference implementations for the host tests: FIPS-197 AES, FIPS 46-3
+ *  DES and triple DES, RFC 1321 MD5, FIPS 180-4 SHA-1, SHA-224 and SHA-256,
+ *  and RFC 2104 HMAC.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "CryptoRef.h"
+
+/* ================================ AES ================================ */
+
+static uint8_t aesSbox[256];
+static uint8_t aesInvSbox[256];
+static bool    aesReady = false;
+
+/*
+ *  ======== aesMul ========
+ *  Multiplication in GF(2^8) modulo x^8 + x^4 + x^3 + x + 1.
+ */
+static uint8_t aesMul(uint8_t a, uint8_t b)
+{
+    uint8_t p = 0;
+
+    while (b != 0) {
+        if (b & 1) {
+            p ^= a;
+        }
+        a = (uint8_t)((a << 1) ^ ((a & 0x80) ? 0x1B : 0));
+        b >>= 1;
+    }
+
+    return (p);
+}
+
+/*
+ *  ======== aesInit ========
+ *  Builds the S-box from its definition: the multiplicative inverse
+ *  followed by the affine transformation.
+ */
+static void aesInit(void)
+{
+    unsigned int x;
+    unsigned int y;
+    uint8_t      inv;
+    uint8_t      s;
+    int          i;
+
+    for (x = 0; x < 256; x++) {
+        inv = 0;
+        for (y = 1; (x != 0) && (y < 256); y++) {
+            if (aesMul((uint8_t)x, (uint8_t)y) == 1) {
+                inv = (uint8_t)y;
+                break;
+            }
+        }
+        s = inv;
+        for (i = 1; i <= 4; i++) {
+            s ^= (uint8_t)((inv << i) | (inv >> (8 - i)));
+        }
+        s ^= 0x63;
+        aesSbox[x] = s;
+        aesInvSbox[s] = (uint8_t)x;
+    }
+
+    aesReady = true;
+}
+
+/*
+ *  ======== aesSubWord ========
+ */
+static uint32_t aesSubWord(uint32_t w)
+{
+    return (((uint32_t)aesSbox[w >> 24] << 24) |
+            ((uint32_t)aesSbox[(w >> 16) & 0xFF] << 16) |
+            ((uint32_t)aesSbox[(w >> 8) & 0xFF] << 8) |
+            aesSbox[w & 0xFF]);
+}
+
+/*
+ *  ======== aesAddRoundKey ========
+ */
+static void aesAddRoundKey(uint8_t *state, const uint32_t *rk)
+{
+    int c;
+
+    for (c = 0; c < 4; c++) {
+        state[4 * c]     ^= (uint8_t)(rk[c] >> 24);
+        state[4 * c + 1] ^= (uint8_t)(rk[c] >> 16);
+        state[4 * c + 2] ^= (uint8_t)(rk[c] >> 8);
+        state[4 * c + 3] ^= (uint8_t)rk[c];
+    }
+}
+
+/*
+ *  ======== aesMixColumns ========
+ *  Multiplies each column by the matrix whose first row is m.
+ */
+static void aesMixColumns(uint8_t *state, const uint8_t *m)
+{
+    uint8_t col[4];
+    int     c;
+    int     r;
+
+    for (c = 0; c < 4; c++) {
+        memcpy(col, &state[4 * c], 4);
+        for (r = 0; r < 4; r++) {
+            state[4 * c + r] = aesMul(col[r], m[0]) ^
+                aesMul(col[(r + 1) & 3], m[1]) ^
+                aesMul(col[(r + 2) & 3], m[2]) ^
+                aesMul(col[(r + 3) & 3], m[3]);
+        }
+    }
+}
+
+/*
+ *  ======== CryptoRef_aesSetKey ========
+ */
+void CryptoRef_aesSetKey(CryptoRef_AesKey *key, const uint8_t *bytes,
+    size_t keyLen)
+{
+    int      nk = (int)(keyLen / 4);
+    int      words;
+    int      i;
+    uint8_t  rcon = 1;
+    uint32_t temp;
+
+    if (!aesReady) {
+        aesInit();
+    }
+
+    key->rounds = nk + 6;
+    words = 4 * (key->rounds + 1);
+
+    for (i = 0; i < nk; i++) {
+        key->rk[i] = ((uint32_t)bytes[4 * i] << 24) |
+            ((uint32_t)bytes[4 * i + 1] << 16) |
+            ((uint32_t)bytes[4 * i + 2] << 8) | bytes[4 * i + 3];
+    }
+    for (i = nk; i < words; i++) {
+        temp = key->rk[i - 1];
+        if ((i % nk) == 0) {
+            temp = aesSubWord((temp << 8) | (temp >> 24)) ^
+                ((uint32_t)rcon << 24);
+            rcon = aesMul(rcon, 2);
+        }
+        else if ((nk > 6) && ((i % nk) == 4)) {
+            temp = aesSubWord(temp);
+        }
+        key->rk[i] = key->rk[i - nk] ^ temp;
+    }
+}
+
+/*
+ *  ======== CryptoRef_aesEncrypt ========
+ */
+void CryptoRef_aesEncrypt(const CryptoRef_AesKey *key, const uint8_t *in,
+    uint8_t *out)
+{
+    static const uint8_t mix[4] = {2, 3, 1, 1};
+    uint8_t state[16];
+    uint8_t t[16];
+    int     round;
+    int     i;
+
+    memcpy(state, in, 16);
+    aesAddRoundKey(state, &key->rk[0]);
+
+    for (round = 1; round <= key->rounds; round++) {
+        /* SubBytes and ShiftRows: row r moves left by r columns */
+        for (i = 0; i < 16; i++) {
+            t[i] = aesSbox[state[(i + 4 * (i & 3)) & 15]];
+        }
+        memcpy(state, t, 16);
+        if (round != key->rounds) {
+            aesMixColumns(state, mix);
+        }
+        aesAddRoundKey(state, &key->rk[4 * round]);
+    }
+
+    memcpy(out, state, 16);
+}
+
+/*
+ *  ======== CryptoRef_aesDecrypt ========
+ */
+void CryptoRef_aesDecrypt(const CryptoRef_AesKey *key, const uint8_t *in,
+    uint8_t *out)
+{
+    static const uint8_t invMix[4] = {14, 11, 13, 9};
+    uint8_t state[16];
+    uint8_t t[16];
+    int     round;
+    int     i;
+
+    memcpy(state, in, 16);
+    aesAddRoundKey(state, &key->rk[4 * key->rounds]);
+
+    for (round = key->rounds - 1; round >= 0; round--) {
+        /* InvShiftRows and InvSubBytes: row r moves right by r columns */
+        for (i = 0; i < 16; i++) {
+            t[i] = aesInvSbox[state[(i - 4 * (i & 3)) & 15]];
+        }
+        memcpy(state, t, 16);
+        aesAddRoundKey(state, &key->rk[4 * round]);
+        if (round != 0) {
+            aesMixColumns(state, invMix);
+        }
+    }
+
+    memcpy(out, state, 16);
+}
+
+/* ================================ DES ================================ */
+
+static const uint8_t desIP[64] = {
+    58, 50, 42, 34, 26, 18, 10, 2, 60, 52, 44, 36, 28, 20, 12, 4,
+    62, 54, 46, 38, 30, 22, 14, 6, 64, 56, 48, 40, 32, 24, 16, 8,
+    57, 49, 41, 33, 25, 17,  9, 1, 59, 51, 43, 35, 27, 19, 11, 3,
+    61, 53, 45, 37, 29, 21, 13, 5, 63, 55, 47, 39, 31, 23, 15, 7
+};
+
+static const uint8_t desFP[64] = {
+    40, 8, 48, 16, 56, 24, 64, 32, 39, 7, 47, 15, 55, 23, 63, 31,
+    38, 6, 46, 14, 54, 22, 62, 30, 37, 5, 45, 13, 53, 21, 61, 29,
+    36, 4, 44, 12, 52, 20, 60, 28, 35, 3, 43, 11, 51, 19, 59, 27,
+    34, 2, 42, 10, 50, 18, 58, 26, 33, 1, 41,  9, 49, 17, 57, 25
+};
+
+static const uint8_t desE[48] = {
+    32,  1,  2,  3,  4,  5,  4,  5,  6,  7,  8,  9,
+     8,  9, 10, 11, 12, 13, 12, 13, 14, 15, 16, 17,
+    16, 17, 18, 19, 20, 21, 20, 21, 22, 23, 24, 25,
+    24, 25, 26, 27, 28, 29, 28, 29, 30, 31, 32,  1
+};
+
+static const uint8_t desP[32] = {
+    16,  7, 20, 21, 29, 12, 28, 17,  1, 15, 23, 26,  5, 18, 31, 10,
+     2,  8, 24, 14, 32, 27,  3,  9, 19, 13, 30,  6, 22, 11,  4, 25
+};
+
+static const uint8_t desPC1[56] = {
+    57, 49, 41, 33, 25, 17,  9,  1, 58, 50, 42, 34, 26, 18,
+    10,  2, 59, 51, 43, 35, 27, 19, 11,  3, 60, 52, 44, 36,
+    63, 55, 47, 39, 31, 23, 15,  7, 62, 54, 46, 38, 30, 22,
+    14,  6, 61, 53, 45, 37, 29, 21, 13,  5, 28, 20, 12,  4
+};
+
+static const uint8_t desPC2[48] = {
+    14, 17, 11, 24,  1,  5,  3, 28, 15,  6, 21, 10,
+    23, 19, 12,  4, 26,  8, 16,  7, 27, 20, 13,  2,
+    41, 52, 31, 37, 47, 55, 30, 40, 51, 45, 33, 48,
+    44, 49, 39, 56, 34, 53, 46, 42, 50, 36, 29, 32
+};
+
+static const uint8_t desShifts[16] = {
+    1, 1, 2, 2, 2, 2, 2, 2, 1, 2, 2, 2, 2, 2, 2, 1
+};
+
+static const uint8_t desS[8][64] = {
+    {
+        14,  4, 13,  1,  2, 15, 11,  8,  3, 10,  6, 12,  5,  9,  0,  7,
+         0, 15,  7,  4, 14,  2, 13,  1, 10,  6, 12, 11,  9,  5,  3,  8,
+         4,  1, 14,  8, 13,  6,  2, 11, 15, 12,  9,  7,  3, 10,  5,  0,
+        15, 12,  8,  2,  4,  9,  1,  7,  5, 11,  3, 14, 10,  0,  6, 13
+    },
+    {
+        15,  1,  8, 14,  6, 11,  3,  4,  9,  7,  2, 13, 12,  0,  5, 10,
+         3, 13,  4,  7, 15,  2,  8, 14, 12,  0,  1, 10,  6,  9, 11,  5,
+         0, 14,  7, 11, 10,  4, 13,  1,  5,  8, 12,  6,  9,  3,  2, 15,
+        13,  8, 10,  1,  3, 15,  4,  2, 11,  6,  7, 12,  0,  5, 14,  9
+    },
+    {
+        10,  0,  9, 14,  6,  3, 15,  5,  1, 13, 12,  7, 11,  4,  2,  8,
+        13,  7,  0,  9,  3,  4,  6, 10,  2,  8,  5, 14, 12, 11, 15,  1,
+        13,  6,  4,  9,  8, 15,  3,  0, 11,  1,  2, 12,  5, 10, 14,  7,
+         1, 10, 13,  0,  6,  9,  8,  7,  4, 15, 14,  3, 11,  5,  2, 12
+    },
+    {
+         7, 13, 14,  3,  0,  6,  9, 10,  1,  2,  8,  5, 11, 12,  4, 15,
+        13,  8, 11,  5,  6, 15,  0,  3,  4,  7,  2, 12,  1, 10, 14,  9,
+        10,  6,  9,  0, 12, 11,  7, 13, 15,  1,  3, 14,  5,  2,  8,  4,
+         3, 15,  0,  6, 10,  1, 13,  8,  9,  4,  5, 11, 12,  7,  2, 14
+    },
+    {
+         2, 12,  4,  1,  7, 10, 11,  6,  8,  5,  3, 15, 13,  0, 14,  9,
+        14, 11,  2, 12,  4,  7, 13,  1,  5,  0, 15, 10,  3,  9,  8,  6,
+         4,  2,  1, 11, 10, 13,  7,  8, 15,  9, 12,  5,  6,  3,  0, 14,
+        11,  8, 12,  7,  1, 14,  2, 13,  6, 15,  0,  9, 10,  4,  5,  3
+    },
+    {
+        12,  1, 10, 15,  9,  2,  6,  8,  0, 13,  3,  4, 14,  7,  5, 11,
+        10, 15,  4,  2,  7, 12,  9,  5,  6,  1, 13, 14,  0, 11,  3,  8,
+         9, 14, 15,  5,  2,  8, 12,  3,  7,  0,  4, 10,  1, 13, 11,  6,
+         4,  3,  2, 12,  9,  5, 15, 10, 11, 14,  1,  7,  6,  0,  8, 13
+    },
+    {
+         4, 11,  2, 14, 15,  0,  8, 13,  3, 12,  9,  7,  5, 10,  6,  1,
+        13,  0, 11,  7,  4,  9,  1, 10, 14,  3,  5, 12,  2, 15,  8,  6,
+         1,  4, 11, 13, 12,  3,  7, 14, 10, 15,  6,  8,  0,  5,  9,  2,
+         6, 11, 13,  8,  1,  4, 10,  7,  9,  5,  0, 15, 14,  2,  3, 12
+    },
+    {
+        13,  2,  8,  4,  6, 15, 11,  1, 10,  9,  3, 14,  5,  0, 12,  7,
+         1, 15, 13,  8, 10,  3,  7,  4, 12,  5,  6, 11,  0, 14,  9,  2,
+         7, 11,  4,  1,  9, 12, 14,  2,  0,  6, 10, 13, 15,  3,  5,  8,
+         2,  1, 14,  7,  4, 10,  8, 13, 15, 12,  9,  0,  3,  5,  6, 11
+    }
+};
+
+/*
+ *  ======== desPermute ========
+ *  Picks n bits of an inBits wide value; table entries count from 1 at
+ *  the most significant bit, as in the standard.
+ */
+static uint64_t desPermute(uint64_t in, const uint8_t *table, int n,
+    int inBits)
+{
+    uint64_t out = 0;
+    int      i;
+
+    for (i = 0; i < n; i++) {
+        out = (out << 1) | ((in >> (inBits - table[i])) & 1);
+    }
+
+    return (out);
+}
+
+/*
+ *  ======== desLoad ========
+ */
+static uint64_t desLoad(const uint8_t *bytes)
+{
+    uint64_t v = 0;
+    int      i;
+
+    for (i = 0; i < 8; i++) {
+        v = (v << 8) | bytes[i];
+    }
+
+    return (v);
+}
+
+/*
+ *  ======== desStore ========
+ */
+static void desStore(uint64_t v, uint8_t *bytes)
+{
+    int i;
+
+    for (i = 7; i >= 0; i--) {
+        bytes[i] = (uint8_t)v;
+        v >>= 8;
+    }
+}
+
+/*
+ *  ======== desSchedule ========
+ */
+static void desSchedule(uint64_t *subkeys, const uint8_t *bytes)
+{
+    uint64_t cd = desPermute(desLoad(bytes), desPC1, 56, 64);
+    uint32_t c = (uint32_t)(cd >> 28) & 0xFFFFFFF;
+    uint32_t d = (uint32_t)cd & 0xFFFFFFF;
+    int      i;
+
+    for (i = 0; i < 16; i++) {
+        c = ((c << desShifts[i]) | (c >> (28 - desShifts[i]))) & 0xFFFFFFF;
+        d = ((d << desShifts[i]) | (d >> (28 - desShifts[i]))) & 0xFFFFFFF;
+        subkeys[i] = desPermute(((uint64_t)c << 28) | d, desPC2, 48, 56);
+    }
+}
+
+/*
+ *  ======== desF ========
+ */
+static uint32_t desF(uint32_t r, uint64_t subkey)
+{
+    uint64_t x = desPermute(r, desE, 48, 32) ^ subkey;
+    uint32_t s = 0;
+    unsigned int six;
+    int      i;
+
+    for (i = 0; i < 8; i++) {
+        six = (unsigned int)(x >> (42 - 6 * i)) & 0x3F;
+        s = (s << 4) |
+            desS[i][((six & 0x20) | ((six & 1) << 4)) | ((six >> 1) & 0xF)];
+    }
+
+    return ((uint32_t)desPermute(s, desP, 32, 32));
+}
+
+/*
+ *  ======== desCrypt ========
+ *  One single DES pass with the subkeys in the given direction.
+ */
+static void desCrypt(const uint64_t *subkeys, bool decrypt,
+    const uint8_t *in, uint8_t *out)
+{
+    uint64_t block = desPermute(desLoad(in), desIP, 64, 64);
+    uint32_t l = (uint32_t)(block >> 32);
+    uint32_t r = (uint32_t)block;
+    uint32_t t;
+    int      i;
+
+    for (i = 0; i < 16; i++) {
+        t = r;
+        r = l ^ desF(r, subkeys[decrypt ? (15 - i) : i]);
+        l = t;
+    }
+
+    desStore(desPermute(((uint64_t)r << 32) | l, desFP, 64, 64), out);
+}
+
+/*
+ *  ======== CryptoRef_desSetKey ========
+ */
+void CryptoRef_desSetKey(CryptoRef_DesKey *key, const uint8_t *bytes,
+    bool triple)
+{
+    int i;
+
+    key->triple = triple;
+    for (i = 0; i < (triple ? 3 : 1); i++) {
+        desSchedule(key->subkeys[i], bytes + 8 * i);
+    }
+}
+
+/*
+ *  ======== CryptoRef_desEncrypt ========
+ *  Triple DES is EDE: encrypt with K1, decrypt with K2, encrypt with K3.
+ */
+void CryptoRef_desEncrypt(const CryptoRef_DesKey *key, const uint8_t *in,
+    uint8_t *out)
+{
+    desCrypt(key->subkeys[0], false, in, out);
+    if (key->triple) {
+        desCrypt(key->subkeys[1], true, out, out);
+        desCrypt(key->subkeys[2], false, out, out);
+    }
+}
+
+/*
+ *  ======== CryptoRef_desDecrypt ========
+ */
+void CryptoRef_desDecrypt(const CryptoRef_DesKey *key, const uint8_t *in,
+    uint8_t *out)
+{
+    if (key->triple) {
+        desCrypt(key->subkeys[2], true, in, out);
+        desCrypt(key->subkeys[1], false, out, out);
+        desCrypt(key->subkeys[0], true, out, out);
+    }
+    else {
+        desCrypt(key->subkeys[0], true, in, out);
+    }
+}
+
+/* =============================== Hashes ============================== */
+
+static const uint32_t md5T[64] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee,
+    0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+    0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa,
+    0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed,
+    0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+    0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05,
+    0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039,
+    0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+    0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+};
+
+static const uint8_t md5Shift[4][4] = {
+    {7, 12, 17, 22}, {5, 9, 14, 20}, {4, 11, 16, 23}, {6, 10, 15, 21}
+};
+
+static const uint32_t sha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t hashInit[4][8] = {
+    /* MD5 */
+    {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476},
+    /* SHA-1 */
+    {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0},
+    /* SHA-224 */
+    {0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939,
+     0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4},
+    /* SHA-256 */
+    {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+     0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19}
+};
+
+#define ROTL(x, n)  (((x) << (n)) | ((x) >> (32 - (n))))
+#define ROTR(x, n)  (((x) >> (n)) | ((x) << (32 - (n))))
+
+/*
+ *  ======== md5Block ========
+ */
+static void md5Block(uint32_t *state, const uint8_t *block)
+{
+    uint32_t m[16];
+    uint32_t a = state[0];
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+    uint32_t f;
+    uint32_t t;
+    int      g;
+    int      i;
+
+    for (i = 0; i < 16; i++) {
+        m[i] = block[4 * i] | ((uint32_t)block[4 * i + 1] << 8) |
+            ((uint32_t)block[4 * i + 2] << 16) |
+            ((uint32_t)block[4 * i + 3] << 24);
+    }
+
+    for (i = 0; i < 64; i++) {
+        switch (i / 16) {
+            case 0:
+                f = (b & c) | (~b & d);
+                g = i;
+                break;
+            case 1:
+                f = (d & b) | (~d & c);
+                g = (5 * i + 1) & 15;
+                break;
+            case 2:
+                f = b ^ c ^ d;
+                g = (3 * i + 5) & 15;
+                break;
+            default:
+                f = c ^ (b | ~d);
+                g = (7 * i) & 15;
+                break;
+        }
+        t = d;
+        d = c;
+        c = b;
+        f = a + f + md5T[i] + m[g];
+        b = b + ROTL(f, md5Shift[i / 16][i & 3]);
+        a = t;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+}
+
+/*
+ *  ======== sha1Block ========
+ */
+static void sha1Block(uint32_t *state, const uint8_t *block)
+{
+    uint32_t w[80];
+    uint32_t a = state[0];
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+    uint32_t e = state[4];
+    uint32_t f;
+    uint32_t k;
+    uint32_t t;
+    int      i;
+
+    for (i = 0; i < 16; i++) {
+        w[i] = ((uint32_t)block[4 * i] << 24) |
+            ((uint32_t)block[4 * i + 1] << 16) |
+            ((uint32_t)block[4 * i + 2] << 8) | block[4 * i + 3];
+    }
+    for (i = 16; i < 80; i++) {
+        t = w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16];
+        w[i] = ROTL(t, 1);
+    }
+
+    for (i = 0; i < 80; i++) {
+        if (i < 20) {
+            f = (b & c) | (~b & d);
+            k = 0x5a827999;
+        }
+        else if (i < 40) {
+            f = b ^ c ^ d;
+            k = 0x6ed9eba1;
+        }
+        else if (i < 60) {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8f1bbcdc;
+        }
+        else {
+            f = b ^ c ^ d;
+            k = 0xca62c1d6;
+        }
+        t = ROTL(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = ROTL(b, 30);
+        b = a;
+        a = t;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+}
+
+/*
+ *  ======== sha256Block ========
+ */
+static void sha256Block(uint32_t *state, const uint8_t *block)
+{
+    uint32_t w[64];
+    uint32_t v[8];
+    uint32_t t1;
+    uint32_t t2;
+    int      i;
+
+    for (i = 0; i < 16; i++) {
+        w[i] = ((uint32_t)block[4 * i] << 24) |
+            ((uint32_t)block[4 * i + 1] << 16) |
+            ((uint32_t)block[4 * i + 2] << 8) | block[4 * i + 3];
+    }
+    for (i = 16; i < 64; i++) {
+        t1 = ROTR(w[i - 2], 17) ^ ROTR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        t2 = ROTR(w[i - 15], 7) ^ ROTR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        w[i] = t1 + w[i - 7] + t2 + w[i - 16];
+    }
+
+    memcpy(v, state, sizeof(v));
+    for (i = 0; i < 64; i++) {
+        t1 = v[7] + (ROTR(v[4], 6) ^ ROTR(v[4], 11) ^ ROTR(v[4], 25)) +
+            ((v[4] & v[5]) ^ (~v[4] & v[6])) + sha256K[i] + w[i];
+        t2 = (ROTR(v[0], 2) ^ ROTR(v[0], 13) ^ ROTR(v[0], 22)) +
+            ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+        memmove(&v[1], &v[0], 7 * sizeof(uint32_t));
+        v[4] += t1;
+        v[0] = t1 + t2;
+    }
+
+    for (i = 0; i < 8; i++) {
+        state[i] += v[i];
+    }
+}
+
+/*
+ *  ======== CryptoRef_digestSize ========
+ */
+size_t CryptoRef_digestSize(CryptoRef_HashAlgo algo)
+{
+    static const size_t sizes[4] = {16, 20, 28, 32};
+
+    return (sizes[algo]);
+}
+
+/*
+ *  ======== CryptoRef_hashInit ========
+ */
+void CryptoRef_hashInit(CryptoRef_Hash *hash, CryptoRef_HashAlgo algo)
+{
+    hash->algo = algo;
+    memcpy(hash->state, hashInit[algo], sizeof(hash->state));
+    hash->count = 0;
+    hash->bufLen = 0;
+}
+
+/*
+ *  ======== CryptoRef_hashBlock ========
+ */
+void CryptoRef_hashBlock(CryptoRef_Hash *hash, const uint8_t *block)
+{
+    switch (hash->algo) {
+        case CryptoRef_MD5:
+            md5Block(hash->state, block);
+            break;
+        case CryptoRef_SHA1:
+            sha1Block(hash->state, block);
+            break;
+        default:
+            sha256Block(hash->state, block);
+            break;
+    }
+    hash->count += CryptoRef_HASH_BLOCK_SIZE;
+}
+
+/*
+ *  ======== CryptoRef_hashUpdate ========
+ */
+void CryptoRef_hashUpdate(CryptoRef_Hash *hash, const void *data, size_t len)
+{
+    const uint8_t *bytes = data;
+    size_t         copyLen;
+
+    while (len > 0) {
+        copyLen = CryptoRef_HASH_BLOCK_SIZE - hash->bufLen;
+        if (copyLen > len) {
+            copyLen = len;
+        }
+        memcpy(hash->buf + hash->bufLen, bytes, copyLen);
+        hash->bufLen += copyLen;
+        bytes += copyLen;
+        len -= copyLen;
+
+        if (hash->bufLen == CryptoRef_HASH_BLOCK_SIZE) {
+            CryptoRef_hashBlock(hash, hash->buf);
+            hash->bufLen = 0;
+        }
+    }
+}
+
+/*
+ *  ======== CryptoRef_hashFinal ========
+ */
+void CryptoRef_hashFinal(CryptoRef_Hash *hash, uint8_t *digest)
+{
+    uint64_t bits = (hash->count + hash->bufLen) * 8;
+    size_t   size = CryptoRef_digestSize(hash->algo);
+    uint8_t  pad[CryptoRef_HASH_BLOCK_SIZE + 8];
+    size_t   padLen;
+    size_t   i;
+
+    padLen = ((hash->bufLen < 56) ? 56 : 120) - hash->bufLen;
+    memset(pad, 0, sizeof(pad));
+    pad[0] = 0x80;
+    for (i = 0; i < 8; i++) {
+        /* MD5 appends the length little endian, SHA big endian */
+        pad[padLen + i] = (uint8_t)(bits >> ((hash->algo == CryptoRef_MD5) ?
+            (8 * i) : (56 - 8 * i)));
+    }
+    CryptoRef_hashUpdate(hash, pad, padLen + 8);
+
+    for (i = 0; i < size; i++) {
+        digest[i] = (uint8_t)(hash->state[i / 4] >>
+            ((hash->algo == CryptoRef_MD5) ? (8 * (i & 3)) :
+            (24 - 8 * (i & 3))));
+    }
+}
+
+/*
+ *  ======== CryptoRef_hash ========
+ */
+void CryptoRef_hash(CryptoRef_HashAlgo algo, const void *data, size_t len,
+    uint8_t *digest)
+{
+    CryptoRef_Hash hash;
+
+    CryptoRef_hashInit(&hash, algo);
+    CryptoRef_hashUpdate(&hash, data, len);
+    CryptoRef_hashFinal(&hash, digest);
+}
+
+/*
+ *  ======== CryptoRef_hmac ========
+ */
+void CryptoRef_hmac(CryptoRef_HashAlgo algo, const uint8_t *key,
+    size_t keyLen, const void *data, size_t len, uint8_t *mac)
+{
+    CryptoRef_Hash hash;
+    uint8_t        block[CryptoRef_HASH_BLOCK_SIZE];
+    uint8_t        inner[CryptoRef_MAX_DIGEST_SIZE];
+    size_t         i;
+
+    memset(block, 0, sizeof(block));
+    if (keyLen > CryptoRef_HASH_BLOCK_SIZE) {
+        CryptoRef_hash(algo, key, keyLen, block);
+    }
+    else {
+        memcpy(block, key, keyLen);
+    }
+
+    for (i = 0; i < sizeof(block); i++) {
+        block[i] ^= 0x36;
+    }
+    CryptoRef_hashInit(&hash, algo);
+    CryptoRef_hashUpdate(&hash, block, sizeof(block));
+    CryptoRef_hashUpdate(&hash, data, len);
+    CryptoRef_hashFinal(&hash, inner);
+
+    for (i = 0; i < sizeof(block); i++) {
+        block[i] ^= 0x36 ^ 0x5c;
+    }
+    CryptoRef_hashInit(&hash, algo);
+    CryptoRef_hashUpdate(&hash, block, sizeof(block));
+    CryptoRef_hashUpdate(&hash, inner, CryptoRef_digestSize(algo));
+    CryptoRef_hashFinal(&hash, mac);
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2018, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *  ======== CryptoRef.h ========
+ *  Reference AES, DES, MD5, SHA-1, SHA-224, SHA-256 and HMAC for the host
+ *  tests, written from the standards for clarity rather than speed.
+ */
+
+#ifndef tests_ref_CryptoRef__include
+#define tests_ref_CryptoRef__include
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define CryptoRef_AES_BLOCK_SIZE    (16)
+#define CryptoRef_DES_BLOCK_SIZE    (8)
+#define CryptoRef_HASH_BLOCK_SIZE   (64)
+#define CryptoRef_MAX_DIGEST_SIZE   (32)
+
+typedef struct CryptoRef_AesKey {
+    uint32_t rk[60];
+    int      rounds;
+} CryptoRef_AesKey;
+
+typedef struct CryptoRef_DesKey {
+    uint64_t subkeys[3][16];
+    bool     triple;
+} CryptoRef_DesKey;
+
+typedef enum CryptoRef_HashAlgo {
+    CryptoRef_MD5,
+    CryptoRef_SHA1,
+    CryptoRef_SHA224,
+    CryptoRef_SHA256
+} CryptoRef_HashAlgo;
+
+/*
+ *  Hash state. state[] and count may be read and set directly to model an
+ *  engine whose intermediate digest is saved and restored; count is in
+ *  bytes.
+ */
+typedef struct CryptoRef_Hash {
+    CryptoRef_HashAlgo algo;
+    uint32_t           state[8];
+    uint64_t           count;
+    uint8_t            buf[CryptoRef_HASH_BLOCK_SIZE];
+    size_t             bufLen;
+} CryptoRef_Hash;
+
+/* keyLen is 16, 24 or 32 bytes */
+extern void CryptoRef_aesSetKey(CryptoRef_AesKey *key, const uint8_t *bytes,
+    size_t keyLen);
+extern void CryptoRef_aesEncrypt(const CryptoRef_AesKey *key,
+    const uint8_t *in, uint8_t *out);
+extern void CryptoRef_aesDecrypt(const CryptoRef_AesKey *key,
+    const uint8_t *in, uint8_t *out);
+
+/* bytes holds K1, or K1 K2 K3 for EDE triple DES */
+extern void CryptoRef_desSetKey(CryptoRef_DesKey *key, const uint8_t *bytes,
+    bool triple);
+extern void CryptoRef_desEncrypt(const CryptoRef_DesKey *key,
+    const uint8_t *in, uint8_t *out);
+extern void CryptoRef_desDecrypt(const CryptoRef_DesKey *key,
+    const uint8_t *in, uint8_t *out);
+
+extern size_t CryptoRef_digestSize(CryptoRef_HashAlgo algo);
+extern void CryptoRef_hashInit(CryptoRef_Hash *hash, CryptoRef_HashAlgo algo);
+extern void CryptoRef_hashBlock(CryptoRef_Hash *hash, const uint8_t *block);
+extern void CryptoRef_hashUpdate(CryptoRef_Hash *hash, const void *data,
+    size_t len);
+extern void CryptoRef_hashFinal(CryptoRef_Hash *hash, uint8_t *digest);
+extern void CryptoRef_hash(CryptoRef_HashAlgo algo, const void *data,
+    size_t len, uint8_t *digest);
+
+/* Keys longer than a block are hashed first, as in RFC 2104 */
+extern void CryptoRef_hmac(CryptoRef_HashAlgo algo, const uint8_t *key,
+    size_t keyLen, const void *data, size_t len, uint8_t *mac);
+
+#endif /* tests_ref_CryptoRef__include */